@@ -27,7 +27,10 @@
 .RETURNS     non-negative on success, negative on failure
 .COMMENTS    None
 .ENVIRONment None
-.VERSION     1.0     28-Oct-2008   initial release by R. M. van Hees
+.VERSION     1.2     17-Oct-2026   read products by worker processes, write
+                                   the merged records in blocks, RvH
+             1.1     17-Oct-2026   merge products in time, no HPSORT, RvH
+             1.0     28-Oct-2008   initial release by R. M. van Hees
 ------------------------------------------------------------*/
 /*
  * Define _ISOC99_SOURCE to indicate
@@ -39,6 +42,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stddef.h>
 
 #include <hdf5.h>
 #include <netcdf.h>
@@ -57,89 +61,83 @@
 
 /*+++++++++++++++++++++++++ Static Functions +++++++++++++++++++++++*/
 /*+++++++++++++++++++++++++
-.IDENTifer   HPSORT
-.PURPOSE     sort an array into assending order using the Heapsort algorithm
+.IDENTifer   RD_FRESCO_PRODUCT
+.PURPOSE     read header and records of one FRESCO product
 .INPUT/OUTPUT
-  call as   HPSORT( dim, jday, rec );
+  call as   res = RD_FRESCO_PRODUCT( flname, hdr, &rec, &numRec );
      input:
-            unsigned int dim       :    dimension of the array to be sorted
+            char *flname         :  name of the product (ASCII or netCDF)
     output:
-            double       *jday     :    array to be sorted
-	    struct fresco_rec *rec :    array of records to be sorted as jday
+            void *hdr            :  header (struct fresco_hdr)
+	    void **rec           :  records (struct fresco_rec)
+	    unsigned int *numRec :  number of records
 
-.RETURNS     nothing
-.COMMENTS    static function
-             Heapsort algorithm in a N log_2 N routine
+.RETURNS     FALSE when the product is skipped
+             error status passed by global variable ``nadc_stat''
+.COMMENTS    static function, called by the workers of ADAGUC_SPOOL_PRODUCTS
 -------------------------*/
 static
-void HPSORT( unsigned int dim, double *jday, struct fresco_rec *rec )
+bool RD_FRESCO_PRODUCT( const char *flname, void *hdr_out, void **rec_out,
+			unsigned int *numRec )
 {
-     register unsigned int ii,  ir, jj, ll;
-
-     double jbuff;
-     struct fresco_rec buff;
+     int    ncid;
+     int    retval;
 
-     const size_t sizeof_fresco_rec = sizeof(struct fresco_rec);
-/*
- * initialization
- */
-     jday--; rec--;
-     ll = (dim >> 1) + 1;
-     ir = dim;
+     struct fresco_hdr *hdr = (struct fresco_hdr *) hdr_out;
+     struct fresco_rec *rec = NULL;
 
-     while ( TRUE ) {
-	  if ( ll > 1 ) {                          /* still in hirring phase */
-	       jbuff = jday[--ll];
-	       (void) memcpy( &buff, rec+ll, sizeof_fresco_rec );
-	  } else {                      /* in retirement-and-promotion phase */
-	       jbuff = jday[ir];              /* clear space at end of array */
-	       (void) memcpy( &buff, rec+ir, sizeof_fresco_rec );
-	       jday[ir] = jday[1];     /* retire the top of the heap into it */
-	       (void) memcpy( rec+ir, rec+1, sizeof_fresco_rec );
-	       if ( --ir == 1 ) {            /* done with the last promotion */
-		    jday[1] = jbuff;    /* the least competent worker of all */
-		    (void) memcpy( rec+1, &buff, sizeof_fresco_rec );
-		    break;
-	       }
+     *rec_out = NULL;
+     *numRec  = 0u;
+     if ( H5Fis_hdf5( flname ) ) {
+	  if ( (retval = nc_open(flname, NC_NOWRITE, &ncid)) != NC_NOERR )
+	       NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_FRESCO_RD_NC_META( ncid, hdr );
+	  hdr->numRec = NADC_FRESCO_RD_NC_REC( ncid, &rec );
+	  if ( nc_close( ncid ) != NC_NOERR )
+	       NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+     } else {
+	  (void) NADC_RD_FRESCO( flname, hdr, &rec );
+	  if ( IS_ERR_STAT_WARN ) {
+	       nadc_stat &= ~NADC_STAT_WARN;
+	       if ( rec != NULL ) free( rec );
+	       return FALSE;
 	  }
-/*
- * whether in the hiring phase or promotion phase, we here set up to shift
- * down element jbuff to its proper level
- */
-	  ii = ll;
-	  jj = ll + ll;
-	  while ( jj <= ir ) {
-	       if ( jj < ir && jday[jj] < jday[jj+1] ) jj++;
-	       if ( jbuff < jday[jj] ) {                     /* demote jbuff */
-		    jday[ii] = jday[jj];
-		    (void) memcpy( rec+ii, rec+jj, sizeof_fresco_rec );
-		    ii = jj;
-		    jj <<= 1;
-	       } else
-		    jj = ir + 1;       /* set jj to terminate the shift down */
-	  }
-	  jday[ii] = jbuff;                       /* put jbuff into its slot */
-	  (void) memcpy( rec+ii, &buff, sizeof_fresco_rec );
+#ifdef DEBUG
+	  (void) printf( "%s %s %s %s %s %s %s %s %hu %hu %hu %u\n", 
+			 hdr->product, hdr->creation_date, 
+			 hdr->receive_date, hdr->l1b_product, 
+			 hdr->validity_start, hdr->validity_stop, 
+			 hdr->software_version, hdr->lv1c_version, 
+			 hdr->numProd, hdr->numRec, 
+			 hdr->numState, hdr->file_size );
+#endif
      }
+ done:
+     *rec_out = rec;
+     if ( rec != NULL ) *numRec = hdr->numRec;
+     return TRUE;
 }
 
 /*+++++++++++++++++++++++++ Main Program or Function +++++++++++++++*/
 int main ( int argc, char *argv[] )
 {
-     register int na = 0; 
+     register unsigned int np;
 
      char flname[2 * MAX_STRING_LENGTH];
 
-     register unsigned int nr;
-
      int    ncid;
      int    retval;
-     double *jday = NULL;
+     unsigned int num, offs;
 
      struct param_adaguc param;
+     struct adaguc_spool spool;
 
      struct fresco_hdr hdr;
      struct fresco_rec *rec = NULL;
+
+     const struct fresco_hdr *hdr_prod;
+
+     (void) memset( &spool, 0, sizeof(struct adaguc_spool) );
 /*
  * check command-line parameters
  */
@@ -157,129 +155,71 @@ int main ( int argc, char *argv[] )
 	  exit( EXIT_SUCCESS );
      }
 /*
- * process input files
+ * process input files, the records are spooled ordered in time
  */
-     hdr.numProd = 0;
-     do {
-	  struct fresco_hdr hdr_tmp;
-	  struct fresco_rec *rec_tmp = NULL;
-	  
-	  (void) nadc_strlcpy( flname, 
-			       param.name_infiles[na], MAX_STRING_LENGTH );
-	  if ( H5Fis_hdf5( flname ) ) {
-	       if ( (retval = nc_open(flname, NC_NOWRITE, &ncid)) != NC_NOERR )
-		    NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
-	       NADC_FRESCO_RD_NC_META( ncid, &hdr_tmp );
-	       hdr_tmp.numRec = NADC_FRESCO_RD_NC_REC( ncid, &rec_tmp );
-	       if ( nc_close( ncid ) != NC_NOERR )
-		    NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
-	  } else {
-	       (void) NADC_RD_FRESCO( flname, &hdr_tmp, &rec_tmp );
-               if ( IS_ERR_STAT_WARN ) {
-                    nadc_stat &= ~NADC_STAT_WARN;
-                    continue;
-               }
-#ifdef DEBUG
-	       (void) printf( "%s %s %s %s %s %s %s %s %hu %hu %hu %u\n", 
-			      hdr_tmp.product, hdr_tmp.creation_date, 
-			      hdr_tmp.receive_date, hdr_tmp.l1b_product, 
-			      hdr_tmp.validity_start, hdr_tmp.validity_stop, 
-			      hdr_tmp.software_version, hdr_tmp.lv1c_version, 
-			      hdr_tmp.numProd, hdr_tmp.numRec, 
-			      hdr_tmp.numState, hdr_tmp.file_size );
-#endif
-	  }
-	  if ( IS_ERR_STAT_FATAL )
-	       NADC_GOTO_ERROR( NADC_ERR_FATAL, "failed to read product" );
+     ADAGUC_SPOOL_PRODUCTS( &param, sizeof(struct fresco_hdr), 
+			    sizeof(struct fresco_rec), 
+			    offsetof(struct fresco_rec, jday), 
+			    RD_FRESCO_PRODUCT, &spool );
+     if ( IS_ERR_STAT_FATAL )
+	  NADC_GOTO_ERROR( NADC_ERR_FATAL, "failed to read product" );
 
+     hdr.numProd = 0;
+     hdr_prod = (const struct fresco_hdr *) spool.hdr;
+     for ( np = 0; np < spool.num_prod; np++, hdr_prod++ ) {
 	  if ( hdr.numProd == 0 ) {
-	       (void) memcpy( &hdr, &hdr_tmp, sizeof(struct fresco_hdr) );
-	       if ( hdr_tmp.numRec > 0 ) {
-		    rec = (struct fresco_rec *)
-			 malloc( hdr_tmp.numRec * sizeof( struct fresco_rec ));
-		    if ( rec == NULL ) 
-			 NADC_GOTO_ERROR( NADC_ERR_ALLOC, "rec" );
-		    (void) memcpy( rec, rec_tmp, 
-				   hdr_tmp.numRec * sizeof(struct fresco_rec) );
-	       }
+	       (void) memcpy( &hdr, hdr_prod, sizeof(struct fresco_hdr) );
 	  } else {
-	       if ( strcmp( hdr.software_version, hdr_tmp.software_version ) != 0 )
+	       if ( strcmp( hdr.software_version, hdr_prod->software_version ) != 0 )
 		    NADC_GOTO_ERROR( NADC_ERR_FATAL,
 				     "inconsistent product versions" );
 
 	       /* update header struct */
-	       hdr.numProd += hdr_tmp.numProd;
-	       hdr.numRec  += hdr_tmp.numRec;
-	       hdr.file_size = hdr_tmp.file_size;
-	       (void) strcat( hdr.l1b_product, "," );
-	       (void) strcat( hdr.l1b_product, hdr_tmp.l1b_product );
-
-	       /* append new records */
-	       if ( hdr.numRec > 0 ) {
-		    rec = (struct fresco_rec *)
-			 realloc( rec, hdr.numRec * sizeof(struct fresco_rec));
-		    if ( rec == NULL ) 
-			 NADC_GOTO_ERROR( NADC_ERR_ALLOC, "rec" );
-		    (void) memcpy( rec + (hdr.numRec - hdr_tmp.numRec), 
-				   rec_tmp, 
-				   hdr_tmp.numRec * sizeof(struct fresco_rec) );
-	       }
+	       hdr.numProd += hdr_prod->numProd;
+	       hdr.numRec  += hdr_prod->numRec;
+	       hdr.file_size = hdr_prod->file_size;
+	       (void) nadc_strlcat( hdr.l1b_product, ",", 
+				    sizeof(hdr.l1b_product) );
+	       (void) nadc_strlcat( hdr.l1b_product, hdr_prod->l1b_product, 
+				    sizeof(hdr.l1b_product) );
 	  }
-	  if ( rec_tmp != NULL ) free( rec_tmp );
-     } while ( ++na < param.num_infiles );
+     }
      if ( hdr.numProd == 0 ) goto done;
-     if ( rec == NULL ) goto done;
+     if ( spool.num_read == 0u ) goto done;
 /*
- * sort the FRESCO records in time
+ * select the FRESCO records in the clip range
  */
-     if ( hdr.numRec > 1 ) {
-	  jday = (double *) malloc( hdr.numRec * sizeof(double) );
-	  if ( jday == NULL ) NADC_GOTO_ERROR( NADC_ERR_ALLOC, "jday" );
-	  for ( nr = 0; nr < hdr.numRec; nr++ ) jday[nr] = rec[nr].jday;
-	  HPSORT( hdr.numRec, jday, rec );
-
-	  if ( param.flag_clip == PARAM_SET ) {
-	       register unsigned int ilow, ihigh;
-
-	       double jdayStart, jdayStop;
-
-	       if ( strncmp(hdr.source, "GOME", 4) == 0 ) {
-		    jdayStart = Adaguc2gomeJDAY( param.clipStart );
-		    jdayStop  = Adaguc2gomeJDAY( param.clipStop );
-	       } else {
-		    jdayStart = Adaguc2sciaJDAY( param.clipStart );
-		    jdayStop  = Adaguc2sciaJDAY( param.clipStop );
-	       }
-	       (void) nadc_strlcpy( hdr.validity_start, param.clipStart, 16 );
-	       (void) nadc_strlcpy( hdr.validity_stop, param.clipStop, 16 );
-
-	       for ( ilow = 0; ilow < hdr.numRec; ilow++ ) 
-		    if ( jday[ilow] >= jdayStart ) break;
-	       for ( ihigh = hdr.numRec-1; ihigh > ilow; ihigh-- ) 
-		    if ( jday[ihigh] <= jdayStop ) break;
+     if ( param.flag_clip == PARAM_SET ) {
+	  double jdayStart, jdayStop;
 
-	       if ( ihigh <= ilow ) {
-		    NADC_GOTO_ERROR( NADC_ERR_FATAL, 
-				     "all records outside clipRange" );
-	       } else if ( ilow > 0 || ihigh < (hdr.numRec-1) ) {
-		    hdr.numRec = ihigh - ilow + 1;
-		    (void) memmove( rec, rec+ilow, 
-				    hdr.numRec * sizeof(struct fresco_rec) );
-	       }
+	  if ( strncmp(hdr.source, "GOME", 4) == 0 ) {
+	       jdayStart = Adaguc2gomeJDAY( param.clipStart );
+	       jdayStop  = Adaguc2gomeJDAY( param.clipStop );
+	  } else {
+	       jdayStart = Adaguc2sciaJDAY( param.clipStart );
+	       jdayStop  = Adaguc2sciaJDAY( param.clipStop );
 	  }
-	  free( jday );
+	  ADAGUC_SPOOL_SELECT( &spool, jdayStart, jdayStop );
+	  if ( IS_ERR_STAT_FATAL )
+	       NADC_GOTO_ERROR( NADC_ERR_FATAL, "ADAGUC_SPOOL_SELECT" );
+	  if ( spool.num_rec == 0u )
+	       NADC_GOTO_ERROR( NADC_ERR_FATAL, 
+				"all records outside clipRange" );
+	  (void) nadc_strlcpy( hdr.validity_start, param.clipStart, 16 );
+	  (void) nadc_strlcpy( hdr.validity_stop, param.clipStop, 16 );
      }
+     hdr.numRec = spool.num_rec;
 /*
  * construct ADAGUC compiant filename
  * first, recontruct validity period from FRESCO records
  */
      if ( hdr.numProd > 1 && param.flag_clip == PARAM_UNSET ) {
 	  if ( strncmp(hdr.source, "GOME", 4) == 0 ) {
-	       GomeJDAY2adaguc( rec->jday, hdr.validity_start );
-	       GomeJDAY2adaguc( rec[hdr.numRec-1].jday, hdr.validity_stop );
+	       GomeJDAY2adaguc( spool.key_first, hdr.validity_start );
+	       GomeJDAY2adaguc( spool.key_last, hdr.validity_stop );
 	  } else {
-	       SciaJDAY2adaguc( rec->jday, hdr.validity_start );
-	       SciaJDAY2adaguc( rec[hdr.numRec-1].jday, hdr.validity_stop );
+	       SciaJDAY2adaguc( spool.key_first, hdr.validity_start );
+	       SciaJDAY2adaguc( spool.key_last, hdr.validity_stop );
 	  }
      }
      (void) snprintf( flname, sizeof(flname), "%s/"ADAGUC_PROD_TEMPLATE, 
@@ -293,9 +233,25 @@ int main ( int argc, char *argv[] )
      if ( IS_ERR_STAT_FATAL )
 	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "FRESCO header" );
 
-     NADC_FRESCO_WR_NC_REC( ncid, hdr.source, hdr.numRec, rec );
+     NADC_FRESCO_DEF_NC_REC( ncid, hdr.source, hdr.numRec );
      if ( IS_ERR_STAT_FATAL )
 	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "FRESCO records" );
+/*
+ * merge the FRESCO records in time, and write them block by block
+ */
+     rec = (struct fresco_rec *) 
+	  malloc( ADAGUC_REC_BLOCK * sizeof(struct fresco_rec) );
+     if ( rec == NULL ) NADC_GOTO_ERROR( NADC_ERR_ALLOC, "rec" );
+
+     offs = 0u;
+     while ( (num = ADAGUC_SPOOL_MERGE( &spool, ADAGUC_REC_BLOCK, rec )) > 0 ) {
+	  NADC_FRESCO_WR_NC_REC( ncid, offs, num, rec );
+	  if ( IS_ERR_STAT_FATAL )
+	       NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "FRESCO records" );
+	  offs += num;
+     }
+     if ( IS_ERR_STAT_FATAL )
+	  NADC_GOTO_ERROR( NADC_ERR_FATAL, "ADAGUC_SPOOL_MERGE" );
 
      if ( nc_close( ncid ) != NC_NOERR )
 	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
@@ -304,6 +260,7 @@ int main ( int argc, char *argv[] )
  */
  done:
      if ( rec != NULL ) free( rec );
+     ADAGUC_SPOOL_CLOSE( &spool );
 /*
  * display error messages
  */
@@ -28,7 +28,8 @@
 .RETURNS     non-negative on success, negative on failure
 .COMMENTS    None
 .ENVIRONment None
-.VERSION     2.1     25-Jun-2008   update to Fresco+, 
+.VERSION     2.2     17-Oct-2026   define and write netCDF records apart, RvH
+             2.1     25-Jun-2008   update to Fresco+, 
                                    added more sanity checks, RvH
              2.0     03-Jun-2008   added optional netCDF output, RvH
              1.0     01-Mar-2007   initial release by R. M. van Hees
@@ -176,7 +177,9 @@ int main ( int argc, char *argv[] )
 
           NADC_FRESCO_WR_NC_META( ncid, &hdr );
 
-          NADC_FRESCO_WR_NC_REC( ncid, hdr.source, numRec, fresco );
+          NADC_FRESCO_DEF_NC_REC( ncid, hdr.source, numRec );
+          if ( ! IS_ERR_STAT_FATAL )
+               NADC_FRESCO_WR_NC_REC( ncid, 0u, numRec, fresco );
 
           if ( nc_close( ncid ) != NC_NOERR )
                NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
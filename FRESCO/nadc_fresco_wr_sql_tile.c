@@ -31,7 +31,8 @@
 .RETURNS     Nothing, error status passed by global variable ``nadc_stat''
 .COMMENTS    None
 .ENVIRONment None
-.VERSION     3.2     12-Aug-2009   bugfix string allocation too small, RvH
+.VERSION     3.3     17-Oct-2026   bulk ingest of tiles using COPY, RvH
+             3.2     12-Aug-2009   bugfix string allocation too small, RvH
              3.1     11-Apr-2008   add GOME implementation, RvH
              3.0     20-Mar-2008   rename/rewrite, RvH
              2.1     06-Aug-2007   fixed segementation fault on empty products
@@ -54,6 +55,8 @@
 #define _SCIA_LEVEL_2
 #include <nadc_fresco.h>
 
+#include <_nadc_sql_copy.inc>
+
 /*+++++ Macros +++++*/
 	/* NONE */
 
@@ -69,13 +72,14 @@
  surfacePressure,surfaceAlbedo) \
  VALUES (%.11f,%lld,%d,%hhu,%.7g,%.7g,%.7g,%.7g,%.7g,%.7g,%.7g)"
 
-#define SQL_INSERT_SCIA_TILE \
-"INSERT INTO %s (pk_tile,fk_meta,julianDay,integrationTime,errorFlag,\
+#define TILE_TBL_COLUMNS \
+"tile_fresco (pk_tile,fk_meta,julianDay,integrationTime,errorFlag,\
  cloudFraction,cloudTopHeight,cloudTopPressure,cloudAlbedo,surfaceHeight,\
- surfacePressure,surfaceAlbedo,tile) \
- VALUES (%lld,%d,%.11f,%d,%hhu,%.7g,%.7g,%.7g,%.7g,%.7g,%.7g,%.7g,\
- ST_GeomFromText(\
- \'POLYGON((%.6f %.6f,%.6f %.6f,%.6f %.6f,%.6f %.6f,%.6f %.6f))\', 4326))"
+ surfacePressure,surfaceAlbedo,tile)"
+
+#define SQL_COPY_SCIA_TILE \
+"%lld\t%d\t%.11f\t%d\t%hhu\t%.7g\t%.7g\t%.7g\t%.7g\t%.7g\t%.7g\t%.7g\t\
+SRID=4326;POLYGON((%.6f %.6f,%.6f %.6f,%.6f %.6f,%.6f %.6f,%.6f %.6f))\n"
 
 /*+++++ Static Variables +++++*/
 	/* NONE */
@@ -203,90 +207,66 @@ void NADC_FRESCO_WR_SQL_SCIA_TILE( PGconn *conn, const char *prodName,
      register unsigned int insertedRows = 0u;
      register unsigned int failedRows = num_rec;
 
-     char   sql_query[SQL_STR_SIZE], cbuff[SQL_STR_SIZE];
+     char   cbuff[SQL_STR_SIZE];
 
-     char       *pntr;
-     int        nrow, numChar, meta_id;
+     int    meta_id;
 
-     long long  tile_id;
+     long long *tile_id = NULL;
 
-     PGresult   *res;
+     struct sql_copy_rec copy;
 /*
  * check if product is already in database
  */
-     (void) snprintf( sql_query, SQL_STR_SIZE, 
-		      "SELECT pk_meta FROM %s WHERE name=\'%s\'", 
-		      META_TBL_NAME, prodName );
-     res = PQexec( conn, sql_query );
-     if ( PQresultStatus( res ) != PGRES_TUPLES_OK ) {
-          NADC_GOTO_ERROR( NADC_ERR_SQL, PQresultErrorMessage(res) );
-     }
-     if ( (nrow = PQntuples( res )) == 0 ) {
-          NADC_GOTO_ERROR( NADC_ERR_FATAL, prodName );
-     }
-     pntr = PQgetvalue( res, 0, 0 );
-     meta_id = (int) strtol( pntr, (char **) NULL, 10 );     
-     PQclear( res );
+     meta_id = NADC_SQL_GET_META_ID( conn, META_TBL_NAME, prodName );
+     if ( IS_ERR_STAT_FATAL ) goto done;
+     if ( num_rec == 0u ) goto done;
+/*
+ * obtain values for serial pk_tile (one round trip)
+ */
+     tile_id = (long long *) malloc( num_rec * sizeof(long long) );
+     if ( tile_id == NULL ) NADC_GOTO_ERROR( NADC_ERR_ALLOC, "tile_id" );
+     NADC_SQL_NEXTVAL( conn, "tile_fresco_pk_tile_seq", num_rec, tile_id );
+     if ( IS_ERR_STAT_FATAL ) goto done;
 /*
  * Start a transaction block
  */
-     res = PQexec( conn, "BEGIN" );
-     if ( PQresultStatus( res ) != PGRES_COMMAND_OK )
-          NADC_GOTO_ERROR( NADC_ERR_SQL, PQresultErrorMessage(res) );
-     PQclear( res );
+     NADC_SQL_COMMAND( conn, "BEGIN" );
+     if ( IS_ERR_STAT_FATAL ) goto done;
 /*
- * insert all tiles in products
+ * stream all tiles of the product to the server
  */
-     for ( nr = 0; nr < num_rec; nr++ ) {
-	  /* obtain next value for serial pk_tile */
-	  res = PQexec( conn,
-			"SELECT nextval(\'tile_fresco_pk_tile_seq\')" );
-	  if ( PQresultStatus( res ) != PGRES_TUPLES_OK )
-	       NADC_GOTO_ERROR( NADC_ERR_SQL, 
-				PQresultErrorMessage(res) );
-	  pntr = PQgetvalue( res, 0, 0 );
-	  tile_id = strtoll( pntr, (char **) NULL, 10 );
-	  PQclear( res );
-
-	  numChar = snprintf( sql_query, SQL_STR_SIZE, SQL_INSERT_SCIA_TILE, 
-			      TILE_TBL_NAME, tile_id, meta_id, rec[nr].jday,
-			      rec[nr].meta.intg_time, 
-			      rec[nr].meta.errorFlag, rec[nr].cloudFraction, 
-			      rec[nr].cloudTopHeight, rec[nr].cloudTopPress,
-			      rec[nr].cloudAlbedo, rec[nr].surfaceHeight, 
-			      rec[nr].groundPress, rec[nr].surfaceAlbedo,
-			      rec[nr].lon_corner[0],rec[nr].lat_corner[0],
-			      rec[nr].lon_corner[1],rec[nr].lat_corner[1],
-			      rec[nr].lon_corner[2],rec[nr].lat_corner[2],
-			      rec[nr].lon_corner[3],rec[nr].lat_corner[3],
-			      rec[nr].lon_corner[0],rec[nr].lat_corner[0] );
-
- 	  /* (void) fprintf( stderr, "%s [%-d]\n", sql_query, numChar ); */
-	  if ( numChar >= SQL_STR_SIZE )
-	       NADC_RETURN_ERROR( NADC_ERR_STRLEN, "sql_query" );
-	  res = PQexec( conn, sql_query );
-	  if ( PQresultStatus( res ) != PGRES_COMMAND_OK ) {
-	       NADC_ERROR( NADC_ERR_SQL, PQresultErrorMessage(res) );
-	       PQclear( res );
-	       res = PQexec( conn, "ROLLBACK" );
-	       if ( PQresultStatus( res ) != PGRES_COMMAND_OK )
-		    NADC_ERROR( NADC_ERR_SQL,
-				PQresultErrorMessage(res) );
-	       goto done;
-	  }
-	  PQclear( res );
-
-	  insertedRows++;
-	  failedRows--;
+     NADC_SQL_COPY_BEGIN( conn, TILE_TBL_COLUMNS, &copy );
+     for ( nr = 0; nr < num_rec && ! IS_ERR_STAT_FATAL; nr++ ) {
+	  NADC_SQL_COPY_ROW( &copy, SQL_COPY_SCIA_TILE, tile_id[nr], meta_id,
+			     rec[nr].jday, rec[nr].meta.intg_time, 
+			     rec[nr].meta.errorFlag, rec[nr].cloudFraction, 
+			     rec[nr].cloudTopHeight, rec[nr].cloudTopPress,
+			     rec[nr].cloudAlbedo, rec[nr].surfaceHeight, 
+			     rec[nr].groundPress, rec[nr].surfaceAlbedo,
+			     rec[nr].lon_corner[0], rec[nr].lat_corner[0],
+			     rec[nr].lon_corner[1], rec[nr].lat_corner[1],
+			     rec[nr].lon_corner[2], rec[nr].lat_corner[2],
+			     rec[nr].lon_corner[3], rec[nr].lat_corner[3],
+			     rec[nr].lon_corner[0], rec[nr].lat_corner[0] );
      }
+     if ( IS_ERR_STAT_FATAL )
+	  NADC_SQL_COPY_ABORT( &copy );
+     else
+	  NADC_SQL_COPY_END( &copy );
 /*
  * end the transaction
  */
-     res = PQexec( conn, "COMMIT" );
-     if ( PQresultStatus( res ) != PGRES_COMMAND_OK )
-          NADC_ERROR( NADC_ERR_SQL, PQresultErrorMessage(res) );
+     if ( IS_ERR_STAT_FATAL ) {
+	  NADC_SQL_COMMAND( conn, "ROLLBACK" );
+	  goto done;
+     }
+     NADC_SQL_COMMAND( conn, "COMMIT" );
+     if ( ! IS_ERR_STAT_FATAL ) {
+	  insertedRows = copy.num_rows;
+	  failedRows = num_rec - insertedRows;
+     }
  done:
-     PQclear( res );
+     if ( tile_id != NULL ) free( tile_id );
      (void) snprintf( cbuff, SQL_STR_SIZE, "insertedRows=%-u", insertedRows );
      NADC_ERROR( NADC_ERR_NONE, cbuff );
      if ( failedRows > 0 ) {
@@ -20,9 +20,12 @@
 .KEYWORDS    FRESCO GOME SCIA
 .LANGUAGE    ANSI C
 .PURPOSE     write KNMI Fresco product in ADAGUC format
-.COMMENTS    contains NADC_FRESCO_WR_NC_META and NADC_FRESCO_WR_NC_REC
+.COMMENTS    contains NADC_FRESCO_WR_NC_META, NADC_FRESCO_DEF_NC_REC
+             and NADC_FRESCO_WR_NC_REC
 .ENVIRONment None
-.VERSION     1.0     20-Oct-2008   initial release by R. M. van Hees
+.VERSION     1.1     17-Oct-2026   define the variables once, write the
+                                   records in blocks, RvH
+             1.0     20-Oct-2008   initial release by R. M. van Hees
 ------------------------------------------------------------*/
 /*
  * Define _POSIX_SOURCE to indicate
@@ -193,48 +196,63 @@ void NADC_FRESCO_WR_NC_META( int ncid, const struct fresco_hdr *hdr )
 }
 
 /*+++++++++++++++++++++++++
-.IDENTifer   NADC_FRESCO_WR_NC_REC
-.PURPOSE     write records to Fresco product in netCDF-4 format 
-             (ADAGUC standard)
+.IDENTifer   NADC_FRESCO_DEF_NC_REC
+.PURPOSE     define the record variables of a Fresco product in netCDF-4 
+             format (ADAGUC standard)
 .INPUT/OUTPUT
-  call as   NADC_FRESCO_WR_NC_REC( ncid, instr, numRec, rec );
+  call as   NADC_FRESCO_DEF_NC_REC( ncid, instr, numRec );
      input:
             int ncid               :  netCDF file ID
 	    char *instr            :  instrument (GOME/SCIA)
             unsigned int numRec    :  number of Fresco records
-            struct fresco_rec *rec :  Fresco records
 
 .RETURNS     Nothing
-.COMMENTS    None
+.COMMENTS    the records are written by NADC_FRESCO_WR_NC_REC, 
+             the variables are chunked by ADAGUC_REC_BLOCK records
 -------------------------*/
-void NADC_FRESCO_WR_NC_REC( int ncid, const char *instr, unsigned int numRec,
-			    const struct fresco_rec *rec )
+void NADC_FRESCO_DEF_NC_REC( int ncid, const char *instr, unsigned int numRec )
 {
-     register unsigned int ni, nr;
+     register unsigned short ni;
 
      int    retval;
      int    time_id, nv_id, dimids[2];
      int    meta_id, var_id;
 
-     float  *rbuff = NULL;
-     double *dbuff = NULL;
+     size_t chunk_size[2] = {ADAGUC_REC_BLOCK, NUM_CORNERS};
 
-     struct fresco_meta_rec *mbuff;
-
-     size_t chunk_size[2] = {numRec, NUM_CORNERS};
-     
-     const size_t nr_byte = NUM_CORNERS * sizeof(float);
+     const struct {
+	  const char *name, *units, *long_name, *standard_name, *error_name;
+     } fresco_var[] = {
+	  { "cloudFraction", "none", "effective cloud fraction", 
+	    "cloud_area_fraction", "cloudFractionError" },
+	  { "cloudFractionError", "none", "error of effective cloud fraction", 
+	    "cloud_area_fraction standard_error", NULL },
+	  { "cloudTopHeight", "m", "cloud height", "cloud_top_altitude", NULL },
+	  { "cloudTopPress", "hPa", "cloud pressure", 
+	    "air_pressure_at_cloud_top", "cloudTopPressError" },
+	  { "cloudTopPressError", "hPa", "error of cloud pressure", 
+	    "air_pressure_at_cloud_top standard_error", NULL },
+	  { "cloudAlbedo", "none", "cloud albedo", 
+	    "cloud_albedo", "cloudAlbedoError" },
+	  { "cloudAlbedoError", "none", "error of cloud albedo", 
+	    "cloud_albedo standard_error", NULL },
+	  { "surfaceAlbedo", "none", "wavelength averaged surface albedo", 
+	    "surface_albedo", NULL },
+	  { "surfaceHeight", "m", "surface heigth", "surface_altitude", NULL },
+	  { "groundPress", "Pa", "assumed surface pressure", 
+	    "surface_air_pressure", NULL }
+     };
+     const unsigned short num_var = 
+	  (unsigned short) (sizeof(fresco_var) / sizeof(fresco_var[0]));
 
      if ( numRec == 0u ) return;
+     if ( numRec < ADAGUC_REC_BLOCK ) chunk_size[0] = numRec;
 /*
- * write dimension scale "time"
+ * define dimension scale "time"
  */
-     dbuff = (double *) malloc( numRec * sizeof(double) );
-     if ( dbuff == NULL ) NADC_RETURN_ERROR( NADC_ERR_ALLOC, "dbuff" );
-
      retval = nc_def_dim( ncid, "time", (size_t) numRec, &time_id );
      if ( retval != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
      (void) nc_def_var( ncid, "time", NC_DOUBLE, 1, &time_id, &var_id );
      (void) nc_put_att_text( ncid, var_id, "long_name", 4, "time" );
      if ( strncmp( instr, "SCIA", 4 ) == 0 )
@@ -246,50 +264,41 @@ void NADC_FRESCO_WR_NC_REC( int ncid, const char *instr, unsigned int numRec,
      else
 	  (void) nc_put_att_text( ncid, var_id, "units", 7, "UNKNOWN" );
      (void) nc_put_att_text( ncid, var_id, "calendar", 4, "none" );
-     for ( nr = 0; nr < numRec; nr++ ) dbuff[nr] = rec[nr].jday;
      (void) nc_def_var_chunking( ncid, var_id, 0, chunk_size );
      (void) nc_def_var_deflate( ncid, var_id, 0, 1, 6 );
-     (void) nc_put_var_double( ncid, var_id, dbuff );
 
      retval = nc_def_dim( ncid, "nv", NUM_CORNERS, &nv_id );
      if ( retval != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
 /*
- * write longitude and latitude of measurements
+ * define longitude and latitude of measurements
  */
-     rbuff = (float *) malloc( numRec * sizeof(float) );
-     if ( rbuff == NULL ) NADC_RETURN_ERROR( NADC_ERR_ALLOC, "rbuff" );
-
      retval = nc_def_var( ncid, "lon", NC_FLOAT, 1, &time_id, &var_id );
      if ( retval != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
      (void) nc_def_var_chunking( ncid, var_id, 0, chunk_size );
      (void) nc_def_var_deflate( ncid, var_id, 0, 1, 6 );
      (void) nc_put_att_text( ncid, var_id, "long_name", 9, "longitude" );
      (void) nc_put_att_text( ncid, var_id, "units", 12, "degrees_east" );
      (void) nc_put_att_text( ncid, var_id, "standard_name", 9, "longitude" );
      (void) nc_put_att_text( ncid, var_id, "bounds", 8, "lon_bnds" );
-     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].lon_center;
-     (void) nc_put_var_float( ncid, var_id, rbuff );
 
      retval = nc_def_var( ncid, "lat", NC_FLOAT, 1, &time_id, &var_id );
      if ( retval != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
      (void) nc_def_var_chunking( ncid, var_id, 0, chunk_size );
      (void) nc_def_var_deflate( ncid, var_id, 0, 1, 6 );
      (void) nc_put_att_text( ncid, var_id, "long_name", 8, "latitude" );
      (void) nc_put_att_text( ncid, var_id, "units", 13, "degrees_north" );
      (void) nc_put_att_text( ncid, var_id, "standard_name", 8, "latitude" );
      (void) nc_put_att_text( ncid, var_id, "bounds", 8, "lat_bnds" );
-     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].lat_center;
-     (void) nc_put_var_float( ncid, var_id, rbuff );
 /*
- * write pixel meta-data as compound dataset
+ * define pixel meta-data as compound dataset
  */
      retval = nc_def_compound( ncid, sizeof(struct fresco_meta_rec),
                                "meta_rec", &meta_id );
      if ( retval != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
      nc_insert_compound( ncid, meta_id, "integration_time",
                          HOFFSET( struct fresco_meta_rec, intg_time ), 
 			 NC_UBYTE );
@@ -315,143 +324,154 @@ void NADC_FRESCO_WR_NC_REC( int ncid, const char *instr, unsigned int numRec,
                                "pixel_properties_and_retrieval_flags" );
      (void) nc_def_var_chunking( ncid, var_id, 0, chunk_size );
      (void) nc_def_var_deflate( ncid, var_id, 0, 1, 6 );
+/*
+ * define datasets
+ */
+     for ( ni = 0; ni < num_var; ni++ ) {
+	  var_id = ADAGUC_DEF_VAR( ncid, NC_FLOAT, time_id, 
+				   fresco_var[ni].name, fresco_var[ni].units,
+				   fresco_var[ni].long_name, 
+				   fresco_var[ni].standard_name, 
+				   fresco_var[ni].error_name );
+	  if ( IS_ERR_STAT_FATAL )
+	       NADC_RETURN_ERROR( NADC_ERR_HDF_WR, fresco_var[ni].name );
+	  (void) nc_def_var_chunking( ncid, var_id, 0, chunk_size );
+	  (void) nc_def_var_deflate( ncid, var_id, 0, 1, 6 );
+     }
+/*
+ * define longitude and latitude of tile-corners
+ */
+     dimids[0] = time_id;
+     dimids[1] = nv_id;
+     retval = nc_def_var( ncid, "lon_bnds", NC_FLOAT, 2, dimids, &var_id );
+     if ( retval != NC_NOERR )
+	  NADC_RETURN_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+     (void) nc_def_var_chunking( ncid, var_id, 0, chunk_size );
+     (void) nc_def_var_deflate( ncid, var_id, 0, 1, 6 );
+
+     retval = nc_def_var( ncid, "lat_bnds", NC_FLOAT, 2, dimids, &var_id );
+     if ( retval != NC_NOERR )
+	  NADC_RETURN_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+     (void) nc_def_var_chunking( ncid, var_id, 0, chunk_size );
+     (void) nc_def_var_deflate( ncid, var_id, 0, 1, 6 );
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   NADC_FRESCO_WR_NC_REC
+.PURPOSE     write a block of records to Fresco product in netCDF-4 format 
+             (ADAGUC standard)
+.INPUT/OUTPUT
+  call as   NADC_FRESCO_WR_NC_REC( ncid, offs, numRec, rec );
+     input:
+            int ncid               :  netCDF file ID
+            unsigned int offs      :  index of the first record of block
+            unsigned int numRec    :  number of Fresco records in block
+            struct fresco_rec *rec :  Fresco records
+
+.RETURNS     Nothing
+.COMMENTS    the variables are defined by NADC_FRESCO_DEF_NC_REC
+-------------------------*/
+void NADC_FRESCO_WR_NC_REC( int ncid, unsigned int offs, unsigned int numRec,
+			    const struct fresco_rec *rec )
+{
+     register unsigned int ni, nr;
+
+     float  *rbuff = NULL;
+     double *dbuff = NULL;
+
+     struct fresco_meta_rec *mbuff = NULL;
+
+     const size_t nr_byte = NUM_CORNERS * sizeof(float);
+
+     if ( numRec == 0u ) return;
+
+     dbuff = (double *) malloc( numRec * sizeof(double) );
+     if ( dbuff == NULL ) NADC_GOTO_ERROR( NADC_ERR_ALLOC, "dbuff" );
+     rbuff = (float *) malloc( NUM_CORNERS * numRec * sizeof(float) );
+     if ( rbuff == NULL ) NADC_GOTO_ERROR( NADC_ERR_ALLOC, "rbuff" );
      mbuff = (struct fresco_meta_rec *) 
 	  malloc( numRec * sizeof(struct fresco_meta_rec) );
-     if ( mbuff == NULL ) NADC_RETURN_ERROR( NADC_ERR_ALLOC, "mbuff" );
+     if ( mbuff == NULL ) NADC_GOTO_ERROR( NADC_ERR_ALLOC, "mbuff" );
+/*
+ * write dimension scale "time"
+ */
+     for ( nr = 0; nr < numRec; nr++ ) dbuff[nr] = rec[nr].jday;
+     ADAGUC_PUT_VARA( ncid, "time", offs, numRec, 1, dbuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "time" );
+/*
+ * write longitude and latitude of measurements
+ */
+     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].lon_center;
+     ADAGUC_PUT_VARA( ncid, "lon", offs, numRec, 1, rbuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "lon" );
+     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].lat_center;
+     ADAGUC_PUT_VARA( ncid, "lat", offs, numRec, 1, rbuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "lat" );
+/*
+ * write pixel meta-data as compound dataset
+ */
      for ( nr = 0; nr < numRec; nr++ )
 	  (void) memcpy( mbuff+nr, &rec[nr].meta, 
 			 sizeof(struct fresco_meta_rec) );
-     (void) nc_put_var( ncid, var_id, mbuff );
-     free( mbuff );
+     ADAGUC_PUT_VARA( ncid, "tile_properties", offs, numRec, 1, mbuff );
+     if ( IS_ERR_STAT_FATAL ) 
+	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "tile_properties" );
 /*
  * write datasets
  */
-     var_id = ADAGUC_DEF_VAR( ncid, NC_FLOAT, time_id, "cloudFraction", 
-			      "none", "effective cloud fraction", 
-			      "cloud_area_fraction", "cloudFractionError" );
-     if ( IS_ERR_STAT_FATAL )
-          NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "cloudFraction" );
      for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].cloudFraction;
-     (void) nc_def_var_chunking( ncid, var_id, 0, chunk_size );
-     (void) nc_def_var_deflate( ncid, var_id, 0, 1, 6 );
-     (void) nc_put_var_float( ncid, var_id, rbuff );
-     /*+++++++++++++++++++++++++*/
-     var_id = ADAGUC_DEF_VAR( ncid, NC_FLOAT, time_id, "cloudFractionError", 
-			      "none", "error of effective cloud fraction", 
-			      "cloud_area_fraction standard_error", NULL );
-     if ( IS_ERR_STAT_FATAL )
-          NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "cloudFractionError" );
+     ADAGUC_PUT_VARA( ncid, "cloudFraction", offs, numRec, 1, rbuff );
+     if ( IS_ERR_STAT_FATAL ) 
+	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "cloudFraction" );
      for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].cloudFractionError;
-     (void) nc_def_var_chunking( ncid, var_id, 0, chunk_size );
-     (void) nc_def_var_deflate( ncid, var_id, 0, 1, 6 );
-     (void) nc_put_var_float( ncid, var_id, rbuff );
-     /*+++++++++++++++++++++++++*/
-     var_id = ADAGUC_DEF_VAR( ncid, NC_FLOAT, time_id, "cloudTopHeight", 
-			      "m", "cloud height", "cloud_top_altitude", NULL );
-     if ( IS_ERR_STAT_FATAL )
-          NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "cloudTopHeight" );
+     ADAGUC_PUT_VARA( ncid, "cloudFractionError", offs, numRec, 1, rbuff );
+     if ( IS_ERR_STAT_FATAL ) 
+	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "cloudFractionError" );
      for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].cloudTopHeight;
-     (void) nc_def_var_chunking( ncid, var_id, 0, chunk_size );
-     (void) nc_def_var_deflate( ncid, var_id, 0, 1, 6 );
-     (void) nc_put_var_float( ncid, var_id, rbuff );
-    /*+++++++++++++++++++++++++*/
-     var_id = ADAGUC_DEF_VAR( ncid, NC_FLOAT, time_id, "cloudTopPress", 
-			      "hPa", "cloud pressure", 
-			      "air_pressure_at_cloud_top", 
-			      "cloudTopPressError" );
-     if ( IS_ERR_STAT_FATAL )
-          NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "cloudTopPress" );
+     ADAGUC_PUT_VARA( ncid, "cloudTopHeight", offs, numRec, 1, rbuff );
+     if ( IS_ERR_STAT_FATAL ) 
+	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "cloudTopHeight" );
      for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].cloudTopPress;
-     (void) nc_def_var_chunking( ncid, var_id, 0, chunk_size );
-     (void) nc_def_var_deflate( ncid, var_id, 0, 1, 6 );
-     (void) nc_put_var_float( ncid, var_id, rbuff );
-     /*+++++++++++++++++++++++++*/
-     var_id = ADAGUC_DEF_VAR( ncid, NC_FLOAT, time_id, "cloudTopPressError", 
-			      "hPa", "error of cloud pressure", 
-			      "air_pressure_at_cloud_top standard_error",
-			      NULL );
-     if ( IS_ERR_STAT_FATAL )
-          NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "cloudTopPressError" );
+     ADAGUC_PUT_VARA( ncid, "cloudTopPress", offs, numRec, 1, rbuff );
+     if ( IS_ERR_STAT_FATAL ) 
+	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "cloudTopPress" );
      for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].cloudTopPressError;
-     (void) nc_def_var_chunking( ncid, var_id, 0, chunk_size );
-     (void) nc_def_var_deflate( ncid, var_id, 0, 1, 6 );
-     (void) nc_put_var_float( ncid, var_id, rbuff );
-      /*+++++++++++++++++++++++++*/
-     var_id = ADAGUC_DEF_VAR( ncid, NC_FLOAT, time_id, "cloudAlbedo", 
-			      "none", "cloud albedo", 
-			      "cloud_albedo", "cloudAlbedoError" );
-     if ( IS_ERR_STAT_FATAL )
-          NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "cloudAlbedo" );
+     ADAGUC_PUT_VARA( ncid, "cloudTopPressError", offs, numRec, 1, rbuff );
+     if ( IS_ERR_STAT_FATAL ) 
+	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "cloudTopPressError" );
      for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].cloudAlbedo;
-     (void) nc_def_var_chunking( ncid, var_id, 0, chunk_size );
-     (void) nc_def_var_deflate( ncid, var_id, 0, 1, 6 );
-     (void) nc_put_var_float( ncid, var_id, rbuff );
-      /*+++++++++++++++++++++++++*/
-     var_id = ADAGUC_DEF_VAR( ncid, NC_FLOAT, time_id, "cloudAlbedoError", 
-			      "none", "error of cloud albedo", 
-			      "cloud_albedo standard_error", NULL );
-     if ( IS_ERR_STAT_FATAL )
-          NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "cloudAlbedoError" );
+     ADAGUC_PUT_VARA( ncid, "cloudAlbedo", offs, numRec, 1, rbuff );
+     if ( IS_ERR_STAT_FATAL ) 
+	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "cloudAlbedo" );
      for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].cloudAlbedoError;
-     (void) nc_def_var_chunking( ncid, var_id, 0, chunk_size );
-     (void) nc_def_var_deflate( ncid, var_id, 0, 1, 6 );
-     (void) nc_put_var_float( ncid, var_id, rbuff );
-     /*+++++++++++++++++++++++++*/
-     var_id = ADAGUC_DEF_VAR( ncid, NC_FLOAT, time_id, "surfaceAlbedo", 
-			      "none", "wavelength averaged surface albedo", 
-			      "surface_albedo", NULL );
-     if ( IS_ERR_STAT_FATAL )
-          NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "surfaceAlbedo" );
+     ADAGUC_PUT_VARA( ncid, "cloudAlbedoError", offs, numRec, 1, rbuff );
+     if ( IS_ERR_STAT_FATAL ) 
+	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "cloudAlbedoError" );
      for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].surfaceAlbedo;
-     (void) nc_def_var_chunking( ncid, var_id, 0, chunk_size );
-     (void) nc_def_var_deflate( ncid, var_id, 0, 1, 6 );
-     (void) nc_put_var_float( ncid, var_id, rbuff );
-     /*+++++++++++++++++++++++++*/
-     var_id = ADAGUC_DEF_VAR( ncid, NC_FLOAT, time_id, "surfaceHeight", 
-			      "m", "surface heigth", "surface_altitude", NULL );
-     if ( IS_ERR_STAT_FATAL )
-          NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "surfaceHeight" );
+     ADAGUC_PUT_VARA( ncid, "surfaceAlbedo", offs, numRec, 1, rbuff );
+     if ( IS_ERR_STAT_FATAL ) 
+	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "surfaceAlbedo" );
      for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].surfaceHeight;
-     (void) nc_def_var_chunking( ncid, var_id, 0, chunk_size );
-     (void) nc_def_var_deflate( ncid, var_id, 0, 1, 6 );
-     (void) nc_put_var_float( ncid, var_id, rbuff );
-     /*+++++++++++++++++++++++++*/
-     var_id = ADAGUC_DEF_VAR( ncid, NC_FLOAT, time_id, "groundPress", 
-			      "Pa", "assumed surface pressure", 
-			      "surface_air_pressure", NULL );
-     if ( IS_ERR_STAT_FATAL )
-          NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "groundPress" );
+     ADAGUC_PUT_VARA( ncid, "surfaceHeight", offs, numRec, 1, rbuff );
+     if ( IS_ERR_STAT_FATAL ) 
+	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "surfaceHeight" );
      for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].groundPress;
-     (void) nc_def_var_chunking( ncid, var_id, 0, chunk_size );
-     (void) nc_def_var_deflate( ncid, var_id, 0, 1, 6 );
-     (void) nc_put_var_float( ncid, var_id, rbuff );
+     ADAGUC_PUT_VARA( ncid, "groundPress", offs, numRec, 1, rbuff );
+     if ( IS_ERR_STAT_FATAL ) 
+	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "groundPress" );
 /*
  * write longitude and latitude of tile-corners
  */
-     rbuff = (float *) realloc( rbuff, NUM_CORNERS * numRec * sizeof(float) );
-     if ( rbuff == NULL ) NADC_RETURN_ERROR( NADC_ERR_ALLOC, "rbuff" );
-
-     dimids[0] = time_id;
-     dimids[1] = nv_id;
-     retval = nc_def_var( ncid, "lon_bnds", NC_FLOAT, 2, dimids, &var_id );
-     if ( retval != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
-     (void) nc_def_var_chunking( ncid, var_id, 0, chunk_size );
-     (void) nc_def_var_deflate( ncid, var_id, 0, 1, 6 );
      for ( ni = nr = 0; nr < numRec; nr++, ni += NUM_CORNERS )
           (void) memcpy( rbuff+ni, rec[nr].lon_corner, nr_byte );
-     (void) nc_put_var_float( ncid, var_id, rbuff );
-
-     retval = nc_def_var( ncid, "lat_bnds", NC_FLOAT, 2, dimids, &var_id );
-     if ( retval != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
-     (void) nc_def_var_chunking( ncid, var_id, 0, chunk_size );
-     (void) nc_def_var_deflate( ncid, var_id, 0, 1, 6 );
+     ADAGUC_PUT_VARA( ncid, "lon_bnds", offs, numRec, NUM_CORNERS, rbuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "lon_bnds" );
      for ( ni = nr = 0; nr < numRec; nr++, ni += NUM_CORNERS )
           (void) memcpy( rbuff+ni, rec[nr].lat_corner, nr_byte );
-     (void) nc_put_var_float( ncid, var_id, rbuff );
-
+     ADAGUC_PUT_VARA( ncid, "lat_bnds", offs, numRec, NUM_CORNERS, rbuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "lat_bnds" );
  done:
+     if ( mbuff != NULL ) free( mbuff );
      if ( rbuff != NULL ) free( rbuff );
      if ( dbuff != NULL ) free( dbuff );
 }
@@ -20,9 +20,12 @@
 .KEYWORDS    SCIA IMAP CH4
 .LANGUAGE    ANSI C
 .PURPOSE     write IMAP-CH4 product in ADAGUC format
-.COMMENTS    contains SCIA_WR_NC_CH4_META and SCIA_WR_NC_CH4_REC
+.COMMENTS    contains SCIA_WR_NC_CH4_META, SCIA_DEF_NC_CH4_REC
+             and SCIA_WR_NC_CH4_REC
 .ENVIRONment None
-.VERSION     1.2     28-Apr-2011   differentiate between CH4 and HDO code, RvH
+.VERSION     1.3     17-Oct-2026   define the variables once, write the
+                                   records in blocks, RvH
+             1.2     28-Apr-2011   differentiate between CH4 and HDO code, RvH
              1.1     01-Jun-2010   fixed to dataset descriptor bugs, RvH
              1.0     20-Nov-2008   initial release by R. M. van Hees
 ------------------------------------------------------------*/
@@ -171,87 +174,64 @@ void SCIA_WR_NC_CH4_META( int ncid, const struct imap_hdr *hdr )
 }
 
 /*+++++++++++++++++++++++++
-.IDENTifer   SCIA_WR_NC_CH4_REC
-.PURPOSE     write records to IMAP-CH4 product in netCDF-4 (ADAGUC standard)
+.IDENTifer   SCIA_DEF_NC_CH4_REC
+.PURPOSE     define the record variables of IMAP-CH4 product in netCDF-4 
+             (ADAGUC standard)
 .INPUT/OUTPUT
-  call as   SCIA_WR_NC_CH4_REC( ncid, numRec, rec );
+  call as   SCIA_DEF_NC_CH4_REC( ncid, numRec );
      input:
             int ncid              :  netCDF file ID
 	    unsigned int numRec   :  number of IMAP records
-	    struct imap_rec *rec  :  IMAP records
 
 .RETURNS     Nothing
-.COMMENTS    static function
+.COMMENTS    the records are written by SCIA_WR_NC_CH4_REC
 -------------------------*/
-void SCIA_WR_NC_CH4_REC( int ncid, unsigned int numRec,
-			 const struct imap_rec *rec )
+void SCIA_DEF_NC_CH4_REC( int ncid, unsigned int numRec )
 {
-     register unsigned int ni, nr;
-
      int    retval;
      int    time_id, nv_id, dimids[2];
      int    meta_id, var_id;
-     size_t indx;
-
-     float  *rbuff = NULL;
-     double *dbuff = NULL;
-     
-     const size_t nr_byte = NUM_CORNERS * sizeof(float);
 
      if ( numRec == 0 ) return;
 /*
- * write dimension scale "time"
+ * define dimension scale "time"
  */
-     dbuff = (double *) malloc( numRec * sizeof(double) );
-     if ( dbuff == NULL ) NADC_RETURN_ERROR( NADC_ERR_ALLOC, "dbuff" );
-
      retval = nc_def_dim( ncid, "time", (size_t) numRec, &time_id );
      if ( retval != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
      (void) nc_def_var( ncid, "time", NC_DOUBLE, 1, &time_id, &var_id );
      (void) nc_put_att_text( ncid, var_id, "long_name", 4, "time" );
      (void) nc_put_att_text( ncid, var_id, "units", 34, 
 			       "days since 2000-01-01 00:00:00 UTC" );
      (void) nc_put_att_text( ncid, var_id, "calendar", 4, "none" );
-     for ( nr = 0; nr < numRec; nr++ ) dbuff[nr] = rec[nr].jday;
-     if ( (retval = nc_put_var_double( ncid, var_id, dbuff )) != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
 
      if ( (retval = nc_def_dim( ncid, "nv", NUM_CORNERS, &nv_id )) != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
 /*
- * write longitude and latitude of measurements
+ * define longitude and latitude of measurements
  */
-     rbuff = (float *) malloc( numRec * sizeof(float) );
-     if ( rbuff == NULL ) NADC_RETURN_ERROR( NADC_ERR_ALLOC, "rbuff" );
-
      retval = nc_def_var( ncid, "lon", NC_FLOAT, 1, &time_id, &var_id );
      if ( retval != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
      (void) nc_put_att_text( ncid, var_id, "long_name", 9, "longitude" );
      (void) nc_put_att_text( ncid, var_id, "units", 12, "degrees_east" );
      (void) nc_put_att_text( ncid, var_id, "standard_name", 9, "longitude" );
      (void) nc_put_att_text( ncid, var_id, "bounds", 8, "lon_bnds" );
-     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].lon_center;
-     retval = nc_put_var_float( ncid, var_id, rbuff );
 
      retval = nc_def_var( ncid, "lat", NC_FLOAT, 1, &time_id, &var_id );
      if ( retval != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
      (void) nc_put_att_text( ncid, var_id, "long_name", 8, "latitude" );
      (void) nc_put_att_text( ncid, var_id, "units", 13, "degrees_north" );
      (void) nc_put_att_text( ncid, var_id, "standard_name", 8, "latitude" );
      (void) nc_put_att_text( ncid, var_id, "bounds", 8, "lat_bnds" );
-     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].lat_center;
-     if ( (retval = nc_put_var_float( ncid, var_id, rbuff )) != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
 /*
- * write pixel meta-data as compound dataset
+ * define pixel meta-data as compound dataset
  */
      retval = nc_def_compound( ncid, sizeof(struct imap_meta_rec), 
 			       "meta_rec", &meta_id );
      if ( retval != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
      (void) nc_insert_compound( ncid, meta_id, "state_id",
 			 HOFFSET(struct imap_meta_rec, stateID), NC_UBYTE );
      (void) nc_insert_compound( ncid, meta_id, "backscan_flag",
@@ -283,106 +263,167 @@ void SCIA_WR_NC_CH4_REC( int ncid, unsigned int numRec,
      retval = nc_def_var( ncid, "tile_properties", 
 			  meta_id, 1, &time_id, &var_id );
      if ( retval != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
      (void) nc_put_att_text( ncid, var_id, "long_name", 36, 
 			       "pixel_properties_and_retrieval_flags" );
-     for ( indx = 0; indx < (size_t) numRec; indx++ ) {
-	  retval = nc_put_var1( ncid, var_id, &indx, &rec[indx].meta );
-	  if ( retval != NC_NOERR )
-	       NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
-     }
 /*
- * write datasets (CH4, CO2)
+ * define datasets (CH4, CO2)
  */
      var_id = ADAGUC_DEF_VAR( ncid, NC_FLOAT, time_id, "CH4", "cm-2",
 			     "vertical column number density of (CH4)",
 			     "atmosphere_number_content_of_methane_in_air",
 			     "CH4_error CH4_model" );
      if ( IS_ERR_STAT_FATAL ) 
-	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "CH4" );
-     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].ch4_vcd;
-     if ( (retval = nc_put_var_float( ncid, var_id, rbuff )) != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_HDF_WR, "CH4" );
      var_id = ADAGUC_DEF_VAR( ncid, NC_FLOAT, time_id, "CH4_error", "cm-2",
 			     "vertical column number density of CH4 (Error)",
 		  "atmosphere_number_content_of_methane_in_air standard_error",
 			     NULL );
      if ( IS_ERR_STAT_FATAL ) 
-	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "CH4_error" );
-     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].ch4_error;
-     if ( (retval = nc_put_var_float( ncid, var_id, rbuff )) != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_HDF_WR, "CH4_error" );
      var_id = ADAGUC_DEF_VAR( ncid, NC_FLOAT, time_id, "CH4_model", "cm-2",
 			     "vertical column number density of CH4 (Model)",
  		           "atmosphere_number_content_of_methane_in_air model",
 			     NULL );
      if ( IS_ERR_STAT_FATAL ) 
-	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "CH4_model" );
-     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].ch4_model;
-     if ( (retval = nc_put_var_float( ncid, var_id, rbuff )) != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_HDF_WR, "CH4_model" );
      /*+++++++++++++++++++++++++*/
      var_id = ADAGUC_DEF_VAR( ncid, NC_FLOAT, time_id, "CO2", "cm-2",
 			     "vertical column number density of CO2", 
 			 "atmosphere_number_content_of_carbone_dioxide_in_air",
 			     "CO2_error CO2_model" );
      if ( IS_ERR_STAT_FATAL ) 
-	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "CO2" );
-     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].co2_vcd;
-     if ( (retval = nc_put_var_float( ncid, var_id, rbuff )) != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_HDF_WR, "CO2" );
      var_id = ADAGUC_DEF_VAR( ncid, NC_FLOAT, time_id, "CO2_error", "cm-2",
 			     "vertical column number density of CO2 (Error)", 
 	  "atmosphere_number_content_of_carbone_dioxide_in_air standard_error",
 			     NULL );
      if ( IS_ERR_STAT_FATAL ) 
-	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "CO2_error" );
-     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].co2_error;
-     if ( (retval = nc_put_var_float( ncid, var_id, rbuff )) != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_HDF_WR, "CO2_error" );
      var_id = ADAGUC_DEF_VAR( ncid, NC_FLOAT, time_id, "CO2_model", "cm-2",
 			     "vertical column number density of CO2 (Model)", 
  	           "atmosphere_number_content_of_carbone_dioxide_in_air model",
 			     NULL );
      if ( IS_ERR_STAT_FATAL ) 
-	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "CO2_model" );
-     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].co2_model;
-     if ( (retval = nc_put_var_float( ncid, var_id, rbuff )) != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_HDF_WR, "CO2_model" );
      /*+++++++++++++++++++++++++*/
      var_id = ADAGUC_DEF_VAR( ncid, NC_FLOAT, time_id, "xVMR_CH4", "ppb",
 			      "vertical mixing ratio of CH4",
 			      "vertical_mixing_ratio_of_methane_in_air",
 			      NULL );
      if ( IS_ERR_STAT_FATAL ) 
-	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "xVMR_CH4" );
-     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].ch4_vmr;
-     if ( (retval = nc_put_var_float( ncid, var_id, rbuff )) != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_HDF_WR, "xVMR_CH4" );
 /*
- * write longitude and latitude bounding boxes
+ * define longitude and latitude bounding boxes
  */
-     rbuff = (float *) realloc( rbuff, NUM_CORNERS * numRec * sizeof(float) );
-     if ( rbuff == NULL ) NADC_RETURN_ERROR( NADC_ERR_ALLOC, "rbuff" );
-
      dimids[0] = time_id;
      dimids[1] = nv_id;
      retval = nc_def_var( ncid, "lon_bnds", NC_FLOAT, 2, dimids, &var_id );
      if ( retval != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
-     for ( ni = nr = 0; nr < numRec; nr++, ni += NUM_CORNERS )
-	  (void) memcpy( rbuff+ni, rec[nr].lon_corner, nr_byte );
-     if ( (retval = nc_put_var_float( ncid, var_id, rbuff )) != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
 
      retval = nc_def_var( ncid, "lat_bnds", NC_FLOAT, 2, dimids, &var_id );
      if ( retval != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   SCIA_WR_NC_CH4_REC
+.PURPOSE     write a block of records to IMAP-CH4 product in netCDF-4 
+             (ADAGUC standard)
+.INPUT/OUTPUT
+  call as   SCIA_WR_NC_CH4_REC( ncid, offs, numRec, rec );
+     input:
+            int ncid              :  netCDF file ID
+	    unsigned int offs     :  index of the first record of block
+	    unsigned int numRec   :  number of IMAP records in block
+	    struct imap_rec *rec  :  IMAP records
+
+.RETURNS     Nothing
+.COMMENTS    the variables are defined by SCIA_DEF_NC_CH4_REC
+-------------------------*/
+void SCIA_WR_NC_CH4_REC( int ncid, unsigned int offs, unsigned int numRec,
+			 const struct imap_rec *rec )
+{
+     register unsigned int ni, nr;
+
+     float  *rbuff = NULL;
+     double *dbuff = NULL;
+
+     struct imap_meta_rec *mbuff = NULL;
+
+     const size_t nr_byte = NUM_CORNERS * sizeof(float);
+
+     if ( numRec == 0u ) return;
+
+     dbuff = (double *) malloc( numRec * sizeof(double) );
+     if ( dbuff == NULL ) NADC_GOTO_ERROR( NADC_ERR_ALLOC, "dbuff" );
+     rbuff = (float *) malloc( NUM_CORNERS * numRec * sizeof(float) );
+     if ( rbuff == NULL ) NADC_GOTO_ERROR( NADC_ERR_ALLOC, "rbuff" );
+     mbuff = (struct imap_meta_rec *) 
+	  malloc( numRec * sizeof(struct imap_meta_rec) );
+     if ( mbuff == NULL ) NADC_GOTO_ERROR( NADC_ERR_ALLOC, "mbuff" );
+/*
+ * write dimension scale "time"
+ */
+     for ( nr = 0; nr < numRec; nr++ ) dbuff[nr] = rec[nr].jday;
+     ADAGUC_PUT_VARA( ncid, "time", offs, numRec, 1, dbuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "time" );
+/*
+ * write longitude and latitude of measurements
+ */
+     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].lon_center;
+     ADAGUC_PUT_VARA( ncid, "lon", offs, numRec, 1, rbuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "lon" );
+     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].lat_center;
+     ADAGUC_PUT_VARA( ncid, "lat", offs, numRec, 1, rbuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "lat" );
+/*
+ * write pixel meta-data as compound dataset
+ */
+     for ( nr = 0; nr < numRec; nr++ )
+	  (void) memcpy( mbuff+nr, &rec[nr].meta, 
+			 sizeof(struct imap_meta_rec) );
+     ADAGUC_PUT_VARA( ncid, "tile_properties", offs, numRec, 1, mbuff );
+     if ( IS_ERR_STAT_FATAL ) 
+	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "tile_properties" );
+/*
+ * write datasets (CH4, CO2)
+ */
+     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].ch4_vcd;
+     ADAGUC_PUT_VARA( ncid, "CH4", offs, numRec, 1, rbuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "CH4" );
+     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].ch4_error;
+     ADAGUC_PUT_VARA( ncid, "CH4_error", offs, numRec, 1, rbuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "CH4_error" );
+     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].ch4_model;
+     ADAGUC_PUT_VARA( ncid, "CH4_model", offs, numRec, 1, rbuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "CH4_model" );
+     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].co2_vcd;
+     ADAGUC_PUT_VARA( ncid, "CO2", offs, numRec, 1, rbuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "CO2" );
+     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].co2_error;
+     ADAGUC_PUT_VARA( ncid, "CO2_error", offs, numRec, 1, rbuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "CO2_error" );
+     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].co2_model;
+     ADAGUC_PUT_VARA( ncid, "CO2_model", offs, numRec, 1, rbuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "CO2_model" );
+     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].ch4_vmr;
+     ADAGUC_PUT_VARA( ncid, "xVMR_CH4", offs, numRec, 1, rbuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "xVMR_CH4" );
+/*
+ * write longitude and latitude bounding boxes
+ */
+     for ( ni = nr = 0; nr < numRec; nr++, ni += NUM_CORNERS )
+	  (void) memcpy( rbuff+ni, rec[nr].lon_corner, nr_byte );
+     ADAGUC_PUT_VARA( ncid, "lon_bnds", offs, numRec, NUM_CORNERS, rbuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "lon_bnds" );
      for ( ni = nr = 0; nr < numRec; nr++, ni += NUM_CORNERS )
 	  (void) memcpy( rbuff+ni, rec[nr].lat_corner, nr_byte );
-     if ( (retval = nc_put_var_float( ncid, var_id, rbuff )) != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+     ADAGUC_PUT_VARA( ncid, "lat_bnds", offs, numRec, NUM_CORNERS, rbuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "lat_bnds" );
  done:
+     if ( mbuff != NULL ) free( mbuff );
      if ( rbuff != NULL ) free( rbuff );
      if ( dbuff != NULL ) free( dbuff );
 }
@@ -20,9 +20,12 @@
 .KEYWORDS    SCIA IMAP HDO
 .LANGUAGE    ANSI C
 .PURPOSE     write IMAP-HDO product in ADAGUC format
-.COMMENTS    contains SCIA_WR_NC_HDO_META and SCIA_WR_NC_HDO_REC
+.COMMENTS    contains SCIA_WR_NC_HDO_META, SCIA_DEF_NC_HDO_REC
+             and SCIA_WR_NC_HDO_REC
 .ENVIRONment None
-.VERSION     1.0     28-Apr-2011   initial release by R. M. van Hees
+.VERSION     1.1     17-Oct-2026   define the variables once, write the
+                                   records in blocks, RvH
+             1.0     28-Apr-2011   initial release by R. M. van Hees
 ------------------------------------------------------------*/
 /*
  * Define _ISOC99_SOURCE to indicate
@@ -169,87 +172,64 @@ void SCIA_WR_NC_HDO_META( int ncid, const struct imap_hdr *hdr )
 }
 
 /*+++++++++++++++++++++++++
-.IDENTifer   SCIA_WR_NC_HDO_REC
-.PURPOSE     write records to IMAP-HDO product in netCDF-4 (ADAGUC standard)
+.IDENTifer   SCIA_DEF_NC_HDO_REC
+.PURPOSE     define the record variables of IMAP-HDO product in netCDF-4 
+             (ADAGUC standard)
 .INPUT/OUTPUT
-  call as   SCIA_WR_NC_HDO_REC( ncid, numRec, rec );
+  call as   SCIA_DEF_NC_HDO_REC( ncid, numRec );
      input:
             int ncid              :  netCDF file ID
 	    unsigned int numRec   :  number of IMAP records
-	    struct imap_rec *rec  :  IMAP records
 
 .RETURNS     Nothing
-.COMMENTS    static function
+.COMMENTS    the records are written by SCIA_WR_NC_HDO_REC
 -------------------------*/
-void SCIA_WR_NC_HDO_REC( int ncid, unsigned int numRec,
-			 const struct imap_rec *rec )
+void SCIA_DEF_NC_HDO_REC( int ncid, unsigned int numRec )
 {
-     register unsigned int ni, nr;
-
      int    retval;
      int    time_id, nv_id, dimids[2];
      int    meta_id, var_id;
-     size_t indx;
-
-     float  *rbuff = NULL;
-     double *dbuff = NULL;
-     
-     const size_t nr_byte = NUM_CORNERS * sizeof(float);
 
      if ( numRec == 0 ) return;
 /*
- * write dimension scale "time"
+ * define dimension scale "time"
  */
-     dbuff = (double *) malloc( numRec * sizeof(double) );
-     if ( dbuff == NULL ) NADC_RETURN_ERROR( NADC_ERR_ALLOC, "dbuff" );
-
      retval = nc_def_dim( ncid, "time", (size_t) numRec, &time_id );
      if ( retval != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
      (void) nc_def_var( ncid, "time", NC_DOUBLE, 1, &time_id, &var_id );
      (void) nc_put_att_text( ncid, var_id, "long_name", 4, "time" );
      (void) nc_put_att_text( ncid, var_id, "units", 34, 
 			       "days since 2000-01-01 00:00:00 UTC" );
      (void) nc_put_att_text( ncid, var_id, "calendar", 4, "none" );
-     for ( nr = 0; nr < numRec; nr++ ) dbuff[nr] = rec[nr].jday;
-     if ( (retval = nc_put_var_double( ncid, var_id, dbuff )) != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
 
      if ( (retval = nc_def_dim( ncid, "nv", NUM_CORNERS, &nv_id )) != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
 /*
- * write longitude and latitude of measurements
+ * define longitude and latitude of measurements
  */
-     rbuff = (float *) malloc( numRec * sizeof(float) );
-     if ( rbuff == NULL ) NADC_RETURN_ERROR( NADC_ERR_ALLOC, "rbuff" );
-
      retval = nc_def_var( ncid, "lon", NC_FLOAT, 1, &time_id, &var_id );
      if ( retval != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
      (void) nc_put_att_text( ncid, var_id, "long_name", 9, "longitude" );
      (void) nc_put_att_text( ncid, var_id, "units", 12, "degrees_east" );
      (void) nc_put_att_text( ncid, var_id, "standard_name", 9, "longitude" );
      (void) nc_put_att_text( ncid, var_id, "bounds", 8, "lon_bnds" );
-     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].lon_center;
-     retval = nc_put_var_float( ncid, var_id, rbuff );
 
      retval = nc_def_var( ncid, "lat", NC_FLOAT, 1, &time_id, &var_id );
      if ( retval != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
      (void) nc_put_att_text( ncid, var_id, "long_name", 8, "latitude" );
      (void) nc_put_att_text( ncid, var_id, "units", 13, "degrees_north" );
      (void) nc_put_att_text( ncid, var_id, "standard_name", 8, "latitude" );
      (void) nc_put_att_text( ncid, var_id, "bounds", 8, "lat_bnds" );
-     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].lat_center;
-     if ( (retval = nc_put_var_float( ncid, var_id, rbuff )) != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
 /*
- * write pixel meta-data as compound dataset
+ * define pixel meta-data as compound dataset
  */
      retval = nc_def_compound( ncid, sizeof(struct imap_meta_rec), 
 			       "meta_rec", &meta_id );
      if ( retval != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
      (void) nc_insert_compound( ncid, meta_id, "state_id",
 			 HOFFSET(struct imap_meta_rec, stateID), NC_UBYTE );
      (void) nc_insert_compound( ncid, meta_id, "backscan_flag",
@@ -281,102 +261,164 @@ void SCIA_WR_NC_HDO_REC( int ncid, unsigned int numRec,
      retval = nc_def_var( ncid, "tile_properties", 
 			  meta_id, 1, &time_id, &var_id );
      if ( retval != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
      (void) nc_put_att_text( ncid, var_id, "long_name", 36, 
 			       "pixel_properties_and_retrieval_flags" );
-     for ( indx = 0; indx < (size_t) numRec; indx++ ) {
-	  retval = nc_put_var1( ncid, var_id, &indx, &rec[indx].meta );
-	  if ( retval != NC_NOERR )
-	       NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
-     }
 /*
- * write datasets (HDO, CO2)
+ * define datasets (HDO, CO2)
  */
      var_id = ADAGUC_DEF_VAR( ncid, NC_FLOAT, time_id, "HDO", "cm-2",
 			     "vertical column number density of (HDO)",
 			     "atmosphere_number_content_of_hdo_in_air",
 			     "HDO_error" );
      if ( IS_ERR_STAT_FATAL ) 
-	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "HDO" );
-     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].hdo_vcd;
-     if ( (retval = nc_put_var_float( ncid, var_id, rbuff )) != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_HDF_WR, "HDO" );
      var_id = ADAGUC_DEF_VAR( ncid, NC_FLOAT, time_id, "HDO_error", "cm-2",
 			     "vertical column number density of HDO (Error)",
 		    "atmosphere_number_content_of_hdo_in_air standard_error",
 			     NULL );
      if ( IS_ERR_STAT_FATAL ) 
-	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "HDO_error" );
-     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].hdo_error;
-     if ( (retval = nc_put_var_float( ncid, var_id, rbuff )) != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_HDF_WR, "HDO_error" );
      /*+++++++++++++++++++++++++*/
      var_id = ADAGUC_DEF_VAR( ncid, NC_FLOAT, time_id, "H2O", "cm-2",
 			     "vertical column number density of water", 
 			   "atmosphere_number_content_of_water_in_air",
 			     "H2O_error H2O_model" );
      if ( IS_ERR_STAT_FATAL ) 
-	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "H2O" );
-     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].h2o_vcd;
-     if ( (retval = nc_put_var_float( ncid, var_id, rbuff )) != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_HDF_WR, "H2O" );
      var_id = ADAGUC_DEF_VAR( ncid, NC_FLOAT, time_id, "H2O_error", "cm-2",
 			"vertical column number density of water (Error)", 
 	       "atmosphere_number_content_of_water_in_air standard_error",
 			     NULL );
      if ( IS_ERR_STAT_FATAL ) 
-	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "H2O_error" );
-     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].h2o_error;
-     if ( (retval = nc_put_var_float( ncid, var_id, rbuff )) != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_HDF_WR, "H2O_error" );
      var_id = ADAGUC_DEF_VAR( ncid, NC_FLOAT, time_id, "H2O_model", "cm-2",
 			"vertical column number density of water (ECMWF)", 
 			"atmosphere_number_content_of_water_in_air model",
 			     NULL );
      if ( IS_ERR_STAT_FATAL ) 
-	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "H2O_model" );
-     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].h2o_model;
-     if ( (retval = nc_put_var_float( ncid, var_id, rbuff )) != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_HDF_WR, "H2O_model" );
      /*+++++++++++++++++++++++++*/
      var_id = ADAGUC_DEF_VAR( ncid, NC_FLOAT, time_id, "delta_d", "per mil",
 			     "delta D", "delta D", "delta_d_error" );
      if ( IS_ERR_STAT_FATAL ) 
-	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "delta_d" );
-     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].delta_d;
-     if ( (retval = nc_put_var_float( ncid, var_id, rbuff )) != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_HDF_WR, "delta_d" );
      var_id = ADAGUC_DEF_VAR( ncid, NC_FLOAT, time_id, "delta_d_error", 
 			     "per mil", "delta D (error)", "delta D", NULL );
      if ( IS_ERR_STAT_FATAL ) 
-	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "delta_d_error" );
-     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].delta_d_error;
-     if ( (retval = nc_put_var_float( ncid, var_id, rbuff )) != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_HDF_WR, "delta_d_error" );
 /*
- * write longitude and latitude bounding boxes
+ * define longitude and latitude bounding boxes
  */
-     rbuff = (float *) realloc( rbuff, NUM_CORNERS * numRec * sizeof(float) );
-     if ( rbuff == NULL ) NADC_RETURN_ERROR( NADC_ERR_ALLOC, "rbuff" );
-
      dimids[0] = time_id;
      dimids[1] = nv_id;
      retval = nc_def_var( ncid, "lon_bnds", NC_FLOAT, 2, dimids, &var_id );
      if ( retval != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
-     for ( ni = nr = 0; nr < numRec; nr++, ni += NUM_CORNERS )
-	  (void) memcpy( rbuff+ni, rec[nr].lon_corner, nr_byte );
-     if ( (retval = nc_put_var_float( ncid, var_id, rbuff )) != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
 
      retval = nc_def_var( ncid, "lat_bnds", NC_FLOAT, 2, dimids, &var_id );
      if ( retval != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   SCIA_WR_NC_HDO_REC
+.PURPOSE     write a block of records to IMAP-HDO product in netCDF-4 
+             (ADAGUC standard)
+.INPUT/OUTPUT
+  call as   SCIA_WR_NC_HDO_REC( ncid, offs, numRec, rec );
+     input:
+            int ncid              :  netCDF file ID
+	    unsigned int offs     :  index of the first record of block
+	    unsigned int numRec   :  number of IMAP records in block
+	    struct imap_rec *rec  :  IMAP records
+
+.RETURNS     Nothing
+.COMMENTS    the variables are defined by SCIA_DEF_NC_HDO_REC
+-------------------------*/
+void SCIA_WR_NC_HDO_REC( int ncid, unsigned int offs, unsigned int numRec,
+			 const struct imap_rec *rec )
+{
+     register unsigned int ni, nr;
+
+     float  *rbuff = NULL;
+     double *dbuff = NULL;
+
+     struct imap_meta_rec *mbuff = NULL;
+
+     const size_t nr_byte = NUM_CORNERS * sizeof(float);
+
+     if ( numRec == 0u ) return;
+
+     dbuff = (double *) malloc( numRec * sizeof(double) );
+     if ( dbuff == NULL ) NADC_GOTO_ERROR( NADC_ERR_ALLOC, "dbuff" );
+     rbuff = (float *) malloc( NUM_CORNERS * numRec * sizeof(float) );
+     if ( rbuff == NULL ) NADC_GOTO_ERROR( NADC_ERR_ALLOC, "rbuff" );
+     mbuff = (struct imap_meta_rec *) 
+	  malloc( numRec * sizeof(struct imap_meta_rec) );
+     if ( mbuff == NULL ) NADC_GOTO_ERROR( NADC_ERR_ALLOC, "mbuff" );
+/*
+ * write dimension scale "time"
+ */
+     for ( nr = 0; nr < numRec; nr++ ) dbuff[nr] = rec[nr].jday;
+     ADAGUC_PUT_VARA( ncid, "time", offs, numRec, 1, dbuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "time" );
+/*
+ * write longitude and latitude of measurements
+ */
+     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].lon_center;
+     ADAGUC_PUT_VARA( ncid, "lon", offs, numRec, 1, rbuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "lon" );
+     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].lat_center;
+     ADAGUC_PUT_VARA( ncid, "lat", offs, numRec, 1, rbuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "lat" );
+/*
+ * write pixel meta-data as compound dataset
+ */
+     for ( nr = 0; nr < numRec; nr++ )
+	  (void) memcpy( mbuff+nr, &rec[nr].meta, 
+			 sizeof(struct imap_meta_rec) );
+     ADAGUC_PUT_VARA( ncid, "tile_properties", offs, numRec, 1, mbuff );
+     if ( IS_ERR_STAT_FATAL ) 
+	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "tile_properties" );
+/*
+ * write datasets (HDO, H2O)
+ */
+     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].hdo_vcd;
+     ADAGUC_PUT_VARA( ncid, "HDO", offs, numRec, 1, rbuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "HDO" );
+     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].hdo_error;
+     ADAGUC_PUT_VARA( ncid, "HDO_error", offs, numRec, 1, rbuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "HDO_error" );
+     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].h2o_vcd;
+     ADAGUC_PUT_VARA( ncid, "H2O", offs, numRec, 1, rbuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "H2O" );
+     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].h2o_error;
+     ADAGUC_PUT_VARA( ncid, "H2O_error", offs, numRec, 1, rbuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "H2O_error" );
+     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].h2o_model;
+     ADAGUC_PUT_VARA( ncid, "H2O_model", offs, numRec, 1, rbuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "H2O_model" );
+     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].delta_d;
+     ADAGUC_PUT_VARA( ncid, "delta_d", offs, numRec, 1, rbuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "delta_d" );
+     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].delta_d_error;
+     ADAGUC_PUT_VARA( ncid, "delta_d_error", offs, numRec, 1, rbuff );
+     if ( IS_ERR_STAT_FATAL ) 
+	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "delta_d_error" );
+/*
+ * write longitude and latitude bounding boxes
+ */
+     for ( ni = nr = 0; nr < numRec; nr++, ni += NUM_CORNERS )
+	  (void) memcpy( rbuff+ni, rec[nr].lon_corner, nr_byte );
+     ADAGUC_PUT_VARA( ncid, "lon_bnds", offs, numRec, NUM_CORNERS, rbuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "lon_bnds" );
      for ( ni = nr = 0; nr < numRec; nr++, ni += NUM_CORNERS )
 	  (void) memcpy( rbuff+ni, rec[nr].lat_corner, nr_byte );
-     if ( (retval = nc_put_var_float( ncid, var_id, rbuff )) != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+     ADAGUC_PUT_VARA( ncid, "lat_bnds", offs, numRec, NUM_CORNERS, rbuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "lat_bnds" );
  done:
+     if ( mbuff != NULL ) free( mbuff );
      if ( rbuff != NULL ) free( rbuff );
      if ( dbuff != NULL ) free( dbuff );
 }
@@ -31,7 +31,8 @@
 .RETURNS     Nothing, error status passed by global variable ``nadc_stat''
 .COMMENTS    None
 .ENVIRONment None
-.VERSION     1.0     08-Dec-2008   initial release by R. M. van Hees
+.VERSION     1.1     17-Oct-2026   bulk ingest of tiles using COPY, RvH
+             1.0     08-Dec-2008   initial release by R. M. van Hees
 ------------------------------------------------------------*/
 /*
  * Define _ISOC99_SOURCE to indicate
@@ -51,6 +52,8 @@
 #define __IMAP_CH4_PRODUCT
 #include <nadc_imap.h>
 
+#include <_nadc_sql_copy.inc>
+
 /*+++++ Macros +++++*/
 	/* NONE */
 
@@ -58,13 +61,14 @@
 #define SQL_STR_SIZE   384
 
 #define META_TBL_NAME "meta_imap_ch4"
-#define TILE_TBL_NAME "tile_imap_ch4"
 
-#define SQL_INSERT_TILE \
-"INSERT INTO %s (pk_tile,fk_meta,julianDay,integrationTime,meanElevation,\
- VCD_CH4,VCD_CH4_ERROR,VCD_CO2,VCD_CO2_ERROR,xVMR_CH4,tile) \
- VALUES (%lld,%d,%.11f,%d,%.3g,%.5g,%.5g,%.5g,%.5g,%.5g,ST_GeomFromText(\
- \'POLYGON((%.6f %.6f,%.6f %.6f,%.6f %.6f,%.6f %.6f,%.6f %.6f))\', 4326))"
+#define TILE_TBL_COLUMNS \
+"tile_imap_ch4 (pk_tile,fk_meta,julianDay,integrationTime,\
+ meanElevation,VCD_CH4,VCD_CH4_ERROR,VCD_CO2,VCD_CO2_ERROR,xVMR_CH4,tile)"
+
+#define SQL_COPY_TILE \
+"%lld\t%d\t%.11f\t%d\t%.3g\t%.5g\t%.5g\t%.5g\t%.5g\t%.5g\t\
+SRID=4326;POLYGON((%.6f %.6f,%.6f %.6f,%.6f %.6f,%.6f %.6f,%.6f %.6f))\n"
 
 #define NINT(a) ((a) >= 0.f ? (int)((a)+0.5) : (int)((a)-0.5))
 
@@ -82,87 +86,63 @@ void SCIA_WR_SQL_CH4_TILE( PGconn *conn, const char *prodName,
      register unsigned int nr;
      register unsigned int affectedRows = 0u;
 
-     char   sql_query[SQL_STR_SIZE], cbuff[SQL_STR_SIZE];
+     char   cbuff[SQL_STR_SIZE];
 
-     char   *pntr;
-     int    nrow, numChar, meta_id;
+     int    meta_id;
 
-     long long tile_id;
+     long long *tile_id = NULL;
 
-     PGresult *res;
+     struct sql_copy_rec copy;
 /*
  * check if product is already in database
  */
-     (void) snprintf( sql_query, SQL_STR_SIZE, 
-		      "SELECT pk_meta FROM %s WHERE name=\'%s\'", 
-		      META_TBL_NAME, prodName );
-     res = PQexec( conn, sql_query );
-     if ( PQresultStatus( res ) != PGRES_TUPLES_OK ) {
-          NADC_GOTO_ERROR( NADC_ERR_SQL, PQresultErrorMessage(res) );
-     }
-     if ( (nrow = PQntuples( res )) == 0 ) {
-          NADC_GOTO_ERROR( NADC_ERR_FATAL, prodName );
-     }
-     pntr = PQgetvalue( res, 0, 0 );
-     meta_id = (int) strtol( pntr, (char **) NULL, 10 );     
-     PQclear( res );
+     meta_id = NADC_SQL_GET_META_ID( conn, META_TBL_NAME, prodName );
+     if ( IS_ERR_STAT_FATAL ) goto done;
+     if ( num_rec == 0u ) goto done;
+/*
+ * obtain values for serial pk_tile (one round trip)
+ */
+     tile_id = (long long *) malloc( num_rec * sizeof(long long) );
+     if ( tile_id == NULL ) NADC_GOTO_ERROR( NADC_ERR_ALLOC, "tile_id" );
+     NADC_SQL_NEXTVAL( conn, "tile_imap_ch4_pk_tile_seq", num_rec, tile_id );
+     if ( IS_ERR_STAT_FATAL ) goto done;
 /*
  * Start a transaction block
  */
-     res = PQexec( conn, "BEGIN" );
-     if ( PQresultStatus( res ) != PGRES_COMMAND_OK )
-          NADC_GOTO_ERROR( NADC_ERR_SQL, PQresultErrorMessage(res) );
-     PQclear( res );
+     NADC_SQL_COMMAND( conn, "BEGIN" );
+     if ( IS_ERR_STAT_FATAL ) goto done;
 /*
- * insert all tiles in products
+ * stream all tiles of the product to the server
  */
-     for ( nr = 0; nr < num_rec; nr++ ) {
-	  /* obtain next value for serial pk_tile */
-	  res = PQexec( conn,
-			"SELECT nextval(\'tile_imap_ch4_pk_tile_seq\')" );
-	  if ( PQresultStatus( res ) != PGRES_TUPLES_OK )
-	       NADC_GOTO_ERROR( NADC_ERR_SQL, PQresultErrorMessage(res) );
-	  pntr = PQgetvalue( res, 0, 0 );
-	  tile_id = strtoll( pntr, (char **) NULL, 10 );
-	  PQclear( res );
-
-	  numChar = snprintf( sql_query, SQL_STR_SIZE, SQL_INSERT_TILE, 
-			      TILE_TBL_NAME, tile_id, meta_id, rec[nr].jday,
-			      NINT(16 * rec[nr].meta.intg_time),
-			      rec[nr].meta.elev, 
-			      rec[nr].ch4_vcd, rec[nr].ch4_error,
-			      rec[nr].co2_vcd, rec[nr].co2_error,
-			      rec[nr].ch4_vmr,
-			      rec[nr].lon_corner[0],rec[nr].lat_corner[0],
-			      rec[nr].lon_corner[1],rec[nr].lat_corner[1],
-			      rec[nr].lon_corner[2],rec[nr].lat_corner[2],
-			      rec[nr].lon_corner[3],rec[nr].lat_corner[3],
-			      rec[nr].lon_corner[0],rec[nr].lat_corner[0] );
-
-  	  (void) fprintf( stderr, "%s [%-d]\n", sql_query, numChar );
-	  if ( numChar >= SQL_STR_SIZE )
-	       NADC_RETURN_ERROR( NADC_ERR_STRLEN, "sql_query" );
-	  res = PQexec( conn, sql_query );
-	  if ( PQresultStatus( res ) != PGRES_COMMAND_OK ) {
-	       NADC_ERROR( NADC_ERR_SQL, PQresultErrorMessage(res) );
-	       PQclear( res );
-	       res = PQexec( conn, "ROLLBACK" );
-	       if ( PQresultStatus( res ) != PGRES_COMMAND_OK )
-		    NADC_ERROR( NADC_ERR_SQL, PQresultErrorMessage(res) );
-	       goto done;
-	  }
-	  PQclear( res );
-
-	  affectedRows += 1;
+     NADC_SQL_COPY_BEGIN( conn, TILE_TBL_COLUMNS, &copy );
+     for ( nr = 0; nr < num_rec && ! IS_ERR_STAT_FATAL; nr++ ) {
+	  NADC_SQL_COPY_ROW( &copy, SQL_COPY_TILE, tile_id[nr], meta_id,
+			     rec[nr].jday, NINT(16 * rec[nr].meta.intg_time),
+			     rec[nr].meta.elev, 
+			     rec[nr].ch4_vcd, rec[nr].ch4_error,
+			     rec[nr].co2_vcd, rec[nr].co2_error,
+			     rec[nr].ch4_vmr,
+			     rec[nr].lon_corner[0], rec[nr].lat_corner[0],
+			     rec[nr].lon_corner[1], rec[nr].lat_corner[1],
+			     rec[nr].lon_corner[2], rec[nr].lat_corner[2],
+			     rec[nr].lon_corner[3], rec[nr].lat_corner[3],
+			     rec[nr].lon_corner[0], rec[nr].lat_corner[0] );
      }
+     if ( IS_ERR_STAT_FATAL )
+	  NADC_SQL_COPY_ABORT( &copy );
+     else
+	  NADC_SQL_COPY_END( &copy );
 /*
  * end the transaction
  */
-     res = PQexec( conn, "COMMIT" );
-     if ( PQresultStatus( res ) != PGRES_COMMAND_OK )
-          NADC_ERROR( NADC_ERR_SQL, PQresultErrorMessage(res) );
+     if ( IS_ERR_STAT_FATAL ) {
+	  NADC_SQL_COMMAND( conn, "ROLLBACK" );
+	  goto done;
+     }
+     NADC_SQL_COMMAND( conn, "COMMIT" );
+     if ( ! IS_ERR_STAT_FATAL ) affectedRows = copy.num_rows;
  done:
-     PQclear( res );
+     if ( tile_id != NULL ) free( tile_id );
      (void) snprintf( cbuff, SQL_STR_SIZE, "affectedRows=%-u", affectedRows );
      NADC_ERROR( NADC_ERR_NONE, cbuff );
 }
@@ -27,7 +27,10 @@
 .RETURNS     non-negative on success, negative on failure
 .COMMENTS    None
 .ENVIRONment None
-.VERSION     1.2     07-Apr-2011   differentiate between CO and H2O code, RvH
+.VERSION     1.4     17-Oct-2026   read products by worker processes, write
+                                   the merged records in blocks, RvH
+             1.3     17-Oct-2026   merge products in time, no HPSORT, RvH
+             1.2     07-Apr-2011   differentiate between CO and H2O code, RvH
              1.1     12-Oct-2009   improved product, fixed several bugs, RvH
              1.0     21-Oct-2008   initial release by R. M. van Hees
 ------------------------------------------------------------*/
@@ -41,6 +44,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stddef.h>
 #include <math.h>
 
 #include <hdf5.h>
@@ -60,77 +64,6 @@
 	/* NONE */
 
 /*+++++++++++++++++++++++++ Static Functions +++++++++++++++++++++++*/
-/*+++++++++++++++++++++++++
-.IDENTifer   HPSORT
-.PURPOSE     sort an array into assending order using the Heapsort algorithm
-.INPUT/OUTPUT
-  call as   HPSORT( dim, jday, rec );
-     input:
-            unsigned int dim       :    dimension of the array to be sorted
-    output:
-            double       *jday     :    array to be sorted
-	    struct imlm_rec *rec :    array of records to be sorted as jday
-
-.RETURNS     nothing
-.COMMENTS    static function
-             Heapsort algorithm in a N log_2 N routine
--------------------------*/
-static
-void HPSORT( unsigned int dim, double *jday, struct imlm_rec *rec )
-{
-     register unsigned int ii,  ir, jj, ll;
-
-     double jbuff;
-     struct imlm_rec buff;
-
-     const size_t sizeof_imlm_rec = sizeof(struct imlm_rec);
-/*
- * check dimension of data arrays
- */
-     if ( dim <= 1 ) return;
-/*
- * initialization
- */
-     jday--; rec--;
-     ll = (dim >> 1) + 1;
-     ir = dim;
-
-     while ( TRUE ) {
-	  if ( ll > 1 ) {                          /* still in hirring phase */
-	       jbuff = jday[--ll];
-	       (void) memcpy( &buff, rec+ll, sizeof_imlm_rec );
-	  } else {                      /* in retirement-and-promotion phase */
-	       jbuff = jday[ir];              /* clear space at end of array */
-	       (void) memcpy( &buff, rec+ir, sizeof_imlm_rec );
-	       jday[ir] = jday[1];     /* retire the top of the heap into it */
-	       (void) memcpy( rec+ir, rec+1, sizeof_imlm_rec );
-	       if ( --ir == 1 ) {            /* done with the last promotion */
-		    jday[1] = jbuff;    /* the least competent worker of all */
-		    (void) memcpy( rec+1, &buff, sizeof_imlm_rec );
-		    break;
-	       }
-	  }
-/*
- * whether in the hiring phase or promotion phase, we here set up to shift
- * down element jbuff to its proper level
- */
-	  ii = ll;
-	  jj = ll + ll;
-	  while ( jj <= ir ) {
-	       if ( jj < ir && jday[jj] < jday[jj+1] ) jj++;
-	       if ( jbuff < jday[jj] ) {                     /* demote jbuff */
-		    jday[ii] = jday[jj];
-		    (void) memcpy( rec+ii, rec+jj, sizeof_imlm_rec );
-		    ii = jj;
-		    jj <<= 1;
-	       } else
-		    jj = ir + 1;       /* set jj to terminate the shift down */
-	  }
-	  jday[ii] = jbuff;                       /* put jbuff into its slot */
-	  (void) memcpy( rec+ii, &buff, sizeof_imlm_rec );
-     }
-}
-
 static
 unsigned int SELECT_IMLM_RECORDS( unsigned int numRec, struct imlm_rec *rec )
 {
@@ -180,23 +113,76 @@ unsigned int SELECT_IMLM_RECORDS( unsigned int numRec, struct imlm_rec *rec )
      return num;
 }
 
+/*+++++++++++++++++++++++++
+.IDENTifer   RD_IMLM_PRODUCT
+.PURPOSE     read header and selected records of one IMLM-CO product
+.INPUT/OUTPUT
+  call as   res = RD_IMLM_PRODUCT( flname, hdr, &rec, &numRec );
+     input:
+            char *flname         :  name of the product (ASCII or netCDF)
+    output:
+            void *hdr            :  header (struct imlm_hdr)
+	    void **rec           :  records (struct imlm_rec)
+	    unsigned int *numRec :  number of records
+
+.RETURNS     TRUE, error status passed by global variable ``nadc_stat''
+.COMMENTS    static function, called by the workers of ADAGUC_SPOOL_PRODUCTS
+-------------------------*/
+static
+bool RD_IMLM_PRODUCT( const char *flname, void *hdr_out, void **rec_out,
+		      unsigned int *numRec )
+{
+     int    ncid;
+     int    retval;
+
+     struct imlm_hdr *hdr = (struct imlm_hdr *) hdr_out;
+     struct imlm_rec *rec = NULL;
+
+     *rec_out = NULL;
+     *numRec  = 0u;
+     if ( H5Fis_hdf5( flname ) ) {
+	  if ( (retval = nc_open(flname, NC_NOWRITE, &ncid)) != NC_NOERR )
+	       NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  SCIA_RD_NC_CO_META( ncid, hdr );
+	  hdr->numRec = SCIA_RD_NC_CO_REC( ncid, &rec );
+	  if ( nc_close( ncid ) != NC_NOERR )
+	       NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+     } else {
+	  SCIA_RD_IMLM( flname, hdr, &rec );
+
+	  /* select IMLM records */
+	  hdr->numRec = SELECT_IMLM_RECORDS( hdr->numRec, rec );
+	  if ( hdr->numRec == 0 && rec != NULL ) {
+	       free( rec );
+	       rec = NULL;
+	  }
+     }
+ done:
+     *rec_out = rec;
+     if ( rec != NULL ) *numRec = hdr->numRec;
+     return TRUE;
+}
+
 /*+++++++++++++++++++++++++ Main Program or Function +++++++++++++++*/
 int main( int argc, char *argv[] )
 {
-     register int na = 0; 
+     register unsigned int np;
 
      char flname[2 * MAX_STRING_LENGTH];
 
-     register unsigned int nr;
-
      int    ncid;
      int    retval;
-     double *jday = NULL;
+     unsigned int num, offs;
 
      struct param_adaguc param;
+     struct adaguc_spool spool;
 
      struct imlm_hdr hdr;
      struct imlm_rec *rec = NULL;
+
+     const struct imlm_hdr *hdr_prod;
+
+     (void) memset( &spool, 0, sizeof(struct adaguc_spool) );
 /*
  * check command-line parameters
  */
@@ -213,117 +199,68 @@ int main( int argc, char *argv[] )
 	  exit( EXIT_SUCCESS );
      }
 /*
- * process input files
+ * process input files, the records are spooled ordered in time
  */
-     hdr.numProd = 0;
-     do {
-	  struct imlm_hdr hdr_tmp;
-	  struct imlm_rec *rec_tmp = NULL;
-	  
-	  (void) nadc_strlcpy( flname, 
-			       param.name_infiles[na], MAX_STRING_LENGTH );
-	  if ( H5Fis_hdf5( flname ) ) {
-	       if ( (retval = nc_open(flname, NC_NOWRITE, &ncid)) != NC_NOERR )
-		    NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
-	       SCIA_RD_NC_CO_META( ncid, &hdr_tmp );
-	       hdr_tmp.numRec = SCIA_RD_NC_CO_REC( ncid, &rec_tmp );
-	       if ( nc_close( ncid ) != NC_NOERR )
-		    NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
-	  } else {
-	       SCIA_RD_IMLM( flname, &hdr_tmp, &rec_tmp );
-
-               /* select IMLM records */
-	       hdr_tmp.numRec = SELECT_IMLM_RECORDS( hdr_tmp.numRec, rec_tmp );
-	       if ( hdr_tmp.numRec == 0 && rec_tmp != NULL) free( rec_tmp );
-	  }
-	  if ( IS_ERR_STAT_FATAL )
-	       NADC_GOTO_ERROR( NADC_ERR_FATAL, "failed to read product" );
+     ADAGUC_SPOOL_PRODUCTS( &param, sizeof(struct imlm_hdr), 
+			    sizeof(struct imlm_rec), 
+			    offsetof(struct imlm_rec, dsr_time), 
+			    RD_IMLM_PRODUCT, &spool );
+     if ( IS_ERR_STAT_FATAL )
+	  NADC_GOTO_ERROR( NADC_ERR_FATAL, "failed to read product" );
 
+     hdr.numProd = 0;
+     hdr_prod = (const struct imlm_hdr *) spool.hdr;
+     for ( np = 0; np < spool.num_prod; np++, hdr_prod++ ) {
 	  if ( hdr.numProd == 0 ) {
-	       (void) memcpy( &hdr, &hdr_tmp, sizeof(struct imlm_hdr) ); 
-	       if ( hdr.numRec > 0 && rec_tmp != NULL ) {
-		    rec = (struct imlm_rec *)
-			 malloc( hdr.numRec * sizeof( struct imlm_rec ));
-		    if ( rec == NULL ) 
-			 NADC_GOTO_ERROR( NADC_ERR_ALLOC, "rec" );
-		    (void) memcpy( rec, rec_tmp, 
-				   hdr.numRec * sizeof(struct imlm_rec) );
-	       }
+	       (void) memcpy( &hdr, hdr_prod, sizeof(struct imlm_hdr) ); 
 	  } else {
-	       if ( strcmp( hdr.product_format, hdr_tmp.product_format ) != 0
-		    || strcmp( hdr.software_version, hdr_tmp.software_version ) != 0
-		    || strcmp( hdr.pixelmask_version, hdr_tmp.pixelmask_version ) != 0
-		    || strcmp( hdr.cloudmask_version, hdr_tmp.cloudmask_version ) != 0 )
+	       if ( strcmp( hdr.product_format, hdr_prod->product_format ) != 0
+		    || strcmp( hdr.software_version, hdr_prod->software_version ) != 0
+		    || strcmp( hdr.pixelmask_version, hdr_prod->pixelmask_version ) != 0
+		    || strcmp( hdr.cloudmask_version, hdr_prod->cloudmask_version ) != 0 )
 		    NADC_GOTO_ERROR( NADC_ERR_FATAL,
 				     "inconsistent product versions" );
 
 	       /* update header struct */
-	       hdr.numProd += hdr_tmp.numProd;
-	       hdr.numRec  += hdr_tmp.numRec;
-	       hdr.file_size = hdr_tmp.file_size;
-	       hdr.orbit[na] = hdr_tmp.orbit[0];
-	       (void) strcat( hdr.l1b_product, "," );
-	       (void) strcat( hdr.l1b_product, hdr_tmp.l1b_product );
-
-	       /* append new records */
-	       if ( hdr.numRec > 0 && rec_tmp != NULL ) {
-		    rec = (struct imlm_rec *)
-			 realloc( rec, hdr.numRec * sizeof( struct imlm_rec ));
-		    if ( rec == NULL ) 
-			 NADC_GOTO_ERROR( NADC_ERR_ALLOC, "rec" );
-		    (void) memcpy( rec+(hdr.numRec - hdr_tmp.numRec), rec_tmp, 
-				   hdr_tmp.numRec * sizeof(struct imlm_rec) );
-	       }
+	       hdr.numProd += hdr_prod->numProd;
+	       hdr.numRec  += hdr_prod->numRec;
+	       hdr.file_size = hdr_prod->file_size;
+	       hdr.orbit[np] = hdr_prod->orbit[0];
+	       (void) nadc_strlcat( hdr.l1b_product, ",", 
+				    sizeof(hdr.l1b_product) );
+	       (void) nadc_strlcat( hdr.l1b_product, hdr_prod->l1b_product, 
+				    sizeof(hdr.l1b_product) );
 	  }
-	  if ( hdr_tmp.numRec != 0 && rec_tmp != NULL ) free( rec_tmp );
-     } while ( ++na < param.num_infiles );
+     }
 /*
  * check number of records read from IMAP product
  */
-     if ( hdr.numRec == 0u || rec == NULL ) {
+     if ( spool.num_read == 0u ) {
 	  NADC_GOTO_ERROR( NADC_ERR_NONE, 
 			   "No valid retrievals found in product" );
      }
 /*
- * sort the IMLM records in time
+ * select the IMLM records in the clip range
  */
-     jday = (double *) malloc( hdr.numRec * sizeof(double) );
-     if ( jday == NULL ) NADC_GOTO_ERROR( NADC_ERR_ALLOC, "jday" );
-     for ( nr = 0; nr < hdr.numRec; nr++ ) jday[nr] = rec[nr].dsr_time;
-     HPSORT( hdr.numRec, jday, rec );
-
      if ( param.flag_clip == PARAM_SET ) {
-	  register unsigned int ilow, ihigh;
-
-	  double jdayStart, jdayStop;
-
-	  jdayStart = Adaguc2gomeJDAY( param.clipStart );
-	  jdayStop  = Adaguc2gomeJDAY( param.clipStop );
-	  (void) nadc_strlcpy( hdr.validity_start, param.clipStart, 16 );
-	  (void) nadc_strlcpy( hdr.validity_stop, param.clipStop, 16 );
-
-	  for ( ilow = 0; ilow < hdr.numRec; ilow++ ) 
-	       if ( jday[ilow] >= jdayStart ) break;
-	  for ( ihigh = hdr.numRec-1; ihigh > ilow; ihigh-- ) 
-	       if ( jday[ihigh] <= jdayStop ) break;
-
-	  if ( ihigh <= ilow ) {
+	  ADAGUC_SPOOL_SELECT( &spool, Adaguc2gomeJDAY( param.clipStart ),
+			       Adaguc2gomeJDAY( param.clipStop ) );
+	  if ( IS_ERR_STAT_FATAL )
+	       NADC_GOTO_ERROR( NADC_ERR_FATAL, "ADAGUC_SPOOL_SELECT" );
+	  if ( spool.num_rec == 0u )
 	       NADC_GOTO_ERROR( NADC_ERR_FATAL, 
 				"all records outside clipRange" );
-	  } else if ( ilow > 0 || ihigh < (hdr.numRec-1) ) {
-	       hdr.numRec = ihigh - ilow + 1;
-	       (void) memmove( rec, rec+ilow, 
-			       hdr.numRec * sizeof(struct imlm_rec) );
-	  }
+	  (void) nadc_strlcpy( hdr.validity_start, param.clipStart, 16 );
+	  (void) nadc_strlcpy( hdr.validity_stop, param.clipStop, 16 );
      }
-     free( jday );
+     hdr.numRec = spool.num_rec;
 /*
  * construct ADAGUC compiant filename, 
  * first, recontruct validity period from IMLM-CO records
  */
      if ( hdr.numProd > 1 && param.flag_clip == PARAM_UNSET ) {
-	  SciaJDAY2adaguc( rec->dsr_time, hdr.validity_start );
-	  SciaJDAY2adaguc( rec[hdr.numRec-1].dsr_time, hdr.validity_stop );
+	  SciaJDAY2adaguc( spool.key_first, hdr.validity_start );
+	  SciaJDAY2adaguc( spool.key_last, hdr.validity_stop );
      }
      (void) snprintf( flname, sizeof(flname), "%s/"ADAGUC_PROD_TEMPLATE,
 		      param.outdir, param.prodClass, 
@@ -336,9 +273,25 @@ int main( int argc, char *argv[] )
      if ( IS_ERR_STAT_FATAL )
 	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "IMLM-CO header" );
 
-     SCIA_WR_NC_CO_REC( ncid, hdr.numRec, rec );
+     SCIA_DEF_NC_CO_REC( ncid, hdr.numRec );
      if ( IS_ERR_STAT_FATAL )
 	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "IMLM-CO records" );
+/*
+ * merge the IMLM records in time, and write them block by block
+ */
+     rec = (struct imlm_rec *) 
+	  malloc( ADAGUC_REC_BLOCK * sizeof(struct imlm_rec) );
+     if ( rec == NULL ) NADC_GOTO_ERROR( NADC_ERR_ALLOC, "rec" );
+
+     offs = 0u;
+     while ( (num = ADAGUC_SPOOL_MERGE( &spool, ADAGUC_REC_BLOCK, rec )) > 0 ) {
+	  SCIA_WR_NC_CO_REC( ncid, offs, num, rec );
+	  if ( IS_ERR_STAT_FATAL )
+	       NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "IMLM-CO records" );
+	  offs += num;
+     }
+     if ( IS_ERR_STAT_FATAL )
+	  NADC_GOTO_ERROR( NADC_ERR_FATAL, "ADAGUC_SPOOL_MERGE" );
 
      if ( nc_close( ncid ) != NC_NOERR )
 	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
@@ -347,6 +300,7 @@ int main( int argc, char *argv[] )
  */
  done:
      if ( rec != NULL ) free( rec );
+     ADAGUC_SPOOL_CLOSE( &spool );
 /*
  * display error messages
  */
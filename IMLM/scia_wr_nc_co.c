@@ -20,9 +20,12 @@
 .KEYWORDS    SRON IMLM Sciamachy
 .LANGUAGE    ANSI C
 .PURPOSE     write IMLM-CO product in ADAGUC format
-.COMMENTS    contains SCIA_WR_NC_CO_META and SCIA_WR_NC_CO_REC
+.COMMENTS    contains SCIA_WR_NC_CO_META, SCIA_DEF_NC_CO_REC
+             and SCIA_WR_NC_CO_REC
 .ENVIRONment None
-.VERSION     1.3     07-Apr-2011   differentiate between CO and H2O code, RvH
+.VERSION     1.4     17-Oct-2026   define the variables once, write the
+                                   records in blocks, RvH
+             1.3     07-Apr-2011   differentiate between CO and H2O code, RvH
              1.2     18-Feb-2011   update of contact address, RvH
              1.1     12-Oct-2009   improved product, fixed several bugs, RvH
              1.0     20-Oct-2008   initial release by R. M. van Hees
@@ -216,81 +219,60 @@ void SCIA_WR_NC_CO_META( int ncid, const struct imlm_hdr *hdr )
 }
 
 /*+++++++++++++++++++++++++
-.IDENTifer   SCIA_WR_NC_CO_REC
-.PURPOSE     write records to IMLM-CO product in netCDF-4 (ADAGUC standard)
+.IDENTifer   SCIA_DEF_NC_CO_REC
+.PURPOSE     define the record variables of IMLM-CO product in netCDF-4 
+             (ADAGUC standard)
 .INPUT/OUTPUT
-  call as   SCIA_WR_NC_CO_REC( ncid, numRec, rec );
+  call as   SCIA_DEF_NC_CO_REC( ncid, numRec );
      input:
             int ncid              :  netCDF file ID
 	    unsigned int numRec   :  number of IMLM records
-	    struct imlm_rec *rec  :  IMLM records
 
 .RETURNS     Nothing
-.COMMENTS    static function
+.COMMENTS    the records are written by SCIA_WR_NC_CO_REC
 -------------------------*/
-void SCIA_WR_NC_CO_REC( int ncid, unsigned int numRec,
-			  const struct imlm_rec *rec )
+void SCIA_DEF_NC_CO_REC( int ncid, unsigned int numRec )
 {
-     register unsigned int ni, nr;
-
      int    retval;
      int    time_id, nv_id, dimids[2];
      int    meta_id, var_id;
-     size_t indx;
-
-     float  *rbuff = NULL;
-     double *dbuff = NULL;
-     
-     const size_t nr_byte = NUM_CORNERS * sizeof(float);
 
      if ( numRec == 0 ) return;
 /*
- * write dimension scale "time"
+ * define dimension scale "time"
  */
-     dbuff = (double *) malloc( numRec * sizeof(double) );
-     if ( dbuff == NULL ) NADC_RETURN_ERROR( NADC_ERR_ALLOC, "dbuff" );
-
      retval = nc_def_dim( ncid, "time", (size_t) numRec, &time_id );
      if ( retval != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
      retval = nc_def_var( ncid, "time", NC_DOUBLE, 1, &time_id, &var_id );
      retval = nc_put_att_text( ncid, var_id, "long_name", 4, "time" );
      retval = nc_put_att_text( ncid, var_id, "units", 34, 
 			       "days since 2000-01-01 00:00:00 UTC" );
      retval = nc_put_att_text( ncid, var_id, "calendar", 4, "none" );
-     for ( nr = 0; nr < numRec; nr++ ) dbuff[nr] = rec[nr].dsr_time;
-     retval = nc_put_var_double( ncid, var_id, dbuff );
 
      retval = nc_def_dim( ncid, "nv", NUM_CORNERS, &nv_id );
      if ( retval != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
 /*
- * write longitude and latitude of measurements
+ * define longitude and latitude of measurements
  */
-     rbuff = (float *) malloc( numRec * sizeof(float) );
-     if ( rbuff == NULL ) NADC_RETURN_ERROR( NADC_ERR_ALLOC, "rbuff" );
-
      retval = nc_def_var( ncid, "lon", NC_FLOAT, 1, &time_id, &var_id );
      if ( retval != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
      retval = nc_put_att_text( ncid, var_id, "long_name", 9, "longitude" );
      retval = nc_put_att_text( ncid, var_id, "standard_name", 9, "longitude" );
      retval = nc_put_att_text( ncid, var_id, "units", 12, "degrees_east" );
      (void) nc_put_att_text( ncid, var_id, "bounds", 8, "lon_bnds" );
-     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].lon_center;
-     retval = nc_put_var_float( ncid, var_id, rbuff );
 
      retval = nc_def_var( ncid, "lat", NC_FLOAT, 1, &time_id, &var_id );
      if ( retval != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
      retval = nc_put_att_text( ncid, var_id, "long_name", 8, "latitude" );
      retval = nc_put_att_text( ncid, var_id, "standard_name", 8, "latitude" );
      retval = nc_put_att_text( ncid, var_id, "units", 13, "degrees_north" );
      (void) nc_put_att_text( ncid, var_id, "bounds", 8, "lat_bnds" );
-     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].lat_center;
-     retval = nc_put_var_float( ncid, var_id, rbuff );
 /*
- * write pixel meta-data as compound dataset
+ * define pixel meta-data as compound dataset
  */
      retval = nc_def_compound( ncid, sizeof(struct imlm_meta_rec), 
 			       "meta_rec", &meta_id );
@@ -315,33 +297,26 @@ void SCIA_WR_NC_CO_REC( int ncid, unsigned int numRec,
      nc_def_var( ncid, "tile_properties", meta_id, 1, &time_id, &var_id );
      retval = nc_put_att_text( ncid, var_id, "long_name", 36, 
 			       "pixel_properties_and_retrieval_flags" );
-     for ( indx = 0; indx < (size_t) numRec; indx++ ) {
-	  retval = nc_put_var1( ncid, var_id, &indx, &rec[indx].meta );
-     }
 /*
- * write datasets (CO, CH4)
+ * define datasets (CO, CH4)
  */
      var_id = ADAGUC_DEF_VAR( ncid, NC_FLOAT, time_id, "CO", "molecules/cm2",
 			     "vertical column density of CO",
 			 "atmosphere_number_content_of_carbon_monoxide_in_air",
 			     "CO_error" );
      if ( IS_ERR_STAT_FATAL ) 
-	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "CO" );
+	  NADC_RETURN_ERROR( NADC_ERR_HDF_WR, "CO" );
      retval = nc_put_att_text( ncid, var_id, "comment",
 			       strlen(CO_COMMENT), CO_COMMENT );
-     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].CO;
-     retval = nc_put_var_float( ncid, var_id, rbuff );
      var_id = ADAGUC_DEF_VAR( ncid, NC_FLOAT, time_id, "CO_error", 
 			     "molecules/cm2",
 			     "error of vertical column density of CO",
 	  "atmosphere_number_content_of_carbon_monoxide_in_air standard_error",
 			     NULL );
      if ( IS_ERR_STAT_FATAL ) 
-	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "CO_error" );
+	  NADC_RETURN_ERROR( NADC_ERR_HDF_WR, "CO_error" );
      retval = nc_put_att_text( ncid, var_id, "comment",
 			       strlen(CO_ERR_COMMENT), CO_ERR_COMMENT );
-     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].CO_err;
-     retval = nc_put_var_float( ncid, var_id, rbuff );
 
      /*+++++++++++++++++++++++++*/
      var_id = ADAGUC_DEF_VAR( ncid, NC_FLOAT, time_id, "CH4", "molecules/cm2",
@@ -349,71 +324,151 @@ void SCIA_WR_NC_CO_REC( int ncid, unsigned int numRec,
 			     "atmosphere_number_content_of_methane_in_air",
 			     "CH4_error" );
      if ( IS_ERR_STAT_FATAL ) 
-	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "CH4" );
+	  NADC_RETURN_ERROR( NADC_ERR_HDF_WR, "CH4" );
      retval = nc_put_att_text( ncid, var_id, "comment",
 			       strlen(CH4_COMMENT), CH4_COMMENT );
-     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].CH4;
-     retval = nc_put_var_float( ncid, var_id, rbuff );
      var_id = ADAGUC_DEF_VAR( ncid, NC_FLOAT, time_id, "CH4_error", 
 			     "molecules/cm2",
 			     "error of vertical column density of CH4",
 		  "atmosphere_number_content_of_methane_in_air standard_error",
 			     NULL );
      if ( IS_ERR_STAT_FATAL ) 
-	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "CH4_error" );
+	  NADC_RETURN_ERROR( NADC_ERR_HDF_WR, "CH4_error" );
      retval = nc_put_att_text( ncid, var_id, "comment",
 			       strlen(CH4_ERR_COMMENT), CH4_ERR_COMMENT );
-     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].CH4_err;
-     retval = nc_put_var_float( ncid, var_id, rbuff );
 
      /*+++++++++++++++++++++++++*/
      var_id = ADAGUC_DEF_VAR( ncid, NC_FLOAT, time_id, "albedo", NULL,
 			     "albedo", "surface_albedo", NULL );
      if ( IS_ERR_STAT_FATAL ) 
-	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "albedo" );
-     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].albedo;
-     retval = nc_put_var_float( ncid, var_id, rbuff );
+	  NADC_RETURN_ERROR( NADC_ERR_HDF_WR, "albedo" );
 
      /*+++++++++++++++++++++++++*/
      var_id = ADAGUC_DEF_VAR( ncid, NC_FLOAT, time_id, "cloudFraction", NULL,
 			     "cloud fraction", "cloud_area_fraction", NULL );
      if ( IS_ERR_STAT_FATAL ) 
-	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "cloudFraction" );
-     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].cl_fr;
-     retval = nc_put_var_float( ncid, var_id, rbuff );
+	  NADC_RETURN_ERROR( NADC_ERR_HDF_WR, "cloudFraction" );
 
      /*+++++++++++++++++++++++++*/
      var_id = ADAGUC_DEF_VAR( ncid, NC_FLOAT, time_id, "meanElevation", "m",
 			     "mean elevation", "surface_altitude", NULL );
      if ( IS_ERR_STAT_FATAL ) 
-	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "meanElevation" );
+	  NADC_RETURN_ERROR( NADC_ERR_HDF_WR, "meanElevation" );
      retval = nc_put_att_text( ncid, var_id, "comment",
 			       strlen(ELEV_COMMENT), ELEV_COMMENT );
-     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].mean_elev;
-     retval = nc_put_var_float( ncid, var_id, rbuff );
 /*
- * write longitude and latitude bounding boxes
+ * define longitude and latitude bounding boxes
  */
-     rbuff = (float *) realloc( rbuff, NUM_CORNERS * numRec * sizeof(float) );
-     if ( rbuff == NULL ) NADC_RETURN_ERROR( NADC_ERR_ALLOC, "rbuff" );
-
      dimids[0] = time_id;
      dimids[1] = nv_id;
      retval = nc_def_var( ncid, "lon_bnds", NC_FLOAT, 2, dimids, &var_id );
      if ( retval != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
-     for ( ni = nr = 0; nr < numRec; nr++, ni += NUM_CORNERS )
-	  (void) memcpy( rbuff+ni, rec[nr].lon_corner, nr_byte );
-     retval = nc_put_var_float( ncid, var_id, rbuff );
+	  NADC_RETURN_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
 
      retval = nc_def_var( ncid, "lat_bnds", NC_FLOAT, 2, dimids, &var_id );
      if ( retval != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   SCIA_WR_NC_CO_REC
+.PURPOSE     write a block of records to IMLM-CO product in netCDF-4 
+             (ADAGUC standard)
+.INPUT/OUTPUT
+  call as   SCIA_WR_NC_CO_REC( ncid, offs, numRec, rec );
+     input:
+            int ncid              :  netCDF file ID
+	    unsigned int offs     :  index of the first record of block
+	    unsigned int numRec   :  number of IMLM records in block
+	    struct imlm_rec *rec  :  IMLM records
+
+.RETURNS     Nothing
+.COMMENTS    the variables are defined by SCIA_DEF_NC_CO_REC
+-------------------------*/
+void SCIA_WR_NC_CO_REC( int ncid, unsigned int offs, unsigned int numRec,
+			const struct imlm_rec *rec )
+{
+     register unsigned int ni, nr;
+
+     float  *rbuff = NULL;
+     double *dbuff = NULL;
+
+     struct imlm_meta_rec *mbuff = NULL;
+
+     const size_t nr_byte = NUM_CORNERS * sizeof(float);
+
+     if ( numRec == 0u ) return;
+
+     dbuff = (double *) malloc( numRec * sizeof(double) );
+     if ( dbuff == NULL ) NADC_GOTO_ERROR( NADC_ERR_ALLOC, "dbuff" );
+     rbuff = (float *) malloc( NUM_CORNERS * numRec * sizeof(float) );
+     if ( rbuff == NULL ) NADC_GOTO_ERROR( NADC_ERR_ALLOC, "rbuff" );
+     mbuff = (struct imlm_meta_rec *) 
+	  malloc( numRec * sizeof(struct imlm_meta_rec) );
+     if ( mbuff == NULL ) NADC_GOTO_ERROR( NADC_ERR_ALLOC, "mbuff" );
+/*
+ * write dimension scale "time"
+ */
+     for ( nr = 0; nr < numRec; nr++ ) dbuff[nr] = rec[nr].dsr_time;
+     ADAGUC_PUT_VARA( ncid, "time", offs, numRec, 1, dbuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "time" );
+/*
+ * write longitude and latitude of measurements
+ */
+     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].lon_center;
+     ADAGUC_PUT_VARA( ncid, "lon", offs, numRec, 1, rbuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "lon" );
+     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].lat_center;
+     ADAGUC_PUT_VARA( ncid, "lat", offs, numRec, 1, rbuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "lat" );
+/*
+ * write pixel meta-data as compound dataset
+ */
+     for ( nr = 0; nr < numRec; nr++ )
+	  (void) memcpy( mbuff+nr, &rec[nr].meta, 
+			 sizeof(struct imlm_meta_rec) );
+     ADAGUC_PUT_VARA( ncid, "tile_properties", offs, numRec, 1, mbuff );
+     if ( IS_ERR_STAT_FATAL ) 
+	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "tile_properties" );
+/*
+ * write datasets (CO, CH4)
+ */
+     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].CO;
+     ADAGUC_PUT_VARA( ncid, "CO", offs, numRec, 1, rbuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "CO" );
+     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].CO_err;
+     ADAGUC_PUT_VARA( ncid, "CO_error", offs, numRec, 1, rbuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "CO_error" );
+     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].CH4;
+     ADAGUC_PUT_VARA( ncid, "CH4", offs, numRec, 1, rbuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "CH4" );
+     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].CH4_err;
+     ADAGUC_PUT_VARA( ncid, "CH4_error", offs, numRec, 1, rbuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "CH4_error" );
+     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].albedo;
+     ADAGUC_PUT_VARA( ncid, "albedo", offs, numRec, 1, rbuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "albedo" );
+     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].cl_fr;
+     ADAGUC_PUT_VARA( ncid, "cloudFraction", offs, numRec, 1, rbuff );
+     if ( IS_ERR_STAT_FATAL ) 
+	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "cloudFraction" );
+     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = rec[nr].mean_elev;
+     ADAGUC_PUT_VARA( ncid, "meanElevation", offs, numRec, 1, rbuff );
+     if ( IS_ERR_STAT_FATAL ) 
+	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "meanElevation" );
+/*
+ * write longitude and latitude bounding boxes
+ */
+     for ( ni = nr = 0; nr < numRec; nr++, ni += NUM_CORNERS )
+	  (void) memcpy( rbuff+ni, rec[nr].lon_corner, nr_byte );
+     ADAGUC_PUT_VARA( ncid, "lon_bnds", offs, numRec, NUM_CORNERS, rbuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "lon_bnds" );
      for ( ni = nr = 0; nr < numRec; nr++, ni += NUM_CORNERS )
 	  (void) memcpy( rbuff+ni, rec[nr].lat_corner, nr_byte );
-     retval = nc_put_var_float( ncid, var_id, rbuff );
-
+     ADAGUC_PUT_VARA( ncid, "lat_bnds", offs, numRec, NUM_CORNERS, rbuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "lat_bnds" );
  done:
+     if ( mbuff != NULL ) free( mbuff );
      if ( rbuff != NULL ) free( rbuff );
      if ( dbuff != NULL ) free( dbuff );
 }
@@ -0,0 +1,232 @@
+/*++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+.COPYRIGHT (c) 2026 SRON (R.M.van.Hees@sron.nl)
+
+   This is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License, version 2, as
+   published by the Free Software Foundation.
+
+   The software is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place - Suite 330,
+   Boston, MA  02111-1307, USA.
+
+.IDENTifer   SCIA_LV0_INDEX
+.AUTHOR      R.M. van Hees
+.KEYWORDS    SCIA level 0
+.LANGUAGE    ANSI C
+.PURPOSE     create the index with info-records of Sciamachy level 0
+             products, using a pool of worker processes
+.INPUT/OUTPUT
+  call as
+            scia_lv0_index [--threads=N] <input-file> [<input-file> ...]
+
+.RETURNS     non-negative on success, negative on failure
+.COMMENTS    The products are distributed round-robin over the workers,
+             each worker reads the info-records of its products with
+	     SCIA_LV0_RD_MDS_INFO, which writes the index.
+	     A product with a valid index is skipped.
+	     A product without states, or for which no valid index exists
+	     afterwards, is reported as failure
+.ENVIRONment SCIA_LV0_INDEX
+             location of the indices, see SCIA_LV0_RD_MDS_INDEX,
+	     default: next to the product
+.VERSION      1.1   17-Oct-2026 check that a valid index is created, RvH
+              1.0   17-Oct-2026 Created by R. M. van Hees
+------------------------------------------------------------*/
+/*
+ * Define _POSIX_C_SOURCE to indicate
+ * that this is a POSIX.1-2001 program
+ */
+#define  _POSIX_C_SOURCE 200112L
+
+/*+++++ System headers +++++*/
+#include <errno.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+/*+++++ Local Headers +++++*/
+#define _SCIA_LEVEL_0
+#include <nadc_scia.h>
+
+/*+++++ Macros +++++*/
+#define NADC_PARAMS " [--threads=N] <flname> [<flname> ...]"
+
+/*+++++ Global Variables +++++*/
+/*
+ * Most routines to read SCIAMACHY data can allocate memory internally
+ * However IDL requires the use of their own memory allocation routines
+ */
+bool Use_Extern_Alloc = FALSE;
+
+/*+++++++++++++++++++++++++ Static Functions +++++++++++++++++++++++*/
+/*+++++++++++++++++++++++++
+.IDENTifer   INDEX_LV0_PRODUCT
+.PURPOSE     create the index of one level 0 product
+.INPUT/OUTPUT
+  call as   INDEX_LV0_PRODUCT(flname);
+     input:
+            char *flname :  name of the level 0 product
+
+.RETURNS     nothing
+             error status passed by global variable ``nadc_stat''
+.COMMENTS    static function, the index is read back to check that it
+             is valid
+-------------------------*/
+static
+void INDEX_LV0_PRODUCT(const char *flname)
+{
+     unsigned int num_dsd;
+     size_t       num_state, num_index;
+
+     FILE *fd;
+
+     struct mph_envi    mph;
+     struct dsd_envi    *dsd = NULL;
+     struct mds0_states *states = NULL;
+
+     (void) nadc_set_param_string("infile", flname);
+     if ((fd = fopen(flname, "rb")) == NULL)
+	  NADC_RETURN_ERROR(NADC_ERR_FILE, flname);
+
+     ENVI_RD_MPH(fd, &mph);
+     if (IS_ERR_STAT_FATAL || mph.num_dsd == 0)
+	  NADC_GOTO_ERROR(NADC_ERR_PDS_RD, "MPH");
+     dsd = (struct dsd_envi *) malloc((mph.num_dsd-1) * sizeof(struct dsd_envi));
+     if (dsd == NULL) NADC_GOTO_ERROR(NADC_ERR_ALLOC, "dsd");
+     num_dsd = ENVI_RD_DSD(fd, mph, dsd);
+     if (IS_ERR_STAT_FATAL)
+	  NADC_GOTO_ERROR(NADC_ERR_PDS_RD, "DSD");
+
+     num_state = SCIA_LV0_RD_MDS_INFO(fd, num_dsd, dsd, &states);
+     if (IS_ERR_STAT_FATAL)
+	  NADC_GOTO_ERROR(NADC_ERR_FILE_RD, "SCIA_LV0_RD_MDS_INFO");
+     if (num_state == 0)
+	  NADC_GOTO_ERROR(NADC_ERR_FILE_RD, "no states in product");
+     SCIA_LV0_FREE_MDS_INFO(num_state, states);
+/*
+ * check that a valid index of this product exists
+ */
+     num_index = SCIA_LV0_RD_MDS_INDEX(fd, &states);
+     if (num_index > 0) SCIA_LV0_FREE_MDS_INFO(num_index, states);
+     if (num_index != num_state)
+	  NADC_GOTO_ERROR(NADC_ERR_FILE_WR, "can not create index");
+ done:
+     if (dsd != NULL) free(dsd);
+     (void) fclose(fd);
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   LV0_INDEX_WORKER
+.PURPOSE     create the index of every num_worker-th product
+.INPUT/OUTPUT
+  call as   LV0_INDEX_WORKER(nw, num_worker, num_file, flnames);
+     input:
+            unsigned short nw         : index of this worker
+            unsigned short num_worker : number of workers
+            int num_file              : number of products
+            char **flnames            : names of the products
+
+.RETURNS     does not return, exit status is non-zero when the index of
+             one of the products could not be created
+.COMMENTS    static function
+-------------------------*/
+static
+void LV0_INDEX_WORKER(unsigned short nw, unsigned short num_worker,
+		      int num_file, char **flnames)
+{
+     register int nf;
+
+     int status = EXIT_SUCCESS;
+
+     for (nf = nw; nf < num_file; nf += num_worker) {
+	  INDEX_LV0_PRODUCT(flnames[nf]);
+	  if (IS_ERR_STAT_FATAL) status = EXIT_FAILURE;
+	  if (nadc_stat != NADC_ERR_NONE) {
+	       NADC_Err_Trace(stderr);
+	       NADC_Err_Clear();
+	  }
+     }
+     (void) fflush(NULL);
+     _exit(status);
+}
+
+/*+++++++++++++++++++++++++ Main Program or Function +++++++++++++++*/
+int main(int argc, char *argv[])
+     /*@globals  errno, stderr, stdout, nadc_stat, nadc_err_stack,
+       Use_Extern_Alloc;@*/
+     /*@modifies errno, stderr, stdout, nadc_stat, nadc_err_stack@*/
+{
+     register unsigned short nw;
+
+     int   narg = 1;
+     int   num_file;
+     unsigned short num_worker = 1;
+     bool  failed = FALSE;
+
+     pid_t *pid = NULL;
+/*
+ * check command-line parameters
+ */
+     if (narg < argc && strncmp(argv[narg], "--threads=", 10) == 0) {
+	  int num = atoi(argv[narg] + 10);
+
+	  if (num < 1 || num > USHRT_MAX)
+	       NADC_GOTO_ERROR(NADC_ERR_PARAM, NADC_PARAMS);
+	  num_worker = (unsigned short) num;
+	  narg++;
+     }
+     if ((num_file = argc - narg) == 0)
+	  NADC_GOTO_ERROR(NADC_ERR_PARAM, NADC_PARAMS);
+     if (num_worker > num_file) num_worker = (unsigned short) num_file;
+/*
+ * by default, the index is written next to the product
+ */
+     if (getenv("SCIA_LV0_INDEX") == NULL
+	 || strcmp(getenv("SCIA_LV0_INDEX"), "0") == 0)
+	  (void) setenv("SCIA_LV0_INDEX", "1", 1);
+/*
+ * start the workers, flush all streams to prevent duplicated output
+ */
+     if ((pid = (pid_t *) malloc(num_worker * sizeof(pid_t))) == NULL)
+	  NADC_GOTO_ERROR(NADC_ERR_ALLOC, "worker pool");
+     (void) fflush(NULL);
+     for (nw = 0; nw < num_worker; nw++) {
+	  if ((pid[nw] = fork()) < 0) {
+	       NADC_ERROR(NADC_ERR_FATAL, strerror(errno));
+	       break;
+	  }
+	  if (pid[nw] == 0)
+	       LV0_INDEX_WORKER(nw, num_worker, num_file, argv + narg);
+     }
+/*
+ * wait for the workers
+ */
+     while (nw-- > 0) {
+	  int status;
+
+	  if (waitpid(pid[nw], &status, 0) != pid[nw]
+	      || ! WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS)
+	       failed = TRUE;
+     }
+     if (failed) NADC_ERROR(NADC_ERR_FATAL, "index of one or more products");
+ done:
+     if (pid != NULL) free(pid);
+/*
+ * display error messages
+ */
+     NADC_Err_Trace(stderr);
+     if (IS_ERR_STAT_FATAL)
+          return NADC_ERR_FATAL;
+     else
+          return NADC_ERR_NONE;
+}
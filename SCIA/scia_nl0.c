@@ -30,7 +30,9 @@
 .RETURNS     non-negative on success, negative on failure
 .COMMENTS    None
 .ENVIRONment None
-.VERSION      3.0   21-Mar-2015	new implementation for info-records, RvH
+.VERSION      3.2   17-Oct-2026	allocate Detector MDS from an arena, RvH
+              3.1   17-Oct-2026	[-mmap] read MDS from memory mapped file, RvH
+              3.0   21-Mar-2015	new implementation for info-records, RvH
               2.6   08-Oct-2013	[-check] show CRC and Reed-Solomon errors, RvH
               2.5   19-Jun-2009	remove non-archived file from database, RvH
               2.4   20-Jun-2008	removed HDF4 support, RvH
@@ -245,7 +247,18 @@ int main(int argc, char *argv[])
      SCIA_LV0_FREE_MDS_INFO(num_state_all, states_all);
 
      if (num_state == 0) goto done;
-
+/*
+ * map input file in memory, MDS records are read from the mapping
+ */
+     if (nadc_get_param_uint8("flag_mmap") == PARAM_SET) {
+	  SCIA_LV0_MMAP_OPEN(fd);
+	  if (IS_ERR_STAT_FATAL)
+	       NADC_GOTO_ERROR(NADC_ERR_FILE_RD, "MMAP_OPEN");
+     }
+/*
+ * Detector MDS records are allocated per state from an arena
+ */
+     SCIA_LV0_DET_ARENA_OPEN();
 #ifdef _WITH_SQL
      if (nadc_get_param_uint8("write_sql") == PARAM_SET) {
 	  struct mds0_sql sqlState[256];
@@ -289,6 +302,7 @@ int main(int argc, char *argv[])
 	       /* release allocated memory */
 	       if (sqlState[ns].nrAux > 0) free(aux);
 	       SCIA_LV0_FREE_MDS_DET(sqlState[ns].nrDet, det);
+	       SCIA_LV0_DET_ARENA_RELEASE();
 	       if (sqlState[ns].nrPMD > 0) free(pmd);
 	  }
  failed:
@@ -351,6 +365,7 @@ int main(int argc, char *argv[])
 	       SCIA_LV0_WR_ASCII_DET(ns, num, det);
 	  }
 	  SCIA_LV0_FREE_MDS_DET(num, det);
+	  SCIA_LV0_DET_ARENA_RELEASE();
 	  if (IS_ERR_STAT_FATAL) {
 	       NADC_GOTO_ERROR(NADC_ERR_FILE_WR, "MDS_DET");
 	  }
@@ -393,6 +408,8 @@ int main(int argc, char *argv[])
 /*
  * close input file
  */
+     SCIA_LV0_DET_ARENA_CLOSE();
+     SCIA_LV0_MMAP_CLOSE();
      if (fd != NULL) (void) fclose(fd);
 /*
  * close connection to PostgreSQL database
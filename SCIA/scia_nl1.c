@@ -30,7 +30,13 @@
 .RETURNS     non-negative on success, negative on failure
 .COMMENTS    None
 .ENVIRONment None
-.VERSION      5.3   19-Jun-2009	remove non-archived file from database, RvH
+.VERSION      5.7   17-Oct-2026	release the cached CKD at exit, RvH
+              5.6   17-Oct-2026	close the SDMF databases at exit, RvH
+              5.5   17-Oct-2026	read the level 1b MDS once for the level 1c 
+                                science, PMD and polV records, RvH
+              5.4   17-Oct-2026	added option --threads to calibrate states
+                                by a pool of worker processes, RvH
+              5.3   19-Jun-2009	remove non-archived file from database, RvH
               5.2   20-Jun-2008	removed HDF4 support, RvH
               5.1   01-Jun-2006	bugfix PROCESS_LV1C_MDS, RvH
               5.0.1 22-Dec-2005	bugfix file open/close, RvH
@@ -65,10 +71,21 @@
  */
 #define  _ISOC99_SOURCE
 
+/*
+ * Define _POSIX_SOURCE to indicate
+ * that this is a POSIX program
+ */
+#define  _POSIX_C_SOURCE 200112L
+
 /*+++++ System headers +++++*/
+#include <errno.h>
+#include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
 
 #include <hdf5.h>
 #ifdef _WITH_SQL
@@ -78,6 +95,7 @@
 /*+++++ Local Headers +++++*/
 #define _SCIA_LEVEL_1
 #include <nadc_scia_cal.h>
+#include <nadc_sdmf.h>
 
 /*+++++ Global Variables +++++*/
 /* 
@@ -95,6 +113,528 @@ static FILE *fp_out = NULL;
 #include <_connect_nadc_db.inc>
 #include "scia_lv1_wr_calls.inc"
 
+/*+++++++++++++++++++++++++
+.IDENTifer   CALIB_LV1C_STATE
+.PURPOSE     read, patch and calibrate the level 1b MDS of one state
+.INPUT/OUTPUT
+  call as   nr_mds1c = CALIB_LV1C_STATE(fp, patch_scia, calib_scia, 
+                                         state, pmd, polV, &mds1c);
+     input:  
+	    FILE   *fd                : (open) stream pointer
+	    unsigned short patch_scia : mask with patch algorithms
+	    unsigned int calib_scia   : mask with calibration algorithms
+ in/output:  
+	    struct state1_scia *state : state record of the MDS
+    output:  
+	    struct mds1c_pmd  *pmd    : level 1c PMD record (or NULL)
+	    struct mds1c_polV *polV   : level 1c polV record (or NULL)
+	    struct mds1c_scia **mds1c : calibrated level 1c MDS records
+
+.RETURNS     number of level 1c MDS records (unsigned int)
+             error status passed by global variable ``nadc_stat''
+.COMMENTS    static function
+             the PMD and polV records are derived from the level 1b MDS 
+	     before any patch or correction is applied, thus the level 1b 
+	     MDS is read only once for all three products
+-------------------------*/
+static
+unsigned int CALIB_LV1C_STATE(FILE *fp, unsigned short patch_scia,
+			      unsigned int calib_scia,
+			      struct state1_scia *state,
+			      struct mds1c_pmd *pmd,
+			      struct mds1c_polV *polV,
+			      struct mds1c_scia **mds1c_out)
+     /*@globals  errno, nadc_stat, nadc_err_stack;@*/
+     /*@modifies fp, errno, nadc_stat, nadc_err_stack, state, pmd, polV, mds1c_out@*/
+{
+     const char *env_str = getenv("SCIA_CORR_LOS");
+     const int  source   = (int) state->type_mds;
+     const unsigned long long clus_mask = SCIA_LV1_CHAN2CLUS(state);
+
+     unsigned int nr_mds, nr_mds1c = 0;
+
+     struct mds1_scia  *mds;
+     struct mds1c_scia *mds1c = NULL;
+
+     *mds1c_out = NULL;
+
+     /* read level 1b MDS-records */
+     if (patch_scia == SCIA_PATCH_NONE) {
+	  nr_mds = SCIA_LV1_RD_MDS(fp, clus_mask, state, &mds);
+	  if (IS_ERR_STAT_FATAL)
+	       NADC_GOTO_ERROR(NADC_ERR_PDS_SIZE, "SCIA_LV1_RD_MDS");
+     } else {
+	  nr_mds = SCIA_LV1_RD_MDS(fp, ~0ULL, state, &mds);
+	  if (IS_ERR_STAT_FATAL)
+	       NADC_GOTO_ERROR(NADC_ERR_PDS_SIZE, "SCIA_LV1_RD_MDS");
+     }
+     /* reconstruct level 1c PMD and polV records */
+     if (pmd != NULL) {
+	  (void) GET_SCIA_LV1C_PMD(state, mds, pmd);
+	  if (IS_ERR_STAT_FATAL) {
+	       SCIA_LV1_FREE_MDS(source, nr_mds, mds);
+	       NADC_GOTO_ERROR(NADC_ERR_FATAL, "GET_SCIA_LV1C_PMD");
+	  }
+     }
+     if (polV != NULL) {
+	  (void) GET_SCIA_LV1C_POLV(state, mds, polV);
+	  if (IS_ERR_STAT_FATAL) {
+	       SCIA_LV1_FREE_MDS(source, nr_mds, mds);
+	       NADC_GOTO_ERROR(NADC_ERR_FATAL, "GET_SCIA_LV1C_POLV");
+	  }
+     }
+     if (patch_scia == SCIA_PATCH_NONE) {
+	  if (state->num_clus == 0) {
+	       SCIA_LV1_FREE_MDS(source, nr_mds, mds);
+	       return 0u;
+	  }
+     } else {
+	  /* patch MDS level 1b record */
+	  SCIA_LV1_PATCH_MDS(fp, patch_scia, state, mds);
+	  if (IS_ERR_STAT_FATAL) {
+	       SCIA_LV1_FREE_MDS(source, nr_mds, mds);
+	       NADC_GOTO_ERROR(NADC_ERR_FATAL, "SCIA_LV1_PATCH_MDS");
+	  }
+     }
+     /* correct line-of-sight angles */
+     if (env_str != NULL && strcmp(env_str, "1") == 0)
+	  SCIA_LV1_CORR_LOS(state, mds);
+
+     /* reconstruct level 1c MDS-records from level 1b MDS-records */
+     mds1c = (struct mds1c_scia *) 
+	  malloc(state->num_clus * sizeof(struct mds1c_scia));
+     if (mds1c == NULL) {
+	  SCIA_LV1_FREE_MDS(source, nr_mds, mds);
+	  NADC_GOTO_ERROR(NADC_ERR_ALLOC, "mds1c");
+     }
+     if (patch_scia != SCIA_PATCH_NONE) {
+	  nr_mds1c = GET_SCIA_LV1C_MDS(clus_mask, state, mds, mds1c);
+     } else {
+	  nr_mds1c = GET_SCIA_LV1C_MDS(~0ULL, state, mds, mds1c);
+     }
+     if (IS_ERR_STAT_FATAL) {
+	  SCIA_LV1_FREE_MDS(source, nr_mds, mds);
+	  SCIA_LV1C_FREE_MDS(source, nr_mds1c, mds1c);
+	  NADC_GOTO_ERROR(NADC_ERR_FATAL, "GET_SCIA_LV1C_MDS");
+     }
+     /* calibrate detector read-outs */
+     SCIA_LV1_CAL(fp, calib_scia, state, mds, mds1c);
+     SCIA_LV1_FREE_MDS(source, nr_mds, mds);
+     if (IS_ERR_STAT_FATAL) {
+	  SCIA_LV1C_FREE_MDS(source, nr_mds1c, mds1c);
+	  NADC_GOTO_ERROR(NADC_ERR_FATAL, "SCIA_LV1_CALIB");
+     }
+     *mds1c_out = mds1c;
+ done:
+     return nr_mds1c;
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   _PIPE_WRITE, _PIPE_READ
+.PURPOSE     write/read a block of bytes to/from a pipe
+.INPUT/OUTPUT
+  call as   res = _PIPE_WRITE(fd, buff, num_byte);
+            res = _PIPE_READ(fd, buff, num_byte);
+     input:  
+            int    fd        : file descriptor of the pipe
+            size_t num_byte  : number of bytes to transfer
+ in/output:  
+            void   *buff     : buffer with data
+
+.RETURNS     TRUE when all bytes are transferred, else FALSE
+.COMMENTS    static functions
+-------------------------*/
+static
+bool _PIPE_WRITE(int fd, const void *buff, size_t num_byte)
+{
+     const char *cpntr = (const char *) buff;
+
+     while (num_byte > 0) {
+	  ssize_t nbyte = write(fd, cpntr, num_byte);
+
+	  if (nbyte < 0 && errno == EINTR) continue;
+	  if (nbyte <= 0) return FALSE;
+	  cpntr    += nbyte;
+	  num_byte -= (size_t) nbyte;
+     }
+     return TRUE;
+}
+
+static
+bool _PIPE_READ(int fd, void *buff, size_t num_byte)
+{
+     char *cpntr = (char *) buff;
+
+     while (num_byte > 0) {
+	  ssize_t nbyte = read(fd, cpntr, num_byte);
+
+	  if (nbyte < 0 && errno == EINTR) continue;
+	  if (nbyte <= 0) return FALSE;
+	  cpntr    += nbyte;
+	  num_byte -= (size_t) nbyte;
+     }
+     return TRUE;
+}
+
+/*
+ * arrays are sent as: number of elements followed by the elements,
+ * a NULL pointer is sent as an empty array
+ */
+static
+bool _SEND_ARRAY(int fd, const void *buff, size_t el_size, unsigned int num)
+{
+     if (buff == NULL) num = 0u;
+     if (! _PIPE_WRITE(fd, &num, sizeof(unsigned int))) return FALSE;
+     if (num == 0u) return TRUE;
+     return _PIPE_WRITE(fd, buff, num * el_size);
+}
+
+static
+bool _RECV_ARRAY(int fd, void **buff, size_t el_size)
+{
+     unsigned int num;
+
+     *buff = NULL;
+     if (! _PIPE_READ(fd, &num, sizeof(unsigned int))) return FALSE;
+     if (num == 0u) return TRUE;
+     if ((*buff = malloc(num * el_size)) == NULL) return FALSE;
+     return _PIPE_READ(fd, *buff, num * el_size);
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   SEND_MDS_1C, RECV_MDS_1C
+.PURPOSE     transfer level 1c MDS records of one state through a pipe
+.INPUT/OUTPUT
+  call as   res = SEND_MDS_1C(fd, source, nr_mds1c, mds1c);
+            res = RECV_MDS_1C(fd, source, &nr_mds1c, &mds1c);
+     input:  
+            int   fd                : file descriptor of the pipe
+	    int   source            : source of MDS (Nadir, Limb, ...)
+ in/output:  
+            unsigned int nr_mds1c   : number of level 1c MDS records
+	    struct mds1c_scia mds1c : level 1c MDS records
+
+.RETURNS     TRUE on success, else FALSE
+.COMMENTS    static functions
+             only the arrays released by SCIA_LV1C_FREE_MDS are sent, 
+	     all other pointers are set to NULL by RECV_MDS_1C
+-------------------------*/
+static
+bool SEND_MDS_1C(int fd, int source, unsigned int nr_mds1c, 
+		 const struct mds1c_scia *mds1c)
+{
+     register unsigned int nm;
+
+     if (! _PIPE_WRITE(fd, &nr_mds1c, sizeof(unsigned int))) return FALSE;
+
+     for (nm = 0; nm < nr_mds1c; nm++) {
+	  const struct mds1c_scia *mds = mds1c + nm;
+
+	  const unsigned int num_pixels = mds->num_pixels;
+	  const unsigned int num_obs    = mds->num_obs;
+	  const unsigned int num_val    = 
+	       (num_pixels == 0u) ? 0u : num_obs * num_pixels;
+
+	  if (! _PIPE_WRITE(fd, mds, sizeof(struct mds1c_scia))) return FALSE;
+
+	  if (! _SEND_ARRAY(fd, mds->pixel_ids, sizeof(unsigned short),
+			    num_pixels)
+	      || ! _SEND_ARRAY(fd, mds->pixel_wv, sizeof(float), num_pixels)
+	      || ! _SEND_ARRAY(fd, mds->pixel_wv_err, sizeof(float), 
+			       num_pixels)
+	      || ! _SEND_ARRAY(fd, mds->pixel_val, sizeof(float), num_val)
+	      || ! _SEND_ARRAY(fd, mds->pixel_err, sizeof(float), num_val))
+	       return FALSE;
+
+	  switch (source) {
+	  case SCIA_NADIR:
+	       if (! _SEND_ARRAY(fd, mds->geoN, sizeof(struct geoN_scia),
+				 num_obs))
+		    return FALSE;
+	       break;
+	  case SCIA_LIMB:
+	  case SCIA_OCCULT:
+	       if (! _SEND_ARRAY(fd, mds->geoL, sizeof(struct geoL_scia),
+				 num_obs))
+		    return FALSE;
+	       break;
+	  case SCIA_MONITOR:
+	       if (! _SEND_ARRAY(fd, mds->geoC, sizeof(struct geoC_scia),
+				 num_obs))
+		    return FALSE;
+	       break;
+	  }
+     }
+     return TRUE;
+}
+
+static
+bool RECV_MDS_1C(int fd, int source, unsigned int *nr_mds1c_out, 
+		 struct mds1c_scia **mds1c_out)
+{
+     register unsigned int nm;
+
+     unsigned int nr_mds1c;
+     bool         res = TRUE;
+
+     struct mds1c_scia *mds1c;
+
+     *nr_mds1c_out = 0u;
+     *mds1c_out = NULL;
+     if (! _PIPE_READ(fd, &nr_mds1c, sizeof(unsigned int))) return FALSE;
+
+     mds1c = (struct mds1c_scia *) 
+	  calloc(nr_mds1c + 1, sizeof(struct mds1c_scia));
+     if (mds1c == NULL) return FALSE;
+
+     for (nm = 0; nm < nr_mds1c; nm++) {
+	  struct mds1c_scia *mds = mds1c + nm;
+
+	  if (! _PIPE_READ(fd, mds, sizeof(struct mds1c_scia))) {
+	       (void) memset(mds, 0, sizeof(struct mds1c_scia));
+	       res = FALSE;
+	       break;
+	  }
+	  mds->pixel_ids = NULL;
+	  mds->pixel_wv  = mds->pixel_wv_err = NULL;
+	  mds->pixel_val = mds->pixel_err = NULL;
+	  mds->geoC = NULL;
+	  mds->geoL = NULL;
+	  mds->geoN = NULL;
+
+	  res = _RECV_ARRAY(fd, (void **) &mds->pixel_ids, 
+			    sizeof(unsigned short))
+	       && _RECV_ARRAY(fd, (void **) &mds->pixel_wv, sizeof(float))
+	       && _RECV_ARRAY(fd, (void **) &mds->pixel_wv_err, sizeof(float))
+	       && _RECV_ARRAY(fd, (void **) &mds->pixel_val, sizeof(float))
+	       && _RECV_ARRAY(fd, (void **) &mds->pixel_err, sizeof(float));
+	  if (! res) break;
+
+	  switch (source) {
+	  case SCIA_NADIR:
+	       res = _RECV_ARRAY(fd, (void **) &mds->geoN, 
+				 sizeof(struct geoN_scia));
+	       break;
+	  case SCIA_LIMB:
+	  case SCIA_OCCULT:
+	       res = _RECV_ARRAY(fd, (void **) &mds->geoL, 
+				 sizeof(struct geoL_scia));
+	       break;
+	  case SCIA_MONITOR:
+	       res = _RECV_ARRAY(fd, (void **) &mds->geoC, 
+				 sizeof(struct geoC_scia));
+	       break;
+	  }
+     }
+     /* hand over all (partially) received records to be released */
+     *nr_mds1c_out = (nm < nr_mds1c) ? nm + 1 : nr_mds1c;
+     *mds1c_out = mds1c;
+     return res;
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   LV1C_WORKER
+.PURPOSE     worker process: calibrate every num_worker-th state
+.INPUT/OUTPUT
+  call as   LV1C_WORKER(fd_out, nw, num_worker, patch_scia, calib_scia,
+                        num_state, state);
+     input:  
+            int   fd_out              : write-end of the pipe to the writer
+	    unsigned short nw         : index of this worker
+	    unsigned short num_worker : number of workers
+	    unsigned short patch_scia : mask with patch algorithms
+	    unsigned int calib_scia   : mask with calibration algorithms
+	    unsigned int num_state    : number of state records
+	    struct state1_scia *state : structure with States of the product
+
+.RETURNS     does not return, terminates the (child) process
+.COMMENTS    static function
+             the worker opens its own stream to the input file, it never
+	     touches the output (HDF5/ASCII) and leaves through _exit()
+	     to keep the writer's buffers and HDF5 objects untouched
+-------------------------*/
+static /*@exits@*/
+void LV1C_WORKER(int fd_out, unsigned short nw, unsigned short num_worker,
+		 unsigned short patch_scia, unsigned int calib_scia,
+		 unsigned int num_state, struct state1_scia *state)
+{
+     register unsigned int ns;
+
+     char  *infl = nadc_get_param_string("infile");
+     FILE  *fp;
+
+     int status = EXIT_SUCCESS;
+
+     if ((fp = fopen(infl, "rb")) == NULL) {
+	  NADC_ERROR(NADC_ERR_FILE, infl);
+	  free(infl);
+	  NADC_Err_Trace(stderr);
+	  _exit(EXIT_FAILURE);
+     }
+     free(infl);
+
+     for (ns = nw; ns < num_state; ns += num_worker) {
+	  unsigned int nr_mds1c;
+	  int          flag_mds;
+
+	  struct mds1c_scia *mds1c = NULL;
+
+	  nr_mds1c = CALIB_LV1C_STATE(fp, patch_scia, calib_scia,
+				      state+ns, NULL, NULL, &mds1c);
+	  if (IS_ERR_STAT_FATAL)
+	       flag_mds = -1;
+	  else
+	       flag_mds = (mds1c == NULL) ? 0 : 1;
+	  if (! _PIPE_WRITE(fd_out, &flag_mds, sizeof(int))) {
+	       status = EXIT_FAILURE;
+	  } else if (flag_mds < 0) {
+	       NADC_Err_Trace(stderr);
+	       status = EXIT_FAILURE;
+	  } else if (flag_mds > 0) {
+	       if (! SEND_MDS_1C(fd_out, (int) state[ns].type_mds, 
+				 nr_mds1c, mds1c))
+		    status = EXIT_FAILURE;
+	  }
+	  if (mds1c != NULL)
+	       SCIA_LV1C_FREE_MDS((int) state[ns].type_mds, nr_mds1c, mds1c);
+	  if (status != EXIT_SUCCESS) break;
+     }
+     (void) fclose(fp);
+     (void) close(fd_out);
+     _exit(status);
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   PROCESS_LV1C_STATES_PARALLEL
+.PURPOSE     calibrate the states using a pool of worker processes, 
+             and write the results in the original order of the states
+.INPUT/OUTPUT
+  call as   PROCESS_LV1C_STATES_PARALLEL(num_worker, patch_scia, calib_scia,
+                                         num_state, state);
+     input:  
+	    unsigned short num_worker : number of workers
+	    unsigned short patch_scia : mask with patch algorithms
+	    unsigned int calib_scia   : mask with calibration algorithms
+	    unsigned int num_state    : number of state records
+	    struct state1_scia *state : structure with States of the product
+
+.RETURNS     nothing
+             error status passed by global variable ``nadc_stat''
+.COMMENTS    static function
+             The library keeps its error status, parameters and cached 
+	     calibration data in global variables, and HDF5 is not 
+	     thread-safe, therefore the workers are processes and not 
+	     threads. The states are distributed round-robin over the 
+	     workers, each worker sends its results in a pipe, the pipe
+	     capacity limits the number of states in flight. This process 
+	     is the only writer, hence the output is identical to the output
+	     of the sequential code.
+-------------------------*/
+static
+void PROCESS_LV1C_STATES_PARALLEL(unsigned short num_worker,
+				  unsigned short patch_scia,
+				  unsigned int calib_scia,
+				  unsigned int num_state,
+				  struct state1_scia *state)
+     /*@globals  errno, nadc_stat, nadc_err_stack;@*/
+     /*@modifies errno, nadc_stat, nadc_err_stack@*/
+{
+     register unsigned short nw;
+     register unsigned int   ns;
+
+     int   *fd_in = NULL;
+     pid_t *pid = NULL;
+
+     if (num_worker > num_state) num_worker = (unsigned short) num_state;
+     if (num_worker == 0) return;
+
+     fd_in = (int *) malloc(num_worker * sizeof(int));
+     pid = (pid_t *) malloc(num_worker * sizeof(pid_t));
+     if (fd_in == NULL || pid == NULL)
+	  NADC_GOTO_ERROR(NADC_ERR_ALLOC, "worker pool");
+     for (nw = 0; nw < num_worker; nw++) {
+	  fd_in[nw] = -1;
+	  pid[nw] = -1;
+     }
+/*
+ * start the workers, flush all streams to prevent duplicated output
+ */
+     (void) fflush(NULL);
+     for (nw = 0; nw < num_worker; nw++) {
+	  int fd_pipe[2];
+
+	  if (pipe(fd_pipe) != 0)
+	       NADC_GOTO_ERROR(NADC_ERR_FATAL, strerror(errno));
+	  if ((pid[nw] = fork()) < 0) {
+	       (void) close(fd_pipe[0]);
+	       (void) close(fd_pipe[1]);
+	       NADC_GOTO_ERROR(NADC_ERR_FATAL, strerror(errno));
+	  }
+	  if (pid[nw] == 0) {
+	       register unsigned short nn;
+
+	       /* child: release the read-ends of the previous workers */
+	       for (nn = 0; nn < nw; nn++) (void) close(fd_in[nn]);
+	       (void) close(fd_pipe[0]);
+	       LV1C_WORKER(fd_pipe[1], nw, num_worker, patch_scia, 
+			   calib_scia, num_state, state);
+	  }
+	  (void) close(fd_pipe[1]);
+	  fd_in[nw] = fd_pipe[0];
+     }
+/*
+ * collect and write the results in the order of the states
+ */
+     for (ns = 0; ns < num_state; ns++) {
+	  int          flag_mds;
+	  unsigned int nr_mds1c = 0;
+
+	  struct mds1c_scia *mds1c = NULL;
+
+	  const int source = (int) state[ns].type_mds;
+
+	  nw = (unsigned short) (ns % num_worker);
+
+	  if (nadc_get_param_uint8("flag_silent") == PARAM_UNSET 
+	      && nadc_get_param_uint8("write_sql") == PARAM_UNSET)
+	       NADC_Info_Update(stdout, 2, ns);
+
+	  if (! _PIPE_READ(fd_in[nw], &flag_mds, sizeof(int)))
+	       NADC_GOTO_ERROR(NADC_ERR_FATAL, "worker terminated");
+	  if (flag_mds < 0)
+	       NADC_GOTO_ERROR(NADC_ERR_FATAL, "CALIB_LV1C_STATE");
+	  if (flag_mds == 0) continue;            /* no clusters selected */
+
+	  if (! RECV_MDS_1C(fd_in[nw], source, &nr_mds1c, &mds1c)) {
+	       if (mds1c != NULL)
+		    SCIA_LV1C_FREE_MDS(source, nr_mds1c, mds1c);
+	       NADC_GOTO_ERROR(NADC_ERR_FATAL, "worker terminated");
+	  }
+	  /* write level 1c MDS-records */
+	  SCIA_WRITE_MDS_1C(nr_mds1c, mds1c);
+	  SCIA_LV1C_FREE_MDS(source, nr_mds1c, mds1c);
+	  if (IS_ERR_STAT_FATAL)
+	       NADC_GOTO_ERROR(NADC_ERR_FILE_WR, "SCIA_WRITE_MDS_1C");
+     }
+ done:
+     if (pid != NULL) {
+	  for (nw = 0; nw < num_worker; nw++) {
+	       int status;
+
+	       if (fd_in != NULL && fd_in[nw] >= 0) (void) close(fd_in[nw]);
+	       if (pid[nw] <= 0) continue;
+	       if (IS_ERR_STAT_FATAL) (void) kill(pid[nw], SIGTERM);
+	       if (waitpid(pid[nw], &status, 0) == pid[nw]
+		   && ! IS_ERR_STAT_FATAL
+		   && (! WIFEXITED(status) 
+		       || WEXITSTATUS(status) != EXIT_SUCCESS))
+		    NADC_ERROR(NADC_ERR_FATAL, "worker failed");
+	  }
+     }
+     if (fd_in != NULL) free(fd_in);
+     if (pid != NULL) free(pid);
+}
+
 /*+++++++++++++++++++++++++
 .IDENTifer   PROCESS_LV1B_MDS
 .PURPOSE     read and write selected Measurement Data Sets
@@ -121,6 +661,8 @@ void PROCESS_LV1B_MDS(FILE *fp, const unsigned int num_state,
 
      struct state1_scia *state;
      struct mds1_scia   *mds;
+     struct mds1c_pmd   **pmd_list = NULL;
+     struct mds1c_polV  **polV_list = NULL;
 /*
  * here we assume that all states are of the same type (NADIR, LIMB, ...)
  *  --- this should be checked! ---
@@ -172,7 +714,12 @@ void PROCESS_LV1B_MDS(FILE *fp, const unsigned int num_state,
  * read MDS's from level 1b and write MDS's to level 1c product
  */
      } else {
-	  char *env_str = getenv("SCIA_CORR_LOS");
+	  const unsigned short num_threads = 
+	       nadc_get_param_uint16("num_threads");
+	  const bool do_pmd = (source != SCIA_MONITOR
+			       && nadc_get_param_uint8("write_pmd") == PARAM_SET);
+	  const bool do_polV = (source != SCIA_MONITOR
+			       && nadc_get_param_uint8("write_polV") == PARAM_SET);
 
 	  struct mds1c_pmd  *pmd = NULL;
 	  struct mds1c_polV *polV = NULL;
@@ -192,66 +739,57 @@ void PROCESS_LV1B_MDS(FILE *fp, const unsigned int num_state,
 	      && (calib_scia & DO_SRON_STRAY) != UINT_ZERO)
 	       patch_scia |= SCIA_PATCH_STRAY;
 
-	  for (ns = 0; ns < (unsigned short) num_state; ns++) {
-	       const unsigned long long clus_mask = 
-		    SCIA_LV1_CHAN2CLUS(state+ns);
+	  /* 
+	   * sequential processing: derive the PMD and polV records from the
+	   * same level 1b MDS as the science data, they are kept in memory 
+	   * and written after the science data (same output as before)
+	   */
+	  if (num_threads <= 1 && do_pmd) {
+	       pmd_list = (struct mds1c_pmd **)
+		    calloc(num_state, sizeof(struct mds1c_pmd *));
+	       if (pmd_list == NULL)
+		    NADC_GOTO_ERROR(NADC_ERR_ALLOC, "pmd_list");
+	  }
+	  if (num_threads <= 1 && do_polV) {
+	       polV_list = (struct mds1c_polV **)
+		    calloc(num_state, sizeof(struct mds1c_polV *));
+	       if (polV_list == NULL)
+		    NADC_GOTO_ERROR(NADC_ERR_ALLOC, "polV_list");
+	  }
 
-	       unsigned int nr_mds1c = 0;
+	  if (num_threads > 1) {
+	       PROCESS_LV1C_STATES_PARALLEL(num_threads, patch_scia, 
+					    calib_scia, num_state, state);
+	       if (IS_ERR_STAT_FATAL)
+		    NADC_GOTO_ERROR(NADC_ERR_FATAL, 
+				     "PROCESS_LV1C_STATES_PARALLEL");
+	  } else for (ns = 0; ns < (unsigned short) num_state; ns++) {
+	       unsigned int nr_mds1c;
 
 	       if (nadc_get_param_uint8("flag_silent") == PARAM_UNSET 
 		   && nadc_get_param_uint8("write_sql") == PARAM_UNSET)
                     NADC_Info_Update(stdout, 2, ns);
 
-	       /* read level 1b MDS-records */
-	       if (patch_scia == SCIA_PATCH_NONE) {
-		    nr_mds = SCIA_LV1_RD_MDS(fp, clus_mask, state+ns, &mds);
-		    if (IS_ERR_STAT_FATAL)
-			 NADC_GOTO_ERROR(NADC_ERR_PDS_SIZE, 
-					  "SCIA_LV1_RD_MDS");
-		    if (state[ns].num_clus == 0) continue;
-	       } else {
-		    nr_mds = SCIA_LV1_RD_MDS(fp, ~0ULL, state+ns, &mds);
-		    if (IS_ERR_STAT_FATAL)
-			 NADC_GOTO_ERROR(NADC_ERR_PDS_SIZE, 
-					  "SCIA_LV1_RD_MDS");
-		    /* patch MDS level 1b record */
-		    SCIA_LV1_PATCH_MDS(fp, patch_scia, state+ns, mds);
-		    if (IS_ERR_STAT_FATAL) {
-			 SCIA_LV1_FREE_MDS(source, nr_mds, mds);
-			 NADC_GOTO_ERROR(NADC_ERR_FATAL, 
-					  "SCIA_LV1_PATCH_MDS");
-		    }
-	       }
-	       /* correct line-of-sight angles */
-	       if (env_str != NULL && strcmp(env_str, "1") == 0)
-		    SCIA_LV1_CORR_LOS(state+ns, mds);
-
-	       /* reconstruct level 1c MDS-records from level 1b MDS-records */
-	       mds1c = (struct mds1c_scia *) malloc(
-		    state[ns].num_clus * sizeof(struct mds1c_scia));
-	       if (mds1c == NULL)
-		    NADC_GOTO_ERROR(NADC_ERR_ALLOC, "mds1c");
-
-	       if (patch_scia != SCIA_PATCH_NONE) {
-		    nr_mds1c = GET_SCIA_LV1C_MDS(clus_mask, state+ns, mds, 
-						  mds1c);
-	       } else {
-		    nr_mds1c = GET_SCIA_LV1C_MDS(~0ULL, state+ns, mds, mds1c);
-	       }
-	       if (IS_ERR_STAT_FATAL) {
-		    SCIA_LV1_FREE_MDS(source, nr_mds, mds);
-		    SCIA_LV1C_FREE_MDS(source, nr_mds1c, mds1c);
-		    NADC_GOTO_ERROR(NADC_ERR_FATAL, 
-				     "GET_SCIA_LV1C_MDS");
+	       if (pmd_list != NULL) {
+		    pmd_list[ns] = (struct mds1c_pmd *) 
+			 calloc(1, sizeof(struct mds1c_pmd));
+		    if ((pmd = pmd_list[ns]) == NULL)
+			 NADC_GOTO_ERROR(NADC_ERR_ALLOC, "pmd");
 	       }
-	       /* calibrate detector read-outs */
-	       SCIA_LV1_CAL(fp, calib_scia, state+ns, mds, mds1c);
-	       SCIA_LV1_FREE_MDS(source, nr_mds, mds);
-	       if (IS_ERR_STAT_FATAL) {
-		    SCIA_LV1C_FREE_MDS(source, nr_mds1c, mds1c);
-		    NADC_GOTO_ERROR(NADC_ERR_FATAL, 
-				     "SCIA_LV1_CALIB");
+	       if (polV_list != NULL) {
+		    polV_list[ns] = (struct mds1c_polV *) 
+			 calloc(1, sizeof(struct mds1c_polV));
+		    if ((polV = polV_list[ns]) == NULL)
+			 NADC_GOTO_ERROR(NADC_ERR_ALLOC, "polV");
 	       }
+
+	       /* read, patch and calibrate level 1b MDS-records */
+	       nr_mds1c = CALIB_LV1C_STATE(fp, patch_scia, calib_scia, 
+					   state+ns, pmd, polV, &mds1c);
+	       if (IS_ERR_STAT_FATAL)
+		    NADC_GOTO_ERROR(NADC_ERR_FATAL, "CALIB_LV1C_STATE");
+	       if (mds1c == NULL) continue;
+
 	       /* write level 1c MDS-records */
 	       SCIA_WRITE_MDS_1C(nr_mds1c, mds1c);
 	       SCIA_LV1C_FREE_MDS(source, nr_mds1c, mds1c);
@@ -263,8 +801,16 @@ void PROCESS_LV1B_MDS(FILE *fp, const unsigned int num_state,
 	  /* 
 	   * reconstruct level 1c MDS_PMD-records from level 1b MDS-records
 	   */
-	  if (source != SCIA_MONITOR
-	      && nadc_get_param_uint8("write_pmd") == PARAM_SET) {
+	  if (pmd_list != NULL) {
+	       for (ns = 0; ns < (unsigned short) num_state; ns++) {
+		    SCIA_WRITE_MDS_PMD(pmd_list[ns]);
+		    SCIA_LV1C_FREE_MDS_PMD(source, pmd_list[ns]);
+		    pmd_list[ns] = NULL;
+		    if (IS_ERR_STAT_FATAL)
+			 NADC_GOTO_ERROR(NADC_ERR_FILE_WR, 
+					  "SCIA_WRITE_MDS_PMD");
+	       }
+	  } else if (do_pmd) {
 	       /* do not read any cluster data */
 	       const unsigned long long clus_mask = 0ULL;
 
@@ -298,8 +844,16 @@ void PROCESS_LV1B_MDS(FILE *fp, const unsigned int num_state,
 	  /*
 	   * reconstruct level 1c MDS_POLV-records from level 1b MDS-records
 	   */
-	  if (source != SCIA_MONITOR
-	      && nadc_get_param_uint8("write_polV") == PARAM_SET) {
+	  if (polV_list != NULL) {
+	       for (ns = 0; ns < (unsigned short) num_state; ns++) {
+		    SCIA_WRITE_MDS_POLV(polV_list[ns]);
+		    SCIA_LV1C_FREE_MDS_POLV(source, polV_list[ns]);
+		    polV_list[ns] = NULL;
+		    if (IS_ERR_STAT_FATAL)
+			 NADC_GOTO_ERROR(NADC_ERR_FILE_WR, 
+					  "SCIA_WRITE_MDS_POLV");
+	       }
+	  } else if (do_polV) {
 	       /* do not read any cluster data */
 	       const unsigned long long clus_mask = 0ULL;
 
@@ -333,6 +887,20 @@ void PROCESS_LV1B_MDS(FILE *fp, const unsigned int num_state,
 	  }
      }
  done:
+     if (pmd_list != NULL) {
+	  for (ns = 0; ns < (unsigned short) num_state; ns++) {
+	       if (pmd_list[ns] != NULL)
+		    SCIA_LV1C_FREE_MDS_PMD(source, pmd_list[ns]);
+	  }
+	  free(pmd_list);
+     }
+     if (polV_list != NULL) {
+	  for (ns = 0; ns < (unsigned short) num_state; ns++) {
+	       if (polV_list[ns] != NULL)
+		    SCIA_LV1C_FREE_MDS_POLV(source, polV_list[ns]);
+	  }
+	  free(polV_list);
+     }
      free(state);
 }
 
@@ -1143,6 +1711,11 @@ int main(int argc, char *argv[])
 	       free(cpntr);
 	  }
      }
+/*
+ * close SDMF databases and release the calibration key data
+ */
+     SDMF_close_files();
+     SCIA_FREE_H5_CKD_CACHE();
 /*
  * close file with error messages
  */
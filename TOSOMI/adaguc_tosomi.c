@@ -27,7 +27,10 @@
 .RETURNS     non-negative on success, negative on failure
 .COMMENTS    None
 .ENVIRONment None
-.VERSION     1.0     23-Oct-2008   initial release by R. M. van Hees
+.VERSION     1.2     17-Oct-2026   read products by worker processes, write
+                                   the merged records in blocks, RvH
+             1.1     17-Oct-2026   merge products in time, no HPSORT, RvH
+             1.0     23-Oct-2008   initial release by R. M. van Hees
 ------------------------------------------------------------*/
 /*
  * Define _ISOC99_SOURCE to indicate
@@ -39,6 +42,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stddef.h>
 
 #include <hdf5.h>
 #include <netcdf.h>
@@ -57,89 +61,83 @@
 
 /*+++++++++++++++++++++++++ Static Functions +++++++++++++++++++++++*/
 /*+++++++++++++++++++++++++
-.IDENTifer   HPSORT
-.PURPOSE     sort an array into assending order using the Heapsort algorithm
+.IDENTifer   RD_TOSOMI_PRODUCT
+.PURPOSE     read header and records of one TOSOMI product
 .INPUT/OUTPUT
-  call as   HPSORT( dim, jday, rec );
+  call as   res = RD_TOSOMI_PRODUCT( flname, hdr, &rec, &numRec );
      input:
-            unsigned int dim       :    dimension of the array to be sorted
+            char *flname         :  name of the product (ASCII or netCDF)
     output:
-            double       *jday     :    array to be sorted
-	    struct tosomi_rec *rec :    array of records to be sorted as jday
+            void *hdr            :  header (struct tosomi_hdr)
+	    void **rec           :  records (struct tosomi_rec)
+	    unsigned int *numRec :  number of records
 
-.RETURNS     nothing
-.COMMENTS    static function
-             Heapsort algorithm in a N log_2 N routine
+.RETURNS     FALSE when the product is skipped
+             error status passed by global variable ``nadc_stat''
+.COMMENTS    static function, called by the workers of ADAGUC_SPOOL_PRODUCTS
 -------------------------*/
 static
-void HPSORT( unsigned int dim, double *jday, struct tosomi_rec *rec )
+bool RD_TOSOMI_PRODUCT( const char *flname, void *hdr_out, void **rec_out,
+			unsigned int *numRec )
 {
-     register unsigned int ii,  ir, jj, ll;
-
-     double jbuff;
-     struct tosomi_rec buff;
+     int    ncid;
+     int    retval;
 
-     const size_t sizeof_tosomi_rec = sizeof(struct tosomi_rec);
-/*
- * initialization
- */
-     jday--; rec--;
-     ll = (dim >> 1) + 1;
-     ir = dim;
+     struct tosomi_hdr *hdr = (struct tosomi_hdr *) hdr_out;
+     struct tosomi_rec *rec = NULL;
 
-     while ( TRUE ) {
-	  if ( ll > 1 ) {                          /* still in hirring phase */
-	       jbuff = jday[--ll];
-	       (void) memcpy( &buff, rec+ll, sizeof_tosomi_rec );
-	  } else {                      /* in retirement-and-promotion phase */
-	       jbuff = jday[ir];              /* clear space at end of array */
-	       (void) memcpy( &buff, rec+ir, sizeof_tosomi_rec );
-	       jday[ir] = jday[1];     /* retire the top of the heap into it */
-	       (void) memcpy( rec+ir, rec+1, sizeof_tosomi_rec );
-	       if ( --ir == 1 ) {            /* done with the last promotion */
-		    jday[1] = jbuff;    /* the least competent worker of all */
-		    (void) memcpy( rec+1, &buff, sizeof_tosomi_rec );
-		    break;
-	       }
+     *rec_out = NULL;
+     *numRec  = 0u;
+     if ( H5Fis_hdf5( flname ) ) {
+	  if ( (retval = nc_open(flname, NC_NOWRITE, &ncid)) != NC_NOERR )
+	       NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_TOSOMI_RD_NC_META( ncid, hdr );
+	  hdr->numRec = NADC_TOSOMI_RD_NC_REC( ncid, &rec );
+	  if ( nc_close( ncid ) != NC_NOERR )
+	       NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+     } else {
+	  (void) NADC_RD_TOSOMI( flname, hdr, &rec );
+	  if ( IS_ERR_STAT_WARN ) { 
+	       nadc_stat &= ~NADC_STAT_WARN;
+	       if ( rec != NULL ) free( rec );
+	       return FALSE;
 	  }
-/*
- * whether in the hiring phase or promotion phase, we here set up to shift
- * down element jbuff to its proper level
- */
-	  ii = ll;
-	  jj = ll + ll;
-	  while ( jj <= ir ) {
-	       if ( jj < ir && jday[jj] < jday[jj+1] ) jj++;
-	       if ( jbuff < jday[jj] ) {                     /* demote jbuff */
-		    jday[ii] = jday[jj];
-		    (void) memcpy( rec+ii, rec+jj, sizeof_tosomi_rec );
-		    ii = jj;
-		    jj <<= 1;
-	       } else
-		    jj = ir + 1;       /* set jj to terminate the shift down */
-	  }
-	  jday[ii] = jbuff;                       /* put jbuff into its slot */
-	  (void) memcpy( rec+ii, &buff, sizeof_tosomi_rec );
+#ifdef DEBUG
+	  (void) printf( "%s %s %s %s %s %s %s %s %hu %hu %hu %u\n", 
+			 hdr->product, hdr->creation_date, 
+			 hdr->receive_date, hdr->l1b_product, 
+			 hdr->validity_start, hdr->validity_stop, 
+			 hdr->software_version, hdr->lv1c_version, 
+			 hdr->numProd, hdr->numRec, 
+			 hdr->numState, hdr->file_size );
+#endif
      }
+ done:
+     *rec_out = rec;
+     if ( rec != NULL ) *numRec = hdr->numRec;
+     return TRUE;
 }
 
 /*+++++++++++++++++++++++++ Main Program or Function +++++++++++++++*/
 int main ( int argc, char *argv[] )
 {
-     register int na = 0;
+     register unsigned int np;
 
      char flname[2 * MAX_STRING_LENGTH];
 
-     register unsigned int nr;
-
      int    ncid;
      int    retval;
-     double *jday = NULL;
+     unsigned int num, offs;
 
      struct param_adaguc param;
+     struct adaguc_spool spool;
 
      struct tosomi_hdr hdr;
      struct tosomi_rec *rec = NULL;
+
+     const struct tosomi_hdr *hdr_prod;
+
+     (void) memset( &spool, 0, sizeof(struct adaguc_spool) );
 /*
  * check command-line parameters
  */
@@ -156,125 +154,64 @@ int main ( int argc, char *argv[] )
 	  exit( EXIT_SUCCESS );
      }
 /*
- * process input files
+ * process input files, the records are spooled ordered in time
  */
-     hdr.numProd = 0;
-     do {
-	  struct tosomi_hdr hdr_tmp;
-	  struct tosomi_rec *rec_tmp = NULL;
-	  
-	  (void) nadc_strlcpy( flname, 
-			       param.name_infiles[na], MAX_STRING_LENGTH );
-	  if ( H5Fis_hdf5( flname ) ) {
-	       if ( (retval = nc_open(flname, NC_NOWRITE, &ncid)) != NC_NOERR )
-		    NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
-	       NADC_TOSOMI_RD_NC_META( ncid, &hdr_tmp );
-	       hdr_tmp.numRec = NADC_TOSOMI_RD_NC_REC( ncid, &rec_tmp );
-	       if ( nc_close( ncid ) != NC_NOERR )
-		    NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
-	  } else {
-	       (void) NADC_RD_TOSOMI( flname, &hdr_tmp, &rec_tmp );
-	       if ( IS_ERR_STAT_WARN ) { 
-		    nadc_stat &= ~NADC_STAT_WARN;
-		    continue;
-	       }
-#ifdef DEBUG
-	       (void) printf( "%s %s %s %s %s %s %s %s %hu %hu %hu %u\n", 
-			      hdr_tmp.product, hdr_tmp.creation_date, 
-			      hdr_tmp.receive_date, hdr_tmp.l1b_product, 
-			      hdr_tmp.validity_start, hdr_tmp.validity_stop, 
-			      hdr_tmp.software_version, hdr_tmp.lv1c_version, 
-			      hdr_tmp.numProd, hdr_tmp.numRec, 
-			      hdr_tmp.numState, hdr_tmp.file_size );
-#endif
-	  }
-	  if ( IS_ERR_STAT_FATAL )
-	       NADC_GOTO_ERROR( NADC_ERR_FATAL, "failed to read product" );
+     ADAGUC_SPOOL_PRODUCTS( &param, sizeof(struct tosomi_hdr), 
+			    sizeof(struct tosomi_rec), 
+			    offsetof(struct tosomi_rec, jday), 
+			    RD_TOSOMI_PRODUCT, &spool );
+     if ( IS_ERR_STAT_FATAL )
+	  NADC_GOTO_ERROR( NADC_ERR_FATAL, "failed to read product" );
 
+     hdr.numProd = 0;
+     hdr_prod = (const struct tosomi_hdr *) spool.hdr;
+     for ( np = 0; np < spool.num_prod; np++, hdr_prod++ ) {
 	  if ( hdr.numProd == 0 ) {
-	       (void) memcpy( &hdr, &hdr_tmp, sizeof(struct tosomi_hdr) ); 
-	       if ( hdr_tmp.numRec > 0 ) {
-		    rec = (struct tosomi_rec *)
-			 malloc( hdr_tmp.numRec * sizeof( struct tosomi_rec ));
-		    if ( rec == NULL ) 
-			 NADC_GOTO_ERROR( NADC_ERR_ALLOC, "rec" );
-		    (void) memcpy( rec, rec_tmp, 
-				   hdr_tmp.numRec * sizeof(struct tosomi_rec) );
-	       }
+	       (void) memcpy( &hdr, hdr_prod, sizeof(struct tosomi_hdr) ); 
 	  } else {
-	       if ( strcmp( hdr.software_version, hdr_tmp.software_version ) != 0 )
+	       if ( strcmp( hdr.software_version, hdr_prod->software_version ) != 0 )
 		    NADC_GOTO_ERROR( NADC_ERR_FATAL,
 				     "inconsistent product versions" );
 
 	       /* update header struct */
-	       hdr.numProd += hdr_tmp.numProd;
-	       hdr.numRec  += hdr_tmp.numRec;
-	       hdr.file_size = hdr_tmp.file_size;
-	       (void) strcat( hdr.l1b_product, "," );
-	       (void) strcat( hdr.l1b_product, hdr_tmp.l1b_product );
-
-	       /* append new records */
-	       if ( hdr.numRec > 0 ) {
-		    rec = (struct tosomi_rec *)
-			 realloc( rec, hdr.numRec * sizeof(struct tosomi_rec));
-		    if ( rec == NULL ) 
-			 NADC_GOTO_ERROR( NADC_ERR_ALLOC, "rec" );
-		    (void) memcpy( rec + (hdr.numRec - hdr_tmp.numRec), 
-				   rec_tmp, 
-				   hdr_tmp.numRec * sizeof(struct tosomi_rec) );
-	       }
+	       hdr.numProd += hdr_prod->numProd;
+	       hdr.numRec  += hdr_prod->numRec;
+	       hdr.file_size = hdr_prod->file_size;
+	       (void) nadc_strlcat( hdr.l1b_product, ",", 
+				    sizeof(hdr.l1b_product) );
+	       (void) nadc_strlcat( hdr.l1b_product, hdr_prod->l1b_product, 
+				    sizeof(hdr.l1b_product) );
 	  }
-	  if ( rec_tmp != NULL ) free( rec_tmp );
-     } while ( ++na < param.num_infiles );
+     }
 /*
- * check number of records read from IMAP product
+ * check number of records read from TOSOMI product
  */
-     if ( hdr.numRec == 0u || rec == NULL ) {
+     if ( spool.num_read == 0u ) {
           NADC_GOTO_ERROR( NADC_ERR_NONE, 
                            "No valid retrievals found in product" );
      }
 /*
- * sort the TOSOMI records in time
+ * select the TOSOMI records in the clip range
  */
-     if ( hdr.numRec > 1 ) {
-	  jday = (double *) malloc( hdr.numRec * sizeof(double) );
-	  if ( jday == NULL ) NADC_GOTO_ERROR( NADC_ERR_ALLOC, "jday" );
-	  for ( nr = 0; nr < hdr.numRec; nr++ ) jday[nr] = rec[nr].jday;
-	  HPSORT( hdr.numRec, jday, rec );
-
-	  if ( param.flag_clip == PARAM_SET ) {
-	       register unsigned int ilow, ihigh;
-
-	       double jdayStart, jdayStop;
-
-	       jdayStart = Adaguc2sciaJDAY( param.clipStart );
-	       jdayStop  = Adaguc2sciaJDAY( param.clipStop );
-	       (void) nadc_strlcpy( hdr.validity_start, param.clipStart, 16 );
-	       (void) nadc_strlcpy( hdr.validity_stop, param.clipStop, 16 );
-
-	       for ( ilow = 0; ilow < hdr.numRec; ilow++ ) 
-		    if ( jday[ilow] >= jdayStart ) break;
-	       for ( ihigh = hdr.numRec-1; ihigh > ilow; ihigh-- ) 
-		    if ( jday[ihigh] <= jdayStop ) break;
-
-	       if ( ihigh <= ilow ) {
-		    NADC_GOTO_ERROR( NADC_ERR_FATAL, 
-				     "all records outside clipRange" );
-	       } else if ( ilow > 0 || ihigh < (hdr.numRec-1) ) {
-		    hdr.numRec = ihigh - ilow + 1;
-		    (void) memmove( rec, rec+ilow, 
-				    hdr.numRec * sizeof(struct tosomi_rec) );
-	       }
-	  }
-	  free( jday );
+     if ( param.flag_clip == PARAM_SET ) {
+	  ADAGUC_SPOOL_SELECT( &spool, Adaguc2sciaJDAY( param.clipStart ),
+			       Adaguc2sciaJDAY( param.clipStop ) );
+	  if ( IS_ERR_STAT_FATAL )
+	       NADC_GOTO_ERROR( NADC_ERR_FATAL, "ADAGUC_SPOOL_SELECT" );
+	  if ( spool.num_rec == 0u )
+	       NADC_GOTO_ERROR( NADC_ERR_FATAL, 
+				"all records outside clipRange" );
+	  (void) nadc_strlcpy( hdr.validity_start, param.clipStart, 16 );
+	  (void) nadc_strlcpy( hdr.validity_stop, param.clipStop, 16 );
      }
+     hdr.numRec = spool.num_rec;
 /*
  * construct ADAGUC compiant filename, 
  * first, recontruct validity period from TOSOMI records
  */
      if ( hdr.numProd > 1 && param.flag_clip == PARAM_UNSET ) {
-	  SciaJDAY2adaguc( rec->jday, hdr.validity_start );
-	  SciaJDAY2adaguc( rec[hdr.numRec-1].jday, hdr.validity_stop );
+	  SciaJDAY2adaguc( spool.key_first, hdr.validity_start );
+	  SciaJDAY2adaguc( spool.key_last, hdr.validity_stop );
      }
      (void) snprintf( flname, sizeof(flname), "%s/"ADAGUC_PROD_TEMPLATE, 
 		      param.outdir, param.prodClass, 
@@ -287,9 +224,25 @@ int main ( int argc, char *argv[] )
      if ( IS_ERR_STAT_FATAL )
 	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "TOSOMI header" );
 
-     NADC_TOSOMI_WR_NC_REC( ncid, hdr.numRec, rec );
+     NADC_TOSOMI_DEF_NC_REC( ncid, hdr.numRec );
      if ( IS_ERR_STAT_FATAL )
 	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "TOSOMI records" );
+/*
+ * merge the TOSOMI records in time, and write them block by block
+ */
+     rec = (struct tosomi_rec *) 
+	  malloc( ADAGUC_REC_BLOCK * sizeof(struct tosomi_rec) );
+     if ( rec == NULL ) NADC_GOTO_ERROR( NADC_ERR_ALLOC, "rec" );
+
+     offs = 0u;
+     while ( (num = ADAGUC_SPOOL_MERGE( &spool, ADAGUC_REC_BLOCK, rec )) > 0 ) {
+	  NADC_TOSOMI_WR_NC_REC( ncid, offs, num, rec );
+	  if ( IS_ERR_STAT_FATAL )
+	       NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "TOSOMI records" );
+	  offs += num;
+     }
+     if ( IS_ERR_STAT_FATAL )
+	  NADC_GOTO_ERROR( NADC_ERR_FATAL, "ADAGUC_SPOOL_MERGE" );
 
      if ( nc_close( ncid ) != NC_NOERR )
 	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
@@ -298,6 +251,7 @@ int main ( int argc, char *argv[] )
  */
  done:
      if ( rec != NULL ) free( rec );
+     ADAGUC_SPOOL_CLOSE( &spool );
 /*
  * display error messages
  */
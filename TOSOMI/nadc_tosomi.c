@@ -28,7 +28,8 @@
 .RETURNS     non-negative on success, negative on failure
 .COMMENTS    None
 .ENVIRONment None
-.VERSION     1.2     12-Aug-2009   removed print statement, RvH
+.VERSION     1.3     17-Oct-2026   define and write netCDF records apart, RvH
+             1.2     12-Aug-2009   removed print statement, RvH
              1.1     20-Oct-2008   conform to ADAGUC filename format, RvH
              1.0     30-Sep-2008   initial release by R. M. van Hees
 ------------------------------------------------------------*/
@@ -162,7 +163,9 @@ int main ( int argc, char *argv[] )
 	  if ( IS_ERR_STAT_FATAL )
 	       NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "TOSOMI header" );
 
-          NADC_TOSOMI_WR_NC_REC( ncid, numRec, tosomi );
+          NADC_TOSOMI_DEF_NC_REC( ncid, numRec );
+	  if ( ! IS_ERR_STAT_FATAL )
+	       NADC_TOSOMI_WR_NC_REC( ncid, 0u, numRec, tosomi );
 	  if ( IS_ERR_STAT_FATAL )
 	       NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "TOSOMI records" );
 
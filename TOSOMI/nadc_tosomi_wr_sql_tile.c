@@ -31,7 +31,8 @@
 .RETURNS     Nothing, error status passed by global variable ``nadc_stat''
 .COMMENTS    None
 .ENVIRONment None
-.VERSION     1.1     12-Aug-2009   bugfix string allocation too small, RvH
+.VERSION     1.2     17-Oct-2026   bulk ingest of tiles using COPY, RvH
+             1.1     12-Aug-2009   bugfix string allocation too small, RvH
              1.0     07-Oct-2008   initial release by R. M. van Hees
 ------------------------------------------------------------*/
 /*
@@ -49,6 +50,8 @@
 /*+++++ Local Headers +++++*/
 #include <nadc_tosomi.h>
 
+#include <_nadc_sql_copy.inc>
+
 /*+++++ Macros +++++*/
 	/* NONE */
 
@@ -56,13 +59,14 @@
 #define SQL_STR_SIZE   384
 
 #define META_TBL_NAME "meta_tosomi"
-#define TILE_TBL_NAME "tile_tosomi"
 
-#define SQL_INSERT_TILE \
-"INSERT INTO %s (pk_tile,fk_meta,julianDay,integrationTime,\
- cloudFraction,cloudTopPress,amf,amfCloud,ozone,ozoneSlant,tile) \
- VALUES (%lld,%d,%.11f,%hhu,%hhu,%hu,%.5g,%.5g,%.5g,%.6g,ST_GeomFromText(\
- \'POLYGON((%.6f %.6f,%.6f %.6f,%.6f %.6f,%.6f %.6f,%.6f %.6f))\', 4326))"
+#define TILE_TBL_COLUMNS \
+"tile_tosomi (pk_tile,fk_meta,julianDay,integrationTime,\
+ cloudFraction,cloudTopPress,amf,amfCloud,ozone,ozoneSlant,tile)"
+
+#define SQL_COPY_TILE \
+"%lld\t%d\t%.11f\t%hhu\t%hhu\t%hu\t%.5g\t%.5g\t%.5g\t%.6g\t\
+SRID=4326;POLYGON((%.6f %.6f,%.6f %.6f,%.6f %.6f,%.6f %.6f,%.6f %.6f))\n"
 
 /*+++++ Static Variables +++++*/
 	/* NONE */
@@ -79,95 +83,71 @@ void NADC_TOSOMI_WR_SQL_TILE( PGconn *conn, const char *prodName,
      register unsigned int insertedRows = 0u;
      register unsigned int failedRows = num_rec;
 
-     char   sql_query[SQL_STR_SIZE], cbuff[SQL_STR_SIZE];
+     char   cbuff[SQL_STR_SIZE];
 
-     char           *pntr;
-     int            nrow, numChar, meta_id;
+     int    meta_id;
 
-     long long tile_id;
+     long long *tile_id = NULL;
 
-     PGresult *res;
+     struct sql_copy_rec copy;
 /*
  * check if product is already in database
  */
-     (void) snprintf( sql_query, SQL_STR_SIZE, 
-		      "SELECT pk_meta FROM %s WHERE name=\'%s\'", 
-		      META_TBL_NAME, prodName );
-     res = PQexec( conn, sql_query );
-     if ( PQresultStatus( res ) != PGRES_TUPLES_OK ) {
-          NADC_GOTO_ERROR( NADC_ERR_SQL, PQresultErrorMessage(res) );
-     }
-     if ( (nrow = PQntuples( res )) == 0 ) {
-          NADC_GOTO_ERROR( NADC_ERR_FATAL, prodName );
-     }
-     pntr = PQgetvalue( res, 0, 0 );
-     meta_id = (int) strtol( pntr, (char **) NULL, 10 );     
-     PQclear( res );
+     meta_id = NADC_SQL_GET_META_ID( conn, META_TBL_NAME, prodName );
+     if ( IS_ERR_STAT_FATAL ) goto done;
+     if ( num_rec == 0u ) goto done;
+/*
+ * obtain values for serial pk_tile (one round trip)
+ */
+     tile_id = (long long *) malloc( num_rec * sizeof(long long) );
+     if ( tile_id == NULL ) NADC_GOTO_ERROR( NADC_ERR_ALLOC, "tile_id" );
+     NADC_SQL_NEXTVAL( conn, "tile_tosomi_pk_tile_seq", num_rec, tile_id );
+     if ( IS_ERR_STAT_FATAL ) goto done;
 /*
  * Start a transaction block
  */
-     res = PQexec( conn, "BEGIN" );
-     if ( PQresultStatus( res ) != PGRES_COMMAND_OK )
-          NADC_GOTO_ERROR( NADC_ERR_SQL, PQresultErrorMessage(res) );
-     PQclear( res );
+     NADC_SQL_COMMAND( conn, "BEGIN" );
+     if ( IS_ERR_STAT_FATAL ) goto done;
 /*
- * insert all tiles in product
+ * stream all tiles of the product to the server
  */
-     for ( nr = 0; nr < num_rec; nr++ ) {
-	  /* obtain next value for serial pk_tile */
-	  res = PQexec( conn,
-			"SELECT nextval(\'tile_tosomi_pk_tile_seq\')" );
-	  if ( PQresultStatus( res ) != PGRES_TUPLES_OK )
-	       NADC_GOTO_ERROR( NADC_ERR_SQL, 
-				PQresultErrorMessage(res) );
-	  pntr = PQgetvalue( res, 0, 0 );
-	  tile_id = strtoll( pntr, (char **) NULL, 10 );
-	  PQclear( res );
-
-	  numChar = snprintf( sql_query, SQL_STR_SIZE, SQL_INSERT_TILE, 
-			      TILE_TBL_NAME, tile_id, meta_id, rec[nr].jday,
-			      rec[nr].meta.intg_time, 
-			      rec[nr].meta.cloudFraction, 
-			      rec[nr].meta.cloudTopPress,
-			      rec[nr].meta.amfSky, rec[nr].meta.amfCloud,
-			      rec[nr].vcd / 10.f, rec[nr].scd / 10.f,
-			      rec[nr].lon_corner[0] / 1e2,
-			      rec[nr].lat_corner[0] / 1e2,
-			      rec[nr].lon_corner[1] / 1e2,
-			      rec[nr].lat_corner[1] / 1e2,
-			      rec[nr].lon_corner[2] / 1e2,
-			      rec[nr].lat_corner[2] / 1e2,
-			      rec[nr].lon_corner[3] / 1e2,
-			      rec[nr].lat_corner[3] / 1e2,
-			      rec[nr].lon_corner[0] / 1e2,
-			      rec[nr].lat_corner[0] / 1e2 );
-
-  	  /* (void) fprintf( stderr, "%s [%-d]\n", sql_query, numChar ); */
-	  if ( numChar >= SQL_STR_SIZE )
-	       NADC_RETURN_ERROR( NADC_ERR_STRLEN, "sql_query" );
-	  res = PQexec( conn, sql_query );
-	  if ( PQresultStatus( res ) != PGRES_COMMAND_OK ) {
-	       NADC_ERROR( NADC_ERR_SQL, PQresultErrorMessage(res) );
-	       PQclear( res );
-	       res = PQexec( conn, "ROLLBACK" );
-	       if ( PQresultStatus( res ) != PGRES_COMMAND_OK )
-		    NADC_ERROR( NADC_ERR_SQL,
-				PQresultErrorMessage(res) );
-	       goto done;
-	  }
-	  PQclear( res );
-
-	  insertedRows++;
-	  failedRows--;
+     NADC_SQL_COPY_BEGIN( conn, TILE_TBL_COLUMNS, &copy );
+     for ( nr = 0; nr < num_rec && ! IS_ERR_STAT_FATAL; nr++ ) {
+	  NADC_SQL_COPY_ROW( &copy, SQL_COPY_TILE, tile_id[nr], meta_id,
+			     rec[nr].jday, rec[nr].meta.intg_time, 
+			     rec[nr].meta.cloudFraction, 
+			     rec[nr].meta.cloudTopPress,
+			     rec[nr].meta.amfSky, rec[nr].meta.amfCloud,
+			     rec[nr].vcd / 10.f, rec[nr].scd / 10.f,
+			     rec[nr].lon_corner[0] / 1e2,
+			     rec[nr].lat_corner[0] / 1e2,
+			     rec[nr].lon_corner[1] / 1e2,
+			     rec[nr].lat_corner[1] / 1e2,
+			     rec[nr].lon_corner[2] / 1e2,
+			     rec[nr].lat_corner[2] / 1e2,
+			     rec[nr].lon_corner[3] / 1e2,
+			     rec[nr].lat_corner[3] / 1e2,
+			     rec[nr].lon_corner[0] / 1e2,
+			     rec[nr].lat_corner[0] / 1e2 );
      }
+     if ( IS_ERR_STAT_FATAL )
+	  NADC_SQL_COPY_ABORT( &copy );
+     else
+	  NADC_SQL_COPY_END( &copy );
 /*
  * end the transaction
  */
-     res = PQexec( conn, "COMMIT" );
-     if ( PQresultStatus( res ) != PGRES_COMMAND_OK )
-          NADC_ERROR( NADC_ERR_SQL, PQresultErrorMessage(res) );
+     if ( IS_ERR_STAT_FATAL ) {
+	  NADC_SQL_COMMAND( conn, "ROLLBACK" );
+	  goto done;
+     }
+     NADC_SQL_COMMAND( conn, "COMMIT" );
+     if ( ! IS_ERR_STAT_FATAL ) {
+	  insertedRows = copy.num_rows;
+	  failedRows = num_rec - insertedRows;
+     }
  done:
-     PQclear( res );
+     if ( tile_id != NULL ) free( tile_id );
      (void) snprintf( cbuff, SQL_STR_SIZE, "insertedRows=%-u", insertedRows );
      NADC_ERROR( NADC_ERR_NONE, cbuff );
      if ( failedRows > 0 ) {
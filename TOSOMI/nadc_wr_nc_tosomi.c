@@ -20,9 +20,12 @@
 .KEYWORDS    TOSOMI Sciamachy
 .LANGUAGE    ANSI C
 .PURPOSE     write Tosomi product in ADAGUC format
-.COMMENTS    contains NADC_TOSOMI_WR_NC_META and NADC_TOSOMI_WR_NC_REC
+.COMMENTS    contains NADC_TOSOMI_WR_NC_META, NADC_TOSOMI_DEF_NC_REC 
+             and NADC_TOSOMI_WR_NC_REC
 .ENVIRONment None
-.VERSION     1.1     18-Aug-2009   removed scale_factor in dimensions, RvH
+.VERSION     1.2     17-Oct-2026   define the variables once, write the
+                                   records in blocks, RvH
+             1.1     18-Aug-2009   removed scale_factor in dimensions, RvH
              1.0     08-Oct-2008   initial release by R. M. van Hees
 ------------------------------------------------------------*/
 /*
@@ -161,182 +164,133 @@ void NADC_TOSOMI_WR_NC_META( int ncid, const struct tosomi_hdr *hdr )
 }
 
 /*+++++++++++++++++++++++++
-.IDENTifer   NADC_TOSOMI_WR_NC_REC
-.PURPOSE     write records to Tosomi product in netCDF-4 format 
-             (ADAGUC standard)
+.IDENTifer   NADC_TOSOMI_DEF_NC_REC
+.PURPOSE     define the record variables of a Tosomi product in netCDF-4 
+             format (ADAGUC standard)
 .INPUT/OUTPUT
-  call as   NADC_TOSOMI_WR_NC_REC( ncid, numRec, rec );
+  call as   NADC_TOSOMI_DEF_NC_REC( ncid, numRec );
      input:
             int ncid               :   netCDF file ID
             unsigned int numRec    :   number of TOSOMI records
-            struct tosomi_rec *rec :   TOSOMI records
 
 .RETURNS     Nothing
-.COMMENTS    None
+.COMMENTS    the records are written by NADC_TOSOMI_WR_NC_REC, 
+             the variables are chunked by ADAGUC_REC_BLOCK records
 -------------------------*/
-void NADC_TOSOMI_WR_NC_REC( int ncid, unsigned int numRec,
-			    const struct tosomi_rec *rec )
+void NADC_TOSOMI_DEF_NC_REC( int ncid, unsigned int numRec )
 {
-     register unsigned int ni, nr;
-
      int    retval;
      int    time_id, nv_id, dimids[2];
      int    meta_id, var_id;
      float  scale;
 
-     unsigned short *ubuff = NULL;
-     float          *rbuff = NULL;
-     double         *dbuff = NULL;
-
-     struct tosomi_meta_rec *mbuff;
-
-     size_t chunk_size[2] = {numRec, NUM_CORNERS};
+     size_t chunk_size[2] = {ADAGUC_REC_BLOCK, NUM_CORNERS};
      
      if ( numRec == 0u ) return;
+     if ( numRec < ADAGUC_REC_BLOCK ) chunk_size[0] = numRec;
 /*
- * write dimension scale "time"
+ * define dimension scale "time"
  */
-     dbuff = (double *) malloc( numRec * sizeof(double) );
-     if ( dbuff == NULL ) NADC_RETURN_ERROR( NADC_ERR_ALLOC, "dbuff" );
-
      retval = nc_def_dim( ncid, "time", (size_t) numRec, &time_id );
      if ( retval != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
      (void) nc_def_var( ncid, "time", NC_DOUBLE, 1, &time_id, &var_id );
      (void) nc_put_att_text( ncid, var_id, "long_name", 4, "time" );
      (void) nc_put_att_text( ncid, var_id, "units", 34, 
 			     "days since 2000-01-01 00:00:00 UTC" );
      (void) nc_put_att_text( ncid, var_id, "calendar", 4, "none" );
-     for ( nr = 0; nr < numRec; nr++ ) dbuff[nr] = rec[nr].jday;
      (void) nc_def_var_chunking( ncid, var_id, 0, chunk_size );
      (void) nc_def_var_deflate( ncid, var_id, 0, 1, 6 );
-     (void) nc_put_var_double( ncid, var_id, dbuff );
 
      retval = nc_def_dim( ncid, "nv", NUM_CORNERS, &nv_id );
      if ( retval != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
 /*
- * write longitude and latitude of measurements
+ * define longitude and latitude of measurements
  */
-     scale = 0.01f;
-     rbuff = (float *) malloc( numRec * sizeof(float) );
-     if ( rbuff == NULL ) NADC_RETURN_ERROR( NADC_ERR_ALLOC, "rbuff" );
-
      retval = nc_def_var( ncid, "lon", NC_FLOAT, 1, &time_id, &var_id );
      if ( retval != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
      (void) nc_def_var_chunking( ncid, var_id, 0, chunk_size );
      (void) nc_def_var_deflate( ncid, var_id, 0, 1, 6 );
      (void) nc_put_att_text( ncid, var_id, "long_name", 9, "longitude" );
      (void) nc_put_att_text( ncid, var_id, "units", 12, "degrees_east" );
      (void) nc_put_att_text( ncid, var_id, "standard_name", 9, "longitude" );
      (void) nc_put_att_text( ncid, var_id, "bounds", 8, "lon_bnds" );
-     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = scale * rec[nr].lon_center;
-     (void) nc_put_var_float( ncid, var_id, rbuff );
 
      retval = nc_def_var( ncid, "lat", NC_FLOAT, 1, &time_id, &var_id );
      if ( retval != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
      (void) nc_def_var_chunking( ncid, var_id, 0, chunk_size );
      (void) nc_def_var_deflate( ncid, var_id, 0, 1, 6 );
      (void) nc_put_att_text( ncid, var_id, "long_name", 8, "latitude" );
      (void) nc_put_att_text( ncid, var_id, "units", 13, "degrees_north" );
      (void) nc_put_att_text( ncid, var_id, "standard_name", 8, "latitude" );
      (void) nc_put_att_text( ncid, var_id, "bounds", 8, "lat_bnds" );
-      for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = scale * rec[nr].lat_center;
-     (void) nc_put_var_float( ncid, var_id, rbuff );
 /*
- * write longitude and latitude of tile-corners
+ * define longitude and latitude of tile-corners
  */
-     rbuff = (float *) realloc( rbuff, NUM_CORNERS * numRec * sizeof(float) );
-     if ( rbuff == NULL ) NADC_RETURN_ERROR( NADC_ERR_ALLOC, "rbuff" );
-
      dimids[0] = time_id;
      dimids[1] = nv_id;
      retval = nc_def_var( ncid, "lon_bnds", NC_FLOAT, 2, dimids, &var_id );
      if ( retval != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
      (void) nc_def_var_chunking( ncid, var_id, 0, chunk_size );
      (void) nc_def_var_deflate( ncid, var_id, 0, 1, 6 );
-     for ( ni = nr = 0; nr < numRec; nr++ ) {
-	  rbuff[ni++] = scale * rec[nr].lon_corner[0];
-	  rbuff[ni++] = scale * rec[nr].lon_corner[1];
-	  rbuff[ni++] = scale * rec[nr].lon_corner[2];
-	  rbuff[ni++] = scale * rec[nr].lon_corner[3];
-     }
-     (void) nc_put_var_float( ncid, var_id, rbuff );
 
      retval = nc_def_var( ncid, "lat_bnds", NC_FLOAT, 2, dimids, &var_id );
      if ( retval != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
      (void) nc_def_var_chunking( ncid, var_id, 0, chunk_size );
      (void) nc_def_var_deflate( ncid, var_id, 0, 1, 6 );
-     for ( ni = nr = 0; nr < numRec; nr++ ) {
-	  rbuff[ni++] = scale * rec[nr].lat_corner[0];
-	  rbuff[ni++] = scale * rec[nr].lat_corner[1];
-	  rbuff[ni++] = scale * rec[nr].lat_corner[2];
-	  rbuff[ni++] = scale * rec[nr].lat_corner[3];
-     }
-     (void) nc_put_var_float( ncid, var_id, rbuff );
 /*
- * write datasets
+ * define datasets
  */
      scale = 0.1f;
-     ubuff = (unsigned short *) malloc( numRec * sizeof(short) );
-     if ( ubuff == NULL ) NADC_RETURN_ERROR( NADC_ERR_ALLOC, "ubuff" );
-
      var_id = ADAGUC_DEF_VAR( ncid, NC_USHORT, time_id, "scd", "Dobson unit", 
 			     "total slant ozone column",
 			     "total_slant_ozone_column", NULL );
      if ( IS_ERR_STAT_FATAL )
-          NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "scd" );
+          NADC_RETURN_ERROR( NADC_ERR_HDF_WR, "scd" );
      (void) nc_put_att_float( ncid, var_id, "scale_factor", 
 			      NC_FLOAT, 1, &scale );
-     for ( nr = 0; nr < numRec; nr++ ) ubuff[nr] = rec[nr].scd;
      (void) nc_def_var_chunking( ncid, var_id, 0, chunk_size );
      (void) nc_def_var_deflate( ncid, var_id, 0, 1, 6 );
-     (void) nc_put_var_ushort( ncid, var_id, ubuff );
      /*+++++++++++++++++++++++++*/
      var_id = ADAGUC_DEF_VAR( ncid, NC_USHORT, time_id, "vcd", "Dobson unit",
 			     "total vertical ozone column",
 			     "total_vertical_ozone_column", "vcdError" );
      if ( IS_ERR_STAT_FATAL )
-          NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "vcd" );
+          NADC_RETURN_ERROR( NADC_ERR_HDF_WR, "vcd" );
      (void) nc_put_att_float( ncid, var_id, "scale_factor", 
 			      NC_FLOAT, 1, &scale );
-     for ( nr = 0; nr < numRec; nr++ ) ubuff[nr] = rec[nr].vcd;
      (void) nc_def_var_chunking( ncid, var_id, 0, chunk_size );
      (void) nc_def_var_deflate( ncid, var_id, 0, 1, 6 );
-     (void) nc_put_var_ushort( ncid, var_id, ubuff );
      /*+++++++++++++++++++++++++*/
      var_id = ADAGUC_DEF_VAR( ncid, NC_USHORT, time_id, "vcdError", 
 			     "Dobson unit",
 			     "(minimum) error in the ozone column",
 			     "vertical_ozone_column standard error", NULL );
      if ( IS_ERR_STAT_FATAL )
-          NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "vcdError" );
-     for ( nr = 0; nr < numRec; nr++ ) ubuff[nr] = rec[nr].vcdError;
+          NADC_RETURN_ERROR( NADC_ERR_HDF_WR, "vcdError" );
      (void) nc_def_var_chunking( ncid, var_id, 0, chunk_size );
      (void) nc_def_var_deflate( ncid, var_id, 0, 1, 6 );
-     (void) nc_put_var_ushort( ncid, var_id, ubuff );
      /*+++++++++++++++++++++++++*/
      var_id = ADAGUC_DEF_VAR( ncid, NC_USHORT, time_id, "vcdRaw",
 			     "vertical ozone column above cloud-top",
 			     "Dobson unit", 
 			     "cloud_top_vertical_ozone_column", NULL );
      if ( IS_ERR_STAT_FATAL )
-          NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "vcdRaw" );
-     for ( nr = 0; nr < numRec; nr++ ) ubuff[nr] = rec[nr].vcdRaw;
+          NADC_RETURN_ERROR( NADC_ERR_HDF_WR, "vcdRaw" );
      (void) nc_def_var_chunking( ncid, var_id, 0, chunk_size );
      (void) nc_def_var_deflate( ncid, var_id, 0, 1, 6 );
-     (void) nc_put_var_ushort( ncid, var_id, ubuff );
 /*
- * write pixel meta-data as compound dataset
+ * define pixel meta-data as compound dataset
  */
      retval = nc_def_compound( ncid, sizeof(struct tosomi_meta_rec),
                                "meta_rec", &meta_id );
      if ( retval != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
      (void) nc_insert_compound( ncid, meta_id, "integration_time",
 				HOFFSET( struct tosomi_meta_rec, intg_time ), 
 				NC_UBYTE );
@@ -370,22 +324,113 @@ void NADC_TOSOMI_WR_NC_REC( int ncid, unsigned int numRec,
      retval = nc_def_var( ncid, "tile_properties", 
 			  meta_id, 1, &time_id, &var_id );
      if ( retval != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+	  NADC_RETURN_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
      (void) nc_put_att_text( ncid, var_id, "long_name", 36,
 			     "pixel properties and retrieval flags" );
      (void) nc_def_var_chunking( ncid, var_id, 0, chunk_size );
      (void) nc_def_var_deflate( ncid, var_id, 0, 1, 6 );
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   NADC_TOSOMI_WR_NC_REC
+.PURPOSE     write a block of records to Tosomi product in netCDF-4 format 
+             (ADAGUC standard)
+.INPUT/OUTPUT
+  call as   NADC_TOSOMI_WR_NC_REC( ncid, offs, numRec, rec );
+     input:
+            int ncid               :   netCDF file ID
+            unsigned int offs      :   index of the first record of block
+            unsigned int numRec    :   number of TOSOMI records in block
+            struct tosomi_rec *rec :   TOSOMI records
+
+.RETURNS     Nothing
+.COMMENTS    the variables are defined by NADC_TOSOMI_DEF_NC_REC
+-------------------------*/
+void NADC_TOSOMI_WR_NC_REC( int ncid, unsigned int offs, unsigned int numRec,
+			    const struct tosomi_rec *rec )
+{
+     register unsigned int ni, nr;
+
+     float  scale;
+
+     unsigned short *ubuff = NULL;
+     float          *rbuff = NULL;
+     double         *dbuff = NULL;
+
+     struct tosomi_meta_rec *mbuff = NULL;
+     
+     if ( numRec == 0u ) return;
+
+     dbuff = (double *) malloc( numRec * sizeof(double) );
+     if ( dbuff == NULL ) NADC_GOTO_ERROR( NADC_ERR_ALLOC, "dbuff" );
+     rbuff = (float *) malloc( NUM_CORNERS * numRec * sizeof(float) );
+     if ( rbuff == NULL ) NADC_GOTO_ERROR( NADC_ERR_ALLOC, "rbuff" );
+     ubuff = (unsigned short *) malloc( numRec * sizeof(short) );
+     if ( ubuff == NULL ) NADC_GOTO_ERROR( NADC_ERR_ALLOC, "ubuff" );
      mbuff = (struct tosomi_meta_rec *) 
 	  malloc( numRec * sizeof(struct tosomi_meta_rec) );
-     if ( mbuff == NULL ) NADC_RETURN_ERROR( NADC_ERR_ALLOC, "mbuff" );
+     if ( mbuff == NULL ) NADC_GOTO_ERROR( NADC_ERR_ALLOC, "mbuff" );
+/*
+ * write dimension scale "time"
+ */
+     for ( nr = 0; nr < numRec; nr++ ) dbuff[nr] = rec[nr].jday;
+     ADAGUC_PUT_VARA( ncid, "time", offs, numRec, 1, dbuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "time" );
+/*
+ * write longitude and latitude of measurements
+ */
+     scale = 0.01f;
+     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = scale * rec[nr].lon_center;
+     ADAGUC_PUT_VARA( ncid, "lon", offs, numRec, 1, rbuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "lon" );
+     for ( nr = 0; nr < numRec; nr++ ) rbuff[nr] = scale * rec[nr].lat_center;
+     ADAGUC_PUT_VARA( ncid, "lat", offs, numRec, 1, rbuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "lat" );
+/*
+ * write longitude and latitude of tile-corners
+ */
+     for ( ni = nr = 0; nr < numRec; nr++ ) {
+	  rbuff[ni++] = scale * rec[nr].lon_corner[0];
+	  rbuff[ni++] = scale * rec[nr].lon_corner[1];
+	  rbuff[ni++] = scale * rec[nr].lon_corner[2];
+	  rbuff[ni++] = scale * rec[nr].lon_corner[3];
+     }
+     ADAGUC_PUT_VARA( ncid, "lon_bnds", offs, numRec, NUM_CORNERS, rbuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "lon_bnds" );
+     for ( ni = nr = 0; nr < numRec; nr++ ) {
+	  rbuff[ni++] = scale * rec[nr].lat_corner[0];
+	  rbuff[ni++] = scale * rec[nr].lat_corner[1];
+	  rbuff[ni++] = scale * rec[nr].lat_corner[2];
+	  rbuff[ni++] = scale * rec[nr].lat_corner[3];
+     }
+     ADAGUC_PUT_VARA( ncid, "lat_bnds", offs, numRec, NUM_CORNERS, rbuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "lat_bnds" );
+/*
+ * write datasets
+ */
+     for ( nr = 0; nr < numRec; nr++ ) ubuff[nr] = rec[nr].scd;
+     ADAGUC_PUT_VARA( ncid, "scd", offs, numRec, 1, ubuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "scd" );
+     for ( nr = 0; nr < numRec; nr++ ) ubuff[nr] = rec[nr].vcd;
+     ADAGUC_PUT_VARA( ncid, "vcd", offs, numRec, 1, ubuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "vcd" );
+     for ( nr = 0; nr < numRec; nr++ ) ubuff[nr] = rec[nr].vcdError;
+     ADAGUC_PUT_VARA( ncid, "vcdError", offs, numRec, 1, ubuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "vcdError" );
+     for ( nr = 0; nr < numRec; nr++ ) ubuff[nr] = rec[nr].vcdRaw;
+     ADAGUC_PUT_VARA( ncid, "vcdRaw", offs, numRec, 1, ubuff );
+     if ( IS_ERR_STAT_FATAL ) NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "vcdRaw" );
+/*
+ * write pixel meta-data as compound dataset
+ */
      for ( nr = 0; nr < numRec; nr++ )
 	  (void) memcpy( mbuff+nr, &rec[nr].meta, 
 			 sizeof(struct tosomi_meta_rec) );
-     retval = nc_put_var( ncid, var_id, mbuff );
-     free( mbuff );
-     if ( retval != NC_NOERR )
-	  NADC_GOTO_ERROR( NADC_ERR_FATAL, nc_strerror(retval) );
+     ADAGUC_PUT_VARA( ncid, "tile_properties", offs, numRec, 1, mbuff );
+     if ( IS_ERR_STAT_FATAL ) 
+	  NADC_GOTO_ERROR( NADC_ERR_HDF_WR, "tile_properties" );
  done:
+     if ( mbuff != NULL ) free( mbuff );
      if ( ubuff != NULL ) free( ubuff );
      if ( rbuff != NULL ) free( rbuff );
      if ( dbuff != NULL ) free( dbuff );
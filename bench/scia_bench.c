@@ -0,0 +1,1146 @@
+/*++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+.COPYRIGHT (c) 2026 SRON (R.M.van.Hees@sron.nl)
+
+   This is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License, version 2, as
+   published by the Free Software Foundation.
+
+   The software is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place - Suite 330,
+   Boston, MA  02111-1307, USA.
+
+.IDENTifer   SCIA_BENCH
+.AUTHOR      R.M. van Hees
+.KEYWORDS    SCIA level 0, level 1b
+.LANGUAGE    ANSI C
+.PURPOSE     benchmark of the SCIAMACHY readers on synthetic products
+.INPUT/OUTPUT
+  call as
+            scia_bench <outdir> [num_state] [num_dsr]
+
+.RETURNS     non-negative on success, negative on failure
+.COMMENTS    - a level 0 and a level 1b product are generated in <outdir>
+               with the PDS writers of this library: num_state Nadir
+	       states (default 8) of num_dsr Detector packets or level 1b
+	       MDS (default 32)
+	     - both products are read back through the stages of scia_nl0
+	       and scia_nl1, the timing of each stage is written to stdout
+	       as CSV: product,stage,seconds,records,bytes
+	     - the level 1b MDS are calibrated three times (dark, PPG,
+	       Etalon, bad pixel mask and errors): per cluster (default),
+	       fused (-cal_fused) and on grouped spectra (-cal_spec), the
+	       bench fails when the calibrated spectra or their errors are
+	       not bit-identical to those of the default run
+	     - there is no writer for level 2 products, therefore, no
+	       level 2 product is generated
+.ENVIRONment None
+.EXTERNALs   the level 0 reader needs the ROE database (ROE_EXC_all.h5) in
+             the working directory or in the directory with the CKD, without
+	     it the level 0 stages are skipped
+.VERSION      1.6   17-Oct-2026 calib_spec stage set by flag_cal_spec, RvH
+              1.5   17-Oct-2026 dark correction, compare default and fused
+                                calibrated spectra, RvH
+              1.4   17-Oct-2026 release the cached CKD at exit, RvH
+              1.3   17-Oct-2026 close the SDMF databases at exit, RvH
+              1.2   17-Oct-2026 skip level 0 without ROE database, write
+                                the MPH to the level 0 HDF5 file, RvH
+              1.1   17-Oct-2026 fused stage set by flag_cal_fused, RvH
+              1.0   17-Oct-2026 Created by R. M. van Hees
+------------------------------------------------------------*/
+/*+++++ System headers +++++*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <hdf5.h>
+
+/*+++++ Local Headers +++++*/
+#define _SCIA_LEVEL_1
+#include <nadc_scia_cal.h>
+#include <nadc_sdmf.h>
+
+/*+++++ Macros +++++*/
+#define BENCH_NUM_STATE    8
+#define BENCH_NUM_DSR      32
+
+#define BENCH_STATE_ID     6             /* Nadir state */
+#define BENCH_NUM_CLUS     2             /* clusters per channel */
+#define BENCH_CLUS_LENGTH  (CHANNEL_SIZE / BENCH_NUM_CLUS)
+
+#define LV0_CHAN_HDR_LENGTH  16
+#define LV0_CLUS_HDR_LENGTH  10
+
+/* level 1b: readouts per MDS of the fastest cluster, PMD and PolV records */
+#define LV1_NUM_AUX        4
+#define LV1_NUM_PMD        (32 * PMD_NUMBER)
+#define LV1_NUM_POL        5
+
+#define LV1_NUM_TEMPLATE   8
+
+#define NAME_ROE_DB        "ROE_EXC_all.h5"
+
+/*+++++ Global Variables +++++*/
+bool Use_Extern_Alloc = FALSE;
+
+/*+++++ Static Variables +++++*/
+static const struct dsd_envi lv1_template[LV1_NUM_TEMPLATE] = {
+     {"INSTRUMENT_PARAMS", "G", "", 0u, 0u, 0u, 0},
+     {"LEAKAGE_CONSTANT", "G", "", 0u, 0u, 0u, 0},
+     {"PPG_ETALON", "G", "", 0u, 0u, 0u, 0},
+     {"STATES", "A", "", 0u, 0u, 0u, 0},
+     {"NADIR", "M", "", 0u, 0u, 0u, -1},
+     {"LIMB", "M", "", 0u, 0u, 0u, -1},
+     {"OCCULTATION", "M", "", 0u, 0u, 0u, -1},
+     {"MONITORING", "M", "", 0u, 0u, 0u, -1}
+};
+
+/*+++++++++++++++++++++++++ Static Functions +++++++++++++++++++++++*/
+static inline
+void BENCH_START(void)
+{
+     nadc_set_start_time();
+}
+
+static inline
+void BENCH_STOP(double *seconds)
+{
+     nadc_set_stop_time();
+     *seconds += nadc_get_epoch_time();
+}
+
+static
+void BENCH_REPORT(const char *product, const char *stage, double seconds,
+		  unsigned long long records, unsigned long long bytes)
+{
+     (void) printf("%s,%s,%.6f,%llu,%llu\n",
+		   product, stage, seconds, records, bytes);
+}
+
+/*
+ * simple linear congruential generator, the products are reproducible
+ */
+static
+unsigned short BENCH_RAND(unsigned int *seed)
+{
+     *seed = 1664525u * (*seed) + 1013904223u;
+     return (unsigned short) (*seed >> 16);
+}
+
+static
+void FILL_MPH(const char *product, unsigned int sph_size,
+	      unsigned int num_dsd, struct mph_envi *mph)
+{
+     const char utc_start[] = "01-JAN-2004 12:00:00.000000";
+     const char utc_stop[]  = "01-JAN-2004 12:10:00.000000";
+
+     (void) memset(mph, 0, sizeof(struct mph_envi));
+     (void) nadc_strlcpy(mph->product, product, ENVI_FILENAME_SIZE);
+     (void) strcpy(mph->proc_stage, "N");
+     (void) strcpy(mph->ref_doc, "PO-RS-MDA-GS-2009_3/B");
+     (void) strcpy(mph->acquis, "PDHS-K");
+     (void) strcpy(mph->proc_center, "PDHS-K");
+     (void) strcpy(mph->proc_time, utc_start);
+     (void) strcpy(mph->soft_version, "SCIA/8.02");
+     (void) strcpy(mph->sensing_start, utc_start);
+     (void) strcpy(mph->sensing_stop, utc_stop);
+     (void) strcpy(mph->phase, "2");
+     mph->cycle = 23;
+     mph->rel_orbit = 1;
+     mph->abs_orbit = 9000;
+     (void) strcpy(mph->state_vector, utc_start);
+     (void) strcpy(mph->vector_source, "FP");
+     (void) strcpy(mph->utc_sbt_time, utc_start);
+     mph->clock_step = 3906250u;
+     (void) strcpy(mph->leap_utc, utc_start);
+     (void) strcpy(mph->leap_err, "0");
+     (void) strcpy(mph->product_err, "0");
+     mph->dsd_size = PDS_DSD_LENGTH;
+     mph->num_dsd  = num_dsd;
+     mph->sph_size = sph_size + num_dsd * PDS_DSD_LENGTH;
+     mph->num_data_sets = 2u;
+}
+
+/*
+ * the SPH writers check the written size against the MPH, therefore,
+ * write the SPH once to a scratch file to obtain its size
+ */
+static
+unsigned int LV0_SPH_LENGTH(const struct sph0_scia sph)
+{
+     FILE *fp;
+     long nr_byte;
+     struct mph_envi mph;
+
+     if ((fp = tmpfile()) == NULL) return 0u;
+     (void) memset(&mph, 0, sizeof(struct mph_envi));
+     NADC_ERR_SAVE();
+     SCIA_LV0_WR_SPH(fp, mph, sph);
+     NADC_ERR_RESTORE();
+     nr_byte = ftell(fp);
+     (void) fclose(fp);
+     return (nr_byte > 0) ? (unsigned int) nr_byte : 0u;
+}
+
+/*
+ * INIT_VERSION is an optional keyword: it is only written with its value
+ * after the SPH was read once, this is what SCIA_LV1_WR_DSD_UPDATE does.
+ * Note that SCIA_LV1_RD_SPH expects the SPH directly after the MPH
+ */
+static
+unsigned int LV1_SPH_LENGTH(const struct sph1_scia sph)
+{
+     register unsigned short nw;
+
+     FILE *fp;
+     long nr_byte = 0;
+     struct mph_envi  mph;
+     struct sph1_scia sph_rd;
+
+     if ((fp = tmpfile()) == NULL) return 0u;
+     (void) memset(&mph, 0, sizeof(struct mph_envi));
+     for (nw = 0; nw < 2; nw++) {
+	  (void) fseek(fp, (long) PDS_MPH_LENGTH, SEEK_SET);
+	  NADC_ERR_SAVE();
+	  SCIA_LV1_WR_SPH(fp, mph, sph);
+	  NADC_ERR_RESTORE();
+	  nr_byte = ftell(fp) - (long) PDS_MPH_LENGTH;
+	  if (nw == 0) {
+	       mph.sph_size = (unsigned int) nr_byte;
+	       SCIA_LV1_RD_SPH(fp, mph, &sph_rd);
+	       mph.sph_size = 0u;
+	       if (IS_ERR_STAT_FATAL) break;
+	  }
+     }
+     (void) fclose(fp);
+     if (IS_ERR_STAT_FATAL) return 0u;
+     return (nr_byte > 0) ? (unsigned int) nr_byte : 0u;
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   GEN_SCIA_LV0
+.PURPOSE     write a synthetic SCIAMACHY level 0 product
+.INPUT/OUTPUT
+  call as   num_dsr = GEN_SCIA_LV0(flname, num_state, num_dsr);
+     input:
+            char *flname             : name of the product
+	    unsigned short num_state : number of Nadir states
+	    unsigned short num_dsr   : number of Detector packets per state
+
+.RETURNS     number of Detector packets written (unsigned int)
+             error status passed by global variable ``nadc_stat''
+.COMMENTS    only Detector packets of 8 channels with two clusters each
+-------------------------*/
+static
+unsigned int GEN_SCIA_LV0(const char *flname, unsigned short num_state,
+			  unsigned short num_dsr)
+{
+     register unsigned short nch, ncl, nd, ns;
+     register unsigned int   np;
+
+     FILE *fd = NULL;
+     unsigned char *pixel_data = NULL;
+     unsigned int  num_det = 0u;
+     unsigned int  offset, sph_length, seed = 1u;
+
+     struct mph_envi  mph;
+     struct sph0_scia sph;
+     struct dsd_envi  dsd;
+     struct mds0_info info;
+     struct mds0_det  det;
+     struct det_src   data_src[SCIENCE_CHANNELS];
+     struct chan_src  chan_src[SCIENCE_CHANNELS][BENCH_NUM_CLUS];
+
+     const size_t clus_bytes = 2 * BENCH_CLUS_LENGTH;
+     const unsigned int src_length = SCIENCE_CHANNELS
+	  * (LV0_CHAN_HDR_LENGTH
+	     + BENCH_NUM_CLUS * (LV0_CLUS_HDR_LENGTH + clus_bytes));
+     const unsigned int dsr_size = LV0_ANNOTATION_LENGTH
+	  + LV0_PACKET_HDR_LENGTH + DET_DATA_HDR_LENGTH + src_length;
+/*
+ * Specific Product Header
+ */
+     (void) memset(&sph, 0, sizeof(struct sph0_scia));
+     (void) strcpy(sph.descriptor, "SCI_NL__0P SPECIFIC HEADER");
+     (void) strcpy(sph.tx_rx_polar, " ");
+     (void) strcpy(sph.swath, " ");
+     if ((sph_length = LV0_SPH_LENGTH(sph)) == 0u)
+	  NADC_GOTO_ERROR(NADC_ERR_PDS_SIZE, "SPH");
+/*
+ * Main Product Header and Data Set Descriptor
+ */
+     FILL_MPH("SCI_NL__0PNPDK20040101_120000_000006002023_00001_09000_0000.N1",
+	      sph_length, 2u, &mph);
+     offset = PDS_MPH_LENGTH + mph.sph_size;
+
+     (void) memset(&dsd, 0, sizeof(struct dsd_envi));
+     (void) strcpy(dsd.name, "SCIAMACHY_SOURCE_PACKETS");
+     (void) strcpy(dsd.type, "M");
+     dsd.offset   = offset;
+     dsd.num_dsr  = (unsigned int) num_state * num_dsr;
+     dsd.size     = dsd.num_dsr * dsr_size;
+     dsd.dsr_size = -1;
+
+     mph.tot_size = dsd.offset + dsd.size;
+     mph.num_data_sets = 3u;
+
+     if ((fd = fopen(flname, "w+b")) == NULL)
+	  NADC_GOTO_ERROR(NADC_ERR_FILE_CRE, flname);
+     ENVI_WR_MPH(fd, mph);
+     SCIA_LV0_WR_SPH(fd, mph, sph);
+     ENVI_WR_DSD(fd, 1u, &dsd);
+     if (IS_ERR_STAT_FATAL)
+	  NADC_GOTO_ERROR(NADC_ERR_FILE_WR, "MPH/SPH/DSD");
+/*
+ * pixel data of all clusters (big-endian)
+ */
+     pixel_data = (unsigned char *)
+	  malloc(SCIENCE_CHANNELS * BENCH_NUM_CLUS * clus_bytes);
+     if (pixel_data == NULL)
+	  NADC_GOTO_ERROR(NADC_ERR_ALLOC, "pixel_data");
+     for (np = 0; np < SCIENCE_CHANNELS * BENCH_NUM_CLUS * clus_bytes;
+	  np += 2) {
+	  unsigned short value = 1000 + (BENCH_RAND(&seed) % 4096);
+
+	  pixel_data[np] = (unsigned char) (value >> 8);
+	  pixel_data[np+1] = (unsigned char) (value & 0xFF);
+     }
+/*
+ * Detector packets
+ */
+     (void) memset(&det, 0, sizeof(struct mds0_det));
+     (void) memset(&info, 0, sizeof(struct mds0_info));
+     (void) memset(data_src, 0, sizeof(data_src));
+     (void) memset(chan_src, 0, sizeof(chan_src));
+
+     det.num_chan = SCIENCE_CHANNELS;
+     det.data_src = data_src;
+     det.packet_hdr.length = DET_DATA_HDR_LENGTH + src_length - 1;
+     det.fep_hdr.isp_length = det.packet_hdr.length;
+     det.data_hdr.category = 1;
+     det.data_hdr.state_id = BENCH_STATE_ID;
+     det.data_hdr.length = DET_DATA_HDR_LENGTH;
+     det.data_hdr.id.field.packet = SCIA_DET_PACKET;
+     for (nch = 0; nch < SCIENCE_CHANNELS; nch++) {
+	  data_src[nch].hdr.sync = 0xAAAA;
+	  data_src[nch].hdr.channel.field.id = nch + 1;
+	  data_src[nch].hdr.channel.field.clusters = BENCH_NUM_CLUS;
+	  data_src[nch].pixel = chan_src[nch];
+	  for (ncl = 0; ncl < BENCH_NUM_CLUS; ncl++) {
+	       chan_src[nch][ncl].cluster_id = ncl;
+	       chan_src[nch][ncl].co_adding = 1;
+	       chan_src[nch][ncl].sync = 0xBBBB;
+	       chan_src[nch][ncl].start = ncl * BENCH_CLUS_LENGTH;
+	       chan_src[nch][ncl].length = BENCH_CLUS_LENGTH;
+	       chan_src[nch][ncl].data = pixel_data
+		    + (nch * BENCH_NUM_CLUS + ncl) * clus_bytes;
+	  }
+     }
+
+     for (ns = 0; ns < num_state; ns++) {
+	  det.data_hdr.on_board_time = 1000u * (ns + 1);
+
+	  for (nd = 0; nd < num_dsr; nd++) {
+	       det.isp.days  = 1461;
+	       det.isp.secnd = 43200u + 60u * ns + nd / 16u;
+	       det.isp.musec = 62500u * (nd % 16u);
+	       det.fep_hdr.gsrt = det.isp;
+	       det.packet_hdr.seq_cntrl = (unsigned short) num_det;
+	       det.bcps = 16 * nd;
+	       for (nch = 0; nch < SCIENCE_CHANNELS; nch++) {
+		    data_src[nch].hdr.bcps = det.bcps;
+		    for (ncl = 0; ncl < BENCH_NUM_CLUS; ncl++)
+			 chan_src[nch][ncl].block_nr = nd;
+	       }
+	       info.offset = offset;
+	       (void) SCIA_LV0_WR_DET(fd, &info, 1, &det);
+	       if (IS_ERR_STAT_FATAL)
+		    NADC_GOTO_ERROR(NADC_ERR_PDS_WR, "MDS_DET");
+	       offset += dsr_size;
+	       num_det++;
+	  }
+     }
+done:
+     if (pixel_data != NULL) free(pixel_data);
+     if (fd != NULL) (void) fclose(fd);
+     return num_det;
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   BENCH_ROE_DB_EXISTS
+.PURPOSE     check if the ROE database can be found by the level 0 reader
+.INPUT/OUTPUT
+  call as   found = BENCH_ROE_DB_EXISTS();
+
+.RETURNS     TRUE when found else FALSE
+.COMMENTS    same search order as the reader: working directory, DATA_DIR
+-------------------------*/
+static
+bool BENCH_ROE_DB_EXISTS(void)
+{
+     char string[MAX_STRING_LENGTH];
+
+     (void) snprintf(string, MAX_STRING_LENGTH, "./%s", NAME_ROE_DB);
+     if (nadc_file_exists(string)) return TRUE;
+
+     (void) snprintf(string, MAX_STRING_LENGTH, "%s/%s", DATA_DIR, NAME_ROE_DB);
+     return nadc_file_exists(string);
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   BENCH_SCIA_LV0
+.PURPOSE     read a SCIAMACHY level 0 product as scia_nl0 does
+.INPUT/OUTPUT
+  call as   BENCH_SCIA_LV0(flname, h5_name);
+     input:
+            char *flname    : name of the level 0 product
+            char *h5_name   : name of the HDF5 output file
+
+.RETURNS     nothing, error status passed by global variable ``nadc_stat''
+.COMMENTS    stages: mph_dsd, info_scan, mds_decode, extract_1c, hdf5_write
+-------------------------*/
+static
+void BENCH_SCIA_LV0(const char *flname, const char *h5_name)
+{
+     register size_t ns;
+
+     FILE   *fd = NULL;
+     size_t num_state = 0;
+     hid_t  fid;
+
+     unsigned int    num_dsd;
+     unsigned short  num_det, num_1c;
+     unsigned long long nr_det = 0ull, nr_1c = 0ull;
+
+     double t_mph = 0., t_info = 0., t_det = 0., t_1c = 0., t_h5 = 0.;
+
+     struct mph_envi    mph;
+     struct dsd_envi    *dsd = NULL;
+     struct mds0_states *states = NULL;
+     struct mds0_det    *det = NULL;
+     struct mds1c_scia  *mds_1c = NULL;
+
+     const unsigned long long nr_byte = nadc_file_size(flname);
+
+     if ((fd = fopen(flname, "rb")) == NULL)
+	  NADC_GOTO_ERROR(NADC_ERR_FILE, flname);
+     (void) nadc_set_param_string("infile", flname);
+     (void) nadc_set_param_string("outfile", h5_name);
+     SCIA_CRE_H5_FILE(SCIA_LEVEL_0);
+     if (IS_ERR_STAT_FATAL)
+	  NADC_GOTO_ERROR(NADC_ERR_HDF_CRE, h5_name);
+/*
+ * Main Product Header and Data Set Descriptors
+ */
+     BENCH_START();
+     ENVI_RD_MPH(fd, &mph);
+     if (IS_ERR_STAT_FATAL || mph.num_dsd == 0)
+	  NADC_GOTO_ERROR(NADC_ERR_PDS_RD, "MPH");
+     dsd = (struct dsd_envi *) malloc((mph.num_dsd-1) * sizeof(struct dsd_envi));
+     if (dsd == NULL) NADC_GOTO_ERROR(NADC_ERR_ALLOC, "dsd");
+     num_dsd = ENVI_RD_DSD(fd, mph, dsd);
+     BENCH_STOP(&t_mph);
+     if (IS_ERR_STAT_FATAL)
+	  NADC_GOTO_ERROR(NADC_ERR_PDS_RD, "DSD");
+     BENCH_REPORT("lv0", "mph_dsd", t_mph, num_dsd, nr_byte);
+/*
+ * the HDF5 writer of the Detector MDS needs the orbit number of the MPH
+ */
+     SCIA_WR_H5_MPH(&mph);
+     if (IS_ERR_STAT_FATAL)
+	  NADC_GOTO_ERROR(NADC_ERR_HDF_WR, "MPH");
+/*
+ * info-records of all states
+ */
+     BENCH_START();
+     num_state = SCIA_LV0_RD_MDS_INFO(fd, num_dsd, dsd, &states);
+     BENCH_STOP(&t_info);
+     if (IS_ERR_STAT_FATAL || num_state == 0)
+	  NADC_GOTO_ERROR(NADC_ERR_FILE_RD, "RD_MDS_INFO");
+     BENCH_REPORT("lv0", "info_scan", t_info, num_state, nr_byte);
+/*
+ * Detector MDS: read, extract level 1c records and write to HDF5
+ */
+     SCIA_LV0_DET_ARENA_OPEN();
+     for (ns = 0; ns < num_state; ns++) {
+	  if (states[ns].num_det == 0) continue;
+
+	  BENCH_START();
+	  num_det = SCIA_LV0_RD_DET(fd, states[ns].info_det,
+				    states[ns].num_det, &det);
+	  BENCH_STOP(&t_det);
+	  if (IS_ERR_STAT_FATAL)
+	       NADC_GOTO_ERROR(NADC_ERR_PDS_RD, "MDS_DET");
+	  nr_det += num_det;
+
+	  BENCH_START();
+	  num_1c = GET_SCIA_LV0C_MDS(num_det, det, &mds_1c);
+	  BENCH_STOP(&t_1c);
+	  if (IS_ERR_STAT_FATAL)
+	       NADC_GOTO_ERROR(NADC_ERR_FATAL, "GET_SCIA_LV0C_MDS");
+	  nr_1c += num_1c;
+	  if (num_1c > 0) SCIA_LV1C_FREE_MDS(SCIA_NADIR, num_1c, mds_1c);
+
+	  BENCH_START();
+	  SCIA_LV0_WR_H5_DET((unsigned short) ns, num_det, det);
+	  BENCH_STOP(&t_h5);
+
+	  SCIA_LV0_FREE_MDS_DET(num_det, det);
+	  SCIA_LV0_DET_ARENA_RELEASE();
+	  if (IS_ERR_STAT_FATAL)
+	       NADC_GOTO_ERROR(NADC_ERR_HDF_WR, "MDS_DET");
+     }
+     BENCH_REPORT("lv0", "mds_decode", t_det, nr_det, nr_byte);
+     BENCH_REPORT("lv0", "extract_1c", t_1c, nr_1c, nr_byte);
+     (void) H5Fflush(nadc_get_param_hid("hdf_file_id"), H5F_SCOPE_GLOBAL);
+     BENCH_REPORT("lv0", "hdf5_write", t_h5, nr_det, nadc_file_size(h5_name));
+done:
+     SCIA_LV0_DET_ARENA_CLOSE();
+     if (fd != NULL) (void) fclose(fd);
+     if ((fid = nadc_get_param_hid("hdf_file_id")) >= 0) {
+	  (void) H5Fclose(fid);
+	  (void) nadc_set_param_hid("hdf_file_id", -1);
+     }
+     if (dsd != NULL) free(dsd);
+     SCIA_LV0_FREE_MDS_INFO(num_state, states);
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   GEN_LV1_STATE
+.PURPOSE     define the cluster configuration of a synthetic Nadir state
+.INPUT/OUTPUT
+  call as   GEN_LV1_STATE(ns, num_dsr, state);
+     input:
+            unsigned short ns       : index of the state
+	    unsigned short num_dsr  : number of MDS of the state
+    output:
+            struct state1_scia *state : state record
+
+.RETURNS     nothing
+.COMMENTS    channels 1-5: RSIG with intg = 1 sec,
+             channels 6-8: RSIGC with intg = 1/4 sec
+-------------------------*/
+static
+void GEN_LV1_STATE(unsigned short ns, unsigned short num_dsr,
+		   struct state1_scia *state)
+{
+     register unsigned short nc, nch, ncl;
+
+     unsigned int sig_bytes = 0u;
+
+     (void) memset(state, 0, sizeof(struct state1_scia));
+     state->mjd.days  = 1461;
+     state->mjd.secnd = 43200u + 60u * ns;
+     state->flag_mds = MDS_ATTACHED;
+     state->type_mds = SCIA_NADIR;
+     state->category = 1;
+     state->state_id = BENCH_STATE_ID;
+     state->dur_scan = 16 * num_dsr;
+     state->longest_intg_time = 16;
+     state->num_clus = SCIENCE_CHANNELS * BENCH_NUM_CLUS;
+     state->orbit_phase = 0.25f;
+
+     for (nc = nch = 0; nch < SCIENCE_CHANNELS; nch++) {
+	  for (ncl = 0; ncl < BENCH_NUM_CLUS; ncl++, nc++) {
+	       struct Clcon_scia *Clcon = &state->Clcon[nc];
+
+	       Clcon->id = (unsigned char) (nc + 1);
+	       Clcon->channel = (unsigned char) (nch + 1);
+	       Clcon->pixel_nr = ncl * BENCH_CLUS_LENGTH;
+	       Clcon->length = BENCH_CLUS_LENGTH;
+	       Clcon->coaddf = 1;
+	       if (nch < VIS_CHANNELS) {
+		    Clcon->type = RSIG;
+		    Clcon->intg_time = 16;
+		    Clcon->n_read = 1;
+		    Clcon->pet = 1.f;
+		    sig_bytes += Clcon->length * 4u;
+	       } else {
+		    Clcon->type = RSIGC;
+		    Clcon->intg_time = 4;
+		    Clcon->n_read = 4;
+		    Clcon->pet = 0.25f;
+		    sig_bytes += Clcon->length * Clcon->n_read * 5u;
+	       }
+	  }
+     }
+     state->num_intg = 2;
+     state->intg_times[0] = 16;
+     state->intg_times[1] = 4;
+     state->num_polar[0] = num_dsr;
+     state->num_polar[1] = (LV1_NUM_POL - 1) * num_dsr;
+     state->total_polar = LV1_NUM_POL * num_dsr;
+     state->num_aux = LV1_NUM_AUX * num_dsr;
+     state->num_pmd = (LV1_NUM_PMD / PMD_NUMBER) * num_dsr;
+     state->num_dsr = num_dsr;
+/*
+ * size of one MDS: header, flags, geolocation, level 0 headers,
+ *                  PMD, PolV and cluster data
+ */
+     state->length_dsr = 25u + LV1_NUM_AUX
+	  + state->num_clus * LV1_NUM_AUX + LV1_NUM_AUX
+	  + 108u * LV1_NUM_AUX + 72u * LV1_NUM_AUX
+	  + 4u * LV1_NUM_PMD + 256u * LV1_NUM_POL + sig_bytes;
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   GEN_LV1_MDS
+.PURPOSE     fill the level 1b MDS records of a synthetic Nadir state
+.INPUT/OUTPUT
+  call as   GEN_LV1_MDS(state, &seed, mds);
+     input:
+            struct state1_scia *state : state record
+ in/output:
+            unsigned int *seed        : seed of the random generator
+    output:
+            struct mds1_scia *mds     : level 1b MDS (state->num_dsr)
+
+.RETURNS     nothing, error status passed by global variable ``nadc_stat''
+.COMMENTS    release the records with SCIA_LV1_FREE_MDS, also on error
+-------------------------*/
+static
+void GEN_LV1_MDS(const struct state1_scia *state, unsigned int *seed,
+		 struct mds1_scia *mds)
+{
+     register unsigned short na, nc, nd, np;
+     register unsigned int   nr;
+
+     for (nd = 0; nd < state->num_dsr; nd++, mds++) {
+	  mds->mjd.days  = state->mjd.days;
+	  mds->mjd.secnd = state->mjd.secnd + nd;
+	  mds->type_mds  = state->type_mds;
+	  mds->state_id  = (unsigned char) state->state_id;
+	  mds->state_index = (unsigned char) state->indx;
+	  mds->n_clus = state->num_clus;
+	  mds->n_aux  = LV1_NUM_AUX;
+	  mds->n_pmd  = LV1_NUM_PMD;
+	  mds->n_pol  = LV1_NUM_POL;
+	  mds->dsr_length = state->length_dsr;
+	  (void) memset(mds->scale_factor, 10, SCIENCE_CHANNELS);
+
+	  mds->sat_flags = (unsigned char *) calloc(LV1_NUM_AUX, 1);
+	  mds->red_grass = (unsigned char *)
+	       calloc((size_t) mds->n_clus * LV1_NUM_AUX, 1);
+	  mds->geoN = (struct geoN_scia *)
+	       calloc(LV1_NUM_AUX, sizeof(struct geoN_scia));
+	  mds->lv0 = (struct lv0_hdr *)
+	       calloc(LV1_NUM_AUX, sizeof(struct lv0_hdr));
+	  mds->int_pmd = (float *) calloc(LV1_NUM_PMD, sizeof(float));
+	  mds->polV = (struct polV_scia *)
+	       calloc(LV1_NUM_POL, sizeof(struct polV_scia));
+	  if (mds->sat_flags == NULL || mds->red_grass == NULL
+	      || mds->geoN == NULL || mds->lv0 == NULL
+	      || mds->int_pmd == NULL || mds->polV == NULL)
+	       NADC_RETURN_ERROR(NADC_ERR_ALLOC, "mds");
+
+	  for (na = 0; na < LV1_NUM_AUX; na++) {
+	       struct geoN_scia *geoN = &mds->geoN[na];
+
+	       geoN->pos_esm = -20.f + 10.f * na;
+	       geoN->sat_h = 800.f;
+	       geoN->earth_rad = 6371.f;
+	       for (np = 0; np < 3; np++) {
+		    geoN->sun_zen_ang[np] = 40.f + np;
+		    geoN->sun_azi_ang[np] = 120.f + np;
+		    geoN->los_zen_ang[np] = 10.f + np;
+		    geoN->los_azi_ang[np] = 90.f + np;
+	       }
+	       geoN->sub_sat_point.lat = 52000000 + 100000 * nd;
+	       geoN->sub_sat_point.lon = 4000000 + 20000 * na;
+	       for (np = 0; np < NUM_CORNERS; np++)
+		    geoN->corner[np] = geoN->sub_sat_point;
+	       geoN->center = geoN->sub_sat_point;
+
+	       mds->lv0[na].bcps = 16 * nd + 4 * na;
+	       mds->lv0[na].num_chan = SCIENCE_CHANNELS;
+	       mds->lv0[na].data_hdr.category = (unsigned char) state->category;
+	       mds->lv0[na].data_hdr.state_id = (unsigned char) state->state_id;
+	       mds->lv0[na].data_hdr.id.field.packet = SCIA_DET_PACKET;
+	  }
+	  for (np = 0; np < LV1_NUM_PMD; np++)
+	       mds->int_pmd[np] = (float) (BENCH_RAND(seed) % 1024);
+	  for (np = 0; np < LV1_NUM_POL; np++)
+	       mds->polV[np].intg_time = (np == 0) ? 16 : 4;
+
+	  for (nc = 0; nc < mds->n_clus; nc++) {
+	       const struct Clcon_scia *Clcon = &state->Clcon[nc];
+	       const unsigned int num = Clcon->length * Clcon->n_read;
+
+	       if (Clcon->type == RSIG) {
+		    mds->clus[nc].sig = (struct Sig_scia *)
+			 calloc(num, sizeof(struct Sig_scia));
+		    if (mds->clus[nc].sig == NULL)
+			 NADC_RETURN_ERROR(NADC_ERR_ALLOC, "sig");
+		    mds->clus[nc].n_sig = (unsigned short) num;
+		    for (nr = 0; nr < num; nr++)
+			 mds->clus[nc].sig[nr].sign =
+			      1000 + (BENCH_RAND(seed) % 4096);
+	       } else {
+		    mds->clus[nc].sigc = (struct Sigc_scia *)
+			 calloc(num, sizeof(struct Sigc_scia));
+		    if (mds->clus[nc].sigc == NULL)
+			 NADC_RETURN_ERROR(NADC_ERR_ALLOC, "sigc");
+		    mds->clus[nc].n_sigc = (unsigned short) num;
+		    for (nr = 0; nr < num; nr++)
+			 mds->clus[nc].sigc[nr].det.field.sign =
+			      4000u + (BENCH_RAND(seed) % 8192);
+	       }
+	  }
+     }
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   GEN_SCIA_LV1
+.PURPOSE     write a synthetic SCIAMACHY level 1b product
+.INPUT/OUTPUT
+  call as   num_mds = GEN_SCIA_LV1(flname, num_state, num_dsr);
+     input:
+            char *flname             : name of the product
+	    unsigned short num_state : number of Nadir states
+	    unsigned short num_dsr   : number of MDS per state
+
+.RETURNS     number of MDS written (unsigned int)
+             error status passed by global variable ``nadc_stat''
+.COMMENTS    the product contains the SIP, Leakage constant, PPG/Etalon and
+             States data sets and Nadir MDS, as needed by SCIA_LV1_CAL for
+	     the dark, PPG, Etalon and bad pixel mask corrections
+-------------------------*/
+static
+unsigned int GEN_SCIA_LV1(const char *flname, unsigned short num_state,
+			  unsigned short num_dsr)
+{
+     register unsigned short ns;
+     register unsigned int   np;
+
+     FILE *fp = NULL;
+     unsigned int num_mds = 0u;
+     unsigned int sph_length, seed = 2u;
+
+     struct mph_envi    mph;
+     struct sph1_scia   sph;
+     struct sip_scia    sip;
+     struct clcp_scia   *clcp = NULL;
+     struct ppg_scia    *ppg = NULL;
+     struct state1_scia *state = NULL;
+     struct mds1_scia   *mds = NULL;
+/*
+ * Specific Product Header
+ */
+     (void) memset(&sph, 0, sizeof(struct sph1_scia));
+     (void) strcpy(sph.descriptor, "SCI_NL__1P SPECIFIC HEADER");
+     (void) strcpy(sph.start_time, "01-JAN-2004 12:00:00.000000");
+     (void) strcpy(sph.stop_time, "01-JAN-2004 12:10:00.000000");
+     (void) strcpy(sph.init_version, "SCIA/8.02  BENCH");
+     (void) strcpy(sph.key_data, "01.00");
+     (void) strcpy(sph.m_factor, "01.00");
+     (void) strcpy(sph.spec_cal, "0000");
+     (void) strcpy(sph.saturate, "0000");
+     (void) strcpy(sph.dead_pixel, "0000");
+     (void) strcpy(sph.dark_check, "0000");
+     sph.stripline = -1;
+     if ((sph_length = LV1_SPH_LENGTH(sph)) == 0u)
+	  NADC_GOTO_ERROR(NADC_ERR_PDS_SIZE, "SPH");
+/*
+ * Static Instrument Parameters
+ */
+     (void) memset(&sip, 0, sizeof(struct sip_scia));
+     (void) strcpy(sip.do_use_limb_dark, "0");
+     (void) memset(sip.do_pixelwise, '0', SCIENCE_CHANNELS);
+     (void) memset(sip.do_ib_oc_etn, '0', PMD_NUMBER);
+     (void) memset(sip.do_ib_sd_etn, '0', PMD_NUMBER);
+     (void) memset(sip.do_fraunhofer, '0', 5 * SCIENCE_CHANNELS);
+     (void) memset(sip.do_etalon, '0', 3 * SCIENCE_CHANNELS);
+     (void) memset(sip.do_var_lc_cha, '0', 4 * IR_CHANNELS);
+     (void) memset(sip.do_stray_lc_cha, '0', 4 * SCIENCE_CHANNELS);
+     (void) memset(sip.do_var_lc_pmd, '0', 4 * IR_PMD_NUMBER);
+     (void) memset(sip.do_stray_lc_pmd, '0', 4 * PMD_NUMBER);
+     (void) memset(sip.do_pol_point, '0', NUM_FRAC_POLV);
+     sip.ds_n_phases = sip.sp_n_phases = MaxBoundariesSIP - 1;
+     for (np = 0; np < MaxBoundariesSIP; np++) {
+	  sip.ds_phase_boundaries[np] = np / (MaxBoundariesSIP - 1.f);
+	  sip.sp_phase_boundaries[np] = np / (MaxBoundariesSIP - 1.f);
+     }
+     for (np = 0; np < SCIENCE_CHANNELS; np++) {
+	  sip.sat_level[np] = 60000;
+	  sip.electrons_bu[np] = 1.f;
+     }
+     sip.pmd_sat_limit = 60000;
+/*
+ * Leakage constant: fixed pattern noise and leakage current
+ */
+     if ((clcp = (struct clcp_scia *)
+	  calloc(1, sizeof(struct clcp_scia))) == NULL)
+	  NADC_GOTO_ERROR(NADC_ERR_ALLOC, "clcp");
+     for (np = 0; np < SCIENCE_PIXELS; np++) {
+	  clcp->fpn[np] = 100.f + (BENCH_RAND(&seed) % 200) / 10.f;
+	  clcp->fpn_error[np] = 0.5f + (BENCH_RAND(&seed) % 100) / 100.f;
+	  clcp->lc[np] = (BENCH_RAND(&seed) % 500) / 100.f;
+	  clcp->lc_error[np] = (BENCH_RAND(&seed) % 50) / 100.f;
+	  clcp->mean_noise[np] = 1.f + (BENCH_RAND(&seed) % 100) / 100.f;
+     }
+/*
+ * PPG and Etalon parameters
+ */
+     if ((ppg = (struct ppg_scia *) malloc(sizeof(struct ppg_scia))) == NULL)
+	  NADC_GOTO_ERROR(NADC_ERR_ALLOC, "ppg");
+     for (np = 0; np < SCIENCE_PIXELS; np++) {
+	  ppg->ppg_fact[np] = 1.f + (BENCH_RAND(&seed) % 200 - 100) / 1e4f;
+	  ppg->etalon_fact[np] = 1.f + (BENCH_RAND(&seed) % 200 - 100) / 1e4f;
+	  ppg->etalon_resid[np] = 0.f;
+	  ppg->wls_deg_fact[np] = 1.f;
+	  ppg->bad_pixel[np] = ((np % 97) == 0) ? 1 : 0;
+     }
+/*
+ * States
+ */
+     state = (struct state1_scia *)
+	  malloc(num_state * sizeof(struct state1_scia));
+     if (state == NULL) NADC_GOTO_ERROR(NADC_ERR_ALLOC, "state");
+     for (ns = 0; ns < num_state; ns++) {
+	  GEN_LV1_STATE(ns, num_dsr, &state[ns]);
+	  state[ns].indx = ns;
+     }
+/*
+ * write the product: MPH, SPH, DSD and data sets in order of the DSD
+ */
+     FILL_MPH("SCI_NL__1PNPDK20040101_120000_000006002023_00001_09000_0000.N1",
+	      sph_length, LV1_NUM_TEMPLATE + 1u, &mph);
+     if ((fp = fopen(flname, "w+b")) == NULL)
+	  NADC_GOTO_ERROR(NADC_ERR_FILE_CRE, flname);
+     ENVI_WR_MPH(fp, mph);
+     SCIA_LV1_WR_SPH(fp, mph, sph);
+     SCIA_LV1_WR_DSD_INIT(fp, LV1_NUM_TEMPLATE, lv1_template);
+     if (IS_ERR_STAT_FATAL)
+	  NADC_GOTO_ERROR(NADC_ERR_FILE_WR, "MPH/SPH/DSD");
+     SCIA_LV1_WR_SIP(fp, 1u, sip);
+     SCIA_LV1_WR_CLCP(fp, 1u, *clcp);
+     SCIA_LV1_WR_PPG(fp, 1u, *ppg);
+     SCIA_LV1_WR_STATE(fp, num_state, state);
+     if (IS_ERR_STAT_FATAL)
+	  NADC_GOTO_ERROR(NADC_ERR_FILE_WR, "GADS/ADS");
+
+     for (ns = 0; ns < num_state; ns++) {
+	  mds = (struct mds1_scia *)
+	       calloc(num_dsr, sizeof(struct mds1_scia));
+	  if (mds == NULL) NADC_GOTO_ERROR(NADC_ERR_ALLOC, "mds");
+	  GEN_LV1_MDS(&state[ns], &seed, mds);
+	  if (IS_ERR_STAT_FATAL)
+	       NADC_GOTO_ERROR(NADC_ERR_FATAL, "GEN_LV1_MDS");
+	  SCIA_LV1_WR_MDS(fp, num_dsr, mds);
+	  if (IS_ERR_STAT_FATAL)
+	       NADC_GOTO_ERROR(NADC_ERR_FILE_WR, "MDS");
+	  SCIA_LV1_FREE_MDS(SCIA_NADIR, num_dsr, mds);
+	  mds = NULL;
+	  num_mds += num_dsr;
+     }
+     SCIA_LV1_EXPORT_NUM_STATE(SCIA_NADIR, num_state);
+/*
+ * update MPH, SPH and DSD records, this closes the file
+ */
+     SCIA_LV1_WR_DSD_UPDATE(fp, fp);
+     fp = NULL;
+done:
+     if (mds != NULL) SCIA_LV1_FREE_MDS(SCIA_NADIR, num_dsr, mds);
+     if (fp != NULL) (void) fclose(fp);
+     if (state != NULL) free(state);
+     if (clcp != NULL) free(clcp);
+     if (ppg != NULL) free(ppg);
+     return num_mds;
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   BENCH_CMP_MDS1C
+.PURPOSE     compare calibrated level 1c MDS records bit by bit
+.INPUT/OUTPUT
+  call as   num_diff = BENCH_CMP_MDS1C(num_1c, mds_ref, mds_1c);
+     input:
+            unsigned int num_1c       : number of level 1c MDS records
+	    struct mds1c_scia *mds_ref : reference records
+	    struct mds1c_scia *mds_1c  : records to compare
+
+.RETURNS     number of clusters with different signals or errors
+.COMMENTS    none
+-------------------------*/
+static
+unsigned int BENCH_CMP_MDS1C(unsigned int num_1c,
+			     const struct mds1c_scia *mds_ref,
+			     const struct mds1c_scia *mds_1c)
+{
+     register unsigned int nc;
+
+     unsigned int num_diff = 0u;
+
+     for (nc = 0; nc < num_1c; nc++) {
+	  const size_t nr_byte = (size_t) mds_ref[nc].num_obs
+	       * mds_ref[nc].num_pixels * sizeof(float);
+
+	  if (mds_ref[nc].num_obs != mds_1c[nc].num_obs
+	      || mds_ref[nc].num_pixels != mds_1c[nc].num_pixels
+	      || memcmp(mds_ref[nc].pixel_val, mds_1c[nc].pixel_val,
+			nr_byte) != 0
+	      || memcmp(mds_ref[nc].pixel_err, mds_1c[nc].pixel_err,
+			nr_byte) != 0)
+	       num_diff++;
+     }
+     return num_diff;
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   BENCH_SCIA_LV1
+.PURPOSE     read and calibrate a SCIAMACHY level 1b product as scia_nl1 does
+.INPUT/OUTPUT
+  call as   BENCH_SCIA_LV1(flname, h5_name);
+     input:
+            char *flname    : name of the level 1b product
+            char *h5_name   : name of the HDF5 output file
+
+.RETURNS     nothing, error status passed by global variable ``nadc_stat''
+.COMMENTS    stages: mph_dsd, states, mds_decode, extract_1c,
+             calib_default, calib_fused, calib_spec, hdf5_write
+	     raises an error when the output of calib_default and 
+	     calib_fused differs
+-------------------------*/
+static
+void BENCH_SCIA_LV1(const char *flname, const char *h5_name)
+{
+     register unsigned int nm, ns;
+
+     FILE *fp = NULL;
+     hid_t fid;
+
+     unsigned int num_dsd, num_state = 0u;
+     unsigned int num_mds = 0u, num_1c = 0u, num_ref = 0u;
+     unsigned long long nr_mds = 0ull, nr_1c = 0ull;
+
+     double t_mph = 0., t_state = 0., t_mds = 0., t_1c = 0., t_h5 = 0.;
+     double t_cal[3] = {0., 0., 0.};
+
+     struct mph_envi    mph;
+     struct dsd_envi    *dsd = NULL;
+     struct state1_scia *state = NULL;
+     struct state1_scia state_rd;
+     struct mds1_scia   *mds = NULL;
+     struct mds1c_scia  *mds_1c = NULL;
+     struct mds1c_scia  *mds_ref = NULL;
+
+     const char *cal_stage[3] = {
+	  "calib_default", "calib_fused", "calib_spec"
+     };
+     const unsigned int calib_flag = DO_CORR_AO|DO_CORR_DARK|DO_CORR_PPG
+	  |DO_CORR_ETALON|DO_MASK_BDPM|DO_CALC_ERROR;
+     const unsigned long long nr_byte = nadc_file_size(flname);
+
+     if ((fp = fopen(flname, "rb")) == NULL)
+	  NADC_GOTO_ERROR(NADC_ERR_FILE, flname);
+     (void) nadc_set_param_string("infile", flname);
+     (void) nadc_set_param_string("outfile", h5_name);
+     SCIA_CRE_H5_FILE(SCIA_LEVEL_1);
+     if (IS_ERR_STAT_FATAL)
+	  NADC_GOTO_ERROR(NADC_ERR_HDF_CRE, h5_name);
+     CRE_SCIA_LV1_H5_STRUCTS();
+     if (IS_ERR_STAT_FATAL)
+	  NADC_GOTO_ERROR(NADC_ERR_HDF_CRE, "STRUCTS");
+/*
+ * Main Product Header and Data Set Descriptors
+ */
+     BENCH_START();
+     ENVI_RD_MPH(fp, &mph);
+     if (IS_ERR_STAT_FATAL || mph.num_dsd == 0)
+	  NADC_GOTO_ERROR(NADC_ERR_PDS_RD, "MPH");
+     dsd = (struct dsd_envi *) malloc((mph.num_dsd-1) * sizeof(struct dsd_envi));
+     if (dsd == NULL) NADC_GOTO_ERROR(NADC_ERR_ALLOC, "dsd");
+     num_dsd = ENVI_RD_DSD(fp, mph, dsd);
+     BENCH_STOP(&t_mph);
+     if (IS_ERR_STAT_FATAL)
+	  NADC_GOTO_ERROR(NADC_ERR_PDS_RD, "DSD");
+     BENCH_REPORT("lv1b", "mph_dsd", t_mph, num_dsd, nr_byte);
+/*
+ * States of the product
+ */
+     BENCH_START();
+     num_state = SCIA_LV1_RD_STATE(fp, num_dsd, dsd, &state);
+     BENCH_STOP(&t_state);
+     if (IS_ERR_STAT_FATAL || num_state == 0u)
+	  NADC_GOTO_ERROR(NADC_ERR_PDS_RD, "STATE");
+     BENCH_REPORT("lv1b", "states", t_state, num_state, nr_byte);
+/*
+ * MDS: read, extract level 1c records, calibrate and write to HDF5
+ */
+     for (ns = 0; ns < num_state; ns++) {
+	  if (state[ns].flag_mds != MDS_ATTACHED) continue;
+
+	  (void) memcpy(&state_rd, &state[ns], sizeof(struct state1_scia));
+	  BENCH_START();
+	  num_mds = SCIA_LV1_RD_MDS(fp, ~0ULL, &state_rd, &mds);
+	  BENCH_STOP(&t_mds);
+	  if (IS_ERR_STAT_FATAL)
+	       NADC_GOTO_ERROR(NADC_ERR_PDS_RD, "SCIA_LV1_RD_MDS");
+	  nr_mds += num_mds;
+
+	  for (nm = 0; nm < 4; nm++) {
+	       mds_1c = (struct mds1c_scia *)
+		    malloc(state_rd.num_clus * sizeof(struct mds1c_scia));
+	       if (mds_1c == NULL) NADC_GOTO_ERROR(NADC_ERR_ALLOC, "mds_1c");
+
+	       BENCH_START();
+	       num_1c = GET_SCIA_LV1C_MDS(~0ULL, &state_rd, mds, mds_1c);
+	       if (nm == 0) {
+		    BENCH_STOP(&t_1c);
+		    nr_1c += num_1c;
+	       }
+	       if (IS_ERR_STAT_FATAL)
+		    NADC_GOTO_ERROR(NADC_ERR_FATAL, "GET_SCIA_LV1C_MDS");
+/*
+ * the first copy is written to HDF5, the others are calibrated and compared
+ */
+	       if (nm == 0) {
+		    BENCH_START();
+		    SCIA_LV1C_WR_H5_MDS(num_1c, mds_1c);
+		    BENCH_STOP(&t_h5);
+		    if (IS_ERR_STAT_FATAL)
+			 NADC_GOTO_ERROR(NADC_ERR_HDF_WR, "MDS_1C");
+	       } else {
+		    (void) nadc_set_param_uint8("flag_cal_fused",
+			 (nm == 2) ? PARAM_SET : PARAM_UNSET);
+		    (void) nadc_set_param_uint8("flag_cal_spec",
+			 (nm == 3) ? PARAM_SET : PARAM_UNSET);
+
+		    BENCH_START();
+		    SCIA_LV1_CAL(fp, calib_flag, &state_rd, mds, mds_1c);
+		    BENCH_STOP(&t_cal[nm-1]);
+		    if (IS_ERR_STAT_FATAL)
+			 NADC_GOTO_ERROR(NADC_ERR_FATAL, cal_stage[nm-1]);
+	       }
+	       if (nm == 1) {
+		    mds_ref = mds_1c;
+		    num_ref = num_1c;
+		    mds_1c = NULL;
+		    continue;
+	       }
+	       if (nm >= 2) {
+		    const unsigned int num_diff = 
+			 (num_ref != num_1c) ? num_1c
+			 : BENCH_CMP_MDS1C(num_1c, mds_ref, mds_1c);
+
+		    if (num_diff > 0u) {
+			 char msg[MAX_STRING_LENGTH];
+
+			 (void) snprintf(msg, MAX_STRING_LENGTH,
+			      "%s, state %u: %u clusters differ", 
+			      cal_stage[nm-1], ns, num_diff);
+			 SCIA_LV1C_FREE_MDS(SCIA_NADIR, num_1c, mds_1c);
+			 mds_1c = NULL;
+			 NADC_GOTO_ERROR(NADC_ERR_FATAL, msg);
+		    }
+	       }
+	       SCIA_LV1C_FREE_MDS(SCIA_NADIR, num_1c, mds_1c);
+	       mds_1c = NULL;
+	  }
+	  SCIA_LV1C_FREE_MDS(SCIA_NADIR, num_ref, mds_ref);
+	  mds_ref = NULL;
+	  (void) nadc_set_param_uint8("flag_cal_fused", PARAM_UNSET);
+	  (void) nadc_set_param_uint8("flag_cal_spec", PARAM_UNSET);
+
+	  SCIA_LV1_FREE_MDS(SCIA_NADIR, num_mds, mds);
+	  mds = NULL;
+     }
+     BENCH_REPORT("lv1b", "mds_decode", t_mds, nr_mds, nr_byte);
+     BENCH_REPORT("lv1b", "extract_1c", t_1c, nr_1c, nr_byte);
+     for (nm = 0; nm < 3; nm++)
+	  BENCH_REPORT("lv1b", cal_stage[nm], t_cal[nm], nr_1c, nr_byte);
+     (void) H5Fflush(nadc_get_param_hid("hdf_file_id"), H5F_SCOPE_GLOBAL);
+     BENCH_REPORT("lv1b", "hdf5_write", t_h5, nr_1c, nadc_file_size(h5_name));
+done:
+     if (mds_1c != NULL) free(mds_1c);
+     if (mds_ref != NULL) SCIA_LV1C_FREE_MDS(SCIA_NADIR, num_ref, mds_ref);
+     if (mds != NULL) SCIA_LV1_FREE_MDS(SCIA_NADIR, num_mds, mds);
+     if (fp != NULL) (void) fclose(fp);
+     if ((fid = nadc_get_param_hid("hdf_file_id")) >= 0) {
+	  (void) H5Fclose(fid);
+	  (void) nadc_set_param_hid("hdf_file_id", -1);
+     }
+     if (dsd != NULL) free(dsd);
+     if (state != NULL) free(state);
+}
+
+/*+++++++++++++++++++++++++ Main Program or Function +++++++++++++++*/
+int main(int argc, char *argv[])
+{
+     char   flname[MAX_STRING_LENGTH], h5_name[MAX_STRING_LENGTH];
+     double t_write;
+
+     unsigned int   num;
+     unsigned short num_state = BENCH_NUM_STATE;
+     unsigned short num_dsr   = BENCH_NUM_DSR;
+
+     if (argc < 2 || argc > 4) {
+	  (void) fprintf(stderr,
+			 "Usage: %s <outdir> [num_state] [num_dsr]\n", argv[0]);
+	  return NADC_ERR_FATAL;
+     }
+     if (argc > 2) num_state = (unsigned short) strtoul(argv[2], NULL, 10);
+     if (argc > 3) num_dsr   = (unsigned short) strtoul(argv[3], NULL, 10);
+     if (num_state == 0 || num_dsr < 4) {
+	  (void) fprintf(stderr, "%s: num_state > 0 and num_dsr >= 4\n",
+			 argv[0]);
+	  return NADC_ERR_FATAL;
+     }
+     (void) nadc_set_param_string("program", "scia_bench");
+     (void) printf("product,stage,seconds,records,bytes\n");
+/*
+ * level 0 product
+ */
+     if (! BENCH_ROE_DB_EXISTS()) {
+	  (void) fprintf(stderr, "%s: %s not found, skip level 0 stages\n",
+			 argv[0], NAME_ROE_DB);
+	  goto level_1b;
+     }
+     (void) snprintf(flname, MAX_STRING_LENGTH, "%s/%s", argv[1],
+		     "SCI_NL__0PNPDK20040101_120000_000006002023_00001_09000_0000.N1");
+     (void) snprintf(h5_name, MAX_STRING_LENGTH, "%s/%s", argv[1],
+		     "scia_bench_lv0.h5");
+     t_write = 0.;
+     BENCH_START();
+     num = GEN_SCIA_LV0(flname, num_state, num_dsr);
+     BENCH_STOP(&t_write);
+     if (IS_ERR_STAT_FATAL)
+	  NADC_GOTO_ERROR(NADC_ERR_FILE_WR, "GEN_SCIA_LV0");
+     BENCH_REPORT("lv0", "write", t_write, num, nadc_file_size(flname));
+
+     BENCH_SCIA_LV0(flname, h5_name);
+     if (IS_ERR_STAT_FATAL)
+	  NADC_GOTO_ERROR(NADC_ERR_FILE_RD, "BENCH_SCIA_LV0");
+/*
+ * level 1b product
+ */
+level_1b:
+     (void) snprintf(flname, MAX_STRING_LENGTH, "%s/%s", argv[1],
+		     "SCI_NL__1PNPDK20040101_120000_000006002023_00001_09000_0000.N1");
+     (void) snprintf(h5_name, MAX_STRING_LENGTH, "%s/%s", argv[1],
+		     "scia_bench_lv1.h5");
+     t_write = 0.;
+     BENCH_START();
+     num = GEN_SCIA_LV1(flname, num_state, num_dsr);
+     BENCH_STOP(&t_write);
+     if (IS_ERR_STAT_FATAL)
+	  NADC_GOTO_ERROR(NADC_ERR_FILE_WR, "GEN_SCIA_LV1");
+     BENCH_REPORT("lv1b", "write", t_write, num, nadc_file_size(flname));
+
+     BENCH_SCIA_LV1(flname, h5_name);
+     if (IS_ERR_STAT_FATAL)
+	  NADC_GOTO_ERROR(NADC_ERR_FILE_RD, "BENCH_SCIA_LV1");
+done:
+     SDMF_close_files();
+     SCIA_FREE_H5_CKD_CACHE();
+     nadc_free_param_string();
+     NADC_Err_Trace(stderr);
+     if (IS_ERR_STAT_FATAL)
+	  return NADC_ERR_FATAL;
+     else
+	  return NADC_ERR_NONE;
+}
@@ -54,6 +54,9 @@
 ;                    renamed module to scia_fopen
 ;       Modified:  RvH, 27 June 2002
 ;                    moved scia_fclose to a separate module
+;       Modified:  RvH, 17 October 2026
+;                    also closes the SDMF databases kept open by the
+;                    calibration and SDMF readers
 ;-
 FUNCTION SCIA_FCLOSE
   compile_opt idl2,hidden
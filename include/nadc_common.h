@@ -22,7 +22,9 @@
 .PURPOSE     macro and structures shared by all NADC routines
 .COMMENTS    None
 .ENVIRONment None
-.VERSION     1.0     14-Mar-2013   initial release by R. M. van Hees
+.VERSION     1.1     17-Oct-2026   bugfix: recognise the include guard of
+                                   hdf5.h of HDF5 1.10 and later, RvH
+             1.0     14-Mar-2013   initial release by R. M. van Hees
 ------------------------------------------------------------*/
 #ifndef  __NADC_COMMON                            /* Avoid redefinitions */
 #define  __NADC_COMMON
@@ -35,6 +37,11 @@
 #include <stddef.h>
 #endif
 
+/* HDF5 1.10 and later use HDF5_H as include guard of hdf5.h */
+#if defined(HDF5_H) && !defined(_HDF5_H)
+#define _HDF5_H
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -85,6 +92,50 @@ extern "C" {
 #define PARAM_SET    ((unsigned char) TRUE)
 #define PARAM_UNSET  ((unsigned char) FALSE)
 
+/* identifiers of the uint8 parameters, see nadc_get_param_uint8_id */
+enum nadc_param_uint8_id {
+     PARAM_FLAG_CHECK = 0,
+     PARAM_FLAG_SHOW,
+     PARAM_FLAG_VERSION,
+     PARAM_FLAG_SILENT,
+     PARAM_FLAG_VERBOSE,
+     PARAM_FLAG_GEOLOC,
+     PARAM_FLAG_GEOMNMX,
+     PARAM_FLAG_PERIOD,
+     PARAM_FLAG_PSELECT,
+     PARAM_FLAG_WAVE,
+     PARAM_FLAG_MMAP,
+     PARAM_FLAG_FAST_GEO,
+     PARAM_FLAG_CAL_FUSED,
+     PARAM_FLAG_CAL_SPEC,
+     PARAM_QCHECK,
+     PARAM_WRITE_PDS,
+     PARAM_WRITE_ASCII,
+     PARAM_WRITE_META,
+     PARAM_WRITE_HDF5,
+     PARAM_FLAG_DEFLATE,
+     PARAM_WRITE_SQL,
+     PARAM_FLAG_SQL_REMOVE,
+     PARAM_FLAG_SQL_REPLACE,
+     PARAM_WRITE_LV1C,
+     PARAM_WRITE_ADS,
+     PARAM_WRITE_GADS,
+     PARAM_WRITE_AUX0,
+     PARAM_WRITE_PMD0,
+     PARAM_WRITE_AUX,
+     PARAM_WRITE_DET,
+     PARAM_WRITE_PMD,
+     PARAM_WRITE_LIMB,
+     PARAM_WRITE_MONI,
+     PARAM_WRITE_NADIR,
+     PARAM_WRITE_OCC,
+     PARAM_WRITE_POLV,
+     PARAM_WRITE_BIAS,
+     PARAM_WRITE_CLD,
+     PARAM_WRITE_DOAS,
+     NUM_PARAM_UINT8
+};
+
 #define SHORT_STRING_LENGTH        ((size_t) 80)
 #define MAX_STRING_LENGTH          ((size_t) 256)
 #define UTC_STRING_LENGTH          28
@@ -187,6 +238,7 @@ struct param_adaguc
      char clipStart[16];
      char clipStop[16];
 
+     unsigned short num_threads;
      unsigned short num_infiles;
      char *name_infiles[MAX_ADAGUC_INFILES];
 
@@ -194,6 +246,25 @@ struct param_adaguc
      char outdir[MAX_STRING_LENGTH];
 };
 
+#define ADAGUC_REC_BLOCK     4096     /* records per write (chunk size) */
+struct adaguc_spool
+{
+     size_t hdr_size;                 /* size of a product header (bytes) */
+     size_t rec_size;                 /* size of a record (bytes) */
+     size_t key_offs;                 /* offset of the time (double) */
+
+     unsigned int num_prod;           /* number of products spooled */
+     unsigned int num_read;           /* number of records read */
+     unsigned int num_rec;            /* number of records to merge */
+     double key_first;                /* time of the first record to merge */
+     double key_last;                 /* time of the last record to merge */
+
+     /*@null@*/ void *hdr;            /* headers of the products */
+     /*@null@*/ struct adaguc_run *run;  /* spooled records per product */
+     /*@null@*/ unsigned int *heap;   /* heap of the k-way merge */
+     unsigned int num_heap;
+};
+
 /* common Envisat PDS data structures */
 typedef struct NADC_pds_hdr_t {
      const char key[PDS_KEYWORD_LENGTH];
@@ -338,6 +409,22 @@ extern size_t NADC_BIWEIGHT(const size_t, const float *,
 			    /*@out@*/ /*@null@*/ float *scale)
      /*@globals  nadc_stat, nadc_err_stack, errno;@*/
      /*@modifies nadc_stat, nadc_err_stack, errno, median, scale@*/;
+extern size_t NADC_BIWEIGHT_BUFF(const size_t, const float *,
+				 /*@null@*/ float *scratch,
+				 /*@out@*/ float *median,
+				 /*@out@*/ /*@null@*/ float *scale)
+     /*@globals  nadc_stat, nadc_err_stack, errno;@*/
+     /*@modifies nadc_stat, nadc_err_stack, errno, scratch, median, scale@*/;
+extern size_t NADC_BIWEIGHT_MULTI(const size_t, const size_t, const float *,
+				  /*@out@*/ float *median,
+				  /*@out@*/ /*@null@*/ float *scale)
+     /*@globals  nadc_stat, nadc_err_stack, errno;@*/
+     /*@modifies nadc_stat, nadc_err_stack, errno, median, scale@*/;
+extern void NADC_MEDIAN_MAD(size_t, const float *, /*@null@*/ float *scratch,
+			    /*@out@*/ float *median,
+			    /*@out@*/ /*@null@*/ float *mad)
+     /*@globals  nadc_stat, nadc_err_stack;@*/
+     /*@modifies nadc_stat, nadc_err_stack, scratch, median, mad@*/;
 extern void NADC_INTERPOL(float, float, float, unsigned int, const float *, 
 			  const float *, /*@unique@*/ float *Y)
       /*@globals  nadc_stat, nadc_err_stack;@*/
@@ -350,6 +437,9 @@ extern void NADC_INTERPOL_d(float, float, float, unsigned int, const float *,
 extern unsigned char nadc_get_param_uint8(const char *)
       /*@globals  nadc_stat, nadc_err_stack;@*/
       /*@modifies nadc_stat, nadc_err_stack@*/;
+extern unsigned char nadc_get_param_uint8_id(enum nadc_param_uint8_id)
+      /*@globals  nadc_stat, nadc_err_stack;@*/
+      /*@modifies nadc_stat, nadc_err_stack@*/;
 extern unsigned short nadc_get_param_uint16(const char *)
       /*@globals  nadc_stat, nadc_err_stack;@*/
       /*@modifies nadc_stat, nadc_err_stack@*/;
@@ -366,6 +456,10 @@ extern /*@null@*/ /*@out@*/ /*@only@*/
 extern int nadc_set_param_uint8(const char *, const unsigned char)
       /*@globals  nadc_stat, nadc_err_stack;@*/
       /*@modifies nadc_stat, nadc_err_stack@*/;
+extern int nadc_set_param_uint8_id(enum nadc_param_uint8_id, 
+				   const unsigned char)
+      /*@globals  nadc_stat, nadc_err_stack;@*/
+      /*@modifies nadc_stat, nadc_err_stack@*/;
 extern int nadc_set_param_uint16(const char *, const unsigned short)
       /*@globals  nadc_stat, nadc_err_stack;@*/
       /*@modifies nadc_stat, nadc_err_stack@*/;
@@ -408,6 +502,10 @@ extern short  SELECTs(const size_t, const size_t, const short  *);
 extern int    SELECTi(const size_t, const size_t, const int    *);
 extern float  SELECTr(const size_t, const size_t, const float  *);
 extern double SELECTd(const size_t, const size_t, const double *);
+extern float  SELECTr_INPLACE(const size_t, const size_t, float  *rbuff)
+     /*@modifies rbuff@*/;
+extern double SELECTd_INPLACE(const size_t, const size_t, double *dbuff)
+     /*@modifies dbuff@*/;
 
 extern size_t NADC_SIGMACLIPPED(const size_t, const float *, 
 				/*@out@*/ float *mean,
@@ -462,6 +560,16 @@ extern void  FIT_GRID_AKIMA(int, int, size_t, const void *, const void *,
 			    /*@out@*/ void *yres)
        /*@globals  nadc_stat, nadc_err_stack;@*/
        /*@modifies nadc_stat, nadc_err_stack, yres@*/;
+struct akima_plan;
+extern struct akima_plan *NADC_AKIMA_PLAN(int, size_t, const void *, 
+					  int, size_t, const void *)
+       /*@globals  nadc_stat, nadc_err_stack;@*/
+       /*@modifies nadc_stat, nadc_err_stack@*/;
+extern void  NADC_AKIMA_PLAN_EXEC(struct akima_plan *, int, const void *,
+				  int, /*@out@*/ void *yres)
+       /*@globals  nadc_stat, nadc_err_stack;@*/
+       /*@modifies nadc_stat, nadc_err_stack, yres@*/;
+extern void  NADC_AKIMA_PLAN_FREE(/*@only@*/ struct akima_plan *);
 
 extern void NADC_FIT(size_t, const float *, const float *, const float *,
 		     /*@out@*/ float *fit_a, 
@@ -494,6 +602,10 @@ extern bool nadc_file_exists(const char *)
        /*@globals  errno;@*/
        /*@modifies errno@*/;
 
+extern void nadc_set_start_time(void);
+extern void nadc_set_stop_time(void);
+extern double nadc_get_epoch_time(void);
+
 extern void NADC_FLIPc(enum nadc_flip, const unsigned int *,
 		       signed char *matrix)
        /*@globals  nadc_stat, nadc_err_stack;@*/
@@ -513,6 +625,27 @@ extern void ADAGUC_INIT_PARAM(int, char **,
 			      /*@out@*/ struct param_adaguc *param)
      /*@globals  errno, stderr, nadc_stat, nadc_err_stack;@*/
      /*@modifies errno, stderr, nadc_stat, nadc_err_stack, param@*/;
+extern /*@null@*/ void *ADAGUC_MERGE_REC(size_t, size_t, unsigned int, 
+					 /*@returned@*/ void *)
+     /*@globals  nadc_stat, nadc_err_stack;@*/
+     /*@modifies nadc_stat, nadc_err_stack@*/;
+extern void ADAGUC_SPOOL_PRODUCTS(const struct param_adaguc *, 
+				  size_t, size_t, size_t,
+				  bool (*)(const char *, /*@out@*/ void *,
+					   /*@out@*/ void **,
+					   /*@out@*/ unsigned int *),
+				  /*@out@*/ struct adaguc_spool *spool)
+     /*@globals  errno, stderr, nadc_stat, nadc_err_stack;@*/
+     /*@modifies errno, stderr, nadc_stat, nadc_err_stack, spool@*/;
+extern void ADAGUC_SPOOL_SELECT(struct adaguc_spool *spool, double, double)
+     /*@globals  nadc_stat, nadc_err_stack;@*/
+     /*@modifies nadc_stat, nadc_err_stack, spool@*/;
+extern unsigned int ADAGUC_SPOOL_MERGE(struct adaguc_spool *spool, 
+				       unsigned int, /*@out@*/ void *rec)
+     /*@globals  nadc_stat, nadc_err_stack;@*/
+     /*@modifies nadc_stat, nadc_err_stack, spool, rec@*/;
+extern void ADAGUC_SPOOL_CLOSE(struct adaguc_spool *spool)
+     /*@modifies spool@*/;
 
 extern void NADC_USRINP(int , /*@unique@*/ const char *, int , 
 			/*@out@*/ void *pntr, /*@out@*/ int *nrval)
@@ -672,6 +805,9 @@ extern int nadc_set_param_hid(const char *, const hid_t)
        /*@modifies nadc_stat, nadc_err_stack*/;
 
 extern hid_t NADC_OPEN_HDF5_Group(hid_t, const char *);
+extern hsize_t NADC_HDF5_CHUNK_SIZE(size_t, hsize_t)
+       /*@globals  nadc_stat, nadc_err_stack;@*/
+       /*@modifies nadc_stat, nadc_err_stack*/;
 
 extern void NADC_WR_HDF5_Attribute(hid_t, const char *, hid_t,
 				   int, const hsize_t *, const void *)
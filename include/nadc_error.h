@@ -22,7 +22,9 @@
 .PURPOSE     definitions for error handling and macro's
 .COMMENTS    None
 .ENVIRONment None
-.VERSION      1.2   31-Mar-2003	modified include for C++ code
+.VERSION      2.0   17-Oct-2026	error status and messages are kept per thread 
+                                (or in an explicit context), RvH
+              1.2   31-Mar-2003	modified include for C++ code
               1.1   22-Mar-2002	added NADC_STAT_ABSENT, RvH 
               1.0   31-Oct-2001 created by R. M. van Hees
 ------------------------------------------------------------*/
@@ -117,11 +119,28 @@ typedef struct NADC_E_t {
      NADC_error_t slots[NADC_E_NSLOTS];
 } NADC_E_t;
 
+typedef struct NADC_ctx_t {
+     unsigned char  stat;
+     unsigned char  stat_save;           /* used by NADC_Err_Keep */
+     unsigned short nused_save;          /* used by NADC_Err_Keep */
+     NADC_E_t       stack;
+} NADC_ctx_t;
+
 /*+++++ Global Variables +++++*/
-extern unsigned char nadc_stat;
-extern NADC_E_t nadc_err_stack;
+/*
+ * error status and error stack of the context of the calling thread,
+ * the names are kept for backward compatibility and can be used as lvalues
+ */
+#define nadc_stat           (NADC_Err_Context()->stat)
+#define nadc_err_stack      (NADC_Err_Context()->stack)
 
 /* Prototypes of modules */
+extern NADC_ctx_t *NADC_Err_Context( void );
+
+extern void NADC_Err_Init_Context( NADC_ctx_t * );
+
+extern NADC_ctx_t *NADC_Err_Use_Context( NADC_ctx_t * );
+
 extern void NADC_Err_Push( NADC_err_t, const char *, const char *, int, 
 			   const char * )
         /*@globals  nadc_stat, nadc_err_stack;@*/
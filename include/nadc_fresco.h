@@ -200,7 +200,8 @@ extern void NADC_FRESCO_RD_NC_META( int , /*@out@*/ struct fresco_hdr * );
 extern unsigned int NADC_FRESCO_RD_NC_REC( int, 
 					   /*@out@*/ struct fresco_rec ** );
 extern void NADC_FRESCO_WR_NC_META( int, const struct fresco_hdr * );
-extern void NADC_FRESCO_WR_NC_REC( int, const char *, unsigned int,
+extern void NADC_FRESCO_DEF_NC_REC( int, const char *, unsigned int );
+extern void NADC_FRESCO_WR_NC_REC( int, unsigned int, unsigned int,
 				   const struct fresco_rec * );
 #endif
 
@@ -299,14 +299,16 @@ extern void SCIA_RD_IMAP_HDO( const char *, /*@out@*/ struct imap_hdr *hdr,
      extern unsigned int SCIA_RD_NC_CH4_REC( int, 
 					     /*@out@*/ struct imap_rec ** );
      extern void SCIA_WR_NC_CH4_META( int, const struct imap_hdr * );
-     extern void SCIA_WR_NC_CH4_REC( int, unsigned int, 
+     extern void SCIA_DEF_NC_CH4_REC( int, unsigned int );
+     extern void SCIA_WR_NC_CH4_REC( int, unsigned int, unsigned int,
 				     const struct imap_rec * );
 
      extern void SCIA_RD_NC_HDO_META( int, /*@out@*/ struct imap_hdr * );
      extern unsigned int SCIA_RD_NC_HDO_REC( int, 
 					     /*@out@*/ struct imap_rec ** );
      extern void SCIA_WR_NC_HDO_META( int, const struct imap_hdr * );
-     extern void SCIA_WR_NC_HDO_REC( int, unsigned int, 
+     extern void SCIA_DEF_NC_HDO_REC( int, unsigned int );
+     extern void SCIA_WR_NC_HDO_REC( int, unsigned int, unsigned int,
 				     const struct imap_rec * );
 #endif
 
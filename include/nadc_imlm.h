@@ -285,12 +285,14 @@ extern void SCIA_RD_IMLM( const char *, /*@out@*/ struct imlm_hdr *hdr,
 extern void SCIA_RD_NC_CO_META( int, /*@out@*/ struct imlm_hdr * );
 extern unsigned int SCIA_RD_NC_CO_REC( int, /*@out@*/ struct imlm_rec ** );
 extern void SCIA_WR_NC_CO_META( int, const struct imlm_hdr * );
-extern void SCIA_WR_NC_CO_REC( int, unsigned int, 
+extern void SCIA_DEF_NC_CO_REC( int, unsigned int );
+extern void SCIA_WR_NC_CO_REC( int, unsigned int, unsigned int,
 			       const struct imlm_rec * );
 extern void SCIA_RD_NC_H2O_META( int, /*@out@*/ struct imlm_hdr * );
 extern unsigned int SCIA_RD_NC_H2O_REC( int, /*@out@*/ struct imlm_rec ** );
 extern void SCIA_WR_NC_H2O_META( int, const struct imlm_hdr * );
-extern void SCIA_WR_NC_H2O_REC( int, unsigned int, 
+extern void SCIA_DEF_NC_H2O_REC( int, unsigned int );
+extern void SCIA_WR_NC_H2O_REC( int, unsigned int, unsigned int,
 				const struct imlm_rec * );
 #endif
 
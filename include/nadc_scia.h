@@ -386,6 +386,9 @@ extern double GET_SCIA_ROE_JDAY(unsigned short);
 extern size_t GET_SCIA_ROE_JDAY_ALL(/*@out@*/ double **jday_out)
        /*@globals  nadc_stat, nadc_err_stack;@*/
        /*@modifies nadc_stat, nadc_err_stack, *jday_out@*/;
+extern /*@null@*/ const char *GET_SCIA_ROE_DB_NAME(void)
+       /*@globals  errno;@*/
+       /*@modifies errno@*/;
 
 extern void SCIA_LV1C_FREE_MDS(int, unsigned int, 
 			       /*@only@*/ struct mds1c_scia *);
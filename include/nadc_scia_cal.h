@@ -93,6 +93,28 @@ struct RadSens_rec {
      double         **value;
 };
 
+/* spectra of one state, clusters with the same read-out share one group */
+struct spec1c_grp {
+     unsigned char  coaddf;
+     unsigned short num_obs;
+     unsigned short num_pixels;
+     unsigned short stride;          /* row length, a multiple of 16 */
+     float          pet;
+     unsigned short *pixel_ids;      /* [num_pixels] */
+     float          *pixel_val;      /* [num_obs][stride] */
+     float          *pixel_err;      /* [num_obs][stride] */
+};
+
+struct spec1c_scia {
+     unsigned char  type_mds;
+     unsigned short num_clus;
+     unsigned short num_grp;
+     unsigned short clus_grp[MAX_CLUSTER];   /* group of a cluster */
+     unsigned short clus_offs[MAX_CLUSTER];  /* first pixel in the group */
+     unsigned short clus_pixels[MAX_CLUSTER];/* pixels of a cluster */
+     struct spec1c_grp grp[MAX_CLUSTER];
+};
+
 /*
  * prototype declarations of Sciamachy calibration functions
  */
@@ -108,6 +130,19 @@ extern void SCIA_RD_H5_STRAY( /*@out@*/ struct scia_straycorr *stray )
        /*@globals nadc_stat, nadc_err_stack;@*/
        /*@modifies nadc_stat, nadc_err_stack, stray@*/;
 extern void SCIA_FREE_H5_STRAY( struct scia_straycorr *stray );
+extern const struct scia_memcorr *SCIA_GET_H5_MEM( void )
+       /*@globals nadc_stat, nadc_err_stack;@*/
+       /*@modifies nadc_stat, nadc_err_stack@*/;
+extern const struct scia_nlincorr *SCIA_GET_H5_NLIN( void )
+       /*@globals nadc_stat, nadc_err_stack;@*/
+       /*@modifies nadc_stat, nadc_err_stack@*/;
+extern const struct scia_straycorr *SCIA_GET_H5_STRAY( void )
+       /*@globals nadc_stat, nadc_err_stack;@*/
+       /*@modifies nadc_stat, nadc_err_stack@*/;
+extern const struct rspd_key *SCIA_GET_H5_RSPD( void )
+       /*@globals nadc_stat, nadc_err_stack;@*/
+       /*@modifies nadc_stat, nadc_err_stack@*/;
+extern void SCIA_FREE_H5_CKD_CACHE( void );
 
 #if defined _STDIO_H || defined _STDIO_H_ || defined S_SPLINT_S
 extern void SCIA_LV1_CAL( FILE *fp, unsigned int,
@@ -160,6 +195,16 @@ extern void SCIA_SRON_FLAG_BDPM( const struct file_rec *fileParam,
      /*@globals  errno, nadc_stat, nadc_err_stack;@*/
      /*@modifies errno, nadc_stat, nadc_err_stack, fileParam->fp,
        mds_1c->pixel_val@*/;
+extern void SCIA_ATBD_FLAG_BDPM_SPEC( const struct file_rec *fileParam,
+				      struct spec1c_scia *spec )
+     /*@globals  errno, nadc_stat, nadc_err_stack;@*/
+     /*@modifies errno, nadc_stat, nadc_err_stack, fileParam->fp, 
+       spec->grp@*/;
+extern void SCIA_SRON_FLAG_BDPM_SPEC( const struct file_rec *fileParam,
+				      struct spec1c_scia *spec )
+     /*@globals  errno, nadc_stat, nadc_err_stack;@*/
+     /*@modifies errno, nadc_stat, nadc_err_stack, fileParam->fp, 
+       spec->grp@*/;
 
 extern void SCIA_ATBD_CAL_DARK( const struct file_rec *fileParam,
 				const struct state1_scia *,
@@ -167,6 +212,12 @@ extern void SCIA_ATBD_CAL_DARK( const struct file_rec *fileParam,
      /*@globals  errno, nadc_stat, nadc_err_stack, Use_Extern_Alloc;@*/
      /*@modifies errno, nadc_stat, nadc_err_stack, fileParam->fp,
        mds_1c->pixel_val, mds_1c->pixel_err@*/;
+extern void SCIA_ATBD_CAL_DARK_SPEC( const struct file_rec *fileParam,
+				     const struct state1_scia *,
+				     struct spec1c_scia *spec )
+     /*@globals  errno, nadc_stat, nadc_err_stack, Use_Extern_Alloc;@*/
+     /*@modifies errno, nadc_stat, nadc_err_stack, fileParam->fp, 
+       spec->grp@*/;
 extern void SCIA_SRON_CAL_DARK( const struct file_rec *fileParam,
 				const struct state1_scia *,
 				struct mds1c_scia *mds_1c )
@@ -183,6 +234,10 @@ extern void SCIA_STATE_CAL_DARK( const struct file_rec *fileParam,
 extern void SCIA_ATBD_CAL_ETALON( const struct file_rec *,
 				  const struct state1_scia *, 
 				  struct mds1c_scia * );
+extern void SCIA_ATBD_CAL_ETALON_SPEC( const struct file_rec *,
+				       struct spec1c_scia *spec )
+     /*@globals  errno, nadc_stat, nadc_err_stack;@*/
+     /*@modifies errno, nadc_stat, nadc_err_stack, spec->grp@*/;
 
 extern void SCIA_SRON_CAL_TRANS( const struct file_rec *,
 				 const struct state1_scia *, 
@@ -190,6 +245,10 @@ extern void SCIA_SRON_CAL_TRANS( const struct file_rec *,
      /*@globals  errno, nadc_stat, nadc_err_stack;@*/
      /*@modifies errno, nadc_stat, nadc_err_stack, fileParam->fp,
        mds_1c->pixel_val@*/;
+extern void SCIA_SRON_CAL_TRANS_SPEC( const struct file_rec *,
+				      struct spec1c_scia *spec )
+     /*@globals  errno, nadc_stat, nadc_err_stack;@*/
+     /*@modifies errno, nadc_stat, nadc_err_stack, spec->grp@*/;
 
 extern void SCIA_ATBD_CAL_PPG( const struct file_rec *fileParam,
 			       const struct state1_scia *, 
@@ -197,6 +256,11 @@ extern void SCIA_ATBD_CAL_PPG( const struct file_rec *fileParam,
      /*@globals  errno, nadc_stat, nadc_err_stack;@*/
      /*@modifies errno, nadc_stat, nadc_err_stack, fileParam->fp,
        mds_1c->pixel_val, mds_1c->pixel_err@*/;
+extern void SCIA_ATBD_CAL_PPG_SPEC( const struct file_rec *fileParam,
+				    struct spec1c_scia *spec )
+     /*@globals  errno, nadc_stat, nadc_err_stack;@*/
+     /*@modifies errno, nadc_stat, nadc_err_stack, fileParam->fp,
+       spec->grp@*/;
 extern void SCIA_SRON_CAL_PPG( const struct file_rec *fileParam,
 			       const struct state1_scia *, 
 			       struct mds1c_scia *mds_1c )
@@ -237,6 +301,30 @@ extern void SCIA_ATBD_INIT_WAVE( const struct file_rec *fileParam,
       /*@modifies errno, nadc_stat, nadc_err_stack, fileParam->fp,
 	wvlen->science, wvlen->error, wvlen->solar@*/;
 
+/*
+ * per-pixel correction factors, used by the fused mode of SCIA_LV1_CAL
+ */
+extern const struct DarkRec *SCIA_ATBD_GET_DARK( const struct file_rec *,
+						 const struct state1_scia *,
+						 int )
+     /*@globals  errno, nadc_stat, nadc_err_stack, Use_Extern_Alloc;@*/
+     /*@modifies errno, nadc_stat, nadc_err_stack@*/;
+extern const float *SCIA_ATBD_GET_PPG( const struct file_rec * )
+     /*@globals  errno, nadc_stat, nadc_err_stack;@*/
+     /*@modifies errno, nadc_stat, nadc_err_stack@*/;
+extern const float *SCIA_ATBD_GET_ETALON( const struct file_rec * )
+     /*@globals  errno, nadc_stat, nadc_err_stack;@*/
+     /*@modifies errno, nadc_stat, nadc_err_stack@*/;
+extern const unsigned char *SCIA_ATBD_GET_BDPM( const struct file_rec * )
+     /*@globals  errno, nadc_stat, nadc_err_stack;@*/
+     /*@modifies errno, nadc_stat, nadc_err_stack@*/;
+extern const unsigned char *SCIA_SRON_GET_BDPM( const struct file_rec * )
+     /*@globals  errno, nadc_stat, nadc_err_stack;@*/
+     /*@modifies errno, nadc_stat, nadc_err_stack@*/;
+extern float SCIA_SRON_GET_TRANS( const struct file_rec * )
+     /*@globals  errno, nadc_stat, nadc_err_stack;@*/
+     /*@modifies errno, nadc_stat, nadc_err_stack@*/;
+
 extern void SCIA_SRON_CAL_NOISE( const struct file_rec *,
 				 const struct state1_scia *, 
 				 struct mds1c_scia *mds_1c )
@@ -244,6 +332,16 @@ extern void SCIA_SRON_CAL_NOISE( const struct file_rec *,
      /*@modifies errno, nadc_stat, nadc_err_stack, mds_1c->pixel_err@*/;
 #endif   /* ---- defined _STDIO_H || defined _STDIO_H_ ----- */
 
+extern void SCIA_LV1C_SPEC_FILL( unsigned short, const struct mds1c_scia *,
+				 /*@out@*/ struct spec1c_scia *spec )
+     /*@globals  nadc_stat, nadc_err_stack;@*/
+     /*@modifies nadc_stat, nadc_err_stack, spec@*/;
+extern void SCIA_LV1C_SPEC_STORE( const struct spec1c_scia *,
+				  unsigned short, struct mds1c_scia *mds_1c )
+     /*@modifies mds_1c->pixel_val, mds_1c->pixel_err@*/;
+extern void SCIA_LV1C_SPEC_FREE( struct spec1c_scia *spec )
+     /*@modifies spec@*/;
+
 extern void SCIA_ATBD_CAL_MEM( unsigned char,
 			       const struct state1_scia *,
 			       const struct mds1_scia *,
@@ -543,6 +543,7 @@ extern unsigned short GET_SCIA_CLUSDEF(unsigned char,
        /*@modifies clusDef, nadc_stat, nadc_err_stack@*/;
 
 extern bool CLUSDEF_DB_EXISTS(void);
+extern /*@null@*/ const char *CLUSDEF_DB_NAME(void);
 extern bool CLUSDEF_MTBL_VALID(unsigned char, unsigned short);
 extern unsigned short CLUSDEF_DURATION(unsigned char, unsigned short);
 extern unsigned short CLUSDEF_NUM_AUX(unsigned char, unsigned short);
@@ -574,6 +575,15 @@ extern size_t SCIA_LV0_RD_MDS_INFO(FILE *fd, unsigned int,
 
 extern void SCIA_LV0_FREE_MDS_INFO(size_t, /*@only@*/ struct mds0_states *);
 
+extern size_t SCIA_LV0_RD_MDS_INDEX(FILE *fd,
+				     /*@out@*/ struct mds0_states **states)
+       /*@globals  errno;@*/
+       /*@modifies errno, *states@*/;
+extern void SCIA_LV0_WR_MDS_INDEX(FILE *fd, size_t,
+				   const struct mds0_states *)
+       /*@globals  errno, nadc_stat, nadc_err_stack;@*/
+       /*@modifies errno, nadc_stat, nadc_err_stack@*/;
+
 extern unsigned int GET_SCIA_LV0_MDS_INFO(FILE *fd, const struct dsd_envi *, 
 					   struct mds0_info *info)
        /*@globals  errno, stderr, nadc_stat, nadc_err_stack;@*/
@@ -623,6 +633,10 @@ extern unsigned int GET_SCIA_LV0_STATE_PMD(FILE *, const struct mds0_states *,
        /*@globals  errno, nadc_stat, nadc_err_stack;@*/
        /*@modifies errno, nadc_stat, nadc_err_stack, fd, pmd_out@*/;
 
+extern void SCIA_LV0_MMAP_OPEN(FILE *fd)
+       /*@globals  errno, nadc_stat, nadc_err_stack;@*/
+       /*@modifies errno, nadc_stat, nadc_err_stack@*/;
+
 extern void SCIA_LV0_RD_LV1_AUX(FILE *fd, /*@out@*/ struct mds1_aux *aux)
        /*@globals  errno, nadc_stat, nadc_err_stack;@*/
        /*@modifies errno, nadc_stat, nadc_err_stack, fd, *aux@*/;
@@ -664,6 +678,14 @@ extern void GET_SCIA_LV0_STATE_PMDtemp(unsigned short,
 extern void GET_SCIA_LV0_DET_PET(struct chan_hdr, 
 				  /*@out@*/ float *, 
 				  /*@out@*/ unsigned short *);
+extern void SCIA_LV0_UNPACK_PIXEL_16(/*@out@*/ unsigned int *, 
+				     const unsigned char *, size_t);
+extern void SCIA_LV0_UNPACK_PIXEL_24(/*@out@*/ unsigned int *, 
+				     const unsigned char *, size_t);
+extern void SCIA_LV0_UNPACK_PIXEL_16S(/*@out@*/ unsigned short *, 
+				      const unsigned char *, size_t);
+extern void SCIA_LV0_UNPACK_PIXEL(const struct chan_src *, 
+				  /*@out@*/ unsigned int *);
 extern unsigned short GET_SCIA_LV0C_MDS(const unsigned int, 
 					 const struct mds0_det *, 
 					 /*@out@*/ struct mds1c_scia **mds)
@@ -680,6 +702,10 @@ extern void SCIA_LV0_WR_ASCII_INFO(size_t, const struct mds0_states *)
 
 extern void SCIA_LV0_FREE_MDS_DET(unsigned short, 
                                    /*@only@*/ struct mds0_det *);
+extern void SCIA_LV0_MMAP_CLOSE(void);
+extern void SCIA_LV0_DET_ARENA_OPEN(void);
+extern void SCIA_LV0_DET_ARENA_RELEASE(void);
+extern void SCIA_LV0_DET_ARENA_CLOSE(void);
 
 extern size_t SCIA_LV0_SELECT_MDS(size_t, const struct mds0_states *,
 			  /*@null@*/ /*@out@*/ struct mds0_states **states)
@@ -299,6 +299,7 @@ static const size_t mtbl_smr2_sizes[DIM_MTBL_SMR2] = {
  * function prototypes
  */
 extern char *SDMF_PATH( const char * );
+extern void SDMF_close_files( void );
 
 extern void SDMF_get_stateParam( unsigned char, unsigned short, 
 				 unsigned short, 
@@ -427,6 +428,11 @@ extern bool SDMF_get_Transmission_30( bool, unsigned short, unsigned short,
      /*@modifies nadc_stat, nadc_err_stack, transmission@*/;
 
 #ifdef _HDF5_H
+extern hid_t SDMF_open_file( const char * );
+extern int SDMF_get_orbitIndex( hid_t, /*@out@*/ const int **orbitList,
+				/*@out@*/ const int **orbitIndex )
+     /*@globals  nadc_stat, nadc_err_stack;@*/
+     /*@modifies nadc_stat, nadc_err_stack, orbitList, orbitIndex@*/;
 extern int SDMF_get_metaIndex( hid_t, int, int *numIndex, int *metaIndex)
 	  /*@modifies numIndex, metaIndex@*/;
 extern int SDMF_get_metaIndex_range( hid_t, const int *, int *numIndex, 
@@ -192,7 +192,8 @@ extern void NADC_TOSOMI_RD_NC_META( int, /*@out@*/ struct tosomi_hdr * );
 extern unsigned int NADC_TOSOMI_RD_NC_REC( int, 
 					   /*@out@*/ struct tosomi_rec ** );
 extern void NADC_TOSOMI_WR_NC_META( int, const struct tosomi_hdr * );
-extern void NADC_TOSOMI_WR_NC_REC( int, unsigned int, 
+extern void NADC_TOSOMI_DEF_NC_REC( int, unsigned int );
+extern void NADC_TOSOMI_WR_NC_REC( int, unsigned int, unsigned int, 
 				   const struct tosomi_rec * );
 #endif
 
@@ -29,7 +29,8 @@
              therefore not portable to all architectures.
 
 .ENVIRONment this is an include file with "inline" functions
-.VERSION      2.7   15-May-2003	fixed a few typos in byte_swap_u64
+.VERSION      2.8   17-Oct-2026	added bulk array routines, RvH
+              2.7   15-May-2003	fixed a few typos in byte_swap_u64
               2.6   31-Mar-2003	speed up real conversion
               2.5   31-Mar-2003	modified include for C++ code 
               2.4   31-Aug-2001	ported to the PGI compiler(s), RvH 
@@ -335,6 +336,26 @@ void IEEE_Swap__DBL( double *dval )
      (void) memcpy( dval, &llval, sizeof( long long ));
 }
 
+/*--------------------------------------------------
+ * Swap bytes of arrays (see nadc_swap_array.c),
+ * dest may be equal to src
+ */
+extern void NADC_SWAP_ARRAY_16( void *dest, const void *src, size_t num );
+extern void NADC_SWAP_ARRAY_32( void *dest, const void *src, size_t num );
+extern void NADC_SWAP_ARRAY_64( void *dest, const void *src, size_t num );
+
+static inline
+void IEEE_Swap__FLT_ARRAY( float *rval, size_t num )
+{
+     NADC_SWAP_ARRAY_32( rval, rval, num );
+}
+
+static inline
+void IEEE_Swap__DBL_ARRAY( double *dval, size_t num )
+{
+     NADC_SWAP_ARRAY_64( dval, dval, num );
+}
+
 #ifdef __cplusplus
   }
 #endif
@@ -34,7 +34,8 @@
 .RETURNS     Nothing
 .COMMENTS    None
 .ENVIRONment None
-.VERSION      1.0   24-Nov-2008 Created by R. M. van Hees
+.VERSION      1.1   17-Oct-2026 added option --threads, RvH
+              1.0   24-Nov-2008 Created by R. M. van Hees
 ------------------------------------------------------------*/
 /*
  * Define _ISOC99_SOURCE to indicate
@@ -42,12 +43,19 @@
  */
 #define  _ISOC99_SOURCE
 
+/*
+ * Define _POSIX_C_SOURCE to indicate
+ * that this is a POSIX.1-2001 program (sysconf)
+ */
+#define  _POSIX_C_SOURCE 200112L
+
 /*+++++ System headers +++++*/
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
 #include <math.h>
+#include <unistd.h>
 
 /*+++++ Local Headers +++++*/
 #include <nadc_common.h>
@@ -75,6 +83,8 @@ struct adaguc_opt {
        "include all measerements equal or less than stop" },
      { "--clip", "<YYYYMMDD>", 
        "clips a certain day or month from input data, format YYYYMM[DD]" },
+     { "--threads", "<N>", 
+       "read input files by N worker processes [default: number of CPUs]" },
 /* last and empty entry */
      { NULL, NULL, "" }
 };
@@ -160,6 +170,7 @@ void ADAGUC_INIT_PARAM(int argc, char *argv[], struct param_adaguc *param)
      char   *cpntr;
      char   prog_master[SHORT_STRING_LENGTH];
      int    narg;
+     long   nproc;
 /*
  * check number of options
  */
@@ -190,6 +201,11 @@ void ADAGUC_INIT_PARAM(int argc, char *argv[], struct param_adaguc *param)
      (void) nadc_strlcpy(param->clipStart, "19500101T000000", 16);
      (void) nadc_strlcpy(param->clipStop , "20500101T000000", 16);
 
+     param->num_threads = 1;
+     if ((nproc = sysconf(_SC_NPROCESSORS_ONLN)) > 1)
+	  param->num_threads = (nproc < MAX_ADAGUC_INFILES) ?
+	       (unsigned short) nproc : MAX_ADAGUC_INFILES;
+
      param->num_infiles = 0;
      param->name_infiles[0] = NULL;
 
@@ -275,6 +291,12 @@ void ADAGUC_INIT_PARAM(int argc, char *argv[], struct param_adaguc *param)
 	       } else if (strncmp(argv[narg]+2, "stop", 4) == 0) {
 		    param->flag_clip = PARAM_SET;
 		    (void) nadc_strlcpy(param->clipStop, argv[narg+1], 16);
+	       } else if (strncmp(argv[narg]+2, "threads", 7) == 0) {
+		    int num = atoi(argv[narg+1]);
+
+		    if (num < 1 || num > MAX_ADAGUC_INFILES)
+			 Show_All_Options(stderr, prog_master);
+		    param->num_threads = (unsigned short) num;
 	       }
 	       narg++;
 	  }
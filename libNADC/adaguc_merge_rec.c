@@ -0,0 +1,805 @@
+/*++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+.COPYRIGHT (c) 2026 SRON (R.M.van.Hees@sron.nl)
+
+   This is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License, version 2, as
+   published by the Free Software Foundation.
+
+   The software is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place - Suite 330,
+   Boston, MA  02111-1307, USA.
+
+.IDENTifer   ADAGUC_MERGE_REC
+.AUTHOR      R.M. van Hees
+.KEYWORDS    ADAGUC - k-way merge
+.LANGUAGE    ANSI C
+.PURPOSE     combine records of several products into one time-ordered 
+             sequence
+.COMMENTS    contains ADAGUC_MERGE_REC, ADAGUC_SPOOL_PRODUCTS, 
+             ADAGUC_SPOOL_SELECT, ADAGUC_SPOOL_MERGE and ADAGUC_SPOOL_CLOSE
+	     - the products are read by a pool of worker processes, each
+	       worker orders the records of a product in time and writes
+	       them to a temporary (spool) file, one file per product
+	     - the spooled products are merged with a heap (N log k, 
+	       k = number of products), only RUN_BUFF records per product
+	       are kept in memory, the caller receives the merged records
+	       in blocks, thus the memory use does not depend on the
+	       total number of records
+	     - the records of one product are ordered in place by
+	       ADAGUC_MERGE_REC: the heap only produces the new order of 
+	       the records, which is applied cycle by cycle
+.ENVIRONment TMPDIR (location of the spool files, see tmpfile(3))
+.VERSION      2.0   17-Oct-2026 read products by worker processes, 
+                                merge spooled products in blocks, RvH
+              1.1   17-Oct-2026 merge in place, bounded growth, RvH
+              1.0   17-Oct-2026 Created by R. M. van Hees
+------------------------------------------------------------*/
+/*
+ * Define _ISOC99_SOURCE to indicate
+ * that this is a ISO C99 program
+ */
+#define  _ISOC99_SOURCE
+
+/*
+ * Define _POSIX_C_SOURCE to indicate
+ * that this is a POSIX.1-2001 program (fork, fseeko)
+ */
+#define  _POSIX_C_SOURCE 200112L
+
+/*+++++ System headers +++++*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+/*+++++ Local Headers +++++*/
+#include <nadc_common.h>
+
+/*+++++ Macros +++++*/
+#define RUN_BUFF          256u       /* records buffered per product */
+#define REC_KEY(rec, nr)  (*(const double *) \
+			   ((const char *)(rec) + (nr) * rec_size + key_offs))
+
+#define SPOOL_FAIL        (-1)       /* failed to read the product */
+#define SPOOL_SKIP        0          /* product is skipped */
+#define SPOOL_DONE        1          /* product is spooled */
+
+/*+++++ Structures +++++*/
+struct run_rec {
+     double       key;            /* key of the first record left in run */
+     unsigned int pos;            /* index of the first record left in run */
+     unsigned int end;            /* index beyond last record of run */
+};
+
+struct adaguc_run {
+     FILE         *fp;            /* spool file of the product */
+     off_t        data_offs;      /* file offset of the first record */
+     unsigned int pos;            /* index of the next record in the file */
+     unsigned int end;            /* index beyond last record to merge */
+     unsigned int num_buff;       /* number of records in buff */
+     unsigned int nr_buff;        /* index of the current record in buff */
+     char         *buff;          /* records read from the spool file */
+};
+
+/*+++++ Local Types +++++*/
+typedef bool (*rd_prod_func)(const char *, void *, void **, unsigned int *);
+
+/*+++++++++++++++++++++++++ Static Functions +++++++++++++++++++++++*/
+static inline
+bool RUN_LESS( const struct run_rec *r1, const struct run_rec *r2 )
+{
+     /* on equal keys the earlier run goes first: the merge is stable */
+     if ( r1->key != r2->key ) return (r1->key < r2->key);
+     return (r1->pos < r2->pos);
+}
+
+static
+void RUN_SIFT_DOWN( unsigned int num_run, struct run_rec *heap,
+		    unsigned int ii )
+{
+     struct run_rec buff = heap[ii];
+
+     for ( ;; ) {
+	  register unsigned int jj = 2 * ii + 1;
+
+	  if ( jj >= num_run ) break;
+	  if ( jj + 1 < num_run && RUN_LESS( heap+jj+1, heap+jj ) ) jj++;
+	  if ( ! RUN_LESS( heap+jj, &buff ) ) break;
+	  heap[ii] = heap[jj];
+	  ii = jj;
+     }
+     heap[ii] = buff;
+}
+
+/*
+ * spooled products: one run per product
+ */
+static inline
+double SPOOL_RUN_KEY( const struct adaguc_spool *spool, unsigned int nr )
+{
+     const struct adaguc_run *run = spool->run + nr;
+
+     return *(const double *) (run->buff + run->nr_buff * spool->rec_size
+			       + spool->key_offs);
+}
+
+static inline
+bool SPOOL_LESS( const struct adaguc_spool *spool, 
+		 unsigned int nr1, unsigned int nr2 )
+{
+     const double key1 = SPOOL_RUN_KEY( spool, nr1 );
+     const double key2 = SPOOL_RUN_KEY( spool, nr2 );
+
+     /* on equal keys the earlier product goes first: the merge is stable */
+     if ( key1 != key2 ) return (key1 < key2);
+     return (nr1 < nr2);
+}
+
+static
+void SPOOL_SIFT_DOWN( struct adaguc_spool *spool, unsigned int ii )
+{
+     unsigned int *heap = spool->heap;
+     unsigned int buff  = heap[ii];
+
+     for ( ;; ) {
+	  register unsigned int jj = 2 * ii + 1;
+
+	  if ( jj >= spool->num_heap ) break;
+	  if ( jj + 1 < spool->num_heap 
+	       && SPOOL_LESS( spool, heap[jj+1], heap[jj] ) ) jj++;
+	  if ( ! SPOOL_LESS( spool, heap[jj], buff ) ) break;
+	  heap[ii] = heap[jj];
+	  ii = jj;
+     }
+     heap[ii] = buff;
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   SPOOL_RD_KEY
+.PURPOSE     read the time of a spooled record
+.INPUT/OUTPUT
+  call as   res = SPOOL_RD_KEY( spool, run, nr, &key );
+     input:
+            struct adaguc_spool *spool : spooled products
+	    struct adaguc_run *run     : spooled product
+	    unsigned int nr            : index of the record
+    output:
+            double *key                : time of the record
+
+.RETURNS     TRUE on success, else FALSE
+.COMMENTS    static function
+-------------------------*/
+static
+bool SPOOL_RD_KEY( const struct adaguc_spool *spool, 
+		   const struct adaguc_run *run, unsigned int nr, 
+		   /*@out@*/ double *key )
+{
+     const off_t offs = run->data_offs 
+	  + (off_t) nr * (off_t) spool->rec_size + (off_t) spool->key_offs;
+
+     if ( fseeko( run->fp, offs, SEEK_SET ) != 0 ) return FALSE;
+     return (fread( key, sizeof(double), 1, run->fp ) == 1);
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   SPOOL_SEARCH
+.PURPOSE     binary search for a time in a spooled product
+.INPUT/OUTPUT
+  call as   res = SPOOL_SEARCH( spool, run, key, upper, &indx );
+     input:
+            struct adaguc_spool *spool : spooled products
+	    struct adaguc_run *run     : spooled product
+	    double key                 : time to search for
+	    bool upper                 : search for the first record later 
+	                                 than key, else not earlier than key
+    output:
+            unsigned int *indx         : index of the record found
+	                                 (run->end when none is found)
+
+.RETURNS     TRUE on success, else FALSE
+.COMMENTS    static function, the records of the product are ordered in time
+-------------------------*/
+static
+bool SPOOL_SEARCH( const struct adaguc_spool *spool, 
+		   const struct adaguc_run *run, double key, bool upper,
+		   /*@out@*/ unsigned int *indx )
+{
+     unsigned int low  = run->pos;
+     unsigned int high = run->end;
+
+     while ( low < high ) {
+	  double key_mid;
+
+	  const unsigned int mid = low + (high - low) / 2;
+
+	  if ( ! SPOOL_RD_KEY( spool, run, mid, &key_mid ) ) return FALSE;
+	  if ( key_mid < key || (upper && key_mid == key) )
+	       low = mid + 1;
+	  else
+	       high = mid;
+     }
+     *indx = low;
+     return TRUE;
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   SPOOL_RANGE
+.PURPOSE     count the records to merge and obtain their time range
+.INPUT/OUTPUT
+  call as   SPOOL_RANGE( spool );
+ in/output:
+            struct adaguc_spool *spool : spooled products
+
+.RETURNS     nothing, error status passed by global variable ``nadc_stat''
+.COMMENTS    static function
+-------------------------*/
+static
+void SPOOL_RANGE( struct adaguc_spool *spool )
+{
+     register unsigned int np;
+
+     bool first = TRUE;
+
+     spool->num_rec = 0u;
+     spool->key_first = spool->key_last = 0.;
+     for ( np = 0; np < spool->num_prod; np++ ) {
+	  const struct adaguc_run *run = spool->run + np;
+
+	  double key;
+
+	  if ( run->pos == run->end ) continue;
+
+	  if ( ! SPOOL_RD_KEY( spool, run, run->pos, &key ) )
+	       NADC_RETURN_ERROR( NADC_ERR_FILE_RD, "spool file" );
+	  if ( first || key < spool->key_first ) spool->key_first = key;
+	  if ( ! SPOOL_RD_KEY( spool, run, run->end - 1, &key ) )
+	       NADC_RETURN_ERROR( NADC_ERR_FILE_RD, "spool file" );
+	  if ( first || key > spool->key_last ) spool->key_last = key;
+	  first = FALSE;
+
+	  spool->num_rec += run->end - run->pos;
+     }
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   SPOOL_FILL
+.PURPOSE     read the next records of a spooled product in its buffer
+.INPUT/OUTPUT
+  call as   res = SPOOL_FILL( spool, run );
+     input:
+            struct adaguc_spool *spool : spooled products
+ in/output:
+	    struct adaguc_run *run     : spooled product
+
+.RETURNS     TRUE on success, else FALSE
+.COMMENTS    static function, the buffer is empty when all records of the
+             product are merged
+-------------------------*/
+static
+bool SPOOL_FILL( const struct adaguc_spool *spool, struct adaguc_run *run )
+{
+     unsigned int num = run->end - run->pos;
+
+     const off_t offs = run->data_offs 
+	  + (off_t) run->pos * (off_t) spool->rec_size;
+
+     run->num_buff = run->nr_buff = 0u;
+     if ( num == 0u ) return TRUE;
+     if ( num > RUN_BUFF ) num = RUN_BUFF;
+
+     if ( fseeko( run->fp, offs, SEEK_SET ) != 0
+	  || fread( run->buff, spool->rec_size, num, run->fp ) != num )
+	  return FALSE;
+     run->pos += num;
+     run->num_buff = num;
+     return TRUE;
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   SPOOL_PRODUCT
+.PURPOSE     read one product and write it to a spool file
+.INPUT/OUTPUT
+  call as   flag = SPOOL_PRODUCT( flname, hdr_size, rec_size, key_offs,
+                                  rd_prod, hdr, fp );
+     input:
+            char *flname          :  name of the product
+            size_t hdr_size       :  size of the product header (bytes)
+            size_t rec_size       :  size of one record (bytes)
+	    size_t key_offs       :  offset of the time (double) in a record
+	    rd_prod_func rd_prod  :  function to read the product
+ in/output:
+            void *hdr             :  buffer for the product header
+	    FILE *fp              :  spool file
+
+.RETURNS     SPOOL_DONE, SPOOL_SKIP or SPOOL_FAIL
+.COMMENTS    static function
+             spool file: flag (int), on SPOOL_DONE followed by the header, 
+	     the number of records (unsigned int) and the records
+-------------------------*/
+static
+int SPOOL_PRODUCT( const char *flname, size_t hdr_size, size_t rec_size,
+		   size_t key_offs, rd_prod_func rd_prod, void *hdr,
+		   FILE *fp )
+{
+     int          flag = SPOOL_DONE;
+     unsigned int num_rec = 0u;
+     void         *rec = NULL;
+
+     if ( ! (*rd_prod)( flname, hdr, &rec, &num_rec ) ) flag = SPOOL_SKIP;
+     if ( IS_ERR_STAT_FATAL ) flag = SPOOL_FAIL;
+     if ( rec == NULL ) num_rec = 0u;
+/*
+ * order the records of the product in time
+ */
+     if ( flag == SPOOL_DONE && num_rec > 1u
+	  && ADAGUC_MERGE_REC( rec_size, key_offs, num_rec, rec ) == NULL )
+	  flag = SPOOL_FAIL;
+
+     if ( fwrite( &flag, sizeof(int), 1, fp ) != 1 ) {
+	  NADC_ERROR( NADC_ERR_FILE_WR, "spool file" );
+	  flag = SPOOL_FAIL;
+     } else if ( flag == SPOOL_DONE ) {
+	  if ( fwrite( hdr, hdr_size, 1, fp ) != 1
+	       || fwrite( &num_rec, sizeof(unsigned int), 1, fp ) != 1
+	       || fwrite( rec, rec_size, num_rec, fp ) != num_rec ) {
+	       NADC_ERROR( NADC_ERR_FILE_WR, "spool file" );
+	       flag = SPOOL_FAIL;
+	  }
+     }
+     if ( fflush( fp ) != 0 && flag != SPOOL_FAIL ) {
+	  NADC_ERROR( NADC_ERR_FILE_WR, "spool file" );
+	  flag = SPOOL_FAIL;
+     }
+     if ( rec != NULL ) free( rec );
+     return flag;
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   SPOOL_WORKER
+.PURPOSE     worker process: spool every num_worker-th product
+.INPUT/OUTPUT
+  call as   SPOOL_WORKER( nw, num_worker, param, hdr_size, rec_size, 
+                          key_offs, rd_prod, fp_spool );
+     input:
+	    unsigned short nw         : index of this worker
+	    unsigned short num_worker : number of workers
+	    struct param_adaguc *param: names of the products
+            size_t hdr_size           : size of the product header (bytes)
+            size_t rec_size           : size of one record (bytes)
+	    size_t key_offs           : offset of the time in a record
+	    rd_prod_func rd_prod      : function to read a product
+	    FILE **fp_spool           : spool files, one per product
+
+.RETURNS     does not return, terminates the (child) process
+.COMMENTS    static function
+             the worker leaves through _exit() to keep the streams and 
+	     HDF5/netCDF objects of the parent untouched
+-------------------------*/
+static /*@exits@*/
+void SPOOL_WORKER( unsigned short nw, unsigned short num_worker,
+		   const struct param_adaguc *param, size_t hdr_size, 
+		   size_t rec_size, size_t key_offs, rd_prod_func rd_prod,
+		   FILE **fp_spool )
+{
+     register unsigned short na;
+
+     int  status = EXIT_SUCCESS;
+     void *hdr;
+
+     if ( (hdr = malloc( hdr_size )) == NULL ) {
+	  NADC_ERROR( NADC_ERR_ALLOC, "hdr" );
+	  status = EXIT_FAILURE;
+     }
+     for ( na = nw; status == EXIT_SUCCESS && na < param->num_infiles; 
+	   na += num_worker ) {
+	  if ( SPOOL_PRODUCT( param->name_infiles[na], hdr_size, rec_size,
+			      key_offs, rd_prod, hdr, fp_spool[na] )
+	       == SPOOL_FAIL )
+	       status = EXIT_FAILURE;
+     }
+     if ( hdr != NULL ) free( hdr );
+     if ( param->flag_silent == PARAM_UNSET ) NADC_Err_Trace( stderr );
+     (void) fflush( NULL );
+     _exit( status );
+}
+
+/*+++++++++++++++++++++++++ Main Program or Function +++++++++++++++*/
+/*+++++++++++++++++++++++++
+.IDENTifer   ADAGUC_MERGE_REC
+.PURPOSE     sort records in time, using the ascending runs already present
+.INPUT/OUTPUT
+  call as   rec = ADAGUC_MERGE_REC( rec_size, key_offs, num_rec, rec );
+     input:
+            size_t rec_size       :  size of one record (bytes)
+	    size_t key_offs       :  offset of the time (double) in a record
+	    unsigned int num_rec  :  number of records
+ in/output:
+	    void *rec             :  records to be sorted (in place)
+
+.RETURNS     rec, NULL on failure (rec is not released nor modified)
+.COMMENTS    the merge is stable
+-------------------------*/
+void *ADAGUC_MERGE_REC( size_t rec_size, size_t key_offs,
+			unsigned int num_rec, void *rec )
+{
+     register unsigned int nr, nrun;
+
+     unsigned int num_run = 1;
+     unsigned int *perm;
+     char   *rbuff = (char *) rec;
+     char   *rtmp;
+     struct run_rec *heap;
+
+     if ( num_rec <= 1u ) return rec;
+/*
+ * count the ascending runs, nothing to do when there is only one
+ */
+     for ( nr = 1; nr < num_rec; nr++ )
+	  if ( REC_KEY( rec, nr ) < REC_KEY( rec, nr-1 ) ) num_run++;
+     if ( num_run == 1u ) return rec;
+
+     heap = (struct run_rec *) malloc( num_run * sizeof(struct run_rec) );
+     if ( heap == NULL ) {
+	  NADC_ERROR( NADC_ERR_ALLOC, "heap" );
+	  return NULL;
+     }
+     if ( (perm = (unsigned int *) 
+	   malloc( num_rec * sizeof(unsigned int) )) == NULL ) {
+	  free( heap );
+	  NADC_ERROR( NADC_ERR_ALLOC, "perm" );
+	  return NULL;
+     }
+     if ( (rtmp = (char *) malloc( rec_size )) == NULL ) {
+	  free( heap ); free( perm );
+	  NADC_ERROR( NADC_ERR_ALLOC, "rtmp" );
+	  return NULL;
+     }
+     heap[0].key = REC_KEY( rec, 0 );
+     heap[0].pos = 0;
+     for ( nrun = 0, nr = 1; nr < num_rec; nr++ ) {
+	  if ( REC_KEY( rec, nr ) < REC_KEY( rec, nr-1 ) ) {
+	       heap[nrun++].end = nr;
+	       heap[nrun].key = REC_KEY( rec, nr );
+	       heap[nrun].pos = nr;
+	  }
+     }
+     heap[nrun].end = num_rec;
+/*
+ * k-way merge: perm[nr] is the current position of the nr-th record
+ */
+     nrun = num_run;
+     nr = nrun / 2;
+     while ( nr-- > 0 ) RUN_SIFT_DOWN( nrun, heap, nr );
+
+     for ( nr = 0; nr < num_rec; nr++ ) {
+	  perm[nr] = heap->pos;
+	  if ( ++heap->pos < heap->end )
+	       heap->key = REC_KEY( rec, heap->pos );
+	  else
+	       heap[0] = heap[--nrun];
+	  RUN_SIFT_DOWN( nrun, heap, 0 );
+     }
+     free( heap );
+/*
+ * move the records to their new position, one cycle of perm at a time
+ */
+     for ( nr = 0; nr < num_rec; nr++ ) {
+	  register unsigned int ni, nj;
+
+	  if ( perm[nr] == nr ) continue;
+
+	  (void) memcpy( rtmp, rbuff + nr * rec_size, rec_size );
+	  ni = nr;
+	  while ( (nj = perm[ni]) != nr ) {
+	       (void) memcpy( rbuff + ni * rec_size, rbuff + nj * rec_size,
+			      rec_size );
+	       perm[ni] = ni;
+	       ni = nj;
+	  }
+	  (void) memcpy( rbuff + ni * rec_size, rtmp, rec_size );
+	  perm[ni] = ni;
+     }
+     free( rtmp );
+     free( perm );
+     return rec;
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   ADAGUC_SPOOL_PRODUCTS
+.PURPOSE     read the input products and write their records, ordered in 
+             time, to spool files
+.INPUT/OUTPUT
+  call as   ADAGUC_SPOOL_PRODUCTS( param, hdr_size, rec_size, key_offs,
+                                   rd_prod, &spool );
+     input:
+            struct param_adaguc *param : command-line parameters
+            size_t hdr_size            : size of the product header (bytes)
+            size_t rec_size            : size of one record (bytes)
+	    size_t key_offs            : offset of the time (double) in a 
+	                                 record
+	    bool (*rd_prod)( flname, hdr, &rec, &num_rec ) : 
+	                                 reads the header and records of a
+					 product, the records are allocated
+					 with malloc, returns FALSE when the
+					 product should be skipped
+    output:
+            struct adaguc_spool *spool : spooled products, the headers of
+	                                 the products are stored in 
+					 spool->hdr in the order of the 
+					 input files
+
+.RETURNS     nothing, error status passed by global variable ``nadc_stat''
+.COMMENTS    The products are read by param->num_threads worker processes,
+             the library keeps its error status in global variables, and 
+	     HDF5/netCDF are not thread-safe, therefore the workers are 
+	     processes and not threads. The products are distributed 
+	     round-robin over the workers. 
+	     Release the spool with ADAGUC_SPOOL_CLOSE, also on failure
+-------------------------*/
+void ADAGUC_SPOOL_PRODUCTS( const struct param_adaguc *param,
+			    size_t hdr_size, size_t rec_size, size_t key_offs,
+			    bool (*rd_prod)( const char *, void *, void **,
+					     unsigned int * ),
+			    struct adaguc_spool *spool )
+{
+     register unsigned short na, nw;
+
+     unsigned short num_worker = param->num_threads;
+     bool  failed = FALSE;
+
+     FILE  *fp_spool[MAX_ADAGUC_INFILES];
+     pid_t pid[MAX_ADAGUC_INFILES];
+
+     spool->hdr_size = hdr_size;
+     spool->rec_size = rec_size;
+     spool->key_offs = key_offs;
+     spool->num_prod = spool->num_read = spool->num_rec = 0u;
+     spool->key_first = spool->key_last = 0.;
+     spool->hdr  = NULL;
+     spool->run  = NULL;
+     spool->heap = NULL;
+     spool->num_heap = 0u;
+
+     for ( na = 0; na < MAX_ADAGUC_INFILES; na++ ) fp_spool[na] = NULL;
+     if ( param->num_infiles == 0 ) return;
+
+     spool->hdr = malloc( param->num_infiles * hdr_size );
+     if ( spool->hdr == NULL ) NADC_RETURN_ERROR( NADC_ERR_ALLOC, "hdr" );
+     spool->run = (struct adaguc_run *)
+	  calloc( param->num_infiles, sizeof(struct adaguc_run) );
+     if ( spool->run == NULL ) NADC_RETURN_ERROR( NADC_ERR_ALLOC, "run" );
+
+     for ( na = 0; na < param->num_infiles; na++ ) {
+	  if ( (fp_spool[na] = tmpfile()) == NULL )
+	       NADC_GOTO_ERROR( NADC_ERR_FILE, "spool file" );
+     }
+/*
+ * read the products, without workers when only one is requested
+ */
+     if ( num_worker > param->num_infiles ) num_worker = param->num_infiles;
+     if ( num_worker <= 1 ) {
+	  for ( na = 0; na < param->num_infiles; na++ ) {
+	       if ( SPOOL_PRODUCT( param->name_infiles[na], hdr_size, 
+				   rec_size, key_offs, rd_prod, spool->hdr,
+				   fp_spool[na] ) == SPOOL_FAIL )
+		    break;
+	  }
+     } else {
+	  /* flush all streams to prevent duplicated output */
+	  (void) fflush( NULL );
+	  for ( nw = 0; nw < num_worker; nw++ ) {
+	       if ( (pid[nw] = fork()) < 0 ) {
+		    NADC_ERROR( NADC_ERR_FATAL, strerror( errno ) );
+		    break;
+	       }
+	       if ( pid[nw] == 0 )
+		    SPOOL_WORKER( nw, num_worker, param, hdr_size, rec_size,
+				  key_offs, rd_prod, fp_spool );
+	  }
+	  while ( nw-- > 0 ) {
+	       int status;
+
+	       if ( waitpid( pid[nw], &status, 0 ) != pid[nw]
+		    || ! WIFEXITED(status) 
+		    || WEXITSTATUS(status) != EXIT_SUCCESS )
+		    failed = TRUE;
+	  }
+	  if ( IS_ERR_STAT_FATAL ) goto done;
+     }
+/*
+ * collect the headers and the location of the records, 
+ * in the order of the input files
+ */
+     for ( na = 0; na < param->num_infiles; na++ ) {
+	  struct adaguc_run *run = spool->run + spool->num_prod;
+
+	  char  *hdr = (char *) spool->hdr + spool->num_prod * hdr_size;
+	  FILE  *fp = fp_spool[na];
+	  int   flag;
+	  unsigned int num_rec;
+
+	  rewind( fp );
+	  if ( fread( &flag, sizeof(int), 1, fp ) != 1 || flag == SPOOL_FAIL )
+	       NADC_GOTO_ERROR( NADC_ERR_FATAL, param->name_infiles[na] );
+	  if ( flag == SPOOL_SKIP ) continue;
+
+	  if ( fread( hdr, hdr_size, 1, fp ) != 1
+	       || fread( &num_rec, sizeof(unsigned int), 1, fp ) != 1 )
+	       NADC_GOTO_ERROR( NADC_ERR_FILE_RD, "spool file" );
+	  if ( num_rec > UINT_MAX - spool->num_read )
+	       NADC_GOTO_ERROR( NADC_ERR_FATAL, "too many records" );
+
+	  if ( (run->data_offs = ftello( fp )) < 0 )
+	       NADC_GOTO_ERROR( NADC_ERR_FILE_RD, "spool file" );
+	  run->fp = fp;
+	  fp_spool[na] = NULL;
+	  run->pos = 0u;
+	  run->end = num_rec;
+	  spool->num_read += num_rec;
+	  spool->num_prod++;
+     }
+     if ( failed ) NADC_GOTO_ERROR( NADC_ERR_FATAL, "worker failed" );
+
+     SPOOL_RANGE( spool );
+ done:
+     for ( na = 0; na < param->num_infiles; na++ ) {
+	  if ( fp_spool[na] != NULL ) (void) fclose( fp_spool[na] );
+     }
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   ADAGUC_SPOOL_SELECT
+.PURPOSE     select the spooled records within a time range
+.INPUT/OUTPUT
+  call as   ADAGUC_SPOOL_SELECT( &spool, key_start, key_stop );
+     input:
+            double key_start           : include records equal or later
+	    double key_stop            : include records equal or earlier
+ in/output:
+            struct adaguc_spool *spool : spooled products
+
+.RETURNS     nothing, error status passed by global variable ``nadc_stat''
+.COMMENTS    call before ADAGUC_SPOOL_MERGE, spool->num_rec, 
+             spool->key_first and spool->key_last are updated
+-------------------------*/
+void ADAGUC_SPOOL_SELECT( struct adaguc_spool *spool, 
+			  double key_start, double key_stop )
+{
+     register unsigned int np;
+
+     if ( spool->heap != NULL )
+	  NADC_RETURN_ERROR( NADC_ERR_FATAL, "merge already started" );
+
+     for ( np = 0; np < spool->num_prod; np++ ) {
+	  struct adaguc_run *run = spool->run + np;
+
+	  unsigned int ilow, ihigh;
+
+	  if ( ! SPOOL_SEARCH( spool, run, key_start, FALSE, &ilow )
+	       || ! SPOOL_SEARCH( spool, run, key_stop, TRUE, &ihigh ) )
+	       NADC_RETURN_ERROR( NADC_ERR_FILE_RD, "spool file" );
+	  run->pos = ilow;
+	  run->end = (ihigh > ilow) ? ihigh : ilow;
+     }
+     SPOOL_RANGE( spool );
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   ADAGUC_SPOOL_MERGE
+.PURPOSE     obtain the next block of spooled records, ordered in time
+.INPUT/OUTPUT
+  call as   num = ADAGUC_SPOOL_MERGE( &spool, max_rec, rec );
+     input:
+            unsigned int max_rec       : maximum number of records
+ in/output:
+            struct adaguc_spool *spool : spooled products
+    output:
+            void *rec                  : records (max_rec elements)
+
+.RETURNS     number of records in rec, zero when all records are merged
+             error status passed by global variable ``nadc_stat''
+.COMMENTS    the merge is stable: records with the same time are 
+             returned in the order of the input files
+-------------------------*/
+unsigned int ADAGUC_SPOOL_MERGE( struct adaguc_spool *spool, 
+				 unsigned int max_rec, void *rec )
+{
+     register unsigned int nr;
+
+     char *rbuff = (char *) rec;
+
+     const size_t rec_size = spool->rec_size;
+/*
+ * first call: fill the buffers of the products and build the heap
+ */
+     if ( spool->heap == NULL ) {
+	  if ( spool->num_prod == 0u ) return 0u;
+
+	  spool->heap = (unsigned int *)
+	       malloc( spool->num_prod * sizeof(unsigned int) );
+	  if ( spool->heap == NULL ) {
+	       NADC_ERROR( NADC_ERR_ALLOC, "heap" );
+	       return 0u;
+	  }
+	  spool->num_heap = 0u;
+	  for ( nr = 0; nr < spool->num_prod; nr++ ) {
+	       struct adaguc_run *run = spool->run + nr;
+
+	       if ( run->pos == run->end ) continue;
+	       if ( (run->buff = (char *) malloc( RUN_BUFF * rec_size )) 
+		    == NULL ) {
+		    NADC_ERROR( NADC_ERR_ALLOC, "run->buff" );
+		    return 0u;
+	       }
+	       if ( ! SPOOL_FILL( spool, run ) ) {
+		    NADC_ERROR( NADC_ERR_FILE_RD, "spool file" );
+		    return 0u;
+	       }
+	       spool->heap[spool->num_heap++] = nr;
+	  }
+	  nr = spool->num_heap / 2;
+	  while ( nr-- > 0 ) SPOOL_SIFT_DOWN( spool, nr );
+     }
+/*
+ * k-way merge: take the earliest record of all products
+ */
+     for ( nr = 0; nr < max_rec && spool->num_heap > 0u; nr++ ) {
+	  struct adaguc_run *run = spool->run + spool->heap[0];
+
+	  (void) memcpy( rbuff + nr * rec_size, 
+			 run->buff + run->nr_buff * rec_size, rec_size );
+	  if ( ++run->nr_buff == run->num_buff ) {
+	       if ( ! SPOOL_FILL( spool, run ) ) {
+		    NADC_ERROR( NADC_ERR_FILE_RD, "spool file" );
+		    return 0u;
+	       }
+	       if ( run->num_buff == 0u )
+		    spool->heap[0] = spool->heap[--spool->num_heap];
+	  }
+	  if ( spool->num_heap > 0u ) SPOOL_SIFT_DOWN( spool, 0 );
+     }
+     return nr;
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   ADAGUC_SPOOL_CLOSE
+.PURPOSE     remove the spool files and release the memory of the spool
+.INPUT/OUTPUT
+  call as   ADAGUC_SPOOL_CLOSE( &spool );
+ in/output:
+            struct adaguc_spool *spool : spooled products
+
+.RETURNS     nothing
+.COMMENTS    the spool files are removed when they are closed
+-------------------------*/
+void ADAGUC_SPOOL_CLOSE( struct adaguc_spool *spool )
+{
+     register unsigned int np;
+
+     if ( spool->run != NULL ) {
+	  for ( np = 0; np < spool->num_prod; np++ ) {
+	       struct adaguc_run *run = spool->run + np;
+
+	       if ( run->fp != NULL ) (void) fclose( run->fp );
+	       if ( run->buff != NULL ) free( run->buff );
+	  }
+	  free( spool->run );
+     }
+     if ( spool->hdr != NULL ) free( spool->hdr );
+     if ( spool->heap != NULL ) free( spool->heap );
+     spool->hdr  = NULL;
+     spool->run  = NULL;
+     spool->heap = NULL;
+     spool->num_prod = spool->num_heap = 0u;
+     spool->num_read = spool->num_rec = 0u;
+}
@@ -36,9 +36,15 @@
     output:  
 	    void   *y_out     :  y values of the spectrum fitted to grid
 .RETURNS     nothing
-.COMMENTS    nothing
+.COMMENTS    contains NADC_AKIMA_SU, NADC_AKIMA_PO, NADC_AKIMA_PLAN,
+             NADC_AKIMA_PLAN_EXEC, NADC_AKIMA_PLAN_FREE and FIT_GRID_AKIMA
+	     - use a plan when many spectra are interpolated between the
+	       same two grids, FIT_GRID_AKIMA is faster for a single spectrum
 .ENVIRONment None
-.VERSION     4.3     23-Nov-2003   more BUGs Fixed, RvH
+.VERSION     5.1     17-Oct-2026   FIT_GRID_AKIMA does not use a plan, RvH
+             5.0     17-Oct-2026   added NADC_AKIMA_PLAN(_EXEC/_FREE),
+                                   FIT_GRID_AKIMA uses a plan, RvH
+             4.3     23-Nov-2003   more BUGs Fixed, RvH
              4.2     03-Jul-2003   BUG Fix: used uninitialised memory
                                    in NADC_AKIMA_EX, RvH
              4.1     23-Jan-2003   several small bugs fixed, RvH
@@ -73,6 +79,18 @@
 #define SMALL_EPSILON        (1e-10)
 #define VERY_SMALL_EPSILON   (1e-16)
 
+/*+++++ Structures +++++*/
+struct akima_plan {
+     size_t dim_in;
+     size_t dim_out;
+     double *xx;                /* x_in extended by 2 points left and right */
+     double *hh;                /* interval widths of xx */
+     size_t *seg;               /* polynomial segment of each output point */
+     double *xdelta;            /* offset of output point in its segment */
+     double *yy, *st, *tt;      /* work space of NADC_AKIMA_PLAN_EXEC */
+     double *a_coef, *b_coef, *c_coef, *d_coef;
+};
+
 /*+++++++++++++++++++++++++ Static Functions +++++++++++++++++++++++*/
 /*+++++++++++++++++++++++++
 .IDENTifer   NADC_AKIMA_EX
@@ -347,6 +365,321 @@ double NADC_AKIMA_PO(size_t dim_in, const double *x_in,
 				     + xdelta * d_coef[xi])));
 }
 
+/*+++++++++++++++++++++++++
+.IDENTifer   NADC_AKIMA_PLAN
+.PURPOSE     prepare Akima interpolation from a fixed grid x_in to x_out
+.INPUT/OUTPUT
+  call as   plan = NADC_AKIMA_PLAN(FLT32_T, dim_in, x_in, 
+                                   FLT32_T, dim_out, x_out);
+     input:  
+	    int    x_type_in  :  data type of x_in (float or double)
+	    size_t dim_in     :  dimension of x_in
+            void   *x_in      :  input (wavelength) grid
+	    int    x_type_out :  data type of x_out (float or double)
+	    size_t dim_out    :  dimension of x_out
+	    void   *x_out     :  output (wavelength) grid
+
+.RETURNS     pointer to a new plan, NULL on failure
+.COMMENTS    everything which depends only on the x grids is calculated
+             here: the extrapolated grid, the interval widths, and the 
+	     segment and offset of each output point. The spline itself
+	     depends on y, use NADC_AKIMA_PLAN_EXEC to evaluate a spectrum.
+	     A plan contains work space, do not share it between threads.
+-------------------------*/
+struct akima_plan *NADC_AKIMA_PLAN(int x_type_in, size_t dim_in, 
+				   const void *x_in, int x_type_out, 
+				   size_t dim_out, const void *x_out)
+{
+     register size_t nr, xi;
+
+     bool   ascnd_out = TRUE;
+     bool   mono_out = TRUE;
+     double *x_dbl_in, *x_dbl_out;
+
+     struct akima_plan *plan;
+
+     const size_t akima_points = dim_in + AKIMA_EXTRA_POINTS;
+
+     if ((x_type_in != FLT32_T && x_type_in != FLT64_T)
+	 || (x_type_out != FLT32_T && x_type_out != FLT64_T)) {
+	  NADC_ERROR(NADC_ERR_FATAL, "invalid types used");
+	  return NULL;
+     }
+     if ((plan = (struct akima_plan *) 
+	  calloc(1, sizeof(struct akima_plan))) == NULL) {
+	  NADC_ERROR(NADC_ERR_ALLOC, "plan");
+	  return NULL;
+     }
+     plan->dim_in  = dim_in;
+     plan->dim_out = dim_out;
+     plan->xx = (double *) malloc((5 * akima_points + 4 * dim_in 
+				   + 2 * dim_out) * sizeof(double));
+     if (plan->xx == NULL) NADC_GOTO_ERROR(NADC_ERR_ALLOC, "xx");
+     plan->hh     = plan->xx + akima_points;
+     plan->yy     = plan->hh + akima_points;
+     plan->st     = plan->yy + akima_points;
+     plan->tt     = plan->st + akima_points;
+     plan->a_coef = plan->tt + akima_points;
+     plan->b_coef = plan->a_coef + dim_in;
+     plan->c_coef = plan->b_coef + dim_in;
+     plan->d_coef = plan->c_coef + dim_in;
+     plan->xdelta = plan->d_coef + dim_in;
+     x_dbl_out    = plan->xdelta + dim_out;
+     plan->seg = (size_t *) malloc(dim_out * sizeof(size_t));
+     if (plan->seg == NULL) NADC_GOTO_ERROR(NADC_ERR_ALLOC, "seg");
+/*
+ * do all calculation in double precision (x_in moved 2 indices up)
+ */
+     x_dbl_in = plan->xx + 2;
+     if (x_type_in == FLT32_T) {
+	  const float *x_pntr = (const float *) x_in;
+
+	  nr = 0;
+	  do { x_dbl_in[nr] = (double)(x_pntr[nr]); } while(++nr < dim_in);
+     } else
+	  (void) memcpy(x_dbl_in, x_in, dim_in * sizeof(double));
+
+     if (x_type_out == FLT32_T) {
+	  const float *x_pntr = (const float *) x_out;
+
+	  nr = 0;
+	  do { x_dbl_out[nr] = (double)(x_pntr[nr]); } while(++nr < dim_out);
+     } else
+	  (void) memcpy(x_dbl_out, x_out, dim_out * sizeof(double));
+/*
+ * check if x_in is monotonic increasing
+ */
+     nr = 0;
+     do {
+	  if (! (x_dbl_in[nr+1] >= x_dbl_in[nr])) {
+	       char msg[64];
+
+	       (void) fprintf(stderr, "-> %zd %f %f\n",
+			      nr, x_dbl_in[nr], x_dbl_in[nr+1]);
+	       (void) sprintf(msg, 
+			      "x_in is not monotonic increasing at %-zd", nr);
+	       NADC_GOTO_ERROR(NADC_ERR_FATAL, msg); 
+	  }
+     } while (++nr < dim_in-1);
+/*
+ * calculation of extrapolated x-values left and right, and interval widths
+ */
+     plan->xx[1] = plan->xx[2] + plan->xx[3] - plan->xx[4];
+     plan->xx[0] = plan->xx[1] + plan->xx[2] - plan->xx[3];
+
+     plan->xx[dim_in+2] = plan->xx[dim_in+1] + plan->xx[dim_in] 
+	  - plan->xx[dim_in-1];
+     plan->xx[dim_in+3] = plan->xx[dim_in+2] + plan->xx[dim_in+1] 
+	  - plan->xx[dim_in];
+
+     for (nr = 0; nr < dim_in+3; nr++)
+	  plan->hh[nr] = plan->xx[nr+1] - plan->xx[nr];
+/*
+ * check if the x_out is monotonic increasing or decreasing
+ */
+     if (dim_out > 1) {
+	  ascnd_out = (x_dbl_out[1] >= x_dbl_out[0]);
+	  for (nr = 1; nr < dim_out-1; nr++) {
+	       if (ascnd_out != (x_dbl_out[nr+1] >= x_dbl_out[nr])) {
+		    mono_out = FALSE;
+		    break;
+	       }
+	  }
+     }
+/*
+ * find for each output point its polynomial segment:
+ *    1) x_out monotonic increasing: forward search
+ *    2) x_out monotonic decreasing: backward search
+ *    else use bi-section algorithm
+ */
+     if (dim_out > 1 && mono_out && ascnd_out) {
+	  xi = 0;
+	  for (nr = 0; nr < dim_out; nr++) {
+	       while(x_dbl_in[xi+1] < x_dbl_out[nr] && (xi+2) < dim_in) xi++;
+	       plan->seg[nr] = xi;
+	  }
+     } else if (dim_out > 1 && mono_out) {
+	  xi = dim_in - 2;
+	  for (nr = 0; nr < dim_out; nr++) {
+	       while(x_dbl_in[xi] > x_dbl_out[nr] && xi > 0) xi--;
+	       plan->seg[nr] = xi;
+	  }
+     } else {
+	  const bool ascnd = (x_dbl_in[dim_in-1] >= x_dbl_in[0]);
+
+	  for (nr = 0; nr < dim_out; nr++) {
+	       register size_t xlo = 0;
+	       register size_t xhi = dim_in - 1;
+
+	       while(xhi - xlo > 1) {
+		    xi = (xhi+xlo) >> 1;
+		    if ((x_dbl_in[xi] <= x_dbl_out[nr]) == ascnd) 
+			 xlo = xi;
+		    else 
+			 xhi = xi;
+	       }
+	       plan->seg[nr] = xlo;
+	  }
+     }
+     for (nr = 0; nr < dim_out; nr++)
+	  plan->xdelta[nr] = x_dbl_out[nr] - x_dbl_in[plan->seg[nr]];
+
+     return plan;
+ done:
+     NADC_AKIMA_PLAN_FREE(plan);
+     return NULL;
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   NADC_AKIMA_PLAN_EXEC
+.PURPOSE     interpolate a spectrum using a plan of NADC_AKIMA_PLAN
+.INPUT/OUTPUT
+  call as   NADC_AKIMA_PLAN_EXEC(plan, FLT64_T, y_in, FLT64_T, y_out);
+     input:  
+	    struct akima_plan *plan : plan for the grids x_in and x_out
+	    int    y_type_in  :  data type of y_in (float or double)
+	    void   *y_in      :  y values of the given spectrum [dim_in]
+	    int    y_type_out :  data type of y_out (float or double)
+    output:  
+	    void   *y_out     :  y values of the spectrum fitted to grid
+                                 [dim_out], y_out may be equal to y_in
+
+.RETURNS     nothing
+.COMMENTS    the arithmetic is identical to NADC_AKIMA_SU/NADC_AKIMA_PO,
+             the loops have no dependency between iterations and are
+	     vectorized by the compiler
+-------------------------*/
+void NADC_AKIMA_PLAN_EXEC(struct akima_plan *plan, int y_type_in, 
+			  const void *y_in, int y_type_out, void *y_out)
+{
+     register size_t ii;
+     register double tmp;
+
+     const size_t dim_in  = plan->dim_in;
+     const size_t dim_out = plan->dim_out;
+     const double * restrict hh = plan->hh;
+     double * restrict yy = plan->yy;
+     double * restrict st = plan->st;
+     double * restrict tt = plan->tt;
+     double * restrict a_coef = plan->a_coef;
+     double * restrict b_coef = plan->b_coef;
+     double * restrict c_coef = plan->c_coef;
+     double * restrict d_coef = plan->d_coef;
+
+     if (y_type_in == FLT32_T) {
+	  const float *y_pntr = (const float *) y_in;
+
+	  for (ii = 0; ii < dim_in; ii++) yy[ii+2] = (double) y_pntr[ii];
+     } else if (y_type_in == FLT64_T) {
+	  (void) memcpy(yy+2, y_in, dim_in * sizeof(double));
+     } else
+	  NADC_RETURN_ERROR(NADC_ERR_PARAM, "y_type_in");
+     if (y_type_out != FLT32_T && y_type_out != FLT64_T)
+	  NADC_RETURN_ERROR(NADC_ERR_PARAM, "y_type_out");
+/*
+ * calculation of slopes of curves
+ */
+     for (ii = 2; ii < dim_in+1; ii++)
+	  st[ii] = (hh[ii] <= SMALL_EPSILON) ? 
+	       0.0 : (yy[ii+1] - yy[ii]) / hh[ii];
+/*
+ * calculation of extrapolated y-values left and right
+ */
+     tmp = hh[1];
+     yy[1] = tmp * (st[3] - 2.0 * st[2]) + yy[2];
+     st[1] = (tmp <= SMALL_EPSILON) ? 0.0 : (yy[2] - yy[1]) / tmp;
+
+     tmp = hh[0];
+     yy[0] = tmp * (st[2] - 2.0 * st[1]) + yy[1];
+     st[0] = (tmp <= SMALL_EPSILON) ? 0.0 : (yy[1] - yy[0]) / tmp;
+
+     tmp = hh[dim_in+1];
+     yy[dim_in+2] = tmp * (2 * st[dim_in] - st[dim_in-1]) + yy[dim_in+1];
+     st[dim_in+1] = (tmp <= SMALL_EPSILON) ? 
+	  0.0 : (yy[dim_in+2] - yy[dim_in+1]) / tmp;
+
+     tmp = hh[dim_in+2];
+     yy[dim_in+3] = tmp * (2 * st[dim_in+1] - st[dim_in]) + yy[dim_in+2];
+     st[dim_in+2] = (tmp <= SMALL_EPSILON) ? 
+	  0.0 : (yy[dim_in+3] - yy[dim_in+2]) / tmp;
+/*
+ * calculation of all polynomial slopes
+ */
+     for (ii = 2; ii < dim_in+2; ii++) {
+	  const double tmp1 = fabs(st[ii+1] - st[ii]  );
+	  const double tmp2 = fabs(st[ii-1] - st[ii-2]);
+
+	  if ((st[ii-2] == st[ii-1]) && (st[ii] == st[ii+1]))
+	       tt[ii] = 0.5 * (st[ii+1] + st[ii]);
+	  else if ((tmp1 + tmp2) >= VERY_SMALL_EPSILON)
+	       tt[ii] = (tmp1 * st[ii-1] + tmp2 * st[ii]) / (tmp1 + tmp2);
+	  else 
+	       tt[ii] = 0.0;
+     }
+/*
+ * calculation of polynomial coefficients (auxiliary points are at ii+2)
+ */
+     for (ii = 0; ii < dim_in-1; ii++) {
+	  const double h1 = hh[ii+2];
+	  const double h2 = h1 * h1;
+
+	  a_coef[ii] = yy[ii+2];
+	  b_coef[ii] = tt[ii+2];
+	  c_coef[ii] = (h1 >= SMALL_EPSILON) ?
+	       (((3. * st[ii+2]) - (2. * tt[ii+2])) - tt[ii+3]) / h1 : 0.0;
+	  d_coef[ii] = (h2 >= SMALL_EPSILON) ?
+	       ((tt[ii+2] + tt[ii+3]) - (2.0 * st[ii+2])) / h2 : 0.0;
+     }
+/*
+ * evaluate polynomials at the output grid
+ */
+     if (y_type_out == FLT64_T) {
+	  double * restrict y_dbl_out = (double *) y_out;
+
+	  for (ii = 0; ii < dim_out; ii++) {
+	       const size_t xi = plan->seg[ii];
+	       const double xdelta = plan->xdelta[ii];
+
+	       y_dbl_out[ii] = (a_coef[xi] 
+				+ xdelta * (b_coef[xi] 
+					    + xdelta * (c_coef[xi] 
+							+ xdelta * d_coef[xi])));
+	  }
+     } else {
+	  float * restrict y_flt_out = (float *) y_out;
+
+	  for (ii = 0; ii < dim_out; ii++) {
+	       const size_t xi = plan->seg[ii];
+	       const double xdelta = plan->xdelta[ii];
+
+	       y_flt_out[ii] = (float) (a_coef[xi] 
+					+ xdelta * (b_coef[xi] 
+						    + xdelta * (c_coef[xi] 
+							+ xdelta * d_coef[xi])));
+	  }
+     }
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   NADC_AKIMA_PLAN_FREE
+.PURPOSE     release a plan obtained with NADC_AKIMA_PLAN
+.INPUT/OUTPUT
+  call as   NADC_AKIMA_PLAN_FREE(plan);
+     input:  
+	    struct akima_plan *plan : plan to be released (may be NULL)
+
+.RETURNS     nothing
+.COMMENTS    none
+-------------------------*/
+void NADC_AKIMA_PLAN_FREE(struct akima_plan *plan)
+{
+     if (plan == NULL) return;
+
+     if (plan->xx != NULL) free(plan->xx);
+     if (plan->seg != NULL) free(plan->seg);
+     free(plan);
+}
+
 /*+++++++++++++++++++++++++ Main Program or Function +++++++++++++++*/
 void FIT_GRID_AKIMA(int x_type_in, int y_type_in, size_t dim_in, 
 		     const void *x_in, const void *y_in, 
@@ -451,14 +784,13 @@ void FIT_GRID_AKIMA(int x_type_in, int y_type_in, size_t dim_in,
 /*
  * check if the x_out is monotonic increasing or decreasing
  */
-     ascnd_out = (x_dbl_out[1] >= x_dbl_out[0]);
-     nr = 1;
-     do {
+     ascnd_out = (dim_out == 1 || x_dbl_out[1] >= x_dbl_out[0]);
+     for (nr = 1; nr < dim_out-1; nr++) {
 	  if (ascnd_out != (x_dbl_out[nr+1] >= x_dbl_out[nr])) {
 	       mono_out = FALSE;
 	       break;
 	  }
-     } while (++nr < dim_out-1);
+     }
 /*
  * interpolate
  * special case:
@@ -20,11 +20,16 @@
 .KEYWORDS    error handling
 .LANGUAGE    ANSI C
 .PURPOSE     error handling and display routines
-.COMMENTS    contains NADC_Err_Push, NADC_Err_Clear, NADC_Err_Keep, 
-             NADC_Err_Trace
-             used global variables: nadc_stat and nadc_err_stack
+.COMMENTS    contains NADC_Err_Context, NADC_Err_Init_Context, 
+             NADC_Err_Use_Context, NADC_Err_Push, NADC_Err_Clear, 
+	     NADC_Err_Keep, NADC_Err_Trace
+             the error status and stack are stored in a context, by default
+	     every thread has its own context. The names nadc_stat and 
+	     nadc_err_stack are macros to the context of the calling thread
 .ENVIRONment None
-.VERSION      1.5   30-Jul-2007 added counter to repeated errors, KB
+.VERSION      2.0   17-Oct-2026 error status and messages are kept per thread
+                                or in a context selected by the caller, RvH
+              1.5   30-Jul-2007 added counter to repeated errors, KB
               1.4   25-Feb-2003 added 2 functions to save and restore
                                 error status en messages, RvH
               1.3   25-Feb-2003 did some code clean-up, RvH
@@ -46,12 +51,23 @@
 /*+++++ Local Headers +++++*/
 #include <nadc_common.h>
 
-/*+++++ Global Variables +++++*/
-unsigned char nadc_stat = NADC_STAT_SUCCESS;
-
-NADC_E_t nadc_err_stack;
+/*+++++ Macros +++++*/
+#if defined __STDC_VERSION__ && __STDC_VERSION__ >= 201112L \
+     && !defined __STDC_NO_THREADS__
+#define NADC_THREAD_LOCAL  _Thread_local
+#elif defined __GNUC__
+#define NADC_THREAD_LOCAL  __thread
+#else
+#define NADC_THREAD_LOCAL
+#endif
 
 /*+++++ Local Variables +++++*/
+/* default context of each thread (zero initialized: no errors) */
+static NADC_THREAD_LOCAL NADC_ctx_t nadc_ctx_thread;
+
+/* context selected by NADC_Err_Use_Context, NULL: use the default */
+static NADC_THREAD_LOCAL NADC_ctx_t *nadc_ctx_user = NULL;
+
 static const NADC_mesg_t NADC_Err_mesg[] = {
      {NADC_ERR_NONE,       "No error, issuing a notice or debug message" },
      {NADC_ERR_WARN,       "No error, issuing a warning"},
@@ -112,6 +128,61 @@ short NADCget_err_mesg( NADC_err_t mesg_num )
 }
 
 /*+++++++++++++++++++++++++ Main Program or Function +++++++++++++++*/
+/*+++++++++++++++++++++++++
+.IDENTifer   NADC_Err_Context
+.PURPOSE     obtain the error context of the calling thread
+.INPUT/OUTPUT
+  call as    ctx = NADC_Err_Context();
+
+.RETURNS     pointer to the error context (NADC_ctx_t *), never NULL
+.COMMENTS    used by the macros nadc_stat and nadc_err_stack
+-------------------------*/
+NADC_ctx_t *NADC_Err_Context( void )
+{
+     return (nadc_ctx_user != NULL) ? nadc_ctx_user : &nadc_ctx_thread;
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   NADC_Err_Init_Context
+.PURPOSE     initialize an (explicit) error context
+.INPUT/OUTPUT
+  call as    NADC_Err_Init_Context( ctx );
+    output:  
+           NADC_ctx_t *ctx  :  error context
+
+.RETURNS     nothing
+.COMMENTS    none
+-------------------------*/
+void NADC_Err_Init_Context( NADC_ctx_t *ctx )
+{
+     ctx->stat = NADC_STAT_SUCCESS;
+     ctx->stat_save = NADC_STAT_SUCCESS;
+     ctx->nused_save = 0u;
+     ctx->stack.nused = 0u;
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   NADC_Err_Use_Context
+.PURPOSE     select the error context of the calling thread
+.INPUT/OUTPUT
+  call as    ctx_prev = NADC_Err_Use_Context( ctx );
+     input:  
+           NADC_ctx_t *ctx  :  initialized error context, 
+	                       or NULL for the default context of the thread
+
+.RETURNS     previously selected context (NULL for the default context)
+.COMMENTS    all errors raised by the calling thread are stored in ctx, 
+             until the previous context is restored. A context may only 
+	     be used by one thread at a time
+-------------------------*/
+NADC_ctx_t *NADC_Err_Use_Context( NADC_ctx_t *ctx )
+{
+     NADC_ctx_t *ctx_prev = nadc_ctx_user;
+
+     nadc_ctx_user = ctx;
+     return ctx_prev;
+}
+
 /*+++++++++++++++++++++++++
 .IDENTifer   NADC_Err_Push
 .PURPOSE     push error message on stack
@@ -135,7 +206,9 @@ void NADC_Err_Push( NADC_err_t mesg_num, const char *file_name,
 {
      register unsigned short ns;
 
-     const unsigned short nused = nadc_err_stack.nused;
+     NADC_ctx_t *ctx = NADC_Err_Context();
+
+     const unsigned short nused = ctx->stack.nused;
 /*
  * check number of messages already stored
  */
@@ -144,44 +217,44 @@ void NADC_Err_Push( NADC_err_t mesg_num, const char *file_name,
  * do not repeat messages, instead count them
  */
      for ( ns = 0; ns < nused; ns++ ) {
-	  if ( nadc_err_stack.slots[ns].mesg_num == mesg_num
-	       && nadc_err_stack.slots[ns].line == line
-	       && strncmp( nadc_err_stack.slots[ns].file_name, 
+	  if ( ctx->stack.slots[ns].mesg_num == mesg_num
+	       && ctx->stack.slots[ns].line == line
+	       && strncmp( ctx->stack.slots[ns].file_name, 
 			   file_name, SHORT_STRING_LENGTH ) == 0
-	       && strncmp( nadc_err_stack.slots[ns].desc, 
+	       && strncmp( ctx->stack.slots[ns].desc, 
 			   desc, MAX_STRING_LENGTH ) == 0 ) {
-	       nadc_err_stack.slots[ns].count++;
+	       ctx->stack.slots[ns].count++;
 	       return;
 	  }
      }
 /*
  * store new message
  */
-     nadc_err_stack.slots[nused].mesg_num = mesg_num;
-     (void) nadc_strlcpy( nadc_err_stack.slots[nused].file_name,
+     ctx->stack.slots[nused].mesg_num = mesg_num;
+     (void) nadc_strlcpy( ctx->stack.slots[nused].file_name,
 			  file_name, SHORT_STRING_LENGTH );
-     (void) nadc_strlcpy( nadc_err_stack.slots[nused].func_name,
+     (void) nadc_strlcpy( ctx->stack.slots[nused].func_name,
 			  func_name, SHORT_STRING_LENGTH );
-     nadc_err_stack.slots[nused].line = line;
-     (void) nadc_strlcpy( nadc_err_stack.slots[nused].desc,
+     ctx->stack.slots[nused].line = line;
+     (void) nadc_strlcpy( ctx->stack.slots[nused].desc,
 			  desc, MAX_STRING_LENGTH );
-     nadc_err_stack.nused++;
+     ctx->stack.nused++;
 
      switch ( mesg_num ) {
      case NADC_ERR_NONE:
-	  nadc_stat |= NADC_STAT_INFO;
+	  ctx->stat |= NADC_STAT_INFO;
 	  break;
      case NADC_PDS_DSD_ABSENT:
      case NADC_SDMF_ABSENT:
-	  nadc_stat |= NADC_STAT_ABSENT;
+	  ctx->stat |= NADC_STAT_ABSENT;
 	  break;
      case NADC_ERR_WARN:
      case NADC_WARN_PDS_RD:
      case NADC_ERR_SQL_TWICE:
-	  nadc_stat |= NADC_STAT_WARN;
+	  ctx->stat |= NADC_STAT_WARN;
 	  break;
      default: 
-	  nadc_stat |= NADC_STAT_FATAL;
+	  ctx->stat |= NADC_STAT_FATAL;
 	  break;
      }
 }
@@ -214,15 +287,14 @@ void NADC_Err_Clear( void )
 -------------------------*/
 void NADC_Err_Keep( bool do_save )
 {
-     static unsigned char  nadc_stat_save = NADC_STAT_SUCCESS;
-     static unsigned short nused_save = 0u;
+     NADC_ctx_t *ctx = NADC_Err_Context();
 
      if ( do_save ) {
-	  nadc_stat_save = nadc_stat;
-	  nused_save = nadc_err_stack.nused;
+	  ctx->stat_save = ctx->stat;
+	  ctx->nused_save = ctx->stack.nused;
      } else {
-	  nadc_stat = nadc_stat_save;
-	  nadc_err_stack.nused = nused_save;
+	  ctx->stat = ctx->stat_save;
+	  ctx->stack.nused = ctx->nused_save;
      }
 }
 
@@ -241,19 +313,23 @@ void NADC_Err_Trace( FILE *stream )
 {
      register short nm;
      register unsigned short nr = 0;
-     register unsigned short nused = nadc_err_stack.nused;
 
-     if ( nadc_stat == UCHAR_ZERO ) return;
+     const NADC_ctx_t *ctx = NADC_Err_Context();
+     const NADC_E_t   *err_stack = &ctx->stack;
+
+     register unsigned short nused = err_stack->nused;
+
+     if ( ctx->stat == UCHAR_ZERO ) return;
 
      while ( nused-- > 0u ) {
-	  NADC_err_t mesg_num = nadc_err_stack.slots[nused].mesg_num;
+	  NADC_err_t mesg_num = err_stack->slots[nused].mesg_num;
 
 	  (void) fprintf( stream, "#%03hu: %s line %-d in %s(): %s\n",
 			  nr++, 
-			  nadc_err_stack.slots[nused].file_name, 
-			  nadc_err_stack.slots[nused].line,
-			  nadc_err_stack.slots[nused].func_name,
-			  nadc_err_stack.slots[nused].desc );
+			  err_stack->slots[nused].file_name, 
+			  err_stack->slots[nused].line,
+			  err_stack->slots[nused].func_name,
+			  err_stack->slots[nused].desc );
 
 	  if ( (nm = NADCget_err_mesg( mesg_num )) == (short)(-1) )
 	       (void) fprintf( stream, "message(%-d): %s\n",
@@ -261,9 +337,9 @@ void NADC_Err_Trace( FILE *stream )
 	  else
 	       (void) fprintf( stream, "message(%-d): %s\n",
 			       mesg_num, NADC_Err_mesg[nm].str );
-	  if ( nadc_err_stack.slots[nused].count > 1)
+	  if ( err_stack->slots[nused].count > 1)
 	       (void) fprintf( stream, "message repeated %-d times.\n",
-			       nadc_err_stack.slots[nused].count );
+			       err_stack->slots[nused].count );
      }
      
 }
@@ -23,7 +23,9 @@
 .COMMENTS    contains nadc_set_start_time, nadc_set_stop_time,
                       nadc_get_epoch_time
 .ENVIRONment None
-.VERSION     1.0     14-May-2013   initial release by R. M. van Hees
+.VERSION     1.1     17-Oct-2026   use a monotonic clock, bugfix: the
+                                   nano-seconds were not scaled to seconds, RvH
+             1.0     14-May-2013   initial release by R. M. van Hees
 ------------------------------------------------------------*/
 /*
  * Define _GNU_SOURCE to indicate
@@ -53,12 +55,12 @@
 #ifdef __MACH__
 static uint64_t  t1, t2;
 #else
-static clockid_t clk_id = CLOCK_REALTIME;
+static clockid_t clk_id = CLOCK_MONOTONIC;
 
 static struct timespec t1, t2;
 #endif
 
-static double  conversion_factor = 1.;
+static double  conversion_factor = -1.;
 
 /*+++++++++++++++++++++++++ Static Functions +++++++++++++++++++++++*/
 				/* NONE */
@@ -66,7 +68,7 @@ static double  conversion_factor = 1.;
 /*+++++++++++++++++++++++++ Main Program or Function +++++++++++++++*/
 /*+++++++++++++++++++++++++
 .IDENTifer   nadc_set_start_time
-.PURPOSE     retrieve the time of system-wide clock that measures real time
+.PURPOSE     retrieve the time of a system-wide monotonic clock
 .INPUT/OUTPUT
   call as    nadc_set_start_time();
 .RETURNS     nothing
@@ -79,26 +81,22 @@ void nadc_set_start_time(void)
 	  mach_timebase_info_data_t timebase;
 
 	  mach_timebase_info(&timebase);
-	  conversion_factor = (double)timebase.numer / (double)timebase.denom;
+	  conversion_factor = 1e-9 * timebase.numer / (double) timebase.denom;
      }
      t1 = mach_absolute_time();
 }
 #else
 void nadc_set_start_time(void)
 {
-     if (conversion_factor < 0.) {
-        struct timespec res;
+     if (conversion_factor < 0.) conversion_factor = 1e-9;
 
-        (void) clock_getres(clk_id, &res);
-        conversion_factor = 1. / (1000. * res.tv_nsec);
-     }
      (void) clock_gettime(clk_id, &t1);
 }
 #endif
 
 /*+++++++++++++++++++++++++
 .IDENTifer   nadc_set_stop_time
-.PURPOSE     retrieve the time of system-wide clock that measures real time
+.PURPOSE     retrieve the time of a system-wide monotonic clock
 .INPUT/OUTPUT
   call as    nadc_set_stop_time();
 .RETURNS     nothing
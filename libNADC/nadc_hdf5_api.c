@@ -24,12 +24,13 @@
              EXISTS_HDF5_Attribute, EXISTS_HDF5_Dataset,
              NADC_WR_HDF5_Attribute, 
              NADC_RD_HDF5_Dataset, NADC_WR_HDF5_Dataset, 
-             NADC_WR_HDF5_Vlen_Dataset, 
+             NADC_WR_HDF5_Vlen_Dataset, NADC_HDF5_CHUNK_SIZE,
              Create_HDF5_NADC_FILE
 .RETURNS     nothing: modifies global error status
 .COMMENTS    none
 .ENVIRONment none
-.VERSION      5.1   23-Sep-2003	removed fill_value parameter from
+.VERSION      5.2   17-Oct-2026	added NADC_HDF5_CHUNK_SIZE, RvH
+              5.1   23-Sep-2003	removed fill_value parameter from
                                 NADC_WR_HDF5_Dataset and 
 				NADC_WR_HDF5_Vlen_Dataset, and apply shuffle,
 				to improve compression, RvH
@@ -400,3 +401,127 @@ void NADC_WR_HDF5_Vlen_Dataset( hbool_t compress, hid_t loc_id,
 	       NADC_RETURN_ERROR( NADC_ERR_HDF_DTYPE, name );
      }
 }
+
+/*+++++++++++++++++++++++++
+.IDENTifer   NADC_HDF5_CHUNK_SIZE
+.PURPOSE     obtain chunk size (in records) of an extendible table
+.INPUT/OUTPUT
+  call as    chunk_sz = NADC_HDF5_CHUNK_SIZE( rec_size, num_rows );
+
+     input:
+            size_t  rec_size  :   size of one record (bytes)
+	    hsize_t num_rows  :   expected number of records in the table
+
+.RETURNS     number of records per chunk, at least one (hsize_t)
+.COMMENTS    - a chunk holds 1/8 of the expected table size, but not less
+               than 64 kB and not more than 1 MB; a chunk is never larger
+	       than the expected table
+	     - the parameter "chunk_kb" (option --chunk-kb) overrides the
+	       chunk size, given in kB
+-------------------------*/
+hsize_t NADC_HDF5_CHUNK_SIZE( size_t rec_size, hsize_t num_rows )
+{
+     const hsize_t chunk_min = 64 * 1024;
+     const hsize_t chunk_max = 1024 * 1024;
+     const hsize_t chunk_kb  = nadc_get_param_uint16( "chunk_kb" );
+
+     hsize_t chunk_bytes;
+     hsize_t chunk_sz;
+
+     if ( rec_size == 0 ) return 1;
+
+     if ( chunk_kb > 0 ) {
+	  chunk_sz = (chunk_kb * 1024) / rec_size;
+     } else {
+	  chunk_bytes = (num_rows * rec_size) / 8;
+	  if ( chunk_bytes < chunk_min ) chunk_bytes = chunk_min;
+	  if ( chunk_bytes > chunk_max ) chunk_bytes = chunk_max;
+
+	  chunk_sz = chunk_bytes / rec_size;
+	  if ( num_rows > 0 && chunk_sz > num_rows ) chunk_sz = num_rows;
+     }
+     return (chunk_sz > 0) ? chunk_sz : 1;
+}
+
+/*
+ * benchmark: writes a packet table with records of the size of a
+ * level 0 Auxiliary MDS, in appends of one State, using one record per
+ * chunk and the chunk size of NADC_HDF5_CHUNK_SIZE
+ *
+ * compile code with gcc -O2 -DTEST_PROG -I../include \
+ *    -I/usr/include/hdf5/serial nadc_hdf5_api.c -L. -lnadc \
+ *    -lhdf5_hl -lhdf5
+ */
+#ifdef TEST_PROG
+#include <stdio.h>
+#include <sys/time.h>
+#include <sys/stat.h>
+
+static
+double _BENCH_PTABLE( const char *flname, hsize_t chunk_sz, int compress,
+		      size_t rec_size, unsigned int num_append, 
+		      size_t num_rec, const unsigned char *buff, 
+		      /*@out@*/ off_t *file_size )
+{
+     register unsigned int na;
+
+     struct timeval tv[2];
+     struct stat    st;
+
+     hid_t fid, tid, ptable;
+
+     (void) gettimeofday( tv, NULL );
+     fid = H5Fcreate( flname, H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT );
+     tid = H5Tcreate( H5T_OPAQUE, rec_size );
+     (void) H5Tset_tag( tid, "mds0_aux" );
+     ptable = H5PTcreate_fl( fid, "mds0_aux", tid, chunk_sz, compress );
+     for ( na = 0; na < num_append; na++ )
+	  (void) H5PTappend( ptable, num_rec, buff );
+     (void) H5PTclose( ptable );
+     (void) H5Tclose( tid );
+     (void) H5Fclose( fid );
+     (void) gettimeofday( tv+1, NULL );
+
+     *file_size = (stat( flname, &st ) == 0) ? st.st_size : 0;
+     (void) remove( flname );
+     return (tv[1].tv_sec - tv[0].tv_sec) 
+	  + (tv[1].tv_usec - tv[0].tv_usec) / 1e6;
+}
+
+int main( void )
+{
+     register size_t nb;
+
+     const size_t rec_size = 1659;
+     const size_t num_rec = 160;
+     const unsigned int num_append = 250;
+
+     unsigned char *buff;
+
+     int   compress;
+     off_t sz[2];
+     double tm[2];
+     hsize_t chunk_sz;
+
+     buff = (unsigned char *) malloc( num_rec * rec_size );
+     for ( nb = 0; nb < num_rec * rec_size; nb++ )
+	  buff[nb] = (unsigned char) ((nb % 7 == 0) ? nb : 0);
+
+     chunk_sz = NADC_HDF5_CHUNK_SIZE( rec_size, num_rec );
+     (void) printf( "records of %zu bytes, %u x %zu records\n",
+		    rec_size, num_append, num_rec );
+     for ( compress = -1; compress <= 3; compress += 4 ) {
+	  tm[0] = _BENCH_PTABLE( "bench_chunk.h5", 1, compress, rec_size,
+				 num_append, num_rec, buff, &sz[0] );
+	  tm[1] = _BENCH_PTABLE( "bench_chunk.h5", chunk_sz, compress, 
+				 rec_size, num_append, num_rec, buff, &sz[1] );
+	  (void) printf( "deflate %2d: chunk %4d: %8.3f s %10ld bytes\n",
+			 compress, 1, tm[0], (long) sz[0] );
+	  (void) printf( "deflate %2d: chunk %4llu: %8.3f s %10ld bytes\n",
+			 compress, (unsigned long long) chunk_sz, 
+			 tm[1], (long) sz[1] );
+     }
+     free( buff );
+     return EXIT_SUCCESS;
+}
+#endif /* TEST_PROG */
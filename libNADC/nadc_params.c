@@ -20,20 +20,24 @@
 .KEYWORDS    command-line parameters
 .LANGUAGE    ANSI C
 .PURPOSE     handle command-line parameters and default settings
-.COMMENTS    None
+.COMMENTS    the uint8 parameters are stored in a table indexed by 
+             enum nadc_param_uint8_id, all other lookups by name use a hash
 .ENVIRONment None
-.VERSION     1.0     25-May-2019   initial release
+.VERSION     1.2     17-Oct-2026   hash tables created with pthread_once, RvH
+             1.1     17-Oct-2026   O(1) parameter lookup, RvH
+             1.0     25-May-2019   initial release
 ------------------------------------------------------------*/
 /*
- * Define _ISOC99_SOURCE to indicate
- * that this is a ISO C99 program
+ * Define _POSIX_C_SOURCE to indicate
+ * that this is a POSIX.1-2001 program (pthread_once)
  */
-#define  _ISOC99_SOURCE
+#define  _POSIX_C_SOURCE 200112L
 
 /*+++++ System headers +++++*/
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <pthread.h>
 
 #include <hdf5.h>
 
@@ -56,42 +60,46 @@
 static struct param_uint8_rec {
      const char  *name;
      unsigned char value;
-} params_uint8[] = {
-     {"flag_check", PARAM_UNSET},
-     {"flag_show", PARAM_UNSET},
-     {"flag_version", PARAM_UNSET},
-     {"flag_silent", PARAM_UNSET},
-     {"flag_verbose", PARAM_UNSET},
-     {"flag_geoloc", PARAM_UNSET},
-     {"flag_geomnmx", PARAM_SET},
-     {"flag_period", PARAM_UNSET},
-     {"flag_pselect", PARAM_UNSET},
-     {"flag_wave", PARAM_UNSET},
-     {"qcheck", PARAM_SET},
-     {"write_pds", PARAM_UNSET},
-     {"write_ascii", PARAM_UNSET},
-     {"write_meta", PARAM_UNSET},
-     {"write_hdf5", PARAM_UNSET},
-     {"flag_deflate", PARAM_UNSET},
-     {"write_sql", PARAM_UNSET},
-     {"flag_sql_remove", PARAM_UNSET},
-     {"flag_sql_replace", PARAM_UNSET},
-     {"write_lv1c", PARAM_UNSET},
-     {"write_ads", PARAM_SET},
-     {"write_gads", PARAM_SET},
-     {"write_aux0", PARAM_SET},    // SCIA LV1
-     {"write_pmd0", PARAM_SET},    // SCIA LV1
-     {"write_aux", PARAM_SET},     // SCIA LV0
-     {"write_det", PARAM_SET},     // SCIA LV0
-     {"write_pmd", PARAM_SET},     // SCIA LV0 & LV1
-     {"write_limb", PARAM_SET},    // SCIA LV1
-     {"write_moni", PARAM_SET},    // SCIA LV1
-     {"write_nadir", PARAM_SET},   // SCIA LV1
-     {"write_occ", PARAM_SET},     // SCIA LV1
-     {"write_polV", PARAM_SET},    // SCIA LV1
-     {"write_bias", PARAM_SET},    // SCIA LV2
-     {"write_cld", PARAM_SET},     // SCIA LV2
-     {"write_doas", PARAM_SET}     // SCIA LV2
+} params_uint8[NUM_PARAM_UINT8] = {
+     [PARAM_FLAG_CHECK] = {"flag_check", PARAM_UNSET},
+     [PARAM_FLAG_SHOW] = {"flag_show", PARAM_UNSET},
+     [PARAM_FLAG_VERSION] = {"flag_version", PARAM_UNSET},
+     [PARAM_FLAG_SILENT] = {"flag_silent", PARAM_UNSET},
+     [PARAM_FLAG_VERBOSE] = {"flag_verbose", PARAM_UNSET},
+     [PARAM_FLAG_GEOLOC] = {"flag_geoloc", PARAM_UNSET},
+     [PARAM_FLAG_GEOMNMX] = {"flag_geomnmx", PARAM_SET},
+     [PARAM_FLAG_PERIOD] = {"flag_period", PARAM_UNSET},
+     [PARAM_FLAG_PSELECT] = {"flag_pselect", PARAM_UNSET},
+     [PARAM_FLAG_WAVE] = {"flag_wave", PARAM_UNSET},
+     [PARAM_FLAG_MMAP] = {"flag_mmap", PARAM_UNSET},               // SCIA LV0
+     [PARAM_FLAG_FAST_GEO] = {"flag_fast_geo", PARAM_UNSET},       // SCIA LV1
+     [PARAM_FLAG_CAL_FUSED] = {"flag_cal_fused", PARAM_UNSET},     // SCIA LV1
+     [PARAM_FLAG_CAL_SPEC] = {"flag_cal_spec", PARAM_UNSET},       // SCIA LV1
+     [PARAM_QCHECK] = {"qcheck", PARAM_SET},
+     [PARAM_WRITE_PDS] = {"write_pds", PARAM_UNSET},
+     [PARAM_WRITE_ASCII] = {"write_ascii", PARAM_UNSET},
+     [PARAM_WRITE_META] = {"write_meta", PARAM_UNSET},
+     [PARAM_WRITE_HDF5] = {"write_hdf5", PARAM_UNSET},
+     [PARAM_FLAG_DEFLATE] = {"flag_deflate", PARAM_UNSET},
+     [PARAM_WRITE_SQL] = {"write_sql", PARAM_UNSET},
+     [PARAM_FLAG_SQL_REMOVE] = {"flag_sql_remove", PARAM_UNSET},
+     [PARAM_FLAG_SQL_REPLACE] = {"flag_sql_replace", PARAM_UNSET},
+     [PARAM_WRITE_LV1C] = {"write_lv1c", PARAM_UNSET},
+     [PARAM_WRITE_ADS] = {"write_ads", PARAM_SET},
+     [PARAM_WRITE_GADS] = {"write_gads", PARAM_SET},
+     [PARAM_WRITE_AUX0] = {"write_aux0", PARAM_SET},               // SCIA LV1
+     [PARAM_WRITE_PMD0] = {"write_pmd0", PARAM_SET},               // SCIA LV1
+     [PARAM_WRITE_AUX] = {"write_aux", PARAM_SET},                 // SCIA LV0
+     [PARAM_WRITE_DET] = {"write_det", PARAM_SET},                 // SCIA LV0
+     [PARAM_WRITE_PMD] = {"write_pmd", PARAM_SET},                 // SCIA LV0 & LV1
+     [PARAM_WRITE_LIMB] = {"write_limb", PARAM_SET},               // SCIA LV1
+     [PARAM_WRITE_MONI] = {"write_moni", PARAM_SET},               // SCIA LV1
+     [PARAM_WRITE_NADIR] = {"write_nadir", PARAM_SET},             // SCIA LV1
+     [PARAM_WRITE_OCC] = {"write_occ", PARAM_SET},                 // SCIA LV1
+     [PARAM_WRITE_POLV] = {"write_polV", PARAM_SET},               // SCIA LV1
+     [PARAM_WRITE_BIAS] = {"write_bias", PARAM_SET},               // SCIA LV2
+     [PARAM_WRITE_CLD] = {"write_cld", PARAM_SET},                 // SCIA LV2
+     [PARAM_WRITE_DOAS] = {"write_doas", PARAM_SET}                // SCIA LV2
 };
 
 static struct param_uint16_rec {
@@ -103,7 +111,9 @@ static struct param_uint16_rec {
      {"calib_limb", 0x0U},
      {"calib_moon", 0x0U},
      {"calib_sun", 0x0U},
-     {"calib_pmd", 0x0U}
+     {"calib_pmd", 0x0U},
+     {"num_threads", 0x0U},         // SCIA LV1
+     {"chunk_kb", 0x0U}             // HDF5 output
 };
 
 static struct param_uint32_rec {
@@ -142,6 +152,136 @@ static struct param_string_rec {
      {"outfile", NULL}
 };
 
+/*+++++++++++++++++++++++++ Static Functions +++++++++++++++++++++++*/
+/*
+ * the string API uses a small open-addressing hash table per parameter 
+ * table, it holds (index + 1) of the parameter record, or zero for an 
+ * empty slot. All tables are created once, at the first lookup by name,
+ * guarded by pthread_once because lookups may come from several threads
+ */
+#define PARAM_HASH_SIZE   64u                  /* power of 2 */
+
+struct param_hash {
+     unsigned char slot[PARAM_HASH_SIZE];
+};
+
+static struct param_hash hash_uint8  = {{0}};
+static struct param_hash hash_uint16 = {{0}};
+static struct param_hash hash_uint32 = {{0}};
+static struct param_hash hash_hid    = {{0}};
+static struct param_hash hash_range  = {{0}};
+static struct param_hash hash_string = {{0}};
+
+static pthread_once_t hash_once = PTHREAD_ONCE_INIT;
+
+/* 32-bit FNV-1a hash of a parameter name */
+static inline
+unsigned int _PARAM_HASH(const char *name)
+{
+     register unsigned int hval = 2166136261u;
+
+     while (*name != '\0') {
+	  hval ^= (unsigned char) *name++;
+	  hval *= 16777619u;
+     }
+     return hval & (PARAM_HASH_SIZE - 1);
+}
+
+#define REC_NAME(table, rec_size, ii)					\
+     (*(const char * const *)((const char *) (table) + (ii) * (rec_size)))
+
+/* fill the hash table of one parameter table */
+static
+void _PARAM_HASH_FILL(struct param_hash *hash, const void *table, 
+		      size_t rec_size, size_t nkeys)
+{
+     register unsigned int hval;
+     register size_t       ii;
+
+     for (ii = 0; ii < nkeys; ii++) {
+	  hval = _PARAM_HASH(REC_NAME(table, rec_size, ii));
+	  while (hash->slot[hval] != 0)
+	       hval = (hval + 1) & (PARAM_HASH_SIZE - 1);
+	  hash->slot[hval] = (unsigned char) (ii + 1);
+     }
+}
+
+#define PARAM_HASH_FILL(type)						\
+     _PARAM_HASH_FILL(&hash_##type, params_##type, sizeof(params_##type[0]), \
+		      sizeof params_##type / sizeof(params_##type[0]))
+
+/* create the hash tables of all parameter tables, called via pthread_once */
+static
+void _PARAM_HASH_INIT(void)
+{
+     PARAM_HASH_FILL(uint8);
+     PARAM_HASH_FILL(uint16);
+     PARAM_HASH_FILL(uint32);
+     PARAM_HASH_FILL(hid);
+     PARAM_HASH_FILL(range);
+     PARAM_HASH_FILL(string);
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   _PARAM_INDEX
+.PURPOSE     find index of a parameter in a parameter table
+.INPUT/OUTPUT
+  call as   indx = _PARAM_INDEX(hash, table, rec_size, param_name);
+     input:  
+            struct param_hash *hash : hash table of the parameter table
+            void   *table    :  parameter table, the first member of each 
+	                        record should be its name
+	    size_t rec_size  :  size of one record
+	    char *param_name :  name of parameter
+
+.RETURNS     index of parameter record, negative when not found
+.COMMENTS    static function
+-------------------------*/
+static
+int _PARAM_INDEX(const struct param_hash *hash, const void *table, 
+		 size_t rec_size, const char *param_name)
+{
+     register unsigned int hval;
+     register size_t       ii;
+
+     (void) pthread_once(&hash_once, _PARAM_HASH_INIT);
+
+     hval = _PARAM_HASH(param_name);
+     while ((ii = hash->slot[hval]) != 0) {
+	  if (strcmp(REC_NAME(table, rec_size, ii-1), param_name) == 0)
+	       return (int) ii - 1;
+	  hval = (hval + 1) & (PARAM_HASH_SIZE - 1);
+     }
+     return -1;
+}
+
+#define PARAM_INDEX(type, param_name)					\
+     _PARAM_INDEX(&hash_##type, params_##type, sizeof(params_##type[0]), \
+		  param_name)
+
+#ifdef TEST_PROG
+/*
+ * the lookup as it was implemented before: linear search with strcmp,
+ * nadc_get_param_uint8_id uses it when test_linear_lookup is set
+ */
+static bool test_linear_lookup = FALSE;
+
+static
+unsigned char _GET_PARAM_UINT8_LINEAR(const char *param_name)
+{
+     register size_t ii = 0;
+     
+     const size_t nkeys = sizeof params_uint8 / sizeof(struct param_uint8_rec);
+
+     do {
+	  if (strcmp(params_uint8[ii].name, param_name) == 0)
+	       return params_uint8[ii].value;
+     } while (++ii < nkeys);
+
+     return (unsigned char) ~0x0U;
+}
+#endif /* TEST_PROG */
+
 /*+++++++++++++++++++++++++ Exported Functions +++++++++++++++++++++*/
 /*+++++++++++++++++++++++++
 .IDENTifer   nadc_set_param
@@ -157,139 +297,113 @@ static struct param_string_rec {
 -------------------------*/
 int nadc_set_param_uint8(const char *param_name, const unsigned char value)
 {
-     register size_t ii = 0;
+     const int ii = PARAM_INDEX(uint8, param_name);
 
-     const size_t nkeys = sizeof params_uint8 / sizeof(struct param_uint8_rec);
+     if (ii < 0) {
+	  NADC_ERROR(NADC_ERR_FATAL, "unknown parameter name");
+	  return -1;
+     }
+     params_uint8[ii].value = value;
+     return 0;
+}
 
-     do {
-	  if (strcmp(params_uint8[ii].name, param_name) == 0) {
-	       params_uint8[ii].value = value;
-	       return 0;
-	  }
-     } while (++ii < nkeys);
-     
-     NADC_ERROR(NADC_ERR_FATAL, "unknown parameter name");
-     return -1;
+int nadc_set_param_uint8_id(enum nadc_param_uint8_id param_id, 
+			    const unsigned char value)
+{
+     if ((unsigned int) param_id >= NUM_PARAM_UINT8) {
+	  NADC_ERROR(NADC_ERR_FATAL, "unknown parameter identifier");
+	  return -1;
+     }
+     params_uint8[param_id].value = value;
+     return 0;
 }
 
 int nadc_set_param_uint16(const char *param_name, const unsigned short value)
 {
-     register size_t ii = 0;
-
-     const size_t nkeys = sizeof params_uint16 / sizeof(struct param_uint16_rec);
+     const int ii = PARAM_INDEX(uint16, param_name);
 
-     do {
-	  if (strcmp(params_uint16[ii].name, param_name) == 0) {
-	       params_uint16[ii].value = value;
-	       return 0;
-	  }
-     } while (++ii < nkeys);
-     
-     NADC_ERROR(NADC_ERR_FATAL, "unknown parameter name");
-     return -1;
+     if (ii < 0) {
+	  NADC_ERROR(NADC_ERR_FATAL, "unknown parameter name");
+	  return -1;
+     }
+     params_uint16[ii].value = value;
+     return 0;
 }
 
 int nadc_set_param_uint32(const char *param_name, const unsigned int value)
 {
-     register size_t ii = 0;
-
-     const size_t nkeys = sizeof params_uint32 / sizeof(struct param_uint32_rec);
+     const int ii = PARAM_INDEX(uint32, param_name);
 
-     do {
-	  if (strcmp(params_uint32[ii].name, param_name) == 0) {
-	       params_uint32[ii].value = value;
-	       return 0;
-	  }
-     } while (++ii < nkeys);
-     
-     NADC_ERROR(NADC_ERR_FATAL, "unknown parameter name");
-     return -1;
+     if (ii < 0) {
+	  NADC_ERROR(NADC_ERR_FATAL, "unknown parameter name");
+	  return -1;
+     }
+     params_uint32[ii].value = value;
+     return 0;
 }
 
 int nadc_set_param_hid(const char *param_name, const hid_t value)
 {
-     register size_t ii = 0;
-
-     const size_t nkeys = sizeof params_hid / sizeof(struct param_hid_rec);
+     const int ii = PARAM_INDEX(hid, param_name);
 
-     do {
-	  if (strcmp(params_hid[ii].name, param_name) == 0) {
-	       params_hid[ii].value = value;
-	       return 0;
-	  }
-     } while (++ii < nkeys);
-     
-     NADC_ERROR(NADC_ERR_FATAL, "unknown parameter name");
-     return -1;
+     if (ii < 0) {
+	  NADC_ERROR(NADC_ERR_FATAL, "unknown parameter name");
+	  return -1;
+     }
+     params_hid[ii].value = value;
+     return 0;
 }
 
 int nadc_set_param_range(const char *param_name, const float *value)
 {
-     register size_t ii = 0;
-
-     const size_t nkeys = sizeof params_range / sizeof(struct param_range_rec);
+     const int ii = PARAM_INDEX(range, param_name);
 
-     do {
-	  if (strcmp(params_range[ii].name, param_name) == 0) {
-	       params_range[ii].value[0] = value[0];
-	       params_range[ii].value[1] = value[1];
-	       return 0;
-	  }
-     } while (++ii < nkeys);
-     
-     NADC_ERROR(NADC_ERR_FATAL, "unknown parameter name");
-     return -1;
+     if (ii < 0) {
+	  NADC_ERROR(NADC_ERR_FATAL, "unknown parameter name");
+	  return -1;
+     }
+     params_range[ii].value[0] = value[0];
+     params_range[ii].value[1] = value[1];
+     return 0;
 }
 
 int nadc_set_param_string(const char *param_name, const char *str)
 {
-     register size_t ii = 0;
+     const int ii = PARAM_INDEX(string, param_name);
 
-     const size_t nkeys = \
-	  sizeof params_string / sizeof(struct param_string_rec);
+     if (ii < 0) 
+	  NADC_GOTO_ERROR(NADC_ERR_FATAL, "unknown parameter name");
 
-     do {
-	  if (strcmp(params_string[ii].name, param_name) == 0) {
-	       if (params_string[ii].str != NULL)
-		    free(params_string[ii].str);
-	       params_string[ii].str = (char *) malloc(strlen(str) + 1);
-	       if (params_string[ii].str == NULL)
-		    NADC_GOTO_ERROR(NADC_ERR_ALLOC, "params_string[ii].str");
-	       (void) strcpy(params_string[ii].str, str);
-	       return 0;
-	  }
-     } while (++ii < nkeys);
-     
-     NADC_ERROR(NADC_ERR_FATAL, "unknown parameter name");
+     if (params_string[ii].str != NULL)
+	  free(params_string[ii].str);
+     params_string[ii].str = (char *) malloc(strlen(str) + 1);
+     if (params_string[ii].str == NULL)
+	  NADC_GOTO_ERROR(NADC_ERR_ALLOC, "params_string[ii].str");
+     (void) strcpy(params_string[ii].str, str);
+     return 0;
 done:
      return -1;
 }
 
 int nadc_set_param_add_ext(const char *param_name, const char *ext)
 {
-     register size_t ii = 0;
+     size_t length;
 
-     const size_t nkeys = \
-	  sizeof params_string / sizeof(struct param_string_rec);
+     const int ii = PARAM_INDEX(string, param_name);
 
-     do {
-	  if (strcmp(params_string[ii].name, param_name) == 0) {
-	       size_t length;
-	       
-	       if (params_string[ii].str == NULL)
-		    NADC_GOTO_ERROR(NADC_ERR_FATAL, "parameter not defined");
-
-	       length = strlen(params_string[ii].str) + strlen(ext);
-	       params_string[ii].str = (char *) realloc(
-		    params_string[ii].str, length + 1);
-	       if (params_string[ii].str == NULL)
-		    NADC_GOTO_ERROR(NADC_ERR_ALLOC, "params_string[ii].str");
-	       (void) strcat(params_string[ii].str, ext);
-	       return 0;
-	  }
-     } while (++ii < nkeys);
-     
-     NADC_ERROR(NADC_ERR_FATAL, "unknown parameter name");
+     if (ii < 0) 
+	  NADC_GOTO_ERROR(NADC_ERR_FATAL, "unknown parameter name");
+
+     if (params_string[ii].str == NULL)
+	  NADC_GOTO_ERROR(NADC_ERR_FATAL, "parameter not defined");
+
+     length = strlen(params_string[ii].str) + strlen(ext);
+     params_string[ii].str = (char *) realloc(
+	  params_string[ii].str, length + 1);
+     if (params_string[ii].str == NULL)
+	  NADC_GOTO_ERROR(NADC_ERR_ALLOC, "params_string[ii].str");
+     (void) strcat(params_string[ii].str, ext);
+     return 0;
 done:
      return -1;
 }
@@ -305,109 +419,93 @@ done:
 	 void *value       :  value of parameter
 
 .RETURNS     zero if successful; otherwise returns a negative value
-.COMMENTS    none
+.COMMENTS    the uint8 parameters can also be obtained by their identifier,
+             using nadc_get_param_uint8_id(), which is preferred in loops
 -------------------------*/
 unsigned char nadc_get_param_uint8(const char *param_name)
 {
-     register size_t ii = 0;
-     
-     const size_t nkeys = sizeof params_uint8 / sizeof(struct param_uint8_rec);
+     const int ii = PARAM_INDEX(uint8, param_name);
 
-     do {
-	  if (strcmp(params_uint8[ii].name, param_name) == 0)
-	       return params_uint8[ii].value;
-     } while (++ii < nkeys);
+     if (ii < 0) {
+	  NADC_ERROR(NADC_ERR_FATAL, "unknown parameter name");
+	  return (unsigned char) ~0x0U;
+     }
+     return params_uint8[ii].value;
+}
 
-     NADC_ERROR(NADC_ERR_FATAL, "unknown parameter name");
-     return (unsigned char) ~0x0U;
+unsigned char nadc_get_param_uint8_id(enum nadc_param_uint8_id param_id)
+{
+     if ((unsigned int) param_id >= NUM_PARAM_UINT8) {
+	  NADC_ERROR(NADC_ERR_FATAL, "unknown parameter identifier");
+	  return (unsigned char) ~0x0U;
+     }
+#ifdef TEST_PROG
+     if (test_linear_lookup)
+	  return _GET_PARAM_UINT8_LINEAR(params_uint8[param_id].name);
+#endif
+     return params_uint8[param_id].value;
 }
 
 unsigned short nadc_get_param_uint16(const char *param_name)
 {
-     register size_t ii = 0;
-     
-     const size_t nkeys = sizeof params_uint16 / sizeof(struct param_uint16_rec);
+     const int ii = PARAM_INDEX(uint16, param_name);
 
-     do {
-	  if (strcmp(params_uint16[ii].name, param_name) == 0)
-	       return params_uint16[ii].value;
-     } while (++ii < nkeys);
-
-     NADC_ERROR(NADC_ERR_FATAL, "unknown parameter name");
-     return (unsigned short) ~0x0U;
+     if (ii < 0) {
+	  NADC_ERROR(NADC_ERR_FATAL, "unknown parameter name");
+	  return (unsigned short) ~0x0U;
+     }
+     return params_uint16[ii].value;
 }
 
 unsigned int nadc_get_param_uint32(const char *param_name)
 {
-     register size_t ii = 0;
-     
-     const size_t nkeys = sizeof params_uint32 / sizeof(struct param_uint32_rec);
+     const int ii = PARAM_INDEX(uint32, param_name);
 
-     do {
-	  if (strcmp(params_uint32[ii].name, param_name) == 0)
-	       return params_uint32[ii].value;
-     } while (++ii < nkeys);
-
-     NADC_ERROR(NADC_ERR_FATAL, "unknown parameter name");
-     return ~0x0U;
+     if (ii < 0) {
+	  NADC_ERROR(NADC_ERR_FATAL, "unknown parameter name");
+	  return ~0x0U;
+     }
+     return params_uint32[ii].value;
 }
 
 hid_t nadc_get_param_hid(const char *param_name)
 {
-     register size_t ii = 0;
-     
-     const size_t nkeys = sizeof params_hid / sizeof(struct param_hid_rec);
+     const int ii = PARAM_INDEX(hid, param_name);
 
-     do {
-	  if (strcmp(params_hid[ii].name, param_name) == 0)
-	       return params_hid[ii].value;
-     } while (++ii < nkeys);
-
-     NADC_ERROR(NADC_ERR_FATAL, "unknown parameter name");
-     return -1;
+     if (ii < 0) {
+	  NADC_ERROR(NADC_ERR_FATAL, "unknown parameter name");
+	  return -1;
+     }
+     return params_hid[ii].value;
 }
 
 void nadc_get_param_range(const char *param_name, float *buff)
 {
-     register size_t ii = 0;
-     
-     const size_t nkeys = sizeof params_range / sizeof(struct param_range_rec);
+     const int ii = PARAM_INDEX(range, param_name);
 
-     do {
-	  if (strcmp(params_range[ii].name, param_name) == 0) {
-	       (void) memcpy(buff, params_range[ii].value, 2 * ENVI_FLOAT);
-	       return;
-	  }
-     } while (++ii < nkeys);
+     if (ii < 0)
+	  NADC_RETURN_ERROR(NADC_ERR_FATAL, "unknown parameter name");
 
-     NADC_RETURN_ERROR(NADC_ERR_FATAL, "unknown parameter name");
+     (void) memcpy(buff, params_range[ii].value, 2 * ENVI_FLOAT);
 }
 
 char * nadc_get_param_string(const char *param_name)
 {
-     register size_t ii = 0;
-
      char *str = NULL;
 
-     const size_t nkeys = \
-	  sizeof params_string / sizeof(struct param_string_rec);
-
-     do {
-	  if (strcmp(params_string[ii].name, param_name) != 0)
-	       continue;
+     const int ii = PARAM_INDEX(string, param_name);
 
-	  if (params_string[ii].str == NULL)
-	       goto done;
+     if (ii < 0) 
+	  NADC_GOTO_ERROR(NADC_ERR_FATAL, "unknown parameter name");
 
-	  if ((str = (char *) malloc(strlen(params_string[ii].str)+1)) == NULL)
-	       NADC_GOTO_ERROR(NADC_ERR_ALLOC, "str");
-	  (void) strcpy(str, params_string[ii].str);
-	  return str;
-     } while (++ii < nkeys);
+     if (params_string[ii].str == NULL)
+	  goto done;
 
-     NADC_ERROR(NADC_ERR_FATAL, "unknown parameter name");
+     if ((str = (char *) malloc(strlen(params_string[ii].str)+1)) == NULL)
+	  NADC_GOTO_ERROR(NADC_ERR_ALLOC, "str");
+     (void) strcpy(str, params_string[ii].str);
 done:
-     return NULL;
+     return str;
 }
 
 /*--------------------------------------------------*/
@@ -1114,3 +1212,211 @@ void nadc_free_param_string(void)
 	       free(params_string[ii].str);
      } while (++ii < nkeys);
 }   
+
+/*
+ * benchmark of the parameter lookup, compile code with
+ * gcc -Wall -O2 -DTEST_PROG -D_SWAP_TO_LITTLE_ENDIAN -I../include \
+ *     -I/usr/include/hdf5/serial -o nadc_params nadc_params.c nadc_bits.c \
+ *     nadc_error.c nadc_string.c -L../libNADC_SCIA -L. -lnadc_scia -lnadc \
+ *     -lhdf5 -lpthread -lm
+ *
+ * usage: nadc_params [level 0 product]
+ *
+ * - the micro-benchmark mimics the state selection of the level 0 reader
+ *   (SCIA_LV0_SELECT_MDS): per state the parameters write_aux, write_det, 
+ *   write_pmd and qcheck are inspected several times
+ * - with a level 0 product, its states are selected and the Detector MDS 
+ *   are read and decoded (SCIA_LV0_SELECT_MDS, SCIA_LV0_RD_DET), once with
+ *   the linear search and once with the identifier lookup
+ */
+#ifdef TEST_PROG
+#include <time.h>
+
+#define _SCIA_LEVEL_0
+#include <nadc_scia.h>
+
+bool Use_Extern_Alloc = FALSE;
+
+static
+double _DECODE_LV0(FILE *fd, size_t num_state_all, 
+		   const struct mds0_states *states_all, unsigned int num_loop,
+		   /*@out@*/ unsigned long long *num_det_all)
+{
+     register size_t       ns;
+     register unsigned int nl;
+
+     size_t num_state;
+     unsigned short num_det;
+
+     struct mds0_states *states = NULL;
+     struct mds0_det    *det = NULL;
+
+     const clock_t tm_bgn = clock();
+
+     *num_det_all = 0ull;
+     for (nl = 0; nl < num_loop; nl++) {
+	  num_state = SCIA_LV0_SELECT_MDS(num_state_all, states_all, &states);
+	  for (ns = 0; ns < num_state; ns++) {
+	       if (states[ns].num_det == 0) continue;
+
+	       num_det = SCIA_LV0_RD_DET(fd, states[ns].info_det, 
+					 states[ns].num_det, &det);
+	       if (IS_ERR_STAT_FATAL) break;
+	       *num_det_all += num_det;
+	       SCIA_LV0_FREE_MDS_DET(num_det, det);
+	  }
+	  SCIA_LV0_FREE_MDS_INFO(num_state, states);
+	  if (IS_ERR_STAT_FATAL) break;
+     }
+     return (double) (clock() - tm_bgn) / CLOCKS_PER_SEC;
+}
+
+static
+void BENCH_LV0_DECODE(const char *flname)
+{
+     FILE   *fd;
+     size_t num_state_all = 0;
+
+     unsigned int  num_dsd;
+     unsigned long long num_det;
+
+     double tm_linear, tm_enum;
+
+     struct mph_envi    mph;
+     struct dsd_envi    *dsd = NULL;
+     struct mds0_states *states_all = NULL;
+
+     const unsigned int num_loop = 200;
+
+     if ((fd = fopen(flname, "rb")) == NULL)
+	  NADC_RETURN_ERROR(NADC_ERR_FILE, flname);
+
+     ENVI_RD_MPH(fd, &mph);
+     if (IS_ERR_STAT_FATAL || mph.num_dsd == 0)
+	  NADC_GOTO_ERROR(NADC_ERR_PDS_RD, "MPH");
+     dsd = (struct dsd_envi *) malloc((mph.num_dsd-1) * sizeof(struct dsd_envi));
+     if (dsd == NULL) NADC_GOTO_ERROR(NADC_ERR_ALLOC, "dsd");
+     num_dsd = ENVI_RD_DSD(fd, mph, dsd);
+     if (IS_ERR_STAT_FATAL)
+	  NADC_GOTO_ERROR(NADC_ERR_PDS_RD, "DSD");
+     num_state_all = SCIA_LV0_RD_MDS_INFO(fd, num_dsd, dsd, &states_all);
+     if (IS_ERR_STAT_FATAL || num_state_all == 0)
+	  NADC_GOTO_ERROR(NADC_ERR_FILE_RD, "RD_MDS_INFO");
+
+     /* warm-up: file cache and hash tables */
+     (void) _DECODE_LV0(fd, num_state_all, states_all, 1, &num_det);
+
+     test_linear_lookup = TRUE;
+     tm_linear = _DECODE_LV0(fd, num_state_all, states_all, num_loop, 
+			     &num_det);
+     test_linear_lookup = FALSE;
+     tm_enum = _DECODE_LV0(fd, num_state_all, states_all, num_loop, 
+			   &num_det);
+     if (IS_ERR_STAT_FATAL)
+	  NADC_GOTO_ERROR(NADC_ERR_PDS_RD, "MDS_DET");
+
+     (void) printf("level 0 decode (%zu states, %llu DSR):\n", 
+		   num_state_all, num_det / num_loop);
+     (void) printf("linear search: %8.2f ms/product\n", 
+		   1e3 * tm_linear / num_loop);
+     (void) printf("identifier:    %8.2f ms/product\n", 
+		   1e3 * tm_enum / num_loop);
+     if (tm_linear > 0.)
+	  (void) printf("difference:    %8.2f %%\n",
+			100. * (tm_linear - tm_enum) / tm_linear);
+done:
+     SCIA_LV0_FREE_MDS_INFO(num_state_all, states_all);
+     if (dsd != NULL) free(dsd);
+     (void) fclose(fd);
+}
+
+int main(int argc, char *argv[])
+{
+     register size_t ns, nl;
+
+     /* call through pointers, to prevent inlining of the lookups */
+     unsigned char (* volatile get_linear)(const char *) = 
+	  _GET_PARAM_UINT8_LINEAR;
+     unsigned char (* volatile get_hash)(const char *) = 
+	  nadc_get_param_uint8;
+     unsigned char (* volatile get_id)(enum nadc_param_uint8_id) = 
+	  nadc_get_param_uint8_id;
+
+     clock_t tm_bgn;
+     double  tm_linear, tm_hash, tm_enum;
+     unsigned int count;
+
+     /* 40 orbits with (about) 500 states each, 10 lookups per state */
+     const size_t num_state = 20000;
+     const size_t num_loop  = 100;
+     const double num_call  = 10. * num_state * num_loop;
+
+     count = 0;
+     tm_bgn = clock();
+     for (nl = 0; nl < num_loop; nl++) {
+	  for (ns = 0; ns < num_state; ns++) {
+	       count += get_linear("write_aux");
+	       count += get_linear("write_det");
+	       count += get_linear("write_pmd");
+	       count += get_linear("qcheck");
+	       count += get_linear("qcheck");
+	       count += get_linear("write_aux");
+	       count += get_linear("write_det");
+	       count += get_linear("write_pmd");
+	       count += get_linear("flag_period");
+	       count += get_linear("write_doas");
+	  }
+     }
+     tm_linear = (double) (clock() - tm_bgn) / CLOCKS_PER_SEC;
+     (void) printf("linear search: %8.2f ns/call (%u)\n", 
+		   1e9 * tm_linear / num_call, count);
+
+     count = 0;
+     tm_bgn = clock();
+     for (nl = 0; nl < num_loop; nl++) {
+	  for (ns = 0; ns < num_state; ns++) {
+	       count += get_hash("write_aux");
+	       count += get_hash("write_det");
+	       count += get_hash("write_pmd");
+	       count += get_hash("qcheck");
+	       count += get_hash("qcheck");
+	       count += get_hash("write_aux");
+	       count += get_hash("write_det");
+	       count += get_hash("write_pmd");
+	       count += get_hash("flag_period");
+	       count += get_hash("write_doas");
+	  }
+     }
+     tm_hash = (double) (clock() - tm_bgn) / CLOCKS_PER_SEC;
+     (void) printf("hashed name:   %8.2f ns/call (%u)\n", 
+		   1e9 * tm_hash / num_call, count);
+
+     count = 0;
+     tm_bgn = clock();
+     for (nl = 0; nl < num_loop; nl++) {
+	  for (ns = 0; ns < num_state; ns++) {
+	       count += get_id(PARAM_WRITE_AUX);
+	       count += get_id(PARAM_WRITE_DET);
+	       count += get_id(PARAM_WRITE_PMD);
+	       count += get_id(PARAM_QCHECK);
+	       count += get_id(PARAM_QCHECK);
+	       count += get_id(PARAM_WRITE_AUX);
+	       count += get_id(PARAM_WRITE_DET);
+	       count += get_id(PARAM_WRITE_PMD);
+	       count += get_id(PARAM_FLAG_PERIOD);
+	       count += get_id(PARAM_WRITE_DOAS);
+	  }
+     }
+     tm_enum = (double) (clock() - tm_bgn) / CLOCKS_PER_SEC;
+     (void) printf("identifier:    %8.2f ns/call (%u)\n", 
+		   1e9 * tm_enum / num_call, count);
+
+     if (tm_hash > 0. && tm_enum > 0.)
+	  (void) printf("speed-up: hashed %.1fx, identifier %.1fx\n",
+			tm_linear / tm_hash, tm_linear / tm_enum);
+
+     if (argc > 1) BENCH_LV0_DECODE(argv[1]);
+     NADC_Err_Trace(stderr);
+     return IS_ERR_STAT_FATAL ? 1 : 0;
+}
+#endif /* TEST_PROG */
@@ -0,0 +1,486 @@
+/*++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+.COPYRIGHT (c) 2014 - 2026 SRON (R.M.van.Hees@sron.nl)
+
+   This is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License, version 2, as
+   published by the Free Software Foundation.
+
+   The software is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place - Suite 330,
+   Boston, MA  02111-1307, USA.
+
+.IDENTifer   NADC_ROBUST_STATS
+.AUTHOR      R.M. van Hees
+.KEYWORDS    Statistics
+.LANGUAGE    ANSI C
+.PURPOSE     robust estimators: selection, median, MAD and biweight
+.COMMENTS    contains SELECTr_INPLACE, SELECTd_INPLACE, NADC_MEDIAN_MAD,
+             NADC_BIWEIGHT, NADC_BIWEIGHT_BUFF, NADC_BIWEIGHT_MULTI
+             - selection is done in place with quickselect (median of 3),
+	       when the partitions do not shrink fast enough the remaining
+	       range is heap-sorted, thus the worst case is O(n log n)
+	     - all functions accept a scratch buffer of the caller, which
+	       can be re-used for many calls
+.ENVIRONment None
+.VERSION     2.0     17-Oct-2026   scratch buffers, introselect, combined
+                                   median/MAD and batched biweight, RvH
+             1.0     15-Jan-2014   initial release, Richard van Hees
+------------------------------------------------------------*/
+/*
+ * Define _ISOC99_SOURCE to indicat
+ * that this is a ISO C99 program
+ */
+#define  _ISOC99_SOURCE
+
+/*+++++ System headers +++++*/
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+
+/*+++++ Local Headers +++++*/
+#include <nadc_common.h>
+
+/*+++++ Macros +++++*/
+#define FOREVER    for(;;)
+#define SWAP(a,b)  {temp = (a); (a) = (b); (b) = temp;}
+
+/*+++++++++++++++++++++++++ Static Functions +++++++++++++++++++++++*/
+static inline
+unsigned int _SELECT_DEPTH( size_t dim )
+{
+     unsigned int depth = 0;
+
+     while ( (dim >>= 1) > 0 ) depth += 2;
+     return depth + 2;
+}
+
+static
+void _HEAPSORT_r( size_t dim, float *rbuff )
+{
+     register size_t ii, jj, nn;
+     register float  temp;
+
+     for ( nn = dim / 2; nn-- > 0; ) {
+	  temp = rbuff[ii = nn];
+	  while ( (jj = 2 * ii + 1) < dim ) {
+	       if ( jj + 1 < dim && rbuff[jj+1] > rbuff[jj] ) jj++;
+	       if ( ! (rbuff[jj] > temp) ) break;
+	       rbuff[ii] = rbuff[jj];
+	       ii = jj;
+	  }
+	  rbuff[ii] = temp;
+     }
+     for ( nn = dim; nn-- > 1; ) {
+	  temp = rbuff[nn];
+	  rbuff[nn] = rbuff[0];
+	  ii = 0;
+	  while ( (jj = 2 * ii + 1) < nn ) {
+	       if ( jj + 1 < nn && rbuff[jj+1] > rbuff[jj] ) jj++;
+	       if ( ! (rbuff[jj] > temp) ) break;
+	       rbuff[ii] = rbuff[jj];
+	       ii = jj;
+	  }
+	  rbuff[ii] = temp;
+     }
+}
+
+static
+void _HEAPSORT_d( size_t dim, double *dbuff )
+{
+     register size_t ii, jj, nn;
+     register double temp;
+
+     for ( nn = dim / 2; nn-- > 0; ) {
+	  temp = dbuff[ii = nn];
+	  while ( (jj = 2 * ii + 1) < dim ) {
+	       if ( jj + 1 < dim && dbuff[jj+1] > dbuff[jj] ) jj++;
+	       if ( ! (dbuff[jj] > temp) ) break;
+	       dbuff[ii] = dbuff[jj];
+	       ii = jj;
+	  }
+	  dbuff[ii] = temp;
+     }
+     for ( nn = dim; nn-- > 1; ) {
+	  temp = dbuff[nn];
+	  dbuff[nn] = dbuff[0];
+	  ii = 0;
+	  while ( (jj = 2 * ii + 1) < nn ) {
+	       if ( jj + 1 < nn && dbuff[jj+1] > dbuff[jj] ) jj++;
+	       if ( ! (dbuff[jj] > temp) ) break;
+	       dbuff[ii] = dbuff[jj];
+	       ii = jj;
+	  }
+	  dbuff[ii] = temp;
+     }
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   _MEDIAN_INPLACE
+.PURPOSE     sample median of an array, the array is reordered
+.INPUT/OUTPUT
+  call as   val = _MEDIAN_INPLACE( dim, rbuff );
+     input:
+             size_t dim    :    dimension of array (> 1)
+ in/output:
+             float *rbuff  :    pointer to array
+
+.RETURNS     median value (float)
+.COMMENTS    static function
+             for an even number of samples below 100 the mean of the two
+	     central values is returned, else the lower one.
+	     After selection all values beyond the lower median are at
+	     least as large, the upper median is their minimum.
+-------------------------*/
+static
+float _MEDIAN_INPLACE( size_t dim, float *rbuff )
+{
+     register size_t ni;
+
+     float med;
+
+     if ( (dim % 2) == 1 ) return SELECTr_INPLACE( (dim+1)/2, dim, rbuff );
+
+     med = SELECTr_INPLACE( dim/2, dim, rbuff );
+     if ( dim < 100 ) {
+	  register float upper = rbuff[dim/2];
+
+	  for ( ni = dim/2 + 1; ni < dim; ni++ )
+	       if ( rbuff[ni] < upper ) upper = rbuff[ni];
+	  med = (med + upper) / 2;
+     }
+     return med;
+}
+
+/*+++++++++++++++++++++++++ Main Program or Function +++++++++++++++*/
+/*+++++++++++++++++++++++++
+.IDENTifer   SELECTr_INPLACE
+.PURPOSE     return the kk-th smallest value of a float array
+.INPUT/OUTPUT
+  call as   val = SELECTr_INPLACE( kk, dim, rbuff );
+     input:
+             size_t kk     :    index number of the value to return [1..dim]
+             size_t dim    :    dimension of the array
+ in/output:
+             float *rbuff  :    pointer to array, which is reordered
+
+.RETURNS     the kk-th smallest value of the array
+.COMMENTS    same convention for kk as SELECTr, but no copy is made.
+             On return rbuff[kk-1] holds the selected value, all values
+	     before it are not larger and all values after it not smaller
+-------------------------*/
+float SELECTr_INPLACE( const size_t kk, const size_t dim, float *rbuff )
+{
+     register size_t ll, hh;
+     register float  test, temp;
+
+     size_t  low = 0;
+     size_t  high = dim - 1;
+     size_t  kx  = kk - 1;
+
+     unsigned int depth = _SELECT_DEPTH( dim );
+
+     if ( dim == 0 ) return 0.f;
+
+     while ( high > low + 1 ) {
+	  size_t mid = (low + high) / 2;
+
+	  if ( depth-- == 0 ) {
+	       _HEAPSORT_r( high - low + 1, rbuff + low );
+	       return rbuff[kx];
+	  }
+	  SWAP( rbuff[mid], rbuff[low+1] );
+	  if ( rbuff[low] > rbuff[high] ) {
+	       SWAP( rbuff[low], rbuff[high] );
+	  }
+	  if ( rbuff[low+1] > rbuff[high] ) {
+	       SWAP( rbuff[low+1], rbuff[high] );
+	  }
+	  if ( rbuff[low] > rbuff[low+1] ) {
+	       SWAP( rbuff[low], rbuff[low+1] );
+	  }
+	  ll = low + 1;
+	  hh = high;
+	  test = rbuff[ll];
+	  FOREVER {
+	       do ll++; while ( rbuff[ll] < test );
+	       do hh--; while ( rbuff[hh] > test );
+	       if ( hh < ll ) break;
+	       SWAP( rbuff[ll], rbuff[hh] );
+	  }
+	  rbuff[low+1] = rbuff[hh];
+	  rbuff[hh] = test;
+	  if ( hh >= kx ) high = hh - 1;
+	  if ( hh <= kx ) low = ll;
+     }
+     if ( high == low + 1 && rbuff[low] > rbuff[high] )
+	  SWAP( rbuff[low], rbuff[high] );
+     return rbuff[kx];
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   SELECTd_INPLACE
+.PURPOSE     return the kk-th smallest value of a double array
+.INPUT/OUTPUT
+  call as   val = SELECTd_INPLACE( kk, dim, dbuff );
+     input:
+             size_t kk     :    index number of the value to return [1..dim]
+             size_t dim    :    dimension of the array
+ in/output:
+             double *dbuff :    pointer to array, which is reordered
+
+.RETURNS     the kk-th smallest value of the array
+.COMMENTS    see SELECTr_INPLACE
+-------------------------*/
+double SELECTd_INPLACE( const size_t kk, const size_t dim, double *dbuff )
+{
+     register size_t ll, hh;
+     register double test, temp;
+
+     size_t  low = 0;
+     size_t  high = dim - 1;
+     size_t  kx  = kk - 1;
+
+     unsigned int depth = _SELECT_DEPTH( dim );
+
+     if ( dim == 0 ) return 0.;
+
+     while ( high > low + 1 ) {
+	  size_t mid = (low + high) / 2;
+
+	  if ( depth-- == 0 ) {
+	       _HEAPSORT_d( high - low + 1, dbuff + low );
+	       return dbuff[kx];
+	  }
+	  SWAP( dbuff[mid], dbuff[low+1] );
+	  if ( dbuff[low] > dbuff[high] ) {
+	       SWAP( dbuff[low], dbuff[high] );
+	  }
+	  if ( dbuff[low+1] > dbuff[high] ) {
+	       SWAP( dbuff[low+1], dbuff[high] );
+	  }
+	  if ( dbuff[low] > dbuff[low+1] ) {
+	       SWAP( dbuff[low], dbuff[low+1] );
+	  }
+	  ll = low + 1;
+	  hh = high;
+	  test = dbuff[ll];
+	  FOREVER {
+	       do ll++; while ( dbuff[ll] < test );
+	       do hh--; while ( dbuff[hh] > test );
+	       if ( hh < ll ) break;
+	       SWAP( dbuff[ll], dbuff[hh] );
+	  }
+	  dbuff[low+1] = dbuff[hh];
+	  dbuff[hh] = test;
+	  if ( hh >= kx ) high = hh - 1;
+	  if ( hh <= kx ) low = ll;
+     }
+     if ( high == low + 1 && dbuff[low] > dbuff[high] )
+	  SWAP( dbuff[low], dbuff[high] );
+     return dbuff[kx];
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   NADC_MEDIAN_MAD
+.PURPOSE     estimate median and median absolute deviation of an array
+.INPUT/OUTPUT
+  call as   NADC_MEDIAN_MAD( dim, arr, scratch, &median, &mad );
+     input:
+             size_t dim     :    dimension of array
+             float  *arr    :    pointer to array
+ in/output:
+             float *scratch :    work buffer of at least dim elements,
+	                         or NULL (allocated internally)
+    output:
+             float *median  :    median value
+             float *mad     :    median absolute deviation
+	                         (not calculated when NULL)
+
+.RETURNS     nothing, error status passed by global nadc_stat
+.COMMENTS    the deviations are computed in place from the values left
+             in the scratch buffer by the median selection, only one
+	     copy of the input array is made
+-------------------------*/
+void NADC_MEDIAN_MAD( size_t dim, const float *arr, float *scratch,
+		      float *median, float *mad )
+{
+     register size_t ni;
+
+     float *rbuff = scratch;
+
+     *median = 0.f;
+     if ( mad != NULL ) *mad = 0.f;
+     if ( dim == 0 ) return;
+     if ( dim == 1 ) {
+	  *median = arr[0];
+	  return;
+     }
+     if ( rbuff == NULL
+	  && (rbuff = (float *) malloc( dim * sizeof(float) )) == NULL )
+	  NADC_RETURN_ERROR( NADC_ERR_ALLOC, "rbuff" );
+
+     (void) memcpy( rbuff, arr, dim * sizeof(float) );
+     *median = _MEDIAN_INPLACE( dim, rbuff );
+
+     if ( mad != NULL ) {
+	  for ( ni = 0; ni < dim; ni++ )
+	       rbuff[ni] = fabsf( rbuff[ni] - *median );
+	  *mad = _MEDIAN_INPLACE( dim, rbuff );
+     }
+     if ( scratch == NULL ) free( rbuff );
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   NADC_BIWEIGHT_BUFF
+.PURPOSE     estimate biweight location and scale of an array
+.INPUT/OUTPUT
+  call as   outlayers = NADC_BIWEIGHT_BUFF( dim, arr, scratch,
+                                            &median, &scale );
+     input:
+             size_t   dim     :    dimension of array
+             float    *arr    :    pointer to array
+ in/output:
+             float   *scratch :    work buffer of at least dim elements,
+	                           or NULL (allocated internally)
+    output:
+             float    median  :    biweight location estimation
+             float    scale   :    biweight scale  estimation
+                                   (not calculated when NULL)
+
+.RETURNS     number of outlayers  (size_t)
+.COMMENTS    none
+-------------------------*/
+size_t NADC_BIWEIGHT_BUFF( const size_t dim, const float *arr,
+			   float *scratch, float *median, float *scale )
+{
+     register size_t ni;
+     register double dist, uu, wght;
+
+     float  med, mad;
+     float  max_dist_loc, max_dist_scale;
+
+     size_t rejected = 0;
+     double sum1 = 0.;
+     double sum2 = 0.;
+
+     NADC_MEDIAN_MAD( dim, arr, scratch, &med, &mad );
+     *median = med;
+     if ( dim <= 1 || mad < FLT_EPSILON ) {
+	  if ( scale != NULL ) *scale = 0.f;
+	  return 0;
+     }
+     max_dist_loc   = 6 * mad;
+     max_dist_scale = 9 * mad;
+
+     /* calculate one-step biweight location estimator */
+     ni = 0;
+     do {
+	  dist = arr[ni] - med;
+	  uu   = dist / max_dist_loc;
+
+	  if ( (uu *= uu) > 1 ) {
+	       rejected++;
+	  } else {
+	       wght = (1 - uu) * (1 - uu);
+
+	       sum1 += wght * dist;
+	       sum2 += wght;
+	  }
+     } while( ++ni < dim );
+
+     if ( sum2 > DBL_EPSILON )
+	  *median += (float)(sum1 / sum2);
+
+     /* calculate one-step biweight scale estimator */
+     if ( scale != NULL ) {
+	  double sum3 = 0.;
+	  double sum4 = 0.;
+
+	  ni = 0;
+	  do {
+	       dist = arr[ni] - med;
+	       uu   = dist / max_dist_scale;
+
+	       if ( (uu *= uu) > 1 ) continue;
+	       wght = 1 - uu;
+
+	       sum3 += dist * dist * wght * wght * wght * wght;
+	       sum4 += wght * (1 - 5 * uu);
+	  } while( ++ni < dim );
+	  *scale = (float)(sqrt(dim * sum3) / sum4);
+     }
+     return rejected;
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   NADC_BIWEIGHT
+.PURPOSE     estimate biweight location and scale of an array
+.INPUT/OUTPUT
+  call as   outlayers = NADC_BIWEIGHT( dim, arr, &median, &scale );
+     input:
+             size_t   dim    :    dimension of array
+             float    *arr   :    pointer to array
+    output:
+             float    median :    biweight location estimation
+             float    scale  :    biweight scale  estimation
+                                  (not calculated when NULL)
+
+.RETURNS     number of outlayers  (size_t)
+.COMMENTS    see NADC_BIWEIGHT_BUFF
+-------------------------*/
+size_t NADC_BIWEIGHT( const size_t dim, const float *arr,
+		      float *median, float *scale )
+{
+     return NADC_BIWEIGHT_BUFF( dim, arr, NULL, median, scale );
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   NADC_BIWEIGHT_MULTI
+.PURPOSE     biweight location and scale for many pixels at once
+.INPUT/OUTPUT
+  call as   outlayers = NADC_BIWEIGHT_MULTI( dim, num, arr, median, scale );
+     input:
+             size_t   dim    :    number of samples per pixel
+             size_t   num    :    number of pixels
+             float    *arr   :    samples as arr[dim][num], thus the
+	                          samples of one pixel are num apart
+    output:
+             float    *median :   biweight location per pixel [num]
+             float    *scale  :   biweight scale per pixel [num]
+                                  (not calculated when NULL)
+
+.RETURNS     total number of outlayers  (size_t)
+.COMMENTS    the samples of a pixel are gathered in a contiguous buffer,
+             the work buffers are allocated once for all pixels
+-------------------------*/
+size_t NADC_BIWEIGHT_MULTI( const size_t dim, const size_t num,
+			    const float *arr, float *median, float *scale )
+{
+     register size_t nd, np;
+
+     size_t rejected = 0;
+     float  *column;
+
+     if ( dim == 0 || num == 0 ) return 0;
+     if ( (column = (float *) malloc( 2 * dim * sizeof(float) )) == NULL ) {
+	  NADC_ERROR( NADC_ERR_ALLOC, "column" );
+	  return 0;
+     }
+     for ( np = 0; np < num; np++ ) {
+	  for ( nd = 0; nd < dim; nd++ )
+	       column[nd] = arr[nd * num + np];
+
+	  rejected += NADC_BIWEIGHT_BUFF( dim, column, column + dim,
+					  median + np,
+					  (scale == NULL) ? NULL : scale + np );
+     }
+     free( column );
+     return rejected;
+}
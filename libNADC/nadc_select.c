@@ -35,7 +35,9 @@
 	     \hspace*{3ex} "r" \hspace*{2ex} float
 	     \hspace*{3ex} "d" \hspace*{2ex} double
 .ENVIRONment None
-.VERSION     1.4     10-Nov-2013   added function for unsigned char, RvH
+.VERSION     1.5     17-Oct-2026   SELECTr and SELECTd use SELECTx_INPLACE,
+                                   no allocation for small arrays, RvH
+             1.4     10-Nov-2013   added function for unsigned char, RvH
              1.3     29-Sep-2011   little stylistic changes, RvH
 	     1.2     29-Dec-1997   little stylistic changes, RvH
              1.1     01-Dec-1997   Changed dimensions to size_t, RvH
@@ -58,6 +60,9 @@
 #define FOREVER    for(;;)
 #define SWAP(a,b)  {temp = (a); (a) = (b); (b) = temp;}
 
+/* arrays up to this size are copied to the stack by SELECTr and SELECTd */
+#define SELECT_STACK_SIZE  1024
+
 /*
  * here start the code of function SELECTs
  */
@@ -238,55 +243,20 @@ int SELECTi( const size_t kk, const size_t dim, const int *ia )
  */
 float SELECTr( const size_t kk, const size_t dim, const float *ra )
 {
-     register size_t ll, hh;
-     register float  test, temp;
-
-     size_t  low = 1;
-     size_t  high = dim;
-     float   *rbuff;
+     float  temp;
+     float  stack_buff[SELECT_STACK_SIZE];
+     float  *rbuff = stack_buff;
 
      if ( dim == 0 ) return 0.f;
      if ( dim == 1 ) return ra[0];
-     rbuff = (float *) malloc( (dim+1) * sizeof( float ) );
-     rbuff[0] = 0.f;
-     (void) memcpy( rbuff+1, ra, dim * sizeof( float ) );
-
-     FOREVER {
-	  if ( high <= low+1 ) {
-	       if ( high == low+1 && rbuff[low] > rbuff[high] )
-		    SWAP( rbuff[low], rbuff[high] );
-	       break;
-	  } else {
-	       size_t mid = (low + high) / 2;
-
-	       SWAP( rbuff[mid], rbuff[low+1] );
-	       if ( rbuff[low] > rbuff[high] ) {
-		    SWAP( rbuff[low], rbuff[high] );
-	       }
-	       if ( rbuff[low+1] > rbuff[high] ) {
-		    SWAP( rbuff[low+1], rbuff[high] );
-	       }
-	       if ( rbuff[low] > rbuff[low+1] ) {
-		    SWAP( rbuff[low], rbuff[low+1] );
-	       }
-	       ll = low + 1;
-	       hh = high;
-	       test = rbuff[ll];
-	       FOREVER {
-		    do ll++; while ( rbuff[ll] < test );
-		    do hh--; while ( rbuff[hh] > test );
-
-		    if ( hh < ll ) break;
-		    SWAP( rbuff[ll], rbuff[hh] );
-	       }
-	       rbuff[low+1] = rbuff[hh];
-	       rbuff[hh] = test;
-	       if ( hh <= kk ) low = ll;
-	       if ( hh >= kk ) high = hh - 1;
-	  }
+     if ( dim > SELECT_STACK_SIZE
+	  && (rbuff = (float *) malloc( dim * sizeof(float) )) == NULL ) {
+	  NADC_ERROR( NADC_ERR_ALLOC, "rbuff" );
+	  return 0.f;
      }
-     temp = rbuff[kk];
-     free( rbuff );
+     (void) memcpy( rbuff, ra, dim * sizeof(float) );
+     temp = SELECTr_INPLACE( kk, dim, rbuff );
+     if ( rbuff != stack_buff ) free( rbuff );
 
      return temp;
 }
@@ -296,55 +266,20 @@ float SELECTr( const size_t kk, const size_t dim, const float *ra )
  */
 double SELECTd( const size_t kk, const size_t dim, const double *da )
 {
-     register size_t ll, hh;
-     register double test, temp;
-
-     size_t  low = 1;
-     size_t  high = dim;
-     double  *dbuff;
+     double temp;
+     double stack_buff[SELECT_STACK_SIZE];
+     double *dbuff = stack_buff;
 
      if ( dim == 0 ) return 0.;
      if ( dim == 1 ) return da[0];
-     dbuff = (double *) malloc( (dim+1) * sizeof( double ) );
-     dbuff[0] = 0.;
-     (void) memcpy( dbuff+1, da, dim * sizeof( double ) );
-
-     FOREVER {
-	  if ( high <= low+1 ) {
-	       if ( high == low+1 && dbuff[low] > dbuff[high] )
-		    SWAP( dbuff[low], dbuff[high] );
-	       break;
-	  } else {
-	       size_t mid = (low + high) / 2;
-
-	       SWAP( dbuff[mid], dbuff[low+1] );
-	       if ( dbuff[low] > dbuff[high] ) {
-		    SWAP( dbuff[low], dbuff[high] );
-	       }
-	       if ( dbuff[low+1] > dbuff[high] ) {
-		    SWAP( dbuff[low+1], dbuff[high] );
-	       }
-	       if ( dbuff[low] > dbuff[low+1] ) {
-		    SWAP( dbuff[low], dbuff[low+1] );
-	       }
-	       ll = low + 1;
-	       hh = high;
-	       test = dbuff[ll];
-	       FOREVER {
-		    do ll++; while ( dbuff[ll] < test );
-		    do hh--; while ( dbuff[hh] > test );
-
-		    if ( hh < ll ) break;
-		    SWAP( dbuff[ll], dbuff[hh] );
-	       }
-	       dbuff[low+1] = dbuff[hh];
-	       dbuff[hh] = test;
-	       if ( hh <= kk ) low = ll;
-	       if ( hh >= kk ) high = hh - 1;
-	  }
+     if ( dim > SELECT_STACK_SIZE
+	  && (dbuff = (double *) malloc( dim * sizeof(double) )) == NULL ) {
+	  NADC_ERROR( NADC_ERR_ALLOC, "dbuff" );
+	  return 0.;
      }
-     temp = dbuff[kk];
-     free( dbuff );
+     (void) memcpy( dbuff, da, dim * sizeof(double) );
+     temp = SELECTd_INPLACE( kk, dim, dbuff );
+     if ( dbuff != stack_buff ) free( dbuff );
 
      return temp;
 }
@@ -33,7 +33,8 @@
 .RETURNS     number of outlayers  (size_t)
 .COMMENTS    none
 .ENVIRONment None
-.VERSION     1.0     19-Jan-2014   initial release, Richard van Hees
+.VERSION     1.1     17-Oct-2026   use NADC_MEDIAN_MAD, one work buffer, RvH
+             1.0     19-Jan-2014   initial release, Richard van Hees
 -------------------------*/
 /*
  * Define _ISOC99_SOURCE to indicat
@@ -53,115 +54,7 @@
 /*+++++ Macros +++++*/
 #define N_SIGMA   7
 
-#define FOREVER    for(;;)
-#define SWAP(a,b)  {temp = (a); (a) = (b); (b) = temp;}
-
 /*+++++++++++++++++++++++++ Static Functions +++++++++++++++++++++++*/
-/*+++++++++++++++++++++++++
-.IDENTifer   _SELECT
-.PURPOSE     select kk-th smallest value a float array (qsort)
-.INPUT/OUTPUT
-  call as   val = _SELECT( kk, dim, arr );
-     input:  
-             size_t kk     :    location to select
-             size_t dim    :    dimension of the array (see comments)
- in/output:  
-             float *arr    :    pointer to array 
-
-.RETURNS     the kk-th smallest value of a float array
-.COMMENTS    static function
-             input array is modified, it should have dim+1 elements, the first
-             element is ignored.
--------------------------*/
-static inline
-float _SELECT( const size_t kk, const size_t dim, float *rbuff )
-     /*@modifies rbuff@*/
-{
-     register size_t ll, hh;
-     register float  test, temp;
-
-     size_t  low = 1;
-     size_t  high = dim;
-
-     FOREVER {
-	  if ( high > (low + 1) ) {
-	       size_t mid = (low + high) / 2;
-
-	       SWAP( rbuff[mid], rbuff[low+1] );
-	       if ( rbuff[low] > rbuff[high] ) {
-		    SWAP( rbuff[low], rbuff[high] );
-	       }
-	       if ( rbuff[low+1] > rbuff[high] ) {
-		    SWAP( rbuff[low+1], rbuff[high] );
-	       }
-	       if ( rbuff[low] > rbuff[low+1] ) {
-		    SWAP( rbuff[low], rbuff[low+1] );
-	       }
-	       ll = low + 1;
-	       test = rbuff[ll];
-	       hh = high;
-	       FOREVER {
-		    do ll++; while ( rbuff[ll] < test );
-		    do hh--; while ( rbuff[hh] > test );
-		    if ( hh < ll ) break;
-		    SWAP( rbuff[ll], rbuff[hh] );
-	       }
-	       rbuff[low+1] = rbuff[hh];
-	       rbuff[hh] = test;
-	       if ( hh >= kk ) high = hh - 1;
-	       if ( hh <= kk ) low = ll;
-	  } else {
-	       if ( high == (low + 1) && rbuff[low] > rbuff[high] )
-		    SWAP( rbuff[low], rbuff[high] );
-	       return rbuff[kk];
-	  }
-     }
-}
-
-/*+++++++++++++++++++++++++
-.IDENTifer   _getMEDIAN
-.PURPOSE     estimate sample median
-.INPUT/OUTPUT
-  call as   val = _getMEDIAN( dim, arr );
-     input:  
-             size_t dim    :    dimension of array
-             float  *arr   :    pointer to array 
-
-.RETURNS     median value (float)
-.COMMENTS    static function
--------------------------*/
-static inline
-float _getMEDIAN( const size_t dim, const float *arr )
-     /*@globals nadc_stat, nadc_err_stack;@*/
-     /*@modifies nadc_stat, nadc_err_stack@*/
-{
-     float med = 0.f;
-     float *rbuff;
-
-     if ( dim == 0 ) return 0;
-     if ( dim == 1 ) return arr[0];
-
-     /* initialize working buffer */
-     rbuff = (float *) malloc( (dim+1) * sizeof(float) );
-     if ( rbuff == NULL ) NADC_GOTO_ERROR( NADC_ERR_ALLOC, "rbuff" );
-     rbuff[0] = 0;
-     (void) memcpy( rbuff+1, arr, dim * sizeof(float) );
-
-     /* estimate sample median */
-     if ( (dim % 2) == 0 ) {
-	  med = _SELECT( dim/2, dim, rbuff );
-	  if ( dim < 100 ) {
-	       med += _SELECT( 1+dim/2, dim, rbuff );
-	       med /= 2;
-	  }
-     } else
-	  med = _SELECT( (dim+1)/2, dim, rbuff );
-
-     free( rbuff );
-done:
-     return med;
-}
-
 /*+++++++++++++++++++++++++
 .IDENTifer   _getADEV
 .PURPOSE     estimate mean absolute deviation of an array
@@ -236,20 +129,25 @@ size_t NADC_SIGMACLIPPED( const size_t dim, const float *arr,
 {
      register size_t ni;
 
-     const float tmp_median = _getMEDIAN( dim, arr );
-     const float tmp_adev   = _getADEV( dim, arr, tmp_median );
-
-     const float max_dist_adev = N_SIGMA * tmp_adev;
+     float  tmp_median, tmp_adev, max_dist_adev;
 
      size_t num = 0, rejected = 0;
      float  *buff = NULL;
 
-     *mean = tmp_median;
+     *mean = (dim == 1) ? arr[0] : 0.f;
      if ( sdev != NULL ) *sdev = 0.f;
-     if ( dim <= 1 || tmp_adev < FLT_EPSILON ) return 0;
+     if ( dim <= 1 ) return 0;
 
+     /* the work buffer is used for the median and the clipped samples */
      if ( (buff = (float *) malloc( dim * sizeof(float) )) == NULL ) 
           NADC_GOTO_ERROR( NADC_ERR_ALLOC, "buff" );
+
+     NADC_MEDIAN_MAD( dim, arr, buff, &tmp_median, NULL );
+     tmp_adev = _getADEV( dim, arr, tmp_median );
+     max_dist_adev = N_SIGMA * tmp_adev;
+
+     *mean = tmp_median;
+     if ( tmp_adev < FLT_EPSILON ) goto done;
      
      /* calculate sigma-clipped mean and standard deviation */
      ni = 0;
@@ -262,7 +160,7 @@ size_t NADC_SIGMACLIPPED( const size_t dim, const float *arr,
 
      /* calculate mean and standard deviation */
      _getMoment( num, buff, mean, sdev );
-     free( buff );
 done:
+     if ( buff != NULL ) free( buff );
      return rejected;
 }
@@ -0,0 +1,349 @@
+/*++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+.COPYRIGHT (c) 2026 SRON (R.M.van.Hees@sron.nl)
+
+   This is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License, version 2, as
+   published by the Free Software Foundation.
+
+   The software is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place - Suite 330,
+   Boston, MA  02111-1307, USA.
+
+.IDENTifer   NADC_SWAP_ARRAY
+.AUTHOR      R.M. van Hees
+.KEYWORDS    byte swapping routines
+.LANGUAGE    ANSI C
+.PURPOSE     swap bytes of arrays with 16, 32 or 64 bit values
+.INPUT/OUTPUT
+  call as   NADC_SWAP_ARRAY_16( dest, src, num );
+            NADC_SWAP_ARRAY_32( dest, src, num );
+            NADC_SWAP_ARRAY_64( dest, src, num );
+     input:
+            void   *src   :  array with values to be swapped
+            size_t num    :  number of values in array
+    output:
+            void   *dest  :  array with byte swapped values
+
+.RETURNS     nothing
+.COMMENTS    - dest may be equal to src (in-place), but the arrays may not
+               overlap otherwise; no alignment is required
+             - use NADC_SWAP_ARRAY_16 for (unsigned) short,
+	       NADC_SWAP_ARRAY_32 for (unsigned) int and float, and
+	       NADC_SWAP_ARRAY_64 for double values
+	     - x86_64: SSE2 kernels, AVX2 kernels are selected at run-time
+	       when supported by the CPU; aarch64: NEON kernels;
+	       other platforms use the scalar routines from swap_bytes.h
+.ENVIRONment None
+.VERSION     1.0     17-Oct-2026   Created by R. M. van Hees
+------------------------------------------------------------*/
+/*
+ * Define _ISOC99_SOURCE to indicate
+ * that this is a ISO C99 program
+ */
+#define  _ISOC99_SOURCE
+
+/*+++++ System headers +++++*/
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define _SWAP_X86_64
+#include <immintrin.h>
+#elif defined(__GNUC__) && defined(__aarch64__)
+#define _SWAP_NEON
+#include <arm_neon.h>
+#endif
+
+/*+++++ Local Headers +++++*/
+#include <swap_bytes.h>
+
+/*+++++++++++++++++++++++++ Static Functions +++++++++++++++++++++++*/
+static inline
+void _SWAP_TAIL_16( unsigned char *dest, const unsigned char *src, size_t num )
+{
+     unsigned short ubuff;
+
+     while ( num-- > 0 ) {
+	  (void) memcpy( &ubuff, src, 2 );
+	  ubuff = byte_swap_u16( ubuff );
+	  (void) memcpy( dest, &ubuff, 2 );
+	  src += 2; dest += 2;
+     }
+}
+
+static inline
+void _SWAP_TAIL_32( unsigned char *dest, const unsigned char *src, size_t num )
+{
+     unsigned int ubuff;
+
+     while ( num-- > 0 ) {
+	  (void) memcpy( &ubuff, src, 4 );
+	  ubuff = byte_swap_u32( ubuff );
+	  (void) memcpy( dest, &ubuff, 4 );
+	  src += 4; dest += 4;
+     }
+}
+
+static inline
+void _SWAP_TAIL_64( unsigned char *dest, const unsigned char *src, size_t num )
+{
+     __u64 ubuff;
+
+     while ( num-- > 0 ) {
+	  (void) memcpy( &ubuff, src, 8 );
+	  ubuff = byte_swap_u64( ubuff );
+	  (void) memcpy( dest, &ubuff, 8 );
+	  src += 8; dest += 8;
+     }
+}
+
+#ifdef _SWAP_X86_64
+/*
+ * SSE2 kernels: swap the 16-bit words of a value with shuffles,
+ * next swap the bytes in each word with shifts
+ */
+static inline
+__m128i _SSE2_SWAP_16( __m128i xx )
+{
+     return _mm_or_si128( _mm_slli_epi16( xx, 8 ), _mm_srli_epi16( xx, 8 ) );
+}
+
+static
+size_t _SSE2_SWAP_ARRAY_16( unsigned char *dest, const unsigned char *src,
+			    size_t num )
+{
+     size_t nr = 0;
+
+     for ( ; nr + 8 <= num; nr += 8, src += 16, dest += 16 ) {
+	  __m128i xx = _mm_loadu_si128( (const __m128i *) src );
+	  _mm_storeu_si128( (__m128i *) dest, _SSE2_SWAP_16( xx ) );
+     }
+     return nr;
+}
+
+static
+size_t _SSE2_SWAP_ARRAY_32( unsigned char *dest, const unsigned char *src,
+			    size_t num )
+{
+     size_t nr = 0;
+
+     for ( ; nr + 4 <= num; nr += 4, src += 16, dest += 16 ) {
+	  __m128i xx = _mm_loadu_si128( (const __m128i *) src );
+	  xx = _mm_shufflelo_epi16( xx, _MM_SHUFFLE(2,3,0,1) );
+	  xx = _mm_shufflehi_epi16( xx, _MM_SHUFFLE(2,3,0,1) );
+	  _mm_storeu_si128( (__m128i *) dest, _SSE2_SWAP_16( xx ) );
+     }
+     return nr;
+}
+
+static
+size_t _SSE2_SWAP_ARRAY_64( unsigned char *dest, const unsigned char *src,
+			    size_t num )
+{
+     size_t nr = 0;
+
+     for ( ; nr + 2 <= num; nr += 2, src += 16, dest += 16 ) {
+	  __m128i xx = _mm_loadu_si128( (const __m128i *) src );
+	  xx = _mm_shufflelo_epi16( xx, _MM_SHUFFLE(0,1,2,3) );
+	  xx = _mm_shufflehi_epi16( xx, _MM_SHUFFLE(0,1,2,3) );
+	  _mm_storeu_si128( (__m128i *) dest, _SSE2_SWAP_16( xx ) );
+     }
+     return nr;
+}
+
+/*
+ * AVX2 kernels: one byte shuffle per 32 bytes
+ */
+__attribute__((target("avx2")))
+static
+size_t _AVX2_SWAP_ARRAY( unsigned char *dest, const unsigned char *src,
+			 size_t num_byte, __m256i mask )
+{
+     size_t nb = 0;
+
+     for ( ; nb + 32 <= num_byte; nb += 32 ) {
+	  __m256i yy = _mm256_loadu_si256( (const __m256i *) (src + nb) );
+	  _mm256_storeu_si256( (__m256i *) (dest + nb),
+			       _mm256_shuffle_epi8( yy, mask ) );
+     }
+     return nb;
+}
+
+__attribute__((target("avx2")))
+static
+size_t _AVX2_SWAP_ARRAY_16( unsigned char *dest, const unsigned char *src,
+			    size_t num )
+{
+     const __m256i mask = _mm256_setr_epi8(
+	  1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+	  1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 );
+
+     return _AVX2_SWAP_ARRAY( dest, src, 2 * num, mask ) / 2;
+}
+
+__attribute__((target("avx2")))
+static
+size_t _AVX2_SWAP_ARRAY_32( unsigned char *dest, const unsigned char *src,
+			    size_t num )
+{
+     const __m256i mask = _mm256_setr_epi8(
+	  3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+	  3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 );
+
+     return _AVX2_SWAP_ARRAY( dest, src, 4 * num, mask ) / 4;
+}
+
+__attribute__((target("avx2")))
+static
+size_t _AVX2_SWAP_ARRAY_64( unsigned char *dest, const unsigned char *src,
+			    size_t num )
+{
+     const __m256i mask = _mm256_setr_epi8(
+	  7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+	  7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8 );
+
+     return _AVX2_SWAP_ARRAY( dest, src, 8 * num, mask ) / 8;
+}
+
+static inline
+int _HAS_AVX2( void )
+{
+     return __builtin_cpu_supports( "avx2" );
+}
+#endif /* _SWAP_X86_64 */
+
+#ifdef _SWAP_NEON
+static
+size_t _NEON_SWAP_ARRAY_16( unsigned char *dest, const unsigned char *src,
+			    size_t num )
+{
+     size_t nr = 0;
+
+     for ( ; nr + 8 <= num; nr += 8, src += 16, dest += 16 )
+	  vst1q_u8( dest, vrev16q_u8( vld1q_u8( src ) ) );
+     return nr;
+}
+
+static
+size_t _NEON_SWAP_ARRAY_32( unsigned char *dest, const unsigned char *src,
+			    size_t num )
+{
+     size_t nr = 0;
+
+     for ( ; nr + 4 <= num; nr += 4, src += 16, dest += 16 )
+	  vst1q_u8( dest, vrev32q_u8( vld1q_u8( src ) ) );
+     return nr;
+}
+
+static
+size_t _NEON_SWAP_ARRAY_64( unsigned char *dest, const unsigned char *src,
+			    size_t num )
+{
+     size_t nr = 0;
+
+     for ( ; nr + 2 <= num; nr += 2, src += 16, dest += 16 )
+	  vst1q_u8( dest, vrev64q_u8( vld1q_u8( src ) ) );
+     return nr;
+}
+#endif /* _SWAP_NEON */
+
+/*+++++++++++++++++++++++++ Main Program or Function +++++++++++++++*/
+void NADC_SWAP_ARRAY_16( void *dest, const void *src, size_t num )
+{
+     unsigned char       *cdest = (unsigned char *) dest;
+     const unsigned char *csrc  = (const unsigned char *) src;
+
+     size_t nr = 0;
+
+#if defined(_SWAP_X86_64)
+     if ( _HAS_AVX2() )
+	  nr = _AVX2_SWAP_ARRAY_16( cdest, csrc, num );
+     nr += _SSE2_SWAP_ARRAY_16( cdest + 2 * nr, csrc + 2 * nr, num - nr );
+#elif defined(_SWAP_NEON)
+     nr = _NEON_SWAP_ARRAY_16( cdest, csrc, num );
+#endif
+     _SWAP_TAIL_16( cdest + 2 * nr, csrc + 2 * nr, num - nr );
+}
+
+void NADC_SWAP_ARRAY_32( void *dest, const void *src, size_t num )
+{
+     unsigned char       *cdest = (unsigned char *) dest;
+     const unsigned char *csrc  = (const unsigned char *) src;
+
+     size_t nr = 0;
+
+#if defined(_SWAP_X86_64)
+     if ( _HAS_AVX2() )
+	  nr = _AVX2_SWAP_ARRAY_32( cdest, csrc, num );
+     nr += _SSE2_SWAP_ARRAY_32( cdest + 4 * nr, csrc + 4 * nr, num - nr );
+#elif defined(_SWAP_NEON)
+     nr = _NEON_SWAP_ARRAY_32( cdest, csrc, num );
+#endif
+     _SWAP_TAIL_32( cdest + 4 * nr, csrc + 4 * nr, num - nr );
+}
+
+void NADC_SWAP_ARRAY_64( void *dest, const void *src, size_t num )
+{
+     unsigned char       *cdest = (unsigned char *) dest;
+     const unsigned char *csrc  = (const unsigned char *) src;
+
+     size_t nr = 0;
+
+#if defined(_SWAP_X86_64)
+     if ( _HAS_AVX2() )
+	  nr = _AVX2_SWAP_ARRAY_64( cdest, csrc, num );
+     nr += _SSE2_SWAP_ARRAY_64( cdest + 8 * nr, csrc + 8 * nr, num - nr );
+#elif defined(_SWAP_NEON)
+     nr = _NEON_SWAP_ARRAY_64( cdest, csrc, num );
+#endif
+     _SWAP_TAIL_64( cdest + 8 * nr, csrc + 8 * nr, num - nr );
+}
+
+/*
+ * compile code with gcc -O2 -DTEST_PROG -I../include nadc_swap_array.c
+ */
+#ifdef TEST_PROG
+#include <stdlib.h>
+
+int main( void )
+{
+     const size_t num = 4099;
+
+     register size_t nr;
+
+     unsigned short *u16 = malloc( num * sizeof(short) );
+     unsigned short *r16 = malloc( num * sizeof(short) );
+     unsigned int   *u32 = malloc( num * sizeof(int) );
+     unsigned int   *r32 = malloc( num * sizeof(int) );
+     __u64          *u64 = malloc( num * sizeof(__u64) );
+     __u64          *r64 = malloc( num * sizeof(__u64) );
+
+     int num_err = 0;
+
+     for ( nr = 0; nr < num; nr++ ) {
+	  u16[nr] = (unsigned short) (rand() & 0xffff);
+	  u32[nr] = (unsigned int) rand() ^ ((unsigned int) rand() << 16);
+	  u64[nr] = ((__u64) u32[nr] << 32) ^ (__u64) rand();
+     }
+     /* unaligned, out-of-place and in-place */
+     NADC_SWAP_ARRAY_16( r16, u16, num );
+     NADC_SWAP_ARRAY_32( r32 + 1, u32 + 1, num - 1 );
+     NADC_SWAP_ARRAY_64( r64, u64, num );
+     NADC_SWAP_ARRAY_64( u64 + 3, u64 + 3, num - 3 );
+     for ( nr = 0; nr < num; nr++ ) {
+	  if ( r16[nr] != byte_swap_u16( u16[nr] ) ) num_err++;
+	  if ( nr > 0 && r32[nr] != byte_swap_u32( u32[nr] ) ) num_err++;
+	  if ( nr >= 3 && u64[nr] != r64[nr] ) num_err++;
+     }
+     (void) printf( "number of errors: %d\n", num_err );
+     free( u16 ); free( r16 ); free( u32 ); free( r32 );
+     free( u64 ); free( r64 );
+     return num_err > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+#endif /* TEST_PROG */
@@ -22,7 +22,10 @@
 .PURPOSE     IDL wrapper for reading SCIAMACHY data (general)
 .COMMENTS    None
 .ENVIRONment None
-.VERSION      1.3   25-Sep-2009	added get_scia_quality, RvH
+.VERSION      1.6   17-Oct-2026	CloseFile releases the cached CKD, RvH
+              1.5   17-Oct-2026	CloseFile closes the SDMF databases, RvH
+              1.4   17-Oct-2026	OpenFile sets parameter "infile", RvH
+              1.3   25-Sep-2009	added get_scia_quality, RvH
               1.2   12-Oct-2002	consistently return, in case of error, -1, RvH 
               1.1   02-Jul-2002	added more error checking, RvH
               1.0   15-Jan-2002	Created by R. M. van Hees 
@@ -41,6 +44,7 @@
 /*+++++ Local Headers +++++*/
 #define _SCIA_COMMON
 #include <nadc_idl.h>
+#include <nadc_sdmf.h>
 
 /*+++++ Global Variables +++++*/
 FILE *fd_nadc = NULL;
@@ -67,8 +71,10 @@ int IDL_STDCALL OpenFile(int argc, void *argv[])
 
      if ((fd_nadc = fopen(str_descr[0].s, "r")) == NULL) {
 	  NADC_GOTO_ERROR(NADC_ERR_FILE, strerror(errno));
-     } else
+     } else {
 	  File_Is_Open = TRUE;
+	  (void) nadc_set_param_string("infile", str_descr[0].s);
+     }
 
      return 0;
  done:
@@ -83,6 +89,8 @@ int IDL_STDCALL CloseFile(void)
 	  stat = fclose(fd_nadc);
 	  File_Is_Open = FALSE;
      }
+     SDMF_close_files();
+     SCIA_FREE_H5_CKD_CACHE();
      return stat;
 }
 
@@ -22,7 +22,8 @@
 .PURPOSE     IDL wrapper for reading SCIAMACHY level 0 data
 .COMMENTS    None
 .ENVIRONment None
-.VERSION      1.4   16-Mar-2015	fixed for nadc_tools v2.x, RvH
+.VERSION      1.5   17-Oct-2026	use SCIA_LV0_UNPACK_PIXEL, RvH
+              1.4   16-Mar-2015	fixed for nadc_tools v2.x, RvH
               1.3   12-Oct-2002	consistently return, in case of error, -1, RvH 
               1.2   02-Jul-2002	added more error checking, RvH
               1.1   19-Feb-2002	made program complied with libSCIA, RvH 
@@ -121,30 +122,6 @@ int IDL_STDCALL _SCIA_LV0_RD_MDS_INFO (int argc, void *argv[])
      return -1;
 }
 
-static inline
-void _UNPACK_LV0_PIXEL_DATA(const struct chan_src *pixel,
-			     /*@out@*/ unsigned int *data)
-{
-     register unsigned short np = 0;
-
-     register unsigned char *cpntr = pixel->data;
-
-     if (pixel->co_adding == (unsigned char) 1) {
-          do {
-               *data++ = (unsigned int) cpntr[1]
-                    + ((unsigned int) cpntr[0] << 8);
-               cpntr += 2;
-          } while (++np < pixel->length);
-     } else {
-          do {
-               *data++ = (unsigned int) cpntr[2]
-                    + ((unsigned int) cpntr[1] << 8)
-                    + ((unsigned int) cpntr[0] << 16);
-               cpntr += 3;
-          } while (++np < pixel->length);
-     }
-}
-
 unsigned int IDL_STDCALL _SCIA_LV0_RD_DET (int argc, void *argv[])
 {
      register unsigned short n_ch, n_cl;
@@ -258,8 +235,8 @@ unsigned int IDL_STDCALL _SCIA_LV0_RD_DET (int argc, void *argv[])
 		    det[nr].data_src[n_ch].pixel[n_cl].length =
 			 C_det->data_src[n_ch].pixel[n_cl].length;
 
-		    _UNPACK_LV0_PIXEL_DATA(&C_det->data_src[n_ch].pixel[n_cl],
-					    data+offs);
+		    SCIA_LV0_UNPACK_PIXEL(&C_det->data_src[n_ch].pixel[n_cl],
+					  data+offs);
 		    offs += C_det->data_src[n_ch].pixel[n_cl].length;
 	       }
 	  }
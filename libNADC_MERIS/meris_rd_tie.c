@@ -32,7 +32,8 @@
 .RETURNS     number of data set records read (unsigned int)
 .COMMENTS    None
 .ENVIRONment None
-.VERSION      1.0   09-Oct-2008 created by R. M. van Hees
+.VERSION      1.1   17-Oct-2026 bulk byte-swap of tie-point arrays, RvH
+              1.0   09-Oct-2008 created by R. M. van Hees
 ------------------------------------------------------------*/
 /*
  * Define _POSIX_SOURCE to indicate
@@ -56,28 +57,25 @@
 static
 void Sun2Intel_TIE( struct tie_meris *tie )
 {
-     register unsigned short ni;
+     const size_t num = MERIS_NUM_TIE_POINT;
 
      tie->mjd.days  = byte_swap_32( tie->mjd.days );
      tie->mjd.secnd = byte_swap_u32( tie->mjd.secnd );
      tie->mjd.musec = byte_swap_u32( tie->mjd.musec );
-     for ( ni = 0; ni < MERIS_NUM_TIE_POINT; ni++ ) {
-	  tie->coord[ni].lat      = byte_swap_32( tie->coord[ni].lat );
-	  tie->coord[ni].lon      = byte_swap_32( tie->coord[ni].lon );
-	  tie->dem_altitude[ni]   = byte_swap_32( tie->dem_altitude[ni] );
-	  tie->dem_roughness[ni]  = byte_swap_u32( tie->dem_roughness[ni] );
-	  tie->dem_lat_corr[ni]   = byte_swap_32( tie->dem_lat_corr[ni] );
-	  tie->dem_lon_corr[ni]   = byte_swap_32( tie->dem_lon_corr[ni] );
-	  tie->sun_zen_angle[ni]  = byte_swap_u32( tie->sun_zen_angle[ni] );
-	  tie->sun_azi_angle[ni]  = byte_swap_32( tie->sun_azi_angle[ni] );
-	  tie->view_zen_angle[ni] = byte_swap_u32( tie->view_zen_angle[ni] );
-	  tie->view_azi_angle[ni] = byte_swap_32( tie->view_azi_angle[ni] );
-	  tie->zonal_wind[ni]     = byte_swap_16( tie->zonal_wind[ni] );
-	  tie->merid_wind[ni]     = byte_swap_16( tie->merid_wind[ni] );
-	  tie->atm_press[ni]      = byte_swap_u16( tie->atm_press[ni] );
-	  tie->ozone[ni]          = byte_swap_u16( tie->ozone[ni] );
-	  tie->humidity[ni]       = byte_swap_u16( tie->humidity[ni] );
-     }
+     NADC_SWAP_ARRAY_32( tie->coord, tie->coord, 2 * num );
+     NADC_SWAP_ARRAY_32( tie->dem_altitude, tie->dem_altitude, num );
+     NADC_SWAP_ARRAY_32( tie->dem_roughness, tie->dem_roughness, num );
+     NADC_SWAP_ARRAY_32( tie->dem_lat_corr, tie->dem_lat_corr, num );
+     NADC_SWAP_ARRAY_32( tie->dem_lon_corr, tie->dem_lon_corr, num );
+     NADC_SWAP_ARRAY_32( tie->sun_zen_angle, tie->sun_zen_angle, num );
+     NADC_SWAP_ARRAY_32( tie->sun_azi_angle, tie->sun_azi_angle, num );
+     NADC_SWAP_ARRAY_32( tie->view_zen_angle, tie->view_zen_angle, num );
+     NADC_SWAP_ARRAY_32( tie->view_azi_angle, tie->view_azi_angle, num );
+     NADC_SWAP_ARRAY_16( tie->zonal_wind, tie->zonal_wind, num );
+     NADC_SWAP_ARRAY_16( tie->merid_wind, tie->merid_wind, num );
+     NADC_SWAP_ARRAY_16( tie->atm_press, tie->atm_press, num );
+     NADC_SWAP_ARRAY_16( tie->ozone, tie->ozone, num );
+     NADC_SWAP_ARRAY_16( tie->humidity, tie->humidity, num );
 }
 #endif /* _SWAP_TO_LITTLE_ENDIAN */
 
@@ -32,7 +32,8 @@
 .RETURNS     number of data set records read (unsigned int)
 .COMMENTS    None
 .ENVIRONment None
-.VERSION      1.0   10-Oct-2008 created by R. M. van Hees
+.VERSION      1.1   17-Oct-2026 bulk byte-swap of norm_surf_refl, RvH
+              1.0   10-Oct-2008 created by R. M. van Hees
 ------------------------------------------------------------*/
 /*
  * Define _ISOC99_SOURCE to indicate
@@ -56,15 +57,11 @@
 static
 void Sun2Intel_MDS_13( struct mds_rr2_13_meris *mds_13 )
 {
-     register unsigned short ni = 0;
-
      mds_13->mjd.days = byte_swap_32( mds_13->mjd.days );
      mds_13->mjd.secnd = byte_swap_u32( mds_13->mjd.secnd );
      mds_13->mjd.musec = byte_swap_u32( mds_13->mjd.musec );
-     do {
-	  mds_13->norm_surf_refl[ni] = 
-	       byte_swap_u32( mds_13->norm_surf_refl[ni] );
-     } while ( ++ni < 1121 );
+     NADC_SWAP_ARRAY_16( mds_13->norm_surf_refl, 
+			 mds_13->norm_surf_refl, 1121 );
 }
 #endif /* _SWAP_TO_LITTLE_ENDIAN */
 
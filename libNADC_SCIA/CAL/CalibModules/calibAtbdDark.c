@@ -22,15 +22,22 @@
 .PURPOSE     perform dark current correction on Sciamachy L1b science data
 .INPUT/OUTPUT
   call as   SCIA_ATBD_CAL_DARK( fileParam, state, mds_1c );
+            SCIA_ATBD_CAL_DARK_SPEC( fileParam, state, spec );
+            DarkData = SCIA_ATBD_GET_DARK( fileParam, state, source );
      input:  
              struct file_rec *fileParam : file/calibration parameters
 	     struct state1_scia *state  : structure with States of the product
+	     int source                 : type of observation
  in/output:  
              struct mds1c_scia *mds_1c  : level 1c MDS records
+             struct spec1c_scia *spec   : spectra of one state
 .RETURNS     Nothing, error status passed by global variable ``nadc_stat''
-.COMMENTS    None
+             SCIA_ATBD_GET_DARK: dark parameters of the state, NULL on error
+.COMMENTS    SCIA_ATBD_CAL_DARK_SPEC does not apply the limb dark correction
 .ENVIRONment None
-.VERSION     4.2   14-May-2013 fixed longstanding issue with GADS orbit-phase
+.VERSION     4.4   17-Oct-2026 added SCIA_ATBD_CAL_DARK_SPEC, RvH
+             4.3   17-Oct-2026 added SCIA_ATBD_GET_DARK, RvH
+             4.2   14-May-2013 fixed longstanding issue with GADS orbit-phase
                                interpolation, RvH
              4.1   21-Aug-2009 moved all error functions to include file, RvH
              4.0   22-Jan-2009 combined ATBD and SRON/SDMF implementation
@@ -72,6 +79,9 @@
 /*+++++ Static Variables +++++*/
 static const size_t nr_byte = SCIENCE_PIXELS * sizeof(float);
 
+static struct DarkRec DarkData_Save;
+static struct DarkRec DarkData_State;
+
 /*+++++ Global Variables +++++*/
         /* NONE */
 
@@ -364,19 +374,14 @@ void applyDarkCorr( float intg, const struct DarkRec *DarkData,
 }
 
 /*+++++++++++++++++++++++++ Main Program or Function +++++++++++++++*/
-void SCIA_ATBD_CAL_DARK( const struct file_rec *fileParam,
-			 const struct state1_scia *state,
-			 struct mds1c_scia *mds_1c )
+/*
+ * return the dark parameters of the state (constant and orbit variable 
+ * fraction), NULL on error
+ */
+const struct DarkRec *SCIA_ATBD_GET_DARK( const struct file_rec *fileParam,
+					  const struct state1_scia *state,
+					  int source )
 {
-     register unsigned short num = 0u;     /* counter for number of clusters */
-
-     static struct DarkRec DarkData_Save;
-     struct DarkRec DarkData;
-
-     const int source = (int) mds_1c->type_mds;
-     const bool do_limbdark = 
-	  (source == SCIA_LIMB && 
-	   (fileParam->calibFlag & DO_CORR_LDARK) != UINT_ZERO);
      const bool do_vardark = 
 	((fileParam->calibFlag & (DO_CORR_VDARK|DO_CORR_VSTRAY)) != UINT_ZERO);
 /*
@@ -385,19 +390,41 @@ void SCIA_ATBD_CAL_DARK( const struct file_rec *fileParam,
      if ( fileParam->flagInitFile ) {
 	  readDarkDataADS( fileParam->calibFlag, fileParam->fp, 
 			   fileParam->num_dsd, fileParam->dsd, &DarkData_Save );
-	  if ( IS_ERR_STAT_FATAL )
-	       NADC_RETURN_ERROR( NADC_ERR_PDS_RD, "DARK" );
+	  if ( IS_ERR_STAT_FATAL ) {
+	       NADC_ERROR( NADC_ERR_PDS_RD, "DARK" );
+	       return NULL;
+	  }
      }
-     (void) memcpy( &DarkData, &DarkData_Save, sizeof( struct DarkRec ) );
+     (void) memcpy( &DarkData_State, &DarkData_Save, sizeof( struct DarkRec ) );
      if ( fileParam->flagInitFile || fileParam->flagInitPhase ) {
           if ( do_vardark ) {
 	       addOrbitDarkADS( source, fileParam->calibFlag, fileParam->fp, 
 				fileParam->num_dsd, fileParam->dsd, 
-				state->orbit_phase, &DarkData );
-	       if ( IS_ERR_STAT_FATAL )
-		    NADC_RETURN_ERROR( NADC_ERR_PDS_RD, "OrbitDARK" );
+				state->orbit_phase, &DarkData_State );
+	       if ( IS_ERR_STAT_FATAL ) {
+		    NADC_ERROR( NADC_ERR_PDS_RD, "OrbitDARK" );
+		    return NULL;
+	       }
 	  }
      }
+     return &DarkData_State;
+}
+
+void SCIA_ATBD_CAL_DARK( const struct file_rec *fileParam,
+			 const struct state1_scia *state,
+			 struct mds1c_scia *mds_1c )
+{
+     register unsigned short num = 0u;     /* counter for number of clusters */
+
+     const struct DarkRec *darkData;
+
+     const int source = (int) mds_1c->type_mds;
+     const bool do_limbdark = 
+	  (source == SCIA_LIMB && 
+	   (fileParam->calibFlag & DO_CORR_LDARK) != UINT_ZERO);
+
+     if ( (darkData = SCIA_ATBD_GET_DARK( fileParam, state, source )) == NULL )
+	  NADC_RETURN_ERROR( NADC_ERR_PDS_RD, "DARK" );
 /*
  * do actual dark current correction
  */
@@ -406,7 +433,7 @@ void SCIA_ATBD_CAL_DARK( const struct file_rec *fileParam,
 	       const float electron_bu = 
 		    fileParam->electron_bu[mds_1c->chan_id-1];
 
-	       calcShotNoise( electron_bu, &DarkData, mds_1c );
+	       calcShotNoise( electron_bu, darkData, mds_1c );
 	  }
 	  if ( do_limbdark ) {
 	       applyDarkCorrLimb( mds_1c );
@@ -415,13 +442,92 @@ void SCIA_ATBD_CAL_DARK( const struct file_rec *fileParam,
 	  } else {
 	       const float intg = getCorrIntg( state->Clcon[num] );
 
-	       applyDarkCorr( intg, &DarkData, mds_1c );
+	       applyDarkCorr( intg, darkData, mds_1c );
  	       if ( (fileParam->calibFlag & DO_CALC_ERROR) != UINT_ZERO )
-		    calcDarkError( intg, &DarkData, mds_1c );
+		    calcDarkError( intg, darkData, mds_1c );
 	  }
      } while ( ++mds_1c, ++num < state->num_clus );   
 }
 
+/*
+ * apply the dark current correction on the spectra in a container
+ */
+void SCIA_ATBD_CAL_DARK_SPEC( const struct file_rec *fileParam,
+			      const struct state1_scia *state,
+			      struct spec1c_scia *spec )
+{
+     register unsigned short num, ng, nobs, npix;
+
+     static float analog_grp[SCIENCE_PIXELS];
+     static float noise_grp[SCIENCE_PIXELS];
+     static float dark_grp[SCIENCE_PIXELS];
+     static float dark_err_grp[SCIENCE_PIXELS];
+     static float electron_bu_grp[SCIENCE_PIXELS];
+
+     const struct DarkRec *darkData;
+
+     const bool do_error = 
+	  (fileParam->calibFlag & DO_CALC_ERROR) != UINT_ZERO;
+
+     darkData = SCIA_ATBD_GET_DARK( fileParam, state, (int) spec->type_mds );
+     if ( darkData == NULL )
+	  NADC_RETURN_ERROR( NADC_ERR_PDS_RD, "DARK" );
+
+     for ( ng = 0; ng < spec->num_grp; ng++ ) {
+	  struct spec1c_grp *grp = spec->grp + ng;
+/*
+ * dark parameters of the pixels in this group, cluster by cluster
+ */
+	  for ( num = 0; num < spec->num_clus; num++ ) {
+	       const float intg = getCorrIntg( state->Clcon[num] );
+	       const float electron_bu = 
+		    fileParam->electron_bu[state->Clcon[num].channel-1];
+	       const unsigned short offs = spec->clus_offs[num];
+
+	       unsigned short id;
+
+	       if ( spec->clus_grp[num] != ng ) continue;
+	       id = grp->pixel_ids[offs];
+	       for ( npix = offs; npix < offs + spec->clus_pixels[num]; 
+		     npix++, id++ ) {
+		    register double derror = 
+			 sqrt( (double) grp->coaddf ) 
+			 * darkData->AnalogOffsError[id]
+			 + intg * darkData->DarkCurrentError[id];
+
+		    analog_grp[npix] = grp->coaddf * darkData->AnalogOffs[id];
+		    noise_grp[npix] = grp->coaddf 
+			 * darkData->MeanNoise[id] * darkData->MeanNoise[id];
+		    dark_grp[npix] = 
+			 (float) grp->coaddf * darkData->AnalogOffs[id]
+			 + intg * darkData->DarkCurrent[id];
+		    dark_err_grp[npix] = (float) (derror * derror);
+		    electron_bu_grp[npix] = electron_bu;
+	       }
+	  }
+/*
+ * apply the dark correction, one row of a group at a time
+ */
+	  for ( nobs = 0; nobs < grp->num_obs; nobs++ ) {
+	       float *signal = grp->pixel_val + (size_t) nobs * grp->stride;
+	       float *e_signal = grp->pixel_err + (size_t) nobs * grp->stride;
+
+	       if ( do_error ) {
+		    for ( npix = 0; npix < grp->num_pixels; npix++ ) {
+			 e_signal[npix] = fabsf( signal[npix] - analog_grp[npix] )
+			      / electron_bu_grp[npix] + noise_grp[npix];
+		    }
+	       }
+	       for ( npix = 0; npix < grp->num_pixels; npix++ )
+		    signal[npix] -= dark_grp[npix];
+	       if ( do_error ) {
+		    for ( npix = 0; npix < grp->num_pixels; npix++ )
+			 e_signal[npix] += dark_err_grp[npix];
+	       }
+	  }
+     }
+}
+
 void SCIA_get_AtbdDark( FILE *fp, unsigned int calib_flag, float orbit_phase,
 			/*@out@*/ float *analogOffs, 
 			/*@out@*/ float *darkCurrent, 
@@ -22,16 +22,21 @@
 .PURPOSE     perform ATBD Pixel-to-Pixel Gain correction
 .INPUT/OUTPUT
   call as   SCIA_ATBD_CAL_PPG( fileParam, state, mds_1c );
+            SCIA_ATBD_CAL_PPG_SPEC( fileParam, spec );
+            ppg_fact = SCIA_ATBD_GET_PPG( fileParam );
      input:  
              struct file_rec *fileParam : file/calibration parameters
 	     struct state1_scia *state  : structure with States of the product
  in/output:  
              struct mds1c_scia *mds_1c  : level 1c MDS records
+             struct spec1c_scia *spec   : spectra of one state
 
 .RETURNS     Nothing, error status passed by global variable ``nadc_stat''
 .COMMENTS    None
 .ENVIRONment None
-.VERSION      3.0   04-Jul-2012 seperated ATBD and SDMF implementation, RvH
+.VERSION      3.2   17-Oct-2026 added SCIA_ATBD_CAL_PPG_SPEC, RvH
+              3.1   17-Oct-2026 added SCIA_ATBD_GET_PPG, RvH
+              3.0   04-Jul-2012 seperated ATBD and SDMF implementation, RvH
               2.2   17-Mar-2011 back-ported SDMF v2.4, RvH
               2.0   21-Jan-2009 moved to SDMF v3, RvH
               1.1   05-Sep-2007 apply L1b PPG when no data is available in SDMF
@@ -60,6 +65,7 @@
         /* NONE */
 
 /*+++++ Static Variables +++++*/
+static float ppg_fact[SCIENCE_PIXELS];
 
 /*+++++ Global Variables +++++*/
         /* NONE */
@@ -84,6 +90,31 @@ void SCIA_SET_FIXED_PPG( float *ppg_fact )
 	  NADC_RETURN_ERROR( NADC_ERR_HDF_RD, "ppg" );
 }
 
+/*
+ * Read calibration parameters
+ *  - at first call
+ *  - when a new file was opened
+ */
+static
+void SCIA_ATBD_RD_PPG_FACT( const struct file_rec *fileParam )
+{
+     struct ppg_scia ppg;
+
+     if ( ! fileParam->flagInitFile ) return;
+
+     (void) SCIA_LV1_RD_PPG( fileParam->fp, fileParam->num_dsd, 
+			     fileParam->dsd, &ppg );
+     if ( IS_ERR_STAT_FATAL )
+	  NADC_RETURN_ERROR( NADC_ERR_PDS_RD, "PPG" );
+     (void) memcpy( ppg_fact, ppg.ppg_fact, SCIENCE_PIXELS * sizeof(float) );
+
+     if ( (fileParam->calibFlag & DO_FIXED_PPG) != UINT_ZERO ) {
+	  SCIA_SET_FIXED_PPG( ppg_fact );
+	  if ( IS_ERR_STAT_FATAL )
+	       NADC_RETURN_ERROR( NADC_ERR_FATAL, "PPG_FIXED" );
+     }
+}
+
 /*+++++++++++++++++++++++++ Main Program or Function +++++++++++++++*/
 void SCIA_ATBD_CAL_PPG( const struct file_rec *fileParam,
 			const struct state1_scia *state, 
@@ -93,28 +124,8 @@ void SCIA_ATBD_CAL_PPG( const struct file_rec *fileParam,
 
      register double derror;
 
-     static float ppg_fact[SCIENCE_PIXELS];
-/*
- * Read calibration parameters
- *  - at first call
- *  - when a new file was opened
- */
-     if ( fileParam->flagInitFile ) {
-	  struct ppg_scia ppg;
-
-	  (void) SCIA_LV1_RD_PPG( fileParam->fp, fileParam->num_dsd, 
-				  fileParam->dsd, &ppg );
-	  if ( IS_ERR_STAT_FATAL )
-	       NADC_RETURN_ERROR( NADC_ERR_PDS_RD, "PPG" );
-	  (void) memcpy( ppg_fact, ppg.ppg_fact, 
-			 SCIENCE_PIXELS * sizeof(float) );
-
-	  if ( (fileParam->calibFlag & DO_FIXED_PPG) != UINT_ZERO ) {
-	       SCIA_SET_FIXED_PPG( ppg_fact );
-	       if ( IS_ERR_STAT_FATAL )
-		    NADC_RETURN_ERROR( NADC_ERR_FATAL, "PPG_FIXED" );
-	  }
-     }
+     SCIA_ATBD_RD_PPG_FACT( fileParam );
+     if ( IS_ERR_STAT_FATAL ) return;
 /*
  * apply Pixel-to-Pixel Gain correction
  */
@@ -143,3 +154,61 @@ void SCIA_ATBD_CAL_PPG( const struct file_rec *fileParam,
 	  } while ( ++nobs < mds_1c->num_obs );
      } while ( mds_1c++, ++num < state->num_clus );   
 }
+
+/*
+ * apply Pixel-to-Pixel Gain correction on the spectra in a container
+ */
+void SCIA_ATBD_CAL_PPG_SPEC( const struct file_rec *fileParam,
+			     struct spec1c_scia *spec )
+{
+     register unsigned short ng, nobs, npix;
+
+     static bool  ppg_zero[SCIENCE_PIXELS];
+     static float ppg_grp[SCIENCE_PIXELS];
+
+     const bool do_error = 
+	  (fileParam->calibFlag & DO_CALC_ERROR) != UINT_ZERO;
+
+     SCIA_ATBD_RD_PPG_FACT( fileParam );
+     if ( IS_ERR_STAT_FATAL ) return;
+/*
+ * apply Pixel-to-Pixel Gain correction, one row of a group at a time
+ */
+     for ( ng = 0; ng < spec->num_grp; ng++ ) {
+	  struct spec1c_grp *grp = spec->grp + ng;
+
+	  for ( npix = 0; npix < grp->num_pixels; npix++ ) {
+	       ppg_grp[npix] = ppg_fact[grp->pixel_ids[npix]];
+	       ppg_zero[npix] = fabsf( ppg_grp[npix] ) < 1e-3;
+	  }
+	  for ( nobs = 0; nobs < grp->num_obs; nobs++ ) {
+	       float *signal = grp->pixel_val + (size_t) nobs * grp->stride;
+
+	       if ( do_error ) {
+		    float *e_signal = 
+			 grp->pixel_err + (size_t) nobs * grp->stride;
+
+		    for ( npix = 0; npix < grp->num_pixels; npix++ ) {
+			 register double derror = 
+			      fileParam->ppgError * signal[npix];
+
+			 e_signal[npix] += (float) (derror * derror);
+		    }
+	       }
+	       for ( npix = 0; npix < grp->num_pixels; npix++ ) {
+		    signal[npix] = ppg_zero[npix] ? 
+			 0.f : signal[npix] / ppg_grp[npix];
+	       }
+	  }
+     }
+}
+
+/*
+ * return the PPG factors of the product, NULL on error
+ */
+const float *SCIA_ATBD_GET_PPG( const struct file_rec *fileParam )
+{
+     SCIA_ATBD_RD_PPG_FACT( fileParam );
+     if ( IS_ERR_STAT_FATAL ) return NULL;
+     return ppg_fact;
+}
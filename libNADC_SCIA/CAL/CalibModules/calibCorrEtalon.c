@@ -22,15 +22,20 @@
 .PURPOSE     perform Etalon correction on Sciamachy L1b science data
 .INPUT/OUTPUT
   call as   SCIA_ATBD_CAL_ETALON( fileParam, state, mds_1c );
+            SCIA_ATBD_CAL_ETALON_SPEC( fileParam, spec );
+            etalon = SCIA_ATBD_GET_ETALON( fileParam );
      input:  
              struct file_rec *fileParam : file/calibration parameters
 	     struct state1_scia *state  : structure with States of the product
  in/output:  
              struct mds1c_scia *mds_1c  : level 1c MDS records
+             struct spec1c_scia *spec   : spectra of one state
 .RETURNS     Nothing, error status passed by global variable ``nadc_stat''
 .COMMENTS    None
 .ENVIRONment None
-.VERSION      1.0   06-Jun-2006 initial release by R. M. van Hees
+.VERSION      1.2   17-Oct-2026 added SCIA_ATBD_CAL_ETALON_SPEC, RvH
+              1.1   17-Oct-2026 added SCIA_ATBD_GET_ETALON, RvH
+              1.0   06-Jun-2006 initial release by R. M. van Hees
 ------------------------------------------------------------*/
 /*
  * Define _ISOC99_SOURCE to indicate
@@ -50,13 +55,30 @@
         /* NONE */
 
 /*+++++ Static Variables +++++*/
-        /* NONE */
+static float etalon[SCIENCE_PIXELS];
 
 /*+++++ Global Variables +++++*/
         /* NONE */
 
 /*+++++++++++++++++++++++++ Static Functions +++++++++++++++++++++++*/
-        /* NONE */
+/*
+ * Reread calibration parameters
+ *  - at first call
+ *  - when a new file was opened
+ */
+static
+void SCIA_ATBD_RD_ETALON( const struct file_rec *fileParam )
+{
+     struct ppg_scia ppg;
+
+     if ( ! fileParam->flagInitFile ) return;
+
+     (void) SCIA_LV1_RD_PPG( fileParam->fp, fileParam->num_dsd, 
+			     fileParam->dsd, &ppg );
+     if ( IS_ERR_STAT_FATAL )
+	  NADC_RETURN_ERROR( NADC_ERR_PDS_RD, "PPG" );
+     (void) memcpy( etalon, ppg.etalon_fact, SCIENCE_PIXELS * sizeof(float) );
+}
 
 /*+++++++++++++++++++++++++ Main Program or Function +++++++++++++++*/
 void SCIA_ATBD_CAL_ETALON( const struct file_rec *fileParam,
@@ -65,22 +87,8 @@ void SCIA_ATBD_CAL_ETALON( const struct file_rec *fileParam,
 {
      register unsigned short num = 0u;
 
-     static float etalon[SCIENCE_PIXELS];
-/*
- * Reread calibration parameters
- *  - at first call
- *  - when a new file was opened
- */
-     if ( fileParam->flagInitFile ) {
-	  struct ppg_scia ppg;
-
-	  (void) SCIA_LV1_RD_PPG( fileParam->fp, fileParam->num_dsd, 
-				  fileParam->dsd, &ppg );
-	  if ( IS_ERR_STAT_FATAL )
-	       NADC_RETURN_ERROR( NADC_ERR_PDS_RD, "PPG" );
-	  (void) memcpy( etalon, ppg.etalon_fact, 
-			 SCIENCE_PIXELS * sizeof(float) );
-     }
+     SCIA_ATBD_RD_ETALON( fileParam );
+     if ( IS_ERR_STAT_FATAL ) return;
 /*
  * apply Etalon correction
  */
@@ -104,3 +112,43 @@ void SCIA_ATBD_CAL_ETALON( const struct file_rec *fileParam,
 	  } while ( ++nobs < mds_1c->num_obs );
      } while ( mds_1c++, ++num < state->num_clus );   
 }
+
+/*
+ * apply Etalon correction on the spectra in a container
+ */
+void SCIA_ATBD_CAL_ETALON_SPEC( const struct file_rec *fileParam,
+				struct spec1c_scia *spec )
+{
+     register unsigned short ng, nobs, npix;
+
+     static float etalon_grp[SCIENCE_PIXELS];
+
+     SCIA_ATBD_RD_ETALON( fileParam );
+     if ( IS_ERR_STAT_FATAL ) return;
+/*
+ * apply Etalon correction, one row of a group at a time
+ */
+     for ( ng = 0; ng < spec->num_grp; ng++ ) {
+	  struct spec1c_grp *grp = spec->grp + ng;
+
+	  for ( npix = 0; npix < grp->num_pixels; npix++ )
+	       etalon_grp[npix] = etalon[grp->pixel_ids[npix]];
+
+	  for ( nobs = 0; nobs < grp->num_obs; nobs++ ) {
+	       float *signal = grp->pixel_val + (size_t) nobs * grp->stride;
+
+	       for ( npix = 0; npix < grp->num_pixels; npix++ )
+		    signal[npix] /= etalon_grp[npix];
+	  }
+     }
+}
+
+/*
+ * return the Etalon correction factors of the product, NULL on error
+ */
+const float *SCIA_ATBD_GET_ETALON( const struct file_rec *fileParam )
+{
+     SCIA_ATBD_RD_ETALON( fileParam );
+     if ( IS_ERR_STAT_FATAL ) return NULL;
+     return etalon;
+}
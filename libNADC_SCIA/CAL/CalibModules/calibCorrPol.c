@@ -33,7 +33,8 @@
 .RETURNS     Nothing, error status passed by global variable ``nadc_stat''
 .COMMENTS    None
 .ENVIRONment None
-.VERSION      2.0   02-Sep-2013 fixed memory leak mtx_psplo, RvH
+.VERSION      2.1   17-Oct-2026 one Akima plan per channel for PSP, RvH
+              2.0   02-Sep-2013 fixed memory leak mtx_psplo, RvH
               2.0   05-Nov-2007 nearly complete rewrite, RvH
               1.1   24-Aug-2006 fixed bug the GPF correction, RvH
                                 ToDo: handling invalid GPF values gracefully
@@ -344,8 +345,6 @@ unsigned short Get_PolSensNadir(const struct file_rec *fileParam,
 
      unsigned short num_psp = 0;
 
-     double rbuff[CHANNEL_SIZE];
-
      struct pspn_scia *pspn;
 
      pspn_out[0] = NULL;
@@ -361,24 +360,20 @@ unsigned short Get_PolSensNadir(const struct file_rec *fileParam,
      for (n_ch = 0; n_ch < SCIENCE_CHANNELS; n_ch++) {
 	  if (do_pixelwise[n_ch] == 'f') {
 	       unsigned int offs = n_ch * CHANNEL_SIZE;
+	       struct akima_plan *plan;
 
-	       for (nr = 0; nr < num_psp; nr++) {
-		    (void) memcpy(rbuff, &pspn[nr].mu2[offs],
-				   CHANNEL_SIZE * sizeof(double));
-
-		    FIT_GRID_AKIMA(FLT32_T, FLT64_T, CHANNEL_SIZE,
-				    wvlen.solar+offs, rbuff,
-				    FLT32_T, FLT64_T, CHANNEL_SIZE,
-				    wvlen.science+offs, &pspn[nr].mu2[offs]);
-
-		    (void) memcpy(rbuff, &pspn[nr].mu3[offs],
-				   CHANNEL_SIZE * sizeof(double));
+	       plan = NADC_AKIMA_PLAN(FLT32_T, CHANNEL_SIZE, wvlen.solar+offs,
+				      FLT32_T, CHANNEL_SIZE, wvlen.science+offs);
+	       if (plan == NULL)
+		    NADC_GOTO_ERROR(NADC_ERR_FATAL, "NADC_AKIMA_PLAN");
 
-		    FIT_GRID_AKIMA(FLT32_T, FLT64_T, CHANNEL_SIZE,
-				    wvlen.solar+offs, rbuff,
-				    FLT32_T, FLT64_T, CHANNEL_SIZE,
-				    wvlen.science+offs, &pspn[nr].mu3[offs]);
+	       for (nr = 0; nr < num_psp; nr++) {
+		    NADC_AKIMA_PLAN_EXEC(plan, FLT64_T, &pspn[nr].mu2[offs],
+					 FLT64_T, &pspn[nr].mu2[offs]);
+		    NADC_AKIMA_PLAN_EXEC(plan, FLT64_T, &pspn[nr].mu3[offs],
+					 FLT64_T, &pspn[nr].mu3[offs]);
 	       }
+	       NADC_AKIMA_PLAN_FREE(plan);
 	  }
      }
 /*
@@ -506,8 +501,6 @@ unsigned short Get_PolSensLimb(const struct file_rec *fileParam,
 
      unsigned short num_psp = 0;
 
-     double rbuff[CHANNEL_SIZE];
-
      struct psplo_scia *pspl;
 
      pspl_out[0] = NULL;
@@ -523,24 +516,20 @@ unsigned short Get_PolSensLimb(const struct file_rec *fileParam,
      for (n_ch = 0; n_ch < SCIENCE_CHANNELS; n_ch++) {
 	  if (do_pixelwise[n_ch] == 'f') {
 	       unsigned int offs = n_ch * CHANNEL_SIZE;
+	       struct akima_plan *plan;
 
-	       for (nr = 0; nr < num_psp; nr++) {
-		    (void) memcpy(rbuff, &pspl[nr].mu2[offs],
-				   CHANNEL_SIZE * sizeof(double));
-
-		    FIT_GRID_AKIMA(FLT32_T, FLT64_T, CHANNEL_SIZE,
-				    wvlen.solar+offs, rbuff,
-				    FLT32_T, FLT64_T, CHANNEL_SIZE,
-				    wvlen.science+offs, &pspl[nr].mu2[offs]);
+	       plan = NADC_AKIMA_PLAN(FLT32_T, CHANNEL_SIZE, wvlen.solar+offs,
+				      FLT32_T, CHANNEL_SIZE, wvlen.science+offs);
+	       if (plan == NULL)
+		    NADC_GOTO_ERROR(NADC_ERR_FATAL, "NADC_AKIMA_PLAN");
 
-		    (void) memcpy(rbuff, &pspl[nr].mu3[offs],
-				   CHANNEL_SIZE * sizeof(double));
-
-		    FIT_GRID_AKIMA(FLT32_T, FLT64_T, CHANNEL_SIZE,
-				    wvlen.solar+offs, rbuff,
-				    FLT32_T, FLT64_T, CHANNEL_SIZE,
-				    wvlen.science+offs, &pspl[nr].mu3[offs]);
+	       for (nr = 0; nr < num_psp; nr++) {
+		    NADC_AKIMA_PLAN_EXEC(plan, FLT64_T, &pspl[nr].mu2[offs],
+					 FLT64_T, &pspl[nr].mu2[offs]);
+		    NADC_AKIMA_PLAN_EXEC(plan, FLT64_T, &pspl[nr].mu3[offs],
+					 FLT64_T, &pspl[nr].mu3[offs]);
 	       }
+	       NADC_AKIMA_PLAN_FREE(plan);
 	  }
      }
 /*
@@ -576,8 +565,6 @@ unsigned short Get_PolSensOccul(const struct file_rec *fileParam,
 
      unsigned short num_psp = 0;
 
-     double rbuff[CHANNEL_SIZE];
-
      struct psplo_scia *pspo;
 
      pspo_out[0] = NULL;
@@ -593,24 +580,20 @@ unsigned short Get_PolSensOccul(const struct file_rec *fileParam,
      for (n_ch = 0; n_ch < SCIENCE_CHANNELS; n_ch++) {
 	  if (do_pixelwise[n_ch] == 'f') {
 	       unsigned int offs = n_ch * CHANNEL_SIZE;
+	       struct akima_plan *plan;
 
-	       for (nr = 0; nr < num_psp; nr++) {
-		    (void) memcpy(rbuff, &pspo[nr].mu2[offs],
-				   CHANNEL_SIZE * sizeof(double));
+	       plan = NADC_AKIMA_PLAN(FLT32_T, CHANNEL_SIZE, wvlen.solar+offs,
+				      FLT32_T, CHANNEL_SIZE, wvlen.science+offs);
+	       if (plan == NULL)
+		    NADC_GOTO_ERROR(NADC_ERR_FATAL, "NADC_AKIMA_PLAN");
 
-		    FIT_GRID_AKIMA(FLT32_T, FLT64_T, CHANNEL_SIZE,
-				    wvlen.solar+offs, rbuff,
-				    FLT32_T, FLT64_T, CHANNEL_SIZE,
-				    wvlen.science+offs, &pspo[nr].mu2[offs]);
-
-		    (void) memcpy(rbuff, &pspo[nr].mu3[offs],
-				   CHANNEL_SIZE * sizeof(double));
-
-		    FIT_GRID_AKIMA(FLT32_T, FLT64_T, CHANNEL_SIZE,
-				    wvlen.solar+offs, rbuff,
-				    FLT32_T, FLT64_T, CHANNEL_SIZE,
-				    wvlen.science+offs, &pspo[nr].mu3[offs]);
+	       for (nr = 0; nr < num_psp; nr++) {
+		    NADC_AKIMA_PLAN_EXEC(plan, FLT64_T, &pspo[nr].mu2[offs],
+					 FLT64_T, &pspo[nr].mu2[offs]);
+		    NADC_AKIMA_PLAN_EXEC(plan, FLT64_T, &pspo[nr].mu3[offs],
+					 FLT64_T, &pspo[nr].mu3[offs]);
 	       }
+	       NADC_AKIMA_PLAN_FREE(plan);
 	  }
      }
 /*
@@ -22,7 +22,9 @@
 .PURPOSE     perform Radiance correction on Sciamachy L1b science data
 .COMMENTS    Contains functions SCIA_ATBD_CAL_RAD & SCIA_SMR_CAL_RAD
 .ENVIRONment None
-.VERSION      4.0   11-Sep-2013 replaced SCIA_ATBD_CAL_RAD_DETWIDE and 
+.VERSION      4.2   17-Oct-2026 one Akima plan per channel for RSP, RvH
+              4.1   17-Oct-2026 read RSPD keydata only once per process, RvH
+              4.0   11-Sep-2013 replaced SCIA_ATBD_CAL_RAD_DETWIDE and 
                                 Apply_RadSensLimb_detwide by SCIA_SMR_CAL_RAD
 				fixed several minor bugs, RvH
 	      3.3   02-Feb-2011 fixed round-off errors
@@ -310,8 +312,6 @@ unsigned short Get_RadSensNadir( const struct file_rec *fileParam,
 
      unsigned short num_rsp = 0;
 
-     double rbuff[CHANNEL_SIZE];
-
      struct rspn_scia *rspn;
 
      rspn_out[0] = NULL;
@@ -332,17 +332,20 @@ unsigned short Get_RadSensNadir( const struct file_rec *fileParam,
      for ( n_ch = 0; n_ch < SCIENCE_CHANNELS; n_ch++ ) {
 	  if ( do_pixelwise[n_ch] == 'f' ) {
 	       unsigned short offs = n_ch * CHANNEL_SIZE;
-
-	       for ( nr = 0; nr < num_rsp; nr++ ) {
-		    (void) memcpy( rbuff, &rspn[nr].sensitivity[offs],
-				   CHANNEL_SIZE * sizeof(double) );
-
-		    FIT_GRID_AKIMA( FLT32_T, FLT64_T, CHANNEL_SIZE,
-				    wvlen.solar + offs, rbuff,
-				    FLT32_T, FLT64_T, CHANNEL_SIZE,
-				    wvlen.science + offs,
-				    &rspn[nr].sensitivity[offs] );
-	       }
+	       struct akima_plan *plan;
+
+	       plan = NADC_AKIMA_PLAN( FLT32_T, CHANNEL_SIZE, wvlen.solar + offs,
+				       FLT32_T, CHANNEL_SIZE, 
+				       wvlen.science + offs );
+	       if ( plan == NULL )
+		    NADC_GOTO_ERROR( NADC_ERR_FATAL, "NADC_AKIMA_PLAN" );
+
+	       for ( nr = 0; nr < num_rsp; nr++ )
+		    NADC_AKIMA_PLAN_EXEC( plan, FLT64_T, 
+					  &rspn[nr].sensitivity[offs],
+					  FLT64_T, 
+					  &rspn[nr].sensitivity[offs] );
+	       NADC_AKIMA_PLAN_FREE( plan );
 	  }
      }
 /*
@@ -380,54 +383,49 @@ unsigned short Get_H5_RadSensNadir( bool NDF, const float *wvlen,
 	  obm_s_p[SCIENCE_PIXELS]; 
      double elev_p[SCIENCE_PIXELS], elev_s[SCIENCE_PIXELS];
 
-     struct rspd_key   key;
+     const struct rspd_key *key;
      struct rspn_scia  *rspn;
 /*
  * initialize return values
  */
-     key.elev_p  = NULL;
-     key.elev_s  = NULL;
-     key.el_az_p = NULL;
-     key.el_az_s = NULL;
-     key.brdf_p  = NULL;
-     key.brdf_s  = NULL;
      rspn_out[0] = NULL;
 /*
  * read radiance calibration keydata from HDF5 file (origin Ife)
  */
-     SCIA_RD_H5_RSPD( &key );
+     if ( (key = SCIA_GET_H5_RSPD()) == NULL )
+	  NADC_GOTO_ERROR( NADC_ERR_HDF_RD, "SCIA_GET_H5_RSPD" );
 /*
  * calculate elev_i_alpha0, abs_rad and obm_s_p
  */
-     Calc_RadSensStatic( NDF, wvlen, &key, elev_a0, abs_rad, obm_s_p );
+     Calc_RadSensStatic( NDF, wvlen, key, elev_a0, abs_rad, obm_s_p );
 /*
  * allocate memory for the RSPN records
  */
      rspn = (struct rspn_scia *) 
-	  malloc( key.n_elev * sizeof(struct rspn_scia) );
+	  malloc( key->n_elev * sizeof(struct rspn_scia) );
      if ( rspn == NULL ) NADC_GOTO_ERROR( NADC_ERR_ALLOC, "rspn" );
-     num_rsp = key.n_elev;
+     num_rsp = key->n_elev;
 /*
  * interpolate sensitivities to wavelength grid 
  * also: rearrange data [elev] decreasing
  */
-     offs = key.n_elev;
+     offs = key->n_elev;
      nr = 0;
      do {
 	  --offs;
 	  FIT_GRID_AKIMA( FLT32_T, FLT32_T, 
-			  key.elev_p[offs].n_wl, key.elev_p[offs].wl,
-			  key.elev_p[offs].sensitivity,
+			  key->elev_p[offs].n_wl, key->elev_p[offs].wl,
+			  key->elev_p[offs].sensitivity,
 			  FLT32_T, FLT64_T, 
 			  SCIENCE_PIXELS, wvlen, elev_p );
 
 	  FIT_GRID_AKIMA( FLT32_T, FLT32_T, 
-			  key.elev_s[offs].n_wl, key.elev_s[offs].wl,
-			  key.elev_s[offs].sensitivity,
+			  key->elev_s[offs].n_wl, key->elev_s[offs].wl,
+			  key->elev_s[offs].sensitivity,
 			  FLT32_T, FLT64_T, 
 			  SCIENCE_PIXELS, wvlen, elev_s );
 
-	  rspn[nr].ang_esm = key.elev_p[offs].elevat_angle;
+	  rspn[nr].ang_esm = key->elev_p[offs].elevat_angle;
 	  for ( np = 0; np < SCIENCE_PIXELS; np++ )
 	       rspn[nr].sensitivity[np] = 
 		    (abs_rad[np] 
@@ -441,12 +439,6 @@ unsigned short Get_H5_RadSensNadir( bool NDF, const float *wvlen,
  */
      rspn_out[0] = rspn;
  done:
-     if ( key.elev_p  != NULL ) free( key.elev_p );
-     if ( key.elev_s  != NULL ) free( key.elev_s );
-     if ( key.el_az_p != NULL ) free( key.el_az_p );
-     if ( key.el_az_s != NULL ) free( key.el_az_s );
-     if ( key.brdf_p  != NULL ) free( key.brdf_p );
-     if ( key.brdf_s  != NULL ) free( key.brdf_s );
      return num_rsp;
 }
 
@@ -559,8 +551,6 @@ unsigned short Get_RadSensLimb( const struct file_rec *fileParam,
 
      unsigned short num_rsp = 0;
 
-     double rbuff[CHANNEL_SIZE];
-
      struct rsplo_scia  *rspl;
 
      rspl_out[0] = NULL;
@@ -576,17 +566,20 @@ unsigned short Get_RadSensLimb( const struct file_rec *fileParam,
      for ( n_ch = 0; n_ch < SCIENCE_CHANNELS; n_ch++ ) {
 	  if ( do_pixelwise[n_ch] == 'f' ) {
 	       unsigned short offs = n_ch * CHANNEL_SIZE;
-
-	       for ( nr = 0; nr < num_rsp; nr++ ) {
-		    (void) memcpy( rbuff, &rspl[nr].sensitivity[offs],
-				   CHANNEL_SIZE * sizeof(double) );
-
-		    FIT_GRID_AKIMA( FLT32_T, FLT64_T, CHANNEL_SIZE,
-				    wvlen.solar + offs, rbuff,
-				    FLT32_T, FLT64_T, CHANNEL_SIZE,
-				    wvlen.science + offs,
-				    &rspl[nr].sensitivity[offs] );
-	       }
+	       struct akima_plan *plan;
+
+	       plan = NADC_AKIMA_PLAN( FLT32_T, CHANNEL_SIZE, wvlen.solar + offs,
+				       FLT32_T, CHANNEL_SIZE, 
+				       wvlen.science + offs );
+	       if ( plan == NULL )
+		    NADC_GOTO_ERROR( NADC_ERR_FATAL, "NADC_AKIMA_PLAN" );
+
+	       for ( nr = 0; nr < num_rsp; nr++ )
+		    NADC_AKIMA_PLAN_EXEC( plan, FLT64_T, 
+					  &rspl[nr].sensitivity[offs],
+					  FLT64_T, 
+					  &rspl[nr].sensitivity[offs] );
+	       NADC_AKIMA_PLAN_FREE( plan );
 	  }
      }
 /*
@@ -636,18 +629,20 @@ unsigned short Get_RadSensOccul( const struct file_rec *fileParam,
      for ( n_ch = 0; n_ch < SCIENCE_CHANNELS; n_ch++ ) {
 	  if ( do_pixelwise[n_ch] == 'f' ) {
 	       unsigned short offs = n_ch * CHANNEL_SIZE;
-	       double rbuff[CHANNEL_SIZE];
-
-	       for ( nr = 0; nr < num_rsp; nr++ ) {
-		    (void) memcpy( rbuff, &rspo[nr].sensitivity[offs],
-				   CHANNEL_SIZE * sizeof(double) );
-
-		    FIT_GRID_AKIMA( FLT32_T, FLT64_T, CHANNEL_SIZE,
-				    wvlen.solar + offs, rbuff,
-				    FLT32_T, FLT64_T, CHANNEL_SIZE,
-				    wvlen.science + offs,
-				    &rspo[nr].sensitivity[offs] );
-	       }
+	       struct akima_plan *plan;
+
+	       plan = NADC_AKIMA_PLAN( FLT32_T, CHANNEL_SIZE, wvlen.solar + offs,
+				       FLT32_T, CHANNEL_SIZE, 
+				       wvlen.science + offs );
+	       if ( plan == NULL )
+		    NADC_GOTO_ERROR( NADC_ERR_FATAL, "NADC_AKIMA_PLAN" );
+
+	       for ( nr = 0; nr < num_rsp; nr++ )
+		    NADC_AKIMA_PLAN_EXEC( plan, FLT64_T, 
+					  &rspo[nr].sensitivity[offs],
+					  FLT64_T, 
+					  &rspo[nr].sensitivity[offs] );
+	       NADC_AKIMA_PLAN_FREE( plan );
 	  }
      }
 /*
@@ -687,44 +682,39 @@ unsigned short Get_H5_RadSensLimb( bool NDF, const float *wvlen,
 	  obm_s_p[SCIENCE_PIXELS];
      double el_az_p[SCIENCE_PIXELS], el_az_s[SCIENCE_PIXELS];
 
-     struct rspd_key   key;
+     const struct rspd_key *key;
      struct rsplo_scia *rspl;
 /*
  * initialize return values
  */
-     key.elev_p  = NULL;
-     key.elev_s  = NULL;
-     key.el_az_p = NULL;
-     key.el_az_s = NULL;
-     key.brdf_p  = NULL;
-     key.brdf_s  = NULL;
      rspl_out[0] = NULL;
 /*
  * read radiance calibration keydata from HDF5 file (origin Ife)
  */
-     SCIA_RD_H5_RSPD( &key );
+     if ( (key = SCIA_GET_H5_RSPD()) == NULL )
+	  NADC_GOTO_ERROR( NADC_ERR_HDF_RD, "SCIA_GET_H5_RSPD" );
 /*
  * calculate elev_i_alpha0, abs_rad and obm_s_p
  */
-     Calc_RadSensStatic( NDF, wvlen, &key, elev_a0, abs_rad, obm_s_p );
+     Calc_RadSensStatic( NDF, wvlen, key, elev_a0, abs_rad, obm_s_p );
 /*
  * allocate memory for the RSPL records
  */
-     if ( key.n_el_az == 0 )
+     if ( key->n_el_az == 0 )
 	  NADC_GOTO_ERROR( NADC_ERR_ALLOC, "rspl" );
      rspl = (struct rsplo_scia *) 
-	  malloc( key.n_el_az * sizeof(struct rsplo_scia) );
+	  malloc( key->n_el_az * sizeof(struct rsplo_scia) );
      if ( rspl == NULL ) NADC_GOTO_ERROR( NADC_ERR_ALLOC, "rspl" );
-     num_rsp = key.n_el_az;
+     num_rsp = key->n_el_az;
 /*
  * interpolate sensitivities to wavelength grid 
  * also: rearrange data [zen,azi] -> [azi,zen], both azi,elev decreasing
  */
      n_elev = 1;
-     tmpAzi = key.el_az_p->azimuth_angle;
+     tmpAzi = key->el_az_p->azimuth_angle;
      for ( nr = 1; nr < num_rsp; nr++ )
-	  if ( key.el_az_p[nr].azimuth_angle == tmpAzi ) n_elev++;
-     n_azi = key.n_el_az / n_elev;
+	  if ( key->el_az_p[nr].azimuth_angle == tmpAzi ) n_elev++;
+     n_azi = key->n_el_az / n_elev;
 
      nr = 0;
      do {
@@ -735,19 +725,19 @@ unsigned short Get_H5_RadSensLimb( bool NDF, const float *wvlen,
 	  indx = nr / n_elev  + nrr * n_elev;
 
 	  FIT_GRID_AKIMA( FLT32_T, FLT32_T, 
-			  key.el_az_p[indx].n_wl, key.el_az_p[indx].wl,
-			  key.el_az_p[indx].sensitivity,
+			  key->el_az_p[indx].n_wl, key->el_az_p[indx].wl,
+			  key->el_az_p[indx].sensitivity,
 			  FLT32_T, FLT64_T, 
 			  SCIENCE_PIXELS, wvlen, el_az_p );
 
 	  FIT_GRID_AKIMA( FLT32_T, FLT32_T, 
-			  key.el_az_s[indx].n_wl, key.el_az_s[indx].wl,
-			  key.el_az_s[indx].sensitivity,
+			  key->el_az_s[indx].n_wl, key->el_az_s[indx].wl,
+			  key->el_az_s[indx].sensitivity,
 			  FLT32_T, FLT64_T, 
 			  SCIENCE_PIXELS, wvlen, el_az_s );
 
-	  rspl[nr].ang_esm = key.el_az_p[indx].elevat_angle;
-	  rspl[nr].ang_asm  = key.el_az_p[indx].azimuth_angle;
+	  rspl[nr].ang_esm = key->el_az_p[indx].elevat_angle;
+	  rspl[nr].ang_asm  = key->el_az_p[indx].azimuth_angle;
 	  for ( np = 0; np < SCIENCE_PIXELS; np++ )
 	       rspl[nr].sensitivity[np] = 
 		    (abs_rad[np] * 
@@ -761,12 +751,6 @@ unsigned short Get_H5_RadSensLimb( bool NDF, const float *wvlen,
  */
      rspl_out[0] = rspl;
  done:
-     if ( key.elev_p  != NULL ) free( key.elev_p );
-     if ( key.elev_s  != NULL ) free( key.elev_s );
-     if ( key.el_az_p != NULL ) free( key.el_az_p );
-     if ( key.el_az_s != NULL ) free( key.el_az_s );
-     if ( key.brdf_p  != NULL ) free( key.brdf_p );
-     if ( key.brdf_s  != NULL ) free( key.brdf_s );
      return num_rsp;
 }
 
@@ -800,51 +784,46 @@ unsigned short Get_H5_RadSensMoni( bool NDF, /*@null@*/ const float *wvlen_in,
 	  obm_s_p[SCIENCE_PIXELS], brdf_p[SCIENCE_PIXELS], 
 	  brdf_s[SCIENCE_PIXELS];
 
-     struct rspd_key   key;
+     const struct rspd_key *key;
      struct rsplo_scia *rspm;
 /*
  * initialize return values
  */
-     key.elev_p  = NULL;
-     key.elev_s  = NULL;
-     key.el_az_p = NULL;
-     key.el_az_s = NULL;
-     key.brdf_p  = NULL;
-     key.brdf_s  = NULL;
      rspm_out[0] = NULL;
 /*
  * read radiance calibration keydata from HDF5 file (origin Ife)
  */
-     SCIA_RD_H5_RSPD( &key );
+     if ( (key = SCIA_GET_H5_RSPD()) == NULL )
+	  NADC_GOTO_ERROR( NADC_ERR_HDF_RD, "SCIA_GET_H5_RSPD" );
 /*
  * check wavelength grid
  */
      if ( wvlen_in == NULL )
-	  (void) memcpy( wvlen, key.key_fix.wl, SCIENCE_PIXELS * sizeof(float));
+	  (void) memcpy( wvlen, key->key_fix.wl, SCIENCE_PIXELS * sizeof(float));
      else
 	  (void) memcpy( wvlen, wvlen_in, SCIENCE_PIXELS * sizeof(float) );
 /*
  * calculate elev_i_alpha0, abs_rad and obm_s_p
  */
-     Calc_RadSensStatic( NDF, wvlen, &key, elev_a0, abs_rad, obm_s_p );
+     Calc_RadSensStatic( NDF, wvlen, key, elev_a0, abs_rad, obm_s_p );
 /*
  * allocate memory for the RSPM records
  */
-     if ( key.n_brdf == 0 )
+     if ( key->n_brdf == 0 )
 	  NADC_GOTO_ERROR( NADC_ERR_ALLOC, "rspm" );
      rspm = (struct rsplo_scia *) 
-	  malloc( key.n_brdf * sizeof(struct rsplo_scia) );
+	  malloc( key->n_brdf * sizeof(struct rsplo_scia) );
      if ( rspm == NULL ) NADC_GOTO_ERROR( NADC_ERR_ALLOC, "rspm" );
-     num_rsp = key.n_brdf;
+     num_rsp = key->n_brdf;
 /*
  * interpolate sensitivities to wavelength grid 
  * also: rearrange data [elev,azi] -> [azi,elev], both azi,elev decreasing
  */
      n_elev = 1;
-     tmpAzi = key.brdf_p->asm_angle;
+     tmpAzi = key->brdf_p->asm_angle;
      for ( nr = 1; nr < num_rsp; nr++ )
-	  if ( key.brdf_p[nr].asm_angle == tmpAzi ) n_elev++;
-     n_azi = key.n_brdf / n_elev;
+	  if ( key->brdf_p[nr].asm_angle == tmpAzi ) n_elev++;
+     n_azi = key->n_brdf / n_elev;
 
      offs = n_elev;
      nr = 0;
@@ -856,19 +835,19 @@ unsigned short Get_H5_RadSensMoni( bool NDF, /*@null@*/ const float *wvlen_in,
 	  indx = offs + nrr * n_elev;
 
 	  FIT_GRID_AKIMA( FLT32_T, FLT32_T, 
-			  key.brdf_p[indx].n_wl, key.brdf_p[indx].wl,
-			  key.brdf_p[indx].sensitivity,
+			  key->brdf_p[indx].n_wl, key->brdf_p[indx].wl,
+			  key->brdf_p[indx].sensitivity,
 			  FLT32_T, FLT64_T, 
 			  SCIENCE_PIXELS, wvlen, brdf_p );
 
 	  FIT_GRID_AKIMA( FLT32_T, FLT32_T, 
-			  key.brdf_s[indx].n_wl, key.brdf_s[indx].wl,
-			  key.brdf_s[indx].sensitivity,
+			  key->brdf_s[indx].n_wl, key->brdf_s[indx].wl,
+			  key->brdf_s[indx].sensitivity,
 			  FLT32_T, FLT64_T, 
 			  SCIENCE_PIXELS, wvlen, brdf_s );
 
-	  rspm[nr].ang_esm = key.brdf_p[indx].elevat_angle;
-	  rspm[nr].ang_asm  = key.brdf_p[indx].asm_angle;
+	  rspm[nr].ang_esm = key->brdf_p[indx].elevat_angle;
+	  rspm[nr].ang_asm  = key->brdf_p[indx].asm_angle;
 	  for ( np = 0; np < SCIENCE_PIXELS; np++ )
 	       rspm[nr].sensitivity[np] = 
 		    (abs_rad[np] 
@@ -882,12 +861,6 @@ unsigned short Get_H5_RadSensMoni( bool NDF, /*@null@*/ const float *wvlen_in,
  */
      rspm_out[0] = rspm;
  done:
-     if ( key.elev_p  != NULL ) free( key.elev_p );
-     if ( key.elev_s  != NULL ) free( key.elev_s );
-     if ( key.el_az_p != NULL ) free( key.el_az_p );
-     if ( key.el_az_s != NULL ) free( key.el_az_s );
-     if ( key.brdf_p  != NULL ) free( key.brdf_p );
-     if ( key.brdf_s  != NULL ) free( key.brdf_s );
      return num_rsp;
 }
 
@@ -23,17 +23,26 @@
 .INPUT/OUTPUT
   call as   SCIA_ATBD_FLAG_BDPM( fileParam, state, mds_1c );
             SCIA_SRON_FLAG_BDPM( fileParam, state, mds_1c );
+            SCIA_ATBD_FLAG_BDPM_SPEC( fileParam, spec );
+            SCIA_SRON_FLAG_BDPM_SPEC( fileParam, spec );
             SCIA_LV1C_FLAG_BDPM( absOrbit, num_mds, mds_1c );
+            bdpm = SCIA_ATBD_GET_BDPM( fileParam );
+            bdpm = SCIA_SRON_GET_BDPM( fileParam );
      input:  
              struct file_rec *fileParam : file/calibration parameters
 	     struct state1_scia *state  : structure with States of the product
  in/output:  
              struct mds1c_scia *mds_1c  : level 1c MDS records
+             struct spec1c_scia *spec   : spectra of one state
 
 .RETURNS     Nothing, error status passed by global variable ``nadc_stat''
 .COMMENTS    None
 .ENVIRONment None
-.VERSION      3.3   15-Mar-2012 export functions getBadPixelMaskSRON_24
+.VERSION      3.5   17-Oct-2026 added SCIA_ATBD_FLAG_BDPM_SPEC and
+                                SCIA_SRON_FLAG_BDPM_SPEC, RvH
+              3.4   17-Oct-2026 added SCIA_ATBD_GET_BDPM and
+                                SCIA_SRON_GET_BDPM, RvH
+              3.3   15-Mar-2012 export functions getBadPixelMaskSRON_24
                                 and getBadPixelMaskSRON_30, RvH
               3.2   17-Mar-2011 back-ported SDMF v2.4, RvH
               3.1   15-Sep-2010 fixed bug causing an overwrite of 
@@ -67,7 +76,8 @@
 #define FIRST_VALID_SDMF_BDPM 3899
 
 /*+++++ Static Variables +++++*/
-        /* NONE */
+static unsigned char bdpm_atbd[SCIENCE_PIXELS];
+static unsigned char bdpm_sron[SCIENCE_PIXELS];
 
 /*+++++ Global Variables +++++*/
         /* NONE */
@@ -90,33 +100,89 @@ void Apply_flagBDPM( const unsigned char *bdpm, struct mds1c_scia *mds_1c )
      } while ( ++nobs < mds_1c->num_obs );
 }
 
-/*+++++++++++++++++++++++++ Main Program or Function +++++++++++++++*/
-void SCIA_ATBD_FLAG_BDPM( const struct file_rec *fileParam,
-			  const struct state1_scia *state, 
-			  struct mds1c_scia *mds_1c )
+static
+void Apply_flagBDPM_SPEC( const unsigned char *bdpm, 
+			  struct spec1c_scia *spec )
 {
-     register unsigned short num = 0u;
+     register unsigned short ng, nobs, npix;
+
+     static bool mask_grp[SCIENCE_PIXELS];
+
+     for ( ng = 0; ng < spec->num_grp; ng++ ) {
+	  struct spec1c_grp *grp = spec->grp + ng;
+
+	  for ( npix = 0; npix < grp->num_pixels; npix++ )
+	       mask_grp[npix] = bdpm[grp->pixel_ids[npix]] != UCHAR_ZERO;
+
+	  for ( nobs = 0; nobs < grp->num_obs; nobs++ ) {
+	       float *signal = grp->pixel_val + (size_t) nobs * grp->stride;
+
+	       for ( npix = 0; npix < grp->num_pixels; npix++ )
+		    if ( mask_grp[npix] ) signal[npix] = NAN;
+	  }
+     }
+}
 
-     static unsigned char bdpm[SCIENCE_PIXELS];
 /*
  * Reread calibration parameters
  *  - at first call
  *  - when a new file was opened
  */
-     if ( fileParam->flagInitFile ) {
+static
+void SCIA_ATBD_RD_BDPM( const struct file_rec *fileParam )
+{
+     struct ppg_scia ppg;
+
+     if ( ! fileParam->flagInitFile ) return;
+
+     (void) SCIA_LV1_RD_PPG( fileParam->fp, fileParam->num_dsd, 
+			     fileParam->dsd, &ppg );
+     if ( IS_ERR_STAT_FATAL )
+	  NADC_RETURN_ERROR( NADC_ERR_PDS_RD, "PPG" );
+     (void) memcpy( bdpm_atbd, ppg.bad_pixel, SCIENCE_PIXELS );
+}
+
+static
+void SCIA_SRON_RD_BDPM( const struct file_rec *fileParam )
+{
+     unsigned short orbit;
+     bool found;
+
+     if ( ! fileParam->flagInitFile ) return;
+
+     orbit = (fileParam->absOrbit > FIRST_VALID_SDMF_BDPM)
+	  ? fileParam->absOrbit : FIRST_VALID_SDMF_BDPM;
+     if ( fileParam->sdmf_version == 24 )
+	  found = SDMF_get_BDPM_24( orbit, bdpm_sron );
+     else
+	  found = SDMF_get_BDPM_30( orbit, bdpm_sron );
+     if ( IS_ERR_STAT_FATAL )
+	  NADC_RETURN_ERROR(NADC_ERR_FATAL, "SDMF_get_BDPM");
+     if ( ! found ) {
 	  struct ppg_scia ppg;
 
 	  (void) SCIA_LV1_RD_PPG( fileParam->fp, fileParam->num_dsd, 
 				  fileParam->dsd, &ppg );
 	  if ( IS_ERR_STAT_FATAL )
 	       NADC_RETURN_ERROR( NADC_ERR_PDS_RD, "PPG" );
-	  (void) memcpy( bdpm, ppg.bad_pixel, SCIENCE_PIXELS );
+	  (void) memcpy( bdpm_sron, ppg.bad_pixel, SCIENCE_PIXELS );
      }
+}
+
+/*+++++++++++++++++++++++++ Main Program or Function +++++++++++++++*/
+void SCIA_ATBD_FLAG_BDPM( const struct file_rec *fileParam,
+			  const struct state1_scia *state, 
+			  struct mds1c_scia *mds_1c )
+{
+     register unsigned short num = 0u;
+
+     SCIA_ATBD_RD_BDPM( fileParam );
+     if ( IS_ERR_STAT_FATAL ) return;
 /*
  * apply bad/dead pixel mask
  */
      do {
-	  Apply_flagBDPM( bdpm, mds_1c );
+	  Apply_flagBDPM( bdpm_atbd, mds_1c );
      } while ( mds_1c++, ++num < state->num_clus );   
 }
 
@@ -127,42 +193,55 @@ void SCIA_SRON_FLAG_BDPM( const struct file_rec *fileParam,
 {
      register unsigned short num = 0u;
 
-     static unsigned char bdpm[SCIENCE_PIXELS];
+     SCIA_SRON_RD_BDPM( fileParam );
+     if ( IS_ERR_STAT_FATAL ) return;
 /*
- * Reread calibration parameters
- *  - at first call
- *  - when a new file was opened
+ * apply bad/dead pixel mask
  */
-     if ( fileParam->flagInitFile ) {
-	  unsigned short orbit = (fileParam->absOrbit > FIRST_VALID_SDMF_BDPM)
-	       ? fileParam->absOrbit : FIRST_VALID_SDMF_BDPM;
+     do {
+	  Apply_flagBDPM( bdpm_sron, mds_1c );
+     } while ( mds_1c++, ++num < state->num_clus );   
+}
 
-	  bool found;
+/*--------------------------------------------------*/
+void SCIA_ATBD_FLAG_BDPM_SPEC( const struct file_rec *fileParam,
+			       struct spec1c_scia *spec )
+{
+     SCIA_ATBD_RD_BDPM( fileParam );
+     if ( IS_ERR_STAT_FATAL ) return;
+
+     Apply_flagBDPM_SPEC( bdpm_atbd, spec );
+}
+
+/*--------------------------------------------------*/
+void SCIA_SRON_FLAG_BDPM_SPEC( const struct file_rec *fileParam,
+			       struct spec1c_scia *spec )
+{
+     SCIA_SRON_RD_BDPM( fileParam );
+     if ( IS_ERR_STAT_FATAL ) return;
+
+     Apply_flagBDPM_SPEC( bdpm_sron, spec );
+}
 
-	  if ( fileParam->sdmf_version == 24 )
-	       found = SDMF_get_BDPM_24( orbit, bdpm );
-	  else
-	       found = SDMF_get_BDPM_30( orbit, bdpm );
-	  if ( IS_ERR_STAT_FATAL )
-	       NADC_RETURN_ERROR(NADC_ERR_FATAL, "SDMF_get_BDPM");
-	  if ( ! found ) {
-	       struct ppg_scia ppg;
-
-	       (void) SCIA_LV1_RD_PPG( fileParam->fp, fileParam->num_dsd, 
-				       fileParam->dsd, &ppg );
-	       if ( IS_ERR_STAT_FATAL )
-		    NADC_RETURN_ERROR( NADC_ERR_PDS_RD, "PPG" );
-	       (void) memcpy( bdpm, ppg.bad_pixel, SCIENCE_PIXELS );
-	  }
-     }
 /*
- * apply bad/dead pixel mask
+ * return the bad/dead pixel mask of the product, NULL on error
  */
-     do {
-	  Apply_flagBDPM( bdpm, mds_1c );
-     } while ( mds_1c++, ++num < state->num_clus );   
+const unsigned char *SCIA_ATBD_GET_BDPM( const struct file_rec *fileParam )
+{
+     SCIA_ATBD_RD_BDPM( fileParam );
+     if ( IS_ERR_STAT_FATAL ) return NULL;
+
+     return bdpm_atbd;
 }
-     
+
+const unsigned char *SCIA_SRON_GET_BDPM( const struct file_rec *fileParam )
+{
+     SCIA_SRON_RD_BDPM( fileParam );
+     if ( IS_ERR_STAT_FATAL ) return NULL;
+
+     return bdpm_sron;
+}
+
 void SCIA_LV1C_FLAG_BDPM( unsigned short absOrbit, 
 			  unsigned short num_mds, struct mds1c_scia *mds_1c )
 {
@@ -31,7 +31,8 @@
 .RETURNS     Nothing, error status passed by global variable ``nadc_stat''
 .COMMENTS    Based on SRON Sciamachy monitoring facility
 .ENVIRONment None
-.VERSION      1.3   21-Jan-2009 implemented reset for limb-scans
+.VERSION      1.4   17-Oct-2026 use cached SRON calibration key data, RvH
+              1.3   21-Jan-2009 implemented reset for limb-scans
                                 implemented reset at start of State, RvH
               1.2   16-Nov-2006 added SCIA_LV0_CAL_MEM & SCIA_LV0_CAL_NLIN, RvH
               1.0   06-Jun-2006 initial release by R. M. van Hees
@@ -262,21 +263,19 @@ void SCIA_SRON_CAL_MEM( unsigned short num_mds, struct mds1c_scia *mds_1c )
 {
      register unsigned short num = 0u;     /* counter for number of clusters */
 
-     struct scia_memcorr memcorr = {{0, 0}, NULL};
+     const struct scia_memcorr *memcorr;
 /*
  * initialize array with memory correction value
  */
-     SCIA_RD_H5_MEM( &memcorr );
-     if ( IS_ERR_STAT_FATAL )
-	  NADC_RETURN_ERROR( NADC_ERR_HDF_RD, "SCIA_RD_H5_MEM" );
+     if ( (memcorr = SCIA_GET_H5_MEM()) == NULL )
+	  NADC_RETURN_ERROR( NADC_ERR_HDF_RD, "SCIA_GET_H5_MEM" );
 /*
  * do actual memory correction
  */
      do {
 	  if ( mds_1c->chan_id < FirstInfraChan )
-	       Apply_MemCorrSRON( memcorr.matrix[mds_1c->chan_id-1], mds_1c );
+	       Apply_MemCorrSRON( memcorr->matrix[mds_1c->chan_id-1], mds_1c );
      } while ( mds_1c++, ++num < num_mds );
-     SCIA_FREE_H5_MEM( &memcorr );
 }
 
 /*--------------------------------------------------*/
@@ -284,19 +283,17 @@ void SCIA_SRON_CAL_NLIN( unsigned short num_mds, struct mds1c_scia *mds_1c )
 {
      register unsigned short num = 0u;     /* counter for number of clusters */
      
-     struct scia_nlincorr nlcorr = {{0, 0}, NULL, NULL};
+     const struct scia_nlincorr *nlcorr;
 /*
  * read lookup table for non-linearity correction of Epitaxx detector data
  */
-     SCIA_RD_H5_NLIN( &nlcorr );
-     if ( IS_ERR_STAT_FATAL )
-	  NADC_RETURN_ERROR( NADC_ERR_HDF_RD, "SCIA_RD_H5_NLIN" );
+     if ( (nlcorr = SCIA_GET_H5_NLIN()) == NULL )
+	  NADC_RETURN_ERROR( NADC_ERR_HDF_RD, "SCIA_GET_H5_NLIN" );
 /*
  * do actual non-Linearity correction
  */
      do {
 	  if ( mds_1c->chan_id >= FirstInfraChan )
-	       Apply_nLinCorrSRON( &nlcorr, mds_1c );
+	       Apply_nLinCorrSRON( nlcorr, mds_1c );
      } while ( mds_1c++, ++num < num_mds );
-     SCIA_FREE_H5_NLIN( &nlcorr );
 }
@@ -22,16 +22,21 @@
 .PURPOSE     perform Transmission correction on Sciamachy channel 8 data
 .INPUT/OUTPUT
   call as   SCIA_SRON_CAL_TRANS( fileParam, state, mds_1c );
+            SCIA_SRON_CAL_TRANS_SPEC( fileParam, spec );
+            trans_avg = SCIA_SRON_GET_TRANS( fileParam );
      input:  
              struct file_rec *fileParam : file/calibration parameters
 	     struct state1_scia *state  : structure with States of the product
  in/output:  
              struct mds1c_scia *mds_1c  : level 1c MDS records
+             struct spec1c_scia *spec   : spectra of one state
 
 .RETURNS     Nothing, error status passed by global variable ``nadc_stat''
 .COMMENTS    None
 .ENVIRONment None
-.VERSION      1.1   21-May-2012 bug fixes and usage of SDMF routines, RvH
+.VERSION      1.3   17-Oct-2026 added SCIA_SRON_CAL_TRANS_SPEC, RvH
+              1.2   17-Oct-2026 added SCIA_SRON_GET_TRANS, RvH
+              1.1   21-May-2012 bug fixes and usage of SDMF routines, RvH
               1.0   27-Mar-2012 initial release by R. M. van Hees
 ------------------------------------------------------------*/
 /*
@@ -64,12 +69,13 @@
 
 /*+++++++++++++++++++++++++ Static Functions +++++++++++++++++++++++*/
 /*+++++++++++++++++++++++++ Main Program or Function +++++++++++++++*/
-void SCIA_SRON_CAL_TRANS( const struct file_rec *fileParam,
-			  const struct state1_scia *state, 
-			  struct mds1c_scia *mds_1c )
+/*
+ * return the average transmission of channel 8 (the signal is divided
+ * by this value), NaN on error
+ */
+float SCIA_SRON_GET_TRANS( const struct file_rec *fileParam )
 {
      register unsigned short np;
-     register unsigned short num = 0u;
 
      static float trans_fact[CHANNEL_SIZE];
 
@@ -77,7 +83,6 @@ void SCIA_SRON_CAL_TRANS( const struct file_rec *fileParam,
 
      size_t dim;
      float  new_val = 1.f;
-     float  trans_avg;
      
      unsigned short pixel_range[] = {505, 615};
 /*
@@ -94,8 +99,10 @@ void SCIA_SRON_CAL_TRANS( const struct file_rec *fileParam,
 	  else
 	       found = SDMF_get_Transmission_30( FALSE, fileParam->absOrbit, 
 						 8, trans_fact );
-	  if ( IS_ERR_STAT_FATAL )
-	       NADC_RETURN_ERROR( NADC_ERR_FATAL, "SDMF_get_Transmission" );
+	  if ( IS_ERR_STAT_FATAL ) {
+	       NADC_ERROR( NADC_ERR_FATAL, "SDMF_get_Transmission" );
+	       return NAN;
+	  }
 	  if ( ! found )
 	       NADC_ERROR( NADC_ERR_NONE, "no SDMF Transmission data" );
      }
@@ -115,9 +122,20 @@ void SCIA_SRON_CAL_TRANS( const struct file_rec *fileParam,
 	  }
      }
      dim = pixel_range[1] - pixel_range[0] + 1;
-     trans_avg = SELECTr( (dim+1)/2, dim, trans_fact+pixel_range[0] );
-     /* (void) fprintf( stderr, "%04hu-%04hu: %4zd %12.6g\n",  */
-     /* 		     pixel_range[0], pixel_range[1], dim, trans_avg ); */
+     /* (void) fprintf( stderr, "%04hu-%04hu: %4zd\n",  */
+     /* 		     pixel_range[0], pixel_range[1], dim ); */
+     return SELECTr( (dim+1)/2, dim, trans_fact+pixel_range[0] );
+}
+
+void SCIA_SRON_CAL_TRANS( const struct file_rec *fileParam,
+			  const struct state1_scia *state, 
+			  struct mds1c_scia *mds_1c )
+{
+     register unsigned short num = 0u;
+
+     const float trans_avg = SCIA_SRON_GET_TRANS( fileParam );
+
+     if ( IS_ERR_STAT_FATAL ) return;
 /*
  * apply Transmission correction
  */
@@ -136,3 +154,27 @@ void SCIA_SRON_CAL_TRANS( const struct file_rec *fileParam,
 	  } while ( ++nobs < mds_1c->num_obs );
      } while ( mds_1c++, ++num < state->num_clus );   
 }
+
+/*--------------------------------------------------*/
+void SCIA_SRON_CAL_TRANS_SPEC( const struct file_rec *fileParam,
+			       struct spec1c_scia *spec )
+{
+     register unsigned short ng, nobs, npix;
+
+     const float trans_avg = SCIA_SRON_GET_TRANS( fileParam );
+
+     if ( IS_ERR_STAT_FATAL ) return;
+/*
+ * apply Transmission correction, one row of a group at a time
+ */
+     for ( ng = 0; ng < spec->num_grp; ng++ ) {
+	  struct spec1c_grp *grp = spec->grp + ng;
+
+	  for ( nobs = 0; nobs < grp->num_obs; nobs++ ) {
+	       float *signal = grp->pixel_val + (size_t) nobs * grp->stride;
+
+	       for ( npix = 0; npix < grp->num_pixels; npix++ )
+		    signal[npix] /= trans_avg;
+	  }
+     }
+}
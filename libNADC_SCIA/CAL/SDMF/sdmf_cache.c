@@ -0,0 +1,374 @@
+/*++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+.COPYRIGHT (c) 2026 SRON (R.M.van.Hees@sron.nl)
+
+   This is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License, version 2, as
+   published by the Free Software Foundation.
+
+   The software is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place - Suite 330,
+   Boston, MA  02111-1307, USA.
+
+.IDENTifer   SDMF_CACHE
+.AUTHOR      R.M. van Hees
+.KEYWORDS    SDMF - HDF5
+.LANGUAGE    ANSI C
+.PURPOSE     keep SDMF databases open and their orbit indices in memory
+.COMMENTS    contains SDMF_open_file, SDMF_get_orbitIndex, SDMF_close_files
+             - a database is opened (read-only) at its first use, and
+	       remains open until SDMF_close_files is called, or until it
+	       is replaced in the cache by another database. A database
+	       with open objects (groups, datasets, ...) is never replaced
+	     - the datasets "orbitList" and "orbitIndex" are read once per
+	       (file, group) and kept in memory
+	     - a database and its cached indices are validated with the
+	       device, inode, size and modification time of the file, and
+	       re-opened or read again when one of these has changed. A
+	       modified database with open objects is opened in a new entry,
+	       the old identifier remains valid until it is replaced
+	     - indices of a file opened for writing are never cached
+.ENVIRONment None
+.VERSION      1.2   17-Oct-2026 do not close a modified database in use, RvH
+              1.1   17-Oct-2026 do not replace databases in use, RvH
+              1.0   17-Oct-2026 created by R. M. van Hees
+------------------------------------------------------------*/
+/*
+ * Define _POSIX_C_SOURCE to indicate
+ * that this is a POSIX program (stat, st_mtim)
+ */
+#define  _POSIX_C_SOURCE 200809L
+
+/*+++++ System headers +++++*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <hdf5.h>
+#include <hdf5_hl.h>
+
+/*+++++ Local Headers +++++*/
+#include <nadc_sdmf.h>
+
+/*+++++ Macros +++++*/
+#define MAX_SDMF_FILES     16
+#define MAX_SDMF_INDICES   128
+
+/*+++++ Static Variables +++++*/
+static const char  listName[] = "orbitList";
+static const char  indexName[] = "orbitIndex";
+
+struct sdmf_stamp
+{
+     dev_t  dev;
+     ino_t  ino;
+     off_t  size;
+     time_t mtime;
+     long   mtime_ns;
+};
+
+static struct sdmf_file_rec
+{
+     hid_t  fid;
+     char   flname[MAX_STRING_LENGTH];
+     struct sdmf_stamp stamp;
+} sdmf_file[MAX_SDMF_FILES];
+static unsigned short num_file = 0;
+static unsigned short next_file = 0;
+
+static struct sdmf_index_rec
+{
+     bool   valid;
+     char   flname[MAX_STRING_LENGTH];
+     char   grpName[MAX_STRING_LENGTH];
+     struct sdmf_stamp stamp;
+     int    nrows;
+     int    *orbitList;
+     int    *orbitIndex;
+} sdmf_index[MAX_SDMF_INDICES];
+static unsigned short num_index = 0;
+static unsigned short next_index = 0;
+
+/*+++++++++++++++++++++++++ Static Functions +++++++++++++++++++++++*/
+static
+bool GET_STAMP( const char *flname, struct sdmf_stamp *stamp )
+{
+     struct stat st;
+
+     (void) memset( stamp, 0, sizeof(struct sdmf_stamp) );
+     if ( stat( flname, &st ) != 0 ) return FALSE;
+
+     stamp->dev      = st.st_dev;
+     stamp->ino      = st.st_ino;
+     stamp->size     = st.st_size;
+     stamp->mtime    = st.st_mtim.tv_sec;
+     stamp->mtime_ns = st.st_mtim.tv_nsec;
+     return TRUE;
+}
+
+static inline
+bool SAME_STAMP( const struct sdmf_stamp *s1, const struct sdmf_stamp *s2 )
+{
+     return (s1->dev == s2->dev && s1->ino == s2->ino
+	     && s1->size == s2->size && s1->mtime == s2->mtime
+	     && s1->mtime_ns == s2->mtime_ns);
+}
+
+static inline
+bool FILE_IN_USE( hid_t fid )
+{
+     const unsigned int types = H5F_OBJ_DATASET | H5F_OBJ_GROUP
+	  | H5F_OBJ_DATATYPE | H5F_OBJ_ATTR | H5F_OBJ_LOCAL;
+
+     return (H5Fget_obj_count( fid, types ) > 0);
+}
+
+static
+void FREE_INDEX( struct sdmf_index_rec *rec )
+{
+     if ( rec->orbitList != NULL ) free( rec->orbitList );
+     if ( rec->orbitIndex != NULL ) free( rec->orbitIndex );
+     (void) memset( rec, 0, sizeof(struct sdmf_index_rec) );
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   READ_INDEX
+.PURPOSE     read orbitList and orbitIndex of a file or group
+.INPUT/OUTPUT
+  call as    READ_INDEX( locID, rec );
+     input:
+           hid_t locID                 :  HDF5 identifier of file or group
+ in/output:
+           struct sdmf_index_rec *rec  :  cache record (released first)
+
+.RETURNS     nothing, error status passed by global variable ``nadc_stat''
+.COMMENTS    static function, rec->nrows is -1 when orbitList is absent
+-------------------------*/
+static
+void READ_INDEX( hid_t locID, struct sdmf_index_rec *rec )
+{
+     herr_t  stat;
+     hsize_t adim;
+
+     if ( rec->orbitList != NULL ) free( rec->orbitList );
+     if ( rec->orbitIndex != NULL ) free( rec->orbitIndex );
+     rec->orbitList = rec->orbitIndex = NULL;
+     rec->nrows = -1;
+/*
+ * test if dataset "orbitList" exists
+ */
+     H5E_BEGIN_TRY {
+          hid_t dataID = H5Dopen( locID, listName, H5P_DEFAULT );
+	  if ( dataID < 0 ) return;
+	  (void) H5Dclose( dataID );
+     } H5E_END_TRY;
+/*
+ * read orbitList and orbitIndex
+ */
+     stat = H5LTget_dataset_info( locID, listName, &adim, NULL, NULL );
+     if ( stat < 0 ) NADC_RETURN_ERROR( NADC_ERR_HDF_SPACE, listName );
+
+     rec->orbitList = (int *) malloc( (size_t) adim * sizeof(int) );
+     if ( rec->orbitList == NULL )
+	  NADC_RETURN_ERROR( NADC_ERR_ALLOC, "orbitList" );
+     if ( H5LTread_dataset_int( locID, listName, rec->orbitList ) < 0 )
+	  NADC_RETURN_ERROR( NADC_ERR_HDF_DATA, listName );
+
+     rec->orbitIndex = (int *) malloc( (size_t) adim * sizeof(int) );
+     if ( rec->orbitIndex == NULL )
+	  NADC_RETURN_ERROR( NADC_ERR_ALLOC, "orbitIndex" );
+     if ( H5LTread_dataset_int( locID, indexName, rec->orbitIndex ) < 0 )
+	  NADC_RETURN_ERROR( NADC_ERR_HDF_DATA, indexName );
+
+     rec->nrows = (int) adim;
+}
+
+/*+++++++++++++++++++++++++ Main Program or Function +++++++++++++++*/
+/*+++++++++++++++++++++++++
+.IDENTifer   SDMF_open_file
+.PURPOSE     obtain (read-only) HDF5 identifier of a SDMF database
+.INPUT/OUTPUT
+  call as    fid = SDMF_open_file( sdmf_db );
+     input:
+           char *sdmf_db    :  name of the SDMF database
+
+.RETURNS     HDF5 file identifier, negative when the file can not be opened
+.COMMENTS    the identifier is owned by the cache, the caller should not
+             close it. It remains valid until SDMF_close_files, or until
+	     a next call of SDMF_open_file replaces this database in the
+	     cache; therefore, open the required groups or datasets before
+	     a next call of SDMF_open_file
+-------------------------*/
+hid_t SDMF_open_file( const char *sdmf_db )
+{
+     register unsigned short nf;
+
+     hid_t  fid = -1;
+     struct sdmf_stamp stamp;
+     struct sdmf_file_rec *rec;
+
+     if ( ! GET_STAMP( sdmf_db, &stamp ) ) return -1;
+
+     for ( nf = 0; nf < num_file; nf++ ) {
+	  if ( strcmp( sdmf_file[nf].flname, sdmf_db ) == 0 ) break;
+     }
+     if ( nf < num_file ) {
+	  rec = sdmf_file + nf;
+	  if ( SAME_STAMP( &rec->stamp, &stamp ) ) return rec->fid;
+
+	  /* the database has been modified: open it again */
+	  if ( FILE_IN_USE( rec->fid ) ) {
+	       /* keep the old identifier, without name, until it is replaced */
+	       rec->flname[0] = '\0';
+	       nf = num_file;
+	  } else
+	       (void) H5Fclose( rec->fid );
+     }
+     if ( nf == num_file ) {
+	  if ( num_file < MAX_SDMF_FILES ) {
+	       nf = num_file++;
+	  } else {
+	       register unsigned short nn = 0;
+
+	       /* replace the oldest database without open objects */
+	       do {
+		    nf = next_file;
+		    next_file = (unsigned short)
+			 ((next_file + 1) % MAX_SDMF_FILES);
+	       } while ( FILE_IN_USE( sdmf_file[nf].fid )
+			 && ++nn < MAX_SDMF_FILES );
+	       if ( nn == MAX_SDMF_FILES ) {
+		    NADC_ERROR( NADC_ERR_FILE, "too many SDMF databases in use" );
+		    return -1;
+	       }
+	       (void) H5Fclose( sdmf_file[nf].fid );
+	  }
+	  (void) nadc_strlcpy( sdmf_file[nf].flname, sdmf_db,
+			       MAX_STRING_LENGTH );
+     }
+     rec = sdmf_file + nf;
+     H5E_BEGIN_TRY {
+	  fid = H5Fopen( sdmf_db, H5F_ACC_RDONLY, H5P_DEFAULT );
+     } H5E_END_TRY;
+     rec->fid = fid;
+     rec->stamp = stamp;
+
+     /* remove failed entry, by moving the last entry to this position */
+     if ( fid < 0 ) {
+	  if ( nf != --num_file ) sdmf_file[nf] = sdmf_file[num_file];
+	  next_file = 0;
+     }
+     return fid;
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   SDMF_get_orbitIndex
+.PURPOSE     obtain orbitList and orbitIndex of a file or group
+.INPUT/OUTPUT
+  call as    nrows = SDMF_get_orbitIndex( locID, &orbitList, &orbitIndex );
+     input:
+           hid_t locID        :  HDF5 identifier of file or group
+    output:
+           int  **orbitList   :  orbit numbers of the metaTable records
+           int  **orbitIndex  :  indices to orbitList, sorted on orbit
+
+.RETURNS     number of rows, -1 when there is no orbitList (int)
+             error status passed by global variable ``nadc_stat''
+.COMMENTS    the arrays are owned by the cache, they remain valid until the
+             next call of SDMF_get_orbitIndex or SDMF_close_files
+-------------------------*/
+int SDMF_get_orbitIndex( hid_t locID, const int **orbitList,
+			 const int **orbitIndex )
+{
+     register unsigned short ni;
+
+     char     flname[MAX_STRING_LENGTH];
+     char     grpName[MAX_STRING_LENGTH];
+     bool     use_cache = FALSE;
+     hid_t    fid;
+     unsigned intent = H5F_ACC_RDWR;
+
+     struct sdmf_stamp stamp;
+     struct sdmf_index_rec *rec;
+
+     *orbitList = *orbitIndex = NULL;
+/*
+ * key of the cache: name of file and group
+ */
+     if ( H5Fget_name( locID, flname, MAX_STRING_LENGTH ) < 0
+	  || H5Iget_name( locID, grpName, MAX_STRING_LENGTH ) < 0 ) {
+	  NADC_ERROR( NADC_ERR_HDF_FILE, "H5Fget_name/H5Iget_name" );
+	  return -1;
+     }
+     if ( (fid = H5Iget_file_id( locID )) >= 0 ) {
+	  if ( H5Fget_intent( fid, &intent ) < 0 ) intent = H5F_ACC_RDWR;
+	  (void) H5Fclose( fid );
+     }
+     if ( intent == H5F_ACC_RDONLY && GET_STAMP( flname, &stamp ) )
+	  use_cache = TRUE;
+/*
+ * search the cache
+ */
+     for ( ni = 0; ni < num_index; ni++ ) {
+	  if ( strcmp( sdmf_index[ni].grpName, grpName ) == 0
+	       && strcmp( sdmf_index[ni].flname, flname ) == 0 ) break;
+     }
+     if ( ni < num_index ) {
+	  rec = sdmf_index + ni;
+	  if ( use_cache && rec->valid && SAME_STAMP( &rec->stamp, &stamp ) )
+	       goto done;
+     } else {
+	  if ( num_index < MAX_SDMF_INDICES ) {
+	       ni = num_index++;
+	  } else {
+	       ni = next_index;
+	       next_index = (unsigned short)
+		    ((next_index + 1) % MAX_SDMF_INDICES);
+	       FREE_INDEX( sdmf_index + ni );
+	  }
+	  rec = sdmf_index + ni;
+	  (void) nadc_strlcpy( rec->flname, flname, MAX_STRING_LENGTH );
+	  (void) nadc_strlcpy( rec->grpName, grpName, MAX_STRING_LENGTH );
+     }
+/*
+ * (re-)read the orbit indices
+ */
+     rec->valid = FALSE;
+     READ_INDEX( locID, rec );
+     if ( IS_ERR_STAT_FATAL ) return -1;
+     if ( use_cache ) {
+	  rec->valid = TRUE;
+	  rec->stamp = stamp;
+     }
+ done:
+     *orbitList  = rec->orbitList;
+     *orbitIndex = rec->orbitIndex;
+     return rec->nrows;
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   SDMF_close_files
+.PURPOSE     close all SDMF databases and release the cached orbit indices
+.INPUT/OUTPUT
+  call as    SDMF_close_files();
+
+.RETURNS     nothing
+.COMMENTS    none
+-------------------------*/
+void SDMF_close_files( void )
+{
+     register unsigned short nn;
+
+     for ( nn = 0; nn < num_index; nn++ ) FREE_INDEX( sdmf_index + nn );
+     num_index = next_index = 0;
+
+     for ( nn = 0; nn < num_file; nn++ ) (void) H5Fclose( sdmf_file[nn].fid );
+     num_file = next_file = 0;
+}
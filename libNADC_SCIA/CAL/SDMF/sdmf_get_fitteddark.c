@@ -23,7 +23,8 @@
 .COMMENTS    contains SDMF_get_FittedDark, SDMF_get_FittedDark_30
                       SDMF_get_FittedDark_24
 .ENVIRONment None
-.VERSION     2.3     10-Jan-2013   optionally use NRT entries, RvH
+.VERSION     2.4     17-Oct-2026   keep the SDMF database open, RvH
+             2.3     10-Jan-2013   optionally use NRT entries, RvH
              2.2     15-May-2012   greatly improved v2.4 implementation, RvH
              2.1     14-May-2012   added test program, RvH
              2.0     18-Mar-2011   back-ported SDMF v2.4 & 3.0, RvH
@@ -292,9 +293,7 @@ bool SDMF_get_FittedDark_30( unsigned short channel, unsigned short absOrbit,
  */
      (void) snprintf( sdmf_db, MAX_STRING_LENGTH, "%s/%s", 
                       SDMF_PATH("3.0"), "sdmf_dark.h5" );
-     H5E_BEGIN_TRY {
-	  fid = H5Fopen( sdmf_db, H5F_ACC_RDONLY, H5P_DEFAULT );
-     } H5E_END_TRY;
+     fid = SDMF_open_file( sdmf_db );
      if ( fid < 0 ) NADC_GOTO_ERROR( NADC_ERR_HDF_FILE, sdmf_db );
 /*
  * get index to metaTable records or this state
@@ -343,7 +342,6 @@ bool SDMF_get_FittedDark_30( unsigned short channel, unsigned short absOrbit,
 /*
  * close SDMF Dark database
  */
-     if ( fid != -1 ) (void) H5Fclose( fid );
      return TRUE;
 done:
      return FALSE;
@@ -450,9 +448,7 @@ bool SDMF_get_FittedDark( unsigned short absOrbit, unsigned short channel,
  */
      (void) snprintf( sdmf_db, MAX_STRING_LENGTH, "%s/%s", 
                       SDMF_PATH("3.1"), "sdmf_dark.h5" );
-     H5E_BEGIN_TRY {
-	  fid = H5Fopen( sdmf_db, H5F_ACC_RDONLY, H5P_DEFAULT );
-     } H5E_END_TRY;
+     fid = SDMF_open_file( sdmf_db );
      if ( fid < 0 ) NADC_GOTO_ERROR( NADC_ERR_HDF_FILE, sdmf_db );
 
      H5E_BEGIN_TRY {
@@ -554,7 +550,6 @@ bool SDMF_get_FittedDark( unsigned short absOrbit, unsigned short channel,
      }
 done:
      if ( gid > 0 ) H5Gclose( gid );
-     if ( fid > 0 ) H5Fclose( fid );
 
      return found;
 }
@@ -23,7 +23,8 @@
 .COMMENTS    contains SDMF_get_OrbitalDark, SDMF_get_OrbitalDark_30
                       SDMF_get_OrbitalDark_24
 .ENVIRONment None
-.VERSION     1.1     10-Jan-2013   optionally use NRT entries, RvH
+.VERSION     1.2     17-Oct-2026   keep the SDMF database open, RvH
+             1.1     10-Jan-2013   optionally use NRT entries, RvH
              1.0     29-May-2012   initial release by R. M. van Hees
 ------------------------------------------------------------*/
 /*
@@ -200,9 +201,7 @@ bool SDMF_get_OrbitalDark_30( unsigned short absOrbit, float orbitPhase,
  */
      (void) snprintf( sdmf_db, MAX_STRING_LENGTH, "%s/%s", 
                       SDMF_PATH("3.0"), "sdmf_simudark.h5" );
-     H5E_BEGIN_TRY {
-	  fid = H5Fopen( sdmf_db, H5F_ACC_RDONLY, H5P_DEFAULT );
-     } H5E_END_TRY;
+     fid = SDMF_open_file( sdmf_db );
      if ( fid < 0 ) NADC_GOTO_ERROR( NADC_ERR_HDF_FILE, sdmf_db );
 
      if ( (gid = H5Gopen( fid, "ch8", H5P_DEFAULT )) < 0 )
@@ -245,7 +244,6 @@ bool SDMF_get_OrbitalDark_30( unsigned short absOrbit, float orbitPhase,
 done:
      if ( mtbl != NULL ) free( mtbl );
      if ( gid > 0 ) H5Gclose( gid );
-     if ( fid > 0 ) H5Fclose( fid );
      return found;
 }
 
@@ -22,7 +22,8 @@
 .PURPOSE     obtain PPG parameters
 .COMMENTS    contains SDMF_get_PPG_24, SDMF_get_PPG_30
 .ENVIRONment None
-.VERSION     1.0     04-Jul-2012   initial release by R. M. van Hees
+.VERSION     1.1     17-Oct-2026   keep the SDMF database open, RvH
+             1.0     04-Jul-2012   initial release by R. M. van Hees
 ------------------------------------------------------------*/
 /*
  * Define _ISOC99_SOURCE to indicate
@@ -173,9 +174,7 @@ bool SDMF_get_PPG_30( unsigned short absOrbit, unsigned short channel,
  */
      (void) snprintf( sdmf_db, MAX_STRING_LENGTH, "%s/%s", 
                       SDMF_PATH("3.0"), "sdmf_ppg.h5" );
-     H5E_BEGIN_TRY {
-	  fid = H5Fopen( sdmf_db, H5F_ACC_RDONLY, H5P_DEFAULT );
-     } H5E_END_TRY;
+     fid = SDMF_open_file( sdmf_db );
      if ( fid < 0 ) NADC_GOTO_ERROR( NADC_ERR_HDF_FILE, sdmf_db );
 /*
  * find PPG values, requirements:
@@ -212,7 +211,6 @@ bool SDMF_get_PPG_30( unsigned short absOrbit, unsigned short channel,
  * close SDMF pixel-to-pixel gain database
  */
  done:
-     if ( fid != -1 ) (void) H5Fclose( fid );
 
      return found;
 }
@@ -22,7 +22,8 @@
 .PURPOSE     obtain SMR parameters
 .COMMENTS    contains SDMF_get_SMR, SDMF_get_SMR_30, SDMF_get_SMR_31
 .ENVIRONment None
-.VERSION     1.0     04-Jul-2012   initial release by R. M. van Hees
+.VERSION     2.1     17-Oct-2026   keep the SDMF database open, RvH
+             1.0     04-Jul-2012   initial release by R. M. van Hees
              2.0     11-Sept-2013  added SDMF_get_SMR_31, RvH
 ------------------------------------------------------------*/
 /*
@@ -123,9 +124,7 @@ bool SDMF_get_SMR_30( bool calibRad,
  */
      (void) snprintf( sdmf_db, MAX_STRING_LENGTH, "%s/%s", 
                       SDMF_PATH("3.0"), "sdmf_smr.h5" );
-     H5E_BEGIN_TRY {
-	  fid = H5Fopen( sdmf_db, H5F_ACC_RDONLY, H5P_DEFAULT );
-     } H5E_END_TRY;
+     fid = SDMF_open_file( sdmf_db );
      if ( fid < 0 ) NADC_GOTO_ERROR( NADC_ERR_HDF_FILE, sdmf_db );
 /*
  * find SMR values, requirements:
@@ -180,7 +179,6 @@ bool SDMF_get_SMR_30( bool calibRad,
  * close SDMF Sun-Mean-Reference database
  */
  done:
-     if ( fid != -1 ) (void) H5Fclose( fid );
 
      return found;
 }
@@ -260,9 +258,7 @@ bool SDMF_get_SMR_31( bool calibRad,
  */
      (void) snprintf( sdmf_db, MAX_STRING_LENGTH, "%s/%s", 
                       SDMF_PATH("3.1"), "sdmf_smr.h5" );
-     H5E_BEGIN_TRY {
-	  fid = H5Fopen( sdmf_db, H5F_ACC_RDONLY, H5P_DEFAULT );
-     } H5E_END_TRY;
+     fid = SDMF_open_file( sdmf_db );
      if ( fid < 0 ) NADC_GOTO_ERROR( NADC_ERR_HDF_FILE, sdmf_db );
 /*
  * find SMR values, requirements:
@@ -329,7 +325,6 @@ bool SDMF_get_SMR_31( bool calibRad,
  */
  done:
      if ( orbitList != NULL ) free( orbitList );
-     if ( fid != -1 ) (void) H5Fclose( fid );
 
      return found;
 }
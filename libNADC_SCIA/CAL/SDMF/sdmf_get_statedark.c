@@ -23,7 +23,9 @@
 .COMMENTS    contains SDMF_get_StateDark, SDMF_get_StateDark_30
                       SDMF_get_StateDark_24
 .ENVIRONment None
-.VERSION     2.3     10-Sep-2014   do not fail on missing orbits (v3.0), RvH
+.VERSION     2.5     17-Oct-2026   keep the SDMF database open, RvH
+             2.4     17-Oct-2026   use cached SRON calibration key data, RvH
+             2.3     10-Sep-2014   do not fail on missing orbits (v3.0), RvH
              2.2     20-Sep-2012   added option to mimic algorithm of Hans 
                                    Schrijver for dark noise (v2.4), RvH
              2.1     16-May-2012   back-ported SDMF v2.4 & 3.0, RvH
@@ -408,8 +410,8 @@ bool SDMF_get_StateDark_30( unsigned char stateID, unsigned short channel,
 
      struct mtbl_calib_rec *mtbl = NULL;
 
-     struct scia_memcorr memcorr = {{0,0}, NULL};
-     struct scia_nlincorr nlcorr = {{0,0}, NULL, NULL};
+     const struct scia_memcorr  *memcorr;
+     const struct scia_nlincorr *nlcorr;
 
      const int orbit = (int) absOrbit;
      const int pixelRange[2] = { 
@@ -438,9 +440,7 @@ bool SDMF_get_StateDark_30( unsigned char stateID, unsigned short channel,
  */
      (void) snprintf( sdmf_db, MAX_STRING_LENGTH, "%s/%s", 
                       SDMF_PATH("3.0"), "sdmf_extract_calib.h5" );
-     H5E_BEGIN_TRY {
-	  fid = H5Fopen( sdmf_db, H5F_ACC_RDONLY, H5P_DEFAULT );
-     } H5E_END_TRY;
+     fid = SDMF_open_file( sdmf_db );
      if ( fid < 0 ) NADC_GOTO_ERROR( NADC_ERR_HDF_FILE, sdmf_db );
 
      (void) snprintf( grpName, STR_SZ_H5_GRP, "State_%02hhu", stateID );
@@ -485,12 +485,10 @@ bool SDMF_get_StateDark_30( unsigned char stateID, unsigned short channel,
 /*
  * read memory & non-linearity correction tables
  */
-     SCIA_RD_H5_MEM( &memcorr );
-     if ( IS_ERR_STAT_FATAL )
-          NADC_GOTO_ERROR( NADC_ERR_FATAL, "SCIA_RD_H5_MEM" );
-     SCIA_RD_H5_NLIN( &nlcorr );
-     if ( IS_ERR_STAT_FATAL )
-          NADC_GOTO_ERROR( NADC_ERR_FATAL, "SCIA_RD_H5_NLIN" );
+     if ( (memcorr = SCIA_GET_H5_MEM()) == NULL )
+          NADC_GOTO_ERROR( NADC_ERR_FATAL, "SCIA_GET_H5_MEM" );
+     if ( (nlcorr = SCIA_GET_H5_NLIN()) == NULL )
+          NADC_GOTO_ERROR( NADC_ERR_FATAL, "SCIA_GET_H5_NLIN" );
 /*
  * read data from available Dark states and calculate average
  */
@@ -552,15 +550,15 @@ bool SDMF_get_StateDark_30( unsigned char stateID, unsigned short channel,
      if ( channel == 0 ) {
 	  for ( np = 0; np < SCIENCE_PIXELS; np++ ) {
 	       unsigned short ichan = (unsigned short)(np / CHANNEL_SIZE);
-	       unsigned short indx = (unsigned short) nlcorr.curve[np];
+	       unsigned short indx = (unsigned short) nlcorr->curve[np];
 
 	       if ( num_signal[np] > 0 ) {
 		    darkSignal[np] /= num_signal[np];
 		    ival = __ROUNDf_us( darkSignal[np] );
 		    if ( ichan < 5 )
-			 darkSignal[np] -= memcorr.matrix[ichan][ival];
+			 darkSignal[np] -= memcorr->matrix[ichan][ival];
 		    else
-			 darkSignal[np] -= nlcorr.matrix[indx][ival];
+			 darkSignal[np] -= nlcorr->matrix[indx][ival];
 	       }
 	       if ( num_noise[np] > 0 )
 		    darkNoise[np] = sqrtf(darkNoise[np] / num_noise[np] );
@@ -570,15 +568,15 @@ bool SDMF_get_StateDark_30( unsigned char stateID, unsigned short channel,
      } else {
 	  for ( np = 0; np < CHANNEL_SIZE; np++ ) {
 	       unsigned short indx = (unsigned short) 
-		    nlcorr.curve[np + (channel-1) * CHANNEL_SIZE];
+		    nlcorr->curve[np + (channel-1) * CHANNEL_SIZE];
 
 	       if ( num_signal[np] > 0 ) {
 		    darkSignal[np] /= num_signal[np];
 		    ival = __ROUNDf_us( darkSignal[np] );
 		    if ( channel < 6 )
-			 darkSignal[np] -= memcorr.matrix[channel-1][ival];
+			 darkSignal[np] -= memcorr->matrix[channel-1][ival];
 		    else
-			 darkSignal[np] -= nlcorr.matrix[indx][ival];
+			 darkSignal[np] -= nlcorr->matrix[indx][ival];
 	       }
 	       if ( num_noise[np] > 0 ) 
 		    darkNoise[np] = sqrtf( darkNoise[np] / num_noise[np] );
@@ -587,12 +585,8 @@ bool SDMF_get_StateDark_30( unsigned char stateID, unsigned short channel,
 	  }
      }
 done:
-     SCIA_FREE_H5_MEM( &memcorr );
-     SCIA_FREE_H5_NLIN( &nlcorr );
-
      if ( mtbl != NULL ) free( mtbl );
      if ( gid > 0 ) H5Gclose( gid );
-     if ( fid > 0 ) H5Fclose( fid );
 
      return TRUE;
 }
@@ -669,9 +663,7 @@ bool SDMF_get_StateDark( unsigned char stateID, unsigned short channel,
  */
      (void) snprintf( sdmf_db, MAX_STRING_LENGTH, "%s/%s", 
                       SDMF_PATH("3.1"), "sdmf_dark.h5" );
-     H5E_BEGIN_TRY {
-	  fid = H5Fopen( sdmf_db, H5F_ACC_RDONLY, H5P_DEFAULT );
-     } H5E_END_TRY;
+     fid = SDMF_open_file( sdmf_db );
      if ( fid < 0 ) NADC_GOTO_ERROR( NADC_ERR_HDF_FILE, sdmf_db );
 
      (void) snprintf( grpName, STR_SZ_H5_GRP, "State_%02hhu", stateID );
@@ -727,7 +719,6 @@ bool SDMF_get_StateDark( unsigned char stateID, unsigned short channel,
      }
 done:
      if ( gid > 0 ) H5Gclose( gid );
-     if ( fid > 0 ) H5Fclose( fid );
 
      return found;
 }
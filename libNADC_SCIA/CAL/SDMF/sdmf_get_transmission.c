@@ -22,7 +22,8 @@
 .PURPOSE     read transmission based on Sun or WLS measurements
 .COMMENTS    contains SDMF_get_Transmission_24 and SDMF_get_Transmission_30
 .ENVIRONment None
-.VERSION      1.0   20-May-2012 initial release by R. M. van Hees
+.VERSION      1.1   17-Oct-2026 keep the SDMF database open, RvH
+              1.0   20-May-2012 initial release by R. M. van Hees
 ------------------------------------------------------------*/
 /*
  * Define _ISOC99_SOURCE to indicate
@@ -189,9 +190,7 @@ bool SDMF_get_Transmission_30( bool wlsFlag, unsigned short absOrbit,
  */
      (void) snprintf( sdmf_db, MAX_STRING_LENGTH, "%s/%s", 
                       SDMF_PATH("3.0"), "sdmf_transmission.h5" );
-     H5E_BEGIN_TRY {
-	  fid = H5Fopen( sdmf_db, H5F_ACC_RDONLY, H5P_DEFAULT );
-     } H5E_END_TRY;
+     fid = SDMF_open_file( sdmf_db );
      if ( fid < 0 ) NADC_GOTO_ERROR( NADC_ERR_HDF_FILE, sdmf_db );
 
      if ( wlsFlag ) {
@@ -238,7 +237,6 @@ bool SDMF_get_Transmission_30( bool wlsFlag, unsigned short absOrbit,
  */
  done:
      if ( gid != -1 ) (void) H5Gclose( gid );
-     if ( fid != -1 ) (void) H5Fclose( fid );
 
      return found;
 }
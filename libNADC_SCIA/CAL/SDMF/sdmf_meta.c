@@ -22,7 +22,8 @@
 .COMMENTS    contains SDMF_get_metaIndex, SDMF_get_metaIndex_range,
              SDMF_rd_metaTable
 .ENVIRONment None
-.VERSION     1.5     26-Sep-2011   replaced PyTable routines, RvH 
+.VERSION     1.6     17-Oct-2026   orbitList and orbitIndex are cached, RvH
+             1.5     26-Sep-2011   replaced PyTable routines, RvH 
              1.4     20-Jan-2010   added force_replace flag to documentation
                                    feature was implemented by PvdM, RvH
              1.3     07-Jan-2010   bugs fixed in SDMF_get_metaIndex_range, RvH
@@ -50,8 +51,6 @@
 #include <nadc_sdmf.h>
 
 /*+++++ Static Variables +++++*/
-static const char  listName[] = "orbitList";
-static const char  indexName[] = "orbitIndex";
 static const char  tableName[] = "metaTable";
 
 /*+++++++++++++++++++++++++ Static Function(s) +++++++++++++++*/
@@ -81,11 +80,8 @@ int SDMF_get_metaIndex( hid_t locID, int absOrbit,
      register int nrr;
 
      int   nrows, rowIndex = 0;
-     int   *orbitList = NULL;
-     int   *orbitIndex = NULL;
-
-     herr_t   stat;
-     hsize_t  adim;
+     const int *orbitList = NULL;
+     const int *orbitIndex = NULL;
 
      const int dimArray = *numIndx;
 /*
@@ -94,29 +90,11 @@ int SDMF_get_metaIndex( hid_t locID, int absOrbit,
      *numIndx = 0;            /* default: no matching index found */
      *metaIndx = 0;           /* default: append any new records */
 /*
- * test if dataset "orbitList" exists
+ * obtain (cached) orbitList and orbitIndex, -1 when "orbitList" is absent
  */
-     H5E_BEGIN_TRY {
-          hid_t dataID = H5Dopen( locID, listName, H5P_DEFAULT );
-	  if ( dataID < 0 ) return -1;
-	  (void) H5Dclose( dataID );
-     } H5E_END_TRY;
-/*
- * read orbitList and orbitIndex
- */
-     stat = H5LTget_dataset_info( locID, listName, &adim, NULL, NULL );
-     if ( stat < 0 ) NADC_GOTO_ERROR( NADC_ERR_HDF_SPACE, listName );
-     nrows = (int) adim;
-
-     if ( (orbitList = (int *) malloc( nrows * sizeof(int)))  == NULL )
-	  NADC_GOTO_ERROR( NADC_ERR_ALLOC, "orbitList" );
-     if ( H5LTread_dataset_int( locID, listName, orbitList ) < 0 )
-	  NADC_GOTO_ERROR( NADC_ERR_HDF_DATA, listName );
-
-     if ( (orbitIndex = (int *) malloc( nrows * sizeof(int)))  == NULL )
-	  NADC_GOTO_ERROR( NADC_ERR_ALLOC, "orbitIndex" );
-     if ( H5LTread_dataset_int( locID, indexName, orbitIndex ) < 0 )
-	  NADC_GOTO_ERROR( NADC_ERR_HDF_DATA, indexName );
+     nrows = SDMF_get_orbitIndex( locID, &orbitList, &orbitIndex );
+     if ( IS_ERR_STAT_FATAL ) return rowIndex;
+     if ( nrows < 0 ) return -1;
 /*
  * quick check if new data is within stored orbit range
  */
@@ -142,8 +120,6 @@ int SDMF_get_metaIndex( hid_t locID, int absOrbit,
      }
      rowIndex = nrr;
  done:
-     if ( orbitList != NULL ) free( orbitList );
-     if ( orbitIndex != NULL ) free( orbitIndex );
      return rowIndex;
 }
 
@@ -181,11 +157,8 @@ int SDMF_get_metaIndex_range( hid_t locID, const int *orbit_range,
     
      int   nrows;
      int   rowIndex = -1;
-     int   *orbitList = NULL;
-     int   *orbitIndex = NULL;
-
-     herr_t   stat;
-     hsize_t  adim;
+     const int *orbitList = NULL;
+     const int *orbitIndex = NULL;
 
      int lo = orbit_range[0];
      int hi = orbit_range[1];
@@ -199,29 +172,11 @@ int SDMF_get_metaIndex_range( hid_t locID, const int *orbit_range,
  */
      *numIndx = 0;            /* default: no matching index found */
 /*
- * test if dataset "orbitList" exists
+ * obtain (cached) orbitList and orbitIndex, -1 when "orbitList" is absent
  */
-     H5E_BEGIN_TRY {
-	  hid_t dataID = H5Dopen( locID, listName, H5P_DEFAULT );
-	  if ( dataID < 0 ) return -1;
-	  (void) H5Dclose( dataID );
-     } H5E_END_TRY;
-/*
- * read orbitList and orbitIndex
- */
-     stat = H5LTget_dataset_info( locID, listName, &adim, NULL, NULL );
-     if ( stat < 0 ) NADC_GOTO_ERROR( NADC_ERR_HDF_SPACE, listName );
-     nrows = (int) adim;
-
-     if ( (orbitList = (int *) malloc( nrows * sizeof(int)))  == NULL )
-	  NADC_GOTO_ERROR( NADC_ERR_ALLOC, "orbitList" );
-     if ( H5LTread_dataset_int( locID, listName, orbitList ) < 0 )
-	  NADC_GOTO_ERROR( NADC_ERR_HDF_DATA, listName );
-
-     if ( (orbitIndex = (int *) malloc( nrows * sizeof(int)))  == NULL )
-	  NADC_GOTO_ERROR( NADC_ERR_ALLOC, "orbitIndex" );
-     if ( H5LTread_dataset_int( locID, indexName, orbitIndex ) < 0 )
-	  NADC_GOTO_ERROR( NADC_ERR_HDF_DATA, indexName );
+     nrows = SDMF_get_orbitIndex( locID, &orbitList, &orbitIndex );
+     if ( IS_ERR_STAT_FATAL ) return rowIndex;
+     if ( nrows < 0 ) return -1;
 /*
  * quick check if new data is within stored orbit range, else clip or exit
  */
@@ -288,8 +243,6 @@ int SDMF_get_metaIndex_range( hid_t locID, const int *orbit_range,
      }
      rowIndex = nrr_lo;
 done:
-     if ( orbitList != NULL ) free( orbitList );
-     if ( orbitIndex != NULL ) free( orbitIndex );
      return rowIndex;
 }
 
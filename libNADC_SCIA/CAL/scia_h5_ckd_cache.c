@@ -0,0 +1,245 @@
+/*++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+.COPYRIGHT (c) 2026 SRON (R.M.van.Hees@sron.nl)
+
+   This is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License, version 2, as
+   published by the Free Software Foundation.
+
+   The software is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place - Suite 330,
+   Boston, MA  02111-1307, USA.
+
+.IDENTifer   SCIA_H5_CKD_CACHE
+.AUTHOR      R.M. van Hees
+.KEYWORDS    SCIA - HDF5
+.LANGUAGE    ANSI C
+.PURPOSE     keep SRON calibration key data (CKD) in memory
+.COMMENTS    contains SCIA_GET_H5_MEM, SCIA_GET_H5_NLIN, SCIA_GET_H5_STRAY,
+             SCIA_GET_H5_RSPD and SCIA_FREE_H5_CKD_CACHE
+             - each table is read at most once per process with the
+	       SCIA_RD_H5_* readers, the caller gets a const pointer which
+	       remains valid until SCIA_FREE_H5_CKD_CACHE is called
+	     - the cache key is the database name given by the environment
+	       (SCIA_MEMCORR_DB, SCIA_NLCORR_DB, SCIA_STRAYCORR_DB), a table
+	       is read again when this name changes
+.ENVIRONment SCIA_MEMCORR_DB, SCIA_NLCORR_DB, SCIA_STRAYCORR_DB
+.VERSION      1.0   17-Oct-2026 created by R. M. van Hees
+------------------------------------------------------------*/
+/*
+ * Define _ISOC99_SOURCE to indicate
+ * that this is a ISO C99 program
+ */
+#define  _ISOC99_SOURCE
+
+/*+++++ System headers +++++*/
+#include <stdlib.h>
+#include <string.h>
+
+/*+++++ Local Headers +++++*/
+#define _SCIA_LEVEL_1
+#include <nadc_scia_cal.h>
+
+/*+++++ Static Variables +++++*/
+enum ckd_id { CKD_MEM = 0, CKD_NLIN, CKD_STRAY, CKD_RSPD, NUM_CKD };
+
+static const char * const ckd_env[NUM_CKD] = {
+     "SCIA_MEMCORR_DB", "SCIA_NLCORR_DB", "SCIA_STRAYCORR_DB", NULL
+};
+
+static struct {
+     bool loaded;
+     char db_name[MAX_STRING_LENGTH];
+} ckd_key[NUM_CKD];
+
+static struct scia_memcorr   ckd_mem   = {{0,0}, NULL};
+static struct scia_nlincorr  ckd_nlin  = {{0,0}, NULL, NULL};
+static struct scia_straycorr ckd_stray = {{0,0}, NULL, NULL, NULL,
+					  {0,0}, NULL};
+static struct rspd_key       ckd_rspd;
+
+/*+++++ Macros +++++*/
+        /* NONE */
+
+/*+++++ Global Variables +++++*/
+        /* NONE */
+
+/*+++++++++++++++++++++++++ Static Functions +++++++++++++++++++++++*/
+static
+void FREE_H5_RSPD( struct rspd_key *key )
+{
+     if ( key->elev_p  != NULL ) free( key->elev_p );
+     if ( key->elev_s  != NULL ) free( key->elev_s );
+     if ( key->el_az_p != NULL ) free( key->el_az_p );
+     if ( key->el_az_s != NULL ) free( key->el_az_s );
+     if ( key->brdf_p  != NULL ) free( key->brdf_p );
+     if ( key->brdf_s  != NULL ) free( key->brdf_s );
+     (void) memset( key, 0, sizeof(struct rspd_key) );
+}
+
+static
+void FREE_CKD( enum ckd_id id )
+{
+     switch ( id ) {
+     case CKD_MEM:
+	  SCIA_FREE_H5_MEM( &ckd_mem );
+	  (void) memset( &ckd_mem, 0, sizeof(struct scia_memcorr) );
+	  break;
+     case CKD_NLIN:
+	  SCIA_FREE_H5_NLIN( &ckd_nlin );
+	  (void) memset( &ckd_nlin, 0, sizeof(struct scia_nlincorr) );
+	  break;
+     case CKD_STRAY:
+	  SCIA_FREE_H5_STRAY( &ckd_stray );
+	  (void) memset( &ckd_stray, 0, sizeof(struct scia_straycorr) );
+	  break;
+     case CKD_RSPD:
+	  FREE_H5_RSPD( &ckd_rspd );
+	  break;
+     default:
+	  break;
+     }
+     ckd_key[id].loaded = FALSE;
+     ckd_key[id].db_name[0] = '\0';
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   CKD_IS_CACHED
+.PURPOSE     check if table is in memory, and read with the same database
+.INPUT/OUTPUT
+  call as    cached = CKD_IS_CACHED( id );
+     input:
+            enum ckd_id id :  identifier of the CKD table
+
+.RETURNS     TRUE when the table can be used as it is (bool)
+.COMMENTS    static function, releases an outdated table
+-------------------------*/
+static
+bool CKD_IS_CACHED( enum ckd_id id )
+{
+     const char *env_str = NULL;
+     char db_name[MAX_STRING_LENGTH] = "";
+
+     if ( ckd_env[id] != NULL && (env_str = getenv( ckd_env[id] )) != NULL )
+	  (void) nadc_strlcpy( db_name, env_str, MAX_STRING_LENGTH );
+
+     if ( ckd_key[id].loaded ) {
+	  if ( strcmp( ckd_key[id].db_name, db_name ) == 0 ) return TRUE;
+	  FREE_CKD( id );
+     }
+     (void) strcpy( ckd_key[id].db_name, db_name );
+     return FALSE;
+}
+
+/*+++++++++++++++++++++++++ Main Program or Function +++++++++++++++*/
+/*+++++++++++++++++++++++++
+.IDENTifer   SCIA_GET_H5_MEM
+.PURPOSE     obtain table for Reticon memory correction
+.INPUT/OUTPUT
+  call as    memcorr = SCIA_GET_H5_MEM();
+
+.RETURNS     pointer to memory correction table, NULL on failure
+.COMMENTS    do not release the returned table
+-------------------------*/
+const struct scia_memcorr *SCIA_GET_H5_MEM( void )
+{
+     if ( CKD_IS_CACHED( CKD_MEM ) ) return &ckd_mem;
+
+     SCIA_RD_H5_MEM( &ckd_mem );
+     if ( IS_ERR_STAT_FATAL ) {
+	  FREE_CKD( CKD_MEM );
+	  return NULL;
+     }
+     ckd_key[CKD_MEM].loaded = TRUE;
+     return &ckd_mem;
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   SCIA_GET_H5_NLIN
+.PURPOSE     obtain table for Epitaxx non-linearity correction
+.INPUT/OUTPUT
+  call as    nlcorr = SCIA_GET_H5_NLIN();
+
+.RETURNS     pointer to non-linearity correction table, NULL on failure
+.COMMENTS    do not release the returned table
+-------------------------*/
+const struct scia_nlincorr *SCIA_GET_H5_NLIN( void )
+{
+     if ( CKD_IS_CACHED( CKD_NLIN ) ) return &ckd_nlin;
+
+     SCIA_RD_H5_NLIN( &ckd_nlin );
+     if ( IS_ERR_STAT_FATAL ) {
+	  FREE_CKD( CKD_NLIN );
+	  return NULL;
+     }
+     ckd_key[CKD_NLIN].loaded = TRUE;
+     return &ckd_nlin;
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   SCIA_GET_H5_STRAY
+.PURPOSE     obtain straylight correction matrix
+.INPUT/OUTPUT
+  call as    stray = SCIA_GET_H5_STRAY();
+
+.RETURNS     pointer to straylight correction matrix, NULL on failure
+.COMMENTS    do not release the returned matrix
+-------------------------*/
+const struct scia_straycorr *SCIA_GET_H5_STRAY( void )
+{
+     if ( CKD_IS_CACHED( CKD_STRAY ) ) return &ckd_stray;
+
+     SCIA_RD_H5_STRAY( &ckd_stray );
+     if ( IS_ERR_STAT_FATAL ) {
+	  FREE_CKD( CKD_STRAY );
+	  return NULL;
+     }
+     ckd_key[CKD_STRAY].loaded = TRUE;
+     return &ckd_stray;
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   SCIA_GET_H5_RSPD
+.PURPOSE     obtain keydata to calculate Radiance Sensitivity Parameters
+.INPUT/OUTPUT
+  call as    key = SCIA_GET_H5_RSPD();
+
+.RETURNS     pointer to radiance sensitivity keydata, NULL on failure
+.COMMENTS    do not release the returned keydata
+-------------------------*/
+const struct rspd_key *SCIA_GET_H5_RSPD( void )
+{
+     if ( CKD_IS_CACHED( CKD_RSPD ) ) return &ckd_rspd;
+
+     (void) memset( &ckd_rspd, 0, sizeof(struct rspd_key) );
+     SCIA_RD_H5_RSPD( &ckd_rspd );
+     if ( IS_ERR_STAT_FATAL ) {
+	  FREE_CKD( CKD_RSPD );
+	  return NULL;
+     }
+     ckd_key[CKD_RSPD].loaded = TRUE;
+     return &ckd_rspd;
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   SCIA_FREE_H5_CKD_CACHE
+.PURPOSE     release all calibration key data kept in memory
+.INPUT/OUTPUT
+  call as    SCIA_FREE_H5_CKD_CACHE();
+
+.RETURNS     nothing
+.COMMENTS    pointers obtained with SCIA_GET_H5_* are invalid afterwards
+-------------------------*/
+void SCIA_FREE_H5_CKD_CACHE( void )
+{
+     register int id;
+
+     for ( id = 0; id < NUM_CKD; id++ ) {
+	  if ( ckd_key[id].loaded ) FREE_CKD( (enum ckd_id) id );
+     }
+}
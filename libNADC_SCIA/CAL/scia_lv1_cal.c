@@ -31,9 +31,23 @@
             struct mds1c_scia *mds_1c : level 1c MDS records
 
 .RETURNS     Nothing, error status passed by global variable ``nadc_stat''
-.COMMENTS    None
+.COMMENTS    when the parameter flag_cal_fused is set (option -cal_fused),
+             consecutive per-pixel corrections (ATBD Dark, PPG and Etalon, 
+	     BDPM and Transmission) are applied in one pass over the data.
+	     The limb, state and SRON dark corrections are not fused.
+	     When the parameter flag_cal_spec is set (option -cal_spec), 
+	     the spectra of a state are copied once to a container, which 
+	     groups the clusters with the same read-out (see
+	     scia_lv1c_spec.c). The ATBD Dark, PPG, Etalon, BDPM and 
+	     Transmission corrections are applied on the container, it is 
+	     copied back before any other correction. This takes 
+	     precedence over flag_cal_fused.
 .ENVIRONment None
-.VERSION      6.4   15-Mar-2011  add USE_SDMF_VERSION & fileParam.sdmf_version
+.VERSION      6.8   17-Oct-2026  container mode selected by flag_cal_spec, RvH
+              6.7   17-Oct-2026  fused mode includes the ATBD dark, RvH
+              6.6   17-Oct-2026  fused mode is selected by flag_cal_fused, RvH
+              6.5   17-Oct-2026  fused mode for per-pixel corrections, RvH
+              6.4   15-Mar-2011  add USE_SDMF_VERSION & fileParam.sdmf_version
                                  free allocated memory in fileParam, RvH
               6.3   30-Jul-2007  added m-factor correction, KB (Ife Bremen)
               6.2   14-Mar-2006  fixed stupid bug when n_pmd is zero, RvH
@@ -128,6 +142,7 @@
 
 #define __NEED_GRID_ACCURACY__
 #include "CalibModules/calibCalcError.inc"
+#include "CalibModules/getCorrIntg.inc"
 
 /*+++++ Macros +++++*/
 	/* NONE */
@@ -264,6 +279,184 @@ void initFileParam( const unsigned int calib_flag, FILE *fp,
 		    SCIENCE_CHANNELS + 1 );
 }
 
+/*
+ * fused mode: apply the ATBD Dark, PPG and Etalon correction in one pass 
+ * over the data, the expressions are identical to those of the separate 
+ * modules to produce bit-identical results
+ */
+static
+void SCIA_CAL_FUSED_DARK_PPG_ETALON( const struct file_rec *fileParam,
+				     const struct state1_scia *state,
+				     bool do_dark, bool do_ppg_etalon,
+				     struct mds1c_scia *mds_1c )
+{
+     register unsigned short num = 0u;
+     register unsigned short npix;
+
+     const struct DarkRec *darkData = NULL;
+     const float *ppg_fact = NULL;
+     const float *etalon   = NULL;
+
+     const bool do_calc_error = 
+	  (fileParam->calibFlag & DO_CALC_ERROR) != UINT_ZERO;
+
+     bool  ppg_zero[CHANNEL_SIZE];
+     float ppg_clus[CHANNEL_SIZE];
+     float etalon_clus[CHANNEL_SIZE];
+     float analog_clus[CHANNEL_SIZE];
+     float noise_clus[CHANNEL_SIZE];
+     float dark_clus[CHANNEL_SIZE];
+     float dark_err_clus[CHANNEL_SIZE];
+
+     if ( do_dark 
+	  && (darkData = SCIA_ATBD_GET_DARK( fileParam, state, 
+					     (int) mds_1c->type_mds )) == NULL )
+	  NADC_RETURN_ERROR( NADC_ERR_FATAL, "DARK" );
+     if ( do_ppg_etalon ) {
+	  if ( (fileParam->calibFlag & DO_CORR_PPG) != UINT_ZERO
+	       && (ppg_fact = SCIA_ATBD_GET_PPG( fileParam )) == NULL )
+	       NADC_RETURN_ERROR( NADC_ERR_FATAL, "PPG" );
+	  if ( (fileParam->calibFlag & DO_CORR_ETALON) != UINT_ZERO
+	       && (etalon = SCIA_ATBD_GET_ETALON( fileParam )) == NULL )
+	       NADC_RETURN_ERROR( NADC_ERR_FATAL, "Etalon" );
+     }
+
+     do {
+	  register unsigned short nobs = 0u;
+	  register float *signal   = mds_1c->pixel_val;
+	  register float *e_signal = mds_1c->pixel_err;
+
+	  const bool do_dark_error = (darkData != NULL) && do_calc_error;
+	  const bool do_ppg_error  = (ppg_fact != NULL) && do_calc_error;
+	  const float electron_bu = fileParam->electron_bu[mds_1c->chan_id-1];
+/*
+ * factors of the pixels of this cluster, dividing by one is exact
+ */
+	  for ( npix = 0; npix < mds_1c->num_pixels; npix++ ) {
+	       const unsigned short id = mds_1c->pixel_ids[npix];
+
+	       ppg_clus[npix] = (ppg_fact != NULL) ? ppg_fact[id] : 1.f;
+	       ppg_zero[npix] = fabsf( ppg_clus[npix] ) < 1e-3;
+	       etalon_clus[npix] = (etalon != NULL) ? etalon[id] : 1.f;
+	  }
+/*
+ * dark parameters of the pixels of this cluster (as SCIA_ATBD_CAL_DARK)
+ */
+	  if ( darkData != NULL ) {
+	       const float intg = getCorrIntg( state->Clcon[num] );
+	       const unsigned short id0 = mds_1c->pixel_ids[0];
+
+	       for ( npix = 0; npix < mds_1c->num_pixels; npix++ ) {
+		    const unsigned short id = id0 + npix;
+		    register double derror = 
+			 sqrt( (double) mds_1c->coaddf ) 
+			 * darkData->AnalogOffsError[id]
+			 + intg * darkData->DarkCurrentError[id];
+
+		    analog_clus[npix] = 
+			 mds_1c->coaddf * darkData->AnalogOffs[id];
+		    noise_clus[npix] = mds_1c->coaddf 
+			 * darkData->MeanNoise[id] * darkData->MeanNoise[id];
+		    dark_clus[npix] = 
+			 (float) mds_1c->coaddf * darkData->AnalogOffs[id]
+			 + intg * darkData->DarkCurrent[id];
+		    dark_err_clus[npix] = (float) (derror * derror);
+	       }
+	  }
+	  do {
+	       for ( npix = 0; npix < mds_1c->num_pixels; npix++ ) {
+		    register float val = signal[npix];
+
+		    if ( darkData != NULL ) {
+			 if ( do_dark_error ) {
+			      e_signal[npix] = 
+				   fabsf( val - analog_clus[npix] ) / electron_bu
+				   + noise_clus[npix];
+			 }
+			 val -= dark_clus[npix];
+			 if ( do_dark_error ) 
+			      e_signal[npix] += dark_err_clus[npix];
+		    }
+		    if ( do_ppg_error ) {
+			 register double derror = fileParam->ppgError * val;
+
+			 e_signal[npix] += (float) (derror * derror);
+		    }
+		    val = ppg_zero[npix] ? 0.f : val / ppg_clus[npix];
+		    signal[npix] = val / etalon_clus[npix];
+	       }
+	       signal += mds_1c->num_pixels;
+	       if ( do_calc_error ) e_signal += mds_1c->num_pixels;
+	  } while ( ++nobs < mds_1c->num_obs );
+     } while ( mds_1c++, ++num < state->num_clus );
+}
+
+/*
+ * fused mode: apply bad/dead pixel mask and Transmission correction 
+ * in one pass over the data
+ */
+static
+void SCIA_CAL_FUSED_MASK_TRANS( const struct file_rec *fileParam,
+				const struct state1_scia *state,
+				struct mds1c_scia *mds_1c )
+{
+     register unsigned short num = 0u;
+     register unsigned short npix;
+
+     const unsigned char *bdpm = NULL;
+
+     bool  mask_clus[CHANNEL_SIZE];
+     float trans_avg = 1.f;
+
+     if ( (fileParam->calibFlag & DO_MASK_BDPM) != UINT_ZERO ) {
+	  if ( (fileParam->calibFlag & DO_SRON_BDPM) != UINT_ZERO )
+	       bdpm = SCIA_SRON_GET_BDPM( fileParam );
+	  else
+	       bdpm = SCIA_ATBD_GET_BDPM( fileParam );
+	  if ( bdpm == NULL )
+	       NADC_RETURN_ERROR( NADC_ERR_FATAL, "BDPM" );
+     }
+     if ( (fileParam->calibFlag & DO_SRON_TRANS) != UINT_ZERO ) {
+	  trans_avg = SCIA_SRON_GET_TRANS( fileParam );
+	  if ( IS_ERR_STAT_FATAL )
+	       NADC_RETURN_ERROR( NADC_ERR_FATAL, "TRANSMISSION" );
+     }
+
+     do {
+	  register unsigned short nobs = 0u;
+	  register float *signal = mds_1c->pixel_val;
+
+	  for ( npix = 0; npix < mds_1c->num_pixels; npix++ ) {
+	       mask_clus[npix] = (bdpm != NULL)
+		    && bdpm[mds_1c->pixel_ids[npix]] != UCHAR_ZERO;
+	  }
+	  do {
+	       for ( npix = 0; npix < mds_1c->num_pixels; npix++ ) {
+		    signal[npix] = mask_clus[npix] ?
+			 NAN : signal[npix] / trans_avg;
+	       }
+	       signal += mds_1c->num_pixels;
+	  } while ( ++nobs < mds_1c->num_obs );
+     } while ( mds_1c++, ++num < state->num_clus );
+}
+
+/*
+ * container mode: keep the spectra in the container for consecutive
+ * corrections which support it, copy them back before any other correction
+ */
+static
+void SCIA_CAL_SPEC_SYNC( bool use_spec, const struct state1_scia *state,
+			 struct mds1c_scia *mds_1c, struct spec1c_scia *spec )
+{
+     if ( use_spec ) {
+	  if ( spec->num_grp == 0 )
+	       SCIA_LV1C_SPEC_FILL( state->num_clus, mds_1c, spec );
+     } else if ( spec->num_grp > 0 ) {
+	  SCIA_LV1C_SPEC_STORE( spec, state->num_clus, mds_1c );
+	  SCIA_LV1C_SPEC_FREE( spec );
+     }
+}
+
 /*+++++++++++++++++++++++++ Main Program or Function +++++++++++++++*/
 void SCIA_LV1_CAL( FILE *fp, 
 		   unsigned int calib_flag, const struct state1_scia state[],
@@ -273,6 +466,8 @@ void SCIA_LV1_CAL( FILE *fp,
 
      static struct wvlen_rec wvlen;
 
+     struct spec1c_scia spec;
+
      static struct file_rec fileParam = {
 	 /* KB: empty string for sensing start added */
 	  NULL, " ", " ", " ", " ", " ", " ", " ", " ",
@@ -289,6 +484,29 @@ void SCIA_LV1_CAL( FILE *fp,
      const int do_corr_dark =
          ((calib_flag & (DO_CORR_AO|DO_CORR_DARK|DO_CORR_VDARK|DO_CORR_VSTRAY))
           != UINT_ZERO);
+     const int do_atbd_ppg_etalon =
+	  (calib_flag & (DO_CORR_PPG|DO_CORR_ETALON)) != UINT_ZERO
+	  && ((calib_flag & DO_CORR_PPG) == UINT_ZERO
+	      || (calib_flag & DO_SRON_PPG) == UINT_ZERO);
+     const int do_atbd_dark = do_corr_dark
+	  && (calib_flag & (DO_CORR_ADARK|DO_SRON_DARK)) == UINT_ZERO
+	  && ! ((int) mds_1c->type_mds == SCIA_LIMB 
+		&& (calib_flag & DO_CORR_LDARK) != UINT_ZERO);
+     const int do_spec =
+	  (nadc_get_param_uint8_id( PARAM_FLAG_CAL_SPEC ) == PARAM_SET);
+     const int do_spec_dark = do_spec && do_atbd_dark;
+     const int do_spec_ppg = do_spec
+	  && (calib_flag & DO_CORR_PPG) != UINT_ZERO
+	  && (calib_flag & DO_SRON_PPG) == UINT_ZERO;
+     const int do_fused = ! do_spec
+	  && (nadc_get_param_uint8_id( PARAM_FLAG_CAL_FUSED ) == PARAM_SET);
+     const int do_fused_dark = do_fused && do_atbd_dark
+	  && (calib_flag & DO_SRON_NOISE) == UINT_ZERO;
+     const int do_fused_ppg_etalon = do_fused && do_atbd_ppg_etalon;
+     const int do_fused_mask_trans = do_fused
+	  && (calib_flag & (DO_MASK_BDPM|DO_SRON_TRANS)) != UINT_ZERO;
+
+     spec.num_grp = 0;
 /*
  * Any calibration needed?
  */
@@ -331,7 +549,12 @@ void SCIA_LV1_CAL( FILE *fp,
 /*
  * apply Dark correction
  */
-     if ( do_corr_dark ) {
+     if ( do_spec_dark ) {
+	  SCIA_CAL_SPEC_SYNC( TRUE, state, mds_1c, &spec );
+	  SCIA_ATBD_CAL_DARK_SPEC( &fileParam, state, &spec );
+	  if ( IS_ERR_STAT_FATAL )
+	       NADC_GOTO_ERROR( NADC_ERR_FATAL, "DARK" );
+     } else if ( do_corr_dark && ! do_fused_dark ) {
 	  if ( (calib_flag & DO_CORR_ADARK) != UINT_ZERO )
 	       SCIA_STATE_CAL_DARK( &fileParam, state, mds_1c );
 	  else if ( (calib_flag & DO_SRON_DARK) != UINT_ZERO )
@@ -345,14 +568,31 @@ void SCIA_LV1_CAL( FILE *fp,
  * estimate measurement noise (channel 8)
  */
      if ( (calib_flag & DO_SRON_NOISE) != UINT_ZERO ) {
+	  SCIA_CAL_SPEC_SYNC( FALSE, state, mds_1c, &spec );
 	  SCIA_SRON_CAL_NOISE( &fileParam, state, mds_1c );
 	  if ( IS_ERR_STAT_FATAL )
 	       NADC_GOTO_ERROR( NADC_ERR_FATAL, "NOISE" );
      }
+/*
+ * in fused mode: apply the ATBD Dark, PPG and Etalon correction in one pass
+ */
+     if ( do_fused_dark || do_fused_ppg_etalon ) {
+	  SCIA_CAL_FUSED_DARK_PPG_ETALON( &fileParam, state, do_fused_dark,
+					  do_fused_ppg_etalon, mds_1c );
+	  if ( IS_ERR_STAT_FATAL )
+	       NADC_GOTO_ERROR( NADC_ERR_FATAL, "Dark/PPG/Etalon" );
+     }
 /*
  * apply PPG Correction
  */
-     if ( (calib_flag & DO_CORR_PPG) != UINT_ZERO ) {
+     if ( do_spec_ppg ) {
+	  SCIA_CAL_SPEC_SYNC( TRUE, state, mds_1c, &spec );
+	  SCIA_ATBD_CAL_PPG_SPEC( &fileParam, &spec );
+	  if ( IS_ERR_STAT_FATAL )
+	       NADC_GOTO_ERROR( NADC_ERR_FATAL, "PPG" );
+     } else if ( ! do_fused_ppg_etalon
+	  && (calib_flag & DO_CORR_PPG) != UINT_ZERO ) {
+	  SCIA_CAL_SPEC_SYNC( FALSE, state, mds_1c, &spec );
 	  if ( (calib_flag & DO_SRON_PPG) != UINT_ZERO )
 	       SCIA_SRON_CAL_PPG( &fileParam, state, mds_1c );
 	  else
@@ -363,7 +603,13 @@ void SCIA_LV1_CAL( FILE *fp,
 /*
  * apply Etalon Correction
  */
-     if ( (calib_flag & DO_CORR_ETALON) != UINT_ZERO ) {
+     if ( do_spec && (calib_flag & DO_CORR_ETALON) != UINT_ZERO ) {
+	  SCIA_CAL_SPEC_SYNC( TRUE, state, mds_1c, &spec );
+	  SCIA_ATBD_CAL_ETALON_SPEC( &fileParam, &spec );
+	  if ( IS_ERR_STAT_FATAL )
+	       NADC_GOTO_ERROR( NADC_ERR_FATAL, "Etalon" );
+     } else if ( ! do_fused_ppg_etalon
+	  && (calib_flag & DO_CORR_ETALON) != UINT_ZERO ) {
 	  SCIA_ATBD_CAL_ETALON( &fileParam, state, mds_1c );
 	  if ( IS_ERR_STAT_FATAL )
 	       NADC_GOTO_ERROR( NADC_ERR_FATAL, "Etalon" );
@@ -372,6 +618,7 @@ void SCIA_LV1_CAL( FILE *fp,
  * apply Straylight Correction
  */
      if ( (calib_flag & DO_CORR_STRAY) != UINT_ZERO ) {
+	  SCIA_CAL_SPEC_SYNC( FALSE, state, mds_1c, &spec );
 	  SCIA_ATBD_CAL_STRAY( fileParam.strayError, state, mds_1b, mds_1c );
 	  if ( IS_ERR_STAT_FATAL )
 	       NADC_GOTO_ERROR( NADC_ERR_FATAL, "StrayLight" );
@@ -380,8 +627,10 @@ void SCIA_LV1_CAL( FILE *fp,
  * calculate Precision Error on spectra
  */
      if ( (calib_flag & DO_SRON_NOISE) == UINT_ZERO
-	  && (calib_flag & DO_CALC_ERROR) != UINT_ZERO )
+	  && (calib_flag & DO_CALC_ERROR) != UINT_ZERO ) {
+	  SCIA_CAL_SPEC_SYNC( FALSE, state, mds_1c, &spec );
 	  calcSpectralAccuracy( state, mds_1c );
+     }
 /*
  * calculate Wavelength Grid
  */
@@ -394,6 +643,7 @@ void SCIA_LV1_CAL( FILE *fp,
  * apply Polarisation Correction
  */
      if ( (calib_flag & DO_CORR_POL) != UINT_ZERO ) {
+	  SCIA_CAL_SPEC_SYNC( FALSE, state, mds_1c, &spec );
 	  SCIA_ATBD_CAL_POL( &fileParam, wvlen, state, mds_1b, mds_1c );
 	  if ( IS_ERR_STAT_FATAL )
 	       NADC_GOTO_ERROR( NADC_ERR_FATAL, "POL" );
@@ -402,6 +652,7 @@ void SCIA_LV1_CAL( FILE *fp,
  * apply Radiance Sensitivity Correction
  */
      if ( (calib_flag & DO_CORR_RAD) != UINT_ZERO ) {
+	  SCIA_CAL_SPEC_SYNC( FALSE, state, mds_1c, &spec );
 	  SCIA_ATBD_CAL_RAD( &fileParam, wvlen, state, mds_1c );
 	  if ( IS_ERR_STAT_FATAL )
 	       NADC_GOTO_ERROR( NADC_ERR_FATAL, "RAD" );
@@ -410,6 +661,7 @@ void SCIA_LV1_CAL( FILE *fp,
  * covert Radiances to Reflectances
  */
      if ( (calib_flag & DO_DIVIDE_SUN) != UINT_ZERO ) {
+	  SCIA_CAL_SPEC_SYNC( FALSE, state, mds_1c, &spec );
 	  if ( (calib_flag & DO_SRON_SUN) != UINT_ZERO ) {
                SCIA_SRON_CAL_REFL( &fileParam, state, mds_1c );
 	  } else {
@@ -418,10 +670,27 @@ void SCIA_LV1_CAL( FILE *fp,
 	  if ( IS_ERR_STAT_FATAL )
 	       NADC_GOTO_ERROR( NADC_ERR_FATAL, "REFL" );
      }
+/*
+ * in fused mode: apply Bad Pixel Mask and Transmission correction at once
+ */
+     if ( do_fused_mask_trans ) {
+	  SCIA_CAL_FUSED_MASK_TRANS( &fileParam, state, mds_1c );
+	  if ( IS_ERR_STAT_FATAL )
+	       NADC_GOTO_ERROR( NADC_ERR_FATAL, "BDPM/TRANSMISSION" );
+	  goto done;
+     }
 /*
  * apply Bad Pixel Mask
  */
-     if ( (calib_flag & DO_MASK_BDPM) != UINT_ZERO ) {
+     if ( do_spec && (calib_flag & DO_MASK_BDPM) != UINT_ZERO ) {
+	  SCIA_CAL_SPEC_SYNC( TRUE, state, mds_1c, &spec );
+	  if ( (calib_flag & DO_SRON_BDPM) != UINT_ZERO )
+	       SCIA_SRON_FLAG_BDPM_SPEC( &fileParam, &spec );
+	  else
+	       SCIA_ATBD_FLAG_BDPM_SPEC( &fileParam, &spec );
+	  if ( IS_ERR_STAT_FATAL )
+	       NADC_GOTO_ERROR( NADC_ERR_FATAL, "BDPM" );
+     } else if ( (calib_flag & DO_MASK_BDPM) != UINT_ZERO ) {
 	  if ( (calib_flag & DO_SRON_BDPM) != UINT_ZERO )
 	       SCIA_SRON_FLAG_BDPM( &fileParam, state, mds_1c );
 	  else
@@ -432,12 +701,22 @@ void SCIA_LV1_CAL( FILE *fp,
 /*
  * apply Transmission correction
  */
-     if ( (calib_flag & DO_SRON_TRANS) != UINT_ZERO ) {
+     if ( do_spec && (calib_flag & DO_SRON_TRANS) != UINT_ZERO ) {
+	  SCIA_CAL_SPEC_SYNC( TRUE, state, mds_1c, &spec );
+	  SCIA_SRON_CAL_TRANS_SPEC( &fileParam, &spec );
+	  if ( IS_ERR_STAT_FATAL )
+	       NADC_GOTO_ERROR( NADC_ERR_FATAL, "TRANSMISSION" );
+     } else if ( (calib_flag & DO_SRON_TRANS) != UINT_ZERO ) {
 	  SCIA_SRON_CAL_TRANS( &fileParam, state, mds_1c );
 	  if ( IS_ERR_STAT_FATAL )
 	       NADC_GOTO_ERROR( NADC_ERR_FATAL, "TRANSMISSION" );
      }
+/*
+ * in container mode: copy the spectra back to the level 1c MDS
+ */
+     SCIA_CAL_SPEC_SYNC( FALSE, state, mds_1c, &spec );
 done:
+     SCIA_LV1C_SPEC_FREE( &spec );
      fileParam.flagInitFile = FALSE;
      free( fileParam.dsd );
 }
@@ -33,7 +33,11 @@
                    handle PET < 1/32 correctly
 		   handle spikes in the PMD readouts correctly
 .ENVIRONment None
-.VERSION     6.0     21-Apr-2013   verified stray-light correction, RvH
+.VERSION     6.3     17-Oct-2026   check of SCIA_STRAY_GEMM (DEBUG only), RvH
+             6.2     17-Oct-2026   straylight matrix applied to all observations
+                                   of a state at once, RvH
+             6.1     17-Oct-2026   use cached SRON calibration key data, RvH
+             6.0     21-Apr-2013   verified stray-light correction, RvH
              5.1     11-Jan-2013   fixed memory corruption bug which occured
                                    when not all channels where processed, RvH
              5.0     23-Aug-2011   re-write to include stray-light correction,
@@ -88,6 +92,10 @@
 #define FLAG_UNUSED           ((unsigned char) 0x10U)
 #define FLAG_BLINDED          ((unsigned char) 0x20U)
 
+#define STRAY_BLOCK_ROWS      64     /* rows of straylight matrix per block */
+#define STRAY_BLOCK_OBS       4      /* observations per micro-kernel */
+#define STRAY_GEMM_TOL        (2 * FLT_EPSILON) /* see SCIA_STRAY_GEMM */
+
 /*+++++ Static Variables +++++*/
 struct scia_cal_rec {
      unsigned char    state_id;
@@ -597,12 +605,11 @@ void SCIA_CALC_MEM_CORR( struct scia_cal_rec *scia_cal )
 
      double scale_reset;
 
-     struct scia_memcorr memcorr = {{0,0}, NULL};
+     const struct scia_memcorr *memcorr;
 
      /* read memory correction values */
-     SCIA_RD_H5_MEM( &memcorr );
-     if ( IS_ERR_STAT_FATAL )
-	  NADC_GOTO_ERROR( NADC_ERR_HDF_RD, "SCIA_RD_H5_MEM" );
+     if ( (memcorr = SCIA_GET_H5_MEM()) == NULL )
+	  NADC_RETURN_ERROR( NADC_ERR_HDF_RD, "SCIA_GET_H5_MEM" );
 
      if ( scia_cal->limb_scans == 0 ) {
 
@@ -641,14 +648,14 @@ void SCIA_CALC_MEM_CORR( struct scia_cal_rec *scia_cal )
 	       /* calculate memory correction for first readout of a state */
 	       signNorm = __ROUND_us( scia_cal->dark_signal[np]
 				      + scale_reset * scia_cal->spectra[np][0]);
-	       scia_cal->correction[np][0] = memcorr.matrix[nchan][signNorm];
+	       scia_cal->correction[np][0] = memcorr->matrix[nchan][signNorm];
 
 	       /* use previous readout to calculate correction next readout */
 	       while ( ++no < scia_cal->chan_obs[vchan] ) {
 		    signNorm = __ROUND_us( scia_cal->dark_signal[np]
 					   + scia_cal->spectra[np][no-1] );
 		    scia_cal->correction[np][no] = 
-			 memcorr.matrix[nchan][signNorm];
+			 memcorr->matrix[nchan][signNorm];
 	       };
 	  } while ( ++np < (VIS_CHANNELS * CHANNEL_SIZE) );
      } else {                                              /* limb profiles */
@@ -685,7 +692,7 @@ void SCIA_CALC_MEM_CORR( struct scia_cal_rec *scia_cal )
 	       /* calculate memory correction for first readout of a state */
 	       signNorm = __ROUND_us( scia_cal->dark_signal[np]
 				      + scale_reset * scia_cal->spectra[np][0]);
-	       scia_cal->correction[np][0] = memcorr.matrix[nchan][signNorm];
+	       scia_cal->correction[np][0] = memcorr->matrix[nchan][signNorm];
 
 	       /* use previous readout to calculate correction next readout */
 	       while ( ++no < scia_cal->chan_obs[vchan] ) {
@@ -700,12 +707,10 @@ void SCIA_CALC_MEM_CORR( struct scia_cal_rec *scia_cal )
 						+ scia_cal->spectra[np][no-1] );
 		    }
 		    scia_cal->correction[np][no] = 
-			 memcorr.matrix[nchan][signNorm];
+			 memcorr->matrix[nchan][signNorm];
 	       }
 	  } while ( ++np < (VIS_CHANNELS * CHANNEL_SIZE) );
      }
-done:
-     SCIA_FREE_H5_MEM( &memcorr );
 }
 
 /*+++++++++++++++++++++++++
@@ -729,11 +734,10 @@ void SCIA_CALC_NLIN_CORR( struct scia_cal_rec *scia_cal )
      register unsigned short signNorm;
      register unsigned short curveIndx;
 
-     struct scia_nlincorr nlcorr = {{0,0}, NULL, NULL};
+     const struct scia_nlincorr *nlcorr;
 
-     SCIA_RD_H5_NLIN( &nlcorr );
-     if ( IS_ERR_STAT_FATAL ) 
-	  NADC_GOTO_ERROR( NADC_ERR_HDF_RD, "SCIA_RD_H5_NLIN" );
+     if ( (nlcorr = SCIA_GET_H5_NLIN()) == NULL )
+	  NADC_RETURN_ERROR( NADC_ERR_HDF_RD, "SCIA_GET_H5_NLIN" );
 
      do {
 	  register unsigned short nobs = 0;
@@ -744,7 +748,7 @@ void SCIA_CALC_NLIN_CORR( struct scia_cal_rec *scia_cal )
 	  if ( vchan == USHRT_MAX ) continue;         /* skip un-used pixels */
 
 	  /* get index to curve to be used */
-	  curveIndx = (unsigned short) nlcorr.curve[np];
+	  curveIndx = (unsigned short) nlcorr->curve[np];
 
 	  /* set index to first readout */
 	  do {
@@ -753,13 +757,10 @@ void SCIA_CALC_NLIN_CORR( struct scia_cal_rec *scia_cal )
 					   + scia_cal->spectra[np][nobs] );
 
 		    scia_cal->correction[np][nobs] = 
-			 nlcorr.matrix[curveIndx][signNorm];
+			 nlcorr->matrix[curveIndx][signNorm];
 	       }
 	  } while ( ++nobs < scia_cal->chan_obs[vchan] );
      } while ( ++np < SCIENCE_PIXELS );
-
-done:
-     SCIA_FREE_H5_NLIN( &nlcorr );
 }
 
 /*+++++++++++++++++++++++++
@@ -1107,6 +1108,157 @@ void SCIA_CALC_STRAY_GHOSTS( const struct scia_straycorr *stray,
      }
 }
 
+/*+++++++++++++++++++++++++
+.IDENTifer   SCIA_STRAY_GEMM
+.PURPOSE     apply straylight matrix to the reduced spectra of all readouts
+.INPUT/OUTPUT
+  call as    SCIA_STRAY_GEMM( stray, grid_deriv, num_obs, spec_r, stray_r );
+     input:
+	    struct scia_straycorr *stray :  straylight keydata
+	    float  *grid_deriv           :  output sampling distance [dims[0]]
+	    size_t num_obs               :  number of readouts
+	    double *spec_r               :  reduced spectra [num_obs][dims[1]]
+    output:
+	    float  *stray_r              :  straylight [num_obs][dims[0]]
+
+.RETURNS     nothing
+.COMMENTS    static function
+             computes stray_r = spec_r # transpose(matrix) / grid_deriv,
+	     blocked over rows of the matrix, which are kept in cache while
+	     all readouts are processed, and over STRAY_BLOCK_OBS readouts,
+	     which share each element of the matrix loaded in a register.
+	     The inner loop keeps 4 independent partial sums, which the
+	     compiler maps on SIMD registers.
+	     The partial sums change the order of the (double precision)
+	     additions with respect to a matrix-vector product per readout,
+	     therefore, a result may differ in the last bit of the float.
+	     Compile with DEBUG to compare with the matrix-vector product,
+	     see SCIA_STRAY_GEMM_CHECK
+-------------------------*/
+static
+void SCIA_STRAY_GEMM( const struct scia_straycorr *stray,
+		      const float *grid_deriv, size_t num_obs,
+		      const double *spec_r, /*@out@*/ float *stray_r )
+{
+     register size_t nk, nl;
+
+     const size_t dim_out = stray->dims[0];
+     const size_t dim_in  = stray->dims[1];
+     const size_t dim_in4 = dim_in - (dim_in % 4);
+
+     size_t ni_blk, ni, nobs, no;
+
+     for ( ni_blk = 0; ni_blk < dim_out; ni_blk += STRAY_BLOCK_ROWS ) {
+	  const size_t ni_max = (ni_blk + STRAY_BLOCK_ROWS < dim_out) ?
+	       ni_blk + STRAY_BLOCK_ROWS : dim_out;
+
+	  for ( nobs = 0; nobs < num_obs; nobs += STRAY_BLOCK_OBS ) {
+	       const size_t num_blk = (nobs + STRAY_BLOCK_OBS < num_obs) ?
+		    STRAY_BLOCK_OBS : num_obs - nobs;
+
+	       for ( ni = ni_blk; ni < ni_max; ni++ ) {
+		    const float *mrow = stray->matrix[ni];
+
+		    double acc[STRAY_BLOCK_OBS][4];
+
+		    (void) memset( acc, 0, sizeof(acc) );
+		    if ( num_blk == STRAY_BLOCK_OBS ) {
+			 const double *s0 = spec_r + nobs * dim_in;
+			 const double *s1 = s0 + dim_in;
+			 const double *s2 = s1 + dim_in;
+			 const double *s3 = s2 + dim_in;
+
+			 for ( nk = 0; nk < dim_in4; nk += 4 ) {
+			      for ( nl = 0; nl < 4; nl++ ) {
+				   register double mval = mrow[nk+nl];
+
+				   acc[0][nl] += mval * s0[nk+nl];
+				   acc[1][nl] += mval * s1[nk+nl];
+				   acc[2][nl] += mval * s2[nk+nl];
+				   acc[3][nl] += mval * s3[nk+nl];
+			      }
+			 }
+			 for ( nk = dim_in4; nk < dim_in; nk++ ) {
+			      acc[0][0] += mrow[nk] * s0[nk];
+			      acc[1][0] += mrow[nk] * s1[nk];
+			      acc[2][0] += mrow[nk] * s2[nk];
+			      acc[3][0] += mrow[nk] * s3[nk];
+			 }
+		    } else {
+			 for ( no = 0; no < num_blk; no++ ) {
+			      const double *sv = spec_r + (nobs + no) * dim_in;
+
+			      for ( nk = 0; nk < dim_in; nk++ )
+				   acc[no][0] += mrow[nk] * sv[nk];
+			 }
+		    }
+		    for ( no = 0; no < num_blk; no++ ) {
+			 register double dval = 
+			      (acc[no][0] + acc[no][1]) 
+			      + (acc[no][2] + acc[no][3]);
+
+			 stray_r[(nobs + no) * dim_out + ni] = 
+			      (float) (dval / grid_deriv[ni]);
+		    }
+	       }
+	  }
+     }
+}
+
+#ifdef DEBUG
+/*+++++++++++++++++++++++++
+.IDENTifer   SCIA_STRAY_GEMM_CHECK
+.PURPOSE     compare SCIA_STRAY_GEMM with a matrix-vector product per readout
+.INPUT/OUTPUT
+  call as    SCIA_STRAY_GEMM_CHECK( stray, grid_deriv, num_obs, 
+                                    spec_r, stray_r );
+     input:
+	    struct scia_straycorr *stray :  straylight keydata
+	    float  *grid_deriv           :  output sampling distance [dims[0]]
+	    size_t num_obs               :  number of readouts
+	    double *spec_r               :  reduced spectra [num_obs][dims[1]]
+	    float  *stray_r              :  result of SCIA_STRAY_GEMM
+
+.RETURNS     nothing, a warning is issued when the relative difference of
+             one or more elements exceeds STRAY_GEMM_TOL
+.COMMENTS    static function, only compiled with DEBUG
+-------------------------*/
+static
+void SCIA_STRAY_GEMM_CHECK( const struct scia_straycorr *stray,
+			    const float *grid_deriv, size_t num_obs,
+			    const double *spec_r, const float *stray_r )
+{
+     register size_t ni, nk;
+
+     char   msg[64];
+     size_t nobs, num_diff = 0;
+     double max_diff = 0.;
+
+     for ( nobs = 0; nobs < num_obs; nobs++ ) {
+	  const double *spec_obs = spec_r + nobs * stray->dims[1];
+
+	  for ( ni = 0; ni < stray->dims[0]; ni++ ) {
+	       register double dval = 0.;
+	       double ref, diff;
+
+	       for ( nk = 0; nk < stray->dims[1]; nk++ )
+		    dval += stray->matrix[ni][nk] * spec_obs[nk];
+	       ref = (float) (dval / grid_deriv[ni]);
+
+	       diff = fabs( stray_r[nobs * stray->dims[0] + ni] - ref );
+	       if ( diff > STRAY_GEMM_TOL * fabs( ref ) ) num_diff++;
+	       if ( ref != 0. && diff / fabs( ref ) > max_diff )
+		    max_diff = diff / fabs( ref );
+	  }
+     }
+     if ( num_diff > 0 ) {
+	  (void) snprintf( msg, 64, "SCIA_STRAY_GEMM: %zu differ (max %.3g)",
+			   num_diff, max_diff );
+	  NADC_ERROR( NADC_ERR_NONE, msg );
+     }
+}
+#endif
+
 /*+++++++++++++++++++++++++
 .IDENTifer   SCIA_CALC_STRAY_CORR
 .PURPOSE     calculate straylight correction
@@ -1124,7 +1276,6 @@ void SCIA_CALC_STRAY_CORR( struct scia_cal_rec *scia_cal )
        /*@modifies nadc_stat, nadc_err_stack, scia_cal->correction@*/
 {
      register unsigned short nch, ng, nr, np;
-     register size_t ni;
 
      register size_t nobs;
 
@@ -1138,6 +1289,7 @@ void SCIA_CALC_STRAY_CORR( struct scia_cal_rec *scia_cal )
      float  *grid_deriv = NULL;
      double *spec_r     = NULL;
      float  *stray_r    = NULL;
+     const size_t num_obs = scia_cal->num_obs;
 #ifdef DEBUG
      FILE *fp_full = NULL;
      FILE *fp_grid = NULL;
@@ -1145,34 +1297,31 @@ void SCIA_CALC_STRAY_CORR( struct scia_cal_rec *scia_cal )
      FILE *fp_corr_full = NULL;
      FILE *fp_corr_grid = NULL;
 #endif
-     struct scia_straycorr stray = {
-	  {0,0}, NULL, NULL, NULL, {0,0}, NULL
-     };
+     const struct scia_straycorr *stray;
 
      /* reset correction values */
      (void) memset( scia_cal->correction[0], 0,
 		    sizeof(float) * scia_cal->num_obs * scia_cal->num_pixels );
 
      /* read straylight correction matrix */
-     SCIA_RD_H5_STRAY( &stray );
-     if ( IS_ERR_STAT_FATAL )
-     	  NADC_RETURN_ERROR( NADC_ERR_HDF_RD, "SCIA_RD_H5_STRAY" );
+     if ( (stray = SCIA_GET_H5_STRAY()) == NULL )
+     	  NADC_RETURN_ERROR( NADC_ERR_HDF_RD, "SCIA_GET_H5_STRAY" );
 
      /* set each element of the array equal to its subscript */
      for ( nr = 0; nr < SCIENCE_PIXELS; nr++ ) grid_f[nr] = (float) nr;
 
-     /* calculate derivative of stray.grid_out */
-     grid_deriv = (float *) malloc( stray.dims[0] * sizeof(float) );
+     /* calculate derivative of stray->grid_out */
+     grid_deriv = (float *) malloc( stray->dims[0] * sizeof(float) );
      if ( grid_deriv == NULL )
 	  NADC_GOTO_ERROR( NADC_ERR_ALLOC, "grid_deriv" );
-     for ( nr = 0; nr < stray.dims[0]; nr++ )
-	  grid_deriv[nr] = DERIV( nr, stray.dims[0], stray.grid_out );
+     for ( nr = 0; nr < stray->dims[0]; nr++ )
+	  grid_deriv[nr] = DERIV( nr, stray->dims[0], stray->grid_out );
 
      /* obtain lower and upper indices for regridding, per channel */
-     grid_in_ll = (unsigned short *) malloc( stray.dims[1] * sizeof(short) );
+     grid_in_ll = (unsigned short *) malloc( stray->dims[1] * sizeof(short) );
      if ( grid_in_ll == NULL ) 
 	  NADC_GOTO_ERROR( NADC_ERR_ALLOC, "grid_in_ll" );
-     grid_in_ul = (unsigned short *) malloc( stray.dims[1] * sizeof(short) );
+     grid_in_ul = (unsigned short *) malloc( stray->dims[1] * sizeof(short) );
      if ( grid_in_ul == NULL ) 
 	  NADC_GOTO_ERROR( NADC_ERR_ALLOC, "grid_in_ul" );
 
@@ -1182,30 +1331,30 @@ void SCIA_CALC_STRAY_CORR( struct scia_cal_rec *scia_cal )
 
 	  bool found = FALSE;
 
-	  for ( nr = 0; nr < stray.dims[1]; nr++ ) {
-	       if ( stray.grid_in[nr] < ipix_ch_mn 
-		    || stray.grid_in[nr] > ipix_ch_mx ) 
+	  for ( nr = 0; nr < stray->dims[1]; nr++ ) {
+	       if ( stray->grid_in[nr] < ipix_ch_mn 
+		    || stray->grid_in[nr] > ipix_ch_mx ) 
 		    continue;
 
 	       if ( ! found ) {
 		    grid_in_ll[nr] = ipix_ch_mn;
-		    if ( (nr+1u) < stray.dims[1] ) {
+		    if ( (nr+1u) < stray->dims[1] ) {
 			 grid_in_ul[nr] = 
-			      __ROUNDf_us( (stray.grid_in[nr] 
-					    + stray.grid_in[nr+1]) / 2 ) - 1;
+			      __ROUNDf_us( (stray->grid_in[nr] 
+					    + stray->grid_in[nr+1]) / 2 ) - 1;
 		    } else {
 			 grid_in_ul[nr] = ipix_ch_mx;
 		    }
 		    found = TRUE;
 	       } else {
 		    grid_in_ll[nr] = 
-			 __ROUNDf_us( (stray.grid_in[nr-1] 
-				       + stray.grid_in[nr]) / 2 );
-		    if ( (nr+1u) < stray.dims[1]
-			 && stray.grid_in[nr+1] <= ipix_ch_mx ) {
+			 __ROUNDf_us( (stray->grid_in[nr-1] 
+				       + stray->grid_in[nr]) / 2 );
+		    if ( (nr+1u) < stray->dims[1]
+			 && stray->grid_in[nr+1] <= ipix_ch_mx ) {
 			 grid_in_ul[nr] = 
-			      __ROUNDf_us( (stray.grid_in[nr] 
-					    + stray.grid_in[nr+1]) / 2 ) - 1;
+			      __ROUNDf_us( (stray->grid_in[nr] 
+					    + stray->grid_in[nr+1]) / 2 ) - 1;
 		    } else {
 			 grid_in_ul[nr] = ipix_ch_mx;
 		    }
@@ -1219,14 +1368,15 @@ void SCIA_CALC_STRAY_CORR( struct scia_cal_rec *scia_cal )
      fp_corr_full = fopen( "tmp_correction_full.dat", "w" );
      fp_corr_grid = fopen( "tmp_correction_grid.dat", "w" );
 #endif
-     spec_r = (double *) malloc( stray.dims[1] * sizeof(double) );
+     spec_r = (double *) malloc( num_obs * stray->dims[1] * sizeof(double) );
      if ( spec_r == NULL ) NADC_GOTO_ERROR( NADC_ERR_ALLOC, "spec_r" );
-     stray_r = (float *) malloc( stray.dims[0] * sizeof(float) );
+     stray_r = (float *) malloc( num_obs * stray->dims[0] * sizeof(float) );
      if ( stray_r == NULL ) NADC_GOTO_ERROR( NADC_ERR_ALLOC, "stray_r");
 
-     /* loop over spectra*/
+     /* loop over spectra: ghosts and spectra reduced to stray->grid_in */
      nobs = 0;
      do {
+	  double *spec_obs = spec_r + nobs * stray->dims[1];
 	  /* recontruct full spectra (8192 pixels) */
 	  np = 0;
 	  do {
@@ -1257,35 +1407,44 @@ void SCIA_CALC_STRAY_CORR( struct scia_cal_rec *scia_cal )
 #endif
 	  /* calculate stray light contribution for the ghosts */
 	  (void) memset( ghost_f, 0, SCIENCE_PIXELS * sizeof(float) );
-	  SCIA_CALC_STRAY_GHOSTS( &stray, spec_f, ghost_f );
+	  SCIA_CALC_STRAY_GHOSTS( stray, spec_f, ghost_f );
 #ifdef DEBUG
 	  (void) fwrite( ghost_f, sizeof(float), SCIENCE_PIXELS, fp_ghost );
 #endif
-	  /* reduce dimension of spectrum to stray.grid_in */
-	  for ( nr = 0; nr < stray.dims[1]; nr++ ) {
+	  /* reduce dimension of spectrum to stray->grid_in */
+	  for ( nr = 0; nr < stray->dims[1]; nr++ ) {
 	       register double dval = 0.;
 
 	       for ( ng = grid_in_ll[nr]; ng <= grid_in_ul[nr]; ng++ )
 		    dval += spec_f[ng];
 
-	       spec_r[nr] = dval;
+	       spec_obs[nr] = dval;
 	  }
 #ifdef DEBUG
-	  (void) fwrite( spec_r, sizeof(double), stray.dims[1], fp_grid );
+	  (void) fwrite( spec_obs, sizeof(double), stray->dims[1], fp_grid );
 #endif
-	  /* multiply straylight matrix with spectrum */
-          /* and divide by output sampling distance */
-	  for ( ni = 0; ni < stray.dims[0]; ni++ ) {
-	       register double dval = 0.;
-
-	       for ( nr = 0; nr < stray.dims[1]; nr++ )
-		    dval += stray.matrix[ni][nr] * spec_r[nr];
+          /* store ghosts, blank out blinded pixels, use quality_flag */
+          np = 0;
+          do { 
+               if ( (scia_cal->quality_flag[np] & (FLAG_BLINDED|FLAG_UNUSED))
+		    == UCHAR_ZERO )
+                    scia_cal->correction[np][nobs] = ghost_f[np];
+          } while ( ++np < SCIENCE_PIXELS );
+     } while ( ++nobs < num_obs );
 
-	       stray_r[ni] = (float) (dval / grid_deriv[ni]);
-	  }
+     /* multiply straylight matrix with all spectra */
+     /* and divide by output sampling distance */
+     SCIA_STRAY_GEMM( stray, grid_deriv, num_obs, spec_r, stray_r );
 #ifdef DEBUG
-	  (void) fwrite( stray_r, sizeof(float), stray.dims[0], fp_corr_grid );
+     SCIA_STRAY_GEMM_CHECK( stray, grid_deriv, num_obs, spec_r, stray_r );
+     (void) fwrite( stray_r, sizeof(float), num_obs * stray->dims[0], 
+		    fp_corr_grid );
 #endif
+     /* loop over spectra: add straylight on original input grid */
+     nobs = 0;
+     do {
+	  const float *stray_obs = stray_r + nobs * stray->dims[0];
+
 	  /* resample straylight spectrum to original input grid */
 
 	  for ( nch = 0; nch < SCIENCE_CHANNELS; nch++ ) {
@@ -1296,9 +1455,9 @@ void SCIA_CALC_STRAY_CORR( struct scia_cal_rec *scia_cal )
 	       size_t offs = 0;
 	       size_t dim = 0;
 
-	       for ( nr = 0; nr < stray.dims[0]; nr++ ) {
-		    if ( stray.grid_out[nr] < ipix_ch_mn ) continue;
-		    if ( stray.grid_out[nr] > ipix_ch_mx ) break;
+	       for ( nr = 0; nr < stray->dims[0]; nr++ ) {
+		    if ( stray->grid_out[nr] < ipix_ch_mn ) continue;
+		    if ( stray->grid_out[nr] > ipix_ch_mx ) break;
 
 		    if ( ! found ) {
 			 offs = nr;
@@ -1307,7 +1466,7 @@ void SCIA_CALC_STRAY_CORR( struct scia_cal_rec *scia_cal )
 		    dim++;
 	       }
 	       FIT_GRID_AKIMA( FLT32_T, FLT32_T, dim, 
-			       &stray.grid_out[offs], &stray_r[offs], 
+			       &stray->grid_out[offs], &stray_obs[offs], 
 			       FLT32_T, FLT32_T, CHANNEL_SIZE, 
 			       &grid_f[ipix_ch_mn], &stray_f[ipix_ch_mn] );
 	       if ( IS_ERR_STAT_FATAL )
@@ -1321,9 +1480,9 @@ void SCIA_CALC_STRAY_CORR( struct scia_cal_rec *scia_cal )
           do { 
                if ( (scia_cal->quality_flag[np] & (FLAG_BLINDED|FLAG_UNUSED))
 		    == UCHAR_ZERO )
-                    scia_cal->correction[np][nobs] = (ghost_f[np] + stray_f[np]);
+                    scia_cal->correction[np][nobs] += stray_f[np];
           } while ( ++np < SCIENCE_PIXELS );
-     } while ( ++nobs < scia_cal->num_obs );
+     } while ( ++nobs < num_obs );
 
      /* scale straylight correction to pixel exposure time */
      np = 0;
@@ -1375,7 +1534,6 @@ done:
      if ( grid_deriv != NULL ) free( grid_deriv );
      if ( spec_r  != NULL ) free( spec_r );
      if ( stray_r != NULL ) free( stray_r );
-     SCIA_FREE_H5_STRAY( &stray );
 }
 
 static
@@ -0,0 +1,236 @@
+/*++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+.COPYRIGHT (c) 2026 SRON (R.M.van.Hees@sron.nl)
+
+   This is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License, version 2, as
+   published by the Free Software Foundation.
+
+   The software is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place - Suite 330,
+   Boston, MA  02111-1307, USA.
+
+.IDENTifer   SCIA_LV1C_SPEC
+.AUTHOR      R.M. van Hees
+.KEYWORDS    SCIAMACHY level 1c product
+.LANGUAGE    ANSI C
+.PURPOSE     container for the level 1c spectra of one state
+.COMMENTS    contains SCIA_LV1C_SPEC_FILL, SCIA_LV1C_SPEC_STORE,
+             SCIA_LV1C_SPEC_FREE
+	     - clusters with the same number of observations and the same
+	       integration time (coaddf and pet) are stored in one group,
+	       their pixels are concatenated in the order of the clusters
+	     - signal and error of a group are stored as [num_obs][stride]
+	       planes, each row aligned at SPEC1C_ALIGN bytes, a row holds
+	       only the pixels of the clusters in the group
+.ENVIRONment None
+.VERSION      1.0   17-Oct-2026 Created by R. M. van Hees
+------------------------------------------------------------*/
+/*
+ * Define _POSIX_C_SOURCE to indicate
+ * that this is a POSIX program (posix_memalign)
+ */
+#define  _POSIX_C_SOURCE 200112L
+
+/*+++++ System headers +++++*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*+++++ Local Headers +++++*/
+#define _SCIA_LEVEL_1
+#include <nadc_scia_cal.h>
+
+/*+++++ Macros +++++*/
+#define SPEC1C_ALIGN   64
+
+/*+++++++++++++++++++++++++ Static Functions +++++++++++++++++++++++*/
+static
+float *ALLOC_PLANE( size_t num )
+{
+     void *pntr;
+
+     if ( posix_memalign( &pntr, SPEC1C_ALIGN, num * sizeof(float) ) != 0 )
+	  return NULL;
+     return (float *) pntr;
+}
+
+/*+++++++++++++++++++++++++ Main Program or Function +++++++++++++++*/
+/*+++++++++++++++++++++++++
+.IDENTifer   SCIA_LV1C_SPEC_FILL
+.PURPOSE     copy the level 1c spectra of one state to the container
+.INPUT/OUTPUT
+  call as   SCIA_LV1C_SPEC_FILL( num_mds, mds_1c, spec );
+     input:
+            unsigned short num_mds    : number of level 1c MDS (clusters)
+            struct mds1c_scia *mds_1c : level 1c MDS records of one state
+    output:
+            struct spec1c_scia *spec  : spectra of the state
+
+.RETURNS     nothing, error status passed by global variable ``nadc_stat''
+.COMMENTS    release the container with SCIA_LV1C_SPEC_FREE, on error the 
+             container is empty
+-------------------------*/
+void SCIA_LV1C_SPEC_FILL( unsigned short num_mds,
+			  const struct mds1c_scia *mds_1c,
+			  struct spec1c_scia *spec )
+{
+     register unsigned short num, ng, nobs;
+
+     const size_t row_align = SPEC1C_ALIGN / sizeof(float);
+
+     spec->type_mds = (num_mds > 0) ? mds_1c->type_mds : UCHAR_ZERO;
+     spec->num_clus = num_mds;
+     spec->num_grp  = 0;
+/*
+ * assign the clusters to groups
+ */
+     for ( num = 0; num < num_mds; num++ ) {
+	  const struct mds1c_scia *mds = mds_1c + num;
+
+	  for ( ng = 0; ng < spec->num_grp; ng++ ) {
+	       if ( spec->grp[ng].num_obs == mds->num_obs
+		    && spec->grp[ng].coaddf == mds->coaddf
+		    && spec->grp[ng].pet == mds->pet ) break;
+	  }
+	  if ( ng == spec->num_grp ) {
+	       struct spec1c_grp *grp = spec->grp + spec->num_grp++;
+
+	       grp->coaddf     = mds->coaddf;
+	       grp->num_obs    = mds->num_obs;
+	       grp->num_pixels = 0;
+	       grp->stride     = 0;
+	       grp->pet        = mds->pet;
+	       grp->pixel_ids  = NULL;
+	       grp->pixel_val  = NULL;
+	       grp->pixel_err  = NULL;
+	  }
+	  spec->clus_grp[num]  = ng;
+	  spec->clus_offs[num] = spec->grp[ng].num_pixels;
+	  spec->clus_pixels[num] = mds->num_pixels;
+	  spec->grp[ng].num_pixels += mds->num_pixels;
+     }
+/*
+ * allocate memory for the groups
+ */
+     for ( ng = 0; ng < spec->num_grp; ng++ ) {
+	  struct spec1c_grp *grp = spec->grp + ng;
+
+	  size_t nr_val;
+
+	  grp->stride = (unsigned short)
+	       (((grp->num_pixels + row_align - 1) / row_align) * row_align);
+	  nr_val = (size_t) grp->num_obs * grp->stride;
+	  if ( grp->num_pixels == 0 || nr_val == 0 ) continue;
+
+	  grp->pixel_ids = (unsigned short *)
+	       malloc( grp->num_pixels * sizeof(unsigned short) );
+	  if ( grp->pixel_ids == NULL )
+	       NADC_GOTO_ERROR( NADC_ERR_ALLOC, "grp->pixel_ids" );
+	  if ( (grp->pixel_val = ALLOC_PLANE( nr_val )) == NULL )
+	       NADC_GOTO_ERROR( NADC_ERR_ALLOC, "grp->pixel_val" );
+	  if ( (grp->pixel_err = ALLOC_PLANE( nr_val )) == NULL )
+	       NADC_GOTO_ERROR( NADC_ERR_ALLOC, "grp->pixel_err" );
+     }
+/*
+ * copy the spectra, one row of a cluster at a time
+ */
+     for ( num = 0; num < num_mds; num++, mds_1c++ ) {
+	  struct spec1c_grp *grp = spec->grp + spec->clus_grp[num];
+
+	  const unsigned short offs = spec->clus_offs[num];
+	  const size_t nr_byte = mds_1c->num_pixels * sizeof(float);
+
+	  if ( grp->pixel_ids == NULL ) continue;
+
+	  (void) memcpy( grp->pixel_ids + offs, mds_1c->pixel_ids,
+			 mds_1c->num_pixels * sizeof(unsigned short) );
+	  for ( nobs = 0; nobs < mds_1c->num_obs; nobs++ ) {
+	       const size_t nr_row = (size_t) nobs * grp->stride + offs;
+	       const size_t nr_mds = (size_t) nobs * mds_1c->num_pixels;
+
+	       (void) memcpy( grp->pixel_val + nr_row,
+			      mds_1c->pixel_val + nr_mds, nr_byte );
+	       if ( mds_1c->pixel_err != NULL )
+		    (void) memcpy( grp->pixel_err + nr_row,
+				   mds_1c->pixel_err + nr_mds, nr_byte );
+	       else
+		    (void) memset( grp->pixel_err + nr_row, 0, nr_byte );
+	  }
+     }
+     return;
+done:
+     SCIA_LV1C_SPEC_FREE( spec );
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   SCIA_LV1C_SPEC_STORE
+.PURPOSE     copy the spectra in the container back to the level 1c MDS
+.INPUT/OUTPUT
+  call as   SCIA_LV1C_SPEC_STORE( spec, num_mds, mds_1c );
+     input:
+            struct spec1c_scia *spec  : spectra of the state
+            unsigned short num_mds    : number of level 1c MDS (clusters)
+ in/output:
+            struct mds1c_scia *mds_1c : level 1c MDS records of one state
+
+.RETURNS     nothing
+.COMMENTS    none
+-------------------------*/
+void SCIA_LV1C_SPEC_STORE( const struct spec1c_scia *spec,
+			   unsigned short num_mds, struct mds1c_scia *mds_1c )
+{
+     register unsigned short num, nobs;
+
+     for ( num = 0; num < num_mds && num < spec->num_clus; num++, mds_1c++ ) {
+	  const struct spec1c_grp *grp = spec->grp + spec->clus_grp[num];
+
+	  const unsigned short offs = spec->clus_offs[num];
+	  const size_t nr_byte = mds_1c->num_pixels * sizeof(float);
+
+	  if ( grp->pixel_ids == NULL ) continue;
+
+	  for ( nobs = 0; nobs < mds_1c->num_obs; nobs++ ) {
+	       const size_t nr_row = (size_t) nobs * grp->stride + offs;
+	       const size_t nr_mds = (size_t) nobs * mds_1c->num_pixels;
+
+	       (void) memcpy( mds_1c->pixel_val + nr_mds,
+			      grp->pixel_val + nr_row, nr_byte );
+	       if ( mds_1c->pixel_err != NULL )
+		    (void) memcpy( mds_1c->pixel_err + nr_mds,
+				   grp->pixel_err + nr_row, nr_byte );
+	  }
+     }
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   SCIA_LV1C_SPEC_FREE
+.PURPOSE     release the memory of the container
+.INPUT/OUTPUT
+  call as   SCIA_LV1C_SPEC_FREE( spec );
+ in/output:
+            struct spec1c_scia *spec  : spectra of the state
+
+.RETURNS     nothing
+.COMMENTS    the container is empty afterwards (num_grp equals zero)
+-------------------------*/
+void SCIA_LV1C_SPEC_FREE( struct spec1c_scia *spec )
+{
+     register unsigned short ng;
+
+     for ( ng = 0; ng < spec->num_grp; ng++ ) {
+	  struct spec1c_grp *grp = spec->grp + ng;
+
+	  if ( grp->pixel_ids != NULL ) free( grp->pixel_ids );
+	  if ( grp->pixel_val != NULL ) free( grp->pixel_val );
+	  if ( grp->pixel_err != NULL ) free( grp->pixel_err );
+	  grp->pixel_ids = NULL;
+	  grp->pixel_val = grp->pixel_err = NULL;
+     }
+     spec->num_grp = 0;
+}
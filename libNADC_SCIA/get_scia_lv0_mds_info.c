@@ -31,10 +31,13 @@
 
 .RETURNS     number of MDS's read (unsigned int), 
              error status passed by global variable ``nadc_stat'
-.COMMENTS    None
+.COMMENTS    the source packets are read through a window of LV0_SCAN_WINDOW
+             bytes, which is refilled when less than LV0_SCAN_MARGIN bytes
+	     (larger than the largest source packet) are left
 .ENVIRONment None
 .EXTERNALs   ENVI_GET_DSD_INDEX 
-.VERSION     4.0     23-Mar-2015   new info-record implementation, RvH
+.VERSION     4.1     17-Oct-2026   read DSD through a fixed-size window, RvH
+             4.0     23-Mar-2015   new info-record implementation, RvH
              3.1     18-Nov-2013   added corrupted DSR detection, RvH
              3.0     28-Oct-2013   re-write, no cluster-info, RvH
              2.0     13-Nov-2012   added cluster checking, RvH
@@ -61,7 +64,8 @@
 #endif
 
 /*+++++ Macros +++++*/
-	/* NONE */
+#define LV0_SCAN_WINDOW  ((size_t) 4 * 1024 * 1024)
+#define LV0_SCAN_MARGIN  ((size_t) 128 * 1024)
 
 /*+++++ Global Variables +++++*/
 	/* NONE */
@@ -70,7 +74,54 @@
 	/* NONE */
 
 /*+++++++++++++++++++++++++ Static Functions +++++++++++++++++++++++*/
-	/* NONE */
+/*+++++++++++++++++++++++++
+.IDENTifer   _FILL_WINDOW
+.PURPOSE     move the unread bytes to the start of the window, and read
+             the next part of the DSD
+.INPUT/OUTPUT
+  call as   cpntr = _FILL_WINDOW( fd, dsd, cpntr, mds_char, 
+                                  &win_offs, &win_size );
+     input:  
+            FILE   *fd             : (open) stream pointer
+            struct dsd_envi *dsd   : structure for the DSD records
+            char   *cpntr          : current position in window
+ in/output:  
+            char   *mds_char       : window with source packets
+            size_t *win_offs       : offset of window w.r.t. begin of DSD
+            size_t *win_size       : number of valid bytes in window
+
+.RETURNS     new position in window (char *)
+             error status passed by global variable ``nadc_stat'
+.COMMENTS    static function
+-------------------------*/
+static
+char *_FILL_WINDOW( FILE *fd, const struct dsd_envi *dsd, char *cpntr,
+		    char *mds_char, size_t *win_offs, size_t *win_size )
+{
+     size_t nr_byte, nr_keep = 0;
+
+     const size_t nr_used = (size_t) (cpntr - mds_char);
+
+     if ( nr_used < *win_size ) {
+	  nr_keep = *win_size - nr_used;
+	  (void) memmove( mds_char, cpntr, nr_keep );
+     }
+     *win_offs += nr_used;
+     nr_byte = (size_t) dsd->size - (*win_offs + nr_keep);
+     if ( nr_byte > LV0_SCAN_WINDOW - nr_keep )
+	  nr_byte = LV0_SCAN_WINDOW - nr_keep;
+     if ( nr_byte > 0
+	  && fread( mds_char + nr_keep, nr_byte, 1, fd ) != 1 ) {
+	  NADC_ERROR( NADC_ERR_PDS_RD, dsd->name );
+	  return mds_char;
+     }
+     *win_size = nr_keep + nr_byte;
+
+     /* clear the remainder, for the checks on corrupted packets */
+     (void) memset( mds_char + *win_size, 0, 
+		    LV0_SCAN_WINDOW - *win_size );
+     return mds_char;
+}
 
 /*+++++++++++++++++++++++++ Main Program or Function +++++++++++++++*/
 unsigned int GET_SCIA_LV0_MDS_INFO( FILE *fd, const struct dsd_envi *dsd, 
@@ -86,24 +137,30 @@ unsigned int GET_SCIA_LV0_MDS_INFO( FILE *fd, const struct dsd_envi *dsd,
 
      char           *mds_char;
      size_t         offs;
+     size_t         win_offs = 0, win_size = 0;
      unsigned short pdh_length, isp_length;
      unsigned short aux_sync, det_sync, pmd_sync;
 
      /* allocate memory to buffer source packages */
-     if ( (mds_char = (char *) malloc( (size_t) dsd->size )) == NULL ) 
+     if ( (mds_char = (char *) malloc( LV0_SCAN_WINDOW )) == NULL ) 
 	  NADC_GOTO_ERROR( NADC_ERR_ALLOC, "mds_char" );
 
-     /* read all Sciamachy source packages in product */
+     /* examine whole source data section, window by window */
      (void) fseek( fd, (long) dsd->offset, SEEK_SET );
-     if ( fread( mds_char, (size_t) dsd->size, 1, fd ) != 1 )
-	  NADC_GOTO_ERROR( NADC_ERR_PDS_RD, dsd->name );
-
-     /* examine whole source data section */
-     cpntr = mds_char;
+     cpntr = _FILL_WINDOW( fd, dsd, mds_char, mds_char, 
+			   &win_offs, &win_size );
+     if ( IS_ERR_STAT_FATAL ) goto done;
      do {
+	  if ( win_size - (size_t) (cpntr - mds_char) < LV0_SCAN_MARGIN
+	       && win_offs + win_size < (size_t) dsd->size ) {
+	       cpntr = _FILL_WINDOW( fd, dsd, cpntr, mds_char, 
+				     &win_offs, &win_size );
+	       if ( IS_ERR_STAT_FATAL ) goto done;
+	  }
+
 	  /* store byte offset w.r.t. begin of file */
 	  info_pntr->offset = (unsigned int) 
-	       (dsd->offset + (cpntr - mds_char));
+	       (dsd->offset + win_offs + (cpntr - mds_char));
 	  info_pntr->q.value = 0;
 
 	  (void) memcpy( &info_pntr->mjd, cpntr, sizeof(struct mjd_envi) );
@@ -215,7 +272,8 @@ unsigned int GET_SCIA_LV0_MDS_INFO( FILE *fd, const struct dsd_envi *dsd,
 #endif
 	  /* move to the next MDS */
 	  cpntr += info_pntr->packet_length - 11;
-	  if ( (cpntr - mds_char) > dsd->size ) break;
+	  if ( win_offs + (size_t) (cpntr - mds_char) > (size_t) dsd->size )
+	       break;
      } while ( info_pntr++, ++num_info < dsd->num_dsr );
 done:
      if ( mds_char != NULL ) free( mds_char );
@@ -31,7 +31,8 @@
 .RETURNS     number of level 1c MDS records
 .COMMENTS    None
 .ENVIRONment None
-.VERSION     1.1.1   29-Sep-2011   moved clusID check to read module, RvH
+.VERSION     1.2     17-Oct-2026   use SCIA_LV0_UNPACK_PIXEL, RvH
+             1.1.1   29-Sep-2011   moved clusID check to read module, RvH
              1.1     29-Sep-2011   added several checks, RvH
              1.0     07-Nov-2006   created by R. M. van Hees 
 ------------------------------------------------------------*/
@@ -261,27 +262,24 @@ void _GET_LV0_PIXELVAL( unsigned int num_det,
 		    
 	       for ( ncl = 0 ; ncl < nr_clus; ncl++ ) {
 		    if ( chan_src[ncl].cluster_id == clusID ) {
-			 register unsigned short np = 0;
-			 register unsigned int data;
-			 register unsigned char *cpntr = chan_src[ncl].data;
-
-			 if ( chan_src[ncl].co_adding == (unsigned char) 1 ) {
-			      do {
-				   data = (unsigned int) cpntr[1]
-					+ ((unsigned int) cpntr[0] << 8);
-				   cpntr += 2;
-
-				   *pixel_val++ = (float) data;
-			      } while ( ++np < chan_src[ncl].length );
-			 } else {
-			      do {
-				   data = (unsigned int) cpntr[2]
-					+ ((unsigned int) cpntr[1] << 8)
-					+ ((unsigned int) cpntr[0] << 16);
-				   cpntr += 3;
-
-				   *pixel_val++ = (float) data;
-			      } while ( ++np < chan_src[ncl].length );
+			 register unsigned short np, nb, ni;
+			 unsigned int data[CHANNEL_SIZE];
+
+			 const unsigned char *cpntr = chan_src[ncl].data;
+			 const unsigned short length = chan_src[ncl].length;
+
+			 for ( np = 0; np < length; np += nb ) {
+			      nb = (length - np > CHANNEL_SIZE) ?
+				   (unsigned short) CHANNEL_SIZE : length - np;
+			      if ( chan_src[ncl].co_adding == UCHAR_ONE ) {
+				   SCIA_LV0_UNPACK_PIXEL_16( data, cpntr, nb );
+				   cpntr += 2 * nb;
+			      } else {
+				   SCIA_LV0_UNPACK_PIXEL_24( data, cpntr, nb );
+				   cpntr += 3 * nb;
+			      }
+			      for ( ni = 0; ni < nb; ni++ )
+				   *pixel_val++ = (float) data[ni];
 			 }
 		    }
 	       }
@@ -49,9 +49,22 @@
              struct geoC_scia *geoC_1c : Monitor gelocation records (level 1c)
 
 .RETURNS     nothing
-.COMMENTS    None
+.COMMENTS    - geolocations are interpolated as 3D unit vectors, the
+	       sub-satellite points of a state are converted only once,
+	       corners and mid-points shared by adjacent pixels as well
+	     - option -fast_geo (parameter flag_fast_geo) selects table
+	       based sin/cos/atan2,
+	       the absolute error of these is less than 2e-15 radians
+	       (1.2e-7 micro-degree), thus a coordinate differs only when
+	       it lies within this distance of a whole micro-degree.
+	       Besides, the pixel centre is then obtained from the
+	       corner vectors without truncating the intermediate
+	       mid-points, which moves it by at most a few micro-degrees
 .ENVIRONment None
-.VERSION     1.6     07-Dec-2005   use modf (floating point exceptions), RvH
+.VERSION     1.9     17-Oct-2026   states with a single record, RvH
+             1.8     17-Oct-2026   fast trig selected by parameter, RvH
+             1.7     17-Oct-2026   cached unit vectors, fast trig option, RvH
+             1.6     07-Dec-2005   use modf (floating point exceptions), RvH
              1.5     01-Sep-2004   more minor clean-ups and speed-ups, RvH
              1.4     03-Aug-2004   minor bug-fixes and speed-ups, RvH
              1.3     16-Mar-2004   minor bug-fixes, RvH
@@ -80,6 +93,20 @@
 #define START_AT_ONE   ((unsigned char) 1)
 #define START_AT_CNTR  ((unsigned char) 2)
 
+#define NUM_TRIG_DEG   360         /* table of sin/cos: [-360, 360] degree */
+#define NUM_ATAN_TAB   64          /* table of atan: [0, 1] in 1/64 steps */
+
+/*+++++ Structures +++++*/
+struct geo_uvec {                  /* Earth centered unit vector */
+     double xx, yy, zz;
+};
+
+struct geo_cache {                 /* unit vectors of one coordinate */
+     struct coord_envi coord;
+     unsigned char     mask;       /* 1: uvec[0] valid, 2: uvec[1] valid */
+     struct geo_uvec   uvec[2];    /* without/with longitude offset */
+};
+
 /*+++++ Global Variables +++++*/
 	/* NONE */
 
@@ -87,6 +114,12 @@
 static const double LonOffs = PI / 4.;
 static const double deg2rad = DEG2RAD;
 
+static bool   geo_fast_trig = FALSE;
+static bool   geo_trig_init = FALSE;
+static double sin_tab[2 * NUM_TRIG_DEG + 1];
+static double cos_tab[2 * NUM_TRIG_DEG + 1];
+static double atan_tab[NUM_ATAN_TAB + 1];
+
 /*+++++++++++++++++++++++++ Static Functions +++++++++++++++++++++++*/
 /*+++++++++++++++++++++++++
 .IDENTifer  Quick_LinInterPol
@@ -124,43 +157,6 @@ void Quick_LinInterPol( unsigned char flag, float Y_left, float Y_right,
      while ( ++ny < num_Y ) Y_out[ny] = Y_out[ny-1] + Y_delta;
 }
 
-/*+++++++++++++++++++++++++
-.IDENTifer  Quick_LinInterPol_d
-.PURPOSE    quick en dirty interpolation routine (no underfow checking!)
-.INPUT/OUTPUT
-  call as   Quick_LinInterPol_d( flag, Y_left, Y_right, num_Y, Y_out );
-     input:
-            unsigned char flag   : defines starting value (=Y_out[0])
-	                             START_AT_ZERO : Y_left
-				     START_AT_ONE  : Y_left + dY/num_Y
-				     START_AT_CNTR : Y_left + 0.5 * dY/num_Y
-            double Y_left        : start value (see flag)
-	    double Y_right       : end value
-	    unsigned short num_Y : number of interpolated values
-    output:
-            double *Y_out        : interpolated values
-
-.RETURNS     nothing
-.COMMENTS    static function
--------------------------*/
-static
-void Quick_LinInterPol_d( unsigned char flag, double Y_left, double Y_right,
-			  unsigned short num_Y, /*@out@*/ double *Y_out )
-{
-     register unsigned short ny = 0;
-
-     const double Y_delta = (Y_right - Y_left) / num_Y;
-
-     if ( flag == START_AT_ZERO )
-	  *Y_out = Y_left;
-     else if ( flag == START_AT_ONE )
-	  *Y_out = Y_left + Y_delta;
-     else /* START_AT_CNTR */
-	  *Y_out = Y_left + Y_delta / 2;
-
-     while ( ++ny < num_Y ) Y_out[ny] = Y_out[ny-1] + Y_delta;
-}
-
 /*+++++++++++++++++++++++++
 .IDENTifer  Cntr_LinInterPol
 .PURPOSE    quick en dirty interpolation routine (no underfow checking!)
@@ -170,6 +166,7 @@ void Quick_LinInterPol_d( unsigned char flag, double Y_left, double Y_right,
             float Y_left         : Y-value on the left (or NAN)
             float Y_cntr         : Y-value in the center
             float Y_righ t       : Y-right on the left (or NAN)
+	                           (both NAN: constant Y_cntr)
 	    unsigned short num_Y : dimension of the output array
     output:
             double *Y_out        : interpolated values
@@ -187,7 +184,9 @@ void Cntr_LinInterPol( float Y_left, float Y_cntr, float Y_right,
 
      const unsigned short half_Y = (unsigned short) (num_Y / 2);
 
-     if ( isnan( Y_left ) ) {
+     if ( isnan( Y_left ) && isnan( Y_right ) ) {
+	  dY_left = dY_right = 0.;
+     } else if ( isnan( Y_left ) ) {
 	  dY_left = dY_right = ((double) Y_right - Y_cntr) / num_Y;
      } else if ( isnan( Y_right ) ) {
 	  dY_right = dY_left = ((double) Y_cntr - Y_left) / num_Y;
@@ -223,64 +222,272 @@ void Cntr_LinInterPol( float Y_left, float Y_cntr, float Y_right,
 }
 
 /*+++++++++++++++++++++++++
-.IDENTifer  Cntr_LinInterPol_d
-.PURPOSE    quick en dirty interpolation routine (no underfow checking!)
+.IDENTifer  Edge_LinInterPol_uvec
+.PURPOSE    interpolate unit vectors along the edge of a ground pixel
 .INPUT/OUTPUT
-  call as   Cntr_LinInterPol_d( Y_left, Y_cntr, Y_right, num_Y, Y_out );
+  call as   Edge_LinInterPol_uvec( U_left, U_right, num_U, U_out );
      input:
-            double Y_left        : Y-value on the left (or NAN)
-            double Y_cntr        : Y-value in the center
-            double Y_right       : Y-right on the left (or NAN)
-	    unsigned short num_Y : dimension of the output array
+            struct geo_uvec *U_left  : start of the edge
+	    struct geo_uvec *U_right : end of the edge
+	    unsigned short num_U     : number of sub-pixels
     output:
-            double *Y_out        : interpolated values
+            struct geo_uvec *U_out   : interpolated values [num_U+1]
 
 .RETURNS     nothing
-.COMMENTS    static function
+.COMMENTS    static function,
+             U_out[ns] is the start and U_out[ns+1] the end of sub-pixel ns,
+	     identical to the values of START_AT_ZERO and START_AT_ONE
 -------------------------*/
 static
-void Cntr_LinInterPol_d( double Y_left, double Y_cntr, double Y_right, 
-			 unsigned short num_Y, /*@out@*/ double *Y_out )
+void Edge_LinInterPol_uvec( const struct geo_uvec *U_left,
+			    const struct geo_uvec *U_right,
+			    unsigned short num_U,
+			    /*@out@*/ struct geo_uvec *U_out )
 {
-     register unsigned short ny;
+     register unsigned short nu = 0;
 
-     double Y_start, dY_left, dY_right;
+     const double dx = (U_right->xx - U_left->xx) / num_U;
+     const double dy = (U_right->yy - U_left->yy) / num_U;
+     const double dz = (U_right->zz - U_left->zz) / num_U;
 
-     const unsigned short half_Y = (unsigned short) (num_Y / 2);
+     *U_out = *U_left;
+     while ( ++nu <= num_U ) {
+	  U_out[nu].xx = U_out[nu-1].xx + dx;
+	  U_out[nu].yy = U_out[nu-1].yy + dy;
+	  U_out[nu].zz = U_out[nu-1].zz + dz;
+     }
+}
 
-     if ( isnan( Y_left ) ) {
-	  dY_left = dY_right = (Y_right - Y_cntr) / num_Y;
-     } else if ( isnan( Y_right ) ) {
-	  dY_right = dY_left = (Y_cntr - Y_left) / num_Y;
+/*+++++++++++++++++++++++++
+.IDENTifer  Mid_Uvec
+.PURPOSE    unit vector halfway two positions
+.INPUT/OUTPUT
+  call as   Mid_Uvec( U_A, U_B, U_mid );
+     input:
+            struct geo_uvec *U_A    : position A
+	    struct geo_uvec *U_B    : position B
+    output:
+            struct geo_uvec *U_mid  : normalised (A + B)
+
+.RETURNS     nothing
+.COMMENTS    static function
+-------------------------*/
+static inline
+void Mid_Uvec( const struct geo_uvec *U_A, const struct geo_uvec *U_B,
+	       /*@out@*/ struct geo_uvec *U_mid )
+{
+     double norm;
+
+     U_mid->xx = U_A->xx + U_B->xx;
+     U_mid->yy = U_A->yy + U_B->yy;
+     U_mid->zz = U_A->zz + U_B->zz;
+     norm = sqrt( U_mid->xx * U_mid->xx + U_mid->yy * U_mid->yy
+		  + U_mid->zz * U_mid->zz );
+     if ( norm > 0. ) {
+	  U_mid->xx /= norm;
+	  U_mid->yy /= norm;
+	  U_mid->zz /= norm;
+     }
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer  Cntr_LinInterPol_uvec
+.PURPOSE    interpolate unit vectors around a central position
+.INPUT/OUTPUT
+  call as   Cntr_LinInterPol_uvec( U_left, U_cntr, U_right, num_U, U_out );
+     input:
+            struct geo_uvec *U_left  : position on the left (or NULL)
+            struct geo_uvec *U_cntr  : position in the center
+            struct geo_uvec *U_right : position on the right (or NULL)
+	    unsigned short num_U     : dimension of the output array
+    output:
+            struct geo_uvec *U_out   : interpolated values
+
+.RETURNS     nothing
+.COMMENTS    static function
+-------------------------*/
+static
+void Cntr_LinInterPol_uvec( const struct geo_uvec *U_left,
+			    const struct geo_uvec *U_cntr,
+			    const struct geo_uvec *U_right,
+			    unsigned short num_U,
+			    /*@out@*/ struct geo_uvec *U_out )
+{
+     register unsigned short nu;
+
+     struct geo_uvec dU_left, dU_right, U_start;
+
+     const unsigned short half_U = (unsigned short) (num_U / 2);
+
+     if ( U_left == NULL && U_right == NULL ) {
+	  dU_left.xx = dU_left.yy = dU_left.zz = 0.;
+	  dU_right = dU_left;
+     } else if ( U_left == NULL ) {
+	  dU_left.xx = (U_right->xx - U_cntr->xx) / num_U;
+	  dU_left.yy = (U_right->yy - U_cntr->yy) / num_U;
+	  dU_left.zz = (U_right->zz - U_cntr->zz) / num_U;
+	  dU_right = dU_left;
+     } else if ( U_right == NULL ) {
+	  dU_right.xx = (U_cntr->xx - U_left->xx) / num_U;
+	  dU_right.yy = (U_cntr->yy - U_left->yy) / num_U;
+	  dU_right.zz = (U_cntr->zz - U_left->zz) / num_U;
+	  dU_left = dU_right;
      } else {
-	  dY_left = (Y_right - Y_cntr) / num_Y;
-	  dY_right = (Y_cntr - Y_left) / num_Y;
+	  dU_left.xx = (U_right->xx - U_cntr->xx) / num_U;
+	  dU_left.yy = (U_right->yy - U_cntr->yy) / num_U;
+	  dU_left.zz = (U_right->zz - U_cntr->zz) / num_U;
+	  dU_right.xx = (U_cntr->xx - U_left->xx) / num_U;
+	  dU_right.yy = (U_cntr->yy - U_left->yy) / num_U;
+	  dU_right.zz = (U_cntr->zz - U_left->zz) / num_U;
      }
 
-     if ( num_Y % 2 == 1 ) {
-	  Y_start = Y_cntr - half_Y * dY_left;
-	  ny = 0;
-	  do {
-	       *Y_out++ = Y_start + ny * dY_left;
-	  } while ( ++ny < half_Y );
-	  *Y_out++ = Y_cntr;
-	  ny = 0;
-	  do {
-	       *Y_out++ = Y_cntr + (ny+1) * dY_right;
-	  } while ( ++ny < half_Y );
+     if ( num_U % 2 == 1 ) {
+	  U_start.xx = U_cntr->xx - half_U * dU_left.xx;
+	  U_start.yy = U_cntr->yy - half_U * dU_left.yy;
+	  U_start.zz = U_cntr->zz - half_U * dU_left.zz;
+	  for ( nu = 0; nu < half_U; nu++, U_out++ ) {
+	       U_out->xx = U_start.xx + nu * dU_left.xx;
+	       U_out->yy = U_start.yy + nu * dU_left.yy;
+	       U_out->zz = U_start.zz + nu * dU_left.zz;
+	  }
+	  *U_out++ = *U_cntr;
+	  for ( nu = 0; nu < half_U; nu++, U_out++ ) {
+	       U_out->xx = U_cntr->xx + (nu+1) * dU_right.xx;
+	       U_out->yy = U_cntr->yy + (nu+1) * dU_right.yy;
+	       U_out->zz = U_cntr->zz + (nu+1) * dU_right.zz;
+	  }
      } else {
-	  Y_start = Y_cntr - half_Y * dY_left + (dY_left / 2);
-	  ny = 0;
-	  do {
-	       *Y_out++ = Y_start + ny * dY_left;
-	  } while ( ++ny < half_Y );
+	  U_start.xx = U_cntr->xx - half_U * dU_left.xx + (dU_left.xx / 2);
+	  U_start.yy = U_cntr->yy - half_U * dU_left.yy + (dU_left.yy / 2);
+	  U_start.zz = U_cntr->zz - half_U * dU_left.zz + (dU_left.zz / 2);
+	  for ( nu = 0; nu < half_U; nu++, U_out++ ) {
+	       U_out->xx = U_start.xx + nu * dU_left.xx;
+	       U_out->yy = U_start.yy + nu * dU_left.yy;
+	       U_out->zz = U_start.zz + nu * dU_left.zz;
+	  }
+	  U_start.xx = U_cntr->xx + dU_right.xx / 2;
+	  U_start.yy = U_cntr->yy + dU_right.yy / 2;
+	  U_start.zz = U_cntr->zz + dU_right.zz / 2;
+	  for ( nu = 0; nu < half_U; nu++, U_out++ ) {
+	       U_out->xx = U_start.xx + nu * dU_right.xx;
+	       U_out->yy = U_start.yy + nu * dU_right.yy;
+	       U_out->zz = U_start.zz + nu * dU_right.zz;
+	  }
+     }
+}
 
-	  Y_start = Y_cntr + dY_right / 2;
-	  ny = 0;
-	  do {
-	       *Y_out++ = Y_start + ny * dY_right;
-	  } while ( ++ny < half_Y );
+/*+++++++++++++++++++++++++
+.IDENTifer  GEO_INIT_TRIG
+.PURPOSE    select trigonometric functions, initialise tables when needed
+.INPUT/OUTPUT
+  call as   GEO_INIT_TRIG();
+
+.RETURNS     nothing
+.COMMENTS    static function,
+             fast trig is selected with parameter flag_fast_geo, which
+	     is read only at the first call
+-------------------------*/
+static
+void GEO_INIT_TRIG( void )
+{
+     register int nd;
+
+     if ( geo_trig_init ) return;
+     geo_trig_init = TRUE;
+
+     geo_fast_trig = 
+	  (nadc_get_param_uint8_id( PARAM_FLAG_FAST_GEO ) == PARAM_SET);
+     if ( ! geo_fast_trig ) return;
+
+     for ( nd = -NUM_TRIG_DEG; nd <= NUM_TRIG_DEG; nd++ ) {
+	  sin_tab[nd + NUM_TRIG_DEG] = sin( nd * deg2rad );
+	  cos_tab[nd + NUM_TRIG_DEG] = cos( nd * deg2rad );
+     }
+     for ( nd = 0; nd <= NUM_ATAN_TAB; nd++ )
+	  atan_tab[nd] = atan( (double) nd / NUM_ATAN_TAB );
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer  FAST_SINCOS
+.PURPOSE    sine and cosine of an angle in micro-degrees
+.INPUT/OUTPUT
+  call as   FAST_SINCOS( mudeg, &sinval, &cosval );
+     input:
+            int mudeg       : angle (micro-degrees)
+    output:
+            double *sinval  : sine of angle
+            double *cosval  : cosine of angle
+
+.RETURNS     nothing
+.COMMENTS    static function,
+             sin(a+t) = sin(a)cos(t) + cos(a)sin(t), with a whole degrees
+	     (table) and |t| < 1 degree (Taylor series up to t^7 and t^8,
+	     truncation error < 1e-21)
+-------------------------*/
+static inline
+void FAST_SINCOS( int mudeg, /*@out@*/ double *sinval,
+		  /*@out@*/ double *cosval )
+{
+     register int    ideg = mudeg / 1000000;
+     register double tt, t2, sin_t, cos_t;
+
+     const double mudeg2rad = deg2rad / 1e6;
+
+     if ( ideg < -NUM_TRIG_DEG || ideg > NUM_TRIG_DEG ) {
+	  *sinval = sin( mudeg2rad * mudeg );
+	  *cosval = cos( mudeg2rad * mudeg );
+	  return;
      }
+     tt = mudeg2rad * (mudeg - 1000000 * ideg);
+     t2 = tt * tt;
+     sin_t = tt * (1. - t2 / 6 * (1. - t2 / 20 * (1. - t2 / 42)));
+     cos_t = 1. - t2 / 2 * (1. - t2 / 12 * (1. - t2 / 30 * (1. - t2 / 56)));
+
+     ideg += NUM_TRIG_DEG;
+     *sinval = sin_tab[ideg] * cos_t + cos_tab[ideg] * sin_t;
+     *cosval = cos_tab[ideg] * cos_t - sin_tab[ideg] * sin_t;
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer  FAST_ATAN2
+.PURPOSE    arc tangent of yy/xx, using the signs to determine the quadrant
+.INPUT/OUTPUT
+  call as   angle = FAST_ATAN2( yy, xx );
+     input:
+            double yy   : y-coordinate
+            double xx   : x-coordinate
+
+.RETURNS     angle in radians [-PI, PI]
+.COMMENTS    static function,
+             atan(z) = atan(c) + atan(d), d = (z-c)/(1+zc), with c the
+	     nearest table value and |d| < 1/128 (series up to d^7,
+	     truncation error < 2e-20)
+-------------------------*/
+static inline
+double FAST_ATAN2( double yy, double xx )
+{
+     register int    kk;
+     register double zz, dd, d2, res;
+
+     const double ax = fabs( xx );
+     const double ay = fabs( yy );
+
+     if ( ay > ax )
+	  zz = ax / ay;
+     else if ( ax > 0. )
+	  zz = ay / ax;
+     else
+	  return 0.;
+
+     kk = (int) (zz * NUM_ATAN_TAB + 0.5);
+     dd = (zz - (double) kk / NUM_ATAN_TAB)
+	  / (1. + zz * kk / NUM_ATAN_TAB);
+     d2 = dd * dd;
+     res = atan_tab[kk] + dd * (1. - d2 * (1./3 - d2 * (1./5 - d2 / 7)));
+
+     if ( ay > ax ) res = PI / 2 - res;
+     if ( xx < 0. ) res = PI - res;
+     return signbit( yy ) ? -res : res;
 }
 
 /*+++++++++++++++++++++++++
@@ -311,6 +518,17 @@ void Coord2XYZ( int DoLonOffs, const struct coord_envi coord,
      const double mudeg2rad = deg2rad / 1e6;
 
 /* do transformation */
+     if ( geo_fast_trig ) {
+	  FAST_SINCOS( coord.lat, &sinlat, &coslat );
+	  if ( DoLonOffs )                       /* LonOffs = 45 degree */
+	       FAST_SINCOS( coord.lon + 45000000, &sinlon, &coslon );
+	  else
+	       FAST_SINCOS( coord.lon, &sinlon, &coslon );
+	  *xx = coslat * coslon;
+	  *yy = coslat * sinlon;
+	  *zz = sinlat;
+	  return;
+     }
      coslat = cos( mudeg2rad * coord.lat );
      sinlat = sin( mudeg2rad * coord.lat );
      if ( DoLonOffs ) {
@@ -347,14 +565,18 @@ void XYZ2Coord( int DoLonOffs, double xx, double yy, double zz,
 		/*@out@*/ struct coord_envi *coord ) 
      /*@globals  errno@*/
 {
-     double dintegral;
+     double dintegral, dlat, dlon;
 
      const double mudeg2rad = deg2rad / 1e6;
 
-     const double dlat = 
-	  atan( zz / sqrt( xx * xx + yy * yy ));
-     const double dlon = 
-	  (DoLonOffs) ? atan2( yy, xx ) - LonOffs : atan2( yy, xx );
+     if ( geo_fast_trig ) {
+	  dlat = FAST_ATAN2( zz, sqrt( xx * xx + yy * yy ));
+	  dlon = FAST_ATAN2( yy, xx );
+     } else {
+	  dlat = atan( zz / sqrt( xx * xx + yy * yy ));
+	  dlon = atan2( yy, xx );
+     }
+     if ( DoLonOffs ) dlon -= LonOffs;
 
      (void) modf( (dlat / mudeg2rad), &dintegral );
      coord->lat = (int) dintegral;
@@ -423,7 +645,9 @@ void GET_CNTR_COORD( struct coord_envi coord_A,
             struct coord_envi *center : geographical location between A and B
 
 .RETURNS     nothing
-.COMMENTS    static function
+.COMMENTS    static function,
+             with fast trig the mid-points are not truncated to whole
+	     micro-degrees, but kept as (normalised) unit vectors
 -------------------------*/
 static
 void GET_CNTR_CORNER( struct coord_envi corner[],
@@ -432,11 +656,94 @@ void GET_CNTR_CORNER( struct coord_envi corner[],
 {
      struct coord_envi center_A, center_B;
 
+     if ( geo_fast_trig ) {
+	  register unsigned short nc;
+
+	  struct geo_uvec uv[4], mid[2];
+
+	  for ( nc = 0; nc < 4; nc++ )
+	       Coord2XYZ( FALSE, corner[nc], &uv[nc].xx, &uv[nc].yy, 
+			  &uv[nc].zz );
+	  Mid_Uvec( uv, uv+1, mid );
+	  Mid_Uvec( uv+2, uv+3, mid+1 );
+	  XYZ2Coord( FALSE, mid[0].xx + mid[1].xx, mid[0].yy + mid[1].yy,
+		     mid[0].zz + mid[1].zz, center );
+	  return;
+     }
      GET_CNTR_COORD( corner[0], corner[1], &center_A );
      GET_CNTR_COORD( corner[2], corner[3], &center_B );
      GET_CNTR_COORD( center_A, center_B, center );
 }
 
+/*+++++++++++++++++++++++++
+.IDENTifer  GEO_CACHE_UVEC
+.PURPOSE    obtain unit vector of a coordinate, convert only once
+.INPUT/OUTPUT
+  call as   uvec = GEO_CACHE_UVEC( DoLonOffs, cache );
+
+     input:
+            int  DoLonOffs : transpose longitutes to omit roundoff errors
+ in/output:
+            struct geo_cache *cache : coordinate and its unit vectors
+
+.RETURNS     pointer to unit vector (const struct geo_uvec *)
+.COMMENTS    static function
+-------------------------*/
+static
+const struct geo_uvec *GEO_CACHE_UVEC( int DoLonOffs, 
+				       struct geo_cache *cache )
+{
+     const unsigned char mask = DoLonOffs ? (unsigned char) 2 : UCHAR_ONE;
+
+     struct geo_uvec *uvec = cache->uvec + (DoLonOffs ? 1 : 0);
+
+     if ( (cache->mask & mask) == UCHAR_ZERO ) {
+	  Coord2XYZ( DoLonOffs, cache->coord, &uvec->xx, &uvec->yy,
+		     &uvec->zz );
+	  cache->mask |= mask;
+     }
+     return uvec;
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer  GET_SSP_UVEC
+.PURPOSE    interpolate sub-satellite points of one level 1b record
+.INPUT/OUTPUT
+  call as   DoLonOffs = GET_SSP_UVEC( nr, nr_geo, cache, nscale, uval );
+
+     input:
+            unsigned int nr         : index of level 1b record
+            unsigned int nr_geo     : number of level 1b records
+	    unsigned short nscale   : number of level 1c records per record
+ in/output:
+            struct geo_cache *cache : sub-satellite points of all records
+    output:
+            struct geo_uvec *uval   : interpolated unit vectors [nscale]
+
+.RETURNS     longitude offset applied to the unit vectors (int)
+.COMMENTS    static function
+-------------------------*/
+static
+int GET_SSP_UVEC( unsigned int nr, unsigned int nr_geo,
+		  struct geo_cache *cache, unsigned short nscale,
+		  /*@out@*/ struct geo_uvec *uval )
+{
+     const struct coord_envi *ssp = &cache[nr].coord;
+
+     int DoLonOffs = TRUE;
+
+     if ( ssp->lon < -95000000 || ssp->lon > 95000000
+	  || (ssp->lon > -85000000 && ssp->lon < 85000000) )
+	  DoLonOffs = FALSE;
+
+     Cntr_LinInterPol_uvec( 
+	  (nr == 0) ? NULL : GEO_CACHE_UVEC( DoLonOffs, cache+nr-1 ),
+	  GEO_CACHE_UVEC( DoLonOffs, cache+nr ),
+	  (nr == nr_geo-1) ? NULL : GEO_CACHE_UVEC( DoLonOffs, cache+nr+1 ),
+	  nscale, uval );
+     return DoLonOffs;
+}
+
 
 /*+++++++++++++++++++++++++ Main Program or Function +++++++++++++++*/
 void GET_SCIA_LV1C_GEON( unsigned int nr_geo, const struct geoN_scia *geoN,
@@ -447,6 +754,7 @@ void GET_SCIA_LV1C_GEON( unsigned int nr_geo, const struct geoN_scia *geoN,
 
      unsigned short icntr;
 
+     GEO_INIT_TRIG();
      if ( nr_geo == nr_geo1c ) {
 	  (void) memcpy( geoN_1c, geoN, nr_geo * sizeof( struct geoN_scia ));
      } else if ( nr_geo > nr_geo1c ) {
@@ -574,26 +882,33 @@ void GET_SCIA_LV1C_GEON( unsigned int nr_geo, const struct geoN_scia *geoN,
 	       geoN += nscale;
 	  }
      } else { /* nr_geo < nr_geo1c */
-	  register bool DoLonOffs;
+	  register int DoLonOffs;
 
 	  const unsigned short nscale = (unsigned short)(nr_geo1c / nr_geo);
 
-	  double xx[4], yy[4], zz[4];
-	  double *xval, *yval, *zval;
+	  double *yval;
+	  struct geo_uvec uvec[4], *uval, *uval_low;
+	  struct geo_cache *ssp_cache;
 
-	  xval = (double *) malloc( nscale * sizeof(double) );
-	  if ( xval == NULL ) 
-	       NADC_RETURN_ERROR( NADC_ERR_ALLOC, "xval" );
 	  yval = (double *) malloc( nscale * sizeof(double) );
-	  if ( yval == NULL ) {
-	       free( xval );
+	  if ( yval == NULL ) 
 	       NADC_RETURN_ERROR( NADC_ERR_ALLOC, "yval" );
+	  uval = (struct geo_uvec *) 
+	       malloc( 2 * (nscale + 1) * sizeof(struct geo_uvec) );
+	  if ( uval == NULL ) {
+	       free( yval );
+	       NADC_RETURN_ERROR( NADC_ERR_ALLOC, "uval" );
 	  }
-	  zval = (double *) malloc( nscale * sizeof(double) );
-	  if ( zval == NULL ) {
-	       free( xval ); free( yval );
-	       NADC_RETURN_ERROR( NADC_ERR_ALLOC, "zval" );
+	  uval_low = uval + nscale + 1;
+	  ssp_cache = (struct geo_cache *) 
+	       calloc( nr_geo, sizeof(struct geo_cache) );
+	  if ( ssp_cache == NULL ) {
+	       free( yval ); free( uval );
+	       NADC_RETURN_ERROR( NADC_ERR_ALLOC, "ssp_cache" );
 	  }
+	  for ( nr = 0; nr < nr_geo; nr++ )
+	       ssp_cache[nr].coord = geoN[nr].sub_sat_point;
+
 	  for ( nr = 0; nr < nr_geo; nr++ ) {
 /* pixel_type and Sun glint/Rainbow flag */
 	       for ( ns = 0; ns < nscale; ns++ ) {
@@ -603,7 +918,8 @@ void GET_SCIA_LV1C_GEON( unsigned int nr_geo, const struct geoN_scia *geoN,
 /* pos_esm */
 	       if ( nr == 0 )
 		    Cntr_LinInterPol( NAN, geoN[0].pos_esm, 
-				      geoN[1].pos_esm, nscale, yval );
+				      (nr_geo == 1) ? NAN : geoN[1].pos_esm,
+				      nscale, yval );
 	       else if ( nr == nr_geo-1 )
 		    Cntr_LinInterPol( geoN[-1].pos_esm, geoN[0].pos_esm,
 				      NAN, nscale, yval );
@@ -615,7 +931,8 @@ void GET_SCIA_LV1C_GEON( unsigned int nr_geo, const struct geoN_scia *geoN,
 /* sat_h */
 	       if ( nr == 0 )
 		    Cntr_LinInterPol( NAN, geoN[0].sat_h, 
-				      geoN[1].sat_h, nscale, yval );
+				      (nr_geo == 1) ? NAN : geoN[1].sat_h,
+				      nscale, yval );
 	       else if ( nr == nr_geo-1 )
 		    Cntr_LinInterPol( geoN[-1].sat_h, geoN[0].sat_h,
 				      NAN, nscale, yval );
@@ -627,7 +944,8 @@ void GET_SCIA_LV1C_GEON( unsigned int nr_geo, const struct geoN_scia *geoN,
 /* earth_rad */
 	       if ( nr == 0 )
 		    Cntr_LinInterPol( NAN, geoN[0].earth_rad, 
-				      geoN[1].earth_rad, nscale, yval );
+				      (nr_geo == 1) ? NAN : geoN[1].earth_rad,
+				      nscale, yval );
 	       else if ( nr == nr_geo-1 )
 		    Cntr_LinInterPol( geoN[-1].earth_rad, geoN[0].earth_rad,
 				      NAN, nscale, yval );
@@ -697,92 +1015,65 @@ void GET_SCIA_LV1C_GEON( unsigned int nr_geo, const struct geoN_scia *geoN,
 		    || (geoN->corner[0].lon > -85000000
 			&& geoN->corner[2].lon < 85000000) )
 		    DoLonOffs = FALSE;
-	       Coord2XYZ( DoLonOffs, geoN->corner[0], xx, yy, zz );
-	       Coord2XYZ( DoLonOffs, geoN->corner[1], xx+1, yy+1, zz+1 );
-	       Coord2XYZ( DoLonOffs, geoN->corner[2], xx+2, yy+2, zz+2 );
-	       Coord2XYZ( DoLonOffs, geoN->corner[3], xx+3, yy+3, zz+3 );
-/* ----- corner upper left */
-	       Quick_LinInterPol_d( START_AT_ZERO, xx[1], xx[3], nscale, xval);
-	       Quick_LinInterPol_d( START_AT_ZERO, yy[1], yy[3], nscale, yval);
-	       Quick_LinInterPol_d( START_AT_ZERO, zz[1], zz[3], nscale, zval);
-	       for ( ns = 0; ns < nscale; ns++ ) {
-		    XYZ2Coord( DoLonOffs, xval[ns], yval[ns], zval[ns],
-			       &geoN_1c[ns].corner[1] );
-	       }
-/* ----- corner upper right */
-	       Quick_LinInterPol_d( START_AT_ONE, xx[1], xx[3], nscale, xval );
-	       Quick_LinInterPol_d( START_AT_ONE, yy[1], yy[3], nscale, yval );
-	       Quick_LinInterPol_d( START_AT_ONE, zz[1], zz[3], nscale, zval );
-	       for ( ns = 0; ns < nscale; ns++ ) {
-		    XYZ2Coord( DoLonOffs, xval[ns], yval[ns], zval[ns],
-			       &geoN_1c[ns].corner[3] );
-	       }
-/* ----- corner lower left */
-	       Quick_LinInterPol_d( START_AT_ZERO, xx[0], xx[2], nscale, xval);
-	       Quick_LinInterPol_d( START_AT_ZERO, yy[0], yy[2], nscale, yval);
-	       Quick_LinInterPol_d( START_AT_ZERO, zz[0], zz[2], nscale, zval);
+	       for ( ns = 0; ns < 4; ns++ )
+		    Coord2XYZ( DoLonOffs, geoN->corner[ns], &uvec[ns].xx,
+			       &uvec[ns].yy, &uvec[ns].zz );
+/* ----- corners upper left and upper right (shared by adjacent pixels) */
+	       Edge_LinInterPol_uvec( uvec+1, uvec+3, nscale, uval );
 	       for ( ns = 0; ns < nscale; ns++ ) {
-		    XYZ2Coord( DoLonOffs, xval[ns], yval[ns], zval[ns],
-			       &geoN_1c[ns].corner[0] );
+		    XYZ2Coord( DoLonOffs, uval[ns].xx, uval[ns].yy,
+			       uval[ns].zz, &geoN_1c[ns].corner[1] );
+		    if ( ns > 0 ) 
+			 geoN_1c[ns-1].corner[3] = geoN_1c[ns].corner[1];
 	       }
-/* ----- corner lower right */
-	       Quick_LinInterPol_d( START_AT_ONE, xx[0], xx[2], nscale, xval );
-	       Quick_LinInterPol_d( START_AT_ONE, yy[0], yy[2], nscale, yval );
-	       Quick_LinInterPol_d( START_AT_ONE, zz[0], zz[2], nscale, zval );
+	       XYZ2Coord( DoLonOffs, uval[nscale].xx, uval[nscale].yy,
+			  uval[nscale].zz, &geoN_1c[nscale-1].corner[3] );
+/* ----- corners lower left and lower right (shared by adjacent pixels) */
+	       Edge_LinInterPol_uvec( uvec, uvec+2, nscale, uval_low );
 	       for ( ns = 0; ns < nscale; ns++ ) {
-		    XYZ2Coord( DoLonOffs, xval[ns], yval[ns], zval[ns],
-			       &geoN_1c[ns].corner[2] );
+		    XYZ2Coord( DoLonOffs, uval_low[ns].xx, uval_low[ns].yy,
+			       uval_low[ns].zz, &geoN_1c[ns].corner[0] );
+		    if ( ns > 0 ) 
+			 geoN_1c[ns-1].corner[2] = geoN_1c[ns].corner[0];
 	       }
-/* center_coord */
-	       for ( ns = 0; ns < nscale; ns++ ) {
-		    GET_CNTR_CORNER( geoN_1c[ns].corner, &geoN_1c[ns].center );
-	       }
-/* sub_sat_point */
-	       DoLonOffs = TRUE;
-	       if ( geoN->sub_sat_point.lon < -95000000
-		    || geoN->sub_sat_point.lon > 95000000
-		    || (geoN->sub_sat_point.lon > -85000000
-			&& geoN->sub_sat_point.lon < 85000000) )
-		    DoLonOffs = FALSE;
-	       if ( nr == 0 ) {
-		    Coord2XYZ( DoLonOffs, geoN[0].sub_sat_point, xx, yy, zz );
-		    Coord2XYZ( DoLonOffs, geoN[1].sub_sat_point, 
-			       xx+1, yy+1, zz+1 );
-
-		    Cntr_LinInterPol_d( NAN, xx[0], xx[1], nscale, xval );
-		    Cntr_LinInterPol_d( NAN, yy[0], yy[1], nscale, yval );
-		    Cntr_LinInterPol_d( NAN, zz[0], zz[1], nscale, zval );
-	       } else if ( nr == nr_geo-1 ) {
-		    Coord2XYZ( DoLonOffs, geoN[-1].sub_sat_point, 
-			       xx, yy, zz );
-		    Coord2XYZ( DoLonOffs, geoN[0].sub_sat_point, 
-			       xx+1, yy+1, zz+1 );
-
-		    Cntr_LinInterPol_d( xx[0], xx[1], NAN, nscale, xval );
-		    Cntr_LinInterPol_d( yy[0], yy[1], NAN, nscale, yval );
-		    Cntr_LinInterPol_d( zz[0], zz[1], NAN, nscale, zval );
+	       XYZ2Coord( DoLonOffs, uval_low[nscale].xx, uval_low[nscale].yy,
+			  uval_low[nscale].zz, &geoN_1c[nscale-1].corner[2] );
+/* center_coord: the mid-point of the right edge is the left of the next */
+	       if ( geo_fast_trig ) {
+		    struct geo_uvec mid_A, mid_B;
+
+		    Mid_Uvec( uval_low, uval, &mid_A );
+		    for ( ns = 0; ns < nscale; ns++ ) {
+			 Mid_Uvec( uval_low+ns+1, uval+ns+1, &mid_B );
+			 XYZ2Coord( DoLonOffs, mid_A.xx + mid_B.xx,
+				    mid_A.yy + mid_B.yy, mid_A.zz + mid_B.zz,
+				    &geoN_1c[ns].center );
+			 mid_A = mid_B;
+		    }
 	       } else {
-		    Coord2XYZ( DoLonOffs, geoN[-1].sub_sat_point, 
-			       xx, yy, zz );
-		    Coord2XYZ( DoLonOffs, geoN[0].sub_sat_point, 
-			       xx+1, yy+1, zz+1 );
-		    Coord2XYZ( DoLonOffs, geoN[1].sub_sat_point, 
-			       xx+2, yy+2, zz+2 );
-
-		    Cntr_LinInterPol_d( xx[0], xx[1], xx[2], nscale, xval );
-		    Cntr_LinInterPol_d( yy[0], yy[1], yy[2], nscale, yval );
-		    Cntr_LinInterPol_d( zz[0], zz[1], zz[2], nscale, zval );
+		    struct coord_envi cntr_A, cntr_B;
+
+		    GET_CNTR_COORD( geoN_1c->corner[0], geoN_1c->corner[1],
+				    &cntr_A );
+		    for ( ns = 0; ns < nscale; ns++ ) {
+			 GET_CNTR_COORD( geoN_1c[ns].corner[2],
+					 geoN_1c[ns].corner[3], &cntr_B );
+			 GET_CNTR_COORD( cntr_A, cntr_B, &geoN_1c[ns].center );
+			 cntr_A = cntr_B;
+		    }
 	       }
+/* sub_sat_point */
+	       DoLonOffs = GET_SSP_UVEC( nr, nr_geo, ssp_cache, nscale, uval );
 	       for ( ns = 0; ns < nscale; ns++ ) {
-		    XYZ2Coord( DoLonOffs, xval[ns], yval[ns], zval[ns],
-			       &geoN_1c[ns].sub_sat_point );
+		    XYZ2Coord( DoLonOffs, uval[ns].xx, uval[ns].yy,
+			       uval[ns].zz, &geoN_1c[ns].sub_sat_point );
 	       }
 	       geoN++;
 	       geoN_1c += nscale;	       
 	  }
-	  free( xval );
 	  free( yval );
-	  free( zval );
+	  free( uval );
+	  free( ssp_cache );
      }
 }
 		      
@@ -795,6 +1086,7 @@ void GET_SCIA_LV1C_GEOL( unsigned int nr_geo, const struct geoL_scia *geoL,
 
      unsigned short icntr;
 
+     GEO_INIT_TRIG();
      if ( nr_geo == nr_geo1c ) {
 	  (void) memcpy( geoL_1c, geoL, nr_geo * sizeof( struct geoL_scia ));
      } else if ( nr_geo > nr_geo1c ) {
@@ -864,25 +1156,32 @@ void GET_SCIA_LV1C_GEOL( unsigned int nr_geo, const struct geoL_scia *geoL,
 	       geoL += nscale;
 	  }
      } else {
+	  register int DoLonOffs;
+
 	  const unsigned short nscale = (unsigned short)(nr_geo1c / nr_geo);
 
-	  int DoLonOffs;
-	  double xx[3], yy[3], zz[3];
-	  double *xval, *yval, *zval;
+	  double *yval;
+	  struct geo_uvec uvec[2], *uval;
+	  struct geo_cache *ssp_cache;
 
-          xval = (double *) malloc( nscale * sizeof(double) );
-          if ( xval == NULL ) 
-               NADC_RETURN_ERROR( NADC_ERR_ALLOC, "xval" );
 	  yval = (double *) malloc( nscale * sizeof(double) );
-	  if ( yval == NULL ) {
-	       free( xval );
+	  if ( yval == NULL ) 
 	       NADC_RETURN_ERROR( NADC_ERR_ALLOC, "yval" );
+	  uval = (struct geo_uvec *) 
+	       malloc( (nscale + 1) * sizeof(struct geo_uvec) );
+	  if ( uval == NULL ) {
+	       free( yval );
+	       NADC_RETURN_ERROR( NADC_ERR_ALLOC, "uval" );
 	  }
-          zval = (double *) malloc( nscale * sizeof(double) );
-          if ( zval == NULL ) {
-               free( xval ); free( yval );
-               NADC_RETURN_ERROR( NADC_ERR_ALLOC, "zval" );
-          }
+	  ssp_cache = (struct geo_cache *) 
+	       calloc( nr_geo, sizeof(struct geo_cache) );
+	  if ( ssp_cache == NULL ) {
+	       free( yval ); free( uval );
+	       NADC_RETURN_ERROR( NADC_ERR_ALLOC, "ssp_cache" );
+	  }
+	  for ( nr = 0; nr < nr_geo; nr++ )
+	       ssp_cache[nr].coord = geoL[nr].sub_sat_point;
+
 	  for ( nr = 0; nr < nr_geo; nr++ ) {
 /* pixel_type and glint_flag */
 	       geoL_1c[0].pixel_type = UCHAR_ZERO;
@@ -893,7 +1192,8 @@ void GET_SCIA_LV1C_GEOL( unsigned int nr_geo, const struct geoL_scia *geoL,
 /* pos_asm */
 	       if ( nr == 0 )
 		    Cntr_LinInterPol( NAN, geoL[0].pos_asm, 
-				      geoL[1].pos_asm, nscale, yval );
+				      (nr_geo == 1) ? NAN : geoL[1].pos_asm,
+				      nscale, yval );
 	       else if ( nr == nr_geo-1 )
 		    Cntr_LinInterPol( geoL[-1].pos_asm, geoL[0].pos_asm,
 				      NAN, nscale, yval );
@@ -905,7 +1205,8 @@ void GET_SCIA_LV1C_GEOL( unsigned int nr_geo, const struct geoL_scia *geoL,
 /* pos_esm */
 	       if ( nr == 0 )
 		    Cntr_LinInterPol( NAN, geoL[0].pos_esm, 
-				      geoL[1].pos_esm, nscale, yval );
+				      (nr_geo == 1) ? NAN : geoL[1].pos_esm,
+				      nscale, yval );
 	       else if ( nr == nr_geo-1 )
 		    Cntr_LinInterPol( geoL[-1].pos_esm, geoL[0].pos_esm,
 				      NAN, nscale, yval );
@@ -917,7 +1218,8 @@ void GET_SCIA_LV1C_GEOL( unsigned int nr_geo, const struct geoL_scia *geoL,
 /* sat_h */
 	       if ( nr == 0 )
 		    Cntr_LinInterPol( NAN, geoL[0].sat_h, 
-				      geoL[1].sat_h, nscale, yval );
+				      (nr_geo == 1) ? NAN : geoL[1].sat_h,
+				      nscale, yval );
 	       else if ( nr == nr_geo-1 )
 		    Cntr_LinInterPol( geoL[-1].sat_h, geoL[0].sat_h,
 				      NAN, nscale, yval );
@@ -929,7 +1231,8 @@ void GET_SCIA_LV1C_GEOL( unsigned int nr_geo, const struct geoL_scia *geoL,
 /* earth_rad */
 	       if ( nr == 0 )
 		    Cntr_LinInterPol( NAN, geoL[0].earth_rad, 
-				      geoL[1].earth_rad, nscale, yval );
+				      (nr_geo == 1) ? NAN : geoL[1].earth_rad,
+				      nscale, yval );
 	       else if ( nr == nr_geo-1 )
 		    Cntr_LinInterPol( geoL[-1].earth_rad, geoL[0].earth_rad,
 				      NAN, nscale, yval );
@@ -941,7 +1244,8 @@ void GET_SCIA_LV1C_GEOL( unsigned int nr_geo, const struct geoL_scia *geoL,
 /* dopp_shift */
 	       if ( nr == 0 )
 		    Cntr_LinInterPol( NAN, geoL[0].dopp_shift, 
-				      geoL[1].dopp_shift, nscale, yval );
+				      (nr_geo == 1) ? NAN : geoL[1].dopp_shift,
+				      nscale, yval );
 	       else if ( nr == nr_geo-1 )
 		    Cntr_LinInterPol( geoL[-1].dopp_shift, geoL[0].dopp_shift,
 				      NAN, nscale, yval );
@@ -1016,44 +1320,10 @@ void GET_SCIA_LV1C_GEOL( unsigned int nr_geo, const struct geoL_scia *geoL,
 	       for ( ns = 0; ns < nscale; ns++ )
 		    geoL_1c[ns].tan_h[2] = (float) yval[ns];
 /* sub-satellite point */
-	       DoLonOffs = TRUE;
-	       if ( geoL->sub_sat_point.lon < -95000000
-		    || geoL->sub_sat_point.lon > 95000000
-		    || (geoL->sub_sat_point.lon > -85000000
-			&& geoL->sub_sat_point.lon < 85000000) )
-		    DoLonOffs = FALSE;
-	       if ( nr == 0 ) {
-		    Coord2XYZ( DoLonOffs, geoL[0].sub_sat_point, xx, yy, zz );
-		    Coord2XYZ( DoLonOffs, geoL[1].sub_sat_point, 
-			       xx+1, yy+1, zz+1 );
-
-		    Cntr_LinInterPol_d( NAN, xx[0], xx[1], nscale, xval );
-		    Cntr_LinInterPol_d( NAN, yy[0], yy[1], nscale, yval );
-		    Cntr_LinInterPol_d( NAN, zz[0], zz[1], nscale, zval );
-	       } else if ( nr == nr_geo-1 ) {
-		    Coord2XYZ( DoLonOffs, geoL[-1].sub_sat_point, 
-			       xx, yy, zz );
-		    Coord2XYZ( DoLonOffs, geoL[0].sub_sat_point, 
-			       xx+1, yy+1, zz+1 );
-
-		    Cntr_LinInterPol_d( xx[0], xx[1], NAN, nscale, xval );
-		    Cntr_LinInterPol_d( yy[0], yy[1], NAN, nscale, yval );
-		    Cntr_LinInterPol_d( zz[0], zz[1], NAN, nscale, zval );
-	       } else {
-		    Coord2XYZ( DoLonOffs, geoL[-1].sub_sat_point, 
-			       xx, yy, zz );
-		    Coord2XYZ( DoLonOffs, geoL[0].sub_sat_point, 
-			       xx+1, yy+1, zz+1 );
-		    Coord2XYZ( DoLonOffs, geoL[1].sub_sat_point, 
-			       xx+2, yy+2, zz+2 );
-
-		    Cntr_LinInterPol_d( xx[0], xx[1], xx[2], nscale, xval );
-		    Cntr_LinInterPol_d( yy[0], yy[1], yy[2], nscale, yval );
-		    Cntr_LinInterPol_d( zz[0], zz[1], zz[2], nscale, zval );
-	       }
+	       DoLonOffs = GET_SSP_UVEC( nr, nr_geo, ssp_cache, nscale, uval );
 	       for ( ns = 0; ns < nscale; ns++ ) {
-		    XYZ2Coord( DoLonOffs, xval[ns], yval[ns], zval[ns],
-			       &geoL_1c[ns].sub_sat_point );
+		    XYZ2Coord( DoLonOffs, uval[ns].xx, uval[ns].yy,
+			       uval[ns].zz, &geoL_1c[ns].sub_sat_point );
 	       }
 /* coordinates of tangent ground point */
 	       DoLonOffs = TRUE;
@@ -1062,23 +1332,21 @@ void GET_SCIA_LV1C_GEOL( unsigned int nr_geo, const struct geoL_scia *geoL,
 		    || (geoL->tang_ground_point[0].lon > -85000000
 			&& geoL->tang_ground_point[2].lon < 85000000) )
 		    DoLonOffs = FALSE;
-	       Coord2XYZ( DoLonOffs, geoL->tang_ground_point[0], xx, yy, zz );
-	       Coord2XYZ( DoLonOffs, geoL->tang_ground_point[2], 
-			  xx+1, yy+1, zz+1 );
-               Quick_LinInterPol_d( START_AT_ZERO, xx[0], xx[1], nscale, xval);
-               Quick_LinInterPol_d( START_AT_ZERO, yy[0], yy[1], nscale, yval);
-               Quick_LinInterPol_d( START_AT_ZERO, zz[0], zz[1], nscale, zval);
-               for ( ns = 0; ns < nscale; ns++ ) {
-                    XYZ2Coord( DoLonOffs, xval[ns], yval[ns], zval[ns],
-                               &geoL_1c[ns].tang_ground_point[0] );
-               }
-               Quick_LinInterPol_d( START_AT_ONE, xx[0], xx[1], nscale, xval );
-               Quick_LinInterPol_d( START_AT_ONE, yy[0], yy[1], nscale, yval );
-               Quick_LinInterPol_d( START_AT_ONE, zz[0], zz[1], nscale, zval );
-               for ( ns = 0; ns < nscale; ns++ ) {
-                    XYZ2Coord( DoLonOffs, xval[ns], yval[ns], zval[ns],
-			       &geoL_1c[ns].tang_ground_point[2] );
+	       Coord2XYZ( DoLonOffs, geoL->tang_ground_point[0],
+			  &uvec[0].xx, &uvec[0].yy, &uvec[0].zz );
+	       Coord2XYZ( DoLonOffs, geoL->tang_ground_point[2],
+			  &uvec[1].xx, &uvec[1].yy, &uvec[1].zz );
+	       Edge_LinInterPol_uvec( uvec, uvec+1, nscale, uval );
+	       for ( ns = 0; ns < nscale; ns++ ) {
+		    XYZ2Coord( DoLonOffs, uval[ns].xx, uval[ns].yy,
+			       uval[ns].zz, &geoL_1c[ns].tang_ground_point[0] );
+		    if ( ns > 0 )
+			 geoL_1c[ns-1].tang_ground_point[2] = 
+			      geoL_1c[ns].tang_ground_point[0];
 	       }
+	       XYZ2Coord( DoLonOffs, uval[nscale].xx, uval[nscale].yy,
+			  uval[nscale].zz, 
+			  &geoL_1c[nscale-1].tang_ground_point[2] );
 	       for ( ns = 0; ns < nscale; ns++ ) {
 		    GET_CNTR_COORD( geoL_1c[ns].tang_ground_point[0],
 				    geoL_1c[ns].tang_ground_point[2],
@@ -1087,9 +1355,9 @@ void GET_SCIA_LV1C_GEOL( unsigned int nr_geo, const struct geoL_scia *geoL,
 	       geoL++;
 	       geoL_1c += nscale;
 	  }
-          free( xval );
-          free( yval );
-          free( zval );
+	  free( yval );
+	  free( uval );
+	  free( ssp_cache );
      }
 }
 		      
@@ -1102,6 +1370,7 @@ void GET_SCIA_LV1C_GEOC( unsigned int nr_geo, const struct geoC_scia *geoC,
 
      unsigned short icntr;
 
+     GEO_INIT_TRIG();
      if ( nr_geo == nr_geo1c ) {
 	  (void) memcpy( geoC_1c, geoC, nr_geo * sizeof( struct geoC_scia ));
      } else if ( nr_geo > nr_geo1c ) {
@@ -1132,30 +1401,37 @@ void GET_SCIA_LV1C_GEOC( unsigned int nr_geo, const struct geoC_scia *geoC,
 	       geoC += nscale;
 	  }
      } else {
+	  register int DoLonOffs;
+
 	  const unsigned short nscale = (unsigned short)(nr_geo1c / nr_geo);
 
-	  int DoLonOffs;
-	  double xx[3], yy[3], zz[3];
-	  double *xval, *yval, *zval;
+	  double *yval;
+	  struct geo_uvec *uval;
+	  struct geo_cache *ssp_cache;
 
-          xval = (double *) malloc( nscale * sizeof(double) );
-          if ( xval == NULL ) 
-               NADC_RETURN_ERROR( NADC_ERR_ALLOC, "xval" );
 	  yval = (double *) malloc( nscale * sizeof(double) );
-	  if ( yval == NULL ) {
-	       free( xval );
+	  if ( yval == NULL ) 
 	       NADC_RETURN_ERROR( NADC_ERR_ALLOC, "yval" );
+	  uval = (struct geo_uvec *) malloc( nscale * sizeof(struct geo_uvec) );
+	  if ( uval == NULL ) {
+	       free( yval );
+	       NADC_RETURN_ERROR( NADC_ERR_ALLOC, "uval" );
+	  }
+	  ssp_cache = (struct geo_cache *) 
+	       calloc( nr_geo, sizeof(struct geo_cache) );
+	  if ( ssp_cache == NULL ) {
+	       free( yval ); free( uval );
+	       NADC_RETURN_ERROR( NADC_ERR_ALLOC, "ssp_cache" );
 	  }
-          zval = (double *) malloc( nscale * sizeof(double) );
-          if ( zval == NULL ) {
-               free( xval ); free( yval );
-               NADC_RETURN_ERROR( NADC_ERR_ALLOC, "zval" );
-          }
+	  for ( nr = 0; nr < nr_geo; nr++ )
+	       ssp_cache[nr].coord = geoC[nr].sub_sat_point;
+
 	  for ( nr = 0; nr < nr_geo; nr++ ) {
 /* pos_asm */
 	       if ( nr == 0 )
 		    Cntr_LinInterPol( NAN, geoC[0].pos_asm, 
-				      geoC[1].pos_asm, nscale, yval );
+				      (nr_geo == 1) ? NAN : geoC[1].pos_asm,
+				      nscale, yval );
 	       else if ( nr == nr_geo-1 )
 		    Cntr_LinInterPol( geoC[-1].pos_asm, geoC[0].pos_asm,
 				      NAN, nscale, yval );
@@ -1167,7 +1443,8 @@ void GET_SCIA_LV1C_GEOC( unsigned int nr_geo, const struct geoC_scia *geoC,
 /* pos_esm */
 	       if ( nr == 0 )
 		    Cntr_LinInterPol( NAN, geoC[0].pos_esm, 
-				      geoC[1].pos_esm, nscale, yval );
+				      (nr_geo == 1) ? NAN : geoC[1].pos_esm,
+				      nscale, yval );
 	       else if ( nr == nr_geo-1 )
 		    Cntr_LinInterPol( geoC[-1].pos_esm, geoC[0].pos_esm,
 				      NAN, nscale, yval );
@@ -1179,7 +1456,8 @@ void GET_SCIA_LV1C_GEOC( unsigned int nr_geo, const struct geoC_scia *geoC,
 /* sun_zen_ang */
 	       if ( nr == 0 )
 		    Cntr_LinInterPol( NAN, geoC[0].sun_zen_ang, 
-				      geoC[1].sun_zen_ang, nscale, yval );
+				      (nr_geo == 1) ? NAN : geoC[1].sun_zen_ang,
+				      nscale, yval );
 	       else if ( nr == nr_geo-1 )
 		    Cntr_LinInterPol( geoC[-1].sun_zen_ang, 
 				      geoC[0].sun_zen_ang,
@@ -1191,50 +1469,122 @@ void GET_SCIA_LV1C_GEOC( unsigned int nr_geo, const struct geoC_scia *geoC,
 	       for ( ns = 0; ns < nscale; ns++ )
 		    geoC_1c[ns].sun_zen_ang = (float) yval[ns];
 /* sub-satellite point */
-	       DoLonOffs = TRUE;
-	       if ( geoC->sub_sat_point.lon < -95000000
-		    || geoC->sub_sat_point.lon > 95000000
-		    || (geoC->sub_sat_point.lon > -85000000
-			&& geoC->sub_sat_point.lon < 85000000) )
-		    DoLonOffs = FALSE;
-	       if ( nr == 0 ) {
-		    Coord2XYZ( DoLonOffs, geoC[0].sub_sat_point, xx, yy, zz );
-		    Coord2XYZ( DoLonOffs, geoC[1].sub_sat_point, 
-			       xx+1, yy+1, zz+1 );
-
-		    Cntr_LinInterPol_d( NAN, xx[0], xx[1], nscale, xval );
-		    Cntr_LinInterPol_d( NAN, yy[0], yy[1], nscale, yval );
-		    Cntr_LinInterPol_d( NAN, zz[0], zz[1], nscale, zval );
-	       } else if ( nr == nr_geo-1 ) {
-		    Coord2XYZ( DoLonOffs, geoC[-1].sub_sat_point, 
-			       xx, yy, zz );
-		    Coord2XYZ( DoLonOffs, geoC[0].sub_sat_point, 
-			       xx+1, yy+1, zz+1 );
-
-		    Cntr_LinInterPol_d( xx[0], xx[1], NAN, nscale, xval );
-		    Cntr_LinInterPol_d( yy[0], yy[1], NAN, nscale, yval );
-		    Cntr_LinInterPol_d( zz[0], zz[1], NAN, nscale, zval );
-	       } else {
-		    Coord2XYZ( DoLonOffs, geoC[-1].sub_sat_point, 
-			       xx, yy, zz );
-		    Coord2XYZ( DoLonOffs, geoC[0].sub_sat_point, 
-			       xx+1, yy+1, zz+1 );
-		    Coord2XYZ( DoLonOffs, geoC[1].sub_sat_point, 
-			       xx+2, yy+2, zz+2 );
-
-		    Cntr_LinInterPol_d( xx[0], xx[1], xx[2], nscale, xval );
-		    Cntr_LinInterPol_d( yy[0], yy[1], yy[2], nscale, yval );
-		    Cntr_LinInterPol_d( zz[0], zz[1], zz[2], nscale, zval );
-	       }
+	       DoLonOffs = GET_SSP_UVEC( nr, nr_geo, ssp_cache, nscale, uval );
 	       for ( ns = 0; ns < nscale; ns++ ) {
-		    XYZ2Coord( DoLonOffs, xval[ns], yval[ns], zval[ns],
-			       &geoC_1c[ns].sub_sat_point );
+		    XYZ2Coord( DoLonOffs, uval[ns].xx, uval[ns].yy,
+			       uval[ns].zz, &geoC_1c[ns].sub_sat_point );
 	       }
 	       geoC++;
 	       geoC_1c += nscale;
 	  }
-          free( xval );
-          free( yval );
-          free( zval );
+	  free( yval );
+	  free( uval );
+	  free( ssp_cache );
+     }
+}
+
+/*
+ * test of the interpolation of a state with a single geolocation record,
+ * compile code with
+ *  gcc -O1 -g -fsanitize=address -DTEST_PROG -D_SWAP_TO_LITTLE_ENDIAN \
+ *      -I../include -I/usr/include/hdf5/serial get_scia_lv1c_geo.c \
+ *      -L../libNADC -lnadc -lm
+ *
+ * the records are allocated with their exact size, thus AddressSanitizer
+ * reports any access beyond the last record
+ */
+#ifdef TEST_PROG
+#include <stdio.h>
+
+#define NUM_GEO1C   4
+
+static int num_err = 0;
+
+#define CHECK_EQUAL(name, val, ref)				     \
+     if ( (val) != (ref) ) {					     \
+	  (void) printf( "%s: %g != %g\n", name, (double) (val),     \
+			 (double) (ref) );			     \
+	  num_err++;						     \
+     }
+
+static
+void SET_COORD( int lat, int lon, /*@out@*/ struct coord_envi *coord )
+{
+     coord->lat = lat;
+     coord->lon = lon;
+}
+
+int main( void )
+{
+     register unsigned short ns;
+
+     struct geoN_scia *geoN = calloc( 1, sizeof(struct geoN_scia) );
+     struct geoL_scia *geoL = calloc( 1, sizeof(struct geoL_scia) );
+     struct geoC_scia *geoC = calloc( 1, sizeof(struct geoC_scia) );
+
+     struct geoN_scia geoN_1c[NUM_GEO1C];
+     struct geoL_scia geoL_1c[NUM_GEO1C];
+     struct geoC_scia geoC_1c[NUM_GEO1C];
+/*
+ * nadir
+ */
+     geoN->pos_esm   = 12.5f;
+     geoN->sat_h     = 799.8f;
+     geoN->earth_rad = 6371.2f;
+     SET_COORD( 52000000, 4000000, &geoN->sub_sat_point );
+     SET_COORD( 51000000, 2000000, &geoN->corner[0] );
+     SET_COORD( 53000000, 2000000, &geoN->corner[1] );
+     SET_COORD( 51000000, 6000000, &geoN->corner[2] );
+     SET_COORD( 53000000, 6000000, &geoN->corner[3] );
+     GET_SCIA_LV1C_GEON( 1, geoN, NUM_GEO1C, geoN_1c );
+     for ( ns = 0; ns < NUM_GEO1C; ns++ ) {
+	  CHECK_EQUAL( "geoN.pos_esm", geoN_1c[ns].pos_esm, geoN->pos_esm );
+	  CHECK_EQUAL( "geoN.sat_h", geoN_1c[ns].sat_h, geoN->sat_h );
+	  CHECK_EQUAL( "geoN.earth_rad", geoN_1c[ns].earth_rad, 
+		       geoN->earth_rad );
+	  CHECK_EQUAL( "geoN.sub_sat_point.lat", 
+		       geoN_1c[ns].sub_sat_point.lat,
+		       geoN->sub_sat_point.lat );
+	  CHECK_EQUAL( "geoN.sub_sat_point.lon", 
+		       geoN_1c[ns].sub_sat_point.lon,
+		       geoN->sub_sat_point.lon );
      }
+/*
+ * limb
+ */
+     geoL->pos_esm    = -20.f;
+     geoL->pos_asm    = 3.5f;
+     geoL->sat_h      = 801.2f;
+     geoL->earth_rad  = 6370.9f;
+     geoL->dopp_shift = 0.25f;
+     SET_COORD( -10000000, 170000000, &geoL->sub_sat_point );
+     GET_SCIA_LV1C_GEOL( 1, geoL, NUM_GEO1C, geoL_1c );
+     for ( ns = 0; ns < NUM_GEO1C; ns++ ) {
+	  CHECK_EQUAL( "geoL.pos_esm", geoL_1c[ns].pos_esm, geoL->pos_esm );
+	  CHECK_EQUAL( "geoL.pos_asm", geoL_1c[ns].pos_asm, geoL->pos_asm );
+	  CHECK_EQUAL( "geoL.sat_h", geoL_1c[ns].sat_h, geoL->sat_h );
+	  CHECK_EQUAL( "geoL.earth_rad", geoL_1c[ns].earth_rad, 
+		       geoL->earth_rad );
+	  CHECK_EQUAL( "geoL.dopp_shift", geoL_1c[ns].dopp_shift, 
+		       geoL->dopp_shift );
+     }
+/*
+ * calibration and monitoring
+ */
+     geoC->pos_esm     = 1.f;
+     geoC->pos_asm     = -2.f;
+     geoC->sun_zen_ang = 45.5f;
+     SET_COORD( 0, -90000000, &geoC->sub_sat_point );
+     GET_SCIA_LV1C_GEOC( 1, geoC, NUM_GEO1C, geoC_1c );
+     for ( ns = 0; ns < NUM_GEO1C; ns++ ) {
+	  CHECK_EQUAL( "geoC.pos_esm", geoC_1c[ns].pos_esm, geoC->pos_esm );
+	  CHECK_EQUAL( "geoC.pos_asm", geoC_1c[ns].pos_asm, geoC->pos_asm );
+	  CHECK_EQUAL( "geoC.sun_zen_ang", geoC_1c[ns].sun_zen_ang, 
+		       geoC->sun_zen_ang );
+     }
+     (void) printf( "number of errors: %d\n", num_err );
+
+     free( geoN ); free( geoL ); free( geoC );
+     return num_err > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
 }
+#endif /* TEST_PROG */
@@ -21,9 +21,14 @@
 .LANGUAGE    ANSI C
 .PURPOSE     get orbit parameters from ROE records
 .RETURNS     depends on routine
-.COMMENTS    contains GET_SCIA_ROE_JDAY, GET_SCIA_ROE_INFO
+.COMMENTS    contains GET_SCIA_ROE_JDAY, GET_SCIA_ROE_JDAY_ALL, GET_SCIA_ROE_INFO,
+                      GET_SCIA_ROE_DB_NAME
+             - the ROE database is read only once, all lookups are done
+	       on the tables in memory using a binary search
 .ENVIRONment None
-.VERSION     2.1   11-Sep-2014  updated documentation, fixed minor bugs, RvH
+.VERSION     3.1   17-Oct-2026  added GET_SCIA_ROE_DB_NAME, RvH
+             3.0   17-Oct-2026  keep ROE database in memory, RvH
+             2.1   11-Sep-2014  updated documentation, fixed minor bugs, RvH
              2.0   18-Jan-2008  rewrite and combined different routines, RvH
              1.1   18-Jan-2008  added GET_SCIA_ROE_ORBIT, RvH
              1.0   18-Dec-2007	created by R. M. van Hees 
@@ -36,6 +41,7 @@
 
 /*+++++ System headers +++++*/
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 
 #include <hdf5.h>
@@ -86,140 +92,210 @@ static const size_t roeOffs[NFIELDS] = {
      HOFFSET(struct roe_rec, mlst)
 };
 
+/* ROE database in memory, julianDay and orbitList are sorted */
+static struct {
+     bool           loaded;
+     size_t         numRoe;
+     double         *jday_list;
+     unsigned short *orbit_list;
+     struct roe_rec *roe_list;
+} roe_db = { FALSE, 0, NULL, NULL, NULL };
+
 /*+++++ Global Variables +++++*/
 
 /*+++++++++++++++++++++++++ Static Function(s) +++++++++++++++*/
 /*+++++++++++++++++++++++++
-.IDENTifer   _GET_ROE_INDEX
-.PURPOSE     return index in ROE table for given Julian day
+.IDENTifer   _LOAD_ROE_DB
+.PURPOSE     read ROE database into memory
 .INPUT/OUTPUT
-  call as   roeIndx = _GET_ROE_INDEX( julianDay, &jday_mn, &jday_mx );
-     input:
-	     double julianDay  :  julian Day (# days since 2000-01-01)
+  call as   _LOAD_ROE_DB();
 
-.RETURNS     index to ROE table for given julianDay
+.RETURNS     nothing
              error status passed by global variable ``nadc_stat''
-.COMMENTS    static function
+.COMMENTS    static function, the file is only read at the first call
 -------------------------*/
 static
-size_t _GET_ROE_INDEX( hid_t fileID, double jday, 
-		       /*@out@*/ double *jday_mn, /*@out@*/ double *jday_mx )
+void _LOAD_ROE_DB( void )
 {
-     register size_t indx = 0;
+     char    string[MAX_STRING_LENGTH];
 
-     size_t  numRoe;
-     hsize_t adim;
+     hid_t   fileID = -1;
+     hsize_t adim, nfields, nrecords;
      herr_t  stat;
 
-     double  *jday_list = NULL;
+     size_t  numRoe;
 
-     *jday_mn = *jday_mx = -1.;
+     const size_t roeSizes[NFIELDS] = {
+	  sizeof(roe_db.roe_list->julianDay),
+	  sizeof(roe_db.roe_list->orbit),
+	  sizeof(roe_db.roe_list->relOrbit),
+	  sizeof(roe_db.roe_list->phase),
+	  sizeof(roe_db.roe_list->cycle),
+	  sizeof(roe_db.roe_list->repeat),
+	  sizeof(roe_db.roe_list->saaDay),
+	  sizeof(roe_db.roe_list->saaEclipse),
+	  sizeof(roe_db.roe_list->eclipseExit),
+	  sizeof(roe_db.roe_list->eclipseEntry),
+	  sizeof(roe_db.roe_list->period),
+	  sizeof(roe_db.roe_list->anxLongitude),
+	  sizeof(roe_db.roe_list->UTC_anx),
+	  sizeof(roe_db.roe_list->UTC_flt),
+	  sizeof(roe_db.roe_list->mlst)
+     };
+
+     if ( roe_db.loaded ) return;
 /*
- * read info_h5 records
+ * open ROE-database
  */
-     stat = H5LTget_dataset_info( fileID, "julianDay", &adim, NULL, NULL );
-     if ( stat < 0 || (numRoe = (size_t) adim) == 0 ) 
-	  NADC_GOTO_ERROR( NADC_ERR_HDF_RD, "julianDay" );
+     (void) snprintf( string, MAX_STRING_LENGTH, "./%s", name_ROE_db );
+     H5E_BEGIN_TRY {
+          fileID = H5Fopen( string, H5F_ACC_RDONLY, H5P_DEFAULT );
+     } H5E_END_TRY;
+     if ( fileID < 0 ) {
+          (void) snprintf( string, MAX_STRING_LENGTH, "%s/%s", 
+			   DATA_DIR, name_ROE_db );
+          fileID = H5Fopen( string, H5F_ACC_RDONLY, H5P_DEFAULT );
+          if ( fileID < 0 )
+	       NADC_GOTO_ERROR( NADC_ERR_HDF_FILE, string );
+     }
 /*
  * read julian dates
  */
-     if ( (jday_list = (double *) malloc( numRoe * sizeof(double))) == NULL )
+     stat = H5LTget_dataset_info( fileID, "julianDay", &adim, NULL, NULL );
+     if ( stat < 0 || (numRoe = (size_t) adim) == 0 ) 
+	  NADC_GOTO_ERROR( NADC_ERR_HDF_RD, "julianDay" );
+     roe_db.jday_list = (double *) malloc( numRoe * sizeof(double) );
+     if ( roe_db.jday_list == NULL )
 	  NADC_GOTO_ERROR( NADC_ERR_ALLOC, "jday_list" );
-     if ( H5LTread_dataset_double ( fileID, "julianDay", jday_list ) < 0 )
+     if ( H5LTread_dataset_double( fileID, "julianDay", roe_db.jday_list ) < 0 )
 	  NADC_GOTO_ERROR( NADC_ERR_HDF_RD, "julianDay" );
 /*
- * search for match
+ * read orbit numbers
+ */
+     roe_db.orbit_list = (unsigned short *) malloc( numRoe * sizeof(short) );
+     if ( roe_db.orbit_list == NULL )
+	  NADC_GOTO_ERROR( NADC_ERR_ALLOC, "orbit_list" );
+     stat = H5LTread_dataset( fileID, "orbitList", H5T_NATIVE_USHORT, 
+			      roe_db.orbit_list );
+     if ( stat < 0 )
+	  NADC_GOTO_ERROR( NADC_ERR_HDF_RD, "orbitList" );
+/*
+ * read whole ROE-table
  */
-     while( indx < (numRoe-1) && jday >= jday_list[indx+1] ) indx++;
-     if ( indx == (numRoe-1) || jday < jday_list[indx] ) 
-	  NADC_GOTO_ERROR( NADC_ERR_WARN, "no solution found" );
-     *jday_mn = jday_list[indx];
-     *jday_mx = jday_list[indx+1];
-
-     free( jday_list );
-     return indx;
+     stat = H5TBget_table_info( fileID, "roe_entry", &nfields, &nrecords );
+     if ( stat < 0 || (size_t) nrecords < numRoe )
+	  NADC_GOTO_ERROR( NADC_ERR_HDF_RD, "roe_entry" );
+     roe_db.roe_list = (struct roe_rec *) 
+	  malloc( (size_t) nrecords * sizeof(struct roe_rec) );
+     if ( roe_db.roe_list == NULL )
+	  NADC_GOTO_ERROR( NADC_ERR_ALLOC, "roe_list" );
+     stat = H5TBread_table( fileID, "roe_entry", roeSize, roeOffs, roeSizes,
+			    roe_db.roe_list );
+     if ( stat < 0 ) NADC_GOTO_ERROR( NADC_ERR_HDF_RD, "roe_entry" );
+
+     roe_db.numRoe = numRoe;
+     roe_db.loaded = TRUE;
+     (void) H5Fclose( fileID );
+     return;
  done:
-     if ( jday_list != NULL ) free( jday_list );
-     return 0;
+     if ( fileID > 0 ) (void) H5Fclose( fileID );
+     if ( roe_db.roe_list != NULL ) free( roe_db.roe_list );
+     if ( roe_db.orbit_list != NULL ) free( roe_db.orbit_list );
+     if ( roe_db.jday_list != NULL ) free( roe_db.jday_list );
+     roe_db.roe_list = NULL;
+     roe_db.orbit_list = NULL;
+     roe_db.jday_list = NULL;
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   _GET_ROE_INDEX
+.PURPOSE     return index in ROE table for given Julian day
+.INPUT/OUTPUT
+  call as   roeIndx = _GET_ROE_INDEX( julianDay );
+     input:
+	     double julianDay  :  julian Day (# days since 2000-01-01)
+
+.RETURNS     index to ROE table for given julianDay, or -1 if not found
+.COMMENTS    static function, binary search in sorted list of julian dates
+-------------------------*/
+static
+long _GET_ROE_INDEX( double jday )
+{
+     size_t low = 0;
+     size_t high = roe_db.numRoe - 1;
+
+     if ( roe_db.numRoe < 2 || jday < roe_db.jday_list[0]
+	  || jday >= roe_db.jday_list[high] ) return -1;
+
+     /* invariant: jday_list[low] <= jday < jday_list[high] */
+     while ( high - low > 1 ) {
+	  size_t mid = low + (high - low) / 2;
+
+	  if ( jday >= roe_db.jday_list[mid] )
+	       low = mid;
+	  else
+	       high = mid;
+     }
+     return (long) low;
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   _GET_ROE_ORBIT_INDEX
+.PURPOSE     return index in ROE table for given absolute orbit number
+.INPUT/OUTPUT
+  call as   roeIndx = _GET_ROE_ORBIT_INDEX( absOrbit );
+     input:
+	     unsigned short absOrbit : absolute orbit number
+
+.RETURNS     index to ROE table for given orbit, or -1 if not found
+.COMMENTS    static function, binary search in sorted list of orbits
+-------------------------*/
+static
+long _GET_ROE_ORBIT_INDEX( unsigned short absOrbit )
+{
+     size_t low = 0;
+     size_t high = roe_db.numRoe - 1;
+
+     if ( roe_db.numRoe < 2 || absOrbit < roe_db.orbit_list[0]
+	  || absOrbit >= roe_db.orbit_list[high] ) return -1;
+
+     /* invariant: orbit_list[low] <= absOrbit < orbit_list[high] */
+     while ( high - low > 1 ) {
+	  size_t mid = low + (high - low) / 2;
+
+	  if ( absOrbit >= roe_db.orbit_list[mid] )
+	       low = mid;
+	  else
+	       high = mid;
+     }
+     return (long) low;
 }
 
 /*+++++++++++++++++++++++++
 .IDENTifer   _GET_ROE_ENTRY
 .PURPOSE     return ROE record for given Julian day (fast)
 .INPUT/OUTPUT
-  call as   orbit = _GET_ROE_ENTRY( julianDay, &roe );
+  call as   roe = _GET_ROE_ENTRY( julianDay );
      input:
 	     double julianDay  :  julian Day (# days since 2000-01-01)
-    output:
-             struct roe_rec *roe : ROE record (required static in caller)
 
-.RETURNS     absolute orbit number for given julianDay
+.RETURNS     pointer to ROE record for given julianDay, NULL if not found
              error status passed by global variable ``nadc_stat''
 .COMMENTS    static function
 -------------------------*/
 static
-int _GET_ROE_ENTRY( double jday, /*@out@*/ struct roe_rec *roe )
+const struct roe_rec *_GET_ROE_ENTRY( double jday )
 {
-     char    string[MAX_STRING_LENGTH];
+     long indxEntry;
 
-     hid_t   fileID = -1;
-     herr_t  stat;
+     _LOAD_ROE_DB();
+     if ( ! roe_db.loaded ) return NULL;
 
-     static size_t  indxEntry = 0;
-     static double  jday_mn = -1.;
-     static double  jday_mx = -1.;
-
-     const size_t roeSizes[NFIELDS] = {
-	  sizeof(roe->julianDay),
-	  sizeof(roe->orbit),
-	  sizeof(roe->relOrbit),
-	  sizeof(roe->phase),
-	  sizeof(roe->cycle),
-	  sizeof(roe->repeat),
-	  sizeof(roe->saaDay),
-	  sizeof(roe->saaEclipse),
-	  sizeof(roe->eclipseExit),
-	  sizeof(roe->eclipseEntry),
-	  sizeof(roe->period),
-	  sizeof(roe->anxLongitude),
-	  sizeof(roe->UTC_anx),
-	  sizeof(roe->UTC_flt),
-	  sizeof(roe->mlst)
-     };
-/*
- * do we need an update of the ROE record?
- */
-     if ( jday >= jday_mn && jday < jday_mx ) return roe->orbit;
-/*
- * open output HDF5-file
- */
-     (void) snprintf( string, MAX_STRING_LENGTH, "./%s", name_ROE_db );
-     H5E_BEGIN_TRY {
-          fileID = H5Fopen( string, H5F_ACC_RDONLY, H5P_DEFAULT );
-     } H5E_END_TRY;
-     if ( fileID < 0 ) {
-          (void) snprintf( string, MAX_STRING_LENGTH, "%s/%s", 
-			   DATA_DIR, name_ROE_db );
-          fileID = H5Fopen( string, H5F_ACC_RDONLY, H5P_DEFAULT );
-          if ( fileID < 0 )
-	       NADC_GOTO_ERROR( NADC_ERR_HDF_FILE, string );
+     if ( (indxEntry = _GET_ROE_INDEX( jday )) < 0 ) {
+	  NADC_ERROR( NADC_ERR_WARN, "no solution found" );
+	  return NULL;
      }
-/*
- * get index to list with ROE entries
- */
-     indxEntry = _GET_ROE_INDEX( fileID, jday, &jday_mn, &jday_mx );
-     if ( jday_mx < 0. ) goto done;
-/*
- * read whole ROE-record
- */
-     stat = H5TBread_records( fileID, "roe_entry", (hsize_t) indxEntry, 1,
-			      roeSize, roeOffs, roeSizes, roe );
-     if ( stat < 0 ) NADC_GOTO_ERROR( NADC_ERR_HDF_RD, "roe_entry" );
-     (void) H5Fclose( fileID );
-     return roe->orbit;
-done:
-     if ( fileID > 0 ) (void) H5Fclose( fileID );
-     return -1;
+     return &roe_db.roe_list[indxEntry];
 }
 
 /*+++++++++++++++++++++++++ Main Program or Function +++++++++++++++*/
@@ -247,7 +323,7 @@ void GET_SCIA_ROE_INFO( bool eclipseMode, const double jday,
 {
      const double secPerDay = 60. * 60 * 24;
 
-     static struct roe_rec roe;
+     const struct roe_rec *roe;
 
      double tdiff, phase;
 /*
@@ -259,26 +335,26 @@ void GET_SCIA_ROE_INFO( bool eclipseMode, const double jday,
 /*
  * get absOrbit and ROE entry for given julianDay
  */
-     if ( _GET_ROE_ENTRY( jday, &roe ) < 0 ) return;
+     if ( (roe = _GET_ROE_ENTRY( jday )) == NULL ) return;
 
      /* set absolute orbit number */
-     *absOrbit = roe.orbit;
+     *absOrbit = roe->orbit;
 
      /* calculate orbit phase */
-     tdiff = (jday - roe.julianDay) * secPerDay - roe.eclipseEntry;
-     phase = fmod( tdiff, roe.period ) / roe.period;
+     tdiff = (jday - roe->julianDay) * secPerDay - roe->eclipseEntry;
+     phase = fmod( tdiff, roe->period ) / roe->period;
      if ( ! eclipseMode ) {
 	  phase += 0.5 *
-	       ((roe.eclipseEntry - roe.eclipseExit) / roe.period - 0.5);
+	       ((roe->eclipseEntry - roe->eclipseExit) / roe->period - 0.5);
      }
      *orbitPhase = ((phase >= 0) ? (float) phase : (float) (phase + 1));
 
      /* set SAA flag */
-     tdiff = (jday - roe.julianDay) * secPerDay;
-     if ( tdiff > roe.eclipseExit && tdiff < roe.eclipseEntry )
-	  *saaFlag = (roe.saaDay == UCHAR_ZERO);
+     tdiff = (jday - roe->julianDay) * secPerDay;
+     if ( tdiff > roe->eclipseExit && tdiff < roe->eclipseEntry )
+	  *saaFlag = (roe->saaDay == UCHAR_ZERO);
      else
-	  *saaFlag = (roe.saaEclipse == UCHAR_ZERO);
+	  *saaFlag = (roe->saaEclipse == UCHAR_ZERO);
 }
 
 /*+++++++++++++++++++++++++
@@ -295,70 +371,16 @@ void GET_SCIA_ROE_INFO( bool eclipseMode, const double jday,
 -------------------------*/
 double GET_SCIA_ROE_JDAY( unsigned short absOrbit )
 {
-     register size_t nr;
+     long indx;
 
-     char    string[MAX_STRING_LENGTH];
-
-     hid_t   fileID = -1;
-     size_t numRoe;
-     hsize_t adim;
-     herr_t  stat;
-
-     double jday = -1.;
+     _LOAD_ROE_DB();
+     if ( ! roe_db.loaded ) return -1.;
 
-     unsigned short *orbit_list = NULL;
-     double         *jday_list = NULL;
-/*
- * open ROE-database
- */
-     (void) snprintf( string, MAX_STRING_LENGTH, "./%s", name_ROE_db );
-     H5E_BEGIN_TRY {
-          fileID = H5Fopen( string, H5F_ACC_RDONLY, H5P_DEFAULT );
-     } H5E_END_TRY;
-     if ( fileID < 0 ) {
-          (void) snprintf( string, MAX_STRING_LENGTH, "%s/%s", 
-			   DATA_DIR, name_ROE_db );
-          fileID = H5Fopen( string, H5F_ACC_RDONLY, H5P_DEFAULT );
-          if ( fileID < 0 )
-	       NADC_GOTO_ERROR( NADC_ERR_HDF_FILE, string );
+     if ( (indx = _GET_ROE_ORBIT_INDEX( absOrbit )) < 0 ) {
+	  NADC_ERROR( NADC_ERR_WARN, "no solution found" );
+	  return -1.;
      }
-/*
- * read info_h5 records
- */
-     stat = H5LTget_dataset_info( fileID, "julianDay", &adim, NULL, NULL );
-     if ( stat < 0 || (numRoe = (size_t) adim) == 0 ) 
-	  NADC_GOTO_ERROR( NADC_ERR_HDF_RD, "julianDay" );
-/*
- * read julian dates
- */
-     if ( (jday_list = (double *) malloc( numRoe * sizeof(double))) == NULL )
-	  NADC_GOTO_ERROR( NADC_ERR_ALLOC, "jday_list" );
-     if ( H5LTread_dataset_double( fileID, "julianDay", jday_list ) < 0 )
-	  NADC_GOTO_ERROR( NADC_ERR_HDF_RD, "julianDay" );
-/*
- * read orbit numbers
- */
-     orbit_list = (unsigned short *) malloc( numRoe * sizeof(short) );
-     if ( orbit_list == NULL )
-	  NADC_GOTO_ERROR( NADC_ERR_ALLOC, "orbit_list" );
-     stat = H5LTread_dataset( fileID, "orbitList", H5T_NATIVE_USHORT, 
-			      orbit_list );
-     if ( stat < 0 )
-	  NADC_GOTO_ERROR( NADC_ERR_HDF_RD, "orbitList" );
-/*
- * search for match
- */
-     nr = 0;
-     while( nr < (numRoe-1) && absOrbit >= orbit_list[nr+1] ) nr++;
-
-     if ( nr == (numRoe-1) || absOrbit < orbit_list[nr] ) 
-	  NADC_GOTO_ERROR( NADC_ERR_WARN, "no solution found" );
-     jday = jday_list[nr];
- done:
-     if ( orbit_list != NULL ) free( orbit_list );
-     if ( jday_list != NULL ) free( jday_list );
-     if ( fileID > 0 ) (void) H5Fclose( fileID );
-     return jday;
+     return roe_db.jday_list[indx];
 }
 
 /*+++++++++++++++++++++++++
@@ -375,48 +397,46 @@ double GET_SCIA_ROE_JDAY( unsigned short absOrbit )
 -------------------------*/
 size_t GET_SCIA_ROE_JDAY_ALL( double **jday_out )
 {
-     char    string[MAX_STRING_LENGTH];
+     double *jday_arr = NULL;
 
-     hid_t   fileID = -1;
-     hsize_t numRoe;
-     herr_t  stat;
+     *jday_out = NULL;
 
-     size_t num_jday = 0;
-     double *jday_arr = NULL;
-/*
- * open ROE-database
- */
-     (void) snprintf( string, MAX_STRING_LENGTH, "./%s", name_ROE_db );
-     H5E_BEGIN_TRY {
-          fileID = H5Fopen( string, H5F_ACC_RDONLY, H5P_DEFAULT );
-     } H5E_END_TRY;
-     if ( fileID < 0 ) {
-          (void) snprintf( string, MAX_STRING_LENGTH, "%s/%s", 
-			   DATA_DIR, name_ROE_db );
-          fileID = H5Fopen( string, H5F_ACC_RDONLY, H5P_DEFAULT );
-          if ( fileID < 0 )
-	       NADC_GOTO_ERROR( NADC_ERR_HDF_FILE, string );
+     _LOAD_ROE_DB();
+     if ( ! roe_db.loaded ) return 0;
+
+     jday_arr = (double *) malloc( roe_db.numRoe * sizeof(double) );
+     if ( jday_arr == NULL ) {
+	  NADC_ERROR( NADC_ERR_ALLOC, "jday_arr" );
+	  return 0;
      }
-/*
- * obtain size of array julianDay
- */
-     stat = H5LTget_dataset_info( fileID, "julianDay", &numRoe, NULL, NULL );
-     if ( stat < 0 || numRoe == 0 ) 
-	  NADC_GOTO_ERROR( NADC_ERR_HDF_DATA, "julianDay" );
-/*
- * read julian dates
- */
-     jday_arr = (double *) malloc( (size_t) numRoe * sizeof(double));
-     if ( jday_arr == NULL )
-	  NADC_GOTO_ERROR( NADC_ERR_ALLOC, "jday_arr" );
-     if ( H5LTread_dataset_double( fileID, "julianDay", jday_arr ) < 0 )
-	  NADC_GOTO_ERROR( NADC_ERR_HDF_RD, "julianDay" );
-     num_jday = (size_t) numRoe;
- done:
-     if ( fileID > 0 ) (void) H5Fclose( fileID );
+     (void) memcpy( jday_arr, roe_db.jday_list, 
+		    roe_db.numRoe * sizeof(double) );
      *jday_out = jday_arr;
 
-     return num_jday;
+     return roe_db.numRoe;
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   GET_SCIA_ROE_DB_NAME
+.PURPOSE     obtain the name of the ROE database
+.INPUT/OUTPUT
+  call as   flname = GET_SCIA_ROE_DB_NAME();
+
+.RETURNS     name of the database, NULL if it does not exist
+.COMMENTS    same search order as _LOAD_ROE_DB: working directory, DATA_DIR
+-------------------------*/
+const char *GET_SCIA_ROE_DB_NAME( void )
+{
+     static char roe_file[MAX_STRING_LENGTH] = "";
+
+     (void) snprintf( roe_file, MAX_STRING_LENGTH, "./%s", name_ROE_db );
+     if ( nadc_file_exists( roe_file ) ) return roe_file;
+
+     (void) snprintf( roe_file, MAX_STRING_LENGTH, "%s/%s", 
+		      DATA_DIR, name_ROE_db );
+     if ( nadc_file_exists( roe_file ) ) return roe_file;
+
+     return NULL;
 }
 /*
  * +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -20,14 +20,20 @@
 .KEYWORDS    SCIA level 0 data
 .LANGUAGE    ANSI C
 .PURPOSE     Perform L0 detector DSR checks
-.COMMENTS    contains CLUSDEF_DB_EXISTS
+.COMMENTS    contains CLUSDEF_DB_EXISTS, CLUSDEF_DB_NAME
                       CLUSDEF_INVALID, CLUSDEF_DSR_SIZE, CLUSDEF_INTG_MIN, 
                       CLUSDEF_DURATION, CLUSDEF_NUM_DET, CLUSDEF_NUM_AUX, 
 		      CLUSDEF_NUM_PMD, CLUSDEF_CLCON
 
              Uses state/cluster configuration database nadc_clusDef.h5
+	     - the database is opened once, the metaTable and clusDef
+	       tables of a state are read into memory at first use
 .ENVIRONment None
-.VERSION     1.1     15-Nov-2013   added documentation, minor bug-fixes, RvH
+.VERSION     2.2     17-Oct-2026   added CLUSDEF_DB_NAME, RvH
+             2.1     17-Oct-2026   bugfix: CLUSDEF_DB_EXISTS returned TRUE after
+                                   a failed search, RvH
+             2.0     17-Oct-2026   keep database open and tables in memory, RvH
+             1.1     15-Nov-2013   added documentation, minor bug-fixes, RvH
              1.0     02-Nov-2013   initial release by R. M. van Hees
 ------------------------------------------------------------*/
 /*
@@ -37,6 +43,7 @@
 #define  _ISOC99_SOURCE
 
 /*+++++ System headers +++++*/
+#include <stdlib.h>
 #include <string.h>
 
 #include <hdf5.h>
@@ -82,36 +89,45 @@ static char clusDef_file[MAX_STRING_LENGTH] = "";
 static unsigned char  stateID_prev = 0;
 static unsigned short absOrbit_prev = 0;
 
+/* database handle and tables in memory, per state */
+static hid_t clusDef_fid = -1;
+
+static struct clusDef_state_rec {
+     bool    loaded;
+     bool    absent;
+     hsize_t num_mtbl;
+     hsize_t num_clcon;
+     struct scia_mtbl_rec    *mtbl;
+     struct scia_clusDef_rec *clcon;
+} clusDef_db[MAX_NUM_STATE+1];
+
 /*+++++++++++++++++++++++++ Static Functions +++++++++++++++++++++++*/
 /*+++++++++++++++++++++++++
 .IDENTifer   _SCIA_H5_RD_CLUSDEF
-.PURPOSE     obtain cluster configuration
+.PURPOSE     read all cluster configurations of a state
 .INPUT/OUTPUT
-  call as   stat = _SCIA_H5_RD_CLUSDEF(locID, metaIndex);
+  call as   stat = _SCIA_H5_RD_CLUSDEF(locID, state_db);
      input:
              hid_t locID               : hdf5 pointer to group
-	     unsigned short metaIndex  : record to read from HDF5 dataset
+ in/output:
+             struct clusDef_state_rec *state_db : tables of state
 
-.RETURNS     succesful read return 1 else -1
+.RETURNS     succesful read return 0 else -1
              error status passed by global variable ``nadc_stat''
 .COMMENTS    static function
 -------------------------*/
 static
-herr_t _SCIA_H5_RD_CLUSDEF(hid_t locID, unsigned short metaIndex)
-       /*@globals  clusDef;@*/
-       /*@modifies clusDef@*/
+herr_t _SCIA_H5_RD_CLUSDEF(hid_t locID, struct clusDef_state_rec *state_db)
+       /*@modifies state_db@*/
 {
      const char tableName[] = "clusDef";
 
      hid_t  dataID = -1;
      hid_t  typeID = -1, mem_typeID = -1;
-     hid_t  spaceID = -1, mem_spaceID = -1;
+     hid_t  spaceID = -1;
      herr_t stat;
 
-     const int     rank = 2;
-
-     const hsize_t start[] = {metaIndex, 0};
-     const hsize_t count[] = {1, MAX_CLUSTER};
+     hsize_t dims[2];
 
      if ((dataID = H5Dopen(locID, tableName, H5P_DEFAULT)) < 0)
 	  NADC_GOTO_ERROR(NADC_ERR_HDF_RD, tableName);
@@ -126,28 +142,31 @@ herr_t _SCIA_H5_RD_CLUSDEF(hid_t locID, unsigned short metaIndex)
      /* Get the dataspace handle */
      if ((spaceID = H5Dget_space(dataID)) < 0)
           NADC_GOTO_ERROR(NADC_ERR_HDF_SPACE, tableName);
-
-     /* Create a memory dataspace handle */
-     if ((mem_spaceID = H5Screate_simple(rank, count, NULL)) < 0)
+     if (H5Sget_simple_extent_ndims(spaceID) != 2)
+          NADC_GOTO_ERROR(NADC_ERR_HDF_SPACE, tableName);
+     (void) H5Sget_simple_extent_dims(spaceID, dims, NULL);
+     if (dims[1] != MAX_CLUSTER)
           NADC_GOTO_ERROR(NADC_ERR_HDF_SPACE, tableName);
 
-     /* Select hyperslap */
-     stat = H5Sselect_hyperslab(spaceID, H5S_SELECT_SET, 
-				 start, NULL, count, NULL);
-     if (stat < 0) NADC_GOTO_ERROR(NADC_ERR_HDF_DATA, tableName);
-
-     stat = H5Dread(dataID, mem_typeID, mem_spaceID, spaceID,
-		     H5P_DEFAULT, clusDef);
+     /* read all cluster configurations at once */
+     state_db->clcon = (struct scia_clusDef_rec *)
+	  malloc((size_t) (dims[0] * dims[1]) 
+		 * sizeof(struct scia_clusDef_rec));
+     if (state_db->clcon == NULL)
+	  NADC_GOTO_ERROR(NADC_ERR_ALLOC, "clcon");
+     stat = H5Dread(dataID, mem_typeID, H5S_ALL, H5S_ALL,
+		     H5P_DEFAULT, state_db->clcon);
      if (stat < 0) NADC_GOTO_ERROR(NADC_ERR_HDF_RD, tableName);
+     state_db->num_clcon = dims[0];
 
-     (void) H5Sclose(mem_spaceID);
      (void) H5Sclose(spaceID);
      (void) H5Tclose(mem_typeID);
      (void) H5Tclose(typeID);
      (void) H5Dclose(dataID);
      return 0;
 done:
-     if (mem_spaceID >= 0) (void) H5Sclose(mem_spaceID);
+     if (state_db->clcon != NULL) free(state_db->clcon);
+     state_db->clcon = NULL;
      if (spaceID >= 0) (void) H5Sclose(spaceID);
      if (mem_typeID >= 0) (void) H5Tclose(mem_typeID);
      if (typeID >= 0) (void) H5Tclose(typeID);
@@ -156,22 +175,21 @@ done:
 }
 
 /*+++++++++++++++++++++++++
-.IDENTifer   _SET_SCIA_CLUSDEF
-.PURPOSE     set global variables for given state and orbit number
+.IDENTifer   _LOAD_SCIA_CLUSDEF
+.PURPOSE     read metaTable and clusDef tables of a state into memory
 .INPUT/OUTPUT
-  call as   stat = _SET_SCIA_CLUSDEF(stateID, absOrbit);
+  call as   state_db = _LOAD_SCIA_CLUSDEF(stateID);
      input:
              unsigned char stateID       :  State ID
-	     unsigned short absOrbit     :  orbit number
 
-.RETURNS     succesful read return 0; empty mtbl-entry return 1;
-             unknown Clcon-entry return 2; else negative
-.COMMENTS    static function
+.RETURNS     tables of the state, NULL on failure
+             error status passed by global variable ``nadc_stat''
+.COMMENTS    static function, opens the database at the first call
 -------------------------*/
 static
-int _SET_SCIA_CLUSDEF(unsigned char stateID, unsigned short absOrbit)
-       /*@globals  metaTable, clusDef, stateID_prev, absOrbit_prev;@*/
-       /*@modifies metaTable, stateID_prev, absOrbit_prev@*/
+struct clusDef_state_rec *_LOAD_SCIA_CLUSDEF(unsigned char stateID)
+       /*@globals  clusDef_fid, clusDef_db;@*/
+       /*@modifies clusDef_fid, clusDef_db@*/
 {
      const size_t mtbl_size = sizeof(struct scia_mtbl_rec);
      const size_t mtbl_offs[NFIELDS_MTBL] = {
@@ -193,63 +211,126 @@ int _SET_SCIA_CLUSDEF(unsigned char stateID, unsigned short absOrbit)
 
      char    grpName[9];
 
-     hid_t   fid = -1;
      hid_t   gid = -1;
+     hsize_t nfields;
      herr_t  stat;
 
+     struct clusDef_state_rec *state_db;
+
      char msg[SHORT_STRING_LENGTH];
-/*
- * set global variables
- */
-     stateID_prev  = stateID;
-     absOrbit_prev = absOrbit;
 
-     /* open output HDF5-file */
-     if (! CLUSDEF_DB_EXISTS()) {
-	  res = snprintf(msg, SHORT_STRING_LENGTH, 
-			 "can not open file: %s", clusDef_file);
-	  if (res > (int) SHORT_STRING_LENGTH)
-	       NADC_ERROR(NADC_ERR_WARN, "msg truncated");
-	  NADC_GOTO_ERROR(NADC_ERR_NONE, msg);
+     /* open HDF5-file, only once */
+     if (clusDef_fid < 0) {
+	  if (! CLUSDEF_DB_EXISTS()) {
+	       res = snprintf(msg, SHORT_STRING_LENGTH, 
+			      "can not find file: %s", name_clusDef_db);
+	       if (res > (int) SHORT_STRING_LENGTH)
+		    NADC_ERROR(NADC_ERR_WARN, "msg truncated");
+	       NADC_ERROR(NADC_ERR_NONE, msg);
+	       return NULL;
+	  }
+	  clusDef_fid = H5Fopen(clusDef_file, H5F_ACC_RDONLY, H5P_DEFAULT);
+	  if (clusDef_fid < 0) {
+	       NADC_ERROR(NADC_ERR_HDF_FILE, clusDef_file);
+	       return NULL;
+	  }
      }
-     fid = H5Fopen(clusDef_file, H5F_ACC_RDONLY, H5P_DEFAULT);
-     if (fid < 0) NADC_GOTO_ERROR(NADC_ERR_HDF_FILE, clusDef_file);
 
      /* open group with data of requested state */
      res = snprintf(grpName, 9, "State_%02hhu", stateID);
      if (res > 9)
 	  NADC_ERROR(NADC_ERR_WARN, "grpName truncated");
+     if (stateID > MAX_NUM_STATE) {
+	  NADC_ERROR(NADC_ERR_HDF_GRP, grpName);
+	  return NULL;
+     }
+     state_db = &clusDef_db[stateID];
+     if (state_db->loaded) return state_db;
+     if (state_db->absent) {
+	  NADC_ERROR(NADC_ERR_HDF_GRP, grpName);
+	  return NULL;
+     }
+
      H5E_BEGIN_TRY {
-          gid = H5Gopen(fid, grpName, H5P_DEFAULT);
+          gid = H5Gopen(clusDef_fid, grpName, H5P_DEFAULT);
      } H5E_END_TRY;
-     if (gid < 0) NADC_GOTO_ERROR(NADC_ERR_HDF_GRP, grpName);
+     if (gid < 0) {
+	  state_db->absent = TRUE;
+	  NADC_GOTO_ERROR(NADC_ERR_HDF_GRP, grpName);
+     }
 
-     /* read metaTable record */
-     stat = H5TBread_records(gid, "metaTable", absOrbit, 1,
-			     mtbl_size, mtbl_offs, mtbl_sizes, 
-			     &metaTable);
+     /* read metaTable, one record per orbit */
+     stat = H5TBget_table_info(gid, "metaTable", &nfields, 
+			       &state_db->num_mtbl);
+     if (stat < 0) NADC_GOTO_ERROR(NADC_ERR_HDF_RD, "metaTable");
+     state_db->mtbl = (struct scia_mtbl_rec *)
+	  malloc((size_t) state_db->num_mtbl * mtbl_size);
+     if (state_db->mtbl == NULL)
+	  NADC_GOTO_ERROR(NADC_ERR_ALLOC, "metaTable");
+     stat = H5TBread_table(gid, "metaTable", mtbl_size, mtbl_offs, 
+			   mtbl_sizes, state_db->mtbl);
      if (stat < 0) NADC_GOTO_ERROR(NADC_ERR_HDF_RD, "metaTable");
 
-     /* read Clcon record */
-     if (metaTable.duration == 0) {
-	  res = 1;
-     } else {
-	  if (metaTable.indx_Clcon == 255) {
-	       res = 2;
-	  } else {
-	       res = 0;
-	       if (_SCIA_H5_RD_CLUSDEF(gid, metaTable.indx_Clcon) < 0)
-		    NADC_GOTO_ERROR(NADC_ERR_HDF_RD, "clusDef");
-	  }
-     }
+     /* read Clcon records */
+     if (_SCIA_H5_RD_CLUSDEF(gid, state_db) < 0)
+	  NADC_GOTO_ERROR(NADC_ERR_HDF_RD, "clusDef");
 
      (void) H5Gclose(gid);
-     (void) H5Fclose(fid);
-     return res;
+     state_db->loaded = TRUE;
+     return state_db;
 done:
+     if (state_db->mtbl != NULL) free(state_db->mtbl);
+     state_db->mtbl = NULL;
+     state_db->num_mtbl = 0;
      if (gid > 0) (void) H5Gclose(gid);
-     if (fid > 0) (void) H5Fclose(fid);
-     return -1;
+     return NULL;
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   _SET_SCIA_CLUSDEF
+.PURPOSE     set global variables for given state and orbit number
+.INPUT/OUTPUT
+  call as   stat = _SET_SCIA_CLUSDEF(stateID, absOrbit);
+     input:
+             unsigned char stateID       :  State ID
+	     unsigned short absOrbit     :  orbit number
+
+.RETURNS     succesful read return 0; empty mtbl-entry return 1;
+             unknown Clcon-entry return 2; else negative
+.COMMENTS    static function
+-------------------------*/
+static
+int _SET_SCIA_CLUSDEF(unsigned char stateID, unsigned short absOrbit)
+       /*@globals  metaTable, clusDef, stateID_prev, absOrbit_prev;@*/
+       /*@modifies metaTable, clusDef, stateID_prev, absOrbit_prev@*/
+{
+     const struct clusDef_state_rec *state_db;
+/*
+ * set global variables
+ */
+     stateID_prev  = stateID;
+     absOrbit_prev = absOrbit;
+
+     if ((state_db = _LOAD_SCIA_CLUSDEF(stateID)) == NULL) return -1;
+
+     /* metaTable record of this orbit */
+     if ((hsize_t) absOrbit >= state_db->num_mtbl) {
+	  NADC_ERROR(NADC_ERR_HDF_RD, "metaTable");
+	  return -1;
+     }
+     metaTable = state_db->mtbl[absOrbit];
+
+     /* Clcon record */
+     if (metaTable.duration == 0) return 1;
+     if (metaTable.indx_Clcon == 255) return 2;
+     if ((hsize_t) metaTable.indx_Clcon >= state_db->num_clcon) {
+	  NADC_ERROR(NADC_ERR_HDF_RD, "clusDef");
+	  return -1;
+     }
+     (void) memcpy(clusDef, 
+		   state_db->clcon + metaTable.indx_Clcon * MAX_CLUSTER,
+		   MAX_CLUSTER * sizeof(struct scia_clusDef_rec));
+     return 0;
 }
 
 /*+++++++++++++++++++++++++ Main Program or Function +++++++++++++++*/
@@ -280,9 +361,24 @@ bool CLUSDEF_DB_EXISTS(void)
 	  NADC_ERROR(NADC_ERR_WARN, "clusDef_file truncated");
      if (nadc_file_exists(clusDef_file)) return TRUE;
 
+     *clusDef_file = '\0';
      return FALSE;
 }
 
+/*+++++++++++++++++++++++++
+.IDENTifer   CLUSDEF_DB_NAME
+.PURPOSE     obtain the name of the state-cluster configuration database
+.INPUT/OUTPUT
+  call as   flname = CLUSDEF_DB_NAME();
+
+.RETURNS     name of the database, NULL if it does not exist
+.COMMENTS    none
+-------------------------*/
+const char *CLUSDEF_DB_NAME(void)
+{
+     return CLUSDEF_DB_EXISTS() ? clusDef_file : NULL;
+}
+
 /*+++++++++++++++++++++++++
 .IDENTifer   CLUSDEF_MTBL_VALID
 .PURPOSE     check if entry in nadc_clusDef database is valid
@@ -0,0 +1,369 @@
+/*++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+.COPYRIGHT (c) 2026 SRON (R.M.van.Hees@sron.nl)
+
+   This is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License, version 2, as
+   published by the Free Software Foundation.
+
+   The software is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place - Suite 330,
+   Boston, MA  02111-1307, USA.
+
+.IDENTifer   SCIA_LV0_MDS_INDEX
+.AUTHOR      R.M. van Hees
+.KEYWORDS    SCIA level 0 data
+.LANGUAGE    ANSI C
+.PURPOSE     read/write an index with the (corrected) info-records of a
+             Sciamachy level 0 product, grouped per state
+.COMMENTS    contains SCIA_LV0_RD_MDS_INDEX, SCIA_LV0_WR_MDS_INDEX
+             - the index is a binary file with a header, followed by the
+	       state records, each followed by its info-records (AUX, DET
+	       and PMD). The records are stored in native byte-order, the
+	       header holds a byte-order mark and the record sizes
+	     - the index is only valid for a product with the same size and
+	       modification time, for the same setting of the info-record
+	       correction, and for the same cluster definition and ROE
+	       databases (size and modification time)
+	     - the name of the product is taken from the parameter "infile",
+	       which should refer to the same file as the open stream
+.ENVIRONment SCIA_LV0_INDEX
+             unset or "0": do not use an index
+	     "1": the index is stored next to the product as
+	          <product>.nadcidx
+	     otherwise: directory to store the indices of all products
+.VERSION      1.1   17-Oct-2026 stamps of the clusDef and ROE database in
+                                the header, report write errors, RvH
+              1.0   17-Oct-2026 Created by R. M. van Hees
+------------------------------------------------------------*/
+/*
+ * Define _POSIX_C_SOURCE to indicate
+ * that this is a POSIX program (fileno, fstat, st_mtim)
+ */
+#define  _POSIX_C_SOURCE 200809L
+
+/*+++++ System headers +++++*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+/*+++++ Local Headers +++++*/
+#define _SCIA_LEVEL_0
+#include <nadc_scia.h>
+
+/*+++++ Macros +++++*/
+#define LV0_INDEX_VERSION  2u
+#define LV0_INDEX_BOM      0x01020304u
+#define LV0_INDEX_EXT      ".nadcidx"
+
+/*+++++ Static Variables +++++*/
+static const char lv0_index_magic[8] = "NADCIDX";
+
+/* size and modification time of a database, all zero when not found */
+struct lv0_db_stamp
+{
+     uint64_t      size;
+     int64_t       mtime;
+     int64_t       mtime_ns;
+};
+
+struct lv0_index_hdr
+{
+     char          magic[8];
+     uint32_t      version;
+     uint32_t      bom;
+     uint32_t      sz_info;
+     uint32_t      sz_states;
+     uint64_t      file_size;
+     int64_t       file_mtime;
+     int64_t       file_mtime_ns;
+     uint64_t      num_state;
+     unsigned char correct_info_rec;
+     unsigned char clusdef_db_exists;
+     unsigned char spare[6];
+     struct lv0_db_stamp clusdef_db;
+     struct lv0_db_stamp roe_db;
+};
+
+/*+++++++++++++++++++++++++ Static Functions +++++++++++++++++++++++*/
+/*+++++++++++++++++++++++++
+.IDENTifer   _DB_STAMP
+.PURPOSE     obtain size and modification time of a database
+.INPUT/OUTPUT
+  call as   _DB_STAMP( flname, &stamp );
+     input:
+            char *flname               : name of the database (or NULL)
+    output:
+            struct lv0_db_stamp *stamp : size and modification time
+
+.RETURNS     nothing
+.COMMENTS    static function
+-------------------------*/
+static
+void _DB_STAMP( const char *flname, struct lv0_db_stamp *stamp )
+{
+     struct stat st;
+
+     (void) memset( stamp, 0, sizeof(struct lv0_db_stamp) );
+     if ( flname == NULL || stat( flname, &st ) != 0 ) return;
+
+     stamp->size     = (uint64_t) st.st_size;
+     stamp->mtime    = (int64_t) st.st_mtim.tv_sec;
+     stamp->mtime_ns = (int64_t) st.st_mtim.tv_nsec;
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   _INDEX_HEADER
+.PURPOSE     obtain name of the index and fill its header
+.INPUT/OUTPUT
+  call as   found = _INDEX_HEADER( fd, idx_name, &hdr );
+     input:
+            FILE *fd                   : (open) stream pointer to product
+    output:
+            char *idx_name             : name of the index
+	                                 [MAX_STRING_LENGTH]
+            struct lv0_index_hdr *hdr  : expected header of the index
+
+.RETURNS     FALSE when no index should be used (bool)
+.COMMENTS    static function
+-------------------------*/
+static
+bool _INDEX_HEADER( FILE *fd, char *idx_name, struct lv0_index_hdr *hdr )
+{
+     char   *flname;
+     const char *cpntr;
+     bool   found = FALSE;
+     struct stat st_fd, st_fl;
+
+     const char *env_str = getenv( "SCIA_LV0_INDEX" );
+     const char *env_cor = getenv( "NO_INFO_CORRECTION" );
+
+     if ( env_str == NULL || *env_str == '\0' || strcmp( env_str, "0" ) == 0 )
+	  return FALSE;
+
+     /* the parameter "infile" should refer to the open product */
+     if ( (flname = nadc_get_param_string( "infile" )) == NULL )
+	  return FALSE;
+     if ( fstat( fileno( fd ), &st_fd ) != 0
+	  || stat( flname, &st_fl ) != 0
+	  || st_fd.st_dev != st_fl.st_dev || st_fd.st_ino != st_fl.st_ino )
+	  goto done;
+
+     if ( strcmp( env_str, "1" ) == 0 ) {
+	  (void) snprintf( idx_name, MAX_STRING_LENGTH, "%s%s",
+			   flname, LV0_INDEX_EXT );
+     } else {
+	  if ( (cpntr = strrchr( flname, '/' )) == NULL )
+	       cpntr = flname;
+	  else
+	       cpntr++;
+	  (void) snprintf( idx_name, MAX_STRING_LENGTH, "%s/%s%s",
+			   env_str, cpntr, LV0_INDEX_EXT );
+     }
+
+     (void) memset( hdr, 0, sizeof(struct lv0_index_hdr) );
+     (void) memcpy( hdr->magic, lv0_index_magic, sizeof(hdr->magic) );
+     hdr->version    = LV0_INDEX_VERSION;
+     hdr->bom        = LV0_INDEX_BOM;
+     hdr->sz_info    = (uint32_t) sizeof(struct mds0_info);
+     hdr->sz_states  = (uint32_t) sizeof(struct mds0_states);
+     hdr->file_size  = (uint64_t) st_fd.st_size;
+     hdr->file_mtime = (int64_t) st_fd.st_mtim.tv_sec;
+     hdr->file_mtime_ns = (int64_t) st_fd.st_mtim.tv_nsec;
+     hdr->correct_info_rec =
+	  (env_cor != NULL && *env_cor == '1') ? 0 : 1;
+     hdr->clusdef_db_exists = CLUSDEF_DB_EXISTS() ? 1 : 0;
+     _DB_STAMP( CLUSDEF_DB_NAME(), &hdr->clusdef_db );
+     _DB_STAMP( GET_SCIA_ROE_DB_NAME(), &hdr->roe_db );
+     found = TRUE;
+done:
+     free( flname );
+     return found;
+}
+
+/*+++++++++++++++++++++++++ Main Program or Function +++++++++++++++*/
+/*+++++++++++++++++++++++++
+.IDENTifer   SCIA_LV0_RD_MDS_INDEX
+.PURPOSE     read info-records per state from the index of a product
+.INPUT/OUTPUT
+  call as   num_state = SCIA_LV0_RD_MDS_INDEX( fd, &states );
+     input:
+            FILE *fd                    : (open) stream pointer to product
+    output:
+            struct mds0_states **states : info on states in product
+
+.RETURNS     number of states records found (size_t),
+             zero when there is no valid index
+.COMMENTS    no error status is raised, the caller should obtain the
+             info-records from the product when no index is found
+-------------------------*/
+size_t SCIA_LV0_RD_MDS_INDEX( FILE *fd, struct mds0_states **states_out )
+{
+     register size_t ns;
+
+     char   idx_name[MAX_STRING_LENGTH];
+     FILE   *fp;
+     size_t num_state = 0;
+
+     struct lv0_index_hdr hdr, hdr_fl;
+     struct mds0_states *states = NULL;
+
+     states_out[0] = NULL;
+     if ( ! _INDEX_HEADER( fd, idx_name, &hdr ) ) return 0;
+     if ( (fp = fopen( idx_name, "rb" )) == NULL ) return 0;
+
+     /* check header of the index */
+     if ( fread( &hdr_fl, sizeof(struct lv0_index_hdr), 1, fp ) != 1
+	  || memcmp( hdr_fl.magic, hdr.magic, sizeof(hdr.magic) ) != 0
+	  || hdr_fl.version != hdr.version || hdr_fl.bom != hdr.bom
+	  || hdr_fl.sz_info != hdr.sz_info
+	  || hdr_fl.sz_states != hdr.sz_states
+	  || hdr_fl.file_size != hdr.file_size
+	  || hdr_fl.file_mtime != hdr.file_mtime
+	  || hdr_fl.file_mtime_ns != hdr.file_mtime_ns
+	  || hdr_fl.correct_info_rec != hdr.correct_info_rec
+	  || hdr_fl.clusdef_db_exists != hdr.clusdef_db_exists
+	  || memcmp( &hdr_fl.clusdef_db, &hdr.clusdef_db,
+		     sizeof(struct lv0_db_stamp) ) != 0
+	  || memcmp( &hdr_fl.roe_db, &hdr.roe_db,
+		     sizeof(struct lv0_db_stamp) ) != 0
+	  || hdr_fl.num_state == 0 )
+	  goto done;
+
+     states = (struct mds0_states *)
+	  calloc( (size_t) hdr_fl.num_state, sizeof(struct mds0_states) );
+     if ( states == NULL ) goto done;
+
+     for ( ns = 0; ns < hdr_fl.num_state; ns++ ) {
+	  struct mds0_states *state = states + ns;
+
+	  if ( fread( state, sizeof(struct mds0_states), 1, fp ) != 1 )
+	       break;
+	  state->info_aux = state->info_det = state->info_pmd = NULL;
+	  if ( state->num_aux > 0 ) {
+	       state->info_aux = (struct mds0_info *)
+		    malloc( state->num_aux * sizeof(struct mds0_info) );
+	       if ( state->info_aux == NULL
+		    || fread( state->info_aux, sizeof(struct mds0_info),
+			      state->num_aux, fp ) != state->num_aux )
+		    break;
+	  }
+	  if ( state->num_det > 0 ) {
+	       state->info_det = (struct mds0_info *)
+		    malloc( state->num_det * sizeof(struct mds0_info) );
+	       if ( state->info_det == NULL
+		    || fread( state->info_det, sizeof(struct mds0_info),
+			      state->num_det, fp ) != state->num_det )
+		    break;
+	  }
+	  if ( state->num_pmd > 0 ) {
+	       state->info_pmd = (struct mds0_info *)
+		    malloc( state->num_pmd * sizeof(struct mds0_info) );
+	       if ( state->info_pmd == NULL
+		    || fread( state->info_pmd, sizeof(struct mds0_info),
+			      state->num_pmd, fp ) != state->num_pmd )
+		    break;
+	  }
+     }
+
+     /* incomplete index: release all memory */
+     if ( ns < hdr_fl.num_state ) {
+	  do {
+	       if ( states[ns].info_aux == NULL ) states[ns].num_aux = 0;
+	       if ( states[ns].info_det == NULL ) states[ns].num_det = 0;
+	       if ( states[ns].info_pmd == NULL ) states[ns].num_pmd = 0;
+	  } while ( ++ns < hdr_fl.num_state );
+	  SCIA_LV0_FREE_MDS_INFO( (size_t) hdr_fl.num_state, states );
+	  goto done;
+     }
+     num_state = (size_t) hdr_fl.num_state;
+     states_out[0] = states;
+done:
+     (void) fclose( fp );
+     return num_state;
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   SCIA_LV0_WR_MDS_INDEX
+.PURPOSE     write info-records per state to the index of a product
+.INPUT/OUTPUT
+  call as   SCIA_LV0_WR_MDS_INDEX( fd, num_state, states );
+     input:
+            FILE *fd                   : (open) stream pointer to product
+            size_t num_state           : number of states
+            struct mds0_states *states : info on states in product
+
+.RETURNS     nothing
+.COMMENTS    the index is written to a temporary file, which is renamed
+             when complete. Therefore, concurrent processes will never
+	     read an incomplete index.
+	     A notice is raised when the index could not be written, the
+	     product can still be processed without index. Use
+	     SCIA_LV0_RD_MDS_INDEX to check that a valid index exists
+-------------------------*/
+void SCIA_LV0_WR_MDS_INDEX( FILE *fd, size_t num_state,
+			    const struct mds0_states *states )
+{
+     register size_t ns;
+
+     char   idx_name[MAX_STRING_LENGTH];
+     char   tmp_name[MAX_STRING_LENGTH + 16];
+     FILE   *fp;
+
+     struct lv0_index_hdr hdr;
+
+     if ( num_state == 0 || states == NULL ) return;
+     if ( ! _INDEX_HEADER( fd, idx_name, &hdr ) ) return;
+     hdr.num_state = (uint64_t) num_state;
+
+     (void) snprintf( tmp_name, sizeof(tmp_name), "%s.%ld",
+		      idx_name, (long) getpid() );
+     if ( (fp = fopen( tmp_name, "wb" )) == NULL ) {
+	  NADC_ERROR( NADC_ERR_NONE, "can not create index" );
+	  return;
+     }
+     if ( fwrite( &hdr, sizeof(struct lv0_index_hdr), 1, fp ) != 1 )
+	  goto failed;
+     for ( ns = 0; ns < num_state; ns++ ) {
+	  struct mds0_states state = states[ns];
+
+	  state.info_aux = state.info_det = state.info_pmd = NULL;
+	  if ( fwrite( &state, sizeof(struct mds0_states), 1, fp ) != 1 )
+	       goto failed;
+	  if ( state.num_aux > 0
+	       && fwrite( states[ns].info_aux, sizeof(struct mds0_info),
+			  state.num_aux, fp ) != state.num_aux )
+	       goto failed;
+	  if ( state.num_det > 0
+	       && fwrite( states[ns].info_det, sizeof(struct mds0_info),
+			  state.num_det, fp ) != state.num_det )
+	       goto failed;
+	  if ( state.num_pmd > 0
+	       && fwrite( states[ns].info_pmd, sizeof(struct mds0_info),
+			  state.num_pmd, fp ) != state.num_pmd )
+	       goto failed;
+     }
+     if ( fclose( fp ) != 0 ) {
+	  (void) remove( tmp_name );
+	  NADC_ERROR( NADC_ERR_NONE, "can not write index" );
+	  return;
+     }
+     if ( rename( tmp_name, idx_name ) != 0 ) {
+	  (void) remove( tmp_name );
+	  NADC_ERROR( NADC_ERR_NONE, "can not rename index" );
+     }
+     return;
+failed:
+     (void) fclose( fp );
+     (void) remove( tmp_name );
+     NADC_ERROR( NADC_ERR_NONE, "can not write index" );
+}
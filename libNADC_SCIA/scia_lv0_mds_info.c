@@ -32,8 +32,15 @@
 .RETURNS     number of states records found (size_t)
              error status passed by global variable ``nadc_stat''
 .COMMENTS    none
-.ENVIRONment None
-.VERSION      4.0   23-Mar-2015	partly re-wite, many improvements, RvH
+.ENVIRONment NO_INFO_CORRECTION, SHOW_INFO_RECORDS
+             SCIA_LV0_INDEX: read/write the info-records from/to an index,
+	     see SCIA_LV0_RD_MDS_INDEX
+.VERSION      4.4   17-Oct-2026	report warnings of info-records read from
+                                the index, no index after a read error, RvH
+              4.3   17-Oct-2026	natural merge sort of info-records, RvH
+              4.2   17-Oct-2026	use index with info-records, RvH
+              4.1   17-Oct-2026	hash table for the on_board_time check, RvH
+              4.0   23-Mar-2015	partly re-wite, many improvements, RvH
               3.0   19-Dec-2013	new implementation, complete rewrite, RvH
               2.5.1 20-Apr-2006	minor bug-fix to compile without HDF5, RvH
 	      2.5   16-Jan-2005	update documentation, RvH
@@ -127,112 +134,88 @@ void _SHOW_STATE_RECORDS( const char product[],
 }
 
 /*+++++++++++++++++++++++++
-.IDENTifer   _INFO_QSORT
-.PURPOSE     sort an array into assending order using the Quicksort algorithm
+.IDENTifer   _INFO_MERGE_SORT
+.PURPOSE     sort (key, index) pairs into ascending order of key and index
 .INPUT/OUTPUT
-  call as   _INFO_QSORT( dim, ref_arr, info );
+  call as   sorted = _INFO_MERGE_SORT( dim, keys, work );
      input:
             unsigned int dim        :   dimension of the array to be sorted
  in/output:
-            double       *ref_arr   :   array to be sorted
-            struct mds0_info *info  :   array of records to be sorted as jday
+            struct info_key *keys   :   array to be sorted
+            struct info_key *work   :   work array of same dimension
 
-.RETURNS     nothing
+.RETURNS     array with sorted pairs, keys or work (struct info_key *)
 .COMMENTS    static function
+             natural merge sort: every pass merges pairs of adjacent
+	     ascending runs, therefore a sorted array takes one pass and
+	     an array with r runs log2(r) passes. Short runs are first
+	     extended to INFO_MIN_RUN pairs with an insertion sort
 -------------------------*/
-#define PIX_STACK_SIZE 50
-#define PIX_SWAP(a,b) { double temp=(a);(a)=(b);(b)=temp; }
-#define INFO_SWAP(a,b) { struct mds0_info c; memcpy(&c, &(a), type_size); memcpy(&(a), &(b), type_size); memcpy(&(b), &c, type_size); }
+struct info_key
+{
+     unsigned long long key;
+     unsigned int       indx;
+};
 
-static inline
-void _INFO_QSORT( unsigned int dim, double *ref_arr, struct mds0_info *info )
+#define INFO_MIN_RUN  32
+#define INFO_KEY_LESS(a,b) \
+     ((a).key < (b).key || ((a).key == (b).key && (a).indx < (b).indx))
+
+static
+struct info_key *_INFO_MERGE_SORT( unsigned int dim, struct info_key *keys,
+				   struct info_key *work )
 {
-    register int  ii, ir, jj, kk, ll;
-
-    int     *i_stack;
-    int     j_stack;
-    double  ref_tmp;
-
-    struct mds0_info info_tmp;
-
-    const size_t type_size = sizeof(struct mds0_info);
-
-    ir = dim;
-    ll = 1;
-    j_stack = 0;
-    i_stack = (int *) malloc( PIX_STACK_SIZE * sizeof(int) );
-    if ( i_stack == NULL )
-	 NADC_RETURN_ERROR( NADC_ERR_ALLOC, "i_stack" );
-    for (;;) {
-        if ( ir-ll < 7 ) {
-            for ( jj = ll+1; jj <= ir; jj++ ) {
-                ref_tmp = ref_arr[jj-1];
-		(void) memcpy( &info_tmp, &info[jj-1], type_size );
-                for ( ii = jj-1; ii >= 1; ii-- ) {
-                    if ( ref_arr[ii-1] <= ref_tmp ) break;
-                    ref_arr[ii] = ref_arr[ii-1];
-		    (void) memcpy( &info[ii], &info[ii-1], type_size );
-                }
-                ref_arr[ii] = ref_tmp;
-		(void) memcpy( &info[ii], &info_tmp, type_size );
-            }
-            if ( j_stack == 0 ) break;
-            ir = i_stack[j_stack-- -1];
-            ll = i_stack[j_stack-- -1];
-        } else {
-            kk = (ll+ir) >> 1;
-            PIX_SWAP(ref_arr[kk-1], ref_arr[ll])
-	    INFO_SWAP(info[kk-1], info[ll])
-            if ( ref_arr[ll] > ref_arr[ir-1] ) {
-                PIX_SWAP(ref_arr[ll], ref_arr[ir-1])
-		INFO_SWAP(info[ll], info[ir-1])
-            }
-            if ( ref_arr[ll-1] > ref_arr[ir-1] ) {
-                PIX_SWAP(ref_arr[ll-1], ref_arr[ir-1])
-		INFO_SWAP(info[ll-1], info[ir-1])
-            }
-            if ( ref_arr[ll] > ref_arr[ll-1] ) {
-                PIX_SWAP(ref_arr[ll], ref_arr[ll-1])
-		INFO_SWAP(info[ll], info[ll-1])
-            }
-            ii = ll+1;
-            jj = ir;
-            ref_tmp = ref_arr[ll-1];
-	    (void) memcpy( &info_tmp, &info[ll-1], type_size );
-            for (;;) {
-                do ii++; while (ref_arr[ii-1] < ref_tmp);
-                do jj--; while (ref_arr[jj-1] > ref_tmp);
-                if (jj <= ii) break;
-
-                PIX_SWAP(ref_arr[ii-1], ref_arr[jj-1])
-		INFO_SWAP(info[ii-1], info[jj-1])
-            }
-            ref_arr[ll-1] = ref_arr[jj-1];
-            ref_arr[jj-1] = ref_tmp;
-	    (void) memcpy( &info[ll-1], &info[jj-1], type_size );
-	    (void) memcpy( &info[jj-1], &info_tmp, type_size );
-            j_stack += 2;
-            if ( j_stack > PIX_STACK_SIZE )
-		 NADC_GOTO_ERROR( NADC_ERR_FATAL,
-				  "stack too small in pixel_qsort: aborting" );
-
-            if ( (ir - ii + 1) >= (jj - ll) ) {
-                i_stack[j_stack-1] = ir;
-                i_stack[j_stack-2] = ii;
-                ir = jj-1;
-            } else {
-                i_stack[j_stack-1] = jj-1;
-                i_stack[j_stack-2] = ll;
-                ll = ii;
-            }
-        }
-    }
-done:
-    free( i_stack );
+     register unsigned int ii, jj, kk, mm, nn;
+
+     unsigned int num_run;
+     struct info_key *src = keys;
+     struct info_key *dst = work;
+     struct info_key *tmp, key_tmp;
+
+     /* ascending runs of at least INFO_MIN_RUN pairs (insertion sort) */
+     for ( ii = 0; ii < dim; ii += INFO_MIN_RUN ) {
+	  mm = (ii + INFO_MIN_RUN < dim) ? ii + INFO_MIN_RUN : dim;
+	  for ( jj = ii + 1; jj < mm; jj++ ) {
+	       if ( ! INFO_KEY_LESS(src[jj], src[jj-1]) ) continue;
+
+	       key_tmp = src[jj];
+	       for ( kk = jj; kk > ii && INFO_KEY_LESS(key_tmp, src[kk-1]); kk-- )
+		    src[kk] = src[kk-1];
+	       src[kk] = key_tmp;
+	  }
+     }
+
+     do {
+	  num_run = 0;
+	  for ( ii = 0; ii < dim; ii = kk ) {
+	       /* find two adjacent ascending runs: [ii,jj) and [jj,kk) */
+	       for ( jj = ii + 1; jj < dim; jj++ )
+		    if ( INFO_KEY_LESS(src[jj], src[jj-1]) ) break;
+	       for ( kk = jj + 1; kk < dim; kk++ )
+		    if ( INFO_KEY_LESS(src[kk], src[kk-1]) ) break;
+	       if ( kk > dim ) kk = dim;
+	       num_run++;
+	       if ( ii == 0 && jj == dim ) return src;
+
+	       /* merge both runs */
+	       nn = ii;
+	       mm = jj;
+	       while ( ii < mm && jj < kk ) {
+		    if ( INFO_KEY_LESS(src[jj], src[ii]) )
+			 dst[nn++] = src[jj++];
+		    else
+			 dst[nn++] = src[ii++];
+	       }
+	       while ( ii < mm ) dst[nn++] = src[ii++];
+	       while ( jj < kk ) dst[nn++] = src[jj++];
+	  }
+	  tmp = src; src = dst; dst = tmp;
+     } while ( num_run > 1 );
+
+     return src;
 }
-#undef INFO_SWAP
-#undef PIX_SWAP
-#undef PIX_STACK_SIZE
+#undef INFO_KEY_LESS
+#undef INFO_MIN_RUN
 
 /*+++++++++++++++++++++++++
 .IDENTifer   _ASSIGN_INFO_STATES
@@ -451,6 +434,38 @@ void _QCHECK_INFO_PARAMS( bool correct_info_rec,
      } while ( info++, ++ni < num_info );
 }
 
+/*
+ * the unique combinations of (state_id, on_board_time) are stored in an
+ * open-addressing hash table, a slot holds (index + 1) of the key record,
+ * or zero for an empty slot. Key records with the same on_board_time or
+ * with the same state_id are linked in chains, in order of their index
+ */
+#define KEY_NONE   UINT_MAX
+
+struct key_rec {
+     unsigned char  state_id;
+     unsigned short num;
+     unsigned short num_dsr;
+     unsigned int   on_board_time;
+     unsigned int   i_mn;
+     unsigned int   i_mx;
+     unsigned int   next_obt;             /* next key with same on_board_time */
+     unsigned int   next_state;           /* next key with same state_id */
+};
+
+/* hash of the on_board_time, optionally combined with the state_id */
+static inline
+unsigned int _KEY_HASH( unsigned char state_id, unsigned int on_board_time,
+			unsigned int mask )
+{
+     register unsigned int hval = on_board_time ^ ((unsigned int) state_id << 24);
+
+     hval ^= hval >> 16;
+     hval *= 0x45d9f3bu;
+     hval ^= hval >> 16;
+     return hval & mask;
+}
+
 /*+++++++++++++++++++++++++
 .IDENTifer   _CHECK_INFO_ON_BOARD_TIME
 .PURPOSE     consistency check of value of on_board_time in info-records
@@ -464,6 +479,9 @@ void _QCHECK_INFO_PARAMS( bool correct_info_rec,
 
 .RETURNS     nothing
 .COMMENTS    static function
+             the key table is indexed by a hash on (state_id, on_board_time),
+	     candidates for a merge are only searched among the keys with
+	     the same on_board_time or the same state_id
 -------------------------*/
 static
 void _CHECK_INFO_ON_BOARD_TIME( bool correct_info_rec,
@@ -472,23 +490,35 @@ void _CHECK_INFO_ON_BOARD_TIME( bool correct_info_rec,
 {
      register int nb;
      
-     register unsigned int ii, ni, nk;
+     register unsigned int hval, ii, ni, nk;
 
      unsigned int num_key;
+     unsigned int hmask;
 
-     struct key_rec {
-	  unsigned char  state_id;
-	  unsigned short num;
-	  unsigned short num_dsr;
-	  unsigned int   on_board_time;
-	  unsigned int   i_mn;
-	  unsigned int   i_mx;
-     } *key;
+     unsigned int   *slot_key = NULL;
+     unsigned int   *slot_obt = NULL;
+     struct key_rec *key = NULL;
+
+     bool           has_num_dsr[UCHAR_MAX+1];
+     unsigned short num_dsr_state[UCHAR_MAX+1];
+     unsigned int   head_state[UCHAR_MAX+1];
      
      /* handle special cases gracefully */
      if ( num_info < 2 ) return;
 
+     /* size of the hash tables: power of 2, at most half filled */
+     hmask = 1u;
+     while ( hmask < 2 * num_info ) hmask <<= 1;
+     hmask--;
+
      key = (struct key_rec *) malloc( num_info * sizeof(struct key_rec) );
+     slot_key = (unsigned int *) calloc( hmask + 1, sizeof(unsigned int) );
+     slot_obt = (unsigned int *) calloc( hmask + 1, sizeof(unsigned int) );
+     if ( key == NULL || slot_key == NULL || slot_obt == NULL )
+	  NADC_GOTO_ERROR( NADC_ERR_ALLOC, "key" );
+
+     /* expected number of DSR depends only on state_id (absOrbit is fixed) */
+     (void) memset( has_num_dsr, 0, sizeof(has_num_dsr) );
      
      /*
       * create a list of unique combinations of on_board_time and state_id
@@ -499,31 +529,55 @@ void _CHECK_INFO_ON_BOARD_TIME( bool correct_info_rec,
       */
      num_key = 0;
      for ( ni = 0; ni < num_info; ni++ ) {
-	  bool fnd_key = FALSE;
-	  
-	  for ( nk = 0; nk < num_key; nk++ ) {
-	       if ( info[ni].state_id == key[nk].state_id
-		    && info[ni].on_board_time == key[nk].on_board_time ) {
-		    key[nk].num++;
-		    key[nk].i_mx = ni;
-		    fnd_key = TRUE;
+	  const unsigned char state_id = info[ni].state_id;
+
+	  hval = _KEY_HASH( state_id, info[ni].on_board_time, hmask );
+	  while ( (nk = slot_key[hval]) != 0 ) {
+	       if ( key[nk-1].state_id == state_id
+		    && key[nk-1].on_board_time == info[ni].on_board_time )
 		    break;
-	       }
+	       hval = (hval + 1) & hmask;
+	  }
+	  if ( nk != 0 ) {
+	       key[nk-1].num++;
+	       key[nk-1].i_mx = ni;
+	       continue;
 	  }
-	  if ( ! fnd_key ) {
-	       key[num_key].state_id = info[ni].state_id;
-	       key[num_key].on_board_time = info[ni].on_board_time;
-	       key[num_key].num = 1;
-	       if ( info[ni].state_id > 0 )
-		    key[num_key].num_dsr =
-			 CLUSDEF_NUM_DSR( info[ni].state_id, absOrbit );
-	       else
-		    key[num_key].num_dsr = 1;
-	       key[num_key].i_mn = key[num_key].i_mx = ni;
-	       num_key++;
+	  slot_key[hval] = num_key + 1;
+
+	  if ( state_id > 0 && ! has_num_dsr[state_id] ) {
+	       num_dsr_state[state_id] = CLUSDEF_NUM_DSR( state_id, absOrbit );
+	       has_num_dsr[state_id] = TRUE;
 	  }
+	  key[num_key].state_id = state_id;
+	  key[num_key].on_board_time = info[ni].on_board_time;
+	  key[num_key].num = 1;
+	  key[num_key].num_dsr = (state_id > 0) ? num_dsr_state[state_id] : 1;
+	  key[num_key].i_mn = key[num_key].i_mx = ni;
+	  num_key++;
      }
 
+     /*
+      * link keys with the same on_board_time and with the same state_id,
+      * the chains are in increasing order of the key index
+      */
+     for ( nk = 0; nk <= UCHAR_MAX; nk++ ) head_state[nk] = KEY_NONE;
+     nk = num_key;
+     do {
+	  nk--;
+	  key[nk].next_state = head_state[key[nk].state_id];
+	  head_state[key[nk].state_id] = nk;
+
+	  hval = _KEY_HASH( 0, key[nk].on_board_time, hmask );
+	  while ( (ni = slot_obt[hval]) != 0 ) {
+	       if ( key[ni-1].on_board_time == key[nk].on_board_time )
+		    break;
+	       hval = (hval + 1) & hmask;
+	  }
+	  key[nk].next_obt = (ni != 0) ? ni - 1 : KEY_NONE;
+	  slot_obt[hval] = nk + 1;
+     } while ( nk > 0 );
+
      /*
       * try to correct state_id values
       */
@@ -534,11 +588,14 @@ void _CHECK_INFO_ON_BOARD_TIME( bool correct_info_rec,
 	  /* skip small sub-sets or complete sets */
 	  if ( key[nk].num >= key[nk].num_dsr || key[nk].num <= num_thres ) 
 	       continue;
-	  
-	  for ( ni = 0; ni < num_key; ni++ ) {
-	       if ( ni == nk || key[ni].num == 0
-		    || key[ni].on_board_time != key[nk].on_board_time )
-		    continue;
+
+	  /* first key with the same on_board_time */
+	  hval = _KEY_HASH( 0, key[nk].on_board_time, hmask );
+	  while ( key[slot_obt[hval]-1].on_board_time != key[nk].on_board_time )
+	       hval = (hval + 1) & hmask;
+
+	  for ( ni = slot_obt[hval]-1; ni != KEY_NONE; ni = key[ni].next_obt ) {
+	       if ( ni == nk || key[ni].num == 0 ) continue;
 	       
 	       for ( ii = key[ni].i_mn; ii <= key[ni].i_mx; ii++ ) {
 		    if ( info[ii].state_id == key[ni].state_id
@@ -569,14 +626,14 @@ void _CHECK_INFO_ON_BOARD_TIME( bool correct_info_rec,
 	       if ( key[nk].num >= key[nk].num_dsr || key[nk].num <= num_thres )
 		    continue;
 	       
-	       for ( ni = 0; ni < num_key; ni++ ) {
+	       for ( ni = head_state[key[nk].state_id]; ni != KEY_NONE;
+		     ni = key[ni].next_state ) {
 		    unsigned int diff =
 			 key[ni].on_board_time > key[nk].on_board_time ?
 			 key[ni].on_board_time - key[nk].on_board_time :
 			 key[nk].on_board_time - key[ni].on_board_time;
 
 		    if ( ni == nk || key[ni].num == 0
-			 || key[ni].state_id != key[nk].state_id
 			 || __builtin_popcount(diff) > nb )
 			 continue;
 
@@ -596,10 +653,13 @@ void _CHECK_INFO_ON_BOARD_TIME( bool correct_info_rec,
 	       }
 	  }
      }
-
+done:
      /* release allocated memory */
-     free( key );
+     if ( slot_obt != NULL ) free( slot_obt );
+     if ( slot_key != NULL ) free( slot_key );
+     if ( key != NULL ) free( key );
 }
+#undef KEY_NONE
 
 /*+++++++++++++++++++++++++
 .IDENTifer   _CHECK_INFO_BCPS
@@ -688,28 +748,109 @@ void _CHECK_INFO_BCPS( bool correct_info_rec, unsigned char packet_id,
 
 .RETURNS     nothing, error status passed by global variable ``nadc_stat''
 .COMMENTS    static function
+             the sort key is on_board_time + bcps / 16, as integer:
+	     16 * on_board_time + bcps. The info-records are split in an
+	     ascending sequence and the records out of order, only the
+	     (key, index) pairs of the latter are sorted. Both sequences
+	     are merged and the info-records are permuted once.
+	     The sort is stable
 -------------------------*/
+#define INFO_SORT_KEY(a) \
+     (((unsigned long long) (a).on_board_time << 4) + (a).bcps)
+#define INFO_MAX_SPIKE   8
+
 static inline
 void _REPAIR_INFO_SORTED( unsigned int num_info, struct mds0_info *info )
 {
-     register unsigned int ni = 0;
-     
-     double *on_board_time;
+     register unsigned int ni, nj, nk;
 
-     /* allocate memory */
-     on_board_time = (double *) malloc( num_info * sizeof(double) );
-     if ( on_board_time == NULL )
-          NADC_RETURN_ERROR( NADC_ERR_ALLOC, "on_board_time" );
+     unsigned int num_main = 0;
+     unsigned int num_side = 0;
+     unsigned int *perm = NULL;
+     unsigned long long key;
 
-     /* initialize array on_board_time */
-     do { 
-          on_board_time[ni] = info[ni].on_board_time
-	       + (double) info[ni].bcps / 16.;
-     } while ( ++ni < num_info );
+     struct info_key  *keys, *side;
+     struct mds0_info info_tmp;
+
+     /* nothing to do when the info-records are already sorted */
+     for ( ni = 1; ni < num_info; ni++ ) {
+	  if ( INFO_SORT_KEY(info[ni-1]) > INFO_SORT_KEY(info[ni]) ) break;
+     }
+     if ( ni == num_info ) return;
+
+     /* allocate memory for the pairs, the work array and the permutation */
+     keys = (struct info_key *) malloc( 2 * num_info * sizeof(struct info_key) );
+     if ( keys == NULL )
+          NADC_RETURN_ERROR( NADC_ERR_ALLOC, "keys" );
+     perm = (unsigned int *) malloc( num_info * sizeof(unsigned int) );
+     if ( perm == NULL )
+          NADC_GOTO_ERROR( NADC_ERR_ALLOC, "perm" );
+
+     /* 
+      * split the records in an ascending sequence and the rest: a record 
+      * smaller than the last records of the sequence either follows a few
+      * records which are too large (these are removed from the sequence),
+      * or is itself too small
+      */
+     side = keys + num_info;
+     for ( ni = 0; ni < num_info; ni++ ) {
+	  key = INFO_SORT_KEY(info[ni]);
 
-     _INFO_QSORT( num_info, on_board_time, info );
-     free( on_board_time );
+	  if ( num_main > 0 && key < keys[num_main-1].key ) {
+	       for ( nj = 1; nj <= INFO_MAX_SPIKE && nj < num_main; nj++ ) {
+		    if ( keys[num_main-1-nj].key <= key ) break;
+	       }
+	       if ( nj > INFO_MAX_SPIKE ) {
+		    side[num_side].key  = key;
+		    side[num_side].indx = ni;
+		    num_side++;
+		    continue;
+	       }
+	       do {
+		    side[num_side++] = keys[--num_main];
+	       } while ( --nj > 0 );
+	  }
+	  keys[num_main].key  = key;
+	  keys[num_main].indx = ni;
+	  num_main++;
+     }
+
+     /* sort the records out of order, the free part of keys is work space */
+     side = _INFO_MERGE_SORT( num_side, side, keys + num_main );
+
+     /* merge both sequences, equal keys in order of the index */
+     ni = nj = nk = 0;
+     while ( ni < num_main && nj < num_side ) {
+	  if ( side[nj].key < keys[ni].key
+	       || (side[nj].key == keys[ni].key 
+		   && side[nj].indx < keys[ni].indx) )
+	       perm[nk++] = side[nj++].indx;
+	  else
+	       perm[nk++] = keys[ni++].indx;
+     }
+     while ( ni < num_main ) perm[nk++] = keys[ni++].indx;
+     while ( nj < num_side ) perm[nk++] = side[nj++].indx;
+
+     /* move the info-records to their new position, cycle by cycle */
+     for ( ni = 0; ni < num_info; ni++ ) {
+	  if ( perm[ni] == ni ) continue;
+
+	  (void) memcpy( &info_tmp, &info[ni], sizeof(struct mds0_info) );
+	  nj = ni;
+	  while ( (nk = perm[nj]) != ni ) {
+	       (void) memcpy( &info[nj], &info[nk], sizeof(struct mds0_info) );
+	       perm[nj] = nj;
+	       nj = nk;
+	  }
+	  (void) memcpy( &info[nj], &info_tmp, sizeof(struct mds0_info) );
+	  perm[nj] = nj;
+     }
+done:
+     if ( perm != NULL ) free( perm );
+     free( keys );
 }
+#undef INFO_MAX_SPIKE
+#undef INFO_SORT_KEY
 
 /*+++++++++++++++++++++++++
 .IDENTifer   _CHECK_INFO_SORTED
@@ -1320,6 +1461,13 @@ size_t SCIA_LV0_RD_MDS_INFO( FILE *fd, unsigned int num_dsd,
      absOrbit = (unsigned short) mph.abs_orbit;
      clusdef_db_exists = CLUSDEF_DB_EXISTS();
 
+     /* use info-records stored in the index of this product, if valid */
+     if ( ! show_info_rec
+	  && (num_state = SCIA_LV0_RD_MDS_INDEX( fd, states_out )) > 0 ) {
+	  _MDS_INFO_WARNINGS( num_state, states_out[0] );
+	  return num_state;
+     }
+
      /* get index to data set descriptor */
      indx_dsd = ENVI_GET_DSD_INDEX( num_dsd, dsd, dsd_name );
      if ( IS_ERR_STAT_ABSENT ) {
@@ -1421,6 +1569,10 @@ size_t SCIA_LV0_RD_MDS_INFO( FILE *fd, unsigned int num_dsd,
      }
      if ( show_info_rec ) _SHOW_STATE_RECORDS( mph.product, num_state, states );
      _MDS_INFO_WARNINGS( num_state, states );
+
+     /* store info-records in the index of this product, if read completely */
+     if ( num_info == dsd[indx_dsd].num_dsr )
+	  SCIA_LV0_WR_MDS_INDEX( fd, num_state, states );
 done:
      if ( info != NULL ) free( info );
      return num_state;
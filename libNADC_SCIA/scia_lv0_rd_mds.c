@@ -22,7 +22,9 @@
 .PURPOSE     read SCIAMACHY level 0 Measurement Data Sets of one State execution
 .COMMENTS    contains SCIA_LV0_RD_AUX, SCIA_LV0_RD_DET, SCIA_LV0_RD_PMD,
 		      SCIA_LV0_RD_LV1_AUX, SCIA_LV0_FREE_MDS_DET, 
-		      SCIA_LV0_RD_LV1_PMD
+		      SCIA_LV0_RD_LV1_PMD, SCIA_LV0_MMAP_OPEN,
+		      SCIA_LV0_MMAP_CLOSE, SCIA_LV0_DET_ARENA_OPEN, 
+		      SCIA_LV0_DET_ARENA_RELEASE, SCIA_LV0_DET_ARENA_CLOSE
              Documentation:
 	      - Envisat-1 Product Specifications
 	        Volume 6: Level 0 Product Specification
@@ -33,7 +35,11 @@
 
 .ENVIRONment none
 .EXTERNALs   ENVI_GET_DSD_INDEX 
-.VERSION      5.5   18-Mar-2015	bugfixes and code improvements, RvH
+.VERSION      5.7   17-Oct-2026	Detector MDS records can be allocated from 
+                                an arena, released by one call, RvH
+              5.6   17-Oct-2026	added read access via memory mapped product
+                                (zero-copy detector pixel data), RvH
+              5.5   18-Mar-2015	bugfixes and code improvements, RvH
               5.4   29-Sep-2011	check on likelihood of "start" corruption, RvH
               5.3   22-Nov-2009	more fixes in clusDef correction algorithm, RvH
               5.2   28-Oct-2009	move GET_LV0_MDS_INFO to seperate module, RvH
@@ -65,10 +71,10 @@
               1.0   11-Nov-2001 created by R. M. van Hees
 ------------------------------------------------------------*/
 /*
- * Define _ISOC99_SOURCE to indicate
- * that this is a ISO C99 program
+ * Define _POSIX_C_SOURCE to indicate
+ * that this is a POSIX.1-2001 program
  */
-#define  _ISOC99_SOURCE
+#define  _POSIX_C_SOURCE 200112L
 
 /*+++++ System headers +++++*/
 #include <stdio.h>
@@ -76,6 +82,10 @@
 #include <string.h>
 #include <limits.h>
 
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
 /*+++++ Local Headers +++++*/
 #define _SCIA_LEVEL_0
 #include <nadc_scia.h>
@@ -84,12 +94,172 @@ static bool ClusterCorrectionFlag = TRUE;
 static unsigned short numClusDef  = 0;
 static struct clusdef_rec clusDef[MAX_NUM_STATE];
 
+/* read-only memory map of a level 0 product, see SCIA_LV0_MMAP_OPEN */
+static int    lv0_map_fd   = -1;
+static size_t lv0_map_size = 0;
+static char   *lv0_map_addr = NULL;
+
+/* arena for Detector MDS records, see SCIA_LV0_DET_ARENA_OPEN */
+#define LV0_ARENA_BLOCK_SIZE   ((size_t) 4 * 1024 * 1024)
+#define LV0_ARENA_ALIGN        ((size_t) 16)
+
+struct lv0_arena_block {
+     struct lv0_arena_block *next;
+     size_t size;
+     size_t used;
+     char   *data;
+};
+
+static bool lv0_arena_active = FALSE;
+static struct lv0_arena_block *lv0_arena_head = NULL;
+static struct lv0_arena_block *lv0_arena_curr = NULL;
+
 /*+++++++++++++++++++++++++ Static Functions +++++++++++++++++++++++*/
 #include "selected_channel.inc"
 #ifdef _SWAP_TO_LITTLE_ENDIAN
 #include "swap_lv0_mds.inc"
 #endif /* _SWAP_TO_LITTLE_ENDIAN */
 
+/*+++++++++++++++++++++++++
+.IDENTifer   _LV0_MAPPED_DSR
+.PURPOSE     obtain pointer to a DSR in the memory mapped level 0 product
+.INPUT/OUTPUT
+  call as   cpntr = _LV0_MAPPED_DSR(fd, offset, num_byte);
+     input:  
+            FILE   *fd             : (open) stream pointer
+	    unsigned int offset    : offset of the DSR in the product
+	    size_t num_byte        : number of bytes required
+
+.RETURNS     pointer into the mapping, or NULL when stream "fd" is not 
+             mapped or the requested bytes are not within the mapping
+.COMMENTS    static function
+-------------------------*/
+static inline
+const char *_LV0_MAPPED_DSR(FILE *fd, unsigned int offset, size_t num_byte)
+{
+     if (lv0_map_addr == NULL || fileno(fd) != lv0_map_fd) return NULL;
+
+     if ((size_t) offset + num_byte > lv0_map_size) return NULL;
+
+     return lv0_map_addr + offset;
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   _IN_LV0_MAPPING
+.PURPOSE     check if memory is part of the memory mapped level 0 product
+.INPUT/OUTPUT
+  call as   flag = _IN_LV0_MAPPING(pntr);
+     input:  
+            void *pntr  : pointer to memory
+
+.RETURNS     TRUE if memory is owned by the mapping (may not be freed)
+.COMMENTS    static function
+-------------------------*/
+static inline
+bool _IN_LV0_MAPPING(const void *pntr)
+{
+     const char *cpntr = (const char *) pntr;
+
+     if (lv0_map_addr == NULL || cpntr == NULL) return FALSE;
+
+     return (cpntr >= lv0_map_addr && cpntr < lv0_map_addr + lv0_map_size);
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   _IN_LV0_DET_ARENA
+.PURPOSE     check if memory is allocated from the Detector MDS arena
+.INPUT/OUTPUT
+  call as   flag = _IN_LV0_DET_ARENA(pntr);
+     input:  
+            void *pntr  : pointer to memory
+
+.RETURNS     TRUE if memory is owned by the arena (may not be freed)
+.COMMENTS    static function
+-------------------------*/
+static inline
+bool _IN_LV0_DET_ARENA(const void *pntr)
+{
+     const char *cpntr = (const char *) pntr;
+
+     const struct lv0_arena_block *blk;
+
+     if (cpntr == NULL) return FALSE;
+
+     for (blk = lv0_arena_head; blk != NULL; blk = blk->next) {
+	  if (cpntr >= blk->data && cpntr < blk->data + blk->size)
+	       return TRUE;
+     }
+     return FALSE;
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   _LV0_DET_ALLOC
+.PURPOSE     allocate memory for a Detector MDS record
+.INPUT/OUTPUT
+  call as   pntr = _LV0_DET_ALLOC(num_byte);
+     input:  
+            size_t num_byte  : number of bytes
+
+.RETURNS     pointer to memory, NULL when the allocation failed
+.COMMENTS    static function
+             uses malloc, unless the arena is opened by 
+	     SCIA_LV0_DET_ARENA_OPEN. The arena is a list of large blocks,
+	     a block is added when the request does not fit
+-------------------------*/
+static
+void *_LV0_DET_ALLOC(size_t num_byte)
+{
+     struct lv0_arena_block *blk;
+
+     if (! lv0_arena_active) return malloc(num_byte);
+
+     num_byte = (num_byte + LV0_ARENA_ALIGN - 1) & ~(LV0_ARENA_ALIGN - 1);
+
+     for (blk = lv0_arena_curr; blk != NULL; blk = blk->next) {
+	  if (blk->size - blk->used >= num_byte) {
+	       char *cpntr = blk->data + blk->used;
+
+	       blk->used += num_byte;
+	       lv0_arena_curr = blk;
+	       return cpntr;
+	  }
+     }
+
+     /* add a new block at the end of the list */
+     if ((blk = (struct lv0_arena_block *) 
+	  malloc(sizeof(struct lv0_arena_block))) == NULL)
+	  return NULL;
+     blk->next = NULL;
+     blk->size = max_t(size_t, num_byte, LV0_ARENA_BLOCK_SIZE);
+     blk->used = num_byte;
+     if ((blk->data = (char *) malloc(blk->size)) == NULL) {
+	  free(blk);
+	  return NULL;
+     }
+     if (lv0_arena_head == NULL) {
+	  lv0_arena_head = blk;
+     } else {
+	  struct lv0_arena_block *tail = lv0_arena_head;
+
+	  while (tail->next != NULL) tail = tail->next;
+	  tail->next = blk;
+     }
+     lv0_arena_curr = blk;
+     return blk->data;
+}
+
+static inline
+void _LV0_DET_FREE(void *pntr)
+{
+     if (! _IN_LV0_DET_ARENA(pntr)) free(pntr);
+}
+
+static inline
+void _FREE_PIXEL_DATA(unsigned char *data)
+{
+     if (! _IN_LV0_MAPPING(data)) _LV0_DET_FREE(data);
+}
+
 static inline
 void SET_NO_CLUSTER_CORRECTION(void)
 {
@@ -508,6 +678,9 @@ void SCIA_LV0_RD_MDS_PMTC_FRAME(const char *cbuff,
 
 .RETURNS     nothing, error status passed by global variable ``nadc_stat''
 .COMMENTS    static function
+             when cbuff points into a memory mapped product, the pixel data
+	     is not copied: data pointers of struct chan_src point into the
+	     mapping (zero-copy)
 -------------------------*/
 static
 unsigned short SCIA_LV0_RD_MDS_DET_SRC(const char *cbuff, size_t det_length, 
@@ -529,6 +702,8 @@ unsigned short SCIA_LV0_RD_MDS_DET_SRC(const char *cbuff, size_t det_length,
 
      struct chan_src dummy_pixel[LV0_MX_CLUSTERS];
 
+     const bool zero_copy = _IN_LV0_MAPPING(cbuff);
+
      const unsigned short CHANNEL_SYNC = 0xAAAA;
      const unsigned short CLUSTER_SYNC = 0xBBBB;
 /*
@@ -567,7 +742,7 @@ unsigned short SCIA_LV0_RD_MDS_DET_SRC(const char *cbuff, size_t det_length,
 	  if (Band_Is_Selected && numClusters > 0) {
 	       nr_chan++;
 	       data_src->pixel = (struct chan_src *)
-		    malloc (numClusters * sizeof(struct chan_src));
+		    _LV0_DET_ALLOC(numClusters * sizeof(struct chan_src));
 	       if (data_src->pixel == NULL)
 		    NADC_GOTO_ERROR(NADC_ERR_ALLOC, "pixel");
 	  } else {
@@ -586,8 +761,8 @@ unsigned short SCIA_LV0_RD_MDS_DET_SRC(const char *cbuff, size_t det_length,
 	       if (data_src->pixel[n_cl].sync != CLUSTER_SYNC) {
 		    if (Band_Is_Selected && numClusters > 0) {
 			 while (n_cl > 0)
-			      free(data_src->pixel[--n_cl].data);
-			 free(data_src->pixel);
+			      _FREE_PIXEL_DATA(data_src->pixel[--n_cl].data);
+			 _LV0_DET_FREE(data_src->pixel);
 			 data_src->hdr.channel.field.clusters = 0;
 		    } else 
 			 data_src->pixel = NULL;
@@ -633,8 +808,9 @@ unsigned short SCIA_LV0_RD_MDS_DET_SRC(const char *cbuff, size_t det_length,
 		    if (stat == DET_SRC_READ_FAILED) {
 			 if (Band_Is_Selected && numClusters > 0) {
 			      while (n_cl > 0)
-				   free(data_src->pixel[--n_cl].data);
-			      free(data_src->pixel);
+				   _FREE_PIXEL_DATA(
+					data_src->pixel[--n_cl].data);
+			      _LV0_DET_FREE(data_src->pixel);
 			      data_src->hdr.channel.field.clusters = 0;
 			 }
 			 NADC_GOTO_ERROR(NADC_WARN_PDS_RD,
@@ -653,9 +829,11 @@ unsigned short SCIA_LV0_RD_MDS_DET_SRC(const char *cbuff, size_t det_length,
 			 num_byte += ENVI_UCHAR;
 	       }
                /* pixel data */
-	       if (Band_Is_Selected) {
+	       if (Band_Is_Selected && zero_copy) {
+		    data_src->pixel[n_cl].data = (unsigned char *) cpntr;
+	       } else if (Band_Is_Selected) {
 		    data_src->pixel[n_cl].data = 
-			 (unsigned char *) malloc(num_byte);
+			 (unsigned char *) _LV0_DET_ALLOC(num_byte);
 		    if (data_src->pixel[n_cl].data == NULL)
 			 NADC_GOTO_ERROR(NADC_ERR_ALLOC, 
 					  "pixel->data");
@@ -771,19 +949,20 @@ void SCIA_LV0_RD_ONE_AUX(FILE *fd, const struct mds0_info *info,
 	  + NUM_LV0_AUX_PMTC_FRAME * AUX_DATA_SRC_LENGTH;
 
      register unsigned short nf;
-     register char *cpntr;
+     register const char *cpntr;
 
      char cbuff[lv0_aux_dsr_size];
 /*
- * rewind/read input data file
- */
-     (void) fseek(fd, (long) info->offset, SEEK_SET);
-/*
+ * use Auxiliary DSR from memory mapped product, or
  * read Auxiliary DSR from file as a character array
  */
-     if (fread(cbuff, lv0_aux_dsr_size, 1, fd) != 1)
-	  NADC_RETURN_ERROR(NADC_ERR_PDS_RD, "LV0_AUX_DSR");
-     cpntr = cbuff;
+     cpntr = _LV0_MAPPED_DSR(fd, info->offset, lv0_aux_dsr_size);
+     if (cpntr == NULL) {
+	  (void) fseek(fd, (long) info->offset, SEEK_SET);
+	  if (fread(cbuff, lv0_aux_dsr_size, 1, fd) != 1)
+	       NADC_RETURN_ERROR(NADC_ERR_PDS_RD, "LV0_AUX_DSR");
+	  cpntr = cbuff;
+     }
 /*
  * read Annotation (ISP, FEP)
  */
@@ -852,21 +1031,25 @@ void SCIA_LV0_RD_ONE_DET(FILE *fd,
 	  + LV0_PACKET_HDR_LENGTH + LV0_DATA_HDR_LENGTH + LV0_PMTC_HDR_LENGTH
 	  + ENVI_USHRT + 8 * ENVI_INT + ENVI_USHRT;
 
-     register char *cpntr;
+     register const char *cpntr;
 
      char cbuff[lv0_det_dsr_size];
      char *cdet;
+     const char *cdet_map;
+     bool   hdr_mapped = TRUE;
      size_t det_length;
 /*
- * rewind/read input data file
+ * use Detector DSR header from memory mapped product, or
+ * read Detector DSR header from file as a character array
  */
-     (void) fseek(fd, (long) info->offset, SEEK_SET);
-/*
- * read PMD DSR from file as a character array
- */
-     if (fread(cbuff, lv0_det_dsr_size, 1, fd) != 1)
-	  NADC_RETURN_ERROR(NADC_ERR_PDS_RD, "LV0_DET_HDR");
-     cpntr = cbuff;
+     cpntr = _LV0_MAPPED_DSR(fd, info->offset, lv0_det_dsr_size);
+     if (cpntr == NULL) {
+	  (void) fseek(fd, (long) info->offset, SEEK_SET);
+	  if (fread(cbuff, lv0_det_dsr_size, 1, fd) != 1)
+	       NADC_RETURN_ERROR(NADC_ERR_PDS_RD, "LV0_DET_HDR");
+	  cpntr = cbuff;
+	  hdr_mapped = FALSE;
+     }
 /*
  * read Annotation (ISP, FEP)
  */
@@ -928,23 +1111,32 @@ void SCIA_LV0_RD_ONE_DET(FILE *fd,
  * read ISP Detector Data Source Packet
  */
      det_length = (size_t) (det->packet_hdr.length - DET_DATA_HDR_LENGTH + 1);
-     if ((cdet = (char *) malloc(det_length)) == NULL) 
-	  NADC_RETURN_ERROR(NADC_ERR_ALLOC, "cdet");
-     if (fread(cdet, det_length, 1, fd) != 1) {
-	  free(cdet);
-	  NADC_RETURN_ERROR(NADC_ERR_FILE_RD, "cdet");
+     cdet = NULL;
+     cdet_map = _LV0_MAPPED_DSR(fd, info->offset + lv0_det_dsr_size,
+				det_length);
+     if (cdet_map == NULL) {
+	  if (hdr_mapped)
+	       (void) fseek(fd, (long) (info->offset + lv0_det_dsr_size),
+			    SEEK_SET);
+	  if ((cdet = (char *) malloc(det_length)) == NULL) 
+	       NADC_RETURN_ERROR(NADC_ERR_ALLOC, "cdet");
+	  if (fread(cdet, det_length, 1, fd) != 1) {
+	       free(cdet);
+	       NADC_RETURN_ERROR(NADC_ERR_FILE_RD, "cdet");
+	  }
+	  cdet_map = cdet;
      }
      if (! Use_Extern_Alloc) {
 	  det->data_src = (struct det_src *) 
-	       malloc(det->num_chan * sizeof(struct det_src));
+	       _LV0_DET_ALLOC(det->num_chan * sizeof(struct det_src));
      }
      if (det->data_src == NULL) {
-	  free(cdet);
+	  if (cdet != NULL) free(cdet);
 	  NADC_RETURN_ERROR(NADC_ERR_ALLOC, "det_src");
      }
-     det->num_chan = SCIA_LV0_RD_MDS_DET_SRC(cdet, det_length, 
+     det->num_chan = SCIA_LV0_RD_MDS_DET_SRC(cdet_map, det_length, 
 					     det->num_chan, det->data_src);
-     free(cdet);
+     if (cdet != NULL) free(cdet);
      if (IS_ERR_STAT_WARN) {
 	  char msg[SHORT_STRING_LENGTH];
 	  (void) snprintf(msg, SHORT_STRING_LENGTH,
@@ -954,7 +1146,7 @@ void SCIA_LV0_RD_ONE_DET(FILE *fd,
 	  NADC_RETURN_ERROR(NADC_ERR_NONE, msg);
      }
      if (IS_ERR_STAT_FATAL) {
-	  if (! Use_Extern_Alloc) free(det->data_src);
+	  if (! Use_Extern_Alloc) _LV0_DET_FREE(det->data_src);
 	  NADC_RETURN_ERROR(NADC_ERR_PDS_RD, "MDS_DATA_SRC");
      }
 }
@@ -982,19 +1174,20 @@ void SCIA_LV0_RD_ONE_PMD(FILE *fd, const struct mds0_info *info,
      const size_t lv0_pmd_dsr_size = LV0_ANNOTATION_LENGTH 
 	  + LV0_PACKET_HDR_LENGTH + LV0_DATA_HDR_LENGTH + PMD_DATA_SRC_LENGTH;
 
-     register char *cpntr;
+     register const char *cpntr;
 
      char cbuff[lv0_pmd_dsr_size];
 /*
- * rewind/read input data file
- */
-     (void) fseek(fd, (long) info->offset, SEEK_SET);
-/*
+ * use PMD DSR from memory mapped product, or
  * read PMD DSR from file as a character array
  */
-     if (fread(cbuff, lv0_pmd_dsr_size, 1, fd) != 1)
-	  NADC_RETURN_ERROR(NADC_ERR_PDS_RD, "LV0_PMD_DSR");
-     cpntr = cbuff;
+     cpntr = _LV0_MAPPED_DSR(fd, info->offset, lv0_pmd_dsr_size);
+     if (cpntr == NULL) {
+	  (void) fseek(fd, (long) info->offset, SEEK_SET);
+	  if (fread(cbuff, lv0_pmd_dsr_size, 1, fd) != 1)
+	       NADC_RETURN_ERROR(NADC_ERR_PDS_RD, "LV0_PMD_DSR");
+	  cpntr = cbuff;
+     }
 /*
  * read Annotation (ISP, FEP)
  */
@@ -1144,7 +1337,7 @@ unsigned short SCIA_LV0_RD_DET(FILE *fd, const struct mds0_info *info,
  */
      if (! Use_Extern_Alloc) {
 	  *det_out = (struct mds0_det *) 
-	       malloc(num_info * sizeof(struct mds0_det));
+	       _LV0_DET_ALLOC(num_info * sizeof(struct mds0_det));
      }
      if ((det = *det_out) == NULL) 
 	  NADC_GOTO_ERROR(NADC_ERR_ALLOC, "mds0_det");
@@ -1156,7 +1349,7 @@ unsigned short SCIA_LV0_RD_DET(FILE *fd, const struct mds0_info *info,
 	  if (IS_ERR_STAT_FATAL) {
 	       char msg[32];
 
-	       free(*det_out);
+	       _LV0_DET_FREE(*det_out);
 	       (void) snprintf(msg, 32, "MDS_DET[%-u]", nr_det);
 	       NADC_GOTO_ERROR(NADC_ERR_PDS_RD, msg);
 	  }
@@ -1240,13 +1433,15 @@ unsigned short SCIA_LV0_RD_PMD(FILE *fd, const struct mds0_info *info,
             struct mds0_det *det    : Detector MDS records
 
 .RETURNS     error status passed by global variable ``nadc_stat''
-.COMMENTS    none
+.COMMENTS    records allocated from the arena are released by 
+             SCIA_LV0_DET_ARENA_RELEASE, this function does nothing for them
 -------------------------*/
 void SCIA_LV0_FREE_MDS_DET(unsigned short num_det, struct mds0_det *det)
 {
      register unsigned short nd = 0;
 
      if (num_det == 0) return;
+     if (_IN_LV0_DET_ARENA(det)) return;
 
      do {
 	  register unsigned short n_ch, n_cl;
@@ -1256,14 +1451,138 @@ void SCIA_LV0_FREE_MDS_DET(unsigned short num_det, struct mds0_det *det)
 		    det[nd].data_src[n_ch].hdr.channel.field.clusters;
 
 	       for (n_cl = 0; n_cl < numClusters; n_cl++)
-		    free(det[nd].data_src[n_ch].pixel[n_cl].data);
+		    _FREE_PIXEL_DATA(
+			 det[nd].data_src[n_ch].pixel[n_cl].data);
 
-	       if (numClusters > 0) free(det[nd].data_src[n_ch].pixel);
+	       if (numClusters > 0) 
+		    _LV0_DET_FREE(det[nd].data_src[n_ch].pixel);
 	  }
-	  free(det[nd].data_src);
+	  _LV0_DET_FREE(det[nd].data_src);
      } while(++nd < num_det);
 
-     free(det);
+     _LV0_DET_FREE(det);
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   SCIA_LV0_DET_ARENA_OPEN
+.PURPOSE     allocate all following Detector MDS records from an arena
+.INPUT/OUTPUT
+  call as   SCIA_LV0_DET_ARENA_OPEN();
+
+.RETURNS     nothing
+.COMMENTS    After this call, SCIA_LV0_RD_DET allocates the records, the 
+             channel and cluster arrays and the pixel data from a few large 
+	     memory blocks (bump allocator). Call SCIA_LV0_DET_ARENA_RELEASE
+	     when all records of a state are processed, this releases them 
+	     in one call and keeps the memory blocks for the next state.
+	     SCIA_LV0_FREE_MDS_DET may still be called, but does nothing for
+	     records in the arena. SCIA_LV0_DET_ARENA_CLOSE frees the arena 
+	     and restores the use of malloc/free.
+	     Callers which keep records individually, should not use the arena
+-------------------------*/
+void SCIA_LV0_DET_ARENA_OPEN(void)
+{
+     lv0_arena_active = TRUE;
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   SCIA_LV0_DET_ARENA_RELEASE
+.PURPOSE     release all Detector MDS records allocated from the arena
+.INPUT/OUTPUT
+  call as   SCIA_LV0_DET_ARENA_RELEASE();
+
+.RETURNS     nothing
+.COMMENTS    the memory blocks of the arena are kept for re-use
+-------------------------*/
+void SCIA_LV0_DET_ARENA_RELEASE(void)
+{
+     struct lv0_arena_block *blk;
+
+     for (blk = lv0_arena_head; blk != NULL; blk = blk->next)
+	  blk->used = 0;
+     lv0_arena_curr = lv0_arena_head;
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   SCIA_LV0_DET_ARENA_CLOSE
+.PURPOSE     free the arena for Detector MDS records
+.INPUT/OUTPUT
+  call as   SCIA_LV0_DET_ARENA_CLOSE();
+
+.RETURNS     nothing
+.COMMENTS    all records allocated from the arena become invalid
+-------------------------*/
+void SCIA_LV0_DET_ARENA_CLOSE(void)
+{
+     while (lv0_arena_head != NULL) {
+	  struct lv0_arena_block *blk = lv0_arena_head;
+
+	  lv0_arena_head = blk->next;
+	  free(blk->data);
+	  free(blk);
+     }
+     lv0_arena_curr = NULL;
+     lv0_arena_active = FALSE;
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   SCIA_LV0_MMAP_OPEN
+.PURPOSE     map a SCIAMACHY level 0 product read-only in memory
+.INPUT/OUTPUT
+  call as   SCIA_LV0_MMAP_OPEN(fd);
+     input:  
+            FILE   *fd             : (open) stream pointer
+
+.RETURNS     nothing, error status passed by global variable ``nadc_stat''
+.COMMENTS    After a successful call, SCIA_LV0_RD_AUX, SCIA_LV0_RD_DET and
+             SCIA_LV0_RD_PMD take their DSRs from the mapping instead of 
+	     fseek/fread. The pixel data of the Detector MDS records are 
+	     not copied, struct chan_src->data points into the mapping 
+	     (read-only!). Release these records with SCIA_LV0_FREE_MDS_DET
+	     before the product is unmapped by SCIA_LV0_MMAP_CLOSE.
+	     Only one product can be mapped at a time.
+-------------------------*/
+void SCIA_LV0_MMAP_OPEN(FILE *fd)
+{
+     struct stat flstat;
+
+     void *addr;
+
+     if (lv0_map_addr != NULL) SCIA_LV0_MMAP_CLOSE();
+
+     if (fstat(fileno(fd), &flstat) != 0 || flstat.st_size == 0)
+	  NADC_RETURN_ERROR(NADC_ERR_FILE, "fstat");
+
+     addr = mmap(NULL, (size_t) flstat.st_size, PROT_READ, MAP_SHARED,
+		 fileno(fd), 0);
+     if (addr == MAP_FAILED)
+	  NADC_RETURN_ERROR(NADC_ERR_FILE_RD, "mmap");
+     (void) posix_madvise(addr, (size_t) flstat.st_size, 
+			  POSIX_MADV_SEQUENTIAL);
+
+     lv0_map_fd   = fileno(fd);
+     lv0_map_size = (size_t) flstat.st_size;
+     lv0_map_addr = (char *) addr;
+}
+
+/*+++++++++++++++++++++++++
+.IDENTifer   SCIA_LV0_MMAP_CLOSE
+.PURPOSE     release memory map of a SCIAMACHY level 0 product
+.INPUT/OUTPUT
+  call as   SCIA_LV0_MMAP_CLOSE();
+
+.RETURNS     nothing
+.COMMENTS    all Detector MDS records read from the mapping should be 
+             released, because their pixel data become invalid
+-------------------------*/
+void SCIA_LV0_MMAP_CLOSE(void)
+{
+     if (lv0_map_addr == NULL) return;
+
+     (void) munmap(lv0_map_addr, lv0_map_size);
+     lv0_map_fd   = -1;
+     lv0_map_size = 0;
+     lv0_map_addr = NULL;
 }
 
 /*+++++++++++++++++++++++++
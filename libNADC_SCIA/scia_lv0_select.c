@@ -34,7 +34,8 @@
              error status passed by global variable ``nadc_stat''
 .COMMENTS    None
 .ENVIRONment None
-.VERSION      4.0   20-Mar-2015	big update using mds0_states, RvH
+.VERSION      4.1   17-Oct-2026	obtain parameters by identifier, RvH
+              4.0   20-Mar-2015	big update using mds0_states, RvH
               3.1   09-Dec-2009	add unique filter, RvH
               3.0   11-Oct-2005	rewrite to one selection per module, RvH
               2.5   13-Oct-2003	changes to due modification of mds0_info, RvH
@@ -183,21 +184,21 @@ size_t SCIA_LV0_SELECT_MDS_COMPLETE(const struct mds0_states *states,
 	  register bool good_pmd = TRUE;
 
 	  // if write_aux then check q_aux
-	  if (nadc_get_param_uint8("write_aux") == PARAM_SET) {
+	  if (nadc_get_param_uint8_id(PARAM_WRITE_AUX) == PARAM_SET) {
 	       if (states[indx[ni]].q_aux.flag.sync == 1
 		    || states[indx[ni]].q_aux.flag.too_short == 1
 		    || states[indx[ni]].q_aux.flag.dsr_missing == 1)
 		    good_aux = FALSE;
 	  }
 	  // if write_det then check q_det
-	  if (nadc_get_param_uint8("write_det") == PARAM_SET) {
+	  if (nadc_get_param_uint8_id(PARAM_WRITE_DET) == PARAM_SET) {
 	       if (states[indx[ni]].q_det.flag.sync == 1
 		    || states[indx[ni]].q_det.flag.too_short == 1
 		    || states[indx[ni]].q_det.flag.dsr_missing == 1)
 		    good_det = FALSE;
 	  }
 	  // if write_pmd then check q_pmd
-	  if (nadc_get_param_uint8("write_pmd") == PARAM_SET) {
+	  if (nadc_get_param_uint8_id(PARAM_WRITE_PMD) == PARAM_SET) {
 	       if (states[indx[ni]].q_pmd.flag.sync == 1
 		    || states[indx[ni]].q_pmd.flag.too_short == 1
 		    || states[indx[ni]].q_pmd.flag.dsr_missing == 1)
@@ -243,7 +244,7 @@ size_t SCIA_LV0_SELECT_MDS_CRC(const struct mds0_states *states,
 	  register unsigned short crc_pmd = 0;
 
 	  // if write_aux then check CRC of state
-	  if (nadc_get_param_uint8("write_aux") == PARAM_SET) {
+	  if (nadc_get_param_uint8_id(PARAM_WRITE_AUX) == PARAM_SET) {
 	       for (ni = 0; ni < states[indx[ns]].num_aux; ni++)
 		    crc_aux += states[indx[ns]].info_aux[ni].crc_errors;
 
@@ -251,7 +252,7 @@ size_t SCIA_LV0_SELECT_MDS_CRC(const struct mds0_states *states,
 	       
 	  }
 	  // if write_aux then check CRC of state
-	  if (nadc_get_param_uint8("write_det") == PARAM_SET) {
+	  if (nadc_get_param_uint8_id(PARAM_WRITE_DET) == PARAM_SET) {
 	       for (ni = 0; ni < states[indx[ns]].num_det; ni++)
 		    crc_det += states[indx[ns]].info_det[ni].crc_errors;
 
@@ -259,7 +260,7 @@ size_t SCIA_LV0_SELECT_MDS_CRC(const struct mds0_states *states,
 	       
 	  }
 	  // if write_pmd then check CRC of state
-	  if (nadc_get_param_uint8("write_pmd") == PARAM_SET) {
+	  if (nadc_get_param_uint8_id(PARAM_WRITE_PMD) == PARAM_SET) {
 	       for (ni = 0; ni < states[indx[ns]].num_pmd; ni++)
 		    crc_pmd += states[indx[ns]].info_pmd[ni].crc_errors;
 
@@ -297,9 +298,9 @@ size_t SCIA_LV0_SELECT_MDS(size_t num_states, const struct mds0_states *states,
 /*
  * first check type of selected MDS
  */
-     if (nadc_get_param_uint8("write_aux") == PARAM_UNSET
-	 && nadc_get_param_uint8("write_det") == PARAM_UNSET
-	 && nadc_get_param_uint8("write_pmd") == PARAM_UNSET)
+     if (nadc_get_param_uint8_id(PARAM_WRITE_AUX) == PARAM_UNSET
+	 && nadc_get_param_uint8_id(PARAM_WRITE_DET) == PARAM_UNSET
+	 && nadc_get_param_uint8_id(PARAM_WRITE_PMD) == PARAM_UNSET)
 	  return 0u;
 /*
  * allocate memory to store indices to selected MDS records
@@ -311,7 +312,7 @@ size_t SCIA_LV0_SELECT_MDS(size_t num_states, const struct mds0_states *states,
 /*
  * apply date-time criterium
  */
-     if (nadc_get_param_uint8("flag_period") != PARAM_UNSET) {
+     if (nadc_get_param_uint8_id(PARAM_FLAG_PERIOD) != PARAM_UNSET) {
 	  nr_indx = SCIA_LV0_SELECT_MDS_PERIOD(states, nr_indx, indx_states);
 	  if (nr_indx == 0) goto done;
      }
@@ -323,14 +324,14 @@ size_t SCIA_LV0_SELECT_MDS(size_t num_states, const struct mds0_states *states,
 /*
  * reject incomplete states
  */
-     if (nadc_get_param_uint8("qcheck") == PARAM_SET) {
+     if (nadc_get_param_uint8_id(PARAM_QCHECK) == PARAM_SET) {
 	  nr_indx = SCIA_LV0_SELECT_MDS_COMPLETE(states, nr_indx, indx_states);
 	  if (nr_indx == 0) goto done;
      }
 /*
  * apply CRC criterium 
  */
-     if (nadc_get_param_uint8("qcheck") == PARAM_SET) {
+     if (nadc_get_param_uint8_id(PARAM_QCHECK) == PARAM_SET) {
 	  nr_indx = SCIA_LV0_SELECT_MDS_CRC(states, nr_indx, indx_states);
 	  if (nr_indx == 0) goto done;
      }
@@ -357,7 +358,7 @@ size_t SCIA_LV0_SELECT_MDS(size_t num_states, const struct mds0_states *states,
 	       states[indx_states[ni]].on_board_time;
 	  (*states_out)[ni].offset = states[indx_states[ni]].offset;
 
-	  if (nadc_get_param_uint8("write_aux") == PARAM_UNSET) {
+	  if (nadc_get_param_uint8_id(PARAM_WRITE_AUX) == PARAM_UNSET) {
 	       (*states_out)[ni].num_aux = 0;
 	       (*states_out)[ni].info_aux = NULL;
 	  } else if ((*states_out)[ni].num_aux > 0) {
@@ -369,7 +370,7 @@ size_t SCIA_LV0_SELECT_MDS(size_t num_states, const struct mds0_states *states,
 			      states[indx_states[ni]].info_aux,
 			      num_aux * sizeof(struct mds0_info));
 	  }
-	  if (nadc_get_param_uint8("write_det") == PARAM_UNSET) {
+	  if (nadc_get_param_uint8_id(PARAM_WRITE_DET) == PARAM_UNSET) {
 	       (*states_out)[ni].num_det = 0;
 	       (*states_out)[ni].info_det = NULL;
 	  } else if ((*states_out)[ni].num_det > 0) {
@@ -381,7 +382,7 @@ size_t SCIA_LV0_SELECT_MDS(size_t num_states, const struct mds0_states *states,
 			      states[indx_states[ni]].info_det,
 			      num_det * sizeof(struct mds0_info));
 	  }
-	  if (nadc_get_param_uint8("write_pmd") == PARAM_UNSET) {
+	  if (nadc_get_param_uint8_id(PARAM_WRITE_PMD) == PARAM_UNSET) {
 	       (*states_out)[ni].num_pmd = 0;
 	       (*states_out)[ni].info_pmd = NULL;
 	  } else if ((*states_out)[ni].num_pmd > 0) {
@@ -0,0 +1,323 @@
+/*++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+.COPYRIGHT (c) 2026 SRON (R.M.van.Hees@sron.nl)
+
+   This is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License, version 2, as
+   published by the Free Software Foundation.
+
+   The software is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place - Suite 330,
+   Boston, MA  02111-1307, USA.
+
+.IDENTifer   SCIA_LV0_UNPACK_PIXEL
+.AUTHOR      R.M. van Hees
+.KEYWORDS    SCIA level 0 - detector pixel data
+.LANGUAGE    ANSI C
+.PURPOSE     unpack big-endian 16-bit or 24-bit detector readouts
+.INPUT/OUTPUT
+  call as   SCIA_LV0_UNPACK_PIXEL_16( data, cpntr, num );
+            SCIA_LV0_UNPACK_PIXEL_24( data, cpntr, num );
+            SCIA_LV0_UNPACK_PIXEL_16S( sdata, cpntr, num );
+            SCIA_LV0_UNPACK_PIXEL( pixel, data );
+     input:
+            unsigned char *cpntr     :  packed pixel data (2 or 3 bytes)
+            size_t num               :  number of pixels
+	    struct chan_src *pixel   :  pixel data block of a cluster
+    output:
+            unsigned int *data       :  pixel values
+            unsigned short *sdata    :  pixel values (16-bit only)
+
+.RETURNS     nothing
+.COMMENTS    - co-adding factor 1 gives 16-bit values, else 24-bit values
+             - x86_64: SSSE3 and AVX2 byte-shuffle kernels, selected at
+	       run-time when supported by the CPU; other platforms use
+	       the scalar loop
+	     - the gain is in the 24-bit path (TEST_PROG: about 0.6-0.76
+	       -> 4.8-7.5 Gpixel/s); the 16-bit scalar loop is vectorised
+	       by the compiler, its kernel is not significantly faster
+	       (about 4.7 Gpixel/s for both, with a large spread)
+.ENVIRONment None
+.VERSION     1.0     17-Oct-2026   Created by R. M. van Hees
+------------------------------------------------------------*/
+/*
+ * Define _ISOC99_SOURCE to indicate
+ * that this is a ISO C99 program
+ */
+#define  _ISOC99_SOURCE
+
+/*+++++ System headers +++++*/
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define _UNPACK_X86_64
+#include <immintrin.h>
+#endif
+
+/*+++++ Local Headers +++++*/
+#define _SCIA_LEVEL_0
+#include <nadc_scia.h>
+
+#ifdef _SWAP_TO_LITTLE_ENDIAN
+#include <swap_bytes.h>
+#endif
+
+/*+++++++++++++++++++++++++ Static Functions +++++++++++++++++++++++*/
+static inline
+void _UNPACK_TAIL_16( unsigned int *data, const unsigned char *cpntr,
+		      size_t num )
+{
+     while ( num-- > 0 ) {
+	  *data++ = (unsigned int) cpntr[1]
+	       + ((unsigned int) cpntr[0] << 8);
+	  cpntr += 2;
+     }
+}
+
+static inline
+void _UNPACK_TAIL_24( unsigned int *data, const unsigned char *cpntr,
+		      size_t num )
+{
+     while ( num-- > 0 ) {
+	  *data++ = (unsigned int) cpntr[2]
+	       + ((unsigned int) cpntr[1] << 8)
+	       + ((unsigned int) cpntr[0] << 16);
+	  cpntr += 3;
+     }
+}
+
+#ifdef _UNPACK_X86_64
+/*
+ * SSSE3 kernels: one byte shuffle reverses the bytes of a pixel and
+ * inserts the zero bytes of the 32-bit value (index -1)
+ */
+__attribute__((target("ssse3")))
+static
+size_t _SSSE3_UNPACK_16( unsigned int *data, const unsigned char *cpntr,
+			 size_t num )
+{
+     const __m128i mask_lo = _mm_setr_epi8(
+	  1, 0, -1, -1, 3, 2, -1, -1, 5, 4, -1, -1, 7, 6, -1, -1 );
+     const __m128i mask_hi = _mm_setr_epi8(
+	  9, 8, -1, -1, 11, 10, -1, -1, 13, 12, -1, -1, 15, 14, -1, -1 );
+
+     size_t nr = 0;
+
+     for ( ; nr + 8 <= num; nr += 8, cpntr += 16 ) {
+	  __m128i xx = _mm_loadu_si128( (const __m128i *) cpntr );
+
+	  _mm_storeu_si128( (__m128i *) (data + nr),
+			    _mm_shuffle_epi8( xx, mask_lo ) );
+	  _mm_storeu_si128( (__m128i *) (data + nr + 4),
+			    _mm_shuffle_epi8( xx, mask_hi ) );
+     }
+     return nr;
+}
+
+/* 4 pixels per 12 bytes, a 16 byte load needs 2 more pixels */
+__attribute__((target("ssse3")))
+static
+size_t _SSSE3_UNPACK_24( unsigned int *data, const unsigned char *cpntr,
+			 size_t num )
+{
+     const __m128i mask = _mm_setr_epi8(
+	  2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1 );
+
+     size_t nr = 0;
+
+     for ( ; nr + 6 <= num; nr += 4, cpntr += 12 ) {
+	  __m128i xx = _mm_loadu_si128( (const __m128i *) cpntr );
+
+	  _mm_storeu_si128( (__m128i *) (data + nr),
+			    _mm_shuffle_epi8( xx, mask ) );
+     }
+     return nr;
+}
+
+/*
+ * AVX2 kernels: 8 pixels per iteration
+ */
+__attribute__((target("avx2")))
+static
+size_t _AVX2_UNPACK_16( unsigned int *data, const unsigned char *cpntr,
+			size_t num )
+{
+     const __m128i mask = _mm_setr_epi8(
+	  1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 );
+
+     size_t nr = 0;
+
+     for ( ; nr + 8 <= num; nr += 8, cpntr += 16 ) {
+	  __m128i xx = _mm_loadu_si128( (const __m128i *) cpntr );
+
+	  _mm256_storeu_si256( (__m256i *) (data + nr),
+		       _mm256_cvtepu16_epi32( _mm_shuffle_epi8( xx, mask ) ) );
+     }
+     return nr;
+}
+
+/* 8 pixels per 24 bytes, the second 16 byte load needs 2 more pixels */
+__attribute__((target("avx2")))
+static
+size_t _AVX2_UNPACK_24( unsigned int *data, const unsigned char *cpntr,
+			size_t num )
+{
+     const __m256i mask = _mm256_setr_epi8(
+	  2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1,
+	  2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1 );
+
+     size_t nr = 0;
+
+     for ( ; nr + 10 <= num; nr += 8, cpntr += 24 ) {
+	  __m256i yy = _mm256_inserti128_si256(
+	       _mm256_castsi128_si256(
+		    _mm_loadu_si128( (const __m128i *) cpntr ) ),
+	       _mm_loadu_si128( (const __m128i *) (cpntr + 12) ), 1 );
+
+	  _mm256_storeu_si256( (__m256i *) (data + nr),
+			       _mm256_shuffle_epi8( yy, mask ) );
+     }
+     return nr;
+}
+
+static inline
+int _HAS_SSSE3( void )
+{
+     return __builtin_cpu_supports( "ssse3" );
+}
+
+static inline
+int _HAS_AVX2( void )
+{
+     return __builtin_cpu_supports( "avx2" );
+}
+#endif /* _UNPACK_X86_64 */
+
+/*+++++++++++++++++++++++++ Main Program or Function +++++++++++++++*/
+void SCIA_LV0_UNPACK_PIXEL_16( unsigned int *data, const unsigned char *cpntr,
+			       size_t num )
+{
+     size_t nr = 0;
+
+#ifdef _UNPACK_X86_64
+     if ( _HAS_AVX2() )
+	  nr = _AVX2_UNPACK_16( data, cpntr, num );
+     else if ( _HAS_SSSE3() )
+	  nr = _SSSE3_UNPACK_16( data, cpntr, num );
+#endif
+     _UNPACK_TAIL_16( data + nr, cpntr + 2 * nr, num - nr );
+}
+
+void SCIA_LV0_UNPACK_PIXEL_24( unsigned int *data, const unsigned char *cpntr,
+			       size_t num )
+{
+     size_t nr = 0;
+
+#ifdef _UNPACK_X86_64
+     if ( _HAS_AVX2() )
+	  nr = _AVX2_UNPACK_24( data, cpntr, num );
+     if ( _HAS_SSSE3() )
+	  nr += _SSSE3_UNPACK_24( data + nr, cpntr + 3 * nr, num - nr );
+#endif
+     _UNPACK_TAIL_24( data + nr, cpntr + 3 * nr, num - nr );
+}
+
+void SCIA_LV0_UNPACK_PIXEL_16S( unsigned short *sdata,
+				const unsigned char *cpntr, size_t num )
+{
+#ifdef _SWAP_TO_LITTLE_ENDIAN
+     NADC_SWAP_ARRAY_16( sdata, cpntr, num );
+#else
+     (void) memcpy( sdata, cpntr, 2 * num );
+#endif
+}
+
+void SCIA_LV0_UNPACK_PIXEL( const struct chan_src *pixel,
+			    /*@out@*/ unsigned int *data )
+{
+     if ( pixel->co_adding == UCHAR_ONE )
+	  SCIA_LV0_UNPACK_PIXEL_16( data, pixel->data, pixel->length );
+     else
+	  SCIA_LV0_UNPACK_PIXEL_24( data, pixel->data, pixel->length );
+}
+
+/*
+ * compile code with
+ *  gcc -O2 -DTEST_PROG -D_SWAP_TO_LITTLE_ENDIAN -I../include \
+ *      scia_lv0_unpack_pixel.c -L../libNADC -lnadc
+ */
+#ifdef TEST_PROG
+#include <stdlib.h>
+#include <time.h>
+
+int main( void )
+{
+     const size_t num = 1024;            /* longest cluster */
+     const int    num_loop = 100000;
+
+     register int    nl;
+     register size_t nr;
+
+     unsigned char  *cbuff = malloc( 3 * num );
+     unsigned int   *data  = malloc( num * sizeof(int) );
+     unsigned int   *ref   = malloc( num * sizeof(int) );
+     unsigned short *sdata = malloc( num * sizeof(short) );
+
+     int     num_err = 0;
+     clock_t tm;
+
+     for ( nr = 0; nr < 3 * num; nr++ )
+	  cbuff[nr] = (unsigned char) (rand() & 0xff);
+/*
+ * check all lengths, including the tails of the vector kernels
+ */
+     for ( nr = 0; nr <= 40; nr++ ) {
+	  register size_t ni;
+
+	  _UNPACK_TAIL_16( ref, cbuff, nr );
+	  SCIA_LV0_UNPACK_PIXEL_16( data, cbuff, nr );
+	  SCIA_LV0_UNPACK_PIXEL_16S( sdata, cbuff, nr );
+	  for ( ni = 0; ni < nr; ni++ ) {
+	       if ( data[ni] != ref[ni] ) num_err++;
+	       if ( sdata[ni] != ref[ni] ) num_err++;
+	  }
+	  _UNPACK_TAIL_24( ref, cbuff, nr );
+	  SCIA_LV0_UNPACK_PIXEL_24( data, cbuff, nr );
+	  for ( ni = 0; ni < nr; ni++ )
+	       if ( data[ni] != ref[ni] ) num_err++;
+     }
+     (void) printf( "number of errors: %d\n", num_err );
+/*
+ * throughput
+ */
+     tm = clock();
+     for ( nl = 0; nl < num_loop; nl++ )
+	  _UNPACK_TAIL_16( data, cbuff + (nl & 1), num );
+     (void) printf( "16-bit scalar: %8.1f Mpixel/s\n",
+		    1e-6 * num * num_loop * CLOCKS_PER_SEC / (clock() - tm) );
+     tm = clock();
+     for ( nl = 0; nl < num_loop; nl++ )
+	  SCIA_LV0_UNPACK_PIXEL_16( data, cbuff + (nl & 1), num );
+     (void) printf( "16-bit vector: %8.1f Mpixel/s\n",
+		    1e-6 * num * num_loop * CLOCKS_PER_SEC / (clock() - tm) );
+     tm = clock();
+     for ( nl = 0; nl < num_loop; nl++ )
+	  _UNPACK_TAIL_24( data, cbuff + (nl & 1), num - 1 );
+     (void) printf( "24-bit scalar: %8.1f Mpixel/s\n",
+		    1e-6 * num * num_loop * CLOCKS_PER_SEC / (clock() - tm) );
+     tm = clock();
+     for ( nl = 0; nl < num_loop; nl++ )
+	  SCIA_LV0_UNPACK_PIXEL_24( data, cbuff + (nl & 1), num - 1 );
+     (void) printf( "24-bit vector: %8.1f Mpixel/s\n",
+		    1e-6 * num * num_loop * CLOCKS_PER_SEC / (clock() - tm) );
+
+     free( cbuff ); free( data ); free( ref ); free( sdata );
+     return num_err > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+#endif /* TEST_PROG */
@@ -24,7 +24,8 @@
                 SCIA_LV1_WR_ASCII_AUX, SCIA_LV1_WR_ASCII_PMD, 
 		SCIA_LV0_WR_ASCII_DET
 .ENVIRONment None
-.VERSION      1.7   13-Oct-2003 no longer write empty Auxiliary and PMD MDS 
+.VERSION      1.8   17-Oct-2026 use SCIA_LV0_UNPACK_PIXEL, RvH
+              1.7   13-Oct-2003 no longer write empty Auxiliary and PMD MDS 
                                 after "end of measurement", RvH
               1.6   12-Mar-2003	aggressive inline of static function, RvH
               1.5   19-Mar-2002	replaced confusing bench_obm 
@@ -53,30 +54,6 @@
 #define PACKET_SSC     ((unsigned short) 49152)
 
 /*+++++++++++++++++++++++++ Static Functions +++++++++++++++++++++++*/
-static inline
-void UNPACK_LV0_PIXEL_VAL(const struct chan_src *pixel,
-                           /*@out@*/ unsigned int *data)
-{
-     register unsigned short np = 0;
-
-     register unsigned char *cpntr = pixel->data;
-
-     if (pixel->co_adding == (unsigned char) 1) {
-          do {
-               *data++ = (unsigned int) cpntr[1]
-                    + ((unsigned int) cpntr[0] << 8);
-               cpntr += 2;
-          } while (++np < pixel->length);
-     } else {
-          do {
-               *data++ = (unsigned int) cpntr[2]
-                    + ((unsigned int) cpntr[1] << 8)
-                    + ((unsigned int) cpntr[0] << 16);
-               cpntr += 3;
-          } while (++np < pixel->length);
-     }
-}
-
 /*
  * -------------------------
  * Level 0 MDS: Annotiations and [ISP] Packet Header
@@ -273,7 +250,7 @@ void WRITE_PIXEL_BLOCK(FILE *outfl, unsigned int nr,
      nadc_write_ushort(outfl, nr, "Cluster Block Length", pixel.length);
      data = (unsigned int *) malloc((size_t) pixel.length * sizeof(int));
      if (data == NULL) NADC_RETURN_ERROR(NADC_ERR_ALLOC, "data");
-     UNPACK_LV0_PIXEL_VAL(&pixel, data);
+     SCIA_LV0_UNPACK_PIXEL(&pixel, data);
      nadc_write_arr_uint(outfl, nr, "Pixel Data", 1, &adim, data);
      free(data);
 }
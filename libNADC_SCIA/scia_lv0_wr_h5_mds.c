@@ -33,9 +33,12 @@
              struct mds0_pmd *pmd       :  PMD MDS records
 
 .RETURNS     Nothing
-.COMMENTS    None
+.COMMENTS    chunk sizes of the packet tables are set by NADC_HDF5_CHUNK_SIZE
 .ENVIRONment None
-.VERSION      2.0   20-Oct-2003	complete rewrite using hdf5_hl, RvH
+.VERSION      2.2   17-Oct-2026	use SCIA_LV0_UNPACK_PIXEL_16S/24, RvH
+              2.1   17-Oct-2026	chunk size depends on record size and
+                                number of records, RvH
+              2.0   20-Oct-2003	complete rewrite using hdf5_hl, RvH
               1.2   21-Feb-2002	completed implementation, RvH
               1.1   13-Feb-2002	write level 0 structs for AUX and PMD MDS, RvH 
               1.0   06-Feb-2002	created by R. M. van Hees 
@@ -115,7 +118,7 @@ void SCIA_LV0_WR_H5_AUX(unsigned short state_index,
  * create table: AUX MDS
  */
      if (H5LTfind_dataset(grpID, tblName) == 0) {
-	  hsize_t chunk_sz = 1;
+	  hsize_t chunk_sz;
 	  hsize_t adim;
 	  hid_t   dtype_id;
 	  hid_t   tid, tid_bcp, tid_mjd, tid_fep, tid_packet, tid_data, 
@@ -271,6 +274,7 @@ void SCIA_LV0_WR_H5_AUX(unsigned short state_index,
 	  (void) H5Tclose(tid_fep);
 	  (void) H5Tclose(tid_mjd);
 
+	  chunk_sz = NADC_HDF5_CHUNK_SIZE(sizeof(struct mds0_aux), nr_aux);
 	  ptable = H5PTcreate_fl(grpID, tblName, tid, chunk_sz, compress);
 	  (void) H5Tclose(tid);
 	  if (ptable == H5I_BADID)
@@ -346,7 +350,7 @@ void SCIA_LV0_WR_H5_PMD(unsigned short state_index,
  * create table: PMD MDS
  */
      if (H5LTfind_dataset(grpID, tblName) == 0) {
-          hsize_t chunk_sz = 1;
+          hsize_t chunk_sz;
           hsize_t dims[2];
           hid_t   dtype_id;
 	  hid_t   tid, tid_mjd, tid_fep, tid_packet, tid_hdr, tid_data, tid_src;
@@ -456,6 +460,7 @@ void SCIA_LV0_WR_H5_PMD(unsigned short state_index,
 	  (void) H5Tclose(tid_hdr);
 	  (void) H5Tclose(tid_src);
 
+	  chunk_sz = NADC_HDF5_CHUNK_SIZE(sizeof(struct mds0_pmd), nr_pmd);
 	  ptable = H5PTcreate_fl(grpID, tblName, tid, chunk_sz, compress);
 	  (void) H5Tclose(tid);
 	  if (ptable == H5I_BADID)
@@ -656,7 +661,7 @@ void SCIA_LV0_WR_H5_DET(unsigned short state_index,
 	  (void) H5Tclose(tid_hdr);
 	  (void) H5Tclose(tid_pmtc);
 
-	  chunk_sz = nr_det;
+	  chunk_sz = NADC_HDF5_CHUNK_SIZE(sizeof(struct mds0_det), nr_det);
 	  ptable = H5PTcreate_fl(grpID, tblName, tid, chunk_sz, compress);
 	  (void) H5Tclose(tid);
 	  if (ptable == H5I_BADID)
@@ -735,24 +740,13 @@ void SCIA_LV0_WR_H5_DET(unsigned short state_index,
 			      sizeof(struct chan_hdr));
 
 	       if (ptr_chan_src->co_adding == UCHAR_ONE) {
-		    register unsigned short np = 0;
-		    unsigned char *cpntr = ptr_chan_src->data;
-
-		    do {
-			 *ptr_short++ = (unsigned short) cpntr[1]
-			      + ((unsigned short) cpntr[0] << 8);
-			 cpntr += 2;
-		    } while (++np < ptr_chan_src->length);
+		    SCIA_LV0_UNPACK_PIXEL_16S(ptr_short, ptr_chan_src->data,
+					      ptr_chan_src->length);
+		    ptr_short += ptr_chan_src->length;
 	       } else {
-		    register unsigned short np = 0;
-		    unsigned char *cpntr = ptr_chan_src->data;
-
-		    do {
-			 *ptr_int++ = (unsigned int) cpntr[2]
-			      + ((unsigned int) cpntr[1] << 8)
-			      + ((unsigned int) cpntr[0] << 16);
-			 cpntr += 3;
-		    } while (++np < ptr_chan_src->length);
+		    SCIA_LV0_UNPACK_PIXEL_24(ptr_int, ptr_chan_src->data,
+					     ptr_chan_src->length);
+		    ptr_int += ptr_chan_src->length;
 	       }
 	       numHDR++;
 	  }
@@ -812,7 +806,8 @@ void SCIA_LV0_WR_H5_DET(unsigned short state_index,
 				      HOFFSET(struct chan_hdr, command_ir), 
 				      H5T_NATIVE_UINT);
 
-		    chunk_sz = numHDR;
+		    chunk_sz = NADC_HDF5_CHUNK_SIZE(sizeof(struct chan_hdr),
+						     numHDR);
 		    pt_clus = H5PTcreate_fl(subgrpID, clusName, tid, 
 					     chunk_sz, compress);
 		    (void) H5Tclose(tid);
@@ -824,6 +819,7 @@ void SCIA_LV0_WR_H5_DET(unsigned short state_index,
 			 tid = H5Tarray_create(H5T_NATIVE_USHORT, 1, &adim);
 		    else
 			 tid = H5Tarray_create(H5T_NATIVE_UINT, 1, &adim);
+		    chunk_sz = NADC_HDF5_CHUNK_SIZE(H5Tget_size(tid), numHDR);
 		    pt_data = H5PTcreate_fl(subgrpID, "mds0_data", tid,
 					     chunk_sz, compress);
 		    (void) H5Tclose(tid);
@@ -32,7 +32,9 @@
 
 .ENVIRONment none
 .EXTERNALs   ENVI_GET_DSD_INDEX 
-.VERSION      2.0   11-Oct-2005 modified several function declarations, every
+.VERSION      2.1   17-Oct-2026 bugfix: size of the pixel data was derived
+                                from the byte-swapped cluster length, RvH
+              2.0   11-Oct-2005 modified several function declarations, every
                                 module returns the number of bytes written, RvH
               1.0   18-Apr-2005 created by R. M. van Hees
 ------------------------------------------------------------*/
@@ -449,14 +451,14 @@ void SCIA_LV0_WR_MDS_DET_SRC(FILE *fd, long det_length,
 	       (void) memcpy(src_pntr, &data_src.pixel[n_cl].length, 
 			      ENVI_USHRT);
 	       src_pntr += ENVI_USHRT;
-/* determine size of cluster pixel data block */
+/* determine size of cluster pixel data block (length in native order) */
 	       if (data_src.pixel[n_cl].co_adding == UCHAR_ONE)
 		    num_byte = (size_t) 
-			 data_src.pixel[n_cl].length * ENVI_USHRT;
+			 data_src_in->pixel[n_cl].length * ENVI_USHRT;
 	       else {
 		    num_byte = (size_t) 
-			 data_src.pixel[n_cl].length * 3 * ENVI_UCHAR;
-		    if ((data_src.pixel[n_cl].length % 2) == 1) 
+			 data_src_in->pixel[n_cl].length * 3 * ENVI_UCHAR;
+		    if ((data_src_in->pixel[n_cl].length % 2) == 1) 
 			 num_byte += ENVI_UCHAR;
 	       }
 /* pixel data */
@@ -23,7 +23,8 @@
 .RETURNS     number of MDS records written
 .COMMENTS    None
 .ENVIRONment None
-.VERSION      4.2   24-Nov-2008 fixed resently introduced "brown paper bag" 
+.VERSION      4.3   17-Oct-2026 bulk byte-swap of pixel and PMD arrays, RvH
+              4.2   24-Nov-2008 fixed resently introduced "brown paper bag" 
                                bug in SCIA_LV1C_WR_MDS, RvH
               4.1   13-Jun-2006 fixed "brown paper bag" bug in 
                                SCIA_LV1_WR_ONE_MDS, RvH
@@ -545,8 +546,7 @@ unsigned int SCIA_LV1_WR_ONE_MDS( FILE *fd, const struct mds1_scia *mds )
 	  byte_size = mds->n_pmd * ENVI_FLOAT;
 	  if ( (rbuff = (float *) malloc( byte_size )) == NULL ) 
 	       NADC_GOTO_ERROR( NADC_ERR_ALLOC, "rbuff" );
-	  (void) memcpy( rbuff, mds->int_pmd, byte_size );
-	  for ( ni = 0; ni < mds->n_pmd; ni++ ) IEEE_Swap__FLT( &rbuff[ni] );
+	  NADC_SWAP_ARRAY_32( rbuff, mds->int_pmd, (size_t) mds->n_pmd );
 	  if ( fwrite( rbuff, (size_t) mds->n_pmd * ENVI_FLOAT, 1, fd ) != 1 )
 	       NADC_GOTO_ERROR( NADC_ERR_PDS_WR, "" );
 	  free( rbuff );
@@ -723,7 +723,6 @@ void SCIA_LV1C_WR_MDS( FILE *fd, unsigned int num_mds,
      unsigned short *utemp;
 
 #ifdef _SWAP_TO_LITTLE_ENDIAN
-     register size_t  nm;
 
      unsigned int   ubuff;
      float          *rtemp;
@@ -864,16 +863,10 @@ void SCIA_LV1C_WR_MDS( FILE *fd, unsigned int num_mds,
 	  nr_byte = (size_t) mds->num_pixels * ENVI_FLOAT;
 	  if ( (rtemp = (float *) malloc( nr_byte )) == NULL ) 
 	       NADC_RETURN_ERROR( NADC_ERR_ALLOC, "rtemp" );
-	  for ( ni = 0; ni < mds->num_pixels; ni++ ) {
-	       rtemp[ni] = mds->pixel_wv[ni];
-	       IEEE_Swap__FLT( &rtemp[ni] );
-	  }
+	  NADC_SWAP_ARRAY_32( rtemp, mds->pixel_wv, mds->num_pixels );
 	  if ( fwrite( rtemp, nr_byte, 1, fd ) != 1 )
 	       NADC_RETURN_ERROR( NADC_ERR_PDS_WR, "" );
-	  for ( ni = 0; ni < mds->num_pixels; ni++ ) {
-	       rtemp[ni] = mds->pixel_wv_err[ni];
-	       IEEE_Swap__FLT( &rtemp[ni] );
-	  }
+	  NADC_SWAP_ARRAY_32( rtemp, mds->pixel_wv_err, mds->num_pixels );
 	  if ( fwrite( rtemp, nr_byte, 1, fd ) != 1 )
 	       NADC_RETURN_ERROR( NADC_ERR_PDS_WR, "" );
 	  free( rtemp );
@@ -890,19 +883,11 @@ void SCIA_LV1C_WR_MDS( FILE *fd, unsigned int num_mds,
 	  nr_byte = nr_memb * ENVI_FLOAT;
 	  if ( (rtemp = (float *) malloc( nr_byte )) == NULL ) 
 	       NADC_RETURN_ERROR( NADC_ERR_ALLOC, "rtemp" );
-	  nm = 0;
-	  do {
-	       rtemp[nm] = mds->pixel_val[nm];
-	       IEEE_Swap__FLT( &rtemp[nm] );
-	  } while ( ++nm < nr_memb );
+	  NADC_SWAP_ARRAY_32( rtemp, mds->pixel_val, nr_memb );
 	  if ( fwrite( rtemp, ENVI_FLOAT, nr_memb, fd ) != nr_memb )
 	       NADC_RETURN_ERROR( NADC_ERR_PDS_WR, "" );
 
-	  nm = 0;
-	  do { 
-	       rtemp[nm] = mds->pixel_err[nm];
-	       IEEE_Swap__FLT( &rtemp[nm] );
-	  } while ( ++nm < nr_memb );
+	  NADC_SWAP_ARRAY_32( rtemp, mds->pixel_err, nr_memb );
 	  if ( fwrite( rtemp, ENVI_FLOAT, nr_memb, fd ) != nr_memb )
 	       NADC_RETURN_ERROR( NADC_ERR_PDS_WR, "" );
 	  free( rtemp );
@@ -169,6 +169,8 @@ struct nadc_opt {
       (SCIA_LEVEL_0|SCIA_LEVEL_1|SCIA_LEVEL_2)},
      {"-compress", NULL, "compress data sets in HDF5-file",
       (SCIA_LEVEL_0|SCIA_LEVEL_1|SCIA_LEVEL_2)},
+     {"--chunk-kb", "=N", "chunk size of HDF5 tables in kB [default: auto]",
+      SCIA_LEVEL_0},
 #if defined(_WITH_SQL)
      {"-sql", NULL, "\twrite to PostgreSQL database",
       (SCIA_LEVEL_0|SCIA_LEVEL_1|SCIA_LEVEL_2)},
@@ -252,9 +254,22 @@ struct nadc_opt {
 /* MDS quality check */
      {"-no_qcheck", NULL, "no check on incomplete and/or corrupted states",
       SCIA_LEVEL_0},
+/* I/O */
+     {"-mmap", NULL, "\tread MDS records from memory mapped input file",
+      SCIA_LEVEL_0},
+/* parallel processing */
+     {"--threads", "=N", "calibrate states using N worker processes",
+      SCIA_LEVEL_1},
+/* geolocation of level 1c */
+     {"-fast_geo", NULL, "use table based trigonometry for L1c geolocation",
+      SCIA_LEVEL_1},
 /* MDS calibration */
      {"--cal", "[=0,1,...,9]", "apply spectral calibration, impies L1c format",
       SCIA_LEVEL_1},
+     {"-cal_fused", NULL, "apply per-pixel corrections in one pass over data",
+      SCIA_LEVEL_1},
+     {"-cal_spec", NULL, "apply per-pixel corrections on grouped spectra",
+      SCIA_LEVEL_1},
 /* keydata patch */
      {"-no_patch", NULL, "do not apply any patches on annotation datasets",
       SCIA_PATCH_1},
@@ -691,6 +706,27 @@ void SCIA_SET_PARAM(int argc, char *argv[], int instrument)
 		    else
 			 scia_set_calib(cpntr+1);
 
+	       } else if (strncmp(argv[narg]+2, "threads", 7) == 0) {
+		    /* number of worker processes to calibrate states */
+		    unsigned short num_threads;
+
+		    if ((cpntr = strchr(argv[narg], '=')) == NULL)
+			 NADC_RETURN_ERROR(NADC_ERR_PARAM, argv[narg]);
+		    (void) NADC_USRINP(UINT16_T, cpntr+1, 1, 
+				       &num_threads, &num);
+		    if (num != 1)
+			 NADC_RETURN_ERROR(NADC_ERR_PARAM, argv[narg]);
+		    (void) nadc_set_param_uint16("num_threads", num_threads);
+	       } else if (strncmp(argv[narg]+2, "chunk-kb", 8) == 0) {
+		    /* chunk size of HDF5 tables */
+		    unsigned short chunk_kb;
+
+		    if ((cpntr = strchr(argv[narg], '=')) == NULL)
+			 NADC_RETURN_ERROR(NADC_ERR_PARAM, argv[narg]);
+		    (void) NADC_USRINP(UINT16_T, cpntr+1, 1, &chunk_kb, &num);
+		    if (num != 1)
+			 NADC_RETURN_ERROR(NADC_ERR_PARAM, argv[narg]);
+		    (void) nadc_set_param_uint16("chunk_kb", chunk_kb);
 	       } else if (strncmp(argv[narg]+2, "patch", 5) == 0) {
 		    /* perform patches to calibration key data in L1b product */
 		    if ((cpntr = strchr(argv[narg], '=')) == NULL)
@@ -855,6 +891,14 @@ void SCIA_SET_PARAM(int argc, char *argv[], int instrument)
 		    (void) nadc_set_param_uint8("patch_scia", SCIA_PATCH_NONE);
 	       } else if (strncmp(argv[narg]+1, "no_qcheck", 9) == 0) {
 		    (void) nadc_set_param_uint8("qcheck", PARAM_UNSET);
+	       } else if (strncmp(argv[narg]+1, "mmap", 4) == 0) {
+		    (void) nadc_set_param_uint8("flag_mmap", PARAM_SET);
+	       } else if (strncmp(argv[narg]+1, "fast_geo", 8) == 0) {
+		    (void) nadc_set_param_uint8("flag_fast_geo", PARAM_SET);
+	       } else if (strncmp(argv[narg]+1, "cal_fused", 9) == 0) {
+		    (void) nadc_set_param_uint8("flag_cal_fused", PARAM_SET);
+	       } else if (strncmp(argv[narg]+1, "cal_spec", 8) == 0) {
+		    (void) nadc_set_param_uint8("flag_cal_spec", PARAM_SET);
 	       }
 	  } else {
 	       /* name of input file */
@@ -997,6 +1041,9 @@ void SCIA_SHOW_PARAM(int instrument)
 	       nadc_write_text(outfl, ++nr, "HDF5 compression", "True");
 	  else
 	       nadc_write_text(outfl, ++nr, "HDF5 compression", "False");
+	  if (nadc_get_param_uint16("chunk_kb") > 0)
+	       nadc_write_ushort(outfl, ++nr, "HDF5 chunk size (kB)",
+				 nadc_get_param_uint16("chunk_kb"));
      }
      if (instrument == SCIA_LEVEL_1) {
 	  if (nadc_get_param_uint8("write_lv1c") == PARAM_SET)
@@ -1058,6 +1105,13 @@ void SCIA_SHOW_PARAM(int instrument)
 	       nadc_write_text(outfl, ++nr, "MdsQualityCheck", "Off");
 	  else
 	       nadc_write_text(outfl, ++nr, "MdsQualityCheck", "On");
+/*
+ * read access to input file
+ */
+	  if (nadc_get_param_uint8("flag_mmap") == PARAM_SET)
+	       nadc_write_text(outfl, ++nr, "MemoryMapped", "True");
+	  else
+	       nadc_write_text(outfl, ++nr, "MemoryMapped", "False");
 	  break;
 /*
  *  ----- Patch SCIAMACHY level 1 processor specific options
@@ -1162,6 +1216,21 @@ void SCIA_SHOW_PARAM(int instrument)
  */
 	  scia_get_calib(string);
 	  nadc_write_text(outfl, ++nr, "Calibration", string);
+	  if (nadc_get_param_uint8("flag_cal_fused") == PARAM_SET)
+	       nadc_write_text(outfl, ++nr, "FusedCalibration", "True");
+	  if (nadc_get_param_uint8("flag_cal_spec") == PARAM_SET)
+	       nadc_write_text(outfl, ++nr, "GroupedCalibration", "True");
+/*
+ * number of worker processes
+ */
+	  if (nadc_get_param_uint16("num_threads") > 1)
+	       nadc_write_ushort(outfl, ++nr, "Threads", 
+				 nadc_get_param_uint16("num_threads"));
+/*
+ * trigonometry used for the level 1c geolocation
+ */
+	  if (nadc_get_param_uint8("flag_fast_geo") == PARAM_SET)
+	       nadc_write_text(outfl, ++nr, "FastGeolocation", "True");
 	  break;
 /*
  *  ----- SCIAMACHY level 2 processor specific options